@@ -0,0 +1,250 @@
+/*
+AYMO - Accelerated YaMaha Operator
+Copyright (c) 2023-2024 Andrea Zoppi.
+
+This file is part of AYMO.
+
+AYMO is free software: you can redistribute it and/or modify it under the
+terms of the GNU Lesser General Public License as published by the Free
+Software Foundation, either version 2.1 of the License, or (at your option)
+any later version.
+
+AYMO is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with AYMO. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#if !(defined(_WIN32) && !defined(__CYGWIN__))
+    #ifndef _POSIX_C_SOURCE
+        #define _POSIX_C_SOURCE 200809L
+    #endif
+#endif
+
+#include "aymo_app_map.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#if (defined(_WIN32) && !defined(__CYGWIN__))
+    #define AYMO_APP_MAP_WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <sys/types.h>
+    #include <unistd.h>
+#endif
+
+AYMO_CXX_EXTERN_C_BEGIN
+
+
+#ifdef AYMO_APP_MAP_WIN32
+
+static int app_map_setup(struct app_map* map, const char* path, HANDLE file, int writable)
+{
+    map->file = (void*)file;
+    map->writable = writable;
+
+    if (map->size) {
+        DWORD protect = (writable ? PAGE_READWRITE : PAGE_READONLY);
+        DWORD access = (writable ? FILE_MAP_WRITE : FILE_MAP_READ);
+        ULONGLONG size = (ULONGLONG)map->size;
+        HANDLE mapping = CreateFileMappingA(file, NULL, protect, (DWORD)(size >> 32), (DWORD)size, NULL);
+        if (!mapping) {
+            fprintf(stderr, "ERROR: Cannot map \"%s\"\n", path);
+            return 1;
+        }
+        map->mapping = (void*)mapping;
+        map->data = MapViewOfFile(mapping, access, 0u, 0u, map->size);
+        if (!map->data) {
+            fprintf(stderr, "ERROR: Cannot map \"%s\"\n", path);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+
+int app_map_open(struct app_map* map, const char* path)
+{
+    assert(map);
+    assert(path);
+
+    memset(map, 0, sizeof(*map));
+    map->fd = -1;
+
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                              FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        fprintf(stderr, "ERROR: Cannot open \"%s\"\n", path);
+        return 1;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || ((ULONGLONG)size.QuadPart > (ULONGLONG)SIZE_MAX)) {
+        CloseHandle(file);
+        fprintf(stderr, "ERROR: Cannot map \"%s\"\n", path);
+        return 1;
+    }
+    map->size = (size_t)size.QuadPart;
+
+    if (app_map_setup(map, path, file, 0)) {
+        (void)app_map_close(map);
+        return 1;
+    }
+    return 0;
+}
+
+
+int app_map_create(struct app_map* map, const char* path, size_t size)
+{
+    assert(map);
+    assert(path);
+
+    memset(map, 0, sizeof(*map));
+    map->fd = -1;
+    map->size = size;
+
+    HANDLE file = CreateFileA(path, (GENERIC_READ | GENERIC_WRITE), 0u, NULL, CREATE_ALWAYS,
+                              FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        fprintf(stderr, "ERROR: Cannot create \"%s\"\n", path);
+        return 1;
+    }
+
+    if (app_map_setup(map, path, file, 1)) {
+        (void)app_map_close(map);
+        return 1;
+    }
+    return 0;
+}
+
+
+int app_map_close(struct app_map* map)
+{
+    assert(map);
+
+    int status = 0;
+    if (map->data) {
+        if (!UnmapViewOfFile(map->data)) {
+            status = 1;
+        }
+    }
+    if (map->mapping) {
+        CloseHandle((HANDLE)map->mapping);
+    }
+    if (map->file) {
+        CloseHandle((HANDLE)map->file);
+    }
+    memset(map, 0, sizeof(*map));
+    map->fd = -1;
+    return status;
+}
+
+#else  // POSIX
+
+int app_map_open(struct app_map* map, const char* path)
+{
+    assert(map);
+    assert(path);
+
+    memset(map, 0, sizeof(*map));
+
+    map->fd = open(path, O_RDONLY);
+    if (map->fd < 0) {
+        perror(path);
+        return 1;
+    }
+
+    struct stat st;
+    if (fstat(map->fd, &st) || !S_ISREG(st.st_mode) || ((uintmax_t)st.st_size > (uintmax_t)SIZE_MAX)) {
+        fprintf(stderr, "ERROR: Cannot map \"%s\"\n", path);
+        (void)app_map_close(map);
+        return 1;
+    }
+    map->size = (size_t)st.st_size;
+
+    if (map->size) {
+        void* data = mmap(NULL, map->size, PROT_READ, MAP_SHARED, map->fd, 0);
+        if (data == MAP_FAILED) {
+            perror(path);
+            (void)app_map_close(map);
+            return 1;
+        }
+        map->data = data;
+        (void)posix_madvise(map->data, map->size, POSIX_MADV_SEQUENTIAL);
+    }
+    return 0;
+}
+
+
+int app_map_create(struct app_map* map, const char* path, size_t size)
+{
+    assert(map);
+    assert(path);
+
+    memset(map, 0, sizeof(*map));
+    map->writable = 1;
+
+    map->fd = open(path, (O_RDWR | O_CREAT | O_TRUNC), 0666);
+    if (map->fd < 0) {
+        perror(path);
+        return 1;
+    }
+
+    if (size) {
+        if (ftruncate(map->fd, (off_t)size)) {
+            perror(path);
+            (void)app_map_close(map);
+            return 1;
+        }
+        map->size = size;
+
+        void* data = mmap(NULL, size, (PROT_READ | PROT_WRITE), MAP_SHARED, map->fd, 0);
+        if (data == MAP_FAILED) {
+            perror(path);
+            (void)app_map_close(map);
+            return 1;
+        }
+        map->data = data;
+        (void)posix_madvise(map->data, map->size, POSIX_MADV_SEQUENTIAL);
+    }
+    return 0;
+}
+
+
+int app_map_close(struct app_map* map)
+{
+    assert(map);
+
+    int status = 0;
+    if (map->data) {
+        if (munmap(map->data, map->size)) {
+            perror("munmap()");
+            status = 1;
+        }
+    }
+    if (map->fd >= 0) {
+        if (close(map->fd)) {
+            perror("close()");
+            status = 1;
+        }
+    }
+    memset(map, 0, sizeof(*map));
+    map->fd = -1;
+    return status;
+}
+
+#endif  // AYMO_APP_MAP_WIN32
+
+
+AYMO_CXX_EXTERN_C_END
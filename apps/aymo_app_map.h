@@ -0,0 +1,53 @@
+/*
+AYMO - Accelerated YaMaha Operator
+Copyright (c) 2023-2024 Andrea Zoppi.
+
+This file is part of AYMO.
+
+AYMO is free software: you can redistribute it and/or modify it under the
+terms of the GNU Lesser General Public License as published by the Free
+Software Foundation, either version 2.1 of the License, or (at your option)
+any later version.
+
+AYMO is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with AYMO. If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef _include_aymo_app_map_h
+#define _include_aymo_app_map_h
+
+#include "aymo_cc.h"
+
+#include <stddef.h>
+
+AYMO_CXX_EXTERN_C_BEGIN
+
+
+// Whole-file memory mapping, so that the apps can process samples in place
+struct app_map {
+    void* data;  // NULL for empty files
+    size_t size;
+    void* file;  // platform handles
+    void* mapping;
+    int fd;
+    int writable;
+};
+
+
+// Maps an existing file for reading, with sequential access hints
+int app_map_open(struct app_map* map, const char* path);
+
+// Creates a file of the given size, mapped for writing
+int app_map_create(struct app_map* map, const char* path, size_t size);
+
+// Unmaps and closes; written data reaches the file
+int app_map_close(struct app_map* map);
+
+
+AYMO_CXX_EXTERN_C_END
+
+#endif  // _include_aymo_app_map_h
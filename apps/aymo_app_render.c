@@ -0,0 +1,150 @@
+/*
+AYMO - Accelerated YaMaha Operator
+Copyright (c) 2023-2024 Andrea Zoppi.
+
+This file is part of AYMO.
+
+AYMO is free software: you can redistribute it and/or modify it under the
+terms of the GNU Lesser General Public License as published by the Free
+Software Foundation, either version 2.1 of the License, or (at your option)
+any later version.
+
+AYMO is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with AYMO. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "aymo_app_render.h"
+
+#include <assert.h>
+#include <string.h>
+
+AYMO_CXX_EXTERN_C_BEGIN
+
+
+static void app_render_write_queued(struct aymo_ymf262_chip* chip, uint16_t address, uint8_t value)
+{
+    (void)aymo_ymf262_enqueue_write(chip, address, value);
+}
+
+
+void app_render_ctor(
+    struct app_render* render,
+    struct aymo_ymf262_chip* chip,
+    struct aymo_score_instance* score,
+    unsigned loops,
+    unsigned score_after,
+    int score_latency,
+    bool out_quad
+)
+{
+    assert(render);
+    assert(score);
+
+    memset(render, 0, sizeof(*render));
+    render->chip = chip;
+    render->score = score;
+    render->status = aymo_score_get_status(score);
+
+    if (score_latency >= 0) {
+        render->writer = aymo_ymf262_write;
+    }
+    else {
+        render->writer = app_render_write_queued;
+    }
+
+    render->delay_length = render->status->delay;
+    render->out_channels = (out_quad ? 4u : 2u);
+    render->score_latency = score_latency;
+    render->pending_loops = (loops ? (loops - 1u) : 0u);
+    render->score_after = score_after;
+    render->endless = !loops;
+    render->playing = !(render->status->flags & AYMO_SCORE_FLAG_EOF);
+}
+
+
+uint32_t app_render_run(struct app_render* render, uint32_t length, int16_t* y)
+{
+    assert(render);
+
+    struct aymo_ymf262_chip* chip = render->chip;
+    struct aymo_score_status* status = render->status;
+    aymo_ymf262_write_f writer = render->writer;
+    uint32_t avail_length = length;
+    uint32_t delay_length = render->delay_length;
+
+    while (avail_length && render->playing) {
+        if (delay_length > avail_length) {
+            delay_length = avail_length;
+        }
+
+        if (chip) {
+            if (y) {
+                if (render->out_channels == 4u) {
+                    aymo_ymf262_generate_i16x4(chip, delay_length, y);
+                }
+                else {
+                    aymo_ymf262_generate_i16x2(chip, delay_length, y);
+                }
+                y += (delay_length * render->out_channels);
+            }
+            else {
+                aymo_ymf262_tick(chip, delay_length);
+            }
+        }
+
+        aymo_score_tick(render->score, delay_length);
+        avail_length -= delay_length;
+
+        if ((status->flags & AYMO_SCORE_FLAG_EVENT) && chip) {
+            writer(chip, status->address, status->value);
+        }
+
+        while (!(status->flags & (AYMO_SCORE_FLAG_DELAY | AYMO_SCORE_FLAG_EOF))) {
+            aymo_score_tick(render->score, 0u);
+
+            if (status->flags & AYMO_SCORE_FLAG_EVENT) {
+                if (chip) {
+                    writer(chip, status->address, status->value);
+                }
+
+                if (render->score_latency > 0) {
+                    status->delay += (uint32_t)render->score_latency;
+                    break;
+                }
+            }
+        }
+
+        if (!(status->flags & AYMO_SCORE_FLAG_EOF)) {
+            delay_length = status->delay;
+        }
+        else if (render->endless || render->pending_loops) {
+            if (!render->endless) {
+                render->pending_loops--;
+            }
+            aymo_score_restart(render->score);
+            delay_length = status->delay;
+        }
+        else if (render->score_after) {
+            status->flags |= AYMO_SCORE_FLAG_DELAY;
+            status->delay = render->score_after;
+            delay_length = status->delay;
+            render->score_after = 0u;
+        }
+        else {
+            render->playing = false;
+        }
+    }
+
+    render->delay_length = delay_length;
+    length -= avail_length;
+    render->frame += length;
+    return length;
+}
+
+
+AYMO_CXX_EXTERN_C_END
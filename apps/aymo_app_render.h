@@ -0,0 +1,78 @@
+/*
+AYMO - Accelerated YaMaha Operator
+Copyright (c) 2023-2024 Andrea Zoppi.
+
+This file is part of AYMO.
+
+AYMO is free software: you can redistribute it and/or modify it under the
+terms of the GNU Lesser General Public License as published by the Free
+Software Foundation, either version 2.1 of the License, or (at your option)
+any later version.
+
+AYMO is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with AYMO. If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef _include_aymo_app_render_h
+#define _include_aymo_app_render_h
+
+#include "aymo_score.h"
+#include "aymo_ymf262.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+AYMO_CXX_EXTERN_C_BEGIN
+
+
+// Score playback through a YMF262 chip, shared by the score renderers.
+//
+// Chip samples are generated for the delays between score events, and the
+// register writes of each event are dispatched as the score reaches them.
+// Writes at the reached frame are applied before returning, so that the
+// outcome does not depend on how playback is split into runs.
+//
+// Score latency: positive values add that many frames after each register
+// write; negative values queue the writes into the chip instead.
+
+
+struct app_render {
+    struct aymo_ymf262_chip* chip;  // NULL to follow the score only
+    struct aymo_score_instance* score;
+    struct aymo_score_status* status;
+    aymo_ymf262_write_f writer;
+    uint64_t frame;  // advanced so far
+    uint32_t delay_length;
+    uint32_t out_channels;  // 2 or 4
+    int score_latency;
+    unsigned pending_loops;
+    unsigned score_after;  // [frames] of silence after the last loop
+    bool endless;
+    bool playing;
+};
+
+
+// The score must be loaded; loops == 0 repeats it endlessly
+void app_render_ctor(
+    struct app_render* render,
+    struct aymo_ymf262_chip* chip,
+    struct aymo_score_instance* score,
+    unsigned loops,
+    unsigned score_after,
+    int score_latency,
+    bool out_quad
+);
+
+// Advances by up to length frames, writing chip samples into y if not NULL,
+// else only ticking the chip. Returns the advanced frames, fewer only at the
+// end of the score.
+uint32_t app_render_run(struct app_render* render, uint32_t length, int16_t* y);
+
+
+AYMO_CXX_EXTERN_C_END
+
+#endif  // _include_aymo_app_render_h
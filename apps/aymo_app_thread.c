@@ -0,0 +1,169 @@
+/*
+AYMO - Accelerated YaMaha Operator
+Copyright (c) 2023-2024 Andrea Zoppi.
+
+This file is part of AYMO.
+
+AYMO is free software: you can redistribute it and/or modify it under the
+terms of the GNU Lesser General Public License as published by the Free
+Software Foundation, either version 2.1 of the License, or (at your option)
+any later version.
+
+AYMO is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with AYMO. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#if !(defined(_WIN32) && !defined(__CYGWIN__))
+    #ifndef _POSIX_C_SOURCE
+        #define _POSIX_C_SOURCE 200809L
+    #endif
+#endif
+
+#include "aymo_app_thread.h"
+
+#include <assert.h>
+
+#ifdef AYMO_APP_THREAD_WIN32
+    #include <process.h>
+#else
+    #include <sched.h>
+    #include <time.h>
+    #include <unistd.h>
+#endif
+
+AYMO_CXX_EXTERN_C_BEGIN
+
+
+#ifdef AYMO_APP_THREAD_WIN32
+
+static unsigned __stdcall app_thread_entry(void* arg)
+{
+    struct app_thread* thread = (struct app_thread*)arg;
+    thread->result = thread->func(thread->context);
+    return 0u;
+}
+
+
+int app_thread_start(struct app_thread* thread, app_thread_f func, void* context)
+{
+    assert(thread);
+    assert(func);
+
+    thread->func = func;
+    thread->context = context;
+    thread->result = 0;
+    thread->handle = (HANDLE)_beginthreadex(NULL, 0u, app_thread_entry, thread, 0u, NULL);
+    return (thread->handle ? 0 : 1);
+}
+
+
+int app_thread_join(struct app_thread* thread)
+{
+    assert(thread);
+
+    if (thread->handle) {
+        WaitForSingleObject(thread->handle, INFINITE);
+        CloseHandle(thread->handle);
+        thread->handle = NULL;
+    }
+    return thread->result;
+}
+
+
+unsigned app_thread_get_cpu_count(void)
+{
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (info.dwNumberOfProcessors ? (unsigned)info.dwNumberOfProcessors : 1u);
+}
+
+
+void app_thread_yield(void)
+{
+    SwitchToThread();
+}
+
+
+void app_thread_sleep_us(unsigned microseconds)
+{
+    Sleep((microseconds + 999u) / 1000u);
+}
+
+
+double app_clock_seconds(void)
+{
+    LARGE_INTEGER counter, frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return ((double)counter.QuadPart / (double)frequency.QuadPart);
+}
+
+#else  // POSIX
+
+static void* app_thread_entry(void* arg)
+{
+    struct app_thread* thread = (struct app_thread*)arg;
+    thread->result = thread->func(thread->context);
+    return NULL;
+}
+
+
+int app_thread_start(struct app_thread* thread, app_thread_f func, void* context)
+{
+    assert(thread);
+    assert(func);
+
+    thread->func = func;
+    thread->context = context;
+    thread->result = 0;
+    return (pthread_create(&thread->handle, NULL, app_thread_entry, thread) ? 1 : 0);
+}
+
+
+int app_thread_join(struct app_thread* thread)
+{
+    assert(thread);
+
+    (void)pthread_join(thread->handle, NULL);
+    return thread->result;
+}
+
+
+unsigned app_thread_get_cpu_count(void)
+{
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return ((count > 0) ? (unsigned)count : 1u);
+}
+
+
+void app_thread_yield(void)
+{
+    (void)sched_yield();
+}
+
+
+void app_thread_sleep_us(unsigned microseconds)
+{
+    struct timespec ts;
+    ts.tv_sec = (time_t)(microseconds / 1000000u);
+    ts.tv_nsec = ((long)(microseconds % 1000000u) * 1000L);
+    (void)nanosleep(&ts, NULL);
+}
+
+
+double app_clock_seconds(void)
+{
+    struct timespec ts;
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9));
+}
+
+#endif  // AYMO_APP_THREAD_WIN32
+
+
+AYMO_CXX_EXTERN_C_END
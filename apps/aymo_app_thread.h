@@ -0,0 +1,114 @@
+/*
+AYMO - Accelerated YaMaha Operator
+Copyright (c) 2023-2024 Andrea Zoppi.
+
+This file is part of AYMO.
+
+AYMO is free software: you can redistribute it and/or modify it under the
+terms of the GNU Lesser General Public License as published by the Free
+Software Foundation, either version 2.1 of the License, or (at your option)
+any later version.
+
+AYMO is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with AYMO. If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef _include_aymo_app_thread_h
+#define _include_aymo_app_thread_h
+
+#include "aymo_cc.h"
+
+#include <stdint.h>
+
+#if (defined(_WIN32) && !defined(__CYGWIN__))
+    #define AYMO_APP_THREAD_WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+#else
+    #include <pthread.h>
+#endif
+
+AYMO_CXX_EXTERN_C_BEGIN
+
+
+// Minimal threading for the apps, over pthreads or Win32
+
+typedef int (*app_thread_f)(void* context);
+
+struct app_thread {
+#ifdef AYMO_APP_THREAD_WIN32
+    HANDLE handle;
+#else
+    pthread_t handle;
+#endif
+    app_thread_f func;
+    void* context;
+    int result;
+};
+
+int app_thread_start(struct app_thread* thread, app_thread_f func, void* context);
+int app_thread_join(struct app_thread* thread);  // returns the thread function result
+
+unsigned app_thread_get_cpu_count(void);
+void app_thread_yield(void);
+void app_thread_sleep_us(unsigned microseconds);
+
+double app_clock_seconds(void);  // monotonic, for intervals
+
+
+// Atomics, with acquire loads and release stores.
+// All the operations are sequentially consistent on MSVC.
+
+static inline uint32_t app_atomic_load_u32(volatile uint32_t* ptr)
+{
+#if defined(_MSC_VER)
+    return (uint32_t)InterlockedOr((volatile LONG*)ptr, 0);
+#else
+    return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+#endif
+}
+
+
+static inline void app_atomic_store_u32(volatile uint32_t* ptr, uint32_t value)
+{
+#if defined(_MSC_VER)
+    (void)InterlockedExchange((volatile LONG*)ptr, (LONG)value);
+#else
+    __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+#endif
+}
+
+
+// Returns the previous value
+static inline uint32_t app_atomic_add_u32(volatile uint32_t* ptr, uint32_t value)
+{
+#if defined(_MSC_VER)
+    return (uint32_t)InterlockedExchangeAdd((volatile LONG*)ptr, (LONG)value);
+#else
+    return __atomic_fetch_add(ptr, value, __ATOMIC_ACQ_REL);
+#endif
+}
+
+
+// Spin-then-sleep backoff for lock-free waits; start with *spins = 0
+static inline void app_thread_backoff(unsigned* spins)
+{
+    if (*spins < 64u) {
+        ++*spins;
+        app_thread_yield();
+    }
+    else {
+        app_thread_sleep_us(50u);
+    }
+}
+
+
+AYMO_CXX_EXTERN_C_END
+
+#endif  // _include_aymo_app_thread_h
@@ -0,0 +1,465 @@
+/*
+AYMO - Accelerated YaMaha Operator
+Copyright (c) 2023-2024 Andrea Zoppi.
+
+This file is part of AYMO.
+
+AYMO is free software: you can redistribute it and/or modify it under the
+terms of the GNU Lesser General Public License as published by the Free
+Software Foundation, either version 2.1 of the License, or (at your option)
+any later version.
+
+AYMO is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with AYMO. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#if !(defined(_WIN32) && !defined(__CYGWIN__))
+    #if (defined(__linux__) && !defined(_GNU_SOURCE))
+        #define _GNU_SOURCE  // O_DIRECT, sync_file_range()
+    #endif
+    #ifndef _POSIX_C_SOURCE
+        #define _POSIX_C_SOURCE 200809L
+    #endif
+#endif
+
+#include "aymo_app_writer.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef AYMO_APP_THREAD_WIN32
+    #include <fcntl.h>
+    #include <io.h>
+    #include <malloc.h>
+    #include <sys/stat.h>
+#else
+    #include <fcntl.h>
+    #include <sys/types.h>
+    #include <unistd.h>
+#endif
+
+AYMO_CXX_EXTERN_C_BEGIN
+
+
+#ifdef AYMO_APP_THREAD_WIN32
+
+static void* app_writer_sys_alloc(size_t size)
+{
+    return _aligned_malloc(size, APP_WRITER_ALIGN);
+}
+
+
+static void app_writer_sys_free(void* ptr)
+{
+    _aligned_free(ptr);
+}
+
+
+static int app_writer_sys_open(struct app_writer* writer, const char* path)
+{
+    writer->flags &= ~(APP_WRITER_FLAG_DIRECT | APP_WRITER_FLAG_FADVISE);  // not supported
+
+    writer->fd = _open(path, (_O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY), (_S_IREAD | _S_IWRITE));
+    if (writer->fd < 0) {
+        perror(path);
+        return 1;
+    }
+    return 0;
+}
+
+
+static int app_writer_sys_write(struct app_writer* writer, const uint8_t* data, size_t size, uint64_t offset)
+{
+    if (writer->is_file) {
+        if (_lseeki64(writer->fd, (__int64)offset, SEEK_SET) < 0) {
+            perror("_lseeki64(writer)");
+            return 1;
+        }
+    }
+    while (size) {
+        unsigned chunk = ((size < 0x40000000u) ? (unsigned)size : 0x40000000u);
+        int done = _write(writer->fd, data, chunk);
+        if (done <= 0) {
+            perror("_write(writer)");
+            return 1;
+        }
+        data += (size_t)done;
+        size -= (size_t)done;
+    }
+    return 0;
+}
+
+
+static int app_writer_sys_truncate(struct app_writer* writer, uint64_t size)
+{
+    if (_chsize_s(writer->fd, (__int64)size)) {
+        perror("_chsize_s(writer)");
+        return 1;
+    }
+    return 0;
+}
+
+
+static void app_writer_sys_advise(struct app_writer* writer, uint64_t offset, size_t size)
+{
+    (void)writer;
+    (void)offset;
+    (void)size;
+}
+
+
+static int app_writer_sys_close(struct app_writer* writer)
+{
+    if (_close(writer->fd)) {
+        perror("_close(writer)");
+        return 1;
+    }
+    return 0;
+}
+
+#else  // POSIX
+
+static void* app_writer_sys_alloc(size_t size)
+{
+    void* ptr = NULL;
+    return (posix_memalign(&ptr, APP_WRITER_ALIGN, size) ? NULL : ptr);
+}
+
+
+static void app_writer_sys_free(void* ptr)
+{
+    free(ptr);
+}
+
+
+static int app_writer_sys_open(struct app_writer* writer, const char* path)
+{
+    int oflags = (O_WRONLY | O_CREAT | O_TRUNC);
+
+#ifdef O_DIRECT
+    if (writer->flags & APP_WRITER_FLAG_DIRECT) {
+        writer->fd = open(path, (oflags | O_DIRECT), 0666);
+        if (writer->fd >= 0) {
+            return 0;
+        }
+        if (errno != EINVAL) {
+            perror(path);
+            return 1;
+        }
+        fprintf(stderr, "WARNING: Direct output not supported for \"%s\"\n", path);
+    }
+#endif
+    writer->flags &= ~APP_WRITER_FLAG_DIRECT;
+
+    writer->fd = open(path, oflags, 0666);
+    if (writer->fd < 0) {
+        perror(path);
+        return 1;
+    }
+
+#if (defined(_POSIX_ADVISORY_INFO) && (_POSIX_ADVISORY_INFO > 0))
+    if (writer->flags & APP_WRITER_FLAG_FADVISE) {
+        (void)posix_fadvise(writer->fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    }
+#endif
+    return 0;
+}
+
+
+static int app_writer_sys_write(struct app_writer* writer, const uint8_t* data, size_t size, uint64_t offset)
+{
+    while (size) {
+        ssize_t done;
+        if (writer->is_file) {
+            done = pwrite(writer->fd, data, size, (off_t)offset);
+        }
+        else {
+            done = write(writer->fd, data, size);
+        }
+        if (done < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            perror("write(writer)");
+            return 1;
+        }
+        if (done == 0) {
+            fprintf(stderr, "ERROR: Output stopped accepting data\n");
+            return 1;
+        }
+        data += (size_t)done;
+        size -= (size_t)done;
+        offset += (uint64_t)done;
+    }
+    return 0;
+}
+
+
+static int app_writer_sys_truncate(struct app_writer* writer, uint64_t size)
+{
+    if (ftruncate(writer->fd, (off_t)size)) {
+        perror("ftruncate(writer)");
+        return 1;
+    }
+    return 0;
+}
+
+
+// Starts writeback of the new range, and drops the previous one from the page cache,
+// so that long renders do not pile up dirty pages
+static void app_writer_sys_advise(struct app_writer* writer, uint64_t offset, size_t size)
+{
+    if (!(writer->flags & APP_WRITER_FLAG_FADVISE) || !writer->is_file) {
+        return;
+    }
+#ifdef __linux__
+    (void)sync_file_range(writer->fd, (off_t)offset, (off_t)size, SYNC_FILE_RANGE_WRITE);
+#endif
+#if (defined(_POSIX_ADVISORY_INFO) && (_POSIX_ADVISORY_INFO > 0))
+    if (offset >= writer->buffer_size) {
+        (void)posix_fadvise(writer->fd, (off_t)(offset - writer->buffer_size), (off_t)writer->buffer_size,
+                            POSIX_FADV_DONTNEED);
+    }
+#endif
+    (void)offset;
+    (void)size;
+}
+
+
+static int app_writer_sys_close(struct app_writer* writer)
+{
+    if (close(writer->fd)) {
+        perror("close(writer)");
+        return 1;
+    }
+    return 0;
+}
+
+#endif  // AYMO_APP_THREAD_WIN32
+
+
+static int app_writer_thread(void* context)
+{
+    struct app_writer* writer = (struct app_writer*)context;
+    uint32_t written = writer->written;
+
+    for (;;) {
+        uint32_t submitted = app_atomic_load_u32(&writer->submitted);
+
+        if (written == submitted) {
+            if (app_atomic_load_u32(&writer->closing)) {
+                // Closing comes after the last submission
+                if (written == app_atomic_load_u32(&writer->submitted)) {
+                    break;
+                }
+                continue;
+            }
+
+            double t0 = app_clock_seconds();
+            unsigned spins = 0u;
+            do {
+                app_thread_backoff(&spins);
+            } while ((written == app_atomic_load_u32(&writer->submitted)) &&
+                     !app_atomic_load_u32(&writer->closing));
+            writer->stats.writer_blocked += (app_clock_seconds() - t0);
+            continue;
+        }
+
+        uint32_t index = (written % writer->buffer_count);
+        uint8_t* buffer = &writer->pool[index * writer->buffer_size];
+        size_t size = writer->sizes[index];
+        size_t out_size = size;
+
+        if ((writer->flags & APP_WRITER_FLAG_DIRECT) && (size % APP_WRITER_ALIGN)) {
+            // Last buffer: pad to the block size, then truncated at close
+            out_size = (size + (APP_WRITER_ALIGN - (size % APP_WRITER_ALIGN)));
+            memset(&buffer[size], 0, (out_size - size));
+        }
+
+        double t0 = app_clock_seconds();
+        if (app_writer_sys_write(writer, buffer, out_size, writer->offset)) {
+            app_atomic_store_u32(&writer->failed, 1u);
+            return 1;
+        }
+        app_writer_sys_advise(writer, writer->offset, out_size);
+        writer->stats.writer_busy += (app_clock_seconds() - t0);
+
+        writer->offset += size;
+        writer->stats.buffer_total++;
+        writer->stats.byte_total += size;
+
+        ++written;
+        app_atomic_store_u32(&writer->written, written);
+    }
+    return 0;
+}
+
+
+int app_writer_open(
+    struct app_writer* writer,
+    const char* path,
+    size_t head_size,
+    size_t buffer_size,
+    uint32_t buffer_count,
+    unsigned flags
+)
+{
+    assert(writer);
+
+    memset(writer, 0, sizeof(*writer));
+    writer->fd = -1;
+
+    if (buffer_count < 2u) {
+        buffer_count = 2u;
+    }
+    buffer_size += ((APP_WRITER_ALIGN - (buffer_size % APP_WRITER_ALIGN)) % APP_WRITER_ALIGN);
+    if (buffer_size < APP_WRITER_ALIGN) {
+        buffer_size = APP_WRITER_ALIGN;
+    }
+    if (buffer_size > (SIZE_MAX / buffer_count)) {
+        fprintf(stderr, "ERROR: Writer buffers too large\n");
+        return 1;
+    }
+
+    writer->buffer_size = buffer_size;
+    writer->buffer_count = buffer_count;
+    writer->flags = flags;
+
+    writer->pool_alloc = app_writer_sys_alloc(buffer_size * buffer_count);
+    writer->pool = (uint8_t*)writer->pool_alloc;
+    writer->sizes = (size_t*)calloc(buffer_count, sizeof(size_t));
+    if (!writer->pool || !writer->sizes) {
+        perror("app_writer_sys_alloc(pool)");
+        goto error_;
+    }
+
+    if (path) {
+        writer->is_file = 1;
+        if (app_writer_sys_open(writer, path)) {
+            goto error_;
+        }
+        if ((writer->flags & APP_WRITER_FLAG_DIRECT) && (head_size % APP_WRITER_ALIGN)) {
+            fprintf(stderr, "ERROR: Direct output heading not aligned\n");
+            goto error_;
+        }
+        assert(head_size <= buffer_size);
+        writer->head_size = head_size;
+        writer->offset = head_size;
+    }
+    else {
+        writer->is_file = 0;
+        writer->flags &= ~(APP_WRITER_FLAG_DIRECT | APP_WRITER_FLAG_FADVISE);
+        writer->fd = fileno(stdout);
+        fflush(stdout);
+    }
+
+    if (app_thread_start(&writer->thread, app_writer_thread, writer)) {
+        fprintf(stderr, "ERROR: Cannot start the writer thread\n");
+        goto error_;
+    }
+    return 0;
+
+error_:
+    if (writer->is_file && (writer->fd >= 0)) {
+        (void)app_writer_sys_close(writer);
+    }
+    writer->fd = -1;
+    app_writer_sys_free(writer->pool_alloc);
+    writer->pool_alloc = NULL;
+    writer->pool = NULL;
+    free(writer->sizes);
+    writer->sizes = NULL;
+    return 1;
+}
+
+
+void* app_writer_acquire(struct app_writer* writer)
+{
+    assert(writer);
+    assert(writer->pool);
+
+    uint32_t submitted = writer->submitted;  // by this thread only
+
+    if ((submitted - app_atomic_load_u32(&writer->written)) >= writer->buffer_count) {
+        double t0 = app_clock_seconds();
+        unsigned spins = 0u;
+        do {
+            if (app_atomic_load_u32(&writer->failed)) {
+                return NULL;
+            }
+            app_thread_backoff(&spins);
+        } while ((submitted - app_atomic_load_u32(&writer->written)) >= writer->buffer_count);
+        writer->stats.producer_blocked += (app_clock_seconds() - t0);
+    }
+
+    if (app_atomic_load_u32(&writer->failed)) {
+        return NULL;
+    }
+    return &writer->pool[(submitted % writer->buffer_count) * writer->buffer_size];
+}
+
+
+int app_writer_submit(struct app_writer* writer, size_t size)
+{
+    assert(writer);
+    assert(size <= writer->buffer_size);
+
+    uint32_t submitted = writer->submitted;
+    writer->sizes[submitted % writer->buffer_count] = size;
+    app_atomic_store_u32(&writer->submitted, (submitted + 1u));
+
+    return (app_atomic_load_u32(&writer->failed) ? 1 : 0);
+}
+
+
+int app_writer_close(struct app_writer* writer, const void* head)
+{
+    assert(writer);
+
+    if (!writer->pool) {
+        return 0;  // not open
+    }
+
+    int status = 0;
+    app_atomic_store_u32(&writer->closing, 1u);
+    if (app_thread_join(&writer->thread)) {
+        status = 1;
+    }
+
+    if (writer->is_file) {
+        if (!status && (writer->flags & APP_WRITER_FLAG_DIRECT) && (writer->offset % APP_WRITER_ALIGN)) {
+            status = app_writer_sys_truncate(writer, writer->offset);
+        }
+        if (!status && writer->head_size) {
+            assert(head);
+            uint8_t* buffer = writer->pool;  // idle now, and aligned for direct I/O
+            memcpy(buffer, head, writer->head_size);
+            status = app_writer_sys_write(writer, buffer, writer->head_size, 0u);
+        }
+        if (app_writer_sys_close(writer)) {
+            status = 1;
+        }
+    }
+    else {
+        (void)head;
+    }
+    writer->fd = -1;
+
+    app_writer_sys_free(writer->pool_alloc);
+    writer->pool_alloc = NULL;
+    writer->pool = NULL;
+    free(writer->sizes);
+    writer->sizes = NULL;
+    return status;
+}
+
+
+AYMO_CXX_EXTERN_C_END
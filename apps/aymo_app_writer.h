@@ -0,0 +1,104 @@
+/*
+AYMO - Accelerated YaMaha Operator
+Copyright (c) 2023-2024 Andrea Zoppi.
+
+This file is part of AYMO.
+
+AYMO is free software: you can redistribute it and/or modify it under the
+terms of the GNU Lesser General Public License as published by the Free
+Software Foundation, either version 2.1 of the License, or (at your option)
+any later version.
+
+AYMO is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with AYMO. If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef _include_aymo_app_writer_h
+#define _include_aymo_app_writer_h
+
+#include "aymo_app_thread.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+AYMO_CXX_EXTERN_C_BEGIN
+
+
+// Asynchronous output writer.
+//
+// The producer fills buffers from a pool, and hands them over to a writer
+// thread through a lock-free single-producer single-consumer ring; buffers
+// come back in the same order once written. Rendering blocks only when all
+// the buffers are queued for writing, and the writer only when none is.
+//
+// Output files reserve a heading, written at close when its contents are
+// known, e.g. sizes of a WAVE file.
+
+#define APP_WRITER_ALIGN            4096u  // [bytes] buffer and direct I/O alignment
+#define APP_WRITER_BUFFER_SIZE      (1uL << 20)  // [bytes] default
+#define APP_WRITER_BUFFER_COUNT     4u  // default
+
+#define APP_WRITER_FLAG_DIRECT      (1u << 0)  // bypass the page cache (O_DIRECT); files only
+#define APP_WRITER_FLAG_FADVISE     (1u << 1)  // sequential access, drop written pages; files only
+
+
+struct app_writer_stats {
+    double producer_blocked;  // [s] waiting for a free buffer
+    double writer_blocked;  // [s] waiting for a filled buffer
+    double writer_busy;  // [s] within output calls
+    uint64_t buffer_total;
+    uint64_t byte_total;  // excluding the heading
+};
+
+
+struct app_writer {
+    struct app_writer_stats stats;
+    struct app_thread thread;
+
+    uint8_t* pool;  // buffer_count * buffer_size bytes, aligned
+    void* pool_alloc;
+    size_t* sizes;  // submitted size of each buffer
+    size_t buffer_size;
+    uint64_t offset;  // output offset of the next buffer, by the writer thread
+    size_t head_size;
+    uint32_t buffer_count;
+    unsigned flags;
+    int fd;
+    int is_file;
+
+    volatile uint32_t submitted;  // buffers submitted, by the producer
+    volatile uint32_t written;  // buffers written, by the writer thread
+    volatile uint32_t closing;
+    volatile uint32_t failed;
+};
+
+
+// NULL path writes to stdout, which has no heading.
+// With APP_WRITER_FLAG_DIRECT, head_size must be a multiple of APP_WRITER_ALIGN,
+// and only the last buffer can be partially filled.
+int app_writer_open(
+    struct app_writer* writer,
+    const char* path,
+    size_t head_size,
+    size_t buffer_size,
+    uint32_t buffer_count,
+    unsigned flags
+);
+
+// Returns the next free buffer, of writer->buffer_size bytes; NULL on failure
+void* app_writer_acquire(struct app_writer* writer);
+
+// Queues the last acquired buffer, with its filled size
+int app_writer_submit(struct app_writer* writer, size_t size);
+
+// Drains the queue, then writes the heading if any; head can be NULL when head_size is zero
+int app_writer_close(struct app_writer* writer, const void* head);
+
+
+AYMO_CXX_EXTERN_C_END
+
+#endif  // _include_aymo_app_writer_h
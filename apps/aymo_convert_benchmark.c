@@ -0,0 +1,543 @@
+/*
+AYMO - Accelerated YaMaha Operator
+Copyright (c) 2023-2024 Andrea Zoppi.
+
+This file is part of AYMO.
+
+AYMO is free software: you can redistribute it and/or modify it under the
+terms of the GNU Lesser General Public License as published by the Free
+Software Foundation, either version 2.1 of the License, or (at your option)
+any later version.
+
+AYMO is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with AYMO. If not, see <https://www.gnu.org/licenses/>.
+
+---
+
+Measures the cache pollution of the conversion stores of a single CPU
+extension backend.
+
+Each buffer is converted into the next slice of a track much larger than
+the caches, as when rendering to disk, after touching a "hot" working set
+that stands for the chip state of the render loop. Regular stores evict the
+hot set, which is then reloaded from memory; streaming stores leave it be.
+
+    aymo_convert_benchmark --cpu-ext x86_avx2 --mode i16_f32 --stores stream --hot-size 262144 --buffer-length 4096 --length 1000000
+*/
+
+#include "aymo.h"
+#include "aymo_cpu.h"
+#include "aymo_convert.h"
+#include "aymo_convert_none.h"
+#include "aymo_convert_x86_avx2.h"
+#include "aymo_convert_x86_sse41.h"
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+AYMO_CXX_EXTERN_C_BEGIN
+
+
+#define APP_CACHE_LINE_SIZE     64u
+
+
+typedef void (*app_convert_i16_f32_f)(size_t n, const int16_t i16v[], float f32v[], float scale);
+typedef void (*app_convert_f32_i16_f)(size_t n, const float f32v[], int16_t i16v[], float scale);
+
+struct app_backend {
+    const char* cpu_ext;
+    app_convert_i16_f32_f i16_f32_k;
+    app_convert_f32_i16_f f32_i16_k;
+    app_convert_i16_f32_f i16_f32_k_nt;  // NULL if no streaming stores
+    app_convert_f32_i16_f f32_i16_k_nt;  // NULL if no streaming stores
+};
+
+static const struct app_backend app_backends[] =
+{
+#ifdef AYMO_CPU_SUPPORT_X86_AVX2
+    {
+        "x86_avx2",
+        aymo_convert_x86_avx2_i16_f32_k,
+        aymo_convert_x86_avx2_f32_i16_k,
+        aymo_convert_x86_avx2_i16_f32_k_nt,
+        aymo_convert_x86_avx2_f32_i16_k_nt
+    },
+#endif  // AYMO_CPU_SUPPORT_X86_AVX2
+#ifdef AYMO_CPU_SUPPORT_X86_SSE41
+    {
+        "x86_sse41",
+        aymo_convert_x86_sse41_i16_f32_k,
+        aymo_convert_x86_sse41_f32_i16_k,
+        aymo_convert_x86_sse41_i16_f32_k_nt,
+        aymo_convert_x86_sse41_f32_i16_k_nt
+    },
+#endif  // AYMO_CPU_SUPPORT_X86_SSE41
+    {
+        "none",
+        aymo_convert_none_i16_f32_k,
+        aymo_convert_none_f32_i16_k,
+        NULL,
+        NULL
+    },
+    { NULL, NULL, NULL, NULL, NULL }
+};
+
+
+enum app_mode {
+    APP_MODE_I16_F32 = 0,
+    APP_MODE_F32_I16,
+    APP_MODE_COUNT
+};
+
+static const char* app_mode_names[APP_MODE_COUNT] =
+{
+    "i16_f32",
+    "f32_i16"
+};
+
+
+enum app_stores {
+    APP_STORES_CACHED = 0,
+    APP_STORES_STREAM,
+    APP_STORES_COUNT
+};
+
+static const char* app_stores_names[APP_STORES_COUNT] =
+{
+    "cached",
+    "stream"
+};
+
+
+struct app_args {
+    int argc;
+    char** argv;
+
+    // App parameters
+    unsigned buffer_length;
+    unsigned length;
+    unsigned track_length;
+    unsigned hot_size;
+    bool benchmark;
+
+    // Convert parameters
+    const struct app_backend* backend;
+    enum app_mode mode;
+    enum app_stores stores;
+};
+
+
+static int app_return;
+
+static struct app_args app_args;
+static clock_t clock_start;
+static clock_t clock_end;
+static clock_t clock_hot;
+
+static uint32_t buffer_length;
+static uint32_t track_length;
+static void* in_buffer_ptr;
+static void* track_ptr;
+static uint32_t* hot_ptr;
+static size_t hot_length;
+
+
+static bool app_cpu_ext_supported(const char* cpu_ext)
+{
+    #ifdef AYMO_CPU_SUPPORT_X86_AVX2
+        if (!strcmp(cpu_ext, "x86_avx2")) {
+            return !!(aymo_cpu_x86_get_extensions() & AYMO_CPU_X86_EXT_AVX2);
+        }
+    #endif
+
+    #ifdef AYMO_CPU_SUPPORT_X86_SSE41
+        if (!strcmp(cpu_ext, "x86_sse41")) {
+            return !!(aymo_cpu_x86_get_extensions() & AYMO_CPU_X86_EXT_SSE41);
+        }
+    #endif
+
+    return !strcmp(cpu_ext, "none");
+}
+
+
+static int app_boot(void)
+{
+    app_return = 2;
+
+    aymo_boot();
+
+    buffer_length = 1u;
+    track_length = 1u;
+    in_buffer_ptr = NULL;
+    track_ptr = NULL;
+    hot_ptr = NULL;
+    hot_length = 0u;
+
+    return 0;
+}
+
+
+static int app_args_init(int argc, char** argv)
+{
+    memset(&app_args, 0, sizeof(app_args));
+
+    app_args.argc = argc;
+    app_args.argv = argv;
+
+    app_args.buffer_length = 4096u;
+    app_args.length = 1000000u;
+    app_args.track_length = (1u << 24);  // 64 MiB of float samples
+    app_args.hot_size = (256u << 10);
+
+    app_args.backend = app_backends;
+    while (!app_cpu_ext_supported(app_args.backend->cpu_ext)) {
+        ++app_args.backend;  // "none" always matches
+    }
+    app_args.mode = APP_MODE_I16_F32;
+    app_args.stores = APP_STORES_CACHED;
+
+    return 0;
+}
+
+
+static int app_usage(void)
+{
+    printf("Usage: aymo_convert_benchmark [OPTIONS]\n");
+    printf("\n");
+    printf("Options:\n");
+    printf("  --benchmark         Prints render time, hot set time, and checksum\n");
+    printf("  --buffer-length N   Samples converted per call (default: 4096)\n");
+    printf("  --cpu-ext TAG       Convert implementation: x86_avx2, x86_sse41, none (default: best)\n");
+    printf("  --help, -h          Shows this help\n");
+    printf("  --hot-size BYTES    Working set touched before each call (default: 262144)\n");
+    printf("  --length N          Total samples converted (default: 1000000)\n");
+    printf("  --mode MODE         i16_f32, f32_i16 (default: i16_f32)\n");
+    printf("  --stores STORES     cached, stream (x86 only; default: cached)\n");
+    printf("  --track-length N    Output track samples, reused cyclically (default: 16777216)\n");
+
+    return -1;  // help
+}
+
+
+static int app_args_parse_uint(const char* name, const char* text, unsigned* value)
+{
+    errno = 0;
+    *value = strtoul(text, NULL, 0);
+    if (errno) {
+        perror(name);
+        return 1;
+    }
+    return 0;
+}
+
+
+static int app_args_parse(void)
+{
+    int argi;
+
+    for (argi = 1; argi < app_args.argc; ++argi) {
+        const char* name = app_args.argv[argi];
+
+        if (!strcmp(name, "--")) {
+            ++argi;
+            break;
+        }
+
+        // Unary options
+        if (!strcmp(name, "--benchmark")) {
+            app_args.benchmark = true;
+            continue;
+        }
+        if (!strcmp(name, "--help") || !strcmp(name, "-h")) {
+            return app_usage();
+        }
+
+        // Binary options
+        if (argi >= (app_args.argc - 1)) {
+            break;
+        }
+        if (!strcmp(name, "--buffer-length")) {
+            if (app_args_parse_uint(name, app_args.argv[++argi], &app_args.buffer_length)) {
+                return 1;
+            }
+            continue;
+        }
+        if (!strcmp(name, "--cpu-ext")) {
+            const char* text = app_args.argv[++argi];
+            const struct app_backend* backend = app_backends;
+            for (; backend->cpu_ext; ++backend) {
+                if (!strcmp(text, backend->cpu_ext)) {
+                    break;
+                }
+            }
+            if (!backend->cpu_ext || !app_cpu_ext_supported(text)) {
+                fprintf(stderr, "ERROR: Unsupported CPU extensions tag: \"%s\"\n", text);
+                return 1;
+            }
+            app_args.backend = backend;
+            continue;
+        }
+        if (!strcmp(name, "--hot-size")) {
+            if (app_args_parse_uint(name, app_args.argv[++argi], &app_args.hot_size)) {
+                return 1;
+            }
+            continue;
+        }
+        if (!strcmp(name, "--length")) {
+            if (app_args_parse_uint(name, app_args.argv[++argi], &app_args.length)) {
+                return 1;
+            }
+            continue;
+        }
+        if (!strcmp(name, "--mode")) {
+            const char* text = app_args.argv[++argi];
+            int mode = 0;
+            for (; mode < (int)APP_MODE_COUNT; ++mode) {
+                if (!strcmp(text, app_mode_names[mode])) {
+                    break;
+                }
+            }
+            if (mode >= (int)APP_MODE_COUNT) {
+                fprintf(stderr, "ERROR: Unsupported convert mode: \"%s\"\n", text);
+                return 1;
+            }
+            app_args.mode = (enum app_mode)mode;
+            continue;
+        }
+        if (!strcmp(name, "--stores")) {
+            const char* text = app_args.argv[++argi];
+            int stores = 0;
+            for (; stores < (int)APP_STORES_COUNT; ++stores) {
+                if (!strcmp(text, app_stores_names[stores])) {
+                    break;
+                }
+            }
+            if (stores >= (int)APP_STORES_COUNT) {
+                fprintf(stderr, "ERROR: Unsupported stores: \"%s\"\n", text);
+                return 1;
+            }
+            app_args.stores = (enum app_stores)stores;
+            continue;
+        }
+        if (!strcmp(name, "--track-length")) {
+            if (app_args_parse_uint(name, app_args.argv[++argi], &app_args.track_length)) {
+                return 1;
+            }
+            continue;
+        }
+        break;
+    }
+
+    if (argi < app_args.argc) {
+        fprintf(stderr, "ERROR: Unknown options after #%d = \"%s\"\n", argi, app_args.argv[argi]);
+        return 1;
+    }
+
+    if ((app_args.stores == APP_STORES_STREAM) && !app_args.backend->i16_f32_k_nt) {
+        fprintf(stderr, "ERROR: No streaming stores for CPU extensions tag: \"%s\"\n", app_args.backend->cpu_ext);
+        return 1;
+    }
+
+    return 0;
+}
+
+
+static int app_setup(void)
+{
+    bool is_float_in = (app_args.mode == APP_MODE_F32_I16);
+    size_t in_sample_size = (is_float_in ? sizeof(float) : sizeof(int16_t));
+    size_t out_sample_size = (is_float_in ? sizeof(int16_t) : sizeof(float));
+
+    buffer_length = app_args.buffer_length;
+    if (buffer_length < 1u) {
+        buffer_length = 1u;
+    }
+    if (buffer_length > (UINT32_MAX / sizeof(float))) {
+        buffer_length = (UINT32_MAX / sizeof(float));
+    }
+
+    track_length = app_args.track_length;
+    if (track_length < buffer_length) {
+        track_length = buffer_length;
+    }
+    if (track_length > (UINT32_MAX / sizeof(float))) {
+        track_length = (UINT32_MAX / sizeof(float));
+    }
+    track_length -= (track_length % buffer_length);  // whole buffers
+
+    // Deterministic noise
+    in_buffer_ptr = malloc(buffer_length * in_sample_size);
+    if (!in_buffer_ptr) {
+        perror("malloc(in_buffer_size)");
+        return 2;
+    }
+    uint32_t seed = 0x12345678u;
+    for (size_t i = 0u; i < buffer_length; ++i) {
+        seed = ((seed * 1664525u) + 1013904223u);
+        int16_t x = (int16_t)(seed >> 16);
+        if (is_float_in) {
+            ((float*)in_buffer_ptr)[i] = ((float)x * (1.f / 32768.f));
+        }
+        else {
+            ((int16_t*)in_buffer_ptr)[i] = x;
+        }
+    }
+
+    // Touch the whole track, so that page faults stay out of the timings
+    track_ptr = malloc(track_length * out_sample_size);
+    if (!track_ptr) {
+        perror("malloc(track_size)");
+        return 2;
+    }
+    memset(track_ptr, 0, (track_length * out_sample_size));
+
+    hot_length = (app_args.hot_size / sizeof(uint32_t));
+    if (hot_length) {
+        hot_ptr = (uint32_t*)malloc(hot_length * sizeof(uint32_t));
+        if (!hot_ptr) {
+            perror("malloc(hot_size)");
+            return 2;
+        }
+        memset(hot_ptr, 0, (hot_length * sizeof(uint32_t)));
+    }
+
+    return 0;
+}
+
+
+static void app_teardown(void)
+{
+    free(in_buffer_ptr);
+    in_buffer_ptr = NULL;
+
+    free(track_ptr);
+    track_ptr = NULL;
+
+    free(hot_ptr);
+    hot_ptr = NULL;
+    hot_length = 0u;
+
+    buffer_length = 0u;
+    track_length = 0u;
+}
+
+
+// Read-modify-write of one word per cache line, like a chip state update
+static uint32_t app_touch_hot(void)
+{
+    const size_t stride = (APP_CACHE_LINE_SIZE / sizeof(uint32_t));
+    uint32_t sum = 0u;
+    for (size_t i = 0u; i < hot_length; i += stride) {
+        uint32_t x = (hot_ptr[i] + 1u);
+        hot_ptr[i] = x;
+        sum += x;
+    }
+    return sum;
+}
+
+
+static int app_run(void)
+{
+    const struct app_backend* backend = app_args.backend;
+    bool stream = (app_args.stores == APP_STORES_STREAM);
+    app_convert_i16_f32_f i16_f32 = (stream ? backend->i16_f32_k_nt : backend->i16_f32_k);
+    app_convert_f32_i16_f f32_i16 = (stream ? backend->f32_i16_k_nt : backend->f32_i16_k);
+    size_t pending_length = app_args.length;
+    size_t track_offset = 0u;
+    uint32_t checksum = 0u;
+
+    clock_hot = 0;
+    clock_start = clock();
+
+    while (pending_length) {
+        size_t n = buffer_length;
+        if (n > pending_length) {
+            n = pending_length;
+        }
+
+        clock_t clock_hot_start = clock();
+        checksum += app_touch_hot();
+        clock_hot += (clock() - clock_hot_start);
+
+        switch (app_args.mode) {
+            case APP_MODE_I16_F32: {
+                float* f32v = &((float*)track_ptr)[track_offset];
+                i16_f32(n, (const int16_t*)in_buffer_ptr, f32v, (1.f / 32768.f));
+                checksum += ((const uint8_t*)f32v)[0];  // keeps the results alive
+                break;
+            }
+            case APP_MODE_F32_I16: {
+                int16_t* i16v = &((int16_t*)track_ptr)[track_offset];
+                f32_i16(n, (const float*)in_buffer_ptr, i16v, 32768.f);
+                checksum += ((const uint8_t*)i16v)[0];  // keeps the results alive
+                break;
+            }
+            default: {
+                return 2;
+            }
+        }
+
+        track_offset += n;
+        if (track_offset >= track_length) {
+            track_offset = 0u;
+        }
+        pending_length -= n;
+    }
+
+    clock_end = clock();
+
+    if (app_args.benchmark) {
+        clock_t clock_duration = (clock_end - clock_start);
+        double seconds = ((double)clock_duration * (1. / (double)CLOCKS_PER_SEC));
+        double hot_seconds = ((double)clock_hot * (1. / (double)CLOCKS_PER_SEC));
+        printf("Render time: %.6f seconds\n", seconds);
+        printf("Hot time: %.6f seconds\n", hot_seconds);
+        printf("Checksum: %08lX\n", (unsigned long)checksum);
+    }
+
+    return 0;
+}
+
+
+int main(int argc, char** argv)
+{
+    app_return = app_boot();
+    if (app_return) goto catch_;
+
+    app_return = app_args_init(argc, argv);
+    if (app_return) goto catch_;
+
+    app_return = app_args_parse();
+    if (app_return == -1) {  // help
+        app_return = 0;
+        goto finally_;
+    }
+    if (app_return) goto catch_;
+
+    app_return = app_setup();
+    if (app_return) goto catch_;
+
+    app_return = app_run();
+    if (app_return) goto catch_;
+
+    goto finally_;
+
+catch_:
+finally_:
+    app_teardown();
+    return app_return;
+}
+
+
+AYMO_CXX_EXTERN_C_END
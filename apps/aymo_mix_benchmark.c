@@ -0,0 +1,503 @@
+/*
+AYMO - Accelerated YaMaha Operator
+Copyright (c) 2023-2024 Andrea Zoppi.
+
+This file is part of AYMO.
+
+AYMO is free software: you can redistribute it and/or modify it under the
+terms of the GNU Lesser General Public License as published by the Free
+Software Foundation, either version 2.1 of the License, or (at your option)
+any later version.
+
+AYMO is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with AYMO. If not, see <https://www.gnu.org/licenses/>.
+
+---
+
+Measures the mix bus throughput of a single CPU extension backend, mixing
+synthetic streams in blocks of the chosen buffer length.
+
+    aymo_mix_benchmark --cpu-ext x86_avx2 --mode i16x2 --streams 8 --buffer-length 1024 --length 1000000
+*/
+
+#include "aymo.h"
+#include "aymo_cpu.h"
+#include "aymo_mix.h"
+#include "aymo_mix_none.h"
+#include "aymo_mix_x86_avx2.h"
+#include "aymo_mix_x86_sse41.h"
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+AYMO_CXX_EXTERN_C_BEGIN
+
+
+#define APP_STREAMS_MAX     64u
+
+
+typedef void (*app_mix_i16_f)(size_t n, size_t m, const int16_t* const xv[], const float kv[], int16_t yv[]);
+typedef void (*app_mix_f32_f)(size_t n, size_t m, const float* const xv[], const float kv[], float yv[]);
+typedef void (*app_mix_i16_i32_f)(size_t n, size_t m, const int16_t* const xv[], const float kv[], int32_t yv[]);
+typedef void (*app_mix_i32_i16_f)(size_t n, const int32_t xv[], int16_t yv[]);
+
+struct app_backend {
+    const char* cpu_ext;
+    app_mix_i16_f i16_k;
+    app_mix_i16_f i16x2_k;
+    app_mix_f32_f f32_k;
+    app_mix_f32_f f32x2_k;
+    app_mix_i16_i32_f i16_i32_k;
+    app_mix_i16_i32_f i16x2_i32_k;
+    app_mix_i32_i16_f i32_i16;
+};
+
+static const struct app_backend app_backends[] =
+{
+#ifdef AYMO_CPU_SUPPORT_X86_AVX2
+    {
+        "x86_avx2",
+        aymo_mix_x86_avx2_i16_k,
+        aymo_mix_x86_avx2_i16x2_k,
+        aymo_mix_x86_avx2_f32_k,
+        aymo_mix_x86_avx2_f32x2_k,
+        aymo_mix_x86_avx2_i16_i32_k,
+        aymo_mix_x86_avx2_i16x2_i32_k,
+        aymo_mix_x86_avx2_i32_i16
+    },
+#endif  // AYMO_CPU_SUPPORT_X86_AVX2
+#ifdef AYMO_CPU_SUPPORT_X86_SSE41
+    {
+        "x86_sse41",
+        aymo_mix_x86_sse41_i16_k,
+        aymo_mix_x86_sse41_i16x2_k,
+        aymo_mix_x86_sse41_f32_k,
+        aymo_mix_x86_sse41_f32x2_k,
+        aymo_mix_x86_sse41_i16_i32_k,
+        aymo_mix_x86_sse41_i16x2_i32_k,
+        aymo_mix_x86_sse41_i32_i16
+    },
+#endif  // AYMO_CPU_SUPPORT_X86_SSE41
+    {
+        "none",
+        aymo_mix_none_i16_k,
+        aymo_mix_none_i16x2_k,
+        aymo_mix_none_f32_k,
+        aymo_mix_none_f32x2_k,
+        aymo_mix_none_i16_i32_k,
+        aymo_mix_none_i16x2_i32_k,
+        aymo_mix_none_i32_i16
+    },
+    { NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL }
+};
+
+
+enum app_mode {
+    APP_MODE_I16 = 0,
+    APP_MODE_I16X2,
+    APP_MODE_F32,
+    APP_MODE_F32X2,
+    APP_MODE_I16_I32,
+    APP_MODE_I16X2_I32,
+    APP_MODE_COUNT
+};
+
+static const char* app_mode_names[APP_MODE_COUNT] =
+{
+    "i16",
+    "i16x2",
+    "f32",
+    "f32x2",
+    "i16_i32",
+    "i16x2_i32"
+};
+
+
+struct app_args {
+    int argc;
+    char** argv;
+
+    // App parameters
+    unsigned buffer_length;
+    unsigned length;
+    bool benchmark;
+
+    // Mix parameters
+    const struct app_backend* backend;
+    enum app_mode mode;
+    unsigned streams;
+};
+
+
+static int app_return;
+
+static struct app_args app_args;
+static clock_t clock_start;
+static clock_t clock_end;
+
+static uint32_t buffer_length;
+static size_t channels;
+static void* in_buffers[APP_STREAMS_MAX];
+static const int16_t* in_i16v[APP_STREAMS_MAX];
+static const float* in_f32v[APP_STREAMS_MAX];
+static float gains[APP_STREAMS_MAX * 2u];
+static void* out_buffer_ptr;
+static int32_t* acc_buffer_ptr;
+
+
+static bool app_cpu_ext_supported(const char* cpu_ext)
+{
+    #ifdef AYMO_CPU_SUPPORT_X86_AVX2
+        if (!strcmp(cpu_ext, "x86_avx2")) {
+            return !!(aymo_cpu_x86_get_extensions() & AYMO_CPU_X86_EXT_AVX2);
+        }
+    #endif
+
+    #ifdef AYMO_CPU_SUPPORT_X86_SSE41
+        if (!strcmp(cpu_ext, "x86_sse41")) {
+            return !!(aymo_cpu_x86_get_extensions() & AYMO_CPU_X86_EXT_SSE41);
+        }
+    #endif
+
+    return !strcmp(cpu_ext, "none");
+}
+
+
+static int app_boot(void)
+{
+    app_return = 2;
+
+    aymo_boot();
+
+    buffer_length = 1u;
+    channels = 1u;
+    memset(in_buffers, 0, sizeof(in_buffers));
+    out_buffer_ptr = NULL;
+    acc_buffer_ptr = NULL;
+
+    return 0;
+}
+
+
+static int app_args_init(int argc, char** argv)
+{
+    memset(&app_args, 0, sizeof(app_args));
+
+    app_args.argc = argc;
+    app_args.argv = argv;
+
+    app_args.buffer_length = 1u;
+    app_args.length = 1000000u;
+
+    app_args.backend = app_backends;
+    while (!app_cpu_ext_supported(app_args.backend->cpu_ext)) {
+        ++app_args.backend;  // "none" always matches
+    }
+    app_args.mode = APP_MODE_I16X2;
+    app_args.streams = 8u;
+
+    return 0;
+}
+
+
+static int app_usage(void)
+{
+    printf("Usage: aymo_mix_benchmark [OPTIONS]\n");
+    printf("\n");
+    printf("Options:\n");
+    printf("  --benchmark         Prints render time and checksum\n");
+    printf("  --buffer-length N   Frames mixed per call (default: 1)\n");
+    printf("  --cpu-ext TAG       Mix implementation: x86_avx2, x86_sse41, none (default: best)\n");
+    printf("  --help, -h          Shows this help\n");
+    printf("  --length N          Total frames mixed (default: 1000000)\n");
+    printf("  --mode MODE         i16, i16x2, f32, f32x2, i16_i32, i16x2_i32 (default: i16x2)\n");
+    printf("  --streams N         Input streams, up to %u (default: 8)\n", APP_STREAMS_MAX);
+
+    return -1;  // help
+}
+
+
+static int app_args_parse(void)
+{
+    int argi;
+
+    for (argi = 1; argi < app_args.argc; ++argi) {
+        const char* name = app_args.argv[argi];
+
+        if (!strcmp(name, "--")) {
+            ++argi;
+            break;
+        }
+
+        // Unary options
+        if (!strcmp(name, "--benchmark")) {
+            app_args.benchmark = true;
+            continue;
+        }
+        if (!strcmp(name, "--help") || !strcmp(name, "-h")) {
+            return app_usage();
+        }
+
+        // Binary options
+        if (argi >= (app_args.argc - 1)) {
+            break;
+        }
+        if (!strcmp(name, "--buffer-length")) {
+            const char* text = app_args.argv[++argi];
+            errno = 0;
+            app_args.buffer_length = strtoul(text, NULL, 0);
+            if (errno) {
+                perror(name);
+                return 1;
+            }
+            continue;
+        }
+        if (!strcmp(name, "--cpu-ext")) {
+            const char* text = app_args.argv[++argi];
+            const struct app_backend* backend = app_backends;
+            for (; backend->cpu_ext; ++backend) {
+                if (!strcmp(text, backend->cpu_ext)) {
+                    break;
+                }
+            }
+            if (!backend->cpu_ext || !app_cpu_ext_supported(text)) {
+                fprintf(stderr, "ERROR: Unsupported CPU extensions tag: \"%s\"\n", text);
+                return 1;
+            }
+            app_args.backend = backend;
+            continue;
+        }
+        if (!strcmp(name, "--length")) {
+            const char* text = app_args.argv[++argi];
+            errno = 0;
+            app_args.length = strtoul(text, NULL, 0);
+            if (errno) {
+                perror(name);
+                return 1;
+            }
+            continue;
+        }
+        if (!strcmp(name, "--mode")) {
+            const char* text = app_args.argv[++argi];
+            int mode = 0;
+            for (; mode < (int)APP_MODE_COUNT; ++mode) {
+                if (!strcmp(text, app_mode_names[mode])) {
+                    break;
+                }
+            }
+            if (mode >= (int)APP_MODE_COUNT) {
+                fprintf(stderr, "ERROR: Unsupported mix mode: \"%s\"\n", text);
+                return 1;
+            }
+            app_args.mode = (enum app_mode)mode;
+            continue;
+        }
+        if (!strcmp(name, "--streams")) {
+            const char* text = app_args.argv[++argi];
+            errno = 0;
+            app_args.streams = strtoul(text, NULL, 0);
+            if (errno || app_args.streams > APP_STREAMS_MAX) {
+                fprintf(stderr, "ERROR: Invalid stream count: %s\n", text);
+                return 1;
+            }
+            continue;
+        }
+        break;
+    }
+
+    if (argi < app_args.argc) {
+        fprintf(stderr, "ERROR: Unknown options after #%d = \"%s\"\n", argi, app_args.argv[argi]);
+        return 1;
+    }
+
+    return 0;
+}
+
+
+static int app_setup(void)
+{
+    bool is_float = ((app_args.mode == APP_MODE_F32) || (app_args.mode == APP_MODE_F32X2));
+    bool is_stereo = ((app_args.mode == APP_MODE_I16X2) || (app_args.mode == APP_MODE_F32X2) ||
+                      (app_args.mode == APP_MODE_I16X2_I32));
+    size_t sample_size = (is_float ? sizeof(float) : sizeof(int16_t));
+
+    channels = (is_stereo ? 2u : 1u);
+
+    buffer_length = app_args.buffer_length;
+    if (buffer_length < 1u) {
+        buffer_length = 1u;
+    }
+    if (buffer_length > (UINT32_MAX / (sizeof(int32_t) * 2u))) {
+        buffer_length = (UINT32_MAX / (sizeof(int32_t) * 2u));
+    }
+    size_t sample_count = (buffer_length * channels);
+
+    // Deterministic noise, different for each stream
+    uint32_t seed = 0x12345678u;
+    for (unsigned j = 0u; j < app_args.streams; ++j) {
+        in_buffers[j] = malloc(sample_count * sample_size);
+        if (!in_buffers[j]) {
+            perror("malloc(in_buffer_size)");
+            return 2;
+        }
+        for (size_t i = 0u; i < sample_count; ++i) {
+            seed = ((seed * 1664525u) + 1013904223u);
+            int16_t x = (int16_t)(seed >> 16);
+            if (is_float) {
+                ((float*)in_buffers[j])[i] = ((float)x * (1.f / 32768.f));
+            }
+            else {
+                ((int16_t*)in_buffers[j])[i] = x;
+            }
+        }
+        in_i16v[j] = (const int16_t*)in_buffers[j];
+        in_f32v[j] = (const float*)in_buffers[j];
+        gains[(j * 2u) + 0u] = (1.f / (float)(j + 1u));
+        gains[(j * 2u) + 1u] = (1.f - (1.f / (float)(j + 1u)));
+    }
+
+    out_buffer_ptr = malloc(sample_count * sample_size);
+    if (!out_buffer_ptr) {
+        perror("malloc(out_buffer_size)");
+        return 2;
+    }
+
+    if ((app_args.mode == APP_MODE_I16_I32) || (app_args.mode == APP_MODE_I16X2_I32)) {
+        acc_buffer_ptr = (int32_t*)malloc(sample_count * sizeof(int32_t));
+        if (!acc_buffer_ptr) {
+            perror("malloc(acc_buffer_size)");
+            return 2;
+        }
+    }
+
+    return 0;
+}
+
+
+static void app_teardown(void)
+{
+    for (unsigned j = 0u; j < APP_STREAMS_MAX; ++j) {
+        free(in_buffers[j]);
+        in_buffers[j] = NULL;
+    }
+
+    free(out_buffer_ptr);
+    out_buffer_ptr = NULL;
+
+    free(acc_buffer_ptr);
+    acc_buffer_ptr = NULL;
+
+    buffer_length = 0u;
+}
+
+
+static int app_run(void)
+{
+    const struct app_backend* backend = app_args.backend;
+    const int16_t* const* i16v = in_i16v;
+    const float* const* f32v = in_f32v;
+    size_t m = app_args.streams;
+    size_t pending_length = app_args.length;
+    uint32_t checksum = 0u;
+
+    clock_start = clock();
+
+    while (pending_length) {
+        size_t n = buffer_length;
+        if (n > pending_length) {
+            n = pending_length;
+        }
+
+        switch (app_args.mode) {
+            case APP_MODE_I16: {
+                backend->i16_k(n, m, i16v, gains, (int16_t*)out_buffer_ptr);
+                break;
+            }
+            case APP_MODE_I16X2: {
+                backend->i16x2_k(n, m, i16v, gains, (int16_t*)out_buffer_ptr);
+                break;
+            }
+            case APP_MODE_F32: {
+                backend->f32_k(n, m, f32v, gains, (float*)out_buffer_ptr);
+                break;
+            }
+            case APP_MODE_F32X2: {
+                backend->f32x2_k(n, m, f32v, gains, (float*)out_buffer_ptr);
+                break;
+            }
+            case APP_MODE_I16_I32: {
+                memset(acc_buffer_ptr, 0, (n * sizeof(int32_t)));
+                backend->i16_i32_k(n, m, i16v, gains, acc_buffer_ptr);
+                backend->i32_i16(n, acc_buffer_ptr, (int16_t*)out_buffer_ptr);
+                break;
+            }
+            case APP_MODE_I16X2_I32: {
+                memset(acc_buffer_ptr, 0, (n * 2u * sizeof(int32_t)));
+                backend->i16x2_i32_k(n, m, i16v, gains, acc_buffer_ptr);
+                backend->i32_i16((n * 2u), acc_buffer_ptr, (int16_t*)out_buffer_ptr);
+                break;
+            }
+            default: {
+                return 2;
+            }
+        }
+        checksum += ((const uint8_t*)out_buffer_ptr)[0];  // keeps the results alive
+
+        pending_length -= n;
+    }
+
+    clock_end = clock();
+
+    if (app_args.benchmark) {
+        clock_t clock_duration = (clock_end - clock_start);
+        double seconds = ((double)clock_duration * (1. / (double)CLOCKS_PER_SEC));
+        printf("Render time: %.6f seconds\n", seconds);
+        printf("Checksum: %08lX\n", (unsigned long)checksum);
+    }
+
+    return 0;
+}
+
+
+int main(int argc, char** argv)
+{
+    app_return = app_boot();
+    if (app_return) goto catch_;
+
+    app_return = app_args_init(argc, argv);
+    if (app_return) goto catch_;
+
+    app_return = app_args_parse();
+    if (app_return == -1) {  // help
+        app_return = 0;
+        goto finally_;
+    }
+    if (app_return) goto catch_;
+
+    app_return = app_setup();
+    if (app_return) goto catch_;
+
+    app_return = app_run();
+    if (app_return) goto catch_;
+
+    goto finally_;
+
+catch_:
+finally_:
+    app_teardown();
+    return app_return;
+}
+
+
+AYMO_CXX_EXTERN_C_END
@@ -0,0 +1,751 @@
+/*
+AYMO - Accelerated YaMaha Operator
+Copyright (c) 2023-2024 Andrea Zoppi.
+
+This file is part of AYMO.
+
+AYMO is free software: you can redistribute it and/or modify it under the
+terms of the GNU Lesser General Public License as published by the Free
+Software Foundation, either version 2.1 of the License, or (at your option)
+any later version.
+
+AYMO is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with AYMO. If not, see <https://www.gnu.org/licenses/>.
+
+---
+
+Strips redundant register writes from a score, verifying that the optimized
+stream renders the same as the original one, and saves it as DRO v2.0.
+The saved file is reloaded and checked against the optimized stream; its
+timing must be exact, unless rounding to DRO milliseconds is allowed:
+
+    aymo_score_optimize [OPTIONS] SCORE [OUTPUT.dro]
+*/
+
+#include "aymo.h"
+#include "aymo_cpu.h"
+#include "aymo_file.h"
+#include "aymo_score.h"
+#include "aymo_score_dro.h"
+#include "aymo_score_imf.h"
+#include "aymo_score_raw.h"
+#include "aymo_score_ref.h"
+#include "aymo_score_vgm.h"
+#include "aymo_ymf262.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+AYMO_CXX_EXTERN_C_BEGIN
+
+
+#define APP_VERIFY_LENGTH   1024u  // [frames]
+
+
+struct app_args {
+    int argc;
+    char** argv;
+
+    // App parameters
+    unsigned passes;
+    bool verify;
+    bool lossy;
+
+    // Score parameters
+    const char* score_path_cstr;        // NULL or "-" for stdin
+    const char* score_type_cstr;        // NULL uses score file extension
+    enum aymo_score_type score_type;
+
+    // Output parameters
+    const char* out_path_cstr;          // NULL for no output
+
+    // YMF262 parameters
+    const struct aymo_ymf262_vt* ymf262_vt;
+};
+
+
+static int app_return;
+
+static struct app_args app_args;
+
+static void* score_data;
+static size_t score_size;
+static union app_scores {
+    struct aymo_score_instance base;
+    struct aymo_score_dro_instance dro;
+    struct aymo_score_imf_instance imf;
+    struct aymo_score_raw_instance raw;
+    struct aymo_score_ref_instance ref;
+    struct aymo_score_vgm_instance vgm;
+} score;
+
+static struct aymo_score_event* events;
+static uint32_t events_length;
+static struct aymo_score_optimize_stats stats;
+
+static struct aymo_ymf262_chip* chip_orig;
+static struct aymo_ymf262_chip* chip_opt;
+
+static uint8_t* out_data;
+static size_t out_size;
+
+
+static void* aymo_aligned_alloc(size_t size, size_t align)
+{
+    assert(align);
+    assert(size < (SIZE_MAX - align - align));
+
+    void* allocptr = calloc((size + align + align), 1u);
+    if (allocptr) {
+        uintptr_t alignaddr = ((uintptr_t)(void*)allocptr + align);
+        uintptr_t offset = (alignaddr % align);
+        alignaddr += ((align - offset) % align);
+        void* alignptr = (void*)alignaddr;
+        uintptr_t refaddr = (alignaddr - sizeof(void*));
+        void** refptr = (void**)(void*)refaddr;
+        *refptr = allocptr;
+        return alignptr;
+    }
+    return NULL;
+}
+
+
+static void aymo_aligned_free(void* alignptr)
+{
+    if (alignptr) {
+        uintptr_t alignaddr = (uintptr_t)alignptr;
+        uintptr_t refaddr = (alignaddr - sizeof(void*));
+        void** refptr = (void**)(void*)refaddr;
+        void* allocptr = *refptr;
+        free(allocptr);
+    }
+}
+
+
+static int app_boot(void)
+{
+    app_return = 2;
+
+    aymo_boot();
+    aymo_ymf262_boot();
+
+    score_data = NULL;
+    score_size = 0u;
+    memset(&score, 0, sizeof(score));
+
+    events = NULL;
+    events_length = 0u;
+    memset(&stats, 0, sizeof(stats));
+
+    chip_orig = NULL;
+    chip_opt = NULL;
+
+    out_data = NULL;
+    out_size = 0u;
+
+    return 0;
+}
+
+
+static int app_args_init(int argc, char** argv)
+{
+    memset(&app_args, 0, sizeof(app_args));
+
+    app_args.argc = argc;
+    app_args.argv = argv;
+
+    app_args.passes = AYMO_SCORE_OPTIMIZE_EXACT;
+    app_args.verify = true;
+
+    app_args.score_type = aymo_score_type_unknown;
+
+    app_args.ymf262_vt = aymo_ymf262_get_best_vt();
+
+    return 0;
+}
+
+
+static int app_usage(void)
+{
+    printf("Usage: aymo_score_optimize [OPTIONS] SCORE [OUTPUT.dro]\n");
+    printf("\n");
+    printf("Options:\n");
+    printf("  --cpu-ext TAG       YMF262 implementation used for verification\n");
+    printf("  --help, -h          Shows this help\n");
+    printf("  --lossy             Allows rounding delays to DRO milliseconds when saving\n");
+    printf("  --no-verify         Skips rendering comparison\n");
+    printf("  --score-type EXT    Score type, instead of the file extension\n");
+    printf("  --silent-channels   Also drops writes to channels never keyed on (not bit-exact)\n");
+
+    return -1;  // help
+}
+
+
+static int app_args_parse(void)
+{
+    int argi;
+
+    for (argi = 1; argi < app_args.argc; ++argi) {
+        const char* name = app_args.argv[argi];
+
+        if (!strcmp(name, "--")) {
+            ++argi;
+            break;
+        }
+
+        // Unary options
+        if (!strcmp(name, "--help") || !strcmp(name, "-h")) {
+            return app_usage();
+        }
+        if (!strcmp(name, "--lossy")) {
+            app_args.lossy = true;
+            continue;
+        }
+        if (!strcmp(name, "--no-verify")) {
+            app_args.verify = false;
+            continue;
+        }
+        if (!strcmp(name, "--silent-channels")) {
+            app_args.passes |= AYMO_SCORE_OPTIMIZE_SILENT;
+            continue;
+        }
+
+        // Binary options
+        if (argi >= (app_args.argc - 1)) {
+            break;
+        }
+        if (!strcmp(name, "--cpu-ext")) {
+            const char* text = app_args.argv[++argi];
+            app_args.ymf262_vt = aymo_ymf262_get_vt(text);
+            if (!app_args.ymf262_vt) {
+                fprintf(stderr, "ERROR: Unsupported CPU extensions tag: \"%s\"\n", text);
+                return 1;
+            }
+            continue;
+        }
+        if (!strcmp(name, "--score-type")) {
+            const char* value = app_args.argv[++argi];
+            app_args.score_type = aymo_score_ext_to_type(value);
+            if (app_args.score_type >= aymo_score_type_unknown) {
+                fprintf(stderr, "ERROR: Unknown score type \"%s\"\n", value);
+                return 1;
+            }
+            continue;
+        }
+        break;
+    }
+
+    if (argi == (app_args.argc - 2)) {
+        const char* text = app_args.argv[argi++];
+        if (!strcmp(text, "-")) {
+            text = NULL;
+        }
+        app_args.score_path_cstr = text;
+        app_args.out_path_cstr = app_args.argv[argi++];
+    }
+    else if (argi == (app_args.argc - 1)) {
+        const char* text = app_args.argv[argi++];
+        if (!strcmp(text, "-")) {
+            text = NULL;
+        }
+        app_args.score_path_cstr = text;
+    }
+
+    if (app_args.score_type >= aymo_score_type_unknown) {
+        const char* text = app_args.score_path_cstr;
+        if (text) {
+            const char* ext = strrchr(text, '.');
+            if (ext) {
+                app_args.score_type = aymo_score_ext_to_type(ext + 1);
+            }
+        }
+        if (app_args.score_type >= aymo_score_type_unknown) {
+            fprintf(stderr, "ERROR: Unsupported score type of \"%s\"\n", (text ? text : ""));
+            return 1;
+        }
+    }
+
+    if (argi < app_args.argc) {
+        fprintf(stderr, "ERROR: Unknown options after #%d = \"%s\"\n", argi, app_args.argv[argi]);
+        return 1;
+    }
+
+    return 0;
+}
+
+
+static struct aymo_ymf262_chip* app_chip_new(void)
+{
+    size_t chip_size = app_args.ymf262_vt->get_sizeof();
+    void* chip_alignptr = aymo_aligned_alloc(chip_size, 32u);
+    if (!chip_alignptr) {
+        perror("aymo_aligned_alloc(chip_size)");
+        return NULL;
+    }
+    struct aymo_ymf262_chip* chip = (struct aymo_ymf262_chip*)chip_alignptr;
+    chip->vt = app_args.ymf262_vt;
+    aymo_ymf262_ctor(chip);
+    return chip;
+}
+
+
+static int app_setup(void)
+{
+    if (aymo_file_load(app_args.score_path_cstr, &score_data, &score_size)) {
+        return 1;
+    }
+    score.base.vt = aymo_score_type_to_vt(app_args.score_type);
+    if (!score.base.vt) {
+        fprintf(stderr, "ERROR: Unsupported score type ID: %d\n", (int)app_args.score_type);
+        return 1;
+    }
+    aymo_score_ctor(&score.base);
+    if (aymo_score_load(&score.base, score_data, (uint32_t)score_size)) {
+        fprintf(stderr, "ERROR: Cannot load score \"%s\"\n", app_args.score_path_cstr);
+        return 1;
+    }
+
+    if (app_args.verify) {
+        chip_orig = app_chip_new();
+        chip_opt = app_chip_new();
+        if (!chip_orig || !chip_opt) {
+            return 2;
+        }
+    }
+
+    return 0;
+}
+
+
+static void app_teardown(void)
+{
+    if (chip_opt) {
+        aymo_ymf262_dtor(chip_opt);
+        aymo_aligned_free(chip_opt);
+    }
+    chip_opt = NULL;
+
+    if (chip_orig) {
+        aymo_ymf262_dtor(chip_orig);
+        aymo_aligned_free(chip_orig);
+    }
+    chip_orig = NULL;
+
+    free(out_data);
+    out_data = NULL;
+    out_size = 0u;
+
+    free(events);
+    events = NULL;
+    events_length = 0u;
+
+    if (score.base.vt) {
+        aymo_score_unload(&score.base);
+        aymo_score_dtor(&score.base);
+    }
+    aymo_file_unload(score_data);
+    score_data = NULL;
+}
+
+
+static int app_optimize(void)
+{
+    aymo_score_optimize(&score.base, app_args.passes, NULL, 0u, &stats);
+
+    if (stats.events_out) {
+        events = (struct aymo_score_event*)malloc(stats.events_out * sizeof(struct aymo_score_event));
+        if (!events) {
+            perror("malloc(events)");
+            return 2;
+        }
+    }
+    events_length = aymo_score_optimize(&score.base, app_args.passes, events, stats.events_out, &stats);
+
+    uint32_t dropped = (stats.events_in - stats.events_out);
+    double percent = (stats.events_in ? ((100. * (double)dropped) / (double)stats.events_in) : 0.);
+    printf("File: %s\n", (app_args.score_path_cstr ? app_args.score_path_cstr : "-"));
+    printf("Writes in: %lu\n", (unsigned long)stats.events_in);
+    printf("Writes out: %lu\n", (unsigned long)stats.events_out);
+    printf("Writes dropped: %lu (%.2f%%)\n", (unsigned long)dropped, percent);
+    printf("  redundant: %lu\n", (unsigned long)stats.redundant);
+    printf("  inaudible: %lu\n", (unsigned long)stats.inaudible);
+    printf("  silent: %lu\n", (unsigned long)stats.silent);
+    printf("Length: %lu samples\n", (unsigned long)stats.length);
+
+    return 0;
+}
+
+
+// Renders both the original and the optimized scores, comparing outputs
+static int app_verify(void)
+{
+    static int16_t buffer_orig[APP_VERIFY_LENGTH * 2u];
+    static int16_t buffer_opt[APP_VERIFY_LENGTH * 2u];
+
+    struct aymo_score_status* status = aymo_score_get_status(&score.base);
+    uint32_t time = 0u;
+    uint32_t orig_next = 0u;
+    uint32_t opt_index = 0u;
+    uint32_t opt_next = (events_length ? events[0].delay : UINT32_MAX);
+    uint32_t mismatches = 0u;
+    uint32_t first_mismatch = 0u;
+    int max_error = 0;
+
+    aymo_score_restart(&score.base);
+
+    for (;;) {
+        // Apply the writes due now, as the player would do
+        while (!(status->flags & AYMO_SCORE_FLAG_EOF) && (orig_next == time)) {
+            if (status->flags & AYMO_SCORE_FLAG_EVENT) {
+                aymo_ymf262_write(chip_orig, status->address, status->value);
+            }
+            uint32_t delay = ((status->flags & AYMO_SCORE_FLAG_DELAY) ? status->delay : 0u);
+            aymo_score_tick(&score.base, delay);
+            orig_next = (time + delay);
+        }
+
+        while ((opt_index < events_length) && (opt_next == time)) {
+            aymo_ymf262_write(chip_opt, events[opt_index].address, events[opt_index].value);
+            ++opt_index;
+            opt_next = ((opt_index < events_length) ? (time + events[opt_index].delay) : UINT32_MAX);
+        }
+
+        uint32_t next = opt_next;
+        if (!(status->flags & AYMO_SCORE_FLAG_EOF) && (next > orig_next)) {
+            next = orig_next;
+        }
+        if (next == UINT32_MAX) {
+            next = stats.length;  // trailing delay
+        }
+        if (next <= time) {
+            break;
+        }
+
+        while (time < next) {
+            uint32_t length = (next - time);
+            if (length > APP_VERIFY_LENGTH) {
+                length = APP_VERIFY_LENGTH;
+            }
+            aymo_ymf262_generate_i16x2(chip_orig, length, buffer_orig);
+            aymo_ymf262_generate_i16x2(chip_opt, length, buffer_opt);
+
+            for (uint32_t i = 0u; i < (length * 2u); ++i) {
+                int error = abs((int)buffer_orig[i] - (int)buffer_opt[i]);
+                if (error) {
+                    if (!mismatches) {
+                        first_mismatch = (time + (i / 2u));
+                    }
+                    ++mismatches;
+                    if (max_error < error) {
+                        max_error = error;
+                    }
+                }
+            }
+            time += length;
+        }
+    }
+
+    aymo_score_restart(&score.base);
+
+    if (mismatches) {
+        printf("Verification: %lu samples differ, first at %lu, max error %d\n",
+               (unsigned long)mismatches, (unsigned long)first_mismatch, max_error);
+        return ((app_args.passes & AYMO_SCORE_OPTIMIZE_SILENT) ? 0 : 1);
+    }
+    printf("Verification: identical\n");
+    return 0;
+}
+
+
+// Tells whether all the delays are whole DRO milliseconds
+static bool app_dro_is_exact(uint32_t division)
+{
+    for (uint32_t i = 0u; i <= events_length; ++i) {
+        uint32_t delay = ((i < events_length) ? events[i].delay : stats.tail);
+        if (delay % division) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+// Encodes the event stream as DRO v2.0 pairs; pairs can be NULL to count
+static uint32_t app_dro_encode(
+    uint32_t division,
+    const uint8_t codes[256],
+    uint8_t short_delay_code,
+    uint8_t long_delay_code,
+    struct aymo_score_dro_pair* pairs,
+    uint32_t* length_ms
+)
+{
+    uint32_t residual = 0u;
+    uint32_t total_ms = 0u;
+    uint32_t count = 0u;
+
+    for (uint32_t i = 0u; i <= events_length; ++i) {
+        uint32_t delay = ((i < events_length) ? events[i].delay : stats.tail);
+        uint32_t ms = ((delay / division) + ((residual + (delay % division)) / division));
+        residual = ((residual + (delay % division)) % division);
+        total_ms += ms;
+
+        while (ms > 256u) {
+            uint32_t blocks = (ms / 256u);
+            if (blocks > 256u) {
+                blocks = 256u;
+            }
+            if (pairs) {
+                pairs[count].code = long_delay_code;
+                pairs[count].value = (uint8_t)(blocks - 1u);
+            }
+            ++count;
+            ms -= (blocks * 256u);
+        }
+        if (ms) {
+            if (pairs) {
+                pairs[count].code = short_delay_code;
+                pairs[count].value = (uint8_t)(ms - 1u);
+            }
+            ++count;
+        }
+
+        if (i < events_length) {
+            if (pairs) {
+                uint16_t address = events[i].address;
+                pairs[count].code = (uint8_t)(codes[address & 0xFFu] | ((address >> 1u) & 0x80u));
+                pairs[count].value = events[i].value;
+            }
+            ++count;
+        }
+    }
+
+    if (length_ms) {
+        *length_ms = total_ms;
+    }
+    return count;
+}
+
+
+// Reloads the saved file, checking it against the optimized stream
+static int app_save_check(uint32_t division, bool exact)
+{
+    void* data = NULL;
+    size_t size = 0u;
+    struct aymo_score_dro_instance dro;
+    int ret = 1;
+
+    if (aymo_file_load(app_args.out_path_cstr, &data, &size)) {
+        fprintf(stderr, "ERROR: Cannot reload \"%s\"\n", app_args.out_path_cstr);
+        return 2;
+    }
+    memset(&dro, 0, sizeof(dro));
+    dro.parent.vt = &aymo_score_dro_vt;
+    aymo_score_ctor(&dro.parent);
+    if (aymo_score_load(&dro.parent, data, (uint32_t)size)) {
+        fprintf(stderr, "ERROR: Cannot load the saved score \"%s\"\n", app_args.out_path_cstr);
+        goto finally_;
+    }
+
+    // Rounding to milliseconds can only anticipate writes, by less than one
+    struct aymo_score_status* status = aymo_score_get_status(&dro.parent);
+    uint32_t time = 0u;
+    uint32_t expected = 0u;
+    uint32_t index = 0u;
+    uint32_t max_error = 0u;
+
+    while (!(status->flags & AYMO_SCORE_FLAG_EOF)) {
+        if (status->flags & AYMO_SCORE_FLAG_EVENT) {
+            if (index >= events_length) {
+                fprintf(stderr, "ERROR: Saved score has extra writes, from #%lu\n", (unsigned long)index);
+                goto finally_;
+            }
+            expected += events[index].delay;
+            if ((status->address != events[index].address) || (status->value != events[index].value)) {
+                fprintf(stderr, "ERROR: Saved write #%lu differs\n", (unsigned long)index);
+                goto finally_;
+            }
+            if ((time > expected) || ((expected - time) >= division) || (exact && (time != expected))) {
+                fprintf(stderr, "ERROR: Saved write #%lu at %lu samples instead of %lu\n",
+                        (unsigned long)index, (unsigned long)time, (unsigned long)expected);
+                goto finally_;
+            }
+            if (max_error < (expected - time)) {
+                max_error = (expected - time);
+            }
+            ++index;
+        }
+        uint32_t delay = ((status->flags & AYMO_SCORE_FLAG_DELAY) ? status->delay : 0u);
+        aymo_score_tick(&dro.parent, delay);
+        time += delay;
+    }
+    if (index < events_length) {
+        fprintf(stderr, "ERROR: Saved score misses writes, from #%lu\n", (unsigned long)index);
+        goto finally_;
+    }
+    expected += stats.tail;
+    if ((time > expected) || ((expected - time) >= division) || (exact && (time != expected))) {
+        fprintf(stderr, "ERROR: Saved score lasts %lu samples instead of %lu\n",
+                (unsigned long)time, (unsigned long)expected);
+        goto finally_;
+    }
+
+    printf("Reloaded: %lu writes, max timing error %lu samples\n",
+           (unsigned long)index, (unsigned long)max_error);
+    ret = 0;
+
+finally_:
+    if (dro.parent.vt) {
+        aymo_score_unload(&dro.parent);
+        aymo_score_dtor(&dro.parent);
+    }
+    aymo_file_unload(data);
+    return ret;
+}
+
+
+static int app_save(void)
+{
+    uint32_t division = (AYMO_SCORE_OPL_RATE_DEFAULT / 1000u);  // as per decoder
+    bool exact = app_dro_is_exact(division);
+    if (!exact && !app_args.lossy) {
+        fprintf(stderr, "ERROR: Delays are not whole DRO milliseconds; use --lossy to round them\n");
+        return 1;
+    }
+
+    uint8_t codes[256];
+    uint8_t codemap[128];
+    uint32_t codemap_length = 0u;
+    memset(codes, 0xFF, sizeof(codes));
+
+    for (uint32_t i = 0u; i < events_length; ++i) {
+        unsigned address_lo = (events[i].address & 0xFFu);
+        if (codes[address_lo] == 0xFFu) {
+            if (codemap_length >= 126u) {  // two codes reserved for delays
+                fprintf(stderr, "ERROR: Too many distinct registers for DRO v2.0\n");
+                return 1;
+            }
+            codes[address_lo] = (uint8_t)codemap_length;
+            codemap[codemap_length++] = (uint8_t)address_lo;
+        }
+    }
+    uint8_t short_delay_code = (uint8_t)codemap_length;
+    uint8_t long_delay_code = (uint8_t)(codemap_length + 1u);
+
+    uint32_t length_ms = 0u;
+    uint32_t length_pairs = app_dro_encode(division, codes, short_delay_code, long_delay_code, NULL, NULL);
+
+    out_size = (sizeof(struct aymo_score_dro_header) +
+                sizeof(struct aymo_score_dro_v2_header) +
+                codemap_length +
+                (length_pairs * sizeof(struct aymo_score_dro_pair)));
+    out_data = (uint8_t*)malloc(out_size);
+    if (!out_data) {
+        perror("malloc(out_data)");
+        return 2;
+    }
+    uint8_t* ptr = out_data;
+
+    struct aymo_score_dro_header* header = (struct aymo_score_dro_header*)(void*)ptr;
+    memcpy(header->signature, AYMO_DRO_SIGNATURE, sizeof(header->signature));
+    header->version_major = 2u;
+    header->version_minor = 0u;
+    ptr += sizeof(struct aymo_score_dro_header);
+
+    struct aymo_score_dro_v2_header* v2_header = (struct aymo_score_dro_v2_header*)(void*)ptr;
+    ptr += sizeof(struct aymo_score_dro_v2_header);
+
+    memcpy(ptr, codemap, codemap_length);
+    ptr += codemap_length;
+
+    struct aymo_score_dro_pair* pairs = (struct aymo_score_dro_pair*)(void*)ptr;
+    app_dro_encode(division, codes, short_delay_code, long_delay_code, pairs, &length_ms);
+
+    v2_header->length_pairs = length_pairs;
+    v2_header->length_ms = length_ms;
+    v2_header->hardware_type = (uint8_t)aymo_score_dro_v2_hardware_type_opl3;
+    v2_header->format = (uint8_t)aymo_score_dro_v2_format_interleaved;
+    v2_header->compression = 0u;
+    v2_header->short_delay_code = short_delay_code;
+    v2_header->long_delay_code = long_delay_code;
+    v2_header->codemap_length = (uint8_t)codemap_length;
+
+    if (aymo_file_save(app_args.out_path_cstr, out_data, out_size)) {
+        fprintf(stderr, "ERROR: Cannot save \"%s\"\n", app_args.out_path_cstr);
+        return 2;
+    }
+    printf("Saved: %s (%lu bytes, %lu ms)\n", app_args.out_path_cstr,
+           (unsigned long)out_size, (unsigned long)length_ms);
+
+    return app_save_check(division, exact);
+}
+
+
+static int app_run(void)
+{
+    int ret = app_optimize();
+    if (ret) {
+        return ret;
+    }
+
+    if (app_args.verify) {
+        ret = app_verify();
+        if (ret) {
+            fprintf(stderr, "ERROR: Optimized score does not match the original\n");
+            return ret;
+        }
+    }
+
+    if (app_args.out_path_cstr) {
+        ret = app_save();
+        if (ret) {
+            return ret;
+        }
+    }
+
+    return 0;
+}
+
+
+int main(int argc, char** argv)
+{
+    app_return = app_boot();
+    if (app_return) goto catch_;
+
+    app_return = app_args_init(argc, argv);
+    if (app_return) goto catch_;
+
+    app_return = app_args_parse();
+    if (app_return == -1) {  // help
+        app_return = 0;
+        goto finally_;
+    }
+    if (app_return) goto catch_;
+
+    app_return = app_setup();
+    if (app_return) goto catch_;
+
+    app_return = app_run();
+    if (app_return) goto catch_;
+
+    goto finally_;
+
+catch_:
+finally_:
+    app_teardown();
+    return app_return;
+}
+
+
+AYMO_CXX_EXTERN_C_END
@@ -26,9 +26,19 @@ To play via shell pipe, run:
 
     - VLC:
         aymo_tda8425_filter WAVE | vlc --demux=rawaud --rawaud-channels 2 --rawaud-samplerate 47916 -
+
+Input files are memory mapped, and WAVE headings set the input format and
+sample rate; other files are raw samples as per options. Output files are
+mapped too, so that processing runs from the input samples straight into
+the output samples.
+
+To process many files with the same settings, run:
+
+    aymo_tda8425_process --reg-ba F9 --out-dir OUTDIR WAVE...
 */
 
 #include "aymo.h"
+#include "aymo_app_map.h"
 #include "aymo_convert.h"
 #include "aymo_cpu.h"
 #include "aymo_file.h"
@@ -64,8 +74,10 @@ struct app_args {
     // App parameters
     unsigned buffer_length;
     unsigned length;
+    unsigned burst_length;              // benchmark input: signal frames, then silence
     uint32_t sample_rate;
     bool benchmark;
+    bool fixed;                         // int16 fixed-point model
 
     // Input parameters
     const char* in_path_cstr;           // NULL or "-" for stdin
@@ -76,8 +88,14 @@ struct app_args {
     const char* out_path_cstr;          // NULL or "-" for stdout
     bool out_float;
 
+    // Batch parameters
+    const char* out_dir_cstr;           // batch mode, with outputs named after inputs
+    int batch_first;                    // argv index of the first input
+    int batch_count;
+
     // TDA8425 parameters
     const struct aymo_tda8425_vt* tda8425_vt;
+    float silence;
     uint8_t reg_ba;
     uint8_t reg_pp;
     uint8_t reg_sf;
@@ -96,17 +114,29 @@ static clock_t clock_start;
 static clock_t clock_end;
 
 static bool in_stdin;
-static FILE* in_file;
-static uint8_t in_buffer_default[sizeof(float) * 2u];
-static uint8_t* in_buffer_ptr;
+static FILE* in_file;                   // streamed input
+static bool in_mapped;
+static struct app_map in_map;
+static const uint8_t* in_data;          // mapped samples
+static size_t in_length;                // [frames] mapped
+static bool in_float;
+static uint8_t* in_buffer_ptr;          // streamed input block
 
 static uint32_t buffer_length;
+static uint32_t sample_rate;
+static bool fixed;
+static bool chip_ready;
 static struct aymo_tda8425_chip* chip;
+static float* x_buffer_ptr;             // float input block
+static float* y_buffer_ptr;             // float output block
 
 static bool out_stdout;
-static FILE* out_file;
-static uint8_t out_buffer_default[sizeof(float) * 2u];
-static uint8_t* out_buffer_ptr;
+static FILE* out_file;                  // streamed output
+static bool out_mapped;
+static struct app_map out_map;
+static uint8_t* out_data;               // mapped samples
+static bool out_float;
+static uint8_t* out_buffer_ptr;         // streamed output block
 static struct aymo_wave_heading wave_head;
 
 
@@ -150,13 +180,18 @@ static int app_boot(void)
     aymo_tda8425_boot(&math);
 
     buffer_length = 1u;
+    chip_ready = false;
     chip = NULL;
+    x_buffer_ptr = NULL;
+    y_buffer_ptr = NULL;
 
     in_file = NULL;
-    in_buffer_ptr = in_buffer_default;
+    in_mapped = false;
+    in_buffer_ptr = NULL;
 
     out_file = NULL;
-    out_buffer_ptr = out_buffer_default;
+    out_mapped = false;
+    out_buffer_ptr = NULL;
 
     return 0;
 }
@@ -212,6 +247,10 @@ static int app_args_parse(void)
             app_args.benchmark = true;
             continue;
         }
+        if (!strcmp(name, "--fixed")) {
+            app_args.fixed = true;
+            continue;
+        }
         if (!strcmp(name, "--help") || !strcmp(name, "-h")) {
             return app_usage();
         }
@@ -228,6 +267,16 @@ static int app_args_parse(void)
         if (argi >= (app_args.argc - 1)) {
             break;
         }
+        if (!strcmp(name, "--burst-length")) {
+            const char* text = app_args.argv[++argi];
+            errno = 0;
+            app_args.burst_length = strtoul(text, NULL, 0);
+            if (errno) {
+                perror(name);
+                return 1;
+            }
+            continue;
+        }
         if (!strcmp(name, "--buffer-length")) {
             const char* text = app_args.argv[++argi];
             errno = 0;
@@ -257,6 +306,10 @@ static int app_args_parse(void)
             }
             continue;
         }
+        if (!strcmp(name, "--out-dir")) {
+            app_args.out_dir_cstr = app_args.argv[++argi];
+            continue;
+        }
         if (!strcmp(name, "--reg-ba")) {
             const char* text = app_args.argv[++argi];
             errno = 0;
@@ -323,6 +376,20 @@ static int app_args_parse(void)
             app_args.reg_vr = (uint8_t)value;
             continue;
         }
+        if (!strcmp(name, "--silence")) {
+            const char* text = app_args.argv[++argi];
+            errno = 0;
+            app_args.silence = strtof(text, NULL);
+            if (errno) {
+                perror(name);
+                return 1;
+            }
+            if (app_args.silence < 0.f) {
+                fprintf(stderr, "ERROR: Negative silence threshold\n");
+                return 1;
+            }
+            continue;
+        }
         if (!strcmp(name, "--sample-rate")) {
             const char* text = app_args.argv[++argi];
             errno = 0;
@@ -340,6 +407,16 @@ static int app_args_parse(void)
         break;
     }
 
+    if (app_args.out_dir_cstr) {
+        app_args.batch_first = argi;
+        app_args.batch_count = (app_args.argc - argi);
+        if (!app_args.batch_count) {
+            fprintf(stderr, "ERROR: No input files for the batch\n");
+            return 1;
+        }
+        return 0;
+    }
+
     if (argi == (app_args.argc - 2)) {
         const char* text = app_args.argv[argi++];
         if (!strcmp(text, "-")) {
@@ -380,44 +457,100 @@ static int app_setup(void)
         return 2;
     }
     chip = (struct aymo_tda8425_chip*)chip_alignptr;
-    chip->vt = app_args.tda8425_vt;
-    aymo_tda8425_ctor(chip, (float)app_args.sample_rate);
-
-    aymo_tda8425_write(chip, 0x00u, app_args.reg_vl);
-    aymo_tda8425_write(chip, 0x01u, app_args.reg_vr);
-    aymo_tda8425_write(chip, 0x02u, app_args.reg_ba);
-    aymo_tda8425_write(chip, 0x03u, app_args.reg_tr);
-    aymo_tda8425_write(chip, 0x07u, app_args.reg_pp);
-    aymo_tda8425_write(chip, 0x08u, app_args.reg_sf);
 
     buffer_length = app_args.buffer_length;
-    if (buffer_length != 1u) {
-        if (buffer_length < 1u) {
-            buffer_length = 1u;
+    if (buffer_length < 1u) {
+        buffer_length = 1u;
+    }
+    if (buffer_length > (UINT32_MAX / (sizeof(float) * 2u))) {
+        buffer_length = (UINT32_MAX / (sizeof(float) * 2u));
+    }
+    size_t buffer_size = (buffer_length * (sizeof(float) * 2u));
+    in_buffer_ptr = (uint8_t*)calloc(buffer_size, 1u);
+    x_buffer_ptr = (float*)calloc(buffer_size, 1u);
+    y_buffer_ptr = (float*)calloc(buffer_size, 1u);
+    out_buffer_ptr = (uint8_t*)calloc(buffer_size, 1u);
+    if (!in_buffer_ptr || !x_buffer_ptr || !y_buffer_ptr || !out_buffer_ptr) {
+        perror("calloc(buffer_size)");
+        return 2;
+    }
+
+    return 0;
+}
+
+
+static void app_wave_head_setup(size_t frame_total)
+{
+    size_t frame_size = ((out_float ? sizeof(float) : sizeof(int16_t)) * 2u);
+    size_t frame_max = ((UINT32_MAX - sizeof(wave_head)) / frame_size);
+    if (frame_total > frame_max) {
+        frame_total = frame_max;
+    }
+
+    if (out_float) {
+        aymo_wave_heading_setup(&wave_head, AYMO_WAVE_FMT_TYPE_FLOAT, 2u, 32u, sample_rate, (uint32_t)frame_total);
+    }
+    else {
+        aymo_wave_heading_setup(&wave_head, AYMO_WAVE_FMT_TYPE_PCM, 2u, 16u, sample_rate, (uint32_t)frame_total);
+    }
+}
+
+
+// Maps the input file, taking the format from its WAVE heading if any
+static int app_open_input(const char* in_path)
+{
+    if (app_map_open(&in_map, in_path)) {
+        return 1;
+    }
+    in_mapped = true;
+    in_data = (const uint8_t*)in_map.data;
+    size_t data_size = in_map.size;
+
+    if ((data_size >= 4u) && !memcmp(in_data, "RIFF", 4u)) {
+        struct aymo_wave_heading in_head;
+        uint32_t data_offset = 0u;
+        uint32_t size = ((data_size < UINT32_MAX) ? (uint32_t)data_size : UINT32_MAX);
+        if (aymo_wave_heading_parse(&in_head, in_data, size, &data_offset)) {
+            fprintf(stderr, "ERROR: Invalid WAVE file \"%s\"\n", in_path);
+            return 1;
         }
-        if (buffer_length > (UINT32_MAX / (sizeof(float) * 2u))) {
-            buffer_length = (UINT32_MAX / (sizeof(float) * 2u));
+        if ((in_head.wave_fmt_type == AYMO_WAVE_FMT_TYPE_PCM) && (in_head.wave_fmt_sample_bits == 16u)) {
+            in_float = false;
         }
-        size_t buffer_size = (buffer_length * (sizeof(float) * 2u));
-        in_buffer_ptr = (uint8_t*)malloc(buffer_size);
-        if (!in_buffer_ptr) {
-            perror("malloc(in_buffer_size)");
-            return 2;
+        else if ((in_head.wave_fmt_type == AYMO_WAVE_FMT_TYPE_FLOAT) && (in_head.wave_fmt_sample_bits == 32u)) {
+            in_float = true;
         }
-        out_buffer_ptr = (uint8_t*)malloc(buffer_size);
-        if (!out_buffer_ptr) {
-            perror("malloc(out_buffer_size)");
-            return 2;
+        else {
+            fprintf(stderr, "ERROR: Unsupported WAVE sample format of \"%s\"\n", in_path);
+            return 1;
         }
+        if (in_head.wave_fmt_channel_count != 2u) {
+            fprintf(stderr, "ERROR: Unsupported WAVE channel count of \"%s\"\n", in_path);
+            return 1;
+        }
+        sample_rate = in_head.wave_fmt_sample_rate;
+        in_data += data_offset;
+        data_size = in_head.wave_data_size;
     }
 
+    in_length = (data_size / ((in_float ? sizeof(float) : sizeof(int16_t)) * 2u));
+    return 0;
+}
+
+
+static int app_open(const char* in_path, const char* out_path)
+{
+    in_float = app_args.in_float;
+    out_float = app_args.out_float;
+    sample_rate = app_args.sample_rate;
+
     if (app_args.benchmark) {
         in_stdin = false;
         in_file = NULL;
     }
-    else if (!app_args.in_path_cstr || !strcmp(app_args.in_path_cstr, "") || !strcmp(app_args.in_path_cstr, "-")) {
+    else if (!in_path || !strcmp(in_path, "") || !strcmp(in_path, "-")) {
         in_stdin = true;
-        in_file = stdout;
+        in_file = stdin;
 
         #if (defined(__WINDOWS__) || defined(__CYGWIN__))
             errno = 0;
@@ -430,18 +563,38 @@ static int app_setup(void)
     }
     else {
         in_stdin = false;
-        in_file = fopen(app_args.in_path_cstr, "rb");
-        if (!in_file) {
-            perror(app_args.in_path_cstr);
+        if (app_open_input(in_path)) {
             return 1;
         }
     }
 
+    fixed = (app_args.fixed && !in_float && !out_float && (app_args.in_gain < 0.f));
+    if (app_args.benchmark && !fixed) {
+        in_float = true;  // float model all along, without conversions
+        out_float = true;
+    }
+
+    if (!sample_rate) {
+        fprintf(stderr, "ERROR: Null sample rate\n");
+        return 1;
+    }
+    chip->vt = app_args.tda8425_vt;
+    aymo_tda8425_ctor(chip, (float)sample_rate);
+    chip_ready = true;
+
+    aymo_tda8425_write(chip, 0x00u, app_args.reg_vl);
+    aymo_tda8425_write(chip, 0x01u, app_args.reg_vr);
+    aymo_tda8425_write(chip, 0x02u, app_args.reg_ba);
+    aymo_tda8425_write(chip, 0x03u, app_args.reg_tr);
+    aymo_tda8425_write(chip, 0x07u, app_args.reg_pp);
+    aymo_tda8425_write(chip, 0x08u, app_args.reg_sf);
+    aymo_tda8425_set_silence(chip, app_args.silence);
+
     if (app_args.benchmark) {
         out_stdout = false;
         out_file = NULL;
     }
-    else if (!app_args.out_path_cstr || !strcmp(app_args.out_path_cstr, "") || !strcmp(app_args.out_path_cstr, "-")) {
+    else if (!out_path || !strcmp(out_path, "") || !strcmp(out_path, "-")) {
         out_stdout = true;
         out_file = stdout;
 
@@ -454,20 +607,33 @@ static int app_setup(void)
             }
         #endif
     }
+    else if (in_mapped) {
+        // Output size known in advance: map it
+        out_stdout = false;
+        size_t frame_size = ((out_float ? sizeof(float) : sizeof(int16_t)) * 2u);
+        size_t length = in_length;
+        if (app_args.length && (length > app_args.length)) {
+            length = app_args.length;
+        }
+        if (length > ((UINT32_MAX - sizeof(wave_head)) / frame_size)) {
+            fprintf(stderr, "ERROR: Output too long for a WAVE file: \"%s\"\n", out_path);
+            return 1;
+        }
+        if (app_map_create(&out_map, out_path, (sizeof(wave_head) + (length * frame_size)))) {
+            return 1;
+        }
+        out_mapped = true;
+        out_data = ((uint8_t*)out_map.data + sizeof(wave_head));
+    }
     else {
         out_stdout = false;
-        out_file = fopen(app_args.out_path_cstr, "wb");
+        out_file = fopen(out_path, "wb");
         if (!out_file) {
-            perror(app_args.out_path_cstr);
+            perror(out_path);
             return 1;
         }
 
-        if (app_args.out_float) {
-            aymo_wave_heading_setup(&wave_head, AYMO_WAVE_FMT_TYPE_FLOAT, 2u, 32u, app_args.sample_rate, 0u);
-        }
-        else {
-            aymo_wave_heading_setup(&wave_head, AYMO_WAVE_FMT_TYPE_PCM, 2u, 16u, app_args.sample_rate, 0u);
-        }
+        app_wave_head_setup(0u);
         if (fwrite(&wave_head, sizeof(wave_head), 1u, out_file) != 1u) {
             perror("fwrite(wave_head)");
             return 2;
@@ -478,94 +644,174 @@ static int app_setup(void)
 }
 
 
-static void app_teardown(void)
+static int app_close(void)
 {
-    if (chip) {
+    int status = 0;
+
+    if (chip_ready) {
         aymo_tda8425_dtor(chip);
-        aymo_aligned_free(chip);
     }
-    chip = NULL;
+    chip_ready = false;
 
     if (!in_stdin && in_file) {
         fclose(in_file);
     }
     in_file = NULL;
 
-    if (in_buffer_ptr && (in_buffer_ptr != in_buffer_default)) {
-        free(in_buffer_ptr);
+    if (in_mapped && app_map_close(&in_map)) {
+        status = 2;
     }
-    in_buffer_ptr = NULL;
+    in_mapped = false;
+    in_data = NULL;
+    in_length = 0u;
 
     if (!out_stdout && out_file) {
-        fclose(out_file);
+        if (fclose(out_file)) {
+            perror("fclose(out_file)");
+            status = 2;
+        }
     }
     out_file = NULL;
 
-    if (out_buffer_ptr && (out_buffer_ptr != out_buffer_default)) {
-        free(out_buffer_ptr);
+    if (out_mapped && app_map_close(&out_map)) {
+        status = 2;
+    }
+    out_mapped = false;
+    out_data = NULL;
+
+    return status;
+}
+
+
+static void app_teardown(void)
+{
+    (void)app_close();
+
+    if (chip) {
+        aymo_aligned_free(chip);
     }
+    chip = NULL;
+
+    free(in_buffer_ptr);
+    in_buffer_ptr = NULL;
+    free(x_buffer_ptr);
+    x_buffer_ptr = NULL;
+    free(y_buffer_ptr);
+    y_buffer_ptr = NULL;
+    free(out_buffer_ptr);
     out_buffer_ptr = NULL;
 
     buffer_length = 0u;
 }
 
 
+// Fills benchmark input with a square wave burst, followed by silence
+static void app_fill_burst(uint8_t* ptr, size_t frames, size_t frame_offset)
+{
+    for (size_t i = 0u; i < frames; ++i) {
+        size_t frame = (frame_offset + i);
+        float f = 0.f;
+        if (frame < app_args.burst_length) {
+            f = ((frame & 64u) ? .5f : -.5f);
+        }
+        if (in_float) {
+            ((float*)ptr)[(i * 2u) + 0u] = f;
+            ((float*)ptr)[(i * 2u) + 1u] = -f;
+        }
+        else {
+            ((int16_t*)ptr)[(i * 2u) + 0u] = (int16_t)(f * 32767.f);
+            ((int16_t*)ptr)[(i * 2u) + 1u] = (int16_t)(f * -32767.f);
+        }
+    }
+}
+
+
+// Processes a block of frames from input samples to output samples,
+// converting through the float blocks only when needed
+static void app_process_block(size_t length, const void* x, void* y)
+{
+    size_t sample_length = (length * 2u);
+    float in_gain = app_args.in_gain;
+
+    if (fixed) {
+        aymo_tda8425_process_i16(chip, (uint32_t)length, (const int16_t*)x, (int16_t*)y);
+        return;
+    }
+
+    const float* xf = (const float*)x;
+    if (!in_float) {
+        aymo_convert_i16_f32_1(sample_length, (const int16_t*)x, x_buffer_ptr);
+        xf = x_buffer_ptr;
+    }
+    if (in_gain >= 0.f) {
+        for (size_t i = 0u; i < sample_length; ++i) {
+            x_buffer_ptr[i] = (xf[i] * in_gain);
+        }
+        xf = x_buffer_ptr;
+    }
+
+    if (out_float) {
+        aymo_tda8425_process_f32(chip, (uint32_t)length, xf, (float*)y);
+    }
+    else {
+        aymo_tda8425_process_f32(chip, (uint32_t)length, xf, y_buffer_ptr);
+        aymo_convert_f32_i16_1(sample_length, y_buffer_ptr, (int16_t*)y);
+    }
+}
+
+
 static int app_run(void)
 {
-    size_t pending_length = (app_args.length * (size_t)2u);
-    size_t sample_length = ((size_t)buffer_length * 2u);
+    size_t pending_length = app_args.length;
     size_t frame_total = 0u;
-    size_t in_sample_size = (app_args.in_float ? sizeof(float) : sizeof(int16_t));
-    size_t out_sample_size = (app_args.out_float ? sizeof(float) : sizeof(int16_t));
-    uint8_t* in_ptr = in_buffer_ptr;
-    uint8_t* out_ptr = out_buffer_ptr;
-    float in_gain = app_args.in_gain;
+    size_t in_frame_size = ((in_float ? sizeof(float) : sizeof(int16_t)) * 2u);
+    size_t out_frame_size = ((out_float ? sizeof(float) : sizeof(int16_t)) * 2u);
 
     clock_start = clock();
 
     for (;;) {
-        size_t avail_length = sample_length;
+        size_t avail_length = buffer_length;
         if (pending_length) {
             if (avail_length > pending_length) {
                 avail_length = pending_length;
             }
         }
 
-        if (in_file) {
-            avail_length = fread(in_ptr, in_sample_size, avail_length, in_file);
-            avail_length -= (avail_length % 2u);
+        const void* x = in_buffer_ptr;
+        if (in_mapped) {
+            if (avail_length > (in_length - frame_total)) {
+                avail_length = (in_length - frame_total);
+            }
             if (avail_length == 0u) {
                 break;
             }
-            if (!app_args.in_float) {
-                aymo_convert_i16_f32_1(avail_length, (int16_t*)in_ptr, (float*)out_ptr);
-                uint8_t* t = in_ptr;
-                in_ptr = out_ptr;
-                out_ptr = t;
-            }
-            if (in_gain >= 0.f) {
-                for (unsigned i = 0u; i < avail_length; ++i) {
-                    ((float*)in_ptr)[i] *= in_gain;
-                }
+            x = &in_data[frame_total * in_frame_size];
+        }
+        else if (in_file) {
+            avail_length = fread(in_buffer_ptr, in_frame_size, avail_length, in_file);
+            if (avail_length == 0u) {
+                break;
             }
         }
+        else if (app_args.burst_length && (frame_total < ((size_t)app_args.burst_length + buffer_length))) {
+            app_fill_burst(in_buffer_ptr, avail_length, frame_total);
+        }
 
-        aymo_tda8425_process_f32(chip, (avail_length / 2u), (float*)in_ptr, (float*)out_ptr);
+        void* y = out_buffer_ptr;
+        if (out_mapped) {
+            y = &out_data[frame_total * out_frame_size];
+        }
+
+        app_process_block(avail_length, x, y);
 
         if (out_file) {
-            if (!app_args.out_float) {
-                aymo_convert_f32_i16_1(avail_length, (float*)out_ptr, (int16_t*)in_ptr);
-                uint8_t* t = in_ptr;
-                in_ptr = out_ptr;
-                out_ptr = t;
-            }
-            if (fwrite(out_ptr, out_sample_size, avail_length, out_file) != avail_length) {
+            if (fwrite(out_buffer_ptr, out_frame_size, avail_length, out_file) != avail_length) {
                 perror("fwrite(out_buffer)");
                 return 2;
             }
         }
 
-        frame_total += (avail_length / 2u);
+        frame_total += avail_length;
         if (pending_length) {
             pending_length -= avail_length;
             if (!pending_length) {
@@ -574,19 +820,16 @@ static int app_run(void)
         }
     }
 
-    if (out_file && !out_stdout) {
+    if (out_mapped) {
+        app_wave_head_setup(frame_total);
+        memcpy(out_map.data, &wave_head, sizeof(wave_head));
+    }
+    else if (out_file && !out_stdout) {
         if (fseek(out_file, 0, SEEK_SET)) {
             perror("fseek(out_file)");
             return 2;
         }
-        if (app_args.out_float) {
-            aymo_wave_heading_setup(&wave_head, AYMO_WAVE_FMT_TYPE_FLOAT, 2u, 32u,
-                                    app_args.sample_rate, (uint32_t)frame_total);
-        }
-        else {
-            aymo_wave_heading_setup(&wave_head, AYMO_WAVE_FMT_TYPE_PCM, 2u, 16u,
-                                    app_args.sample_rate, (uint32_t)frame_total);
-        }
+        app_wave_head_setup(frame_total);
         if (fwrite(&wave_head, sizeof(wave_head), 1u, out_file) != 1u) {
             perror("fwrite(wave_head)");
             return 2;
@@ -605,6 +848,48 @@ static int app_run(void)
 }
 
 
+// Processes an input file of the batch, into the output directory
+static int app_run_batch_file(const char* in_path)
+{
+    const char* name = in_path;
+    for (const char* ptr = in_path; *ptr; ++ptr) {
+        if ((*ptr == '/') || (*ptr == '\\')) {
+            name = (ptr + 1);
+        }
+    }
+
+    size_t dir_length = strlen(app_args.out_dir_cstr);
+    size_t name_length = strlen(name);
+    char* out_path = (char*)malloc(dir_length + 1u + name_length + 1u);
+    if (!out_path) {
+        perror("malloc(out_path)");
+        return 2;
+    }
+    memcpy(out_path, app_args.out_dir_cstr, dir_length);
+    out_path[dir_length] = '/';
+    memcpy(&out_path[dir_length + 1u], name, (name_length + 1u));
+
+    int status = 0;
+    if (!strcmp(in_path, "-") || !strcmp(in_path, out_path)) {
+        fprintf(stderr, "ERROR: Invalid batch input file: \"%s\"\n", in_path);
+        status = 1;
+    }
+    if (!status) {
+        status = app_open(in_path, out_path);
+    }
+    if (!status) {
+        status = app_run();
+    }
+    int close_status = app_close();
+    if (!status) {
+        status = close_status;
+    }
+
+    free(out_path);
+    return status;
+}
+
+
 int main(int argc, char** argv)
 {
     app_return = app_boot();
@@ -623,8 +908,22 @@ int main(int argc, char** argv)
     app_return = app_setup();
     if (app_return) goto catch_;
 
-    app_return = app_run();
-    if (app_return) goto catch_;
+    if (app_args.out_dir_cstr) {
+        for (int i = 0; i < app_args.batch_count; ++i) {
+            app_return = app_run_batch_file(app_args.argv[app_args.batch_first + i]);
+            if (app_return) goto catch_;
+        }
+    }
+    else {
+        app_return = app_open(app_args.in_path_cstr, app_args.out_path_cstr);
+        if (app_return) goto catch_;
+
+        app_return = app_run();
+        if (app_return) goto catch_;
+
+        app_return = app_close();
+        if (app_return) goto catch_;
+    }
 
     goto finally_;
 
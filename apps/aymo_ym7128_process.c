@@ -26,9 +26,19 @@ To play via shell pipe, run:
 
     - VLC:
         aymo_ym7128_filter WAVE | vlc --demux=rawaud --rawaud-channels 2 --rawaud-samplerate 47916 -
+
+Input files are memory mapped, and WAVE headings set the input format;
+other files are raw samples as per options. Output files are mapped too,
+so that processing runs from the input samples straight into the output
+samples.
+
+To process many files with the same settings, run:
+
+    aymo_ym7128_process --preset gold/chapel --out-dir OUTDIR WAVE...
 */
 
 #include "aymo.h"
+#include "aymo_app_map.h"
 #include "aymo_convert.h"
 #include "aymo_cpu.h"
 #include "aymo_file.h"
@@ -257,6 +267,11 @@ struct app_args {
     const char* out_path_cstr;          // NULL or "-" for stdout
     bool out_float;
 
+    // Batch parameters
+    const char* out_dir_cstr;           // batch mode, with outputs named after inputs
+    int batch_first;                    // argv index of the first input
+    int batch_count;
+
     // YM7128 parameters
     const struct aymo_ym7128_vt* ym7128_vt;
     uint8_t regs[31];
@@ -270,18 +285,28 @@ static clock_t clock_start;
 static clock_t clock_end;
 
 static bool in_stdin;
-static bool in_stereo;
-static FILE* in_file;
-static uint8_t in_buffer_default[sizeof(float) * 2u];
-static uint8_t* in_buffer_ptr;
+static FILE* in_file;                   // streamed input
+static bool in_mapped;
+static struct app_map in_map;
+static const uint8_t* in_data;          // mapped samples
+static size_t in_length;                // [frames] mapped
+static bool in_float;
+static bool in_stereo;                  // left channel only
+static uint8_t* in_buffer_ptr;          // streamed input block
 
 static uint32_t buffer_length;
+static bool chip_ready;
 static struct aymo_ym7128_chip* chip;
+static uint8_t* x_buffer_ptr;           // mono input block
+static uint8_t* y_buffer_ptr;           // output block, before conversion
 
 static bool out_stdout;
-static FILE* out_file;
-static uint8_t out_buffer_default[sizeof(float) * 2u];
-static uint8_t* out_buffer_ptr;
+static FILE* out_file;                  // streamed output
+static bool out_mapped;
+static struct app_map out_map;
+static uint8_t* out_data;               // mapped samples
+static bool out_float;
+static uint8_t* out_buffer_ptr;         // streamed output block, stereo, oversampled
 static struct aymo_wave_heading wave_head;
 
 
@@ -325,13 +350,18 @@ static int app_boot(void)
     aymo_ym7128_boot();
 
     buffer_length = 1u;
+    chip_ready = false;
     chip = NULL;
+    x_buffer_ptr = NULL;
+    y_buffer_ptr = NULL;
 
     in_file = NULL;
-    in_buffer_ptr = in_buffer_default;
+    in_mapped = false;
+    in_buffer_ptr = NULL;
 
     out_file = NULL;
-    out_buffer_ptr = out_buffer_default;
+    out_mapped = false;
+    out_buffer_ptr = NULL;
 
     return 0;
 }
@@ -430,6 +460,10 @@ static int app_args_parse(void)
             }
             continue;
         }
+        if (!strcmp(name, "--out-dir")) {
+            app_args.out_dir_cstr = app_args.argv[++argi];
+            continue;
+        }
         if (!strcmp(name, "--preset")) {
             const char* text = app_args.argv[++argi];
             const struct app_preset* preset = app_presets;
@@ -470,6 +504,16 @@ static int app_args_parse(void)
         break;
     }
 
+    if (app_args.out_dir_cstr) {
+        app_args.batch_first = argi;
+        app_args.batch_count = (app_args.argc - argi);
+        if (!app_args.batch_count) {
+            fprintf(stderr, "ERROR: No input files for the batch\n");
+            return 1;
+        }
+        return 0;
+    }
+
     if (argi == (app_args.argc - 2)) {
         const char* text = app_args.argv[argi++];
         if (!strcmp(text, "-")) {
@@ -510,41 +554,106 @@ static int app_setup(void)
         return 2;
     }
     chip = (struct aymo_ym7128_chip*)chip_alignptr;
-    chip->vt = app_args.ym7128_vt;
-    aymo_ym7128_ctor(chip);
 
-    for (int i = 0; i < AYMO_YM7128_REG_COUNT; ++i) {
-        aymo_ym7128_write(chip, (uint16_t)i, app_args.regs[i]);
+    buffer_length = app_args.buffer_length;
+    if (buffer_length < 1u) {
+        buffer_length = 1u;
+    }
+    if (buffer_length > (UINT32_MAX / (sizeof(float) * 4u))) {
+        buffer_length = (UINT32_MAX / (sizeof(float) * 4u));
+    }
+    size_t buffer_size = (buffer_length * (sizeof(float) * 2u));
+    in_buffer_ptr = (uint8_t*)calloc(buffer_size, 1u);
+    x_buffer_ptr = (uint8_t*)calloc(buffer_size, 1u);
+    y_buffer_ptr = (uint8_t*)calloc(buffer_size, 2u);
+    out_buffer_ptr = (uint8_t*)calloc(buffer_size, 2u);
+    if (!in_buffer_ptr || !x_buffer_ptr || !y_buffer_ptr || !out_buffer_ptr) {
+        perror("calloc(buffer_size)");
+        return 2;
     }
 
-    buffer_length = app_args.buffer_length;
-    if (buffer_length != 1u) {
-        if (buffer_length < 1u) {
-            buffer_length = 1u;
+    return 0;
+}
+
+
+static void app_wave_head_setup(size_t frame_total)
+{
+    size_t frame_size = ((out_float ? sizeof(float) : sizeof(int16_t)) * 2u);
+    size_t frame_max = ((UINT32_MAX - sizeof(wave_head)) / frame_size);
+    if (frame_total > frame_max) {
+        frame_total = frame_max;
+    }
+
+    if (out_float) {
+        aymo_wave_heading_setup(&wave_head, AYMO_WAVE_FMT_TYPE_FLOAT,
+                                2u, 32u, (uint32_t)AYMO_YM7128_OUTPUT_RATE, (uint32_t)frame_total);
+    }
+    else {
+        aymo_wave_heading_setup(&wave_head, AYMO_WAVE_FMT_TYPE_PCM,
+                                2u, 16u, (uint32_t)AYMO_YM7128_OUTPUT_RATE, (uint32_t)frame_total);
+    }
+}
+
+
+// Maps the input file, taking the format from its WAVE heading if any
+static int app_open_input(const char* in_path)
+{
+    if (app_map_open(&in_map, in_path)) {
+        return 1;
+    }
+    in_mapped = true;
+    in_data = (const uint8_t*)in_map.data;
+    size_t data_size = in_map.size;
+
+    if ((data_size >= 4u) && !memcmp(in_data, "RIFF", 4u)) {
+        struct aymo_wave_heading in_head;
+        uint32_t data_offset = 0u;
+        uint32_t size = ((data_size < UINT32_MAX) ? (uint32_t)data_size : UINT32_MAX);
+        if (aymo_wave_heading_parse(&in_head, in_data, size, &data_offset)) {
+            fprintf(stderr, "ERROR: Invalid WAVE file \"%s\"\n", in_path);
+            return 1;
         }
-        if (buffer_length > (UINT32_MAX / (sizeof(float) * 2u))) {
-            buffer_length = (UINT32_MAX / (sizeof(float) * 2u));
+        if ((in_head.wave_fmt_type == AYMO_WAVE_FMT_TYPE_PCM) && (in_head.wave_fmt_sample_bits == 16u)) {
+            in_float = false;
         }
-        size_t buffer_size = (buffer_length * (sizeof(float) * 2u));
-        in_buffer_ptr = (uint8_t*)malloc(buffer_size);
-        if (!in_buffer_ptr) {
-            perror("malloc(in_buffer_size)");
-            return 2;
+        else if ((in_head.wave_fmt_type == AYMO_WAVE_FMT_TYPE_FLOAT) && (in_head.wave_fmt_sample_bits == 32u)) {
+            in_float = true;
         }
-        out_buffer_ptr = (uint8_t*)malloc(buffer_size);
-        if (!out_buffer_ptr) {
-            perror("malloc(out_buffer_size)");
-            return 2;
+        else {
+            fprintf(stderr, "ERROR: Unsupported WAVE sample format of \"%s\"\n", in_path);
+            return 1;
+        }
+        if ((in_head.wave_fmt_channel_count < 1u) || (in_head.wave_fmt_channel_count > 2u)) {
+            fprintf(stderr, "ERROR: Unsupported WAVE channel count of \"%s\"\n", in_path);
+            return 1;
         }
+        in_stereo = (in_head.wave_fmt_channel_count == 2u);
+        if (in_head.wave_fmt_sample_rate != (uint32_t)AYMO_YM7128_INPUT_RATE) {
+            fprintf(stderr, "WARNING: Sample rate of \"%s\" is not %u Hz\n",
+                    in_path, (unsigned)AYMO_YM7128_INPUT_RATE);
+        }
+        in_data += data_offset;
+        data_size = in_head.wave_data_size;
     }
 
+    in_length = (data_size / ((in_float ? sizeof(float) : sizeof(int16_t)) * (in_stereo ? 2u : 1u)));
+    return 0;
+}
+
+
+static int app_open(const char* in_path, const char* out_path)
+{
+    in_float = app_args.in_float;
+    in_stereo = app_args.in_stereo;
+    out_float = app_args.out_float;
+
     if (app_args.benchmark) {
         in_stdin = false;
         in_file = NULL;
     }
-    else if (!app_args.in_path_cstr || !strcmp(app_args.in_path_cstr, "") || !strcmp(app_args.in_path_cstr, "-")) {
+    else if (!in_path || !strcmp(in_path, "") || !strcmp(in_path, "-")) {
         in_stdin = true;
-        in_file = stdout;
+        in_file = stdin;
 
         #if (defined(__WINDOWS__) || defined(__CYGWIN__))
             errno = 0;
@@ -557,18 +666,24 @@ static int app_setup(void)
     }
     else {
         in_stdin = false;
-        in_file = fopen(app_args.in_path_cstr, "rb");
-        if (!in_file) {
-            perror(app_args.in_path_cstr);
+        if (app_open_input(in_path)) {
             return 1;
         }
     }
 
+    chip->vt = app_args.ym7128_vt;
+    aymo_ym7128_ctor(chip);
+    chip_ready = true;
+
+    for (int i = 0; i < AYMO_YM7128_REG_COUNT; ++i) {
+        aymo_ym7128_write(chip, (uint16_t)i, app_args.regs[i]);
+    }
+
     if (app_args.benchmark) {
         out_stdout = false;
         out_file = NULL;
     }
-    else if (!app_args.out_path_cstr || !strcmp(app_args.out_path_cstr, "") || !strcmp(app_args.out_path_cstr, "-")) {
+    else if (!out_path || !strcmp(out_path, "") || !strcmp(out_path, "-")) {
         out_stdout = true;
         out_file = stdout;
 
@@ -581,22 +696,33 @@ static int app_setup(void)
             }
         #endif
     }
+    else if (in_mapped) {
+        // Output size known in advance: map it
+        out_stdout = false;
+        size_t frame_size = ((out_float ? sizeof(float) : sizeof(int16_t)) * 2u);
+        size_t length = in_length;
+        if (app_args.length && (length > app_args.length)) {
+            length = app_args.length;
+        }
+        if (length > ((UINT32_MAX - sizeof(wave_head)) / (frame_size * 2u))) {
+            fprintf(stderr, "ERROR: Output too long for a WAVE file: \"%s\"\n", out_path);
+            return 1;
+        }
+        if (app_map_create(&out_map, out_path, (sizeof(wave_head) + (length * frame_size * 2u)))) {
+            return 1;
+        }
+        out_mapped = true;
+        out_data = ((uint8_t*)out_map.data + sizeof(wave_head));
+    }
     else {
         out_stdout = false;
-        out_file = fopen(app_args.out_path_cstr, "wb");
+        out_file = fopen(out_path, "wb");
         if (!out_file) {
-            perror(app_args.out_path_cstr);
+            perror(out_path);
             return 1;
         }
 
-        if (app_args.out_float) {
-            aymo_wave_heading_setup(&wave_head, AYMO_WAVE_FMT_TYPE_FLOAT,
-                                    2u, 32u, (uint32_t)AYMO_YM7128_OUTPUT_RATE, 0u);
-        }
-        else {
-            aymo_wave_heading_setup(&wave_head, AYMO_WAVE_FMT_TYPE_PCM,
-                                    2u, 16u, (uint32_t)AYMO_YM7128_OUTPUT_RATE, 0u);
-        }
+        app_wave_head_setup(0u);
         if (fwrite(&wave_head, sizeof(wave_head), 1u, out_file) != 1u) {
             perror("fwrite(wave_head)");
             return 2;
@@ -607,92 +733,162 @@ static int app_setup(void)
 }
 
 
-static void app_teardown(void)
+static int app_close(void)
 {
-    if (chip) {
+    int status = 0;
+
+    if (chip_ready) {
         aymo_ym7128_dtor(chip);
-        aymo_aligned_free(chip);
     }
-    chip = NULL;
+    chip_ready = false;
 
     if (!in_stdin && in_file) {
         fclose(in_file);
     }
     in_file = NULL;
 
-    if (in_buffer_ptr && (in_buffer_ptr != in_buffer_default)) {
-        free(in_buffer_ptr);
+    if (in_mapped && app_map_close(&in_map)) {
+        status = 2;
     }
-    in_buffer_ptr = NULL;
+    in_mapped = false;
+    in_data = NULL;
+    in_length = 0u;
 
     if (!out_stdout && out_file) {
-        fclose(out_file);
+        if (fclose(out_file)) {
+            perror("fclose(out_file)");
+            status = 2;
+        }
     }
     out_file = NULL;
 
-    if (out_buffer_ptr && (out_buffer_ptr != out_buffer_default)) {
-        free(out_buffer_ptr);
+    if (out_mapped && app_map_close(&out_map)) {
+        status = 2;
+    }
+    out_mapped = false;
+    out_data = NULL;
+
+    return status;
+}
+
+
+static void app_teardown(void)
+{
+    (void)app_close();
+
+    if (chip) {
+        aymo_aligned_free(chip);
     }
+    chip = NULL;
+
+    free(in_buffer_ptr);
+    in_buffer_ptr = NULL;
+    free(x_buffer_ptr);
+    x_buffer_ptr = NULL;
+    free(y_buffer_ptr);
+    y_buffer_ptr = NULL;
+    free(out_buffer_ptr);
     out_buffer_ptr = NULL;
 
     buffer_length = 0u;
 }
 
 
+// Processes a block of input samples into twice as many stereo output frames,
+// converting and taking the left channel through the scratch blocks only when needed
+static void app_process_block(size_t length, const void* x, void* y)
+{
+    if (in_float && out_float) {
+        // Float model all along, without conversions
+        const float* xf = (const float*)x;
+        if (in_stereo) {
+            for (size_t i = 0u; i < length; ++i) {
+                ((float*)(void*)x_buffer_ptr)[i] = xf[i * 2u];
+            }
+            xf = (const float*)(const void*)x_buffer_ptr;
+        }
+        aymo_ym7128_process_f32(chip, (uint32_t)length, xf, (float*)y);
+        return;
+    }
+
+    const int16_t* xi = (const int16_t*)x;
+    if (in_float) {
+        const float* xf = (const float*)x;
+        if (in_stereo) {
+            for (size_t i = 0u; i < length; ++i) {
+                ((float*)(void*)y_buffer_ptr)[i] = xf[i * 2u];
+            }
+            xf = (const float*)(const void*)y_buffer_ptr;
+        }
+        aymo_convert_f32_i16_1(length, xf, (int16_t*)(void*)x_buffer_ptr);
+        xi = (const int16_t*)(const void*)x_buffer_ptr;
+    }
+    else if (in_stereo) {
+        for (size_t i = 0u; i < length; ++i) {
+            ((int16_t*)(void*)x_buffer_ptr)[i] = xi[i * 2u];
+        }
+        xi = (const int16_t*)(const void*)x_buffer_ptr;
+    }
+
+    if (out_float) {
+        aymo_ym7128_process_i16(chip, (uint32_t)length, xi, (int16_t*)(void*)y_buffer_ptr);
+        aymo_convert_i16_f32_1((length * 4u), (const int16_t*)(const void*)y_buffer_ptr, (float*)y);
+    }
+    else {
+        aymo_ym7128_process_i16(chip, (uint32_t)length, xi, (int16_t*)y);
+    }
+}
+
+
 static int app_run(void)
 {
     size_t pending_length = app_args.length;
-    size_t sample_length = buffer_length;
-    size_t frame_total = 0u;
-    size_t in_sample_size = (app_args.in_float ? sizeof(float) : sizeof(int16_t));
-    size_t out_sample_size = (app_args.out_float ? sizeof(float) : sizeof(int16_t));
-    uint8_t* in_ptr = in_buffer_ptr;
-    uint8_t* out_ptr = out_buffer_ptr;
+    size_t sample_total = 0u;
+    size_t in_frame_size = ((in_float ? sizeof(float) : sizeof(int16_t)) * (in_stereo ? 2u : 1u));
+    size_t out_block_size = ((out_float ? sizeof(float) : sizeof(int16_t)) * 4u);  // per input sample
 
     clock_start = clock();
 
     for (;;) {
-        size_t avail_length = sample_length;
+        size_t avail_length = buffer_length;
         if (pending_length) {
             if (avail_length > pending_length) {
                 avail_length = pending_length;
             }
         }
 
-        if (in_file) {
-            avail_length = fread(in_ptr, in_sample_size, avail_length, in_file);
+        const void* x = in_buffer_ptr;
+        if (in_mapped) {
+            if (avail_length > (in_length - sample_total)) {
+                avail_length = (in_length - sample_total);
+            }
             if (avail_length == 0u) {
                 break;
             }
-            if (app_args.in_float) {
-                aymo_convert_f32_i16_1(avail_length, (float*)in_ptr, (int16_t*)out_ptr);
-                uint8_t* t = in_ptr;
-                in_ptr = out_ptr;
-                out_ptr = t;
-            }
-            if (in_stereo) {
-                for (unsigned i = 0u; i < avail_length; i += 2u) {
-                    ((int16_t*)in_ptr)[i / 2u] = ((int16_t*)in_ptr)[i];  // left only
-                }
+            x = &in_data[sample_total * in_frame_size];
+        }
+        else if (in_file) {
+            avail_length = fread(in_buffer_ptr, in_frame_size, avail_length, in_file);
+            if (avail_length == 0u) {
+                break;
             }
         }
 
-        aymo_ym7128_process_i16(chip, (uint32_t)avail_length, (int16_t*)in_ptr, (int16_t*)out_ptr);
+        void* y = out_buffer_ptr;
+        if (out_mapped) {
+            y = &out_data[sample_total * out_block_size];
+        }
+
+        app_process_block(avail_length, x, y);
 
         if (out_file) {
-            if (app_args.out_float) {
-                aymo_convert_i16_f32_1(avail_length, (int16_t*)out_ptr, (float*)in_ptr);
-                uint8_t* t = in_ptr;
-                in_ptr = out_ptr;
-                out_ptr = t;
-            }
-            if (fwrite(out_ptr, out_sample_size, (avail_length * 2u), out_file) != avail_length) {
+            if (fwrite(out_buffer_ptr, out_block_size, avail_length, out_file) != avail_length) {
                 perror("fwrite(out_buffer)");
                 return 2;
             }
         }
 
-        frame_total += avail_length;
+        sample_total += avail_length;
         if (pending_length) {
             pending_length -= avail_length;
             if (!pending_length) {
@@ -701,19 +897,16 @@ static int app_run(void)
         }
     }
 
-    if (out_file && !out_stdout) {
+    if (out_mapped) {
+        app_wave_head_setup(sample_total * 2u);
+        memcpy(out_map.data, &wave_head, sizeof(wave_head));
+    }
+    else if (out_file && !out_stdout) {
         if (fseek(out_file, 0, SEEK_SET)) {
             perror("fseek(out_file)");
             return 2;
         }
-        if (app_args.out_float) {
-            aymo_wave_heading_setup(&wave_head, AYMO_WAVE_FMT_TYPE_FLOAT, 2u, 32u,
-                                    (uint32_t)AYMO_YM7128_OUTPUT_RATE, (uint32_t)frame_total);
-        }
-        else {
-            aymo_wave_heading_setup(&wave_head, AYMO_WAVE_FMT_TYPE_PCM, 2u, 16u,
-                                    (uint32_t)AYMO_YM7128_OUTPUT_RATE, (uint32_t)frame_total);
-        }
+        app_wave_head_setup(sample_total * 2u);
         if (fwrite(&wave_head, sizeof(wave_head), 1u, out_file) != 1u) {
             perror("fwrite(wave_head)");
             return 2;
@@ -732,6 +925,48 @@ static int app_run(void)
 }
 
 
+// Processes an input file of the batch, into the output directory
+static int app_run_batch_file(const char* in_path)
+{
+    const char* name = in_path;
+    for (const char* ptr = in_path; *ptr; ++ptr) {
+        if ((*ptr == '/') || (*ptr == '\\')) {
+            name = (ptr + 1);
+        }
+    }
+
+    size_t dir_length = strlen(app_args.out_dir_cstr);
+    size_t name_length = strlen(name);
+    char* out_path = (char*)malloc(dir_length + 1u + name_length + 1u);
+    if (!out_path) {
+        perror("malloc(out_path)");
+        return 2;
+    }
+    memcpy(out_path, app_args.out_dir_cstr, dir_length);
+    out_path[dir_length] = '/';
+    memcpy(&out_path[dir_length + 1u], name, (name_length + 1u));
+
+    int status = 0;
+    if (!strcmp(in_path, "-") || !strcmp(in_path, out_path)) {
+        fprintf(stderr, "ERROR: Invalid batch input file: \"%s\"\n", in_path);
+        status = 1;
+    }
+    if (!status) {
+        status = app_open(in_path, out_path);
+    }
+    if (!status) {
+        status = app_run();
+    }
+    int close_status = app_close();
+    if (!status) {
+        status = close_status;
+    }
+
+    free(out_path);
+    return status;
+}
+
+
 int main(int argc, char** argv)
 {
     app_return = app_boot();
@@ -750,8 +985,22 @@ int main(int argc, char** argv)
     app_return = app_setup();
     if (app_return) goto catch_;
 
-    app_return = app_run();
-    if (app_return) goto catch_;
+    if (app_args.out_dir_cstr) {
+        for (int i = 0; i < app_args.batch_count; ++i) {
+            app_return = app_run_batch_file(app_args.argv[app_args.batch_first + i]);
+            if (app_return) goto catch_;
+        }
+    }
+    else {
+        app_return = app_open(app_args.in_path_cstr, app_args.out_path_cstr);
+        if (app_return) goto catch_;
+
+        app_return = app_run();
+        if (app_return) goto catch_;
+
+        app_return = app_close();
+        if (app_return) goto catch_;
+    }
 
     goto finally_;
 
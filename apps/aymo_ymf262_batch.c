@@ -0,0 +1,988 @@
+/*
+AYMO - Accelerated YaMaha Operator
+Copyright (c) 2023-2024 Andrea Zoppi.
+
+This file is part of AYMO.
+
+AYMO is free software: you can redistribute it and/or modify it under the
+terms of the GNU Lesser General Public License as published by the Free
+Software Foundation, either version 2.1 of the License, or (at your option)
+any later version.
+
+AYMO is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with AYMO. If not, see <https://www.gnu.org/licenses/>.
+
+---
+
+Renders many scores to WAVE files at once, one per worker thread:
+
+    aymo_ymf262_batch --threads 16 --out-dir wav/ first.imf second.vgm third.dro
+
+    aymo_ymf262_batch --out-dir wav/ --list scores.txt
+
+Scores are sorted by file size, largest first, and dealt round-robin to the
+workers. Each worker renders its own scores first, then steals the largest
+pending ones from the busiest worker, so that the longest renders start early
+and no core idles while there is work left.
+
+Each worker reuses its chip and output buffer across scores.
+Outputs are named after the score file, with the ".wav" extension.
+Scores whose names differ only by directory, extension or letter case would
+share an output file, so they are refused before rendering.
+*/
+
+#include "aymo.h"
+#include "aymo_app_map.h"
+#include "aymo_app_render.h"
+#include "aymo_app_thread.h"
+#include "aymo_cpu.h"
+#include "aymo_file.h"
+#include "aymo_score.h"
+#include "aymo_score_dro.h"
+#include "aymo_score_imf.h"
+#include "aymo_score_raw.h"
+#include "aymo_score_ref.h"
+#include "aymo_score_vgm.h"
+#include "aymo_wave.h"
+#include "aymo_ymf262.h"
+
+#include <assert.h>
+#include <ctype.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+AYMO_CXX_EXTERN_C_BEGIN
+
+
+#define APP_THREAD_MAX  256u
+
+
+struct app_args {
+    int argc;
+    char** argv;
+
+    // App parameters
+    unsigned loops;
+    unsigned threads;                   // 0 = one per CPU
+    bool benchmark;
+    bool thread_stats;
+
+    // Score parameters
+    const char* list_path_cstr;         // NULL for none
+    const char* score_type_cstr;        // NULL uses score file extension
+    enum aymo_score_type score_type;
+    unsigned score_after;
+    int score_latency;
+    int score_first;                    // first positional score path
+    int score_count;
+
+    // Output parameters
+    const char* out_dir_cstr;
+    uint32_t out_frame_length;
+    bool out_quad;
+
+    // YMF262 parameters
+    const struct aymo_ymf262_vt* ymf262_vt;
+};
+
+
+struct app_job {
+    const char* path;
+    uint64_t size;                      // [bytes] score file
+    enum aymo_score_type score_type;
+};
+
+
+union app_scores {
+    struct aymo_score_instance base;
+    struct aymo_score_dro_instance dro;
+    struct aymo_score_imf_instance imf;
+    struct aymo_score_raw_instance raw;
+    struct aymo_score_ref_instance ref;
+    struct aymo_score_vgm_instance vgm;
+};
+
+
+struct app_worker {
+    struct app_thread thread;
+    bool started;
+
+    struct aymo_ymf262_chip* chip;
+    union app_scores score;
+    struct app_map score_map;
+    int16_t* out_buffer_ptr;
+    char* out_path_ptr;
+    size_t out_path_size;
+
+    // Own jobs: job_order[job_next ... job_end), taken by owner and thieves alike
+    uint32_t job_end;
+    volatile uint32_t job_next;
+
+    // Statistics
+    uint64_t frame_total;
+    double busy_seconds;
+    unsigned done_count;
+    unsigned stolen_count;
+    unsigned failed_count;
+};
+
+
+static int app_return;
+
+static struct app_args app_args;
+
+static void* list_data;
+static size_t list_size;
+
+static struct app_job* jobs;
+static uint32_t* job_order;             // sorted jobs, dealt in per-worker slices
+static uint32_t job_count;
+static unsigned job_invalid_count;      // skipped before rendering
+
+static struct app_worker* workers;
+static unsigned worker_count;
+static uint32_t out_frame_length;
+
+
+static void* aymo_aligned_alloc(size_t size, size_t align)
+{
+    assert(align);
+    assert(size < (SIZE_MAX - align - align));
+
+    void* allocptr = calloc((size + align + align), 1u);
+    if (allocptr) {
+        uintptr_t alignaddr = ((uintptr_t)(void*)allocptr + align);
+        uintptr_t offset = (alignaddr % align);
+        alignaddr += ((align - offset) % align);
+        void* alignptr = (void*)alignaddr;
+        uintptr_t refaddr = (alignaddr - sizeof(void*));
+        void** refptr = (void**)(void*)refaddr;
+        *refptr = allocptr;
+        return alignptr;
+    }
+    return NULL;
+}
+
+
+static void aymo_aligned_free(void* alignptr)
+{
+    if (alignptr) {
+        uintptr_t alignaddr = (uintptr_t)alignptr;
+        uintptr_t refaddr = (alignaddr - sizeof(void*));
+        void** refptr = (void**)(void*)refaddr;
+        void* allocptr = *refptr;
+        free(allocptr);
+    }
+}
+
+
+static int app_boot(void)
+{
+    app_return = 2;
+
+    aymo_boot();
+    aymo_ymf262_boot();
+
+    list_data = NULL;
+    list_size = 0u;
+
+    jobs = NULL;
+    job_order = NULL;
+    job_count = 0u;
+    job_invalid_count = 0u;
+
+    workers = NULL;
+    worker_count = 0u;
+    out_frame_length = 1u;
+
+    return 0;
+}
+
+
+static int app_args_init(int argc, char** argv)
+{
+    memset(&app_args, 0, sizeof(app_args));
+
+    app_args.argc = argc;
+    app_args.argv = argv;
+
+    app_args.loops = 1u;
+
+    app_args.score_type = aymo_score_type_unknown;
+    app_args.score_latency = AYMO_YMF262_REG_SAMPLE_LATENCY;
+
+    app_args.out_frame_length = 4096u;
+
+    app_args.ymf262_vt = aymo_ymf262_get_best_vt();
+
+    return 0;
+}
+
+
+static int app_usage(void)
+{
+    printf("Usage: aymo_ymf262_batch [OPTIONS] [SCORE...]\n");
+    printf("\n");
+    printf("Renders each SCORE to OUT_DIR/NAME.wav, NAME being the score file name.\n");
+    printf("\n");
+    printf("Options:\n");
+    printf("  --benchmark         Renders without writing files, printing statistics only\n");
+    printf("  --buffer-size N     Frames rendered per block (default: 4096)\n");
+    printf("  --cpu-ext TAG       YMF262 implementation (default: best)\n");
+    printf("  --help, -h          Shows this help\n");
+    printf("  --list PATH         Reads more score paths from a file, one per line; # comments\n");
+    printf("  --loops N           Plays each score N times (default: 1)\n");
+    printf("  --out-dir DIR       Output directory; required unless --benchmark\n");
+    printf("  --out-quad          Writes 4 channels instead of 2\n");
+    printf("  --score-after N     Frames of silence rendered after each score (default: 0)\n");
+    printf("  --score-latency N   Frames after each register write; negative queues writes (default: %d)\n",
+           (int)AYMO_YMF262_REG_SAMPLE_LATENCY);
+    printf("  --score-type EXT    Score type of all scores, instead of their file extensions\n");
+    printf("  --thread-stats      Prints per-thread statistics\n");
+    printf("  --threads N         Worker threads; 0 uses one per CPU (default: 0)\n");
+
+    return -1;  // help
+}
+
+
+static int app_args_parse(void)
+{
+    int argi;
+
+    for (argi = 1; argi < app_args.argc; ++argi) {
+        const char* name = app_args.argv[argi];
+
+        if (!strcmp(name, "--")) {
+            ++argi;
+            break;
+        }
+
+        // Unary options
+        if (!strcmp(name, "--benchmark")) {
+            app_args.benchmark = true;
+            continue;
+        }
+        if (!strcmp(name, "--help") || !strcmp(name, "-h")) {
+            return app_usage();
+        }
+        if (!strcmp(name, "--out-quad")) {
+            app_args.out_quad = true;
+            continue;
+        }
+        if (!strcmp(name, "--thread-stats")) {
+            app_args.thread_stats = true;
+            continue;
+        }
+
+        // Binary options
+        if (argi >= (app_args.argc - 1)) {
+            break;
+        }
+        if (!strcmp(name, "--buffer-size")) {
+            const char* text = app_args.argv[++argi];
+            errno = 0;
+            app_args.out_frame_length = (uint32_t)strtoul(text, NULL, 0);
+            if (errno) {
+                perror(name);
+                return 1;
+            }
+            continue;
+        }
+        if (!strcmp(name, "--cpu-ext")) {
+            const char* text = app_args.argv[++argi];
+            app_args.ymf262_vt = aymo_ymf262_get_vt(text);
+            if (!app_args.ymf262_vt) {
+                fprintf(stderr, "ERROR: Unsupported CPU extensions tag: \"%s\"\n", text);
+                return 1;
+            }
+            continue;
+        }
+        if (!strcmp(name, "--list")) {
+            app_args.list_path_cstr = app_args.argv[++argi];
+            continue;
+        }
+        if (!strcmp(name, "--loops")) {
+            const char* text = app_args.argv[++argi];
+            errno = 0;
+            app_args.loops = (unsigned)strtoul(text, NULL, 0);
+            if (errno) {
+                perror(name);
+                return 1;
+            }
+            if (!app_args.loops) {
+                fprintf(stderr, "ERROR: Endless loops not allowed in batch\n");
+                return 1;
+            }
+            continue;
+        }
+        if (!strcmp(name, "--out-dir")) {
+            app_args.out_dir_cstr = app_args.argv[++argi];
+            continue;
+        }
+        if (!strcmp(name, "--score-after")) {
+            const char* text = app_args.argv[++argi];
+            errno = 0;
+            app_args.score_after = (unsigned)strtoul(text, NULL, 0);
+            if (errno) {
+                perror(name);
+                return 1;
+            }
+            continue;
+        }
+        if (!strcmp(name, "--score-latency")) {
+            const char* text = app_args.argv[++argi];
+            errno = 0;
+            app_args.score_latency = (int)strtol(text, NULL, 0);
+            if (errno) {
+                perror(name);
+                return 1;
+            }
+            continue;
+        }
+        if (!strcmp(name, "--score-type")) {
+            const char* value = app_args.argv[++argi];
+            app_args.score_type = aymo_score_ext_to_type(value);
+            if (app_args.score_type >= aymo_score_type_unknown) {
+                fprintf(stderr, "ERROR: Unknown score type \"%s\"\n", value);
+                return 1;
+            }
+            app_args.score_type_cstr = value;
+            continue;
+        }
+        if (!strcmp(name, "--threads")) {
+            const char* text = app_args.argv[++argi];
+            errno = 0;
+            app_args.threads = (unsigned)strtoul(text, NULL, 0);
+            if (errno) {
+                perror(name);
+                return 1;
+            }
+            continue;
+        }
+        break;
+    }
+
+    // All the remaining arguments are score paths
+    app_args.score_first = argi;
+    app_args.score_count = (app_args.argc - argi);
+
+    if (!app_args.benchmark && !app_args.out_dir_cstr) {
+        fprintf(stderr, "ERROR: Missing output directory\n");
+        return 1;
+    }
+    if (!app_args.score_count && !app_args.list_path_cstr) {
+        fprintf(stderr, "ERROR: No scores to render\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+
+// Score file name without directories and extension, naming its output
+static const char* app_out_name(const char* in_path, size_t* length)
+{
+    const char* name = in_path;
+    for (const char* ptr = in_path; *ptr; ++ptr) {
+        if ((*ptr == '/') || (*ptr == '\\')) {
+            name = (ptr + 1);
+        }
+    }
+    *length = strlen(name);
+    const char* ext = strrchr(name, '.');
+    if (ext && (ext != name)) {
+        *length = (size_t)(ext - name);
+    }
+    return name;
+}
+
+
+// Case insensitive, as output directories may be
+static int app_out_name_compare(const void* a, const void* b)
+{
+    size_t length_a, length_b;
+    const char* name_a = app_out_name(jobs[*(const uint32_t*)a].path, &length_a);
+    const char* name_b = app_out_name(jobs[*(const uint32_t*)b].path, &length_b);
+
+    for (size_t i = 0u; (i < length_a) && (i < length_b); ++i) {
+        int ca = tolower((unsigned char)name_a[i]);
+        int cb = tolower((unsigned char)name_b[i]);
+        if (ca != cb) {
+            return (ca - cb);
+        }
+    }
+    return ((length_a > length_b) - (length_a < length_b));
+}
+
+
+static int app_job_compare(const void* a, const void* b)
+{
+    const struct app_job* job_a = &jobs[*(const uint32_t*)a];
+    const struct app_job* job_b = &jobs[*(const uint32_t*)b];
+
+    // Larger first, then in the given order for a stable schedule
+    if (job_a->size != job_b->size) {
+        return ((job_a->size > job_b->size) ? -1 : +1);
+    }
+    return ((job_a->path > job_b->path) - (job_a->path < job_b->path));
+}
+
+
+static void app_job_add(const char* path)
+{
+    struct app_job* job = &jobs[job_count];
+    job->path = path;
+
+    job->score_type = app_args.score_type;
+    if (job->score_type >= aymo_score_type_unknown) {
+        const char* ext = strrchr(path, '.');
+        if (ext) {
+            job->score_type = aymo_score_ext_to_type(ext + 1);
+        }
+        if (job->score_type >= aymo_score_type_unknown) {
+            fprintf(stderr, "ERROR: Unsupported score type of \"%s\"\n", path);
+            ++job_invalid_count;
+            return;
+        }
+    }
+
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        perror(path);
+        ++job_invalid_count;
+        return;
+    }
+    long size = -1;
+    if (!fseek(file, 0, SEEK_END)) {
+        size = ftell(file);
+    }
+    fclose(file);
+    if (size < 0) {
+        fprintf(stderr, "ERROR: Cannot get the size of \"%s\"\n", path);
+        ++job_invalid_count;
+        return;
+    }
+    job->size = (uint64_t)size;
+
+    ++job_count;
+}
+
+
+static int app_setup_jobs(void)
+{
+    size_t path_count = (size_t)app_args.score_count;
+
+    // One path per line, skipping empty lines and "#" comments
+    if (app_args.list_path_cstr) {
+        if (aymo_file_load(app_args.list_path_cstr, &list_data, &list_size)) {
+            fprintf(stderr, "ERROR: Cannot load list \"%s\"\n", app_args.list_path_cstr);
+            return 1;
+        }
+        char* text = (char*)realloc(list_data, (list_size + 1u));
+        if (!text) {
+            perror("realloc(list_data)");
+            return 2;
+        }
+        list_data = text;
+        text[list_size] = '\0';
+
+        for (size_t i = 0u; i < list_size; ++i) {
+            if ((text[i] == '\n') || (text[i] == '\r')) {
+                text[i] = '\0';
+            }
+        }
+        for (size_t i = 0u; i < list_size; ++i) {
+            if (text[i] && (!i || !text[i - 1u])) {
+                ++path_count;
+            }
+        }
+    }
+
+    if (path_count >= UINT32_MAX) {
+        fprintf(stderr, "ERROR: Too many scores\n");
+        return 1;
+    }
+    jobs = (struct app_job*)calloc((path_count + 1u), sizeof(*jobs));
+    job_order = (uint32_t*)calloc((path_count + 1u), sizeof(*job_order));
+    if (!jobs || !job_order) {
+        perror("calloc(jobs)");
+        return 2;
+    }
+
+    for (int i = 0; i < app_args.score_count; ++i) {
+        app_job_add(app_args.argv[app_args.score_first + i]);
+    }
+
+    if (list_data) {
+        char* text = (char*)list_data;
+        for (size_t i = 0u; i < list_size; ++i) {
+            if (text[i] && (!i || !text[i - 1u]) && (text[i] != '#')) {
+                app_job_add(&text[i]);
+            }
+        }
+    }
+
+    for (uint32_t i = 0u; i < job_count; ++i) {
+        job_order[i] = i;
+    }
+
+    // Scores with the same file name would render into the same output file
+    if (!app_args.benchmark) {
+        qsort(job_order, job_count, sizeof(*job_order), app_out_name_compare);
+        int clashes = 0;
+        for (uint32_t i = 1u; i < job_count; ++i) {
+            if (!app_out_name_compare(&job_order[i - 1u], &job_order[i])) {
+                fprintf(stderr, "ERROR: Same output file for \"%s\" and \"%s\"\n",
+                        jobs[job_order[i - 1u]].path, jobs[job_order[i]].path);
+                clashes = 1;
+            }
+        }
+        if (clashes) {
+            return 1;
+        }
+    }
+
+    qsort(job_order, job_count, sizeof(*job_order), app_job_compare);
+
+    return 0;
+}
+
+
+static int app_setup_workers(void)
+{
+    worker_count = app_args.threads;
+    if (!worker_count) {
+        worker_count = app_thread_get_cpu_count();
+    }
+    if (worker_count > job_count) {
+        worker_count = job_count;
+    }
+    if (worker_count > APP_THREAD_MAX) {
+        worker_count = APP_THREAD_MAX;
+    }
+    if (worker_count < 1u) {
+        worker_count = 1u;
+    }
+
+    uint32_t out_channels = (app_args.out_quad ? 4u : 2u);
+    size_t frame_size = (sizeof(int16_t) * out_channels);
+    out_frame_length = app_args.out_frame_length;
+    if (out_frame_length < 1u) {
+        out_frame_length = 1u;
+    }
+    if (out_frame_length > (UINT32_MAX / frame_size)) {
+        out_frame_length = (uint32_t)(UINT32_MAX / frame_size);
+    }
+
+    workers = (struct app_worker*)calloc(worker_count, sizeof(*workers));
+    if (!workers) {
+        perror("calloc(workers)");
+        return 2;
+    }
+
+    // Deal the sorted jobs round-robin, storing each worker slice contiguously
+    uint32_t* dealt = (uint32_t*)calloc((job_count + 1u), sizeof(*dealt));
+    if (!dealt) {
+        perror("calloc(dealt)");
+        return 2;
+    }
+    uint32_t job_begin = 0u;
+
+    for (unsigned w = 0u; w < worker_count; ++w) {
+        struct app_worker* worker = &workers[w];
+
+        for (uint32_t k = w; k < job_count; k += worker_count) {
+            dealt[job_begin++] = job_order[k];
+        }
+        worker->job_next = (job_begin - ((job_count - w + worker_count - 1u) / worker_count));
+        worker->job_end = job_begin;
+
+        size_t chip_size = app_args.ymf262_vt->get_sizeof();
+        void* chip_alignptr = aymo_aligned_alloc(chip_size, 32u);
+        if (!chip_alignptr) {
+            perror("aymo_aligned_alloc(chip_size)");
+            free(dealt);
+            return 2;
+        }
+        worker->chip = (struct aymo_ymf262_chip*)chip_alignptr;
+        worker->chip->vt = app_args.ymf262_vt;
+        aymo_ymf262_ctor(worker->chip);
+
+        worker->out_buffer_ptr = (int16_t*)malloc(out_frame_length * frame_size);
+        if (!worker->out_buffer_ptr) {
+            perror("malloc(out_buffer_size)");
+            free(dealt);
+            return 2;
+        }
+
+        worker->score_map.fd = -1;
+    }
+
+    free(job_order);
+    job_order = dealt;
+    return 0;
+}
+
+
+static int app_setup(void)
+{
+    int status = app_setup_jobs();
+    if (status) {
+        return status;
+    }
+
+    return app_setup_workers();
+}
+
+
+static void app_teardown(void)
+{
+    if (workers) {
+        for (unsigned w = 0u; w < worker_count; ++w) {
+            struct app_worker* worker = &workers[w];
+
+            if (worker->started) {
+                (void)app_thread_join(&worker->thread);
+            }
+            if (worker->chip) {
+                aymo_ymf262_dtor(worker->chip);
+                aymo_aligned_free(worker->chip);
+            }
+            if (worker->score_map.data || (worker->score_map.fd >= 0)) {
+                (void)app_map_close(&worker->score_map);
+            }
+            free(worker->out_buffer_ptr);
+            free(worker->out_path_ptr);
+        }
+        free(workers);
+    }
+    workers = NULL;
+    worker_count = 0u;
+
+    free(jobs);
+    jobs = NULL;
+    free(job_order);
+    job_order = NULL;
+    job_count = 0u;
+
+    aymo_file_unload(list_data);
+    list_data = NULL;
+    list_size = 0u;
+}
+
+
+// Takes the next job of a worker slice; works for its owner and thieves alike
+static const struct app_job* app_worker_take(struct app_worker* worker)
+{
+    if (app_atomic_load_u32(&worker->job_next) < worker->job_end) {
+        uint32_t k = app_atomic_add_u32(&worker->job_next, 1u);
+        if (k < worker->job_end) {
+            return &jobs[job_order[k]];
+        }
+    }
+    return NULL;
+}
+
+
+// Steals the largest pending job of the worker with the most pending ones
+static const struct app_job* app_worker_steal(void)
+{
+    for (;;) {
+        struct app_worker* victim = NULL;
+        uint32_t victim_pending = 0u;
+
+        for (unsigned w = 0u; w < worker_count; ++w) {
+            struct app_worker* worker = &workers[w];
+            uint32_t next = app_atomic_load_u32(&worker->job_next);
+            uint32_t pending = ((next < worker->job_end) ? (worker->job_end - next) : 0u);
+            if (victim_pending < pending) {
+                victim_pending = pending;
+                victim = worker;
+            }
+        }
+        if (!victim) {
+            return NULL;
+        }
+
+        const struct app_job* job = app_worker_take(victim);
+        if (job) {
+            return job;
+        }
+    }
+}
+
+
+// Output path: out_dir + '/' + score file name, with the ".wav" extension
+static int app_worker_out_path(struct app_worker* worker, const char* in_path)
+{
+    size_t name_length;
+    const char* name = app_out_name(in_path, &name_length);
+
+    size_t dir_length = strlen(app_args.out_dir_cstr);
+    size_t size = (dir_length + 1u + name_length + 5u);
+
+    if (worker->out_path_size < size) {
+        char* ptr = (char*)realloc(worker->out_path_ptr, size);
+        if (!ptr) {
+            perror("realloc(out_path)");
+            return 2;
+        }
+        worker->out_path_ptr = ptr;
+        worker->out_path_size = size;
+    }
+
+    char* ptr = worker->out_path_ptr;
+    memcpy(ptr, app_args.out_dir_cstr, dir_length);
+    ptr += dir_length;
+    *ptr++ = '/';
+    memcpy(ptr, name, name_length);
+    ptr += name_length;
+    memcpy(ptr, ".wav", 5u);
+    return 0;
+}
+
+
+static int app_worker_render(struct app_worker* worker, FILE* out_file)
+{
+    size_t out_channels = (app_args.out_quad ? 4u : 2u);
+    uint64_t frame_total = 0u;
+
+    struct app_render render;
+    app_render_ctor(&render, worker->chip, &worker->score.base, app_args.loops, app_args.score_after,
+                    app_args.score_latency, app_args.out_quad);
+
+    while (render.playing) {
+        uint32_t length = app_render_run(&render, out_frame_length, worker->out_buffer_ptr);
+
+        // Unlike playback, the last buffer stops at the end of the score
+        if (out_file && length) {
+            if (fwrite(worker->out_buffer_ptr, (sizeof(int16_t) * out_channels), length, out_file) != length) {
+                perror("fwrite(out_buffer)");
+                return 2;
+            }
+        }
+        frame_total += length;
+    }
+
+    worker->frame_total += frame_total;
+
+    if (out_file) {
+        struct aymo_wave_heading wave_head;
+        uint64_t frame_max = ((UINT32_MAX - sizeof(wave_head)) / (sizeof(int16_t) * out_channels));
+        if (frame_total > frame_max) {
+            frame_total = frame_max;
+        }
+        aymo_wave_heading_setup(&wave_head, AYMO_WAVE_FMT_TYPE_PCM, (uint16_t)out_channels, 16u,
+                                AYMO_YMF262_SAMPLE_RATE, (uint32_t)frame_total);
+
+        if (fseek(out_file, 0, SEEK_SET)) {
+            perror("fseek(out_file)");
+            return 2;
+        }
+        if (fwrite(&wave_head, sizeof(wave_head), 1u, out_file) != 1u) {
+            perror("fwrite(wave_head)");
+            return 2;
+        }
+    }
+    return 0;
+}
+
+
+static int app_worker_job(struct app_worker* worker, const struct app_job* job)
+{
+    int status = 0;
+    FILE* out_file = NULL;
+    union app_scores* score = &worker->score;
+
+    if (app_map_open(&worker->score_map, job->path)) {
+        return 1;
+    }
+    if (worker->score_map.size > UINT32_MAX) {
+        fprintf(stderr, "ERROR: Score too large \"%s\"\n", job->path);
+        status = 1;
+        goto finally_;
+    }
+
+    score->base.vt = aymo_score_type_to_vt(job->score_type);
+    aymo_score_ctor(&score->base);
+    if (aymo_score_load(&score->base, worker->score_map.data, (uint32_t)worker->score_map.size)) {
+        fprintf(stderr, "ERROR: Cannot load score \"%s\"\n", job->path);
+        aymo_score_dtor(&score->base);
+        status = 1;
+        goto finally_;
+    }
+
+    // Wipe the chip of the previous score, keeping its allocation
+    aymo_ymf262_dtor(worker->chip);
+    aymo_ymf262_ctor(worker->chip);
+
+    if (!app_args.benchmark) {
+        status = app_worker_out_path(worker, job->path);
+        if (status) {
+            goto unload_;
+        }
+        out_file = fopen(worker->out_path_ptr, "wb");
+        if (!out_file) {
+            perror(worker->out_path_ptr);
+            status = 1;
+            goto unload_;
+        }
+
+        // Placeholder heading, rewritten with the final sizes
+        struct aymo_wave_heading wave_head;
+        memset(&wave_head, 0, sizeof(wave_head));
+        if (fwrite(&wave_head, sizeof(wave_head), 1u, out_file) != 1u) {
+            perror("fwrite(wave_head)");
+            status = 2;
+            goto unload_;
+        }
+    }
+
+    status = app_worker_render(worker, out_file);
+
+unload_:
+    aymo_score_unload(&score->base);
+    aymo_score_dtor(&score->base);
+
+    if (out_file) {
+        if (fclose(out_file) && !status) {
+            perror(worker->out_path_ptr);
+            status = 2;
+        }
+    }
+
+finally_:
+    if (app_map_close(&worker->score_map) && !status) {
+        status = 2;
+    }
+    return status;
+}
+
+
+static int app_worker_run(void* context)
+{
+    struct app_worker* worker = (struct app_worker*)context;
+    double time_start = app_clock_seconds();
+
+    for (;;) {
+        bool stolen = false;
+        const struct app_job* job = app_worker_take(worker);
+        if (!job) {
+            job = app_worker_steal();
+            if (!job) {
+                break;
+            }
+            stolen = true;
+        }
+
+        if (app_worker_job(worker, job)) {
+            ++worker->failed_count;
+        }
+        else {
+            ++worker->done_count;
+            worker->stolen_count += (stolen ? 1u : 0u);
+        }
+    }
+
+    worker->busy_seconds = (app_clock_seconds() - time_start);
+    return 0;
+}
+
+
+static int app_run(void)
+{
+    double time_start = app_clock_seconds();
+
+    // The calling thread works as the first worker
+    for (unsigned w = 1u; w < worker_count; ++w) {
+        struct app_worker* worker = &workers[w];
+        if (app_thread_start(&worker->thread, app_worker_run, worker)) {
+            fprintf(stderr, "ERROR: Cannot start worker thread #%u\n", w);
+            return 2;
+        }
+        worker->started = true;
+    }
+
+    (void)app_worker_run(&workers[0]);
+
+    for (unsigned w = 1u; w < worker_count; ++w) {
+        struct app_worker* worker = &workers[w];
+        (void)app_thread_join(&worker->thread);
+        worker->started = false;
+    }
+
+    double wall_seconds = (app_clock_seconds() - time_start);
+
+    uint64_t frame_total = 0u;
+    unsigned done_count = 0u;
+    unsigned failed_count = job_invalid_count;
+    double busy_seconds = 0.;
+
+    for (unsigned w = 0u; w < worker_count; ++w) {
+        const struct app_worker* worker = &workers[w];
+        frame_total += worker->frame_total;
+        done_count += worker->done_count;
+        failed_count += worker->failed_count;
+        busy_seconds += worker->busy_seconds;
+
+        if (app_args.thread_stats) {
+            double audio_seconds = ((double)worker->frame_total / (double)AYMO_YMF262_SAMPLE_RATE);
+            fprintf(stderr, "Thread #%u: %u scores (%u stolen, %u failed), %.3f seconds, %.1fx realtime\n",
+                    w, worker->done_count, worker->stolen_count, worker->failed_count, worker->busy_seconds,
+                    ((worker->busy_seconds > 0.) ? (audio_seconds / worker->busy_seconds) : 0.));
+        }
+    }
+
+    double audio_seconds = ((double)frame_total / (double)AYMO_YMF262_SAMPLE_RATE);
+    printf("Rendered: %u scores (%u failed) with %u threads\n", done_count, failed_count, worker_count);
+    printf("Audio time: %.3f seconds\n", audio_seconds);
+    printf("Render time: %.3f seconds\n", wall_seconds);
+    printf("Throughput: %.1fx realtime (%.1fx per thread)\n",
+           ((wall_seconds > 0.) ? (audio_seconds / wall_seconds) : 0.),
+           ((busy_seconds > 0.) ? (audio_seconds / busy_seconds) : 0.));
+
+    return (failed_count ? 1 : 0);
+}
+
+
+int main(int argc, char** argv)
+{
+    app_return = app_boot();
+    if (app_return) goto catch_;
+
+    app_return = app_args_init(argc, argv);
+    if (app_return) goto catch_;
+
+    app_return = app_args_parse();
+    if (app_return == -1) {  // help
+        app_return = 0;
+        goto finally_;
+    }
+    if (app_return) goto catch_;
+
+    app_return = app_setup();
+    if (app_return) goto catch_;
+
+    app_return = app_run();
+    if (app_return) goto catch_;
+
+    goto finally_;
+
+catch_:
+finally_:
+    app_teardown();
+    return app_return;
+}
+
+
+AYMO_CXX_EXTERN_C_END
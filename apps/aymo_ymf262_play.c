@@ -26,9 +26,16 @@ To play via shell pipe, run:
 
     - VLC:
         aymo_ymf262_play SCORE | vlc --demux=rawaud --rawaud-channels 2 --rawaud-samplerate 47916 -
+
+Output is written by a separate thread, from a pool of large buffers, so
+that rendering does not stall on the disk or the pipe:
+
+    aymo_ymf262_play --buffer-size 4096 --writer-size 4194304 --writer-direct --writer-stats SCORE out.wav
 */
 
 #include "aymo.h"
+#include "aymo_app_render.h"
+#include "aymo_app_writer.h"
 #include "aymo_cpu.h"
 #include "aymo_file.h"
 #include "aymo_score.h"
@@ -75,12 +82,19 @@ struct app_args {
     enum aymo_score_type score_type;
     unsigned score_after;
     int score_latency;
+    unsigned score_seek;                // [samples] start time
 
     // Output parameters
     const char* out_path_cstr;          // NULL or "-" for stdout
     uint32_t out_frame_length;
     bool out_quad;
 
+    // Writer parameters
+    size_t writer_size;                 // [bytes] per buffer
+    uint32_t writer_count;              // buffers in the pool
+    unsigned writer_flags;
+    bool writer_stats;
+
     // YMF262 parameters
     const struct aymo_ymf262_vt* ymf262_vt;
     bool ymf262_extensions;
@@ -103,14 +117,18 @@ static union app_scores {
     struct aymo_score_ref_instance ref;
     struct aymo_score_vgm_instance vgm;
 } score;
+static struct aymo_score_event* score_events;
 
 static struct aymo_ymf262_chip* chip;
 
 static bool out_stdout;
-static FILE* out_file;
-static int16_t out_buffer_default[4];
-static int16_t* out_buffer_ptr;
+static bool out_opened;
+static struct app_writer out_writer;
+static int16_t* out_buffer_ptr;         // benchmark only
 static uint32_t out_frame_length;
+static uint32_t out_buffer_length;      // [frames] per writer buffer
+static size_t out_head_size;
+static uint8_t out_head[APP_WRITER_ALIGN];
 static struct aymo_wave_heading wave_head;
 
 
@@ -146,12 +164,6 @@ static void aymo_aligned_free(void* alignptr)
 }
 
 
-static void aymo_ymf262_write_queued(struct aymo_ymf262_chip* chip_, uint16_t address, uint8_t value)
-{
-    (void)aymo_ymf262_enqueue_write(chip_, address, value);
-}
-
-
 static int app_boot(void)
 {
     app_return = 2;
@@ -162,11 +174,12 @@ static int app_boot(void)
     score_data = NULL;
     score_size = 0u;
     memset(&score, 0, sizeof(score));
+    score_events = NULL;
 
     chip = NULL;
 
-    out_file = NULL;
-    out_buffer_ptr = out_buffer_default;
+    out_opened = false;
+    out_buffer_ptr = NULL;
     out_frame_length = 1u;
 
     return 0;
@@ -187,6 +200,9 @@ static int app_args_init(int argc, char** argv)
 
     app_args.out_frame_length = 1u;
 
+    app_args.writer_size = APP_WRITER_BUFFER_SIZE;
+    app_args.writer_count = APP_WRITER_BUFFER_COUNT;
+
     app_args.ymf262_vt = aymo_ymf262_get_best_vt();
 
     return 0;
@@ -225,6 +241,18 @@ static int app_args_parse(void)
             app_args.out_quad = true;
             continue;
         }
+        if (!strcmp(name, "--writer-direct")) {
+            app_args.writer_flags |= APP_WRITER_FLAG_DIRECT;
+            continue;
+        }
+        if (!strcmp(name, "--writer-fadvise")) {
+            app_args.writer_flags |= APP_WRITER_FLAG_FADVISE;
+            continue;
+        }
+        if (!strcmp(name, "--writer-stats")) {
+            app_args.writer_stats = true;
+            continue;
+        }
         if (!strcmp(name, "--ymf62-extensions")) {
             app_args.ymf262_extensions = true;
             continue;
@@ -283,6 +311,16 @@ static int app_args_parse(void)
             }
             continue;
         }
+        if (!strcmp(name, "--score-seek")) {
+            const char* text = app_args.argv[++argi];
+            errno = 0;
+            app_args.score_seek = (unsigned)strtoul(text, NULL, 0);
+            if (errno) {
+                perror(name);
+                return 1;
+            }
+            continue;
+        }
         if (!strcmp(name, "--score-type")) {
             const char* value = app_args.argv[++argi];
             app_args.score_type = aymo_score_ext_to_type(value);
@@ -292,6 +330,26 @@ static int app_args_parse(void)
             }
             continue;
         }
+        if (!strcmp(name, "--writer-buffers")) {
+            const char* text = app_args.argv[++argi];
+            errno = 0;
+            app_args.writer_count = (uint32_t)strtoul(text, NULL, 0);
+            if (errno) {
+                perror(name);
+                return 1;
+            }
+            continue;
+        }
+        if (!strcmp(name, "--writer-size")) {
+            const char* text = app_args.argv[++argi];
+            errno = 0;
+            app_args.writer_size = (size_t)strtoul(text, NULL, 0);
+            if (errno) {
+                perror(name);
+                return 1;
+            }
+            continue;
+        }
         break;
     }
 
@@ -356,6 +414,19 @@ static int app_setup(void)
         return 1;
     }
 
+    if (app_args.score_type == aymo_score_type_ref) {
+        // Pre-parse the text once, so that playback does not tokenize
+        uint32_t tail = 0u;
+        uint32_t length = aymo_score_ref_parse(score_data, (uint32_t)score_size, NULL, 0u, &tail);
+        score_events = (struct aymo_score_event*)malloc((length + 1u) * sizeof(*score_events));
+        if (!score_events) {
+            perror("malloc(score_events)");
+            return 2;
+        }
+        aymo_score_ref_parse(score_data, (uint32_t)score_size, score_events, length, &tail);
+        aymo_score_ref_load_events(&score.ref, score_events, length, tail);
+    }
+
     size_t chip_size = app_args.ymf262_vt->get_sizeof();
     void* chip_alignptr = aymo_aligned_alloc(chip_size, 32u);
     if (!chip_alignptr) {
@@ -366,28 +437,49 @@ static int app_setup(void)
     chip->vt = app_args.ymf262_vt;
     aymo_ymf262_ctor(chip);
 
+    if (app_args.score_seek) {
+        static uint8_t regs[AYMO_YMF262_REG_NUM];
+        static uint8_t written[AYMO_YMF262_REG_NUM / 8u];
+        aymo_score_scan_registers(&score.base, (uint32_t)app_args.score_seek, regs, written);
+        aymo_ymf262_load_registers(chip, regs, written);
+    }
+
     uint32_t out_channels = (app_args.out_quad ? 4u : 2u);
+    size_t frame_size = (sizeof(int16_t) * out_channels);
     out_frame_length = app_args.out_frame_length;
     if (out_frame_length < 1u) {
         out_frame_length = 1u;
     }
-    if (out_frame_length > (UINT32_MAX / (sizeof(int16_t) * out_channels))) {
-        out_frame_length = (UINT32_MAX / (sizeof(int16_t) * out_channels));
+    if (out_frame_length > (UINT32_MAX / frame_size)) {
+        out_frame_length = (uint32_t)(UINT32_MAX / frame_size);
     }
-    size_t out_buffer_size = (out_frame_length * (sizeof(int16_t) * out_channels));
-    out_buffer_ptr = (int16_t*)malloc(out_buffer_size);
-    if (!out_buffer_ptr) {
-        perror("malloc(out_buffer_size)");
-        return 2;
+
+    // Each writer buffer takes a whole number of render buffers
+    size_t writer_size = app_args.writer_size;
+    if (writer_size < (out_frame_length * frame_size)) {
+        writer_size = (out_frame_length * frame_size);
+    }
+    out_buffer_length = (uint32_t)((writer_size / frame_size / out_frame_length) * out_frame_length);
+    writer_size = (out_buffer_length * frame_size);
+
+    unsigned writer_flags = app_args.writer_flags;
+    if ((writer_flags & APP_WRITER_FLAG_DIRECT) && (writer_size % APP_WRITER_ALIGN)) {
+        fprintf(stderr, "WARNING: Writer buffer size not a multiple of %u bytes; direct output disabled\n",
+                APP_WRITER_ALIGN);
+        writer_flags &= ~APP_WRITER_FLAG_DIRECT;
     }
 
     if (app_args.benchmark) {
         out_stdout = false;
-        out_file = NULL;
+        out_buffer_ptr = (int16_t*)malloc(writer_size);
+        if (!out_buffer_ptr) {
+            perror("malloc(out_buffer_size)");
+            return 2;
+        }
     }
     else if (!app_args.out_path_cstr || !strcmp(app_args.out_path_cstr, "") || !strcmp(app_args.out_path_cstr, "-")) {
         out_stdout = true;
-        out_file = stdout;
+        out_head_size = 0u;
 
         #if (defined(__WINDOWS__) || defined(__CYGWIN__))
             errno = 0;
@@ -397,33 +489,64 @@ static int app_setup(void)
                 return 2;
             }
         #endif
+
+        if (app_writer_open(&out_writer, NULL, 0u, writer_size, app_args.writer_count, writer_flags)) {
+            return 2;
+        }
+        out_opened = true;
     }
     else {
         out_stdout = false;
-        out_file = fopen(app_args.out_path_cstr, "wb");
-        if (!out_file) {
-            perror(app_args.out_path_cstr);
-            return 1;
-        }
 
-        aymo_wave_heading_setup(
-            &wave_head,
-            AYMO_WAVE_FMT_TYPE_PCM,
-            (uint16_t)out_channels,
-            16u,
-            AYMO_YMF262_SAMPLE_RATE,
-            0u
-        );
-        if (fwrite(&wave_head, sizeof(wave_head), 1u, out_file) != 1u) {
-            perror("fwrite(wave_head)");
-            return 2;
+        // Direct output needs the samples at an aligned offset, past a padded heading
+        out_head_size = ((writer_flags & APP_WRITER_FLAG_DIRECT) ? APP_WRITER_ALIGN : sizeof(wave_head));
+
+        if (app_writer_open(&out_writer, app_args.out_path_cstr, out_head_size,
+                            writer_size, app_args.writer_count, writer_flags)) {
+            return 1;
         }
+        out_opened = true;
     }
 
     return 0;
 }
 
 
+// WAVE heading for the final frame count, padded to out_head_size via a "JUNK" chunk
+static void app_wave_head_setup(uint64_t frame_total)
+{
+    uint32_t out_channels = (app_args.out_quad ? 4u : 2u);
+
+    aymo_wave_heading_setup(
+        &wave_head,
+        AYMO_WAVE_FMT_TYPE_PCM,
+        (uint16_t)out_channels,
+        16u,
+        AYMO_YMF262_SAMPLE_RATE,
+        0u
+    );
+
+    uint64_t data_size = (frame_total * wave_head.wave_fmt_block_align);
+    uint64_t data_max = (UINT32_MAX - out_head_size);
+    if (data_size > data_max) {
+        data_size = (data_max - (data_max % wave_head.wave_fmt_block_align));
+    }
+    wave_head.riff_size = (uint32_t)((out_head_size - 8u) + data_size);
+    wave_head.wave_data_size = (uint32_t)data_size;
+
+    memset(out_head, 0, sizeof(out_head));
+    size_t fmt_size = offsetof(struct aymo_wave_heading, wave_data_fourcc);
+    memcpy(out_head, &wave_head, fmt_size);
+
+    if (out_head_size > sizeof(wave_head)) {
+        uint32_t junk_size = (uint32_t)(out_head_size - sizeof(wave_head) - 8u);
+        memcpy(&out_head[fmt_size], "JUNK", 4u);
+        memcpy(&out_head[fmt_size + 4u], &junk_size, 4u);
+    }
+    memcpy(&out_head[out_head_size - 8u], &wave_head.wave_data_fourcc, 8u);
+}
+
+
 static void app_teardown(void)
 {
     if (chip) {
@@ -438,15 +561,15 @@ static void app_teardown(void)
     }
     aymo_file_unload(score_data);
     score_data = NULL;
+    free(score_events);
+    score_events = NULL;
 
-    if (!out_stdout && out_file) {
-        fclose(out_file);
+    if (out_opened) {
+        (void)app_writer_close(&out_writer, out_head);  // after failures only
     }
-    out_file = NULL;
+    out_opened = false;
 
-    if (out_buffer_ptr && (out_buffer_ptr != out_buffer_default)) {
-        free(out_buffer_ptr);
-    }
+    free(out_buffer_ptr);
     out_buffer_ptr = NULL;
     out_frame_length = 0u;
 }
@@ -455,18 +578,10 @@ static void app_teardown(void)
 static int app_run(void)
 {
     size_t out_channels = (app_args.out_quad ? 4u : 2u);
-    size_t out_sample_length = ((size_t)out_frame_length * out_channels);
-    uint32_t frame_total = 0u;
-    unsigned pending_loops = (app_args.loops - 1u);
-    unsigned score_after = app_args.score_after;
-
-    aymo_ymf262_write_f aymo_ymf262_writer;
-    if (app_args.score_latency >= 0) {
-        aymo_ymf262_writer = aymo_ymf262_write;
-    }
-    else {
-        aymo_ymf262_writer = aymo_ymf262_write_queued;
-    }
+    size_t frame_size = (sizeof(int16_t) * out_channels);
+    uint64_t frame_total = 0u;
+    int16_t* out_ptr = NULL;  // current writer buffer
+    uint32_t out_fill = 0u;  // [frames] rendered into out_ptr
 
     aymo_ymf262_generate_i16x2_f aymo_ymf262_generate_i16;
     if (app_args.out_quad) {
@@ -476,91 +591,57 @@ static int app_run(void)
         aymo_ymf262_generate_i16 = aymo_ymf262_generate_i16x2;
     }
 
-    struct aymo_score_status* status = aymo_score_get_status(&score.base);
-    bool playing = !(status->flags & AYMO_SCORE_FLAG_EOF);
+    struct app_render render;
+    app_render_ctor(&render, chip, &score.base, app_args.loops, app_args.score_after,
+                    app_args.score_latency, app_args.out_quad);
 
     clock_start = clock();
 
-    while (playing) {
-        int16_t* buffer_ptr = out_buffer_ptr;
-        uint32_t avail_length = out_frame_length;
-        uint32_t delay_length = status->delay;
-
-        while (avail_length) {
-            if (delay_length > avail_length) {
-                delay_length = avail_length;
+    while (render.playing) {
+        if (!out_ptr) {
+            if (out_opened) {
+                out_ptr = (int16_t*)app_writer_acquire(&out_writer);
+                if (!out_ptr) {
+                    return 2;
+                }
             }
-
-            aymo_ymf262_generate_i16(chip, delay_length, buffer_ptr);
-            buffer_ptr += (delay_length * out_channels);
-            frame_total++;
-
-            aymo_score_tick(&score.base, delay_length);
-            avail_length -= delay_length;
-
-            if (status->flags & AYMO_SCORE_FLAG_EVENT) {
-                aymo_ymf262_writer(chip, status->address, status->value);
+            else {
+                out_ptr = out_buffer_ptr;
             }
+            out_fill = 0u;
+        }
 
-            while (!(status->flags & (AYMO_SCORE_FLAG_DELAY | AYMO_SCORE_FLAG_EOF))) {
-                aymo_score_tick(&score.base, 0u);
+        int16_t* buffer_ptr = &out_ptr[out_fill * out_channels];
+        uint32_t done_length = app_render_run(&render, out_frame_length, buffer_ptr);
 
-                if (status->flags & AYMO_SCORE_FLAG_EVENT) {
-                    aymo_ymf262_writer(chip, status->address, status->value);
+        if (done_length < out_frame_length) {
+            // The last buffer is filled with what the chip plays past the end
+            buffer_ptr += (done_length * out_channels);
+            aymo_ymf262_generate_i16(chip, (out_frame_length - done_length), buffer_ptr);
+        }
 
-                    if (app_args.score_latency > 0) {
-                        status->delay += (uint32_t)app_args.score_latency;
-                        break;
-                    }
-                }
-            }
+        out_fill += out_frame_length;
+        frame_total += out_frame_length;
 
-            if (!(status->flags & AYMO_SCORE_FLAG_EOF)) {
-                delay_length = status->delay;
-            }
-            else if (app_args.loops) {
-                if (pending_loops) {
-                    pending_loops--;
-                    aymo_score_restart(&score.base);
-                }
-                else if (score_after) {
-                    status->flags |= AYMO_SCORE_FLAG_DELAY;
-                    status->delay = score_after;
-                    delay_length = status->delay;
-                    score_after = 0u;
-                }
-                else {
-                    playing = false;
-                }
-            }
-            else {
-                aymo_score_restart(&score.base);
+        if (out_fill >= out_buffer_length) {
+            if (out_opened && app_writer_submit(&out_writer, (out_fill * frame_size))) {
+                return 2;
             }
+            out_ptr = NULL;
         }
+    }
 
-        if (out_file) {
-            if (fwrite(out_buffer_ptr, sizeof(int16_t), out_sample_length, out_file) != out_sample_length) {
-                perror("fwrite(out_buffer)");
+    if (out_opened) {
+        if (out_ptr && out_fill) {
+            if (app_writer_submit(&out_writer, (out_fill * frame_size))) {
                 return 2;
             }
         }
-    }
-
-    if (out_file && !out_stdout) {
-        if (fseek(out_file, 0, SEEK_SET)) {
-            perror("fseek(out_file)");
-            return 2;
+        if (!out_stdout) {
+            app_wave_head_setup(frame_total);
         }
-        aymo_wave_heading_setup(
-            &wave_head,
-            AYMO_WAVE_FMT_TYPE_PCM,
-            (uint16_t)out_channels,
-            16u,
-            AYMO_YMF262_SAMPLE_RATE,
-            frame_total
-        );
-        if (fwrite(&wave_head, sizeof(wave_head), 1u, out_file) != 1u) {
-            perror("fwrite(wave_head)");
+        out_opened = false;
+        if (app_writer_close(&out_writer, out_head)) {
             return 2;
         }
     }
@@ -573,6 +654,17 @@ static int app_run(void)
         printf("Render time: %.6f seconds\n", seconds);
     }
 
+    if (app_args.writer_stats) {
+        const struct app_writer_stats* stats = &out_writer.stats;
+        fprintf(stderr, "Writer buffers: %u x %lu bytes\n",
+                (unsigned)out_writer.buffer_count, (unsigned long)out_writer.buffer_size);
+        fprintf(stderr, "Written: %llu bytes in %llu buffers\n",
+                (unsigned long long)stats->byte_total, (unsigned long long)stats->buffer_total);
+        fprintf(stderr, "Render blocked time: %.6f seconds\n", stats->producer_blocked);
+        fprintf(stderr, "Writer blocked time: %.6f seconds\n", stats->writer_blocked);
+        fprintf(stderr, "Writer busy time: %.6f seconds\n", stats->writer_busy);
+    }
+
     return 0;
 }
 
@@ -0,0 +1,970 @@
+/*
+AYMO - Accelerated YaMaha Operator
+Copyright (c) 2023-2024 Andrea Zoppi.
+
+This file is part of AYMO.
+
+AYMO is free software: you can redistribute it and/or modify it under the
+terms of the GNU Lesser General Public License as published by the Free
+Software Foundation, either version 2.1 of the License, or (at your option)
+any later version.
+
+AYMO is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with AYMO. If not, see <https://www.gnu.org/licenses/>.
+
+---
+
+Renders a single score to a WAVE file in segments, on multiple threads:
+
+    aymo_ymf262_split --threads 8 --checkpoints long.ckp long.vgm long.wav
+
+The output is bit-identical to a serial render.
+
+A checkpoint pass emulates the chip through the whole score, without
+generating samples, and captures the chip state at each segment start.
+The segments are rendered concurrently from their checkpoints, each as soon
+as its checkpoint is available, straight into their place within the mapped
+output file.
+
+The chip state only comes from a full emulation, so the checkpoint pass takes
+about as long as a serial render. With --checkpoints, captured states are
+saved to the given file, and reloaded by later renders of the same score with
+the same options: these skip the pass, and scale with the threads.
+
+Checkpoints are plain copies of the chip state, so they need an implementation
+whose state holds no pointers. The "none" implementation links its state with
+pointers: it renders serially, and refuses --checkpoints.
+*/
+
+#include "aymo.h"
+#include "aymo_app_map.h"
+#include "aymo_app_render.h"
+#include "aymo_app_thread.h"
+#include "aymo_cpu.h"
+#include "aymo_file.h"
+#include "aymo_score.h"
+#include "aymo_score_dro.h"
+#include "aymo_score_imf.h"
+#include "aymo_score_raw.h"
+#include "aymo_score_ref.h"
+#include "aymo_score_vgm.h"
+#include "aymo_wave.h"
+#include "aymo_ymf262.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+AYMO_CXX_EXTERN_C_BEGIN
+
+
+#define APP_THREAD_MAX      256u
+#define APP_SEGMENT_MAX     4096u
+
+
+struct app_args {
+    int argc;
+    char** argv;
+
+    // App parameters
+    unsigned loops;
+    unsigned threads;                   // 0 = one per CPU
+    bool benchmark;
+    bool thread_stats;
+
+    // Score parameters
+    const char* score_path_cstr;
+    const char* score_type_cstr;        // NULL uses score file extension
+    enum aymo_score_type score_type;
+    unsigned score_after;
+    int score_latency;
+
+    // Segment parameters
+    const char* checkpoints_path_cstr;  // NULL for none
+    uint32_t segment_length;            // [frames]
+
+    // Output parameters
+    const char* out_path_cstr;
+    uint32_t out_frame_length;
+    bool out_quad;
+
+    // YMF262 parameters
+    const struct aymo_ymf262_vt* ymf262_vt;
+};
+
+
+union app_scores {
+    struct aymo_score_instance base;
+    struct aymo_score_dro_instance dro;
+    struct aymo_score_imf_instance imf;
+    struct aymo_score_raw_instance raw;
+    struct aymo_score_ref_instance ref;
+    struct aymo_score_vgm_instance vgm;
+};
+
+
+// Playback position within the score
+struct app_cursor {
+    union app_scores score;
+    struct app_render render;
+};
+
+
+struct app_worker {
+    struct app_thread thread;
+    bool started;
+
+    struct aymo_ymf262_chip* chip;
+    struct app_cursor cursor;
+    int16_t* out_buffer_ptr;
+
+    // Statistics
+    uint64_t frame_total;
+    double busy_seconds;
+    unsigned segment_count;
+};
+
+
+// Checkpoint file heading; chip states follow, in segment order
+struct app_checkpoint_heading {
+    char magic[8];
+    char class_name[32];
+    uint64_t score_hash;
+    uint64_t frame_total;
+    uint32_t score_size;
+    uint32_t segment_length;
+    uint32_t segment_count;
+    uint32_t chip_size;
+    uint32_t loops;
+    uint32_t score_after;
+    int32_t score_latency;
+    uint32_t reserved;
+};
+
+
+static int app_return;
+
+static struct app_args app_args;
+
+static void* score_data;
+static size_t score_size;
+
+static uint64_t frame_total;
+static uint32_t segment_length;
+static uint32_t segment_count;
+static volatile uint32_t segment_next;  // taken by the workers
+static volatile uint32_t checkpoint_count;  // published by the checkpoint pass
+static volatile uint32_t checkpoint_failed;
+static uint8_t* checkpoints;            // segment_count * chip_size bytes
+static size_t chip_size;
+static bool checkpoints_loaded;
+static double checkpoint_seconds;
+
+static struct app_worker* workers;
+static unsigned worker_count;
+
+static bool out_mapped;
+static struct app_map out_map;
+static uint32_t out_frame_length;
+static size_t out_frame_size;
+
+
+static void* aymo_aligned_alloc(size_t size, size_t align)
+{
+    assert(align);
+    assert(size < (SIZE_MAX - align - align));
+
+    void* allocptr = calloc((size + align + align), 1u);
+    if (allocptr) {
+        uintptr_t alignaddr = ((uintptr_t)(void*)allocptr + align);
+        uintptr_t offset = (alignaddr % align);
+        alignaddr += ((align - offset) % align);
+        void* alignptr = (void*)alignaddr;
+        uintptr_t refaddr = (alignaddr - sizeof(void*));
+        void** refptr = (void**)(void*)refaddr;
+        *refptr = allocptr;
+        return alignptr;
+    }
+    return NULL;
+}
+
+
+static void aymo_aligned_free(void* alignptr)
+{
+    if (alignptr) {
+        uintptr_t alignaddr = (uintptr_t)alignptr;
+        uintptr_t refaddr = (alignaddr - sizeof(void*));
+        void** refptr = (void**)(void*)refaddr;
+        void* allocptr = *refptr;
+        free(allocptr);
+    }
+}
+
+
+static int app_boot(void)
+{
+    app_return = 2;
+
+    aymo_boot();
+    aymo_ymf262_boot();
+
+    score_data = NULL;
+    score_size = 0u;
+
+    frame_total = 0u;
+    segment_length = 0u;
+    segment_count = 0u;
+    segment_next = 0u;
+    checkpoint_count = 0u;
+    checkpoint_failed = 0u;
+    checkpoints = NULL;
+    chip_size = 0u;
+    checkpoints_loaded = false;
+    checkpoint_seconds = 0.;
+
+    workers = NULL;
+    worker_count = 0u;
+
+    out_mapped = false;
+    out_frame_length = 1u;
+    out_frame_size = 0u;
+
+    return 0;
+}
+
+
+static int app_args_init(int argc, char** argv)
+{
+    memset(&app_args, 0, sizeof(app_args));
+
+    app_args.argc = argc;
+    app_args.argv = argv;
+
+    app_args.loops = 1u;
+
+    app_args.score_type = aymo_score_type_unknown;
+    app_args.score_latency = AYMO_YMF262_REG_SAMPLE_LATENCY;
+
+    app_args.segment_length = (AYMO_YMF262_SAMPLE_RATE * 30u);
+
+    app_args.out_frame_length = 4096u;
+
+    app_args.ymf262_vt = aymo_ymf262_get_best_vt();
+
+    return 0;
+}
+
+
+static int app_usage(void)
+{
+    printf("Usage: aymo_ymf262_split [OPTIONS] SCORE OUTPUT.wav\n");
+    printf("\n");
+    printf("Options:\n");
+    printf("  --benchmark         Renders without writing the output, printing statistics only\n");
+    printf("  --buffer-size N     Frames rendered per block (default: 4096)\n");
+    printf("  --checkpoints PATH  Loads chip checkpoints from PATH if they match, else saves them there\n");
+    printf("  --cpu-ext TAG       YMF262 implementation (default: best)\n");
+    printf("  --help, -h          Shows this help\n");
+    printf("  --loops N           Plays the score N times (default: 1)\n");
+    printf("  --out-quad          Writes 4 channels instead of 2\n");
+    printf("  --score-after N     Frames of silence rendered after the score (default: 0)\n");
+    printf("  --score-latency N   Frames after each register write; negative queues writes (default: %d)\n",
+           (int)AYMO_YMF262_REG_SAMPLE_LATENCY);
+    printf("  --score-type EXT    Score type, instead of the file extension\n");
+    printf("  --segment-length N  Frames per segment (default: %u)\n", (unsigned)(AYMO_YMF262_SAMPLE_RATE * 30u));
+    printf("  --thread-stats      Prints per-thread statistics\n");
+    printf("  --threads N         Worker threads; 0 uses one per CPU (default: 0)\n");
+
+    return -1;  // help
+}
+
+
+static int app_args_parse(void)
+{
+    int argi;
+
+    for (argi = 1; argi < app_args.argc; ++argi) {
+        const char* name = app_args.argv[argi];
+
+        if (!strcmp(name, "--")) {
+            ++argi;
+            break;
+        }
+
+        // Unary options
+        if (!strcmp(name, "--benchmark")) {
+            app_args.benchmark = true;
+            continue;
+        }
+        if (!strcmp(name, "--help") || !strcmp(name, "-h")) {
+            return app_usage();
+        }
+        if (!strcmp(name, "--out-quad")) {
+            app_args.out_quad = true;
+            continue;
+        }
+        if (!strcmp(name, "--thread-stats")) {
+            app_args.thread_stats = true;
+            continue;
+        }
+
+        // Binary options
+        if (argi >= (app_args.argc - 1)) {
+            break;
+        }
+        if (!strcmp(name, "--buffer-size")) {
+            const char* text = app_args.argv[++argi];
+            errno = 0;
+            app_args.out_frame_length = (uint32_t)strtoul(text, NULL, 0);
+            if (errno) {
+                perror(name);
+                return 1;
+            }
+            continue;
+        }
+        if (!strcmp(name, "--checkpoints")) {
+            app_args.checkpoints_path_cstr = app_args.argv[++argi];
+            continue;
+        }
+        if (!strcmp(name, "--cpu-ext")) {
+            const char* text = app_args.argv[++argi];
+            app_args.ymf262_vt = aymo_ymf262_get_vt(text);
+            if (!app_args.ymf262_vt) {
+                fprintf(stderr, "ERROR: Unsupported CPU extensions tag: \"%s\"\n", text);
+                return 1;
+            }
+            continue;
+        }
+        if (!strcmp(name, "--loops")) {
+            const char* text = app_args.argv[++argi];
+            errno = 0;
+            app_args.loops = (unsigned)strtoul(text, NULL, 0);
+            if (errno) {
+                perror(name);
+                return 1;
+            }
+            if (!app_args.loops) {
+                fprintf(stderr, "ERROR: Endless loops not allowed for a file\n");
+                return 1;
+            }
+            continue;
+        }
+        if (!strcmp(name, "--score-after")) {
+            const char* text = app_args.argv[++argi];
+            errno = 0;
+            app_args.score_after = (unsigned)strtoul(text, NULL, 0);
+            if (errno) {
+                perror(name);
+                return 1;
+            }
+            continue;
+        }
+        if (!strcmp(name, "--score-latency")) {
+            const char* text = app_args.argv[++argi];
+            errno = 0;
+            app_args.score_latency = (int)strtol(text, NULL, 0);
+            if (errno) {
+                perror(name);
+                return 1;
+            }
+            continue;
+        }
+        if (!strcmp(name, "--score-type")) {
+            const char* value = app_args.argv[++argi];
+            app_args.score_type = aymo_score_ext_to_type(value);
+            if (app_args.score_type >= aymo_score_type_unknown) {
+                fprintf(stderr, "ERROR: Unknown score type \"%s\"\n", value);
+                return 1;
+            }
+            app_args.score_type_cstr = value;
+            continue;
+        }
+        if (!strcmp(name, "--segment-length")) {
+            const char* text = app_args.argv[++argi];
+            errno = 0;
+            app_args.segment_length = (uint32_t)strtoul(text, NULL, 0);
+            if (errno) {
+                perror(name);
+                return 1;
+            }
+            continue;
+        }
+        if (!strcmp(name, "--threads")) {
+            const char* text = app_args.argv[++argi];
+            errno = 0;
+            app_args.threads = (unsigned)strtoul(text, NULL, 0);
+            if (errno) {
+                perror(name);
+                return 1;
+            }
+            continue;
+        }
+        break;
+    }
+
+    if (argi < app_args.argc) {
+        app_args.score_path_cstr = app_args.argv[argi++];
+    }
+    if (argi < app_args.argc) {
+        app_args.out_path_cstr = app_args.argv[argi++];
+    }
+
+    if (!app_args.score_path_cstr || !strcmp(app_args.score_path_cstr, "-")) {
+        fprintf(stderr, "ERROR: Missing score file\n");
+        return 1;
+    }
+    if (!app_args.benchmark) {
+        // Segments are placed at random within the output
+        if (!app_args.out_path_cstr || !strcmp(app_args.out_path_cstr, "-")) {
+            fprintf(stderr, "ERROR: Missing output file\n");
+            return 1;
+        }
+    }
+
+    if (app_args.score_type >= aymo_score_type_unknown) {
+        const char* text = app_args.score_path_cstr;
+        const char* ext = strrchr(text, '.');
+        if (ext) {
+            app_args.score_type = aymo_score_ext_to_type(ext + 1);
+        }
+        if (app_args.score_type >= aymo_score_type_unknown) {
+            fprintf(stderr, "ERROR: Unsupported score type of \"%s\"\n", text);
+            return 1;
+        }
+    }
+
+    if (argi < app_args.argc) {
+        fprintf(stderr, "ERROR: Unknown options after #%d = \"%s\"\n", argi, app_args.argv[argi]);
+        return 1;
+    }
+
+    return 0;
+}
+
+
+static int app_cursor_ctor(struct app_cursor* cursor, struct aymo_ymf262_chip* chip)
+{
+    memset(cursor, 0, sizeof(*cursor));
+
+    union app_scores* score = &cursor->score;
+    score->base.vt = aymo_score_type_to_vt(app_args.score_type);
+    if (!score->base.vt) {
+        fprintf(stderr, "ERROR: Unsupported score type ID: %d\n", (int)app_args.score_type);
+        return 1;
+    }
+    aymo_score_ctor(&score->base);
+    if (aymo_score_load(&score->base, score_data, (uint32_t)score_size)) {
+        fprintf(stderr, "ERROR: Cannot load score \"%s\"\n", app_args.score_path_cstr);
+        aymo_score_dtor(&score->base);
+        score->base.vt = NULL;
+        return 1;
+    }
+
+    app_render_ctor(&cursor->render, chip, &score->base, app_args.loops, app_args.score_after,
+                    app_args.score_latency, app_args.out_quad);
+    return 0;
+}
+
+
+static void app_cursor_dtor(struct app_cursor* cursor)
+{
+    if (cursor->score.base.vt) {
+        aymo_score_unload(&cursor->score.base);
+        aymo_score_dtor(&cursor->score.base);
+    }
+    cursor->score.base.vt = NULL;
+}
+
+
+// Follows the score up to the target frame, without emulating the chip
+static void app_cursor_seek(struct app_cursor* cursor, uint64_t frame)
+{
+    struct app_render* render = &cursor->render;
+    struct aymo_ymf262_chip* chip = render->chip;
+    render->chip = NULL;
+
+    while (render->playing && (render->frame < frame)) {
+        uint64_t length = (frame - render->frame);
+        if (length > UINT32_MAX) {
+            length = UINT32_MAX;
+        }
+        (void)app_render_run(render, (uint32_t)length, NULL);
+    }
+
+    render->chip = chip;
+}
+
+
+static uint64_t app_score_hash(const void* data, size_t size)
+{
+    const uint8_t* ptr = (const uint8_t*)data;
+    uint64_t hash = 0xCBF29CE484222325uLL;  // FNV-1a
+
+    for (size_t i = 0u; i < size; ++i) {
+        hash ^= ptr[i];
+        hash *= 0x00000100000001B3uLL;
+    }
+    return hash;
+}
+
+
+static void app_checkpoint_heading_setup(struct app_checkpoint_heading* heading)
+{
+    memset(heading, 0, sizeof(*heading));
+    memcpy(heading->magic, "AYMOCKP1", 8u);
+    strncpy(heading->class_name, app_args.ymf262_vt->class_name, (sizeof(heading->class_name) - 1u));
+    heading->score_hash = app_score_hash(score_data, score_size);
+    heading->frame_total = frame_total;
+    heading->score_size = (uint32_t)score_size;
+    heading->segment_length = segment_length;
+    heading->segment_count = segment_count;
+    heading->chip_size = (uint32_t)chip_size;
+    heading->loops = app_args.loops;
+    heading->score_after = app_args.score_after;
+    heading->score_latency = app_args.score_latency;
+}
+
+
+// Loads checkpoints saved for the same score and options; silently fails otherwise
+static int app_checkpoints_load(void)
+{
+    struct app_map map;
+    FILE* file = fopen(app_args.checkpoints_path_cstr, "rb");
+    if (!file) {
+        return 1;  // first run
+    }
+    fclose(file);
+
+    if (app_map_open(&map, app_args.checkpoints_path_cstr)) {
+        return 1;
+    }
+
+    int status = 1;
+    struct app_checkpoint_heading expected;
+    app_checkpoint_heading_setup(&expected);
+
+    size_t size = (sizeof(expected) + (segment_count * chip_size));
+    if ((map.size == size) && !memcmp(map.data, &expected, sizeof(expected))) {
+        memcpy(checkpoints, ((const uint8_t*)map.data + sizeof(expected)), (segment_count * chip_size));
+        checkpoint_count = segment_count;
+        checkpoints_loaded = true;
+        status = 0;
+    }
+    else {
+        fprintf(stderr, "WARNING: Checkpoints of \"%s\" do not match; computing again\n",
+                app_args.checkpoints_path_cstr);
+    }
+
+    (void)app_map_close(&map);
+    return status;
+}
+
+
+static int app_checkpoints_save(void)
+{
+    struct app_checkpoint_heading heading;
+    app_checkpoint_heading_setup(&heading);
+
+    FILE* file = fopen(app_args.checkpoints_path_cstr, "wb");
+    if (!file) {
+        perror(app_args.checkpoints_path_cstr);
+        return 1;
+    }
+    int status = 0;
+    if ((fwrite(&heading, sizeof(heading), 1u, file) != 1u) ||
+        (fwrite(checkpoints, chip_size, segment_count, file) != segment_count)) {
+        perror(app_args.checkpoints_path_cstr);
+        status = 1;
+    }
+    if (fclose(file)) {
+        perror(app_args.checkpoints_path_cstr);
+        status = 1;
+    }
+    return status;
+}
+
+
+// Chip states that can be copied into another chip, or saved to a file
+static bool app_vt_is_relocatable(const struct aymo_ymf262_vt* vt)
+{
+    return (vt != aymo_ymf262_get_vt("none"));
+}
+
+
+static int app_setup(void)
+{
+    if (aymo_file_load(app_args.score_path_cstr, &score_data, &score_size)) {
+        return 1;
+    }
+    if (score_size > UINT32_MAX) {
+        fprintf(stderr, "ERROR: Score too large \"%s\"\n", app_args.score_path_cstr);
+        return 1;
+    }
+
+    out_frame_size = (sizeof(int16_t) * (app_args.out_quad ? 4u : 2u));
+    out_frame_length = app_args.out_frame_length;
+    if (out_frame_length < 1u) {
+        out_frame_length = 1u;
+    }
+    if (out_frame_length > (UINT32_MAX / out_frame_size)) {
+        out_frame_length = (uint32_t)(UINT32_MAX / out_frame_size);
+    }
+
+    // Following the score alone is cheap, and tells the output length
+    struct app_cursor cursor;
+    if (app_cursor_ctor(&cursor, NULL)) {
+        app_cursor_dtor(&cursor);
+        return 1;
+    }
+    app_cursor_seek(&cursor, UINT64_MAX);
+    frame_total = cursor.render.frame;
+    app_cursor_dtor(&cursor);
+
+    worker_count = app_args.threads;
+    if (!worker_count) {
+        worker_count = app_thread_get_cpu_count();
+    }
+    if (worker_count > APP_THREAD_MAX) {
+        worker_count = APP_THREAD_MAX;
+    }
+    if (worker_count < 1u) {
+        worker_count = 1u;
+    }
+    if (!app_vt_is_relocatable(app_args.ymf262_vt)) {
+        if (app_args.checkpoints_path_cstr) {
+            fprintf(stderr, "ERROR: Checkpoints not supported by \"%s\"\n", app_args.ymf262_vt->class_name);
+            return 1;
+        }
+        if (worker_count > 1u) {
+            fprintf(stderr, "WARNING: \"%s\" cannot be split; rendering serially\n", app_args.ymf262_vt->class_name);
+            worker_count = 1u;
+        }
+    }
+
+    segment_length = app_args.segment_length;
+    if (segment_length < out_frame_length) {
+        segment_length = out_frame_length;
+    }
+    if ((worker_count == 1u) && !app_args.checkpoints_path_cstr) {
+        segment_length = UINT32_MAX;  // plain serial render
+    }
+    while ((frame_total / segment_length) >= APP_SEGMENT_MAX) {
+        segment_length = ((segment_length < (UINT32_MAX / 2u)) ? (segment_length * 2u) : UINT32_MAX);
+    }
+    segment_count = (uint32_t)((frame_total + segment_length - 1u) / segment_length);
+    if (segment_count < 1u) {
+        segment_count = 1u;
+    }
+    if (worker_count > segment_count) {
+        worker_count = segment_count;
+    }
+
+    chip_size = app_args.ymf262_vt->get_sizeof();
+    checkpoints = (uint8_t*)calloc(segment_count, chip_size);
+    if (!checkpoints) {
+        perror("calloc(checkpoints)");
+        return 2;
+    }
+    if (app_args.checkpoints_path_cstr) {
+        (void)app_checkpoints_load();
+    }
+
+    workers = (struct app_worker*)calloc(worker_count, sizeof(*workers));
+    if (!workers) {
+        perror("calloc(workers)");
+        return 2;
+    }
+    for (unsigned w = 0u; w < worker_count; ++w) {
+        struct app_worker* worker = &workers[w];
+
+        void* chip_alignptr = aymo_aligned_alloc(chip_size, 32u);
+        if (!chip_alignptr) {
+            perror("aymo_aligned_alloc(chip_size)");
+            return 2;
+        }
+        worker->chip = (struct aymo_ymf262_chip*)chip_alignptr;
+        worker->chip->vt = app_args.ymf262_vt;
+        aymo_ymf262_ctor(worker->chip);
+
+        worker->out_buffer_ptr = (int16_t*)malloc(out_frame_length * out_frame_size);
+        if (!worker->out_buffer_ptr) {
+            perror("malloc(out_buffer_size)");
+            return 2;
+        }
+    }
+
+    if (!app_args.benchmark) {
+        struct aymo_wave_heading wave_head;
+        if (frame_total > ((UINT32_MAX - sizeof(wave_head)) / out_frame_size)) {
+            fprintf(stderr, "ERROR: Output too long for a WAVE file: \"%s\"\n", app_args.out_path_cstr);
+            return 1;
+        }
+        if (app_map_create(&out_map, app_args.out_path_cstr, (sizeof(wave_head) + (frame_total * out_frame_size)))) {
+            return 1;
+        }
+        out_mapped = true;
+
+        aymo_wave_heading_setup(&wave_head, AYMO_WAVE_FMT_TYPE_PCM, (uint16_t)(out_frame_size / sizeof(int16_t)),
+                                16u, AYMO_YMF262_SAMPLE_RATE, (uint32_t)frame_total);
+        memcpy(out_map.data, &wave_head, sizeof(wave_head));
+    }
+
+    return 0;
+}
+
+
+static void app_teardown(void)
+{
+    if (workers) {
+        for (unsigned w = 0u; w < worker_count; ++w) {
+            struct app_worker* worker = &workers[w];
+
+            if (worker->started) {
+                (void)app_thread_join(&worker->thread);
+            }
+            app_cursor_dtor(&worker->cursor);
+            if (worker->chip) {
+                aymo_ymf262_dtor(worker->chip);
+                aymo_aligned_free(worker->chip);
+            }
+            free(worker->out_buffer_ptr);
+        }
+        free(workers);
+    }
+    workers = NULL;
+    worker_count = 0u;
+
+    free(checkpoints);
+    checkpoints = NULL;
+
+    aymo_file_unload(score_data);
+    score_data = NULL;
+
+    if (out_mapped) {
+        (void)app_map_close(&out_map);
+    }
+    out_mapped = false;
+}
+
+
+// Captures the chip state at each segment start, publishing them in order
+static int app_checkpoint_pass(void)
+{
+    double time_start = app_clock_seconds();
+    struct aymo_ymf262_chip* chip = workers[0].chip;
+    struct app_cursor cursor;
+
+    aymo_ymf262_ctor(chip);
+    if (app_cursor_ctor(&cursor, chip)) {
+        app_cursor_dtor(&cursor);
+        return 1;
+    }
+
+    for (uint32_t k = 0u; k < segment_count; ++k) {
+        if (k) {
+            (void)app_render_run(&cursor.render, segment_length, NULL);
+        }
+        uint8_t* checkpoint = &checkpoints[k * chip_size];
+        memcpy(checkpoint, chip, chip_size);
+        memset(checkpoint, 0, sizeof(struct aymo_ymf262_chip));  // VT, not portable
+        app_atomic_store_u32(&checkpoint_count, (k + 1u));
+    }
+
+    app_cursor_dtor(&cursor);
+    checkpoint_seconds = (app_clock_seconds() - time_start);
+    return 0;
+}
+
+
+static int app_worker_segment(struct app_worker* worker, uint32_t k)
+{
+    struct app_cursor* cursor = &worker->cursor;
+    struct aymo_ymf262_chip* chip = worker->chip;
+
+    // Resume both the score and the chip at the segment start
+    app_cursor_dtor(cursor);
+    if (app_cursor_ctor(cursor, chip)) {
+        return 1;
+    }
+    uint64_t frame = ((uint64_t)k * segment_length);
+    app_cursor_seek(cursor, frame);
+
+    const uint8_t* checkpoint = &checkpoints[k * chip_size];
+    memcpy(((uint8_t*)chip + sizeof(*chip)), (checkpoint + sizeof(*chip)), (chip_size - sizeof(*chip)));
+
+    uint64_t end = (frame + segment_length);
+    if (end > frame_total) {
+        end = frame_total;
+    }
+
+    while (cursor->render.frame < end) {
+        uint64_t length = (end - cursor->render.frame);
+        if (length > out_frame_length) {
+            length = out_frame_length;
+        }
+        uint64_t offset = cursor->render.frame;
+        uint32_t done = app_render_run(&cursor->render, (uint32_t)length, worker->out_buffer_ptr);
+        if (!done) {
+            break;
+        }
+        if (out_mapped) {
+            uint8_t* out_ptr = ((uint8_t*)out_map.data + sizeof(struct aymo_wave_heading));
+            memcpy(&out_ptr[offset * out_frame_size], worker->out_buffer_ptr, (done * out_frame_size));
+        }
+        worker->frame_total += done;
+    }
+
+    ++worker->segment_count;
+    return 0;
+}
+
+
+static int app_worker_run(void* context)
+{
+    struct app_worker* worker = (struct app_worker*)context;
+    double time_start = app_clock_seconds();
+    int status = 0;
+
+    for (;;) {
+        uint32_t k = app_atomic_add_u32(&segment_next, 1u);
+        if (k >= segment_count) {
+            break;
+        }
+
+        unsigned spins = 0u;
+        while (app_atomic_load_u32(&checkpoint_count) <= k) {
+            if (app_atomic_load_u32(&checkpoint_failed)) {
+                status = 1;
+                break;
+            }
+            app_thread_backoff(&spins);
+        }
+        if (status) {
+            break;
+        }
+
+        if (app_worker_segment(worker, k)) {
+            status = 1;
+            break;
+        }
+    }
+
+    worker->busy_seconds = (app_clock_seconds() - time_start);
+    return status;
+}
+
+
+static int app_run(void)
+{
+    double time_start = app_clock_seconds();
+    int status = 0;
+
+    for (unsigned w = 1u; w < worker_count; ++w) {
+        struct app_worker* worker = &workers[w];
+        if (app_thread_start(&worker->thread, app_worker_run, worker)) {
+            fprintf(stderr, "ERROR: Cannot start worker thread #%u\n", w);
+            return 2;
+        }
+        worker->started = true;
+    }
+
+    // The calling thread runs the checkpoint pass, then works as the first worker
+    if (!checkpoints_loaded) {
+        if (app_checkpoint_pass()) {
+            app_atomic_store_u32(&checkpoint_failed, 1u);  // stop workers
+            status = 1;
+        }
+    }
+    if (!status && app_worker_run(&workers[0])) {
+        status = 1;
+    }
+
+    for (unsigned w = 1u; w < worker_count; ++w) {
+        struct app_worker* worker = &workers[w];
+        if (app_thread_join(&worker->thread)) {
+            status = 1;
+        }
+        worker->started = false;
+    }
+
+    double wall_seconds = (app_clock_seconds() - time_start);
+
+    if (!checkpoints_loaded && app_args.checkpoints_path_cstr && !status) {
+        if (app_checkpoints_save()) {
+            status = 1;
+        }
+    }
+
+    if (out_mapped) {
+        out_mapped = false;
+        if (app_map_close(&out_map)) {
+            status = 2;
+        }
+    }
+
+    if (app_args.thread_stats) {
+        for (unsigned w = 0u; w < worker_count; ++w) {
+            const struct app_worker* worker = &workers[w];
+            fprintf(stderr, "Thread #%u: %u segments, %.3f seconds\n",
+                    w, worker->segment_count, worker->busy_seconds);
+        }
+    }
+
+    double audio_seconds = ((double)frame_total / (double)AYMO_YMF262_SAMPLE_RATE);
+    printf("Segments: %u x %lu frames, with %u threads\n",
+           segment_count, (unsigned long)segment_length, worker_count);
+    if (checkpoints_loaded) {
+        printf("Checkpoints: loaded\n");
+    }
+    else {
+        printf("Checkpoints: %.3f seconds\n", checkpoint_seconds);
+    }
+    printf("Audio time: %.3f seconds\n", audio_seconds);
+    printf("Render time: %.3f seconds\n", wall_seconds);
+    printf("Throughput: %.1fx realtime\n", ((wall_seconds > 0.) ? (audio_seconds / wall_seconds) : 0.));
+
+    return status;
+}
+
+
+int main(int argc, char** argv)
+{
+    app_return = app_boot();
+    if (app_return) goto catch_;
+
+    app_return = app_args_init(argc, argv);
+    if (app_return) goto catch_;
+
+    app_return = app_args_parse();
+    if (app_return == -1) {  // help
+        app_return = 0;
+        goto finally_;
+    }
+    if (app_return) goto catch_;
+
+    app_return = app_setup();
+    if (app_return) goto catch_;
+
+    app_return = app_run();
+    if (app_return) goto catch_;
+
+    goto finally_;
+
+catch_:
+finally_:
+    app_teardown();
+    return app_return;
+}
+
+
+AYMO_CXX_EXTERN_C_END
@@ -0,0 +1,79 @@
+import json
+import os
+import sys
+from contextlib import redirect_stdout
+
+__thin__ = '-' * 80
+
+
+def parse_seconds(stdout, label):
+    rtidx = stdout.index(label)
+    sidx = stdout.index('seconds', rtidx)
+    return float(stdout[rtidx+len(label):sidx])
+
+
+if __name__ == '__main__':
+    inpath = sys.argv[1]
+    outpath = sys.argv[2]
+
+    with open(inpath, 'rt') as infile:
+        lines = infile.readlines()
+
+    durations = {}
+    hot_durations = {}
+    cpuexts = set()
+    rows = set()
+
+    for index, line in enumerate(lines):
+        print(__thin__)
+        print(f'Entry:      {1+index:3d} / {len(lines):3d}')
+
+        info = json.loads(line)
+        name = info['name']
+        if not name.startswith('convert_'):
+            continue
+
+        cmdline = info['command']
+        cpuext = cmdline[cmdline.index('--cpu-ext')+1]
+        mode = cmdline[cmdline.index('--mode')+1]
+        stores = cmdline[cmdline.index('--stores')+1]
+        hot_size = int(cmdline[cmdline.index('--hot-size')+1])
+        buffer_length = int(cmdline[cmdline.index('--buffer-length')+1])
+        exit_code = info['returncode']
+
+        print(f'CPU-ext:    {cpuext}')
+        print(f'Command:    {cmdline}')
+        print(f'Exit-code:  {exit_code}')
+        assert not exit_code
+
+        cpuexts.add(cpuext)
+        row = (mode, stores, hot_size, buffer_length)
+        rows.add(row)
+        stdout = info['stdout']
+        duration = parse_seconds(stdout, 'Render time:')
+        hot_duration = parse_seconds(stdout, 'Hot time:')
+        print(f'Duration:   {duration} seconds')
+        print(f'Hot:        {hot_duration} seconds')
+
+        durations[(row, cpuext)] = duration
+        hot_durations[(row, cpuext)] = hot_duration
+
+    cpuexts.remove('none')
+    cpuexts = ['none'] + list(sorted(cpuexts))
+
+    with open(outpath, 'wt') as outfile:
+        outfile.write(f'MODE,STORES,HOT_SIZE,BUFFER_LENGTH')
+        for cpuext in cpuexts:
+            outfile.write(f',{cpuext}')
+        for cpuext in cpuexts:
+            outfile.write(f',{cpuext}_hot')
+        outfile.write('\n')
+
+        for row in sorted(rows):
+            mode, stores, hot_size, buffer_length = row
+            outfile.write(f'{mode},{stores},{hot_size},{buffer_length}')
+            for table in (durations, hot_durations):
+                for cpuext in cpuexts:
+                    duration = table.get((row, cpuext))
+                    outfile.write(',' if duration is None else f',{duration:.6f}')
+            outfile.write('\n')
@@ -0,0 +1,106 @@
+/*
+AYMO - Accelerated YaMaha Operator
+Copyright (c) 2023-2024 Andrea Zoppi.
+
+This file is part of AYMO.
+
+AYMO is free software: you can redistribute it and/or modify it under the
+terms of the GNU Lesser General Public License as published by the Free
+Software Foundation, either version 2.1 of the License, or (at your option)
+any later version.
+
+AYMO is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with AYMO. If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef _include_aymo_adlibgold_h
+#define _include_aymo_adlibgold_h
+
+#include "aymo_tda8425.h"
+#include "aymo_ym7128.h"
+#include "aymo_ymf262.h"
+
+AYMO_CXX_EXTERN_C_BEGIN
+
+
+// AdLib Gold audio path, as a single pipeline:
+//   YMF262 @ 49716 Hz --> resampler --> dry @ 47100 Hz -----------+--> TDA8425 @ 47100 Hz
+//                                        |                        ^
+//                                        +--> mono @ 23550 Hz --> YM7128 --> wet
+// Each pass runs a block of frames through all the stages, so that the
+// intermediate buffers stay in L1 cache.
+#define AYMO_ADLIBGOLD_SAMPLE_RATE      AYMO_YM7128_SAMPLE_RATE_OUT  // [Hz]
+#define AYMO_ADLIBGOLD_BLOCK_LENGTH     256  // frames per pass, even
+#define AYMO_ADLIBGOLD_SOURCE_HISTORY   3  // YMF262 frames kept by the cubic resampler
+#define AYMO_ADLIBGOLD_SOURCE_LENGTH    \
+    (((AYMO_ADLIBGOLD_BLOCK_LENGTH * AYMO_YMF262_SAMPLE_RATE) / AYMO_ADLIBGOLD_SAMPLE_RATE) + 2)
+#define AYMO_ADLIBGOLD_CHIP_ALIGN       64  // [bytes]
+
+// Register address map of the write front end
+#define AYMO_ADLIBGOLD_ADDRESS_YMF262   0x000  // 0x000-0x1FF
+#define AYMO_ADLIBGOLD_ADDRESS_YM7128   0x200  // 0x200-0x21F
+#define AYMO_ADLIBGOLD_ADDRESS_TDA8425  0x220  // 0x220-0x22F
+#define AYMO_ADLIBGOLD_ADDRESS_END      0x230
+
+
+// Followed by the owned chips, within the same aymo_adlibgold_get_sizeof() bytes.
+// Size/alignment order, with the stage buffers first, at aligned offsets.
+struct aymo_adlibgold {
+    // Stage buffers, interleaved stereo unless mono
+    float src[(AYMO_ADLIBGOLD_SOURCE_HISTORY + AYMO_ADLIBGOLD_SOURCE_LENGTH) * 2];
+    float dry[AYMO_ADLIBGOLD_BLOCK_LENGTH * 2];
+    float wet[AYMO_ADLIBGOLD_BLOCK_LENGTH * 2];
+    float out[AYMO_ADLIBGOLD_BLOCK_LENGTH * 2];
+    float mono[AYMO_ADLIBGOLD_BLOCK_LENGTH / 2];
+
+    // Pointer data
+    struct aymo_ymf262_chip* ymf262;
+    struct aymo_ym7128_chip* ym7128;
+    struct aymo_tda8425_chip* tda8425;
+
+    // 64-bit data
+    uint64_t src_pos;  // 32.32 source frame of the next frame, after the oldest history frame
+    uint64_t src_step;  // 32.32 source frames per frame
+
+    // 32-bit data
+    float pending_frame[2];
+    float dry_gain;
+    float wet_gain;
+    uint32_t pending;  // frames left in pending_frame[]
+};
+
+
+// NULL virtual tables select the best ones, after booting the chip modules.
+// Memory must be aligned to AYMO_ADLIBGOLD_CHIP_ALIGN bytes.
+AYMO_PUBLIC uint32_t aymo_adlibgold_get_sizeof(
+    const struct aymo_ymf262_vt* ymf262_vt,
+    const struct aymo_ym7128_vt* ym7128_vt,
+    const struct aymo_tda8425_vt* tda8425_vt
+);
+AYMO_PUBLIC void aymo_adlibgold_ctor(
+    struct aymo_adlibgold* ag,
+    const struct aymo_ymf262_vt* ymf262_vt,
+    const struct aymo_ym7128_vt* ym7128_vt,
+    const struct aymo_tda8425_vt* tda8425_vt
+);
+AYMO_PUBLIC void aymo_adlibgold_dtor(struct aymo_adlibgold* ag);
+
+// Writes take effect from the next generated frame; unmapped addresses are ignored.
+AYMO_PUBLIC uint8_t aymo_adlibgold_read(struct aymo_adlibgold* ag, uint16_t address);
+AYMO_PUBLIC void aymo_adlibgold_write(struct aymo_adlibgold* ag, uint16_t address, uint8_t value);
+
+// Mix of the YMF262 signal and of the YM7128 output into the TDA8425; 1 and 1 by default
+AYMO_PUBLIC void aymo_adlibgold_set_mix(struct aymo_adlibgold* ag, float dry_gain, float wet_gain);
+
+// Interleaved stereo frames at AYMO_ADLIBGOLD_SAMPLE_RATE; float samples are +/-1 full scale
+AYMO_PUBLIC void aymo_adlibgold_generate_f32x2(struct aymo_adlibgold* ag, uint32_t count, float y[]);
+AYMO_PUBLIC void aymo_adlibgold_generate_i16x2(struct aymo_adlibgold* ag, uint32_t count, int16_t y[]);
+
+
+AYMO_CXX_EXTERN_C_END
+
+#endif  // _include_aymo_adlibgold_h
@@ -28,8 +28,44 @@ along with AYMO. If not, see <https://www.gnu.org/licenses/>.
 AYMO_CXX_EXTERN_C_BEGIN
 
 
+#define AYMO_CONVERT_I24_MIN    (-0x7FFFFF - 1)
+#define AYMO_CONVERT_I24_MAX    (+0x7FFFFF)
+
+
+// Running statistics of the int16 side of metered conversions.
+// Sample i of each call belongs to channel (i % channels), so calls must pass
+// whole frames; statistics carry over from one call to the next.
+#define AYMO_CONVERT_METER_CHANNELS_MAX     2
+
+struct aymo_convert_meter {
+    uint64_t sumsq[AYMO_CONVERT_METER_CHANNELS_MAX];  // sum of squared samples
+    uint64_t count[AYMO_CONVERT_METER_CHANNELS_MAX];  // metered samples
+    uint64_t zero_lead[AYMO_CONVERT_METER_CHANNELS_MAX];  // zeros before the first non-zero sample
+    uint64_t zero_run[AYMO_CONVERT_METER_CHANNELS_MAX];  // zeros after the last non-zero sample
+    uint64_t zero_run_max[AYMO_CONVERT_METER_CHANNELS_MAX];  // longest run of zeros ended by a non-zero sample
+    uint32_t peak[AYMO_CONVERT_METER_CHANNELS_MAX];  // largest magnitude
+    uint32_t channels;  // 1 = mono, 2 = interleaved stereo
+};
+
+
+// Outputs of at least this many bytes are written with non-temporal stores,
+// so that they do not evict the working set of the caller.
+// Applies to the int16 <-> float32 conversions on x86 (SSE4.1, AVX2) only;
+// other targets always use regular stores. SIZE_MAX disables streaming.
+#define AYMO_CONVERT_STREAM_THRESHOLD_DEFAULT   ((size_t)1 << 20)
+
+
 AYMO_PUBLIC void aymo_convert_boot(void);
 
+AYMO_PUBLIC void aymo_convert_set_stream_threshold(size_t size);
+AYMO_PUBLIC size_t aymo_convert_get_stream_threshold(void);
+
+AYMO_PUBLIC void aymo_convert_meter_ctor(struct aymo_convert_meter* meter, uint32_t channels);
+
+// Zero-run bookkeeping shared by the backends: n <= 32 whole-frame samples,
+// where bit i of zeros is set if sample i is zero
+AYMO_PUBLIC void aymo_convert_meter_zeros(struct aymo_convert_meter* meter, size_t n, uint32_t zeros);
+
 AYMO_PUBLIC void aymo_convert_i16_f32(size_t n, const int16_t i16v[], float f32v[]);
 AYMO_PUBLIC void aymo_convert_f32_i16(size_t n, const float f32v[], int16_t i16v[]);
 
@@ -48,6 +84,60 @@ AYMO_PUBLIC void aymo_convert_f32_u16_1(size_t n, const float f32v[], uint16_t u
 AYMO_PUBLIC void aymo_convert_u16_f32_k(size_t n, const uint16_t u16v[], float f32v[], float scale);
 AYMO_PUBLIC void aymo_convert_f32_u16_k(size_t n, const float f32v[], uint16_t u16v[], float scale);
 
+AYMO_PUBLIC void aymo_convert_i8_f32(size_t n, const int8_t i8v[], float f32v[]);
+AYMO_PUBLIC void aymo_convert_f32_i8(size_t n, const float f32v[], int8_t i8v[]);
+
+AYMO_PUBLIC void aymo_convert_i8_f32_1(size_t n, const int8_t i8v[], float f32v[]);
+AYMO_PUBLIC void aymo_convert_f32_i8_1(size_t n, const float f32v[], int8_t i8v[]);
+
+AYMO_PUBLIC void aymo_convert_i8_f32_k(size_t n, const int8_t i8v[], float f32v[], float scale);
+AYMO_PUBLIC void aymo_convert_f32_i8_k(size_t n, const float f32v[], int8_t i8v[], float scale);
+
+AYMO_PUBLIC void aymo_convert_u8_f32(size_t n, const uint8_t u8v[], float f32v[]);
+AYMO_PUBLIC void aymo_convert_f32_u8(size_t n, const float f32v[], uint8_t u8v[]);
+
+AYMO_PUBLIC void aymo_convert_u8_f32_1(size_t n, const uint8_t u8v[], float f32v[]);
+AYMO_PUBLIC void aymo_convert_f32_u8_1(size_t n, const float f32v[], uint8_t u8v[]);
+
+AYMO_PUBLIC void aymo_convert_u8_f32_k(size_t n, const uint8_t u8v[], float f32v[], float scale);
+AYMO_PUBLIC void aymo_convert_f32_u8_k(size_t n, const float f32v[], uint8_t u8v[], float scale);
+
+// Packed 24-bit little-endian signed samples, 3 bytes each
+AYMO_PUBLIC void aymo_convert_i24_f32(size_t n, const uint8_t i24v[], float f32v[]);
+AYMO_PUBLIC void aymo_convert_f32_i24(size_t n, const float f32v[], uint8_t i24v[]);
+
+AYMO_PUBLIC void aymo_convert_i24_f32_1(size_t n, const uint8_t i24v[], float f32v[]);
+AYMO_PUBLIC void aymo_convert_f32_i24_1(size_t n, const float f32v[], uint8_t i24v[]);
+
+AYMO_PUBLIC void aymo_convert_i24_f32_k(size_t n, const uint8_t i24v[], float f32v[], float scale);
+AYMO_PUBLIC void aymo_convert_f32_i24_k(size_t n, const float f32v[], uint8_t i24v[], float scale);
+
+AYMO_PUBLIC void aymo_convert_i32_f32(size_t n, const int32_t i32v[], float f32v[]);
+AYMO_PUBLIC void aymo_convert_f32_i32(size_t n, const float f32v[], int32_t i32v[]);
+
+AYMO_PUBLIC void aymo_convert_i32_f32_1(size_t n, const int32_t i32v[], float f32v[]);
+AYMO_PUBLIC void aymo_convert_f32_i32_1(size_t n, const float f32v[], int32_t i32v[]);
+
+AYMO_PUBLIC void aymo_convert_i32_f32_k(size_t n, const int32_t i32v[], float f32v[], float scale);
+AYMO_PUBLIC void aymo_convert_f32_i32_k(size_t n, const float f32v[], int32_t i32v[], float scale);
+
+AYMO_PUBLIC void aymo_convert_f64_f32(size_t n, const double f64v[], float f32v[]);
+AYMO_PUBLIC void aymo_convert_f32_f64(size_t n, const float f32v[], double f64v[]);
+
+AYMO_PUBLIC void aymo_convert_f64_f32_k(size_t n, const double f64v[], float f32v[], float scale);
+AYMO_PUBLIC void aymo_convert_f32_f64_k(size_t n, const float f32v[], double f64v[], float scale);
+
+// Fused layout conversions; n counts frames, planar buffers are per channel.
+// Quad to stereo downmix: L = (A * k[0]) + (C * k[2]), R = (B * k[1]) + (D * k[3])
+AYMO_PUBLIC void aymo_convert_i16x2_f32x2_k(size_t n, const int16_t i16x2v[], float f32lv[], float f32rv[], float scale);
+AYMO_PUBLIC void aymo_convert_f32x2_i16x2_k(size_t n, const float f32lv[], const float f32rv[], int16_t i16x2v[], float scale);
+
+AYMO_PUBLIC void aymo_convert_i16x4_i16x2_k(size_t n, const int16_t i16x4v[], int16_t i16x2v[], const float k[4]);
+AYMO_PUBLIC void aymo_convert_i16x4_f32x2_k(size_t n, const int16_t i16x4v[], float f32x2v[], const float k[4]);
+
+AYMO_PUBLIC void aymo_convert_i16_f32_k_m(size_t n, const int16_t i16v[], float f32v[], float scale, struct aymo_convert_meter* meter);
+AYMO_PUBLIC void aymo_convert_f32_i16_k_m(size_t n, const float f32v[], int16_t i16v[], float scale, struct aymo_convert_meter* meter);
+
 
 AYMO_CXX_EXTERN_C_END
 
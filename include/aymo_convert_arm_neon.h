@@ -53,6 +53,12 @@ AYMO_PUBLIC void aymo_(f32_u16_1)(size_t n, const float f32v[], uint16_t i16v[])
 AYMO_PUBLIC void aymo_(u16_f32_k)(size_t n, const uint16_t i16v[], float f32v[], float scale);
 AYMO_PUBLIC void aymo_(f32_u16_k)(size_t n, const float f32v[], uint16_t i16v[], float scale);
 
+AYMO_PUBLIC void aymo_(i16x2_f32x2_k)(size_t n, const int16_t i16x2v[], float f32lv[], float f32rv[], float scale);
+AYMO_PUBLIC void aymo_(f32x2_i16x2_k)(size_t n, const float f32lv[], const float f32rv[], int16_t i16x2v[], float scale);
+
+AYMO_PUBLIC void aymo_(i16x4_i16x2_k)(size_t n, const int16_t i16x4v[], int16_t i16x2v[], const float k[4]);
+AYMO_PUBLIC void aymo_(i16x4_f32x2_k)(size_t n, const int16_t i16x4v[], float f32x2v[], const float k[4]);
+
 
 #ifndef AYMO_KEEP_SHORTHANDS
     #undef AYMO_KEEP_SHORTHANDS
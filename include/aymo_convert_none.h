@@ -21,6 +21,7 @@ along with AYMO. If not, see <https://www.gnu.org/licenses/>.
 #define _include_aymo_convert_none_h
 
 #include "aymo_cc.h"
+#include "aymo_convert.h"
 
 #include <stddef.h>
 #include <stdint.h>
@@ -52,6 +53,57 @@ AYMO_PUBLIC void aymo_(f32_u16_1)(size_t n, const float f32v[], uint16_t i16v[])
 AYMO_PUBLIC void aymo_(u16_f32_k)(size_t n, const uint16_t i16v[], float f32v[], float scale);
 AYMO_PUBLIC void aymo_(f32_u16_k)(size_t n, const float f32v[], uint16_t i16v[], float scale);
 
+AYMO_PUBLIC void aymo_(i8_f32)(size_t n, const int8_t i8v[], float f32v[]);
+AYMO_PUBLIC void aymo_(f32_i8)(size_t n, const float f32v[], int8_t i8v[]);
+
+AYMO_PUBLIC void aymo_(i8_f32_1)(size_t n, const int8_t i8v[], float f32v[]);
+AYMO_PUBLIC void aymo_(f32_i8_1)(size_t n, const float f32v[], int8_t i8v[]);
+
+AYMO_PUBLIC void aymo_(i8_f32_k)(size_t n, const int8_t i8v[], float f32v[], float scale);
+AYMO_PUBLIC void aymo_(f32_i8_k)(size_t n, const float f32v[], int8_t i8v[], float scale);
+
+AYMO_PUBLIC void aymo_(u8_f32)(size_t n, const uint8_t u8v[], float f32v[]);
+AYMO_PUBLIC void aymo_(f32_u8)(size_t n, const float f32v[], uint8_t u8v[]);
+
+AYMO_PUBLIC void aymo_(u8_f32_1)(size_t n, const uint8_t u8v[], float f32v[]);
+AYMO_PUBLIC void aymo_(f32_u8_1)(size_t n, const float f32v[], uint8_t u8v[]);
+
+AYMO_PUBLIC void aymo_(u8_f32_k)(size_t n, const uint8_t u8v[], float f32v[], float scale);
+AYMO_PUBLIC void aymo_(f32_u8_k)(size_t n, const float f32v[], uint8_t u8v[], float scale);
+
+AYMO_PUBLIC void aymo_(i24_f32)(size_t n, const uint8_t i24v[], float f32v[]);
+AYMO_PUBLIC void aymo_(f32_i24)(size_t n, const float f32v[], uint8_t i24v[]);
+
+AYMO_PUBLIC void aymo_(i24_f32_1)(size_t n, const uint8_t i24v[], float f32v[]);
+AYMO_PUBLIC void aymo_(f32_i24_1)(size_t n, const float f32v[], uint8_t i24v[]);
+
+AYMO_PUBLIC void aymo_(i24_f32_k)(size_t n, const uint8_t i24v[], float f32v[], float scale);
+AYMO_PUBLIC void aymo_(f32_i24_k)(size_t n, const float f32v[], uint8_t i24v[], float scale);
+
+AYMO_PUBLIC void aymo_(i32_f32)(size_t n, const int32_t i32v[], float f32v[]);
+AYMO_PUBLIC void aymo_(f32_i32)(size_t n, const float f32v[], int32_t i32v[]);
+
+AYMO_PUBLIC void aymo_(i32_f32_1)(size_t n, const int32_t i32v[], float f32v[]);
+AYMO_PUBLIC void aymo_(f32_i32_1)(size_t n, const float f32v[], int32_t i32v[]);
+
+AYMO_PUBLIC void aymo_(i32_f32_k)(size_t n, const int32_t i32v[], float f32v[], float scale);
+AYMO_PUBLIC void aymo_(f32_i32_k)(size_t n, const float f32v[], int32_t i32v[], float scale);
+
+AYMO_PUBLIC void aymo_(f64_f32)(size_t n, const double f64v[], float f32v[]);
+AYMO_PUBLIC void aymo_(f32_f64)(size_t n, const float f32v[], double f64v[]);
+
+AYMO_PUBLIC void aymo_(f64_f32_k)(size_t n, const double f64v[], float f32v[], float scale);
+AYMO_PUBLIC void aymo_(f32_f64_k)(size_t n, const float f32v[], double f64v[], float scale);
+
+AYMO_PUBLIC void aymo_(i16x2_f32x2_k)(size_t n, const int16_t i16x2v[], float f32lv[], float f32rv[], float scale);
+AYMO_PUBLIC void aymo_(f32x2_i16x2_k)(size_t n, const float f32lv[], const float f32rv[], int16_t i16x2v[], float scale);
+
+AYMO_PUBLIC void aymo_(i16x4_i16x2_k)(size_t n, const int16_t i16x4v[], int16_t i16x2v[], const float k[4]);
+AYMO_PUBLIC void aymo_(i16x4_f32x2_k)(size_t n, const int16_t i16x4v[], float f32x2v[], const float k[4]);
+
+AYMO_PUBLIC void aymo_(i16_f32_k_m)(size_t n, const int16_t i16v[], float f32v[], float scale, struct aymo_convert_meter* meter);
+AYMO_PUBLIC void aymo_(f32_i16_k_m)(size_t n, const float f32v[], int16_t i16v[], float scale, struct aymo_convert_meter* meter);
+
 
 #ifndef AYMO_KEEP_SHORTHANDS
     #undef AYMO_KEEP_SHORTHANDS
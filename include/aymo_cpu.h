@@ -24,10 +24,12 @@ along with AYMO. If not, see <https://www.gnu.org/licenses/>.
 
 #include "aymo_cc.h"
 
+#include <stdint.h>
+
 #if (defined(AYMO_CPU_FAMILY_X86) || defined(AYMO_CPU_FAMILY_X86_64))
     #include "aymo_cpu_x86.h"
 
-    #if defined(AYMO_CPU_SUPPORT_X86_AVX2)
+    #if (defined(AYMO_CPU_SUPPORT_X86_AVX2) || defined(AYMO_CPU_SUPPORT_X86_FMA3))
         #include "aymo_cpu_x86_avx2.h"
     #endif
 
@@ -50,6 +52,16 @@ AYMO_CXX_EXTERN_C_BEGIN
 AYMO_PUBLIC void aymo_cpu_boot(void);
 
 
+// Floating-point control state, as saved by aymo_cpu_enter_ftz()
+typedef uint64_t aymo_cpu_fpstate_t;
+
+// Enables flush-to-zero and denormals-are-zero where supported; returns the previous state
+AYMO_PUBLIC aymo_cpu_fpstate_t aymo_cpu_enter_ftz(void);
+
+// Restores the state returned by aymo_cpu_enter_ftz()
+AYMO_PUBLIC void aymo_cpu_leave_ftz(aymo_cpu_fpstate_t state);
+
+
 AYMO_CXX_EXTERN_C_END
 
 #endif  // _include_aymo_cpu_h
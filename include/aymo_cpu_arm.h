@@ -32,10 +32,15 @@ AYMO_CXX_EXTERN_C_BEGIN
 #define AYMO_CPU_ARM_EXT_AARCH64    (1u << 3u)
 #define AYMO_CPU_ARM_EXT_NEON64     (1u << 4u)
 
+#define AYMO_CPU_ARM_FPCR_FZ        (1uLL << 24u)  // same bit in AArch32 FPSCR
+
 
 AYMO_PUBLIC void aymo_cpu_arm_boot(void);
 AYMO_PUBLIC unsigned aymo_cpu_arm_get_extensions(void);
 
+AYMO_PUBLIC uint64_t aymo_cpu_arm_enter_ftz(void);
+AYMO_PUBLIC void aymo_cpu_arm_leave_ftz(uint64_t fpcr);
+
 
 AYMO_CXX_EXTERN_C_END
 
@@ -36,10 +36,16 @@ AYMO_CXX_EXTERN_C_BEGIN
 #define AYMO_CPU_X86_EXT_AVX2       (1u << 7u)
 #define AYMO_CPU_X86_EXT_FMA3       (1u << 8u)
 
+#define AYMO_CPU_X86_MXCSR_DAZ      (1uL <<  6u)
+#define AYMO_CPU_X86_MXCSR_FTZ      (1uL << 15u)
+
 
 AYMO_PUBLIC void aymo_cpu_x86_boot(void);
 AYMO_PUBLIC unsigned aymo_cpu_x86_get_extensions(void);
 
+AYMO_PUBLIC uint32_t aymo_cpu_x86_enter_ftz(void);
+AYMO_PUBLIC void aymo_cpu_x86_leave_ftz(uint32_t mxcsr);
+
 
 AYMO_CXX_EXTERN_C_END
 
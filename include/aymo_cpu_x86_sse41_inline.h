@@ -174,6 +174,9 @@ typedef vi32x4_t vi32_t;
 #define vvpacks         _mm_packs_epi32
 #define vvpackus        _mm_packus_epi32
 
+#define vvunpacklo      _mm_unpacklo_epi32
+#define vvunpackhi      _mm_unpackhi_epi32
+
 
 static inline
 __m128i mm_setm_epi16(uint8_t m)
@@ -0,0 +1,52 @@
+/*
+AYMO - Accelerated YaMaha Operator
+Copyright (c) 2023-2024 Andrea Zoppi.
+
+This file is part of AYMO.
+
+AYMO is free software: you can redistribute it and/or modify it under the
+terms of the GNU Lesser General Public License as published by the Free
+Software Foundation, either version 2.1 of the License, or (at your option)
+any later version.
+
+AYMO is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with AYMO. If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef _include_aymo_mix_h
+#define _include_aymo_mix_h
+
+#include "aymo_cc.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+AYMO_CXX_EXTERN_C_BEGIN
+
+
+// Mix buses: m input streams of n samples (or stereo frames) each, scaled by
+// per-stream gains kv[m] (or L,R pairs kv[m * 2], for panning), then summed
+// with saturation of integer outputs.
+// Plain variants overwrite yv[], while _i32 variants accumulate into it.
+
+AYMO_PUBLIC void aymo_mix_boot(void);
+
+AYMO_PUBLIC void aymo_mix_i16_k(size_t n, size_t m, const int16_t* const xv[], const float kv[], int16_t yv[]);
+AYMO_PUBLIC void aymo_mix_i16x2_k(size_t n, size_t m, const int16_t* const xv[], const float kv[], int16_t yv[]);
+
+AYMO_PUBLIC void aymo_mix_f32_k(size_t n, size_t m, const float* const xv[], const float kv[], float yv[]);
+AYMO_PUBLIC void aymo_mix_f32x2_k(size_t n, size_t m, const float* const xv[], const float kv[], float yv[]);
+
+AYMO_PUBLIC void aymo_mix_i16_i32_k(size_t n, size_t m, const int16_t* const xv[], const float kv[], int32_t yv[]);
+AYMO_PUBLIC void aymo_mix_i16x2_i32_k(size_t n, size_t m, const int16_t* const xv[], const float kv[], int32_t yv[]);
+
+AYMO_PUBLIC void aymo_mix_i32_i16(size_t n, const int32_t xv[], int16_t yv[]);
+
+
+AYMO_CXX_EXTERN_C_END
+
+#endif  // _include_aymo_mix_h
@@ -0,0 +1,59 @@
+/*
+AYMO - Accelerated YaMaha Operator
+Copyright (c) 2023-2024 Andrea Zoppi.
+
+This file is part of AYMO.
+
+AYMO is free software: you can redistribute it and/or modify it under the
+terms of the GNU Lesser General Public License as published by the Free
+Software Foundation, either version 2.1 of the License, or (at your option)
+any later version.
+
+AYMO is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with AYMO. If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef _include_aymo_mix_x86_avx2_h
+#define _include_aymo_mix_x86_avx2_h
+
+#include "aymo_cc.h"
+#ifdef AYMO_CPU_SUPPORT_X86_AVX2
+
+#include <stddef.h>
+#include <stdint.h>
+
+AYMO_CXX_EXTERN_C_BEGIN
+
+
+#undef AYMO_
+#undef aymo_
+#define AYMO_(_token_)  AYMO_MIX_X86_AVX2_##_token_
+#define aymo_(_token_)  aymo_mix_x86_avx2_##_token_
+
+
+AYMO_PUBLIC void aymo_(i16_k)(size_t n, size_t m, const int16_t* const xv[], const float kv[], int16_t yv[]);
+AYMO_PUBLIC void aymo_(i16x2_k)(size_t n, size_t m, const int16_t* const xv[], const float kv[], int16_t yv[]);
+
+AYMO_PUBLIC void aymo_(f32_k)(size_t n, size_t m, const float* const xv[], const float kv[], float yv[]);
+AYMO_PUBLIC void aymo_(f32x2_k)(size_t n, size_t m, const float* const xv[], const float kv[], float yv[]);
+
+AYMO_PUBLIC void aymo_(i16_i32_k)(size_t n, size_t m, const int16_t* const xv[], const float kv[], int32_t yv[]);
+AYMO_PUBLIC void aymo_(i16x2_i32_k)(size_t n, size_t m, const int16_t* const xv[], const float kv[], int32_t yv[]);
+
+AYMO_PUBLIC void aymo_(i32_i16)(size_t n, const int32_t xv[], int16_t yv[]);
+
+
+#ifndef AYMO_KEEP_SHORTHANDS
+    #undef AYMO_KEEP_SHORTHANDS
+    #undef AYMO_
+    #undef aymo_
+#endif  // AYMO_KEEP_SHORTHANDS
+
+AYMO_CXX_EXTERN_C_END
+
+#endif  // AYMO_CPU_SUPPORT_X86_AVX2
+#endif  // _include_aymo_mix_x86_avx2_h
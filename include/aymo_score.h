@@ -21,6 +21,7 @@ along with AYMO. If not, see <https://www.gnu.org/licenses/>.
 #define _include_aymo_score_h
 
 #include "aymo_cc.h"
+#include "aymo_ymf262_common.h"
 
 #include <stddef.h>
 #include <stdint.h>
@@ -51,6 +52,40 @@ struct aymo_score_status {
     uint8_t flags;
 };
 
+// Decoder position snapshot, for seeking without decoding from the start
+struct aymo_score_checkpoint {
+    uint32_t time;  // [samples] since restart
+    uint32_t offset;  // decoder specific event stream position
+    uint32_t delay;  // pending delay
+    uint32_t state;  // decoder specific sticky state (e.g. high address byte)
+};
+
+// Register write event, as emitted by score passes
+struct aymo_score_event {
+    uint32_t delay;  // before
+    uint16_t address;
+    uint8_t value;
+    uint8_t reserved_;
+};
+
+// Register write optimization passes
+#define AYMO_SCORE_OPTIMIZE_REDUNDANT   1u  // rewrites of unchanged values
+#define AYMO_SCORE_OPTIMIZE_INAUDIBLE   2u  // registers without audible effects
+#define AYMO_SCORE_OPTIMIZE_SILENT      4u  // channels never keyed on (NOT bit-exact)
+
+#define AYMO_SCORE_OPTIMIZE_EXACT   (AYMO_SCORE_OPTIMIZE_REDUNDANT | AYMO_SCORE_OPTIMIZE_INAUDIBLE)
+
+// Register write optimization statistics
+struct aymo_score_optimize_stats {
+    uint32_t events_in;  // register writes found
+    uint32_t events_out;  // register writes kept
+    uint32_t redundant;  // dropped by AYMO_SCORE_OPTIMIZE_REDUNDANT
+    uint32_t inaudible;  // dropped by AYMO_SCORE_OPTIMIZE_INAUDIBLE
+    uint32_t silent;  // dropped by AYMO_SCORE_OPTIMIZE_SILENT
+    uint32_t length;  // [samples] whole score duration
+    uint32_t tail;  // [samples] trailing delay after the last kept write
+};
+
 struct aymo_score_instance;  // forward
 
 typedef int (*aymo_score_ctor_f)(
@@ -84,6 +119,16 @@ typedef uint32_t (*aymo_score_tick_f)(
     uint32_t count
 );
 
+typedef void (*aymo_score_get_checkpoint_f)(
+    struct aymo_score_instance* score,
+    struct aymo_score_checkpoint* checkpoint
+);
+
+typedef void (*aymo_score_set_checkpoint_f)(
+    struct aymo_score_instance* score,
+    const struct aymo_score_checkpoint* checkpoint
+);
+
 struct aymo_score_vt {
     const char* class_name;
     aymo_score_ctor_f ctor;
@@ -93,6 +138,8 @@ struct aymo_score_vt {
     aymo_score_get_status_f get_status;
     aymo_score_restart_f restart;
     aymo_score_tick_f tick;
+    aymo_score_get_checkpoint_f get_checkpoint;
+    aymo_score_set_checkpoint_f set_checkpoint;
 };
 
 struct aymo_score_instance {
@@ -132,6 +179,59 @@ AYMO_PUBLIC uint32_t aymo_score_tick(
     uint32_t count
 );
 
+AYMO_PUBLIC void aymo_score_get_checkpoint(
+    struct aymo_score_instance* score,
+    struct aymo_score_checkpoint* checkpoint
+);
+
+AYMO_PUBLIC void aymo_score_set_checkpoint(
+    struct aymo_score_instance* score,
+    const struct aymo_score_checkpoint* checkpoint
+);
+
+// Walks the whole score, taking a checkpoint every period [samples].
+// Returns the number of checkpoints stored into index[capacity].
+// The score is restarted afterwards.
+AYMO_PUBLIC uint32_t aymo_score_index_build(
+    struct aymo_score_instance* score,
+    struct aymo_score_checkpoint index[],
+    uint32_t capacity,
+    uint32_t period
+);
+
+// Moves the score to the target time [samples], starting from the closest
+// preceding checkpoint; events up to the target time are consumed.
+// Returns the time actually reached (less than the target at end of score).
+AYMO_PUBLIC uint32_t aymo_score_seek(
+    struct aymo_score_instance* score,
+    const struct aymo_score_checkpoint index[],
+    uint32_t length,
+    uint32_t time
+);
+
+// Restarts the score and scans register writes up to the target time,
+// without any emulation, into a "shadow" register file.
+// Written registers are flagged into the written[] bitmap (optional).
+// Returns the time actually reached (less than the target at end of score).
+AYMO_PUBLIC uint32_t aymo_score_scan_registers(
+    struct aymo_score_instance* score,
+    uint32_t time,
+    uint8_t regs[AYMO_YMF262_REG_NUM],
+    uint8_t written[AYMO_YMF262_REG_NUM / 8u]
+);
+
+// Simulates the register file along the whole score, emitting the minimal
+// equivalent stream of register writes according to the selected passes.
+// Up to capacity events are stored; events can be NULL to just count them.
+// Returns the number of events stored; the score is restarted afterwards.
+AYMO_PUBLIC uint32_t aymo_score_optimize(
+    struct aymo_score_instance* score,
+    unsigned passes,
+    struct aymo_score_event events[],
+    uint32_t capacity,
+    struct aymo_score_optimize_stats* stats
+);
+
 
 AYMO_PUBLIC enum aymo_score_type aymo_score_ext_to_type(
     const char *tag
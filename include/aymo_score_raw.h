@@ -92,6 +92,16 @@ AYMO_PUBLIC uint32_t aymo_score_raw_tick(
     uint32_t count
 );
 
+AYMO_PUBLIC void aymo_score_raw_get_checkpoint(
+    struct aymo_score_raw_instance* score,
+    struct aymo_score_checkpoint* checkpoint
+);
+
+AYMO_PUBLIC void aymo_score_raw_set_checkpoint(
+    struct aymo_score_raw_instance* score,
+    const struct aymo_score_checkpoint* checkpoint
+);
+
 
 AYMO_CXX_EXTERN_C_END
 
@@ -41,6 +41,11 @@ struct aymo_score_ref_instance {
     uint32_t offset;
     uint32_t line;
     uint8_t addrhi;
+    uint8_t delayed;  // pre-parsed: delay before the current event already issued
+    const struct aymo_score_event* events;  // pre-parsed, or NULL for text
+    uint32_t length;
+    uint32_t index;
+    uint32_t tail;
 };
 
 
@@ -61,6 +66,14 @@ AYMO_PUBLIC int aymo_score_ref_load(
     uint32_t size
 );
 
+// Plays a pre-parsed event array, as from aymo_score_ref_parse()
+AYMO_PUBLIC int aymo_score_ref_load_events(
+    struct aymo_score_ref_instance* score,
+    const struct aymo_score_event events[],
+    uint32_t length,
+    uint32_t tail
+);
+
 AYMO_PUBLIC void aymo_score_ref_unload(
     struct aymo_score_ref_instance* score
 );
@@ -78,6 +91,32 @@ AYMO_PUBLIC uint32_t aymo_score_ref_tick(
     uint32_t count
 );
 
+AYMO_PUBLIC void aymo_score_ref_get_checkpoint(
+    struct aymo_score_ref_instance* score,
+    struct aymo_score_checkpoint* checkpoint
+);
+
+AYMO_PUBLIC void aymo_score_ref_set_checkpoint(
+    struct aymo_score_ref_instance* score,
+    const struct aymo_score_checkpoint* checkpoint
+);
+
+
+// Classifies 64 characters, into bitmasks of line breaks and hex digits.
+// Plain C reference of the SIMD classifiers used by aymo_score_ref_parse().
+AYMO_PUBLIC void aymo_score_ref_classify_none(const char text[64], uint64_t* eol, uint64_t* hex);
+
+// Pre-parses a score sheet into an event array, merging consecutive delays.
+// Returns the number of events found; at most capacity are stored.
+// The trailing delay after the last event is stored into tail.
+AYMO_PUBLIC uint32_t aymo_score_ref_parse(
+    const void* data,
+    uint32_t size,
+    struct aymo_score_event events[],
+    uint32_t capacity,
+    uint32_t* tail
+);
+
 
 AYMO_CXX_EXTERN_C_END
 
@@ -0,0 +1,50 @@
+/*
+AYMO - Accelerated YaMaha Operator
+Copyright (c) 2023-2024 Andrea Zoppi.
+
+This file is part of AYMO.
+
+AYMO is free software: you can redistribute it and/or modify it under the
+terms of the GNU Lesser General Public License as published by the Free
+Software Foundation, either version 2.1 of the License, or (at your option)
+any later version.
+
+AYMO is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with AYMO. If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef _include_aymo_score_ref_x86_sse41_h
+#define _include_aymo_score_ref_x86_sse41_h
+
+#include "aymo_cc.h"
+#ifdef AYMO_CPU_SUPPORT_X86_SSE41
+
+#include <stdint.h>
+
+AYMO_CXX_EXTERN_C_BEGIN
+
+
+#undef AYMO_
+#undef aymo_
+#define AYMO_(_token_)  AYMO_SCORE_REF_X86_SSE41_##_token_
+#define aymo_(_token_)  aymo_score_ref_x86_sse41_##_token_
+
+
+// Classifies 64 characters, into bitmasks of line breaks and hex digits
+AYMO_PUBLIC void aymo_(classify)(const char text[64], uint64_t* eol, uint64_t* hex);
+
+
+#ifndef AYMO_KEEP_SHORTHANDS
+    #undef AYMO_KEEP_SHORTHANDS
+    #undef AYMO_
+    #undef aymo_
+#endif  // AYMO_KEEP_SHORTHANDS
+
+AYMO_CXX_EXTERN_C_END
+
+#endif  // AYMO_CPU_SUPPORT_X86_SSE41
+#endif  // _include_aymo_score_ref_x86_sse41_h
@@ -38,6 +38,22 @@ AYMO_PUBLIC void aymo_tda8425_dtor(struct aymo_tda8425_chip* chip);
 AYMO_PUBLIC uint8_t aymo_tda8425_read(struct aymo_tda8425_chip* chip, uint16_t address);
 AYMO_PUBLIC void aymo_tda8425_write(struct aymo_tda8425_chip* chip, uint16_t address, uint8_t value);
 AYMO_PUBLIC void aymo_tda8425_process_f32(struct aymo_tda8425_chip* chip, uint32_t count, const float x[], float y[]);
+AYMO_PUBLIC void aymo_tda8425_process_i16(struct aymo_tda8425_chip* chip, uint32_t count, const int16_t x[], int16_t y[]);
+AYMO_PUBLIC void aymo_tda8425_set_coeffs(struct aymo_tda8425_chip* chip, struct aymo_tda8425_coeffs* coeffs);
+AYMO_PUBLIC void aymo_tda8425_set_smoothing(struct aymo_tda8425_chip* chip, uint32_t frames);
+AYMO_PUBLIC void aymo_tda8425_set_silence(struct aymo_tda8425_chip* chip, float threshold);
+
+AYMO_PUBLIC const struct aymo_tda8425_bank_vt* aymo_tda8425_get_bank_vt(const char* cpu_ext);
+AYMO_PUBLIC const struct aymo_tda8425_bank_vt* aymo_tda8425_get_best_bank_vt(void);
+
+AYMO_PUBLIC uint32_t aymo_tda8425_bank_get_sizeof(struct aymo_tda8425_bank* bank, uint32_t instances);
+AYMO_PUBLIC void aymo_tda8425_bank_ctor(struct aymo_tda8425_bank* bank, uint32_t instances, float sample_rate);
+AYMO_PUBLIC void aymo_tda8425_bank_dtor(struct aymo_tda8425_bank* bank);
+AYMO_PUBLIC uint8_t aymo_tda8425_bank_read(struct aymo_tda8425_bank* bank, uint32_t index, uint16_t address);
+AYMO_PUBLIC void aymo_tda8425_bank_write(struct aymo_tda8425_bank* bank, uint32_t index, uint16_t address, uint8_t value);
+AYMO_PUBLIC void aymo_tda8425_bank_process_f32(struct aymo_tda8425_bank* bank, uint32_t count, const float* const x[], float* const y[]);
+AYMO_PUBLIC void aymo_tda8425_bank_process_f32_interleaved(struct aymo_tda8425_bank* bank, uint32_t count, const float x[], float y[]);
+AYMO_PUBLIC void aymo_tda8425_bank_set_coeffs(struct aymo_tda8425_bank* bank, struct aymo_tda8425_coeffs* coeffs);
 
 
 AYMO_CXX_EXTERN_C_END
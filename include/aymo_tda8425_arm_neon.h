@@ -62,14 +62,39 @@ struct aymo_(chip) {
 
     vf32x4_t kb0;
 
+    // Smoothing targets and ramp deltas
+    vf32x4_t tkb2;
+    vf32x4_t tka2;
+    vf32x4_t tkb1;
+    vf32x4_t tka1;
+    vf32x4_t tkb0;
+    vf32x4_t dkb2;
+    vf32x4_t dka2;
+    vf32x4_t dkb1;
+    vf32x4_t dka1;
+    vf32x4_t dkb0;
+
     // 64-bit data
     vf32x2_t krl;
     vf32x2_t klr;
 
     vf32x2_t kv;
 
+    vf32x2_t tklr;
+    vf32x2_t tkrl;
+    vf32x2_t tkv;
+    vf32x2_t dklr;
+    vf32x2_t dkrl;
+    vf32x2_t dkv;
+
+    // Pointer data
+    struct aymo_tda8425_coeffs* coeffs;
+
     // 32-bit data
+    uint32_t smooth_steps;
+    uint32_t smooth_left;
     float sample_rate;  // [Hz]
+    float silence;  // threshold
     float pseudo_c1;  // [F]
     float pseudo_c2;  // [F]
 
@@ -91,6 +116,10 @@ AYMO_PUBLIC void aymo_(dtor)(struct aymo_(chip)* chip);
 AYMO_PUBLIC uint8_t aymo_(read)(struct aymo_(chip)* chip, uint16_t address);
 AYMO_PUBLIC void aymo_(write)(struct aymo_(chip)* chip, uint16_t address, uint8_t value);
 AYMO_PUBLIC void aymo_(process_f32)(struct aymo_(chip)* chip, uint32_t count, const float x[], float y[]);
+AYMO_PUBLIC void aymo_(process_i16)(struct aymo_(chip)* chip, uint32_t count, const int16_t x[], int16_t y[]);
+AYMO_PUBLIC void aymo_(set_coeffs)(struct aymo_(chip)* chip, struct aymo_tda8425_coeffs* coeffs);
+AYMO_PUBLIC void aymo_(set_smoothing)(struct aymo_(chip)* chip, uint32_t frames);
+AYMO_PUBLIC void aymo_(set_silence)(struct aymo_(chip)* chip, float threshold);
 
 
 #ifndef AYMO_KEEP_SHORTHANDS
@@ -30,12 +30,17 @@ AYMO_CXX_EXTERN_C_BEGIN
 // Object-oriented API
 
 struct aymo_tda8425_chip;  // forward
+struct aymo_tda8425_coeffs;  // forward
 typedef uint32_t (*aymo_tda8425_get_sizeof_f)(void);
 typedef void (*aymo_tda8425_ctor_f)(struct aymo_tda8425_chip* chip, float sample_rate);
 typedef void (*aymo_tda8425_dtor_f)(struct aymo_tda8425_chip* chip);
 typedef uint8_t (*aymo_tda8425_read_f)(struct aymo_tda8425_chip* chip, uint16_t address);
 typedef void (*aymo_tda8425_write_f)(struct aymo_tda8425_chip* chip, uint16_t address, uint8_t value);
 typedef void (*aymo_tda8425_process_f32_f)(struct aymo_tda8425_chip* chip, uint32_t count, const float x[], float y[]);
+typedef void (*aymo_tda8425_process_i16_f)(struct aymo_tda8425_chip* chip, uint32_t count, const int16_t x[], int16_t y[]);
+typedef void (*aymo_tda8425_set_coeffs_f)(struct aymo_tda8425_chip* chip, struct aymo_tda8425_coeffs* coeffs);
+typedef void (*aymo_tda8425_set_smoothing_f)(struct aymo_tda8425_chip* chip, uint32_t frames);
+typedef void (*aymo_tda8425_set_silence_f)(struct aymo_tda8425_chip* chip, float threshold);
 
 struct aymo_tda8425_vt {
     const char* class_name;
@@ -45,6 +50,10 @@ struct aymo_tda8425_vt {
     aymo_tda8425_read_f read;
     aymo_tda8425_write_f write;
     aymo_tda8425_process_f32_f process_f32;
+    aymo_tda8425_process_i16_f process_i16;
+    aymo_tda8425_set_coeffs_f set_coeffs;
+    aymo_tda8425_set_smoothing_f set_smoothing;
+    aymo_tda8425_set_silence_f set_silence;
 };
 
 struct aymo_tda8425_chip {
@@ -52,6 +61,98 @@ struct aymo_tda8425_chip {
 };
 
 
+// Bank of independent chips, processed together.
+// Memory is provided by the caller: bank_get_sizeof() bytes, aligned to 32 bytes, with VT set.
+// Planar buffers have one interleaved stereo buffer per instance; NULL ones are silent/discarded.
+// Interleaved buffers have (instances * 2) samples per frame, ordered by instance then channel.
+// Banks do not implement parameter smoothing nor silence detection.
+
+struct aymo_tda8425_bank;  // forward
+typedef uint32_t (*aymo_tda8425_bank_get_sizeof_f)(uint32_t instances);
+typedef void (*aymo_tda8425_bank_ctor_f)(struct aymo_tda8425_bank* bank, uint32_t instances, float sample_rate);
+typedef void (*aymo_tda8425_bank_dtor_f)(struct aymo_tda8425_bank* bank);
+typedef uint8_t (*aymo_tda8425_bank_read_f)(struct aymo_tda8425_bank* bank, uint32_t index, uint16_t address);
+typedef void (*aymo_tda8425_bank_write_f)(struct aymo_tda8425_bank* bank, uint32_t index, uint16_t address, uint8_t value);
+typedef void (*aymo_tda8425_bank_process_f32_f)(struct aymo_tda8425_bank* bank, uint32_t count, const float* const x[], float* const y[]);
+typedef void (*aymo_tda8425_bank_process_f32_interleaved_f)(struct aymo_tda8425_bank* bank, uint32_t count, const float x[], float y[]);
+typedef void (*aymo_tda8425_bank_set_coeffs_f)(struct aymo_tda8425_bank* bank, struct aymo_tda8425_coeffs* coeffs);
+
+struct aymo_tda8425_bank_vt {
+    const char* class_name;
+    aymo_tda8425_bank_get_sizeof_f get_sizeof;
+    aymo_tda8425_bank_ctor_f ctor;
+    aymo_tda8425_bank_dtor_f dtor;
+    aymo_tda8425_bank_read_f read;
+    aymo_tda8425_bank_write_f write;
+    aymo_tda8425_bank_process_f32_f process_f32;
+    aymo_tda8425_bank_process_f32_interleaved_f process_f32_interleaved;
+    aymo_tda8425_bank_set_coeffs_f set_coeffs;
+};
+
+struct aymo_tda8425_bank {
+    const struct aymo_tda8425_bank_vt* vt;
+    uint32_t instances;
+};
+
+// Backend bank data starts at this offset from the bank
+#define AYMO_TDA8425_BANK_HEADER_SIZE   32
+
+
+// Fixed-point model, for process_i16()
+// Coefficients are Q4.27, signals are Q6.25 (1.0 = int16 full scale, +36 dB headroom).
+// Filter sums are exact in 64 bits, rounded once per stage; states are shared with process_f32().
+// Against the float model, sweep errors are ~0.3 LSB rms (output rounding),
+// up to ~1.7 LSB rms with the T-filter at max bass, where float noise dominates.
+#define AYMO_TDA8425_Q_COEFF    27
+#define AYMO_TDA8425_Q_SIGNAL   25
+
+
+// Parameter smoothing: coefficients ramp linearly towards new register values,
+// updated every AYMO_TDA8425_SMOOTH_STEP frames.
+#define AYMO_TDA8425_SMOOTH_STEP    16
+
+
+// process_f32() runs with flush-to-zero and denormals-are-zero enabled, restoring the
+// caller's floating-point control state on return.
+// Silence detection: at the end of each process call, filter states with all magnitudes
+// below the threshold are zeroed, so that they stop decaying through tiny values.
+// A threshold of zero disables detection (default).
+// The none backend ignores the threshold, as the wrapped reference emulator does not
+// expose its filter states; so does the dummy backend, which has no states at all.
+#define AYMO_TDA8425_SILENCE_THRESHOLD  (1.f / 16384.f)  // suggested, about -84 dBFS
+
+
+// Biquad coefficients, normalized by a0, with negated feedback terms:
+//   y[n] = kb0*x[n] + kb1*x[n-1] + kb2*x[n-2] + ka1*y[n-1] + ka2*y[n-2]
+struct aymo_tda8425_biquad {
+    float kb0;
+    float kb1;
+    float kb2;
+    float ka1;
+    float ka2;
+};
+
+// Coefficient cache for a sample rate, filled lazily by the first lookup of each entry.
+// Owned by the caller, and shareable by chips running at the same sample rate.
+// Lookups write to a partially filled cache, so sharing it across threads needs either
+// external locking, or filling it at once with aymo_tda8425_coeffs_fill() beforehand:
+// lookups only read a filled cache.
+struct aymo_tda8425_coeffs {
+    uint64_t volume_valid;
+    uint32_t bass_valid;
+    uint32_t treble_valid;
+    uint32_t tfilter_valid;
+    uint32_t pseudo_valid;
+    float sample_rate;  // [Hz]
+
+    float volume[64];  // by VL/VR
+    struct aymo_tda8425_biquad bass[16];  // by BA
+    struct aymo_tda8425_biquad treble[2][16];  // by SF.6 (T-filter disabled), TR
+    struct aymo_tda8425_biquad tfilter[16];  // by BA
+    struct aymo_tda8425_biquad pseudo[3];  // by PP preset
+};
+
+
 // Math API
 
 typedef double (*aymo_tda8425_math1_f)(double a);
@@ -79,6 +180,33 @@ AYMO_PUBLIC const float aymo_tda8425_pseudo_preset_c1[3];
 AYMO_PUBLIC const float aymo_tda8425_pseudo_preset_c2[3];
 
 
+AYMO_PUBLIC const struct aymo_tda8425_biquad aymo_tda8425_biquad_pass;
+
+AYMO_PUBLIC void aymo_tda8425_calc_mixer(float klr[2], float krl[2], uint8_t reg_sf);
+AYMO_PUBLIC float aymo_tda8425_calc_volume(uint8_t reg_v, uint8_t reg_sf);
+AYMO_PUBLIC void aymo_tda8425_calc_bass(struct aymo_tda8425_biquad* bq, float sample_rate, uint8_t reg_ba);
+AYMO_PUBLIC void aymo_tda8425_calc_treble(struct aymo_tda8425_biquad* bq, float sample_rate, uint8_t reg_tr, uint8_t reg_sf);
+AYMO_PUBLIC void aymo_tda8425_calc_tfilter(struct aymo_tda8425_biquad* bq, float sample_rate, uint8_t reg_ba, uint8_t reg_sf);
+AYMO_PUBLIC void aymo_tda8425_calc_pseudo(struct aymo_tda8425_biquad* bq, float sample_rate, uint8_t reg_pp, uint8_t reg_sf);
+
+AYMO_PUBLIC void aymo_tda8425_coeffs_ctor(struct aymo_tda8425_coeffs* coeffs, float sample_rate);
+AYMO_PUBLIC void aymo_tda8425_coeffs_fill(struct aymo_tda8425_coeffs* coeffs);
+
+// Lookups return cached coefficients if coeffs is not NULL, else they compute them into tmp
+AYMO_PUBLIC float aymo_tda8425_lookup_volume(struct aymo_tda8425_coeffs* coeffs, uint8_t reg_v, uint8_t reg_sf);
+AYMO_PUBLIC const struct aymo_tda8425_biquad* aymo_tda8425_lookup_bass(struct aymo_tda8425_coeffs* coeffs, struct aymo_tda8425_biquad* tmp, float sample_rate, uint8_t reg_ba);
+AYMO_PUBLIC const struct aymo_tda8425_biquad* aymo_tda8425_lookup_treble(struct aymo_tda8425_coeffs* coeffs, struct aymo_tda8425_biquad* tmp, float sample_rate, uint8_t reg_tr, uint8_t reg_sf);
+AYMO_PUBLIC const struct aymo_tda8425_biquad* aymo_tda8425_lookup_tfilter(struct aymo_tda8425_coeffs* coeffs, struct aymo_tda8425_biquad* tmp, float sample_rate, uint8_t reg_ba, uint8_t reg_sf);
+AYMO_PUBLIC const struct aymo_tda8425_biquad* aymo_tda8425_lookup_pseudo(struct aymo_tda8425_coeffs* coeffs, struct aymo_tda8425_biquad* tmp, float sample_rate, uint8_t reg_pp, uint8_t reg_sf);
+
+
+// Bank fallback: one chip per instance, chip_size bytes apart, processed through their VT
+#define AYMO_TDA8425_CHIPS_BLOCK    64u  // frames per temporary buffer
+
+AYMO_PUBLIC void aymo_tda8425_chips_process_f32(struct aymo_tda8425_chip* chips, uint32_t chip_size, uint32_t instances, uint32_t count, const float* const x[], float* const y[]);
+AYMO_PUBLIC void aymo_tda8425_chips_process_f32_interleaved(struct aymo_tda8425_chip* chips, uint32_t chip_size, uint32_t instances, uint32_t count, const float x[], float y[]);
+
+
 AYMO_CXX_EXTERN_C_END
 
 #endif  // _include_aymo_tda8425_common_h
@@ -44,6 +44,10 @@ AYMO_PUBLIC void aymo_(dtor)(struct aymo_(chip)* chip);
 AYMO_PUBLIC uint8_t aymo_(read)(struct aymo_(chip)* chip, uint16_t address);
 AYMO_PUBLIC void aymo_(write)(struct aymo_(chip)* chip, uint16_t address, uint8_t value);
 AYMO_PUBLIC void aymo_(process_f32)(struct aymo_(chip)* chip, uint32_t count, const float x[], float y[]);
+AYMO_PUBLIC void aymo_(process_i16)(struct aymo_(chip)* chip, uint32_t count, const int16_t x[], int16_t y[]);
+AYMO_PUBLIC void aymo_(set_coeffs)(struct aymo_(chip)* chip, struct aymo_tda8425_coeffs* coeffs);
+AYMO_PUBLIC void aymo_(set_smoothing)(struct aymo_(chip)* chip, uint32_t frames);
+AYMO_PUBLIC void aymo_(set_silence)(struct aymo_(chip)* chip, float threshold);
 
 
 #ifndef AYMO_KEEP_SHORTHANDS
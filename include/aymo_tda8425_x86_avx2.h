@@ -57,8 +57,34 @@ struct aymo_(chip) {
     vf32x8_t kb0;
     vf32x8_t kv;
 
+    // Smoothing targets
+    vf32x8_t tkb2;
+    vf32x8_t tka2;
+    vf32x8_t tkb1;
+    vf32x8_t tka1;
+    vf32x8_t tklr;
+    vf32x8_t tkrl;
+    vf32x8_t tkb0;
+    vf32x8_t tkv;
+
+    // Smoothing ramp deltas
+    vf32x8_t dkb2;
+    vf32x8_t dka2;
+    vf32x8_t dkb1;
+    vf32x8_t dka1;
+    vf32x8_t dklr;
+    vf32x8_t dkrl;
+    vf32x8_t dkb0;
+    vf32x8_t dkv;
+
+    // Pointer data
+    struct aymo_tda8425_coeffs* coeffs;
+
     // 32-bit data
+    uint32_t smooth_steps;
+    uint32_t smooth_left;
     float sample_rate;  // [Hz]
+    float silence;  // threshold
     float pseudo_c1;  // [F]
     float pseudo_c2;  // [F]
 
@@ -73,6 +99,55 @@ struct aymo_(chip) {
 };
 
 
+// Bank unit of independent chips, packed as stereo lane pairs.
+// Each filter stage has its own vectors, so that all the stages of all the
+// instances run side by side, without pipelining nor lane shuffling.
+#define AYMO_TDA8425_X86_AVX2_BANK_WIDTH    4  // instances per bank unit
+#define AYMO_TDA8425_X86_AVX2_BANK_STAGES   4  // pseudo, treble, bass, T-filter
+
+AYMO_ALIGN_V256
+struct aymo_(bank_unit) {
+    // 256-bit data, by stage
+    vf32x8_t kb2[AYMO_TDA8425_X86_AVX2_BANK_STAGES];
+    vf32x8_t ka2[AYMO_TDA8425_X86_AVX2_BANK_STAGES];
+    vf32x8_t hb1[AYMO_TDA8425_X86_AVX2_BANK_STAGES];
+    vf32x8_t ha1[AYMO_TDA8425_X86_AVX2_BANK_STAGES];
+
+    vf32x8_t kb1[AYMO_TDA8425_X86_AVX2_BANK_STAGES];
+    vf32x8_t ka1[AYMO_TDA8425_X86_AVX2_BANK_STAGES];
+    vf32x8_t hb0[AYMO_TDA8425_X86_AVX2_BANK_STAGES];
+    vf32x8_t ha0[AYMO_TDA8425_X86_AVX2_BANK_STAGES];
+
+    vf32x8_t kb0[AYMO_TDA8425_X86_AVX2_BANK_STAGES];
+
+    // 256-bit data
+    vf32x8_t krl;
+    vf32x8_t klr;
+    vf32x8_t kv;
+
+    // Pointer data
+    struct aymo_tda8425_coeffs* coeffs;
+
+    // 32-bit data
+    float sample_rate;  // [Hz]
+
+    // 8-bit data, by instance
+    uint8_t reg_vl[AYMO_TDA8425_X86_AVX2_BANK_WIDTH];
+    uint8_t reg_vr[AYMO_TDA8425_X86_AVX2_BANK_WIDTH];
+    uint8_t reg_ba[AYMO_TDA8425_X86_AVX2_BANK_WIDTH];
+    uint8_t reg_tr[AYMO_TDA8425_X86_AVX2_BANK_WIDTH];
+    uint8_t reg_pp[AYMO_TDA8425_X86_AVX2_BANK_WIDTH];
+    uint8_t reg_sf[AYMO_TDA8425_X86_AVX2_BANK_WIDTH];
+};
+
+
+// Bank of independent chips, as (instances + BANK_WIDTH - 1) / BANK_WIDTH units following this header
+struct aymo_(bank) {
+    struct aymo_tda8425_bank parent;
+    uint8_t align_[AYMO_TDA8425_BANK_HEADER_SIZE - sizeof(struct aymo_tda8425_bank)];
+};
+
+
 AYMO_PUBLIC const struct aymo_tda8425_vt* aymo_(get_vt)(void);
 AYMO_PUBLIC uint32_t aymo_(get_sizeof)(void);
 AYMO_PUBLIC void aymo_(ctor)(struct aymo_(chip)* chip, float sample_rate);
@@ -80,6 +155,20 @@ AYMO_PUBLIC void aymo_(dtor)(struct aymo_(chip)* chip);
 AYMO_PUBLIC uint8_t aymo_(read)(struct aymo_(chip)* chip, uint16_t address);
 AYMO_PUBLIC void aymo_(write)(struct aymo_(chip)* chip, uint16_t address, uint8_t value);
 AYMO_PUBLIC void aymo_(process_f32)(struct aymo_(chip)* chip, uint32_t count, const float x[], float y[]);
+AYMO_PUBLIC void aymo_(process_i16)(struct aymo_(chip)* chip, uint32_t count, const int16_t x[], int16_t y[]);
+AYMO_PUBLIC void aymo_(set_coeffs)(struct aymo_(chip)* chip, struct aymo_tda8425_coeffs* coeffs);
+AYMO_PUBLIC void aymo_(set_smoothing)(struct aymo_(chip)* chip, uint32_t frames);
+AYMO_PUBLIC void aymo_(set_silence)(struct aymo_(chip)* chip, float threshold);
+
+AYMO_PUBLIC const struct aymo_tda8425_bank_vt* aymo_(get_bank_vt)(void);
+AYMO_PUBLIC uint32_t aymo_(bank_get_sizeof)(uint32_t instances);
+AYMO_PUBLIC void aymo_(bank_ctor)(struct aymo_(bank)* bank, uint32_t instances, float sample_rate);
+AYMO_PUBLIC void aymo_(bank_dtor)(struct aymo_(bank)* bank);
+AYMO_PUBLIC uint8_t aymo_(bank_read)(struct aymo_(bank)* bank, uint32_t index, uint16_t address);
+AYMO_PUBLIC void aymo_(bank_write)(struct aymo_(bank)* bank, uint32_t index, uint16_t address, uint8_t value);
+AYMO_PUBLIC void aymo_(bank_process_f32)(struct aymo_(bank)* bank, uint32_t count, const float* const x[], float* const y[]);
+AYMO_PUBLIC void aymo_(bank_process_f32_interleaved)(struct aymo_(bank)* bank, uint32_t count, const float x[], float y[]);
+AYMO_PUBLIC void aymo_(bank_set_coeffs)(struct aymo_(bank)* bank, struct aymo_tda8425_coeffs* coeffs);
 
 
 #ifndef AYMO_KEEP_SHORTHANDS
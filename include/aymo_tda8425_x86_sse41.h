@@ -67,8 +67,34 @@ struct aymo_(chip) {
 
     vf32x4_t kv;
 
+    // Smoothing targets
+    vf32x4_t tkb2;
+    vf32x4_t tka2;
+    vf32x4_t tkb1;
+    vf32x4_t tka1;
+    vf32x4_t tklr;
+    vf32x4_t tkrl;
+    vf32x4_t tkb0;
+    vf32x4_t tkv;
+
+    // Smoothing ramp deltas
+    vf32x4_t dkb2;
+    vf32x4_t dka2;
+    vf32x4_t dkb1;
+    vf32x4_t dka1;
+    vf32x4_t dklr;
+    vf32x4_t dkrl;
+    vf32x4_t dkb0;
+    vf32x4_t dkv;
+
+    // Pointer data
+    struct aymo_tda8425_coeffs* coeffs;
+
     // 32-bit data
+    uint32_t smooth_steps;
+    uint32_t smooth_left;
     float sample_rate;  // [Hz]
+    float silence;  // threshold
     float pseudo_c1;  // [F]
     float pseudo_c2;  // [F]
 
@@ -83,6 +109,13 @@ struct aymo_(chip) {
 };
 
 
+// Bank of independent chips, one per instance, following this header
+struct aymo_(bank) {
+    struct aymo_tda8425_bank parent;
+    uint8_t align_[AYMO_TDA8425_BANK_HEADER_SIZE - sizeof(struct aymo_tda8425_bank)];
+};
+
+
 AYMO_PUBLIC const struct aymo_tda8425_vt* aymo_(get_vt)(void);
 AYMO_PUBLIC uint32_t aymo_(get_sizeof)(void);
 AYMO_PUBLIC void aymo_(ctor)(struct aymo_(chip)* chip, float sample_rate);
@@ -90,6 +123,20 @@ AYMO_PUBLIC void aymo_(dtor)(struct aymo_(chip)* chip);
 AYMO_PUBLIC uint8_t aymo_(read)(struct aymo_(chip)* chip, uint16_t address);
 AYMO_PUBLIC void aymo_(write)(struct aymo_(chip)* chip, uint16_t address, uint8_t value);
 AYMO_PUBLIC void aymo_(process_f32)(struct aymo_(chip)* chip, uint32_t count, const float x[], float y[]);
+AYMO_PUBLIC void aymo_(process_i16)(struct aymo_(chip)* chip, uint32_t count, const int16_t x[], int16_t y[]);
+AYMO_PUBLIC void aymo_(set_coeffs)(struct aymo_(chip)* chip, struct aymo_tda8425_coeffs* coeffs);
+AYMO_PUBLIC void aymo_(set_smoothing)(struct aymo_(chip)* chip, uint32_t frames);
+AYMO_PUBLIC void aymo_(set_silence)(struct aymo_(chip)* chip, float threshold);
+
+AYMO_PUBLIC const struct aymo_tda8425_bank_vt* aymo_(get_bank_vt)(void);
+AYMO_PUBLIC uint32_t aymo_(bank_get_sizeof)(uint32_t instances);
+AYMO_PUBLIC void aymo_(bank_ctor)(struct aymo_(bank)* bank, uint32_t instances, float sample_rate);
+AYMO_PUBLIC void aymo_(bank_dtor)(struct aymo_(bank)* bank);
+AYMO_PUBLIC uint8_t aymo_(bank_read)(struct aymo_(bank)* bank, uint32_t index, uint16_t address);
+AYMO_PUBLIC void aymo_(bank_write)(struct aymo_(bank)* bank, uint32_t index, uint16_t address, uint8_t value);
+AYMO_PUBLIC void aymo_(bank_process_f32)(struct aymo_(bank)* bank, uint32_t count, const float* const x[], float* const y[]);
+AYMO_PUBLIC void aymo_(bank_process_f32_interleaved)(struct aymo_(bank)* bank, uint32_t count, const float x[], float y[]);
+AYMO_PUBLIC void aymo_(bank_set_coeffs)(struct aymo_(bank)* bank, struct aymo_tda8425_coeffs* coeffs);
 
 
 #ifndef AYMO_KEEP_SHORTHANDS
@@ -80,6 +80,24 @@ AYMO_PUBLIC void aymo_wave_heading_setup(
 );
 
 
+
+/* Parses the heading of a WAVE file, as the counterpart of aymo_wave_heading_setup().
+ *
+ * Fills the heading with the "fmt " chunk and the "data" chunk size, skipping
+ * any other chunks in between (e.g. "LIST", "JUNK").
+ * WAVE_FORMAT_EXTENSIBLE is reported as its PCM/float subformat.
+ * The data size is clamped to the available bytes, which also covers
+ * streamed files with unset sizes.
+ *
+ * Returns zero on success, with the samples at byte data_offset of the file.
+ */
+AYMO_PUBLIC int aymo_wave_heading_parse(
+    struct aymo_wave_heading* heading,
+    const void* data,
+    uint32_t size,
+    uint32_t* data_offset
+);
+
 AYMO_CXX_EXTERN_C_END
 
 #endif  // _include_aymo_wave_h
@@ -39,6 +39,7 @@ AYMO_PUBLIC void aymo_ym7128_dtor(struct aymo_ym7128_chip* chip);
 AYMO_PUBLIC uint8_t aymo_ym7128_read(struct aymo_ym7128_chip* chip, uint16_t address);
 AYMO_PUBLIC void aymo_ym7128_write(struct aymo_ym7128_chip* chip, uint16_t address, uint8_t value);
 AYMO_PUBLIC void aymo_ym7128_process_i16(struct aymo_ym7128_chip* chip, uint32_t count, const int16_t x[], int16_t y[]);
+AYMO_PUBLIC void aymo_ym7128_process_f32(struct aymo_ym7128_chip* chip, uint32_t count, const float x[], float y[]);
 
 
 AYMO_CXX_EXTERN_C_END
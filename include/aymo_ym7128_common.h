@@ -37,6 +37,7 @@ typedef void (*aymo_ym7128_dtor_f)(struct aymo_ym7128_chip* chip);
 typedef uint8_t (*aymo_ym7128_read_f)(struct aymo_ym7128_chip* chip, uint16_t address);
 typedef void (*aymo_ym7128_write_f)(struct aymo_ym7128_chip* chip, uint16_t address, uint8_t value);
 typedef void (*aymo_ym7128_process_i16_f)(struct aymo_ym7128_chip* chip, uint32_t count, const int16_t x[], int16_t y[]);
+typedef void (*aymo_ym7128_process_f32_f)(struct aymo_ym7128_chip* chip, uint32_t count, const float x[], float y[]);
 
 struct aymo_ym7128_vt {
     const char* class_name;
@@ -46,6 +47,7 @@ struct aymo_ym7128_vt {
     aymo_ym7128_read_f read;
     aymo_ym7128_write_f write;
     aymo_ym7128_process_i16_f process_i16;
+    aymo_ym7128_process_f32_f process_f32;
 };
 
 struct aymo_ym7128_chip {
@@ -67,6 +69,7 @@ struct aymo_ym7128_chip {
 #define AYMO_YM7128_SIGNAL_MASK     0xFFFC
 #define AYMO_YM7128_INPUT_RATE      23550
 #define AYMO_YM7128_OUTPUT_RATE     47100
+#define AYMO_YM7128_BLOCK_LENGTH    64  // <= shortest non-zero tap
 
 
 enum aymo_ym7128_reg {
@@ -115,6 +118,34 @@ AYMO_PUBLIC const int16_t aymo_ym7128_kernel_linear[AYMO_YM7128_KERNEL_LENGTH];
 AYMO_PUBLIC const int16_t aymo_ym7128_kernel_minphase[AYMO_YM7128_KERNEL_LENGTH];
 
 
+// Float model, for process_f32()
+// Same signal flow as process_i16(), with exact gains and kernel, and without
+// quantization nor saturation; it has its own delay line and oversampler.
+struct aymo_ym7128_f32_coeffs {
+    float kgl[8];
+    float kgr[8];
+    float kvm;
+    float kvc;
+    float kvl;
+    float kvr;
+    float kc0;
+    float kc1;
+    int16_t tap[9];
+};
+
+struct aymo_ym7128_f32_state {
+    float uh[AYMO_YM7128_DELAY_LENGTH];
+    float zh[AYMO_YM7128_KERNEL_LENGTH - 1];  // last L,R pairs into the oversampler
+    float t0d;
+    uint16_t hi;
+};
+
+AYMO_PUBLIC const float aymo_ym7128_gain_f32[AYMO_YM7128_GAIN_COUNT];
+AYMO_PUBLIC const float aymo_ym7128_kernel_linear_f32[AYMO_YM7128_KERNEL_LENGTH];
+
+AYMO_PUBLIC void aymo_ym7128_calc_f32(struct aymo_ym7128_f32_coeffs* coeffs, const uint8_t regs[]);
+
+
 AYMO_CXX_EXTERN_C_END
 
 #endif  // _include_aymo_ym7128_common_h
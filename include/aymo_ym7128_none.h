@@ -37,6 +37,7 @@ AYMO_CXX_EXTERN_C_BEGIN
 struct aymo_(chip) {
     struct aymo_ym7128_chip parent;
     YM7128B_ChipFixed emu;
+    YM7128B_ChipFloat emu_f32;  // for process_f32()
 };
 
 
@@ -47,6 +48,7 @@ AYMO_PUBLIC void aymo_(dtor)(struct aymo_(chip)* chip);
 AYMO_PUBLIC uint8_t aymo_(read)(struct aymo_(chip)* chip, uint16_t address);
 AYMO_PUBLIC void aymo_(write)(struct aymo_(chip)* chip, uint16_t address, uint8_t value);
 AYMO_PUBLIC void aymo_(process_i16)(struct aymo_(chip)* chip, uint32_t count, const int16_t x[], int16_t y[]);
+AYMO_PUBLIC void aymo_(process_f32)(struct aymo_(chip)* chip, uint32_t count, const float x[], float y[]);
 
 
 #ifndef AYMO_KEEP_SHORTHANDS
@@ -51,15 +51,14 @@ struct aymo_(chip) {
     vi16x8_t kgr;
     vi16x8_t kv;
 
-    vi16x8_t zc;
-    vi16x8_t zb;
-    vi16x8_t kf;
-    vi16x8_t ke;
-    vi16x8_t za;
-    vi16x8_t kd;
-    vi16x8_t kc;
-    vi16x8_t kb;
-    vi16x8_t ka;
+    vi16x8_t kh[AYMO_YM7128_KERNEL_LENGTH];  // oversampler kernel, broadcast
+
+    // 32-bit data
+    int32_t zh[(AYMO_YM7128_KERNEL_LENGTH - 1) / 2];  // last L,R pairs into the oversampler
+
+    // Float model data
+    struct aymo_ym7128_f32_coeffs f32_coeffs;
+    struct aymo_ym7128_f32_state f32;
 
     // 16-bit data
     int16_t uh[AYMO_YM7128_DELAY_LENGTH];
@@ -78,6 +77,7 @@ AYMO_PUBLIC void aymo_(dtor)(struct aymo_(chip)* chip);
 AYMO_PUBLIC uint8_t aymo_(read)(struct aymo_(chip)* chip, uint16_t address);
 AYMO_PUBLIC void aymo_(write)(struct aymo_(chip)* chip, uint16_t address, uint8_t value);
 AYMO_PUBLIC void aymo_(process_i16)(struct aymo_(chip)* chip, uint32_t count, const int16_t x[], int16_t y[]);
+AYMO_PUBLIC void aymo_(process_f32)(struct aymo_(chip)* chip, uint32_t count, const float x[], float y[]);
 
 
 #ifndef AYMO_KEEP_SHORTHANDS
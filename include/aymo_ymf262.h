@@ -50,6 +50,26 @@ AYMO_PUBLIC void aymo_ymf262_generate_i16x4(struct aymo_ymf262_chip* chip, uint3
 AYMO_PUBLIC void aymo_ymf262_generate_f32x2(struct aymo_ymf262_chip* chip, uint32_t count, float y[]);
 AYMO_PUBLIC void aymo_ymf262_generate_f32x4(struct aymo_ymf262_chip* chip, uint32_t count, float y[]);
 
+// Loads a whole register file at once, rebuilding the derived state only once.
+// Only registers flagged by mask[] are loaded; all of them if mask is NULL.
+// The resulting state is as if the registers were written one by one to the
+// chip, with 105h first, 104h next, then ascending addresses, and BDh last.
+// Envelope, phase and timer progress are kept.
+AYMO_PUBLIC void aymo_ymf262_load_registers(
+    struct aymo_ymf262_chip* chip,
+    const uint8_t regs[AYMO_YMF262_REG_NUM],
+    const uint8_t mask[AYMO_YMF262_REG_NUM / 8u]
+);
+
+// Writes a burst of registers at once, with the same outcome as writing them
+// one by one. Overwritten values are skipped, and derived state updates
+// (connections, KSL, frequencies) are deferred to the end of the batch.
+AYMO_PUBLIC void aymo_ymf262_write_batch(
+    struct aymo_ymf262_chip* chip,
+    const struct aymo_ymf262_reg_write writes[],
+    uint32_t count
+);
+
 
 AYMO_CXX_EXTERN_C_END
 
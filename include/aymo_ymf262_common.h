@@ -27,6 +27,13 @@ along with AYMO. If not, see <https://www.gnu.org/licenses/>.
 AYMO_CXX_EXTERN_C_BEGIN
 
 
+// Register write, for batches
+struct aymo_ymf262_reg_write {
+    uint16_t address;
+    uint8_t value;
+};
+
+
 // Object-oriented API
 
 struct aymo_ymf262_chip;  // forward
@@ -43,6 +50,8 @@ typedef void (*aymo_ymf262_generate_i16x2_f)(struct aymo_ymf262_chip* chip, uint
 typedef void (*aymo_ymf262_generate_i16x4_f)(struct aymo_ymf262_chip* chip, uint32_t count, int16_t y[]);
 typedef void (*aymo_ymf262_generate_f32x2_f)(struct aymo_ymf262_chip* chip, uint32_t count, float y[]);
 typedef void (*aymo_ymf262_generate_f32x4_f)(struct aymo_ymf262_chip* chip, uint32_t count, float y[]);
+typedef void (*aymo_ymf262_load_registers_f)(struct aymo_ymf262_chip* chip, const uint8_t regs[], const uint8_t mask[]);
+typedef void (*aymo_ymf262_write_batch_f)(struct aymo_ymf262_chip* chip, const struct aymo_ymf262_reg_write writes[], uint32_t count);
 
 struct aymo_ymf262_vt {
     const char* class_name;
@@ -59,6 +68,8 @@ struct aymo_ymf262_vt {
     aymo_ymf262_generate_i16x4_f generate_i16x4;
     aymo_ymf262_generate_f32x2_f generate_f32x2;
     aymo_ymf262_generate_f32x4_f generate_f32x4;
+    aymo_ymf262_load_registers_f load_registers;
+    aymo_ymf262_write_batch_f write_batch;
 };
 
 struct aymo_ymf262_chip {
@@ -73,6 +84,8 @@ struct aymo_ymf262_chip {
 #define AYMO_YMF262_SLOT_NUM_MAX        64
 #define AYMO_YMF262_CHANNEL_NUM_MAX     32
 
+#define AYMO_YMF262_REG_NUM             0x200
+
 #ifndef AYMO_YMF262_REG_SAMPLE_LATENCY
 #define AYMO_YMF262_REG_SAMPLE_LATENCY  2
 #endif
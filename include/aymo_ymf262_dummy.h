@@ -58,6 +58,8 @@ AYMO_PUBLIC void aymo_(generate_i16x2)(struct aymo_(chip)* chip, uint32_t count,
 AYMO_PUBLIC void aymo_(generate_i16x4)(struct aymo_(chip)* chip, uint32_t count, int16_t y[]);
 AYMO_PUBLIC void aymo_(generate_f32x2)(struct aymo_(chip)* chip, uint32_t count, float y[]);
 AYMO_PUBLIC void aymo_(generate_f32x4)(struct aymo_(chip)* chip, uint32_t count, float y[]);
+AYMO_PUBLIC void aymo_(load_registers)(struct aymo_(chip)* chip, const uint8_t regs[AYMO_YMF262_REG_NUM], const uint8_t mask[AYMO_YMF262_REG_NUM / 8u]);
+AYMO_PUBLIC void aymo_(write_batch)(struct aymo_(chip)* chip, const struct aymo_ymf262_reg_write writes[], uint32_t count);
 
 
 #ifndef AYMO_KEEP_SHORTHANDS
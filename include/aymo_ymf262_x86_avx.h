@@ -220,12 +220,16 @@ struct aymo_(chip) {
     // 64-bit data
     uint64_t eg_timer;
     uint64_t tm_timer;
+    uint64_t wr_ksl_words;
 
     // 32-bit data
     uint32_t rq_delay;
     uint32_t og_ch2x_pairing;
     uint32_t og_ch2x_drum;
     uint32_t ng_noise;
+    uint32_t wr_fnum_ch2x;
+    uint32_t wr_rewire_ch2x;
+    uint32_t wr_deltafreq_sgs;
 
     // 16-bit data
     uint16_t rq_head;
@@ -291,6 +295,8 @@ AYMO_PUBLIC void aymo_(generate_i16x2)(struct aymo_(chip)* chip, uint32_t count,
 AYMO_PUBLIC void aymo_(generate_i16x4)(struct aymo_(chip)* chip, uint32_t count, int16_t y[]);
 AYMO_PUBLIC void aymo_(generate_f32x2)(struct aymo_(chip)* chip, uint32_t count, float y[]);
 AYMO_PUBLIC void aymo_(generate_f32x4)(struct aymo_(chip)* chip, uint32_t count, float y[]);
+AYMO_PUBLIC void aymo_(load_registers)(struct aymo_(chip)* chip, const uint8_t regs[AYMO_YMF262_REG_NUM], const uint8_t mask[AYMO_YMF262_REG_NUM / 8u]);
+AYMO_PUBLIC void aymo_(write_batch)(struct aymo_(chip)* chip, const struct aymo_ymf262_reg_write writes[], uint32_t count);
 
 
 // Slot group index to Channel group index
@@ -21,6 +21,7 @@ along with AYMO. If not, see <https://www.gnu.org/licenses/>.
 #include "aymo.h"
 #include "aymo_convert.h"
 #include "aymo_cpu.h"
+#include "aymo_mix.h"
 
 AYMO_CXX_EXTERN_C_BEGIN
 
@@ -29,6 +30,7 @@ void aymo_boot(void)
 {
     aymo_cpu_boot();
     aymo_convert_boot();
+    aymo_mix_boot();
 }
 
 
@@ -0,0 +1,271 @@
+/*
+AYMO - Accelerated YaMaha Operator
+Copyright (c) 2023-2024 Andrea Zoppi.
+
+This file is part of AYMO.
+
+AYMO is free software: you can redistribute it and/or modify it under the
+terms of the GNU Lesser General Public License as published by the Free
+Software Foundation, either version 2.1 of the License, or (at your option)
+any later version.
+
+AYMO is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with AYMO. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "aymo_adlibgold.h"
+#include "aymo_convert.h"
+
+#include <assert.h>
+
+AYMO_CXX_EXTERN_C_BEGIN
+
+
+static inline size_t aymo_adlibgold_align(size_t size)
+{
+    return ((size + (AYMO_ADLIBGOLD_CHIP_ALIGN - 1u)) & ~(size_t)(AYMO_ADLIBGOLD_CHIP_ALIGN - 1u));
+}
+
+
+static void aymo_adlibgold_select_vts(
+    const struct aymo_ymf262_vt** ymf262_vt,
+    const struct aymo_ym7128_vt** ym7128_vt,
+    const struct aymo_tda8425_vt** tda8425_vt
+)
+{
+    if (!*ymf262_vt) {
+        *ymf262_vt = aymo_ymf262_get_best_vt();
+    }
+    if (!*ym7128_vt) {
+        *ym7128_vt = aymo_ym7128_get_best_vt();
+    }
+    if (!*tda8425_vt) {
+        *tda8425_vt = aymo_tda8425_get_best_vt();
+    }
+    assert(*ymf262_vt);
+    assert(*ym7128_vt);
+    assert(*tda8425_vt);
+}
+
+
+uint32_t aymo_adlibgold_get_sizeof(
+    const struct aymo_ymf262_vt* ymf262_vt,
+    const struct aymo_ym7128_vt* ym7128_vt,
+    const struct aymo_tda8425_vt* tda8425_vt
+)
+{
+    aymo_adlibgold_select_vts(&ymf262_vt, &ym7128_vt, &tda8425_vt);
+
+    size_t size = aymo_adlibgold_align(sizeof(struct aymo_adlibgold));
+    size += aymo_adlibgold_align(ymf262_vt->get_sizeof());
+    size += aymo_adlibgold_align(ym7128_vt->get_sizeof());
+    size += aymo_adlibgold_align(tda8425_vt->get_sizeof());
+    return (uint32_t)size;
+}
+
+
+void aymo_adlibgold_ctor(
+    struct aymo_adlibgold* ag,
+    const struct aymo_ymf262_vt* ymf262_vt,
+    const struct aymo_ym7128_vt* ym7128_vt,
+    const struct aymo_tda8425_vt* tda8425_vt
+)
+{
+    assert(ag);
+    assert(((uintptr_t)(void*)ag & (AYMO_ADLIBGOLD_CHIP_ALIGN - 1u)) == 0u);
+
+    aymo_adlibgold_select_vts(&ymf262_vt, &ym7128_vt, &tda8425_vt);
+
+    aymo_memset(ag, 0, sizeof(*ag));
+
+    // Lay out the owned chips after the pipeline
+    uint8_t* ptr = ((uint8_t*)(void*)ag + aymo_adlibgold_align(sizeof(*ag)));
+    ag->ymf262 = (struct aymo_ymf262_chip*)(void*)ptr;
+    ptr += aymo_adlibgold_align(ymf262_vt->get_sizeof());
+    ag->ym7128 = (struct aymo_ym7128_chip*)(void*)ptr;
+    ptr += aymo_adlibgold_align(ym7128_vt->get_sizeof());
+    ag->tda8425 = (struct aymo_tda8425_chip*)(void*)ptr;
+
+    ag->ymf262->vt = ymf262_vt;
+    ag->ym7128->vt = ym7128_vt;
+    ag->tda8425->vt = tda8425_vt;
+    aymo_ymf262_ctor(ag->ymf262);
+    aymo_ym7128_ctor(ag->ym7128);
+    aymo_tda8425_ctor(ag->tda8425, (float)AYMO_ADLIBGOLD_SAMPLE_RATE);
+
+    ag->src_step = ((((uint64_t)AYMO_YMF262_SAMPLE_RATE << 32) + (AYMO_ADLIBGOLD_SAMPLE_RATE / 2)) /
+                    AYMO_ADLIBGOLD_SAMPLE_RATE);
+    ag->dry_gain = 1.f;
+    ag->wet_gain = 1.f;
+}
+
+
+void aymo_adlibgold_dtor(struct aymo_adlibgold* ag)
+{
+    assert(ag);
+
+    aymo_tda8425_dtor(ag->tda8425);
+    aymo_ym7128_dtor(ag->ym7128);
+    aymo_ymf262_dtor(ag->ymf262);
+}
+
+
+uint8_t aymo_adlibgold_read(struct aymo_adlibgold* ag, uint16_t address)
+{
+    assert(ag);
+
+    if (address < AYMO_ADLIBGOLD_ADDRESS_YM7128) {
+        return aymo_ymf262_read(ag->ymf262, (uint16_t)(address - AYMO_ADLIBGOLD_ADDRESS_YMF262));
+    }
+    if (address < AYMO_ADLIBGOLD_ADDRESS_TDA8425) {
+        return aymo_ym7128_read(ag->ym7128, (uint16_t)(address - AYMO_ADLIBGOLD_ADDRESS_YM7128));
+    }
+    if (address < AYMO_ADLIBGOLD_ADDRESS_END) {
+        return aymo_tda8425_read(ag->tda8425, (uint16_t)(address - AYMO_ADLIBGOLD_ADDRESS_TDA8425));
+    }
+    return 0u;
+}
+
+
+void aymo_adlibgold_write(struct aymo_adlibgold* ag, uint16_t address, uint8_t value)
+{
+    assert(ag);
+
+    if (address < AYMO_ADLIBGOLD_ADDRESS_YM7128) {
+        aymo_ymf262_write(ag->ymf262, (uint16_t)(address - AYMO_ADLIBGOLD_ADDRESS_YMF262), value);
+    }
+    else if (address < AYMO_ADLIBGOLD_ADDRESS_TDA8425) {
+        aymo_ym7128_write(ag->ym7128, (uint16_t)(address - AYMO_ADLIBGOLD_ADDRESS_YM7128), value);
+    }
+    else if (address < AYMO_ADLIBGOLD_ADDRESS_END) {
+        aymo_tda8425_write(ag->tda8425, (uint16_t)(address - AYMO_ADLIBGOLD_ADDRESS_TDA8425), value);
+    }
+}
+
+
+void aymo_adlibgold_set_mix(struct aymo_adlibgold* ag, float dry_gain, float wet_gain)
+{
+    assert(ag);
+
+    ag->dry_gain = dry_gain;
+    ag->wet_gain = wet_gain;
+}
+
+
+// Catmull-Rom interpolation of the YMF262 frames, normalized to +/-1 full scale
+static void aymo_adlibgold_resample(struct aymo_adlibgold* ag, uint32_t n)
+{
+    const float scale = (float)(1. / 32768.);
+    const float frac_scale = (float)(1. / 4294967296.);
+    uint64_t pos = ag->src_pos;
+    float* y = ag->dry;
+
+    for (uint32_t i = 0u; i < n; ++i) {
+        const float* x = &ag->src[(size_t)(pos >> 32) * 2u];
+        float t = ((float)(uint32_t)pos * frac_scale);
+
+        for (unsigned c = 0u; c < 2u; ++c) {
+            float x0 = x[c], x1 = x[2u + c], x2 = x[4u + c], x3 = x[6u + c];
+            float a = ((3.f * (x1 - x2)) + x3 - x0);
+            float b = ((2.f * x0) - (5.f * x1) + (4.f * x2) - x3);
+            float d = (x2 - x0);
+            *y++ = ((x1 + (.5f * t * (d + (t * (b + (t * a)))))) * scale);
+        }
+        pos += ag->src_step;
+    }
+}
+
+
+// Runs an even number of frames, up to a block, through all the stages
+static void aymo_adlibgold_run(struct aymo_adlibgold* ag, uint32_t n, float y[])
+{
+    assert(n <= AYMO_ADLIBGOLD_BLOCK_LENGTH);
+    assert(!(n & 1u));
+
+    const size_t history = (AYMO_ADLIBGOLD_SOURCE_HISTORY * 2u);
+    uint64_t end = (ag->src_pos + (n * ag->src_step));
+    uint32_t m = (uint32_t)(end >> 32);  // new source frames, past the history
+    assert(m <= AYMO_ADLIBGOLD_SOURCE_LENGTH);
+
+    aymo_ymf262_generate_f32x2(ag->ymf262, m, &ag->src[history]);
+    aymo_adlibgold_resample(ag, n);
+
+    for (size_t i = 0u; i < history; ++i) {
+        ag->src[i] = ag->src[(m * 2u) + i];
+    }
+    ag->src_pos = (end & 0xFFFFFFFFu);
+
+    // The YM7128 takes the mono sum at half the rate, and outputs two frames each
+    for (uint32_t j = 0u; j < (n / 2u); ++j) {
+        const float* x = &ag->dry[j * 4u];
+        ag->mono[j] = ((x[0] + x[1] + x[2] + x[3]) * .25f);
+    }
+    aymo_ym7128_process_f32(ag->ym7128, (n / 2u), ag->mono, ag->wet);
+
+    float kd = ag->dry_gain;
+    float kw = ag->wet_gain;
+    for (size_t i = 0u; i < (n * 2u); ++i) {
+        ag->dry[i] = ((ag->dry[i] * kd) + (ag->wet[i] * kw));
+    }
+    aymo_tda8425_process_f32(ag->tda8425, n, ag->dry, y);
+}
+
+
+void aymo_adlibgold_generate_f32x2(struct aymo_adlibgold* ag, uint32_t count, float y[])
+{
+    assert(ag);
+    assert(y || !count);
+
+    while (count) {
+        if (ag->pending) {
+            y[0] = ag->pending_frame[0];
+            y[1] = ag->pending_frame[1];
+            y += 2u;
+            --count;
+            ag->pending = 0u;
+            continue;
+        }
+
+        uint32_t n = ((count < AYMO_ADLIBGOLD_BLOCK_LENGTH) ? count : AYMO_ADLIBGOLD_BLOCK_LENGTH);
+        n &= ~1u;
+        if (n) {
+            aymo_adlibgold_run(ag, n, y);
+            y += (n * 2u);
+            count -= n;
+        }
+        else {
+            // Odd frame out: keep its pair for the next call
+            float yy[4];
+            aymo_adlibgold_run(ag, 2u, yy);
+            y[0] = yy[0];
+            y[1] = yy[1];
+            ag->pending_frame[0] = yy[2];
+            ag->pending_frame[1] = yy[3];
+            ag->pending = 1u;
+            return;
+        }
+    }
+}
+
+
+void aymo_adlibgold_generate_i16x2(struct aymo_adlibgold* ag, uint32_t count, int16_t y[])
+{
+    assert(ag);
+    assert(y || !count);
+
+    while (count) {
+        uint32_t n = ((count < AYMO_ADLIBGOLD_BLOCK_LENGTH) ? count : AYMO_ADLIBGOLD_BLOCK_LENGTH);
+        aymo_adlibgold_generate_f32x2(ag, n, ag->out);
+        aymo_convert_f32_i16_1((n * 2u), ag->out, y);
+        y += (n * 2u);
+        count -= n;
+    }
+}
+
+
+AYMO_CXX_EXTERN_C_END
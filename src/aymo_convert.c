@@ -27,6 +27,8 @@ along with AYMO. If not, see <https://www.gnu.org/licenses/>.
 #include "aymo_convert_x86_sse41.h"
 #include "aymo_cpu.h"
 
+#include <assert.h>
+
 AYMO_CXX_EXTERN_C_BEGIN
 
 
@@ -43,6 +45,42 @@ typedef void (*aymo_convert_u16_f32_1_f)(size_t n, const uint16_t u16v[], float
 typedef void (*aymo_convert_f32_u16_1_f)(size_t n, const float f32v[], uint16_t u16v[]);
 typedef void (*aymo_convert_u16_f32_k_f)(size_t n, const uint16_t u16v[], float f32v[], float scale);
 typedef void (*aymo_convert_f32_u16_k_f)(size_t n, const float f32v[], uint16_t u16v[], float scale);
+typedef void (*aymo_convert_i8_f32_f)(size_t n, const int8_t i8v[], float f32v[]);
+typedef void (*aymo_convert_f32_i8_f)(size_t n, const float f32v[], int8_t i8v[]);
+typedef void (*aymo_convert_i8_f32_1_f)(size_t n, const int8_t i8v[], float f32v[]);
+typedef void (*aymo_convert_f32_i8_1_f)(size_t n, const float f32v[], int8_t i8v[]);
+typedef void (*aymo_convert_i8_f32_k_f)(size_t n, const int8_t i8v[], float f32v[], float scale);
+typedef void (*aymo_convert_f32_i8_k_f)(size_t n, const float f32v[], int8_t i8v[], float scale);
+typedef void (*aymo_convert_u8_f32_f)(size_t n, const uint8_t u8v[], float f32v[]);
+typedef void (*aymo_convert_f32_u8_f)(size_t n, const float f32v[], uint8_t u8v[]);
+typedef void (*aymo_convert_u8_f32_1_f)(size_t n, const uint8_t u8v[], float f32v[]);
+typedef void (*aymo_convert_f32_u8_1_f)(size_t n, const float f32v[], uint8_t u8v[]);
+typedef void (*aymo_convert_u8_f32_k_f)(size_t n, const uint8_t u8v[], float f32v[], float scale);
+typedef void (*aymo_convert_f32_u8_k_f)(size_t n, const float f32v[], uint8_t u8v[], float scale);
+typedef void (*aymo_convert_i24_f32_f)(size_t n, const uint8_t i24v[], float f32v[]);
+typedef void (*aymo_convert_f32_i24_f)(size_t n, const float f32v[], uint8_t i24v[]);
+typedef void (*aymo_convert_i24_f32_1_f)(size_t n, const uint8_t i24v[], float f32v[]);
+typedef void (*aymo_convert_f32_i24_1_f)(size_t n, const float f32v[], uint8_t i24v[]);
+typedef void (*aymo_convert_i24_f32_k_f)(size_t n, const uint8_t i24v[], float f32v[], float scale);
+typedef void (*aymo_convert_f32_i24_k_f)(size_t n, const float f32v[], uint8_t i24v[], float scale);
+typedef void (*aymo_convert_i32_f32_f)(size_t n, const int32_t i32v[], float f32v[]);
+typedef void (*aymo_convert_f32_i32_f)(size_t n, const float f32v[], int32_t i32v[]);
+typedef void (*aymo_convert_i32_f32_1_f)(size_t n, const int32_t i32v[], float f32v[]);
+typedef void (*aymo_convert_f32_i32_1_f)(size_t n, const float f32v[], int32_t i32v[]);
+typedef void (*aymo_convert_i32_f32_k_f)(size_t n, const int32_t i32v[], float f32v[], float scale);
+typedef void (*aymo_convert_f32_i32_k_f)(size_t n, const float f32v[], int32_t i32v[], float scale);
+typedef void (*aymo_convert_f64_f32_f)(size_t n, const double f64v[], float f32v[]);
+typedef void (*aymo_convert_f32_f64_f)(size_t n, const float f32v[], double f64v[]);
+typedef void (*aymo_convert_f64_f32_k_f)(size_t n, const double f64v[], float f32v[], float scale);
+typedef void (*aymo_convert_f32_f64_k_f)(size_t n, const float f32v[], double f64v[], float scale);
+typedef void (*aymo_convert_i16x2_f32x2_k_f)(size_t n, const int16_t i16x2v[], float f32lv[], float f32rv[], float scale);
+typedef void (*aymo_convert_f32x2_i16x2_k_f)(size_t n, const float f32lv[], const float f32rv[], int16_t i16x2v[], float scale);
+typedef void (*aymo_convert_i16x4_i16x2_k_f)(size_t n, const int16_t i16x4v[], int16_t i16x2v[], const float k[4]);
+typedef void (*aymo_convert_i16x4_f32x2_k_f)(size_t n, const int16_t i16x4v[], float f32x2v[], const float k[4]);
+typedef void (*aymo_convert_i16_f32_k_m_f)(size_t n, const int16_t i16v[], float f32v[], float scale, struct aymo_convert_meter* meter);
+typedef void (*aymo_convert_f32_i16_k_m_f)(size_t n, const float f32v[], int16_t i16v[], float scale, struct aymo_convert_meter* meter);
+typedef void (*aymo_convert_i16_f32_k_nt_f)(size_t n, const int16_t i16v[], float f32v[], float scale);
+typedef void (*aymo_convert_f32_i16_k_nt_f)(size_t n, const float f32v[], int16_t i16v[], float scale);
 
 // Dispatcher function pointers
 static aymo_convert_i16_f32_f aymo_convert_i16_f32_p;
@@ -57,6 +95,44 @@ static aymo_convert_u16_f32_1_f aymo_convert_u16_f32_1_p;
 static aymo_convert_f32_u16_1_f aymo_convert_f32_u16_1_p;
 static aymo_convert_u16_f32_k_f aymo_convert_u16_f32_k_p;
 static aymo_convert_f32_u16_k_f aymo_convert_f32_u16_k_p;
+static aymo_convert_i8_f32_f aymo_convert_i8_f32_p;
+static aymo_convert_f32_i8_f aymo_convert_f32_i8_p;
+static aymo_convert_i8_f32_1_f aymo_convert_i8_f32_1_p;
+static aymo_convert_f32_i8_1_f aymo_convert_f32_i8_1_p;
+static aymo_convert_i8_f32_k_f aymo_convert_i8_f32_k_p;
+static aymo_convert_f32_i8_k_f aymo_convert_f32_i8_k_p;
+static aymo_convert_u8_f32_f aymo_convert_u8_f32_p;
+static aymo_convert_f32_u8_f aymo_convert_f32_u8_p;
+static aymo_convert_u8_f32_1_f aymo_convert_u8_f32_1_p;
+static aymo_convert_f32_u8_1_f aymo_convert_f32_u8_1_p;
+static aymo_convert_u8_f32_k_f aymo_convert_u8_f32_k_p;
+static aymo_convert_f32_u8_k_f aymo_convert_f32_u8_k_p;
+static aymo_convert_i24_f32_f aymo_convert_i24_f32_p;
+static aymo_convert_f32_i24_f aymo_convert_f32_i24_p;
+static aymo_convert_i24_f32_1_f aymo_convert_i24_f32_1_p;
+static aymo_convert_f32_i24_1_f aymo_convert_f32_i24_1_p;
+static aymo_convert_i24_f32_k_f aymo_convert_i24_f32_k_p;
+static aymo_convert_f32_i24_k_f aymo_convert_f32_i24_k_p;
+static aymo_convert_i32_f32_f aymo_convert_i32_f32_p;
+static aymo_convert_f32_i32_f aymo_convert_f32_i32_p;
+static aymo_convert_i32_f32_1_f aymo_convert_i32_f32_1_p;
+static aymo_convert_f32_i32_1_f aymo_convert_f32_i32_1_p;
+static aymo_convert_i32_f32_k_f aymo_convert_i32_f32_k_p;
+static aymo_convert_f32_i32_k_f aymo_convert_f32_i32_k_p;
+static aymo_convert_f64_f32_f aymo_convert_f64_f32_p;
+static aymo_convert_f32_f64_f aymo_convert_f32_f64_p;
+static aymo_convert_f64_f32_k_f aymo_convert_f64_f32_k_p;
+static aymo_convert_f32_f64_k_f aymo_convert_f32_f64_k_p;
+static aymo_convert_i16x2_f32x2_k_f aymo_convert_i16x2_f32x2_k_p;
+static aymo_convert_f32x2_i16x2_k_f aymo_convert_f32x2_i16x2_k_p;
+static aymo_convert_i16x4_i16x2_k_f aymo_convert_i16x4_i16x2_k_p;
+static aymo_convert_i16x4_f32x2_k_f aymo_convert_i16x4_f32x2_k_p;
+static aymo_convert_i16_f32_k_m_f aymo_convert_i16_f32_k_m_p;
+static aymo_convert_f32_i16_k_m_f aymo_convert_f32_i16_k_m_p;
+static aymo_convert_i16_f32_k_nt_f aymo_convert_i16_f32_k_nt_p;  // NULL if no streaming stores
+static aymo_convert_f32_i16_k_nt_f aymo_convert_f32_i16_k_nt_p;  // NULL if no streaming stores
+
+static size_t aymo_convert_stream_threshold = AYMO_CONVERT_STREAM_THRESHOLD_DEFAULT;
 
 
 void aymo_convert_boot(void)
@@ -75,6 +151,42 @@ void aymo_convert_boot(void)
         aymo_convert_f32_u16_1_p = aymo_convert_x86_avx2_f32_u16_1;
         aymo_convert_u16_f32_k_p = aymo_convert_x86_avx2_u16_f32_k;
         aymo_convert_f32_u16_k_p = aymo_convert_x86_avx2_f32_u16_k;
+        aymo_convert_i8_f32_p = aymo_convert_x86_avx2_i8_f32;
+        aymo_convert_f32_i8_p = aymo_convert_x86_avx2_f32_i8;
+        aymo_convert_i8_f32_1_p = aymo_convert_x86_avx2_i8_f32_1;
+        aymo_convert_f32_i8_1_p = aymo_convert_x86_avx2_f32_i8_1;
+        aymo_convert_i8_f32_k_p = aymo_convert_x86_avx2_i8_f32_k;
+        aymo_convert_f32_i8_k_p = aymo_convert_x86_avx2_f32_i8_k;
+        aymo_convert_u8_f32_p = aymo_convert_x86_avx2_u8_f32;
+        aymo_convert_f32_u8_p = aymo_convert_x86_avx2_f32_u8;
+        aymo_convert_u8_f32_1_p = aymo_convert_x86_avx2_u8_f32_1;
+        aymo_convert_f32_u8_1_p = aymo_convert_x86_avx2_f32_u8_1;
+        aymo_convert_u8_f32_k_p = aymo_convert_x86_avx2_u8_f32_k;
+        aymo_convert_f32_u8_k_p = aymo_convert_x86_avx2_f32_u8_k;
+        aymo_convert_i24_f32_p = aymo_convert_x86_avx2_i24_f32;
+        aymo_convert_f32_i24_p = aymo_convert_x86_avx2_f32_i24;
+        aymo_convert_i24_f32_1_p = aymo_convert_x86_avx2_i24_f32_1;
+        aymo_convert_f32_i24_1_p = aymo_convert_x86_avx2_f32_i24_1;
+        aymo_convert_i24_f32_k_p = aymo_convert_x86_avx2_i24_f32_k;
+        aymo_convert_f32_i24_k_p = aymo_convert_x86_avx2_f32_i24_k;
+        aymo_convert_i32_f32_p = aymo_convert_x86_avx2_i32_f32;
+        aymo_convert_f32_i32_p = aymo_convert_x86_avx2_f32_i32;
+        aymo_convert_i32_f32_1_p = aymo_convert_x86_avx2_i32_f32_1;
+        aymo_convert_f32_i32_1_p = aymo_convert_x86_avx2_f32_i32_1;
+        aymo_convert_i32_f32_k_p = aymo_convert_x86_avx2_i32_f32_k;
+        aymo_convert_f32_i32_k_p = aymo_convert_x86_avx2_f32_i32_k;
+        aymo_convert_f64_f32_p = aymo_convert_x86_avx2_f64_f32;
+        aymo_convert_f32_f64_p = aymo_convert_x86_avx2_f32_f64;
+        aymo_convert_f64_f32_k_p = aymo_convert_x86_avx2_f64_f32_k;
+        aymo_convert_f32_f64_k_p = aymo_convert_x86_avx2_f32_f64_k;
+        aymo_convert_i16x2_f32x2_k_p = aymo_convert_x86_avx2_i16x2_f32x2_k;
+        aymo_convert_f32x2_i16x2_k_p = aymo_convert_x86_avx2_f32x2_i16x2_k;
+        aymo_convert_i16x4_i16x2_k_p = aymo_convert_x86_avx2_i16x4_i16x2_k;
+        aymo_convert_i16x4_f32x2_k_p = aymo_convert_x86_avx2_i16x4_f32x2_k;
+        aymo_convert_i16_f32_k_m_p = aymo_convert_x86_avx2_i16_f32_k_m;
+        aymo_convert_f32_i16_k_m_p = aymo_convert_x86_avx2_f32_i16_k_m;
+        aymo_convert_i16_f32_k_nt_p = aymo_convert_x86_avx2_i16_f32_k_nt;
+        aymo_convert_f32_i16_k_nt_p = aymo_convert_x86_avx2_f32_i16_k_nt;
         return;
     }
 #endif  // AYMO_CPU_SUPPORT_X86_AVX2
@@ -93,6 +205,42 @@ void aymo_convert_boot(void)
         aymo_convert_f32_u16_1_p = aymo_convert_x86_sse41_f32_u16_1;
         aymo_convert_u16_f32_k_p = aymo_convert_x86_sse41_u16_f32_k;
         aymo_convert_f32_u16_k_p = aymo_convert_x86_sse41_f32_u16_k;
+        aymo_convert_i8_f32_p = aymo_convert_x86_sse41_i8_f32;
+        aymo_convert_f32_i8_p = aymo_convert_x86_sse41_f32_i8;
+        aymo_convert_i8_f32_1_p = aymo_convert_x86_sse41_i8_f32_1;
+        aymo_convert_f32_i8_1_p = aymo_convert_x86_sse41_f32_i8_1;
+        aymo_convert_i8_f32_k_p = aymo_convert_x86_sse41_i8_f32_k;
+        aymo_convert_f32_i8_k_p = aymo_convert_x86_sse41_f32_i8_k;
+        aymo_convert_u8_f32_p = aymo_convert_x86_sse41_u8_f32;
+        aymo_convert_f32_u8_p = aymo_convert_x86_sse41_f32_u8;
+        aymo_convert_u8_f32_1_p = aymo_convert_x86_sse41_u8_f32_1;
+        aymo_convert_f32_u8_1_p = aymo_convert_x86_sse41_f32_u8_1;
+        aymo_convert_u8_f32_k_p = aymo_convert_x86_sse41_u8_f32_k;
+        aymo_convert_f32_u8_k_p = aymo_convert_x86_sse41_f32_u8_k;
+        aymo_convert_i24_f32_p = aymo_convert_x86_sse41_i24_f32;
+        aymo_convert_f32_i24_p = aymo_convert_x86_sse41_f32_i24;
+        aymo_convert_i24_f32_1_p = aymo_convert_x86_sse41_i24_f32_1;
+        aymo_convert_f32_i24_1_p = aymo_convert_x86_sse41_f32_i24_1;
+        aymo_convert_i24_f32_k_p = aymo_convert_x86_sse41_i24_f32_k;
+        aymo_convert_f32_i24_k_p = aymo_convert_x86_sse41_f32_i24_k;
+        aymo_convert_i32_f32_p = aymo_convert_x86_sse41_i32_f32;
+        aymo_convert_f32_i32_p = aymo_convert_x86_sse41_f32_i32;
+        aymo_convert_i32_f32_1_p = aymo_convert_x86_sse41_i32_f32_1;
+        aymo_convert_f32_i32_1_p = aymo_convert_x86_sse41_f32_i32_1;
+        aymo_convert_i32_f32_k_p = aymo_convert_x86_sse41_i32_f32_k;
+        aymo_convert_f32_i32_k_p = aymo_convert_x86_sse41_f32_i32_k;
+        aymo_convert_f64_f32_p = aymo_convert_x86_sse41_f64_f32;
+        aymo_convert_f32_f64_p = aymo_convert_x86_sse41_f32_f64;
+        aymo_convert_f64_f32_k_p = aymo_convert_x86_sse41_f64_f32_k;
+        aymo_convert_f32_f64_k_p = aymo_convert_x86_sse41_f32_f64_k;
+        aymo_convert_i16x2_f32x2_k_p = aymo_convert_x86_sse41_i16x2_f32x2_k;
+        aymo_convert_f32x2_i16x2_k_p = aymo_convert_x86_sse41_f32x2_i16x2_k;
+        aymo_convert_i16x4_i16x2_k_p = aymo_convert_x86_sse41_i16x4_i16x2_k;
+        aymo_convert_i16x4_f32x2_k_p = aymo_convert_x86_sse41_i16x4_f32x2_k;
+        aymo_convert_i16_f32_k_m_p = aymo_convert_x86_sse41_i16_f32_k_m;
+        aymo_convert_f32_i16_k_m_p = aymo_convert_x86_sse41_f32_i16_k_m;
+        aymo_convert_i16_f32_k_nt_p = aymo_convert_x86_sse41_i16_f32_k_nt;
+        aymo_convert_f32_i16_k_nt_p = aymo_convert_x86_sse41_f32_i16_k_nt;
         return;
     }
 #endif  // AYMO_CPU_SUPPORT_X86_SSE41
@@ -111,6 +259,44 @@ void aymo_convert_boot(void)
         aymo_convert_f32_u16_1_p = aymo_convert_arm_neon_f32_u16_1;
         aymo_convert_u16_f32_k_p = aymo_convert_arm_neon_u16_f32_k;
         aymo_convert_f32_u16_k_p = aymo_convert_arm_neon_f32_u16_k;
+        // Formats without a NEON implementation yet
+        aymo_convert_i8_f32_p = aymo_convert_none_i8_f32;
+        aymo_convert_f32_i8_p = aymo_convert_none_f32_i8;
+        aymo_convert_i8_f32_1_p = aymo_convert_none_i8_f32_1;
+        aymo_convert_f32_i8_1_p = aymo_convert_none_f32_i8_1;
+        aymo_convert_i8_f32_k_p = aymo_convert_none_i8_f32_k;
+        aymo_convert_f32_i8_k_p = aymo_convert_none_f32_i8_k;
+        aymo_convert_u8_f32_p = aymo_convert_none_u8_f32;
+        aymo_convert_f32_u8_p = aymo_convert_none_f32_u8;
+        aymo_convert_u8_f32_1_p = aymo_convert_none_u8_f32_1;
+        aymo_convert_f32_u8_1_p = aymo_convert_none_f32_u8_1;
+        aymo_convert_u8_f32_k_p = aymo_convert_none_u8_f32_k;
+        aymo_convert_f32_u8_k_p = aymo_convert_none_f32_u8_k;
+        aymo_convert_i24_f32_p = aymo_convert_none_i24_f32;
+        aymo_convert_f32_i24_p = aymo_convert_none_f32_i24;
+        aymo_convert_i24_f32_1_p = aymo_convert_none_i24_f32_1;
+        aymo_convert_f32_i24_1_p = aymo_convert_none_f32_i24_1;
+        aymo_convert_i24_f32_k_p = aymo_convert_none_i24_f32_k;
+        aymo_convert_f32_i24_k_p = aymo_convert_none_f32_i24_k;
+        aymo_convert_i32_f32_p = aymo_convert_none_i32_f32;
+        aymo_convert_f32_i32_p = aymo_convert_none_f32_i32;
+        aymo_convert_i32_f32_1_p = aymo_convert_none_i32_f32_1;
+        aymo_convert_f32_i32_1_p = aymo_convert_none_f32_i32_1;
+        aymo_convert_i32_f32_k_p = aymo_convert_none_i32_f32_k;
+        aymo_convert_f32_i32_k_p = aymo_convert_none_f32_i32_k;
+        aymo_convert_f64_f32_p = aymo_convert_none_f64_f32;
+        aymo_convert_f32_f64_p = aymo_convert_none_f32_f64;
+        aymo_convert_f64_f32_k_p = aymo_convert_none_f64_f32_k;
+        aymo_convert_f32_f64_k_p = aymo_convert_none_f32_f64_k;
+        aymo_convert_i16x2_f32x2_k_p = aymo_convert_arm_neon_i16x2_f32x2_k;
+        aymo_convert_f32x2_i16x2_k_p = aymo_convert_arm_neon_f32x2_i16x2_k;
+        aymo_convert_i16x4_i16x2_k_p = aymo_convert_arm_neon_i16x4_i16x2_k;
+        aymo_convert_i16x4_f32x2_k_p = aymo_convert_arm_neon_i16x4_f32x2_k;
+        // Metering without a NEON implementation yet
+        aymo_convert_i16_f32_k_m_p = aymo_convert_none_i16_f32_k_m;
+        aymo_convert_f32_i16_k_m_p = aymo_convert_none_f32_i16_k_m;
+        aymo_convert_i16_f32_k_nt_p = NULL;  // streaming stores are x86 only
+        aymo_convert_f32_i16_k_nt_p = NULL;
         return;
     }
 #endif  // AYMO_CPU_SUPPORT_ARM_NEON
@@ -128,41 +314,175 @@ void aymo_convert_boot(void)
     aymo_convert_f32_u16_1_p = aymo_convert_none_f32_u16_1;
     aymo_convert_u16_f32_k_p = aymo_convert_none_u16_f32_k;
     aymo_convert_f32_u16_k_p = aymo_convert_none_f32_u16_k;
+    aymo_convert_i8_f32_p = aymo_convert_none_i8_f32;
+    aymo_convert_f32_i8_p = aymo_convert_none_f32_i8;
+    aymo_convert_i8_f32_1_p = aymo_convert_none_i8_f32_1;
+    aymo_convert_f32_i8_1_p = aymo_convert_none_f32_i8_1;
+    aymo_convert_i8_f32_k_p = aymo_convert_none_i8_f32_k;
+    aymo_convert_f32_i8_k_p = aymo_convert_none_f32_i8_k;
+    aymo_convert_u8_f32_p = aymo_convert_none_u8_f32;
+    aymo_convert_f32_u8_p = aymo_convert_none_f32_u8;
+    aymo_convert_u8_f32_1_p = aymo_convert_none_u8_f32_1;
+    aymo_convert_f32_u8_1_p = aymo_convert_none_f32_u8_1;
+    aymo_convert_u8_f32_k_p = aymo_convert_none_u8_f32_k;
+    aymo_convert_f32_u8_k_p = aymo_convert_none_f32_u8_k;
+    aymo_convert_i24_f32_p = aymo_convert_none_i24_f32;
+    aymo_convert_f32_i24_p = aymo_convert_none_f32_i24;
+    aymo_convert_i24_f32_1_p = aymo_convert_none_i24_f32_1;
+    aymo_convert_f32_i24_1_p = aymo_convert_none_f32_i24_1;
+    aymo_convert_i24_f32_k_p = aymo_convert_none_i24_f32_k;
+    aymo_convert_f32_i24_k_p = aymo_convert_none_f32_i24_k;
+    aymo_convert_i32_f32_p = aymo_convert_none_i32_f32;
+    aymo_convert_f32_i32_p = aymo_convert_none_f32_i32;
+    aymo_convert_i32_f32_1_p = aymo_convert_none_i32_f32_1;
+    aymo_convert_f32_i32_1_p = aymo_convert_none_f32_i32_1;
+    aymo_convert_i32_f32_k_p = aymo_convert_none_i32_f32_k;
+    aymo_convert_f32_i32_k_p = aymo_convert_none_f32_i32_k;
+    aymo_convert_f64_f32_p = aymo_convert_none_f64_f32;
+    aymo_convert_f32_f64_p = aymo_convert_none_f32_f64;
+    aymo_convert_f64_f32_k_p = aymo_convert_none_f64_f32_k;
+    aymo_convert_f32_f64_k_p = aymo_convert_none_f32_f64_k;
+    aymo_convert_i16x2_f32x2_k_p = aymo_convert_none_i16x2_f32x2_k;
+    aymo_convert_f32x2_i16x2_k_p = aymo_convert_none_f32x2_i16x2_k;
+    aymo_convert_i16x4_i16x2_k_p = aymo_convert_none_i16x4_i16x2_k;
+    aymo_convert_i16x4_f32x2_k_p = aymo_convert_none_i16x4_f32x2_k;
+    aymo_convert_i16_f32_k_m_p = aymo_convert_none_i16_f32_k_m;
+    aymo_convert_f32_i16_k_m_p = aymo_convert_none_f32_i16_k_m;
+    aymo_convert_i16_f32_k_nt_p = NULL;
+    aymo_convert_f32_i16_k_nt_p = NULL;
+}
+
+
+void aymo_convert_set_stream_threshold(size_t size)
+{
+    aymo_convert_stream_threshold = size;
+}
+
+
+size_t aymo_convert_get_stream_threshold(void)
+{
+    return aymo_convert_stream_threshold;
+}
+
+
+static inline int aymo_convert_is_streamed(size_t n, size_t size)
+{
+    return (n >= (aymo_convert_stream_threshold / size));
+}
+
+
+void aymo_convert_meter_ctor(struct aymo_convert_meter* meter, uint32_t channels)
+{
+    assert(meter);
+    assert((channels >= 1u) && (channels <= AYMO_CONVERT_METER_CHANNELS_MAX));
+
+    aymo_memset(meter, 0, sizeof(*meter));
+    meter->channels = channels;
+}
+
+
+static inline void aymo_convert_meter_end_run(struct aymo_convert_meter* meter, uint32_t ch)
+{
+    uint64_t run = meter->zero_run[ch];
+    if (run == meter->count[ch]) {  // nothing but zeros so far
+        meter->zero_lead[ch] = run;
+    }
+    if (meter->zero_run_max[ch] < run) {
+        meter->zero_run_max[ch] = run;
+    }
+    meter->zero_run[ch] = 0u;
+}
+
+
+void aymo_convert_meter_zeros(struct aymo_convert_meter* meter, size_t n, uint32_t zeros)
+{
+    uint32_t channels = meter->channels;
+    uint32_t full = ((n < 32u) ? (uint32_t)((1uL << n) - 1u) : UINT32_MAX);
+    uint32_t ch;
+
+    if (zeros == full) {
+        for (ch = 0u; ch < channels; ++ch) {
+            meter->zero_run[ch] += (n / channels);
+            meter->count[ch] += (n / channels);
+        }
+    }
+    else if (!zeros) {
+        for (ch = 0u; ch < channels; ++ch) {
+            aymo_convert_meter_end_run(meter, ch);
+            meter->count[ch] += (n / channels);
+        }
+    }
+    else {
+        for (size_t i = 0u; i < n; ++i) {
+            ch = (uint32_t)(i % channels);
+            if (zeros & (1uL << i)) {
+                ++meter->zero_run[ch];
+            }
+            else {
+                aymo_convert_meter_end_run(meter, ch);
+            }
+            ++meter->count[ch];
+        }
+    }
 }
 
 
 void aymo_convert_i16_f32(size_t n, const int16_t i16v[], float f32v[])
 {
+    if (aymo_convert_i16_f32_k_nt_p && aymo_convert_is_streamed(n, sizeof(float))) {
+        aymo_convert_i16_f32_k_nt_p(n, i16v, f32v, 1.f);
+        return;
+    }
     aymo_convert_i16_f32_p(n, i16v, f32v);
 }
 
 
 void aymo_convert_f32_i16(size_t n, const float f32v[], int16_t i16v[])
 {
+    if (aymo_convert_f32_i16_k_nt_p && aymo_convert_is_streamed(n, sizeof(int16_t))) {
+        aymo_convert_f32_i16_k_nt_p(n, f32v, i16v, 1.f);
+        return;
+    }
     aymo_convert_f32_i16_p(n, f32v, i16v);
 }
 
 
 void aymo_convert_i16_f32_1(size_t n, const int16_t i16v[], float f32v[])
 {
+    if (aymo_convert_i16_f32_k_nt_p && aymo_convert_is_streamed(n, sizeof(float))) {
+        aymo_convert_i16_f32_k_nt_p(n, i16v, f32v, (float)(1. / 32768.));
+        return;
+    }
     aymo_convert_i16_f32_1_p(n, i16v, f32v);
 }
 
 
 void aymo_convert_f32_i16_1(size_t n, const float f32v[], int16_t i16v[])
 {
+    if (aymo_convert_f32_i16_k_nt_p && aymo_convert_is_streamed(n, sizeof(int16_t))) {
+        aymo_convert_f32_i16_k_nt_p(n, f32v, i16v, (float)(32768.));
+        return;
+    }
     aymo_convert_f32_i16_1_p(n, f32v, i16v);
 }
 
 
 void aymo_convert_i16_f32_k(size_t n, const int16_t i16v[], float f32v[], float scale)
 {
+    if (aymo_convert_i16_f32_k_nt_p && aymo_convert_is_streamed(n, sizeof(float))) {
+        aymo_convert_i16_f32_k_nt_p(n, i16v, f32v, scale);
+        return;
+    }
     aymo_convert_i16_f32_k_p(n, i16v, f32v, scale);
 }
 
 
 void aymo_convert_f32_i16_k(size_t n, const float f32v[], int16_t i16v[], float scale)
 {
+    if (aymo_convert_f32_i16_k_nt_p && aymo_convert_is_streamed(n, sizeof(int16_t))) {
+        aymo_convert_f32_i16_k_nt_p(n, f32v, i16v, scale);
+        return;
+    }
     aymo_convert_f32_i16_k_p(n, f32v, i16v, scale);
 }
 
@@ -203,4 +523,208 @@ void aymo_convert_f32_u16_k(size_t n, const float f32v[], uint16_t u16v[], float
 }
 
 
+void aymo_convert_i8_f32(size_t n, const int8_t i8v[], float f32v[])
+{
+    aymo_convert_i8_f32_p(n, i8v, f32v);
+}
+
+
+void aymo_convert_f32_i8(size_t n, const float f32v[], int8_t i8v[])
+{
+    aymo_convert_f32_i8_p(n, f32v, i8v);
+}
+
+
+void aymo_convert_i8_f32_1(size_t n, const int8_t i8v[], float f32v[])
+{
+    aymo_convert_i8_f32_1_p(n, i8v, f32v);
+}
+
+
+void aymo_convert_f32_i8_1(size_t n, const float f32v[], int8_t i8v[])
+{
+    aymo_convert_f32_i8_1_p(n, f32v, i8v);
+}
+
+
+void aymo_convert_i8_f32_k(size_t n, const int8_t i8v[], float f32v[], float scale)
+{
+    aymo_convert_i8_f32_k_p(n, i8v, f32v, scale);
+}
+
+
+void aymo_convert_f32_i8_k(size_t n, const float f32v[], int8_t i8v[], float scale)
+{
+    aymo_convert_f32_i8_k_p(n, f32v, i8v, scale);
+}
+
+
+void aymo_convert_u8_f32(size_t n, const uint8_t u8v[], float f32v[])
+{
+    aymo_convert_u8_f32_p(n, u8v, f32v);
+}
+
+
+void aymo_convert_f32_u8(size_t n, const float f32v[], uint8_t u8v[])
+{
+    aymo_convert_f32_u8_p(n, f32v, u8v);
+}
+
+
+void aymo_convert_u8_f32_1(size_t n, const uint8_t u8v[], float f32v[])
+{
+    aymo_convert_u8_f32_1_p(n, u8v, f32v);
+}
+
+
+void aymo_convert_f32_u8_1(size_t n, const float f32v[], uint8_t u8v[])
+{
+    aymo_convert_f32_u8_1_p(n, f32v, u8v);
+}
+
+
+void aymo_convert_u8_f32_k(size_t n, const uint8_t u8v[], float f32v[], float scale)
+{
+    aymo_convert_u8_f32_k_p(n, u8v, f32v, scale);
+}
+
+
+void aymo_convert_f32_u8_k(size_t n, const float f32v[], uint8_t u8v[], float scale)
+{
+    aymo_convert_f32_u8_k_p(n, f32v, u8v, scale);
+}
+
+
+void aymo_convert_i24_f32(size_t n, const uint8_t i24v[], float f32v[])
+{
+    aymo_convert_i24_f32_p(n, i24v, f32v);
+}
+
+
+void aymo_convert_f32_i24(size_t n, const float f32v[], uint8_t i24v[])
+{
+    aymo_convert_f32_i24_p(n, f32v, i24v);
+}
+
+
+void aymo_convert_i24_f32_1(size_t n, const uint8_t i24v[], float f32v[])
+{
+    aymo_convert_i24_f32_1_p(n, i24v, f32v);
+}
+
+
+void aymo_convert_f32_i24_1(size_t n, const float f32v[], uint8_t i24v[])
+{
+    aymo_convert_f32_i24_1_p(n, f32v, i24v);
+}
+
+
+void aymo_convert_i24_f32_k(size_t n, const uint8_t i24v[], float f32v[], float scale)
+{
+    aymo_convert_i24_f32_k_p(n, i24v, f32v, scale);
+}
+
+
+void aymo_convert_f32_i24_k(size_t n, const float f32v[], uint8_t i24v[], float scale)
+{
+    aymo_convert_f32_i24_k_p(n, f32v, i24v, scale);
+}
+
+
+void aymo_convert_i32_f32(size_t n, const int32_t i32v[], float f32v[])
+{
+    aymo_convert_i32_f32_p(n, i32v, f32v);
+}
+
+
+void aymo_convert_f32_i32(size_t n, const float f32v[], int32_t i32v[])
+{
+    aymo_convert_f32_i32_p(n, f32v, i32v);
+}
+
+
+void aymo_convert_i32_f32_1(size_t n, const int32_t i32v[], float f32v[])
+{
+    aymo_convert_i32_f32_1_p(n, i32v, f32v);
+}
+
+
+void aymo_convert_f32_i32_1(size_t n, const float f32v[], int32_t i32v[])
+{
+    aymo_convert_f32_i32_1_p(n, f32v, i32v);
+}
+
+
+void aymo_convert_i32_f32_k(size_t n, const int32_t i32v[], float f32v[], float scale)
+{
+    aymo_convert_i32_f32_k_p(n, i32v, f32v, scale);
+}
+
+
+void aymo_convert_f32_i32_k(size_t n, const float f32v[], int32_t i32v[], float scale)
+{
+    aymo_convert_f32_i32_k_p(n, f32v, i32v, scale);
+}
+
+
+void aymo_convert_f64_f32(size_t n, const double f64v[], float f32v[])
+{
+    aymo_convert_f64_f32_p(n, f64v, f32v);
+}
+
+
+void aymo_convert_f32_f64(size_t n, const float f32v[], double f64v[])
+{
+    aymo_convert_f32_f64_p(n, f32v, f64v);
+}
+
+
+void aymo_convert_f64_f32_k(size_t n, const double f64v[], float f32v[], float scale)
+{
+    aymo_convert_f64_f32_k_p(n, f64v, f32v, scale);
+}
+
+
+void aymo_convert_f32_f64_k(size_t n, const float f32v[], double f64v[], float scale)
+{
+    aymo_convert_f32_f64_k_p(n, f32v, f64v, scale);
+}
+
+
+void aymo_convert_i16x2_f32x2_k(size_t n, const int16_t i16x2v[], float f32lv[], float f32rv[], float scale)
+{
+    aymo_convert_i16x2_f32x2_k_p(n, i16x2v, f32lv, f32rv, scale);
+}
+
+
+void aymo_convert_f32x2_i16x2_k(size_t n, const float f32lv[], const float f32rv[], int16_t i16x2v[], float scale)
+{
+    aymo_convert_f32x2_i16x2_k_p(n, f32lv, f32rv, i16x2v, scale);
+}
+
+
+void aymo_convert_i16x4_i16x2_k(size_t n, const int16_t i16x4v[], int16_t i16x2v[], const float k[4])
+{
+    aymo_convert_i16x4_i16x2_k_p(n, i16x4v, i16x2v, k);
+}
+
+
+void aymo_convert_i16x4_f32x2_k(size_t n, const int16_t i16x4v[], float f32x2v[], const float k[4])
+{
+    aymo_convert_i16x4_f32x2_k_p(n, i16x4v, f32x2v, k);
+}
+
+
+void aymo_convert_i16_f32_k_m(size_t n, const int16_t i16v[], float f32v[], float scale, struct aymo_convert_meter* meter)
+{
+    aymo_convert_i16_f32_k_m_p(n, i16v, f32v, scale, meter);
+}
+
+
+void aymo_convert_f32_i16_k_m(size_t n, const float f32v[], int16_t i16v[], float scale, struct aymo_convert_meter* meter)
+{
+    aymo_convert_f32_i16_k_m_p(n, f32v, i16v, scale, meter);
+}
+
+
 AYMO_CXX_EXTERN_C_END
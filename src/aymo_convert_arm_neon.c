@@ -26,6 +26,8 @@ along with AYMO. If not, see <https://www.gnu.org/licenses/>.
 #define AYMO_KEEP_SHORTHANDS
 #include "aymo_convert_arm_neon.h"
 
+#include <string.h>
+
 AYMO_CXX_EXTERN_C_BEGIN
 
 
@@ -816,6 +818,159 @@ void aymo_(f32_u16_k)(size_t n, const float f32v[], uint16_t u16v[], float scale
 }
 
 
+// Fused layout kernels, processing 8 frames per step via structured loads/stores.
+// Tails are run through zero-padded temporary buffers.
+
+static inline void i16x2_f32x2_k_8(const int16_t i16x2v[], float f32lv[], float f32rv[], float32x4_t f32k)
+{
+    int16x8x2_t s16lr = vld2q_s16(i16x2v);
+    float32x4_t f32llo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(s16lr.val[0])));
+    float32x4_t f32lhi = vcvtq_f32_s32(vmovl_s16(vget_high_s16(s16lr.val[0])));
+    float32x4_t f32rlo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(s16lr.val[1])));
+    float32x4_t f32rhi = vcvtq_f32_s32(vmovl_s16(vget_high_s16(s16lr.val[1])));
+    vst1q_f32(&f32lv[0], vmulq_f32(f32llo, f32k));
+    vst1q_f32(&f32lv[4], vmulq_f32(f32lhi, f32k));
+    vst1q_f32(&f32rv[0], vmulq_f32(f32rlo, f32k));
+    vst1q_f32(&f32rv[4], vmulq_f32(f32rhi, f32k));
+}
+
+
+static inline void f32x2_i16x2_k_8(const float f32lv[], const float f32rv[], int16_t i16x2v[], float32x4_t f32k)
+{
+    float32x4_t f32llo = vmulq_f32(vld1q_f32(&f32lv[0]), f32k);
+    float32x4_t f32lhi = vmulq_f32(vld1q_f32(&f32lv[4]), f32k);
+    float32x4_t f32rlo = vmulq_f32(vld1q_f32(&f32rv[0]), f32k);
+    float32x4_t f32rhi = vmulq_f32(vld1q_f32(&f32rv[4]), f32k);
+    int16x8x2_t s16lr;
+    s16lr.val[0] = vcombine_s16(vqmovn_s32(vcvtq_s32_f32(f32llo)), vqmovn_s32(vcvtq_s32_f32(f32lhi)));
+    s16lr.val[1] = vcombine_s16(vqmovn_s32(vcvtq_s32_f32(f32rlo)), vqmovn_s32(vcvtq_s32_f32(f32rhi)));
+    vst2q_s16(i16x2v, s16lr);
+}
+
+
+static inline float32x4x2_t i16x4_lr_4(int16x4_t s16a, int16x4_t s16b, int16x4_t s16c, int16x4_t s16d, const float k[4])
+{
+    float32x4_t f32a = vcvtq_f32_s32(vmovl_s16(s16a));
+    float32x4_t f32b = vcvtq_f32_s32(vmovl_s16(s16b));
+    float32x4_t f32c = vcvtq_f32_s32(vmovl_s16(s16c));
+    float32x4_t f32d = vcvtq_f32_s32(vmovl_s16(s16d));
+    float32x4x2_t f32lr;
+    f32lr.val[0] = vaddq_f32(vmulq_n_f32(f32a, k[0]), vmulq_n_f32(f32c, k[2]));
+    f32lr.val[1] = vaddq_f32(vmulq_n_f32(f32b, k[1]), vmulq_n_f32(f32d, k[3]));
+    return f32lr;
+}
+
+
+static inline void i16x4_i16x2_k_8(const int16_t i16x4v[], int16_t i16x2v[], const float k[4])
+{
+    int16x8x4_t s16abcd = vld4q_s16(i16x4v);
+    float32x4x2_t f32lrlo = i16x4_lr_4(vget_low_s16(s16abcd.val[0]), vget_low_s16(s16abcd.val[1]),
+                                       vget_low_s16(s16abcd.val[2]), vget_low_s16(s16abcd.val[3]), k);
+    float32x4x2_t f32lrhi = i16x4_lr_4(vget_high_s16(s16abcd.val[0]), vget_high_s16(s16abcd.val[1]),
+                                       vget_high_s16(s16abcd.val[2]), vget_high_s16(s16abcd.val[3]), k);
+    int16x8x2_t s16lr;
+    s16lr.val[0] = vcombine_s16(vqmovn_s32(vcvtq_s32_f32(f32lrlo.val[0])), vqmovn_s32(vcvtq_s32_f32(f32lrhi.val[0])));
+    s16lr.val[1] = vcombine_s16(vqmovn_s32(vcvtq_s32_f32(f32lrlo.val[1])), vqmovn_s32(vcvtq_s32_f32(f32lrhi.val[1])));
+    vst2q_s16(i16x2v, s16lr);
+}
+
+
+static inline void i16x4_f32x2_k_8(const int16_t i16x4v[], float f32x2v[], const float k[4])
+{
+    int16x8x4_t s16abcd = vld4q_s16(i16x4v);
+    float32x4x2_t f32lrlo = i16x4_lr_4(vget_low_s16(s16abcd.val[0]), vget_low_s16(s16abcd.val[1]),
+                                       vget_low_s16(s16abcd.val[2]), vget_low_s16(s16abcd.val[3]), k);
+    float32x4x2_t f32lrhi = i16x4_lr_4(vget_high_s16(s16abcd.val[0]), vget_high_s16(s16abcd.val[1]),
+                                       vget_high_s16(s16abcd.val[2]), vget_high_s16(s16abcd.val[3]), k);
+    vst2q_f32(&f32x2v[0], f32lrlo);
+    vst2q_f32(&f32x2v[8], f32lrhi);
+}
+
+
+void aymo_(i16x2_f32x2_k)(size_t n, const int16_t i16x2v[], float f32lv[], float f32rv[], float scale)
+{
+    float32x4_t f32k = vdupq_n_f32(scale);
+    if (n >= 8) {
+        size_t nw = (n / 8);
+        n %= 8;
+        do {
+            i16x2_f32x2_k_8(i16x2v, f32lv, f32rv, f32k);
+            i16x2v += 16; f32lv += 8; f32rv += 8;
+        } while (--nw);
+    }
+    if (n) {
+        int16_t i16t[16] = { 0 };
+        float f32lt[8], f32rt[8];
+        memcpy(i16t, i16x2v, (n * 2u * sizeof(int16_t)));
+        i16x2_f32x2_k_8(i16t, f32lt, f32rt, f32k);
+        memcpy(f32lv, f32lt, (n * sizeof(float)));
+        memcpy(f32rv, f32rt, (n * sizeof(float)));
+    }
+}
+
+
+void aymo_(f32x2_i16x2_k)(size_t n, const float f32lv[], const float f32rv[], int16_t i16x2v[], float scale)
+{
+    float32x4_t f32k = vdupq_n_f32(scale);
+    if (n >= 8) {
+        size_t nw = (n / 8);
+        n %= 8;
+        do {
+            f32x2_i16x2_k_8(f32lv, f32rv, i16x2v, f32k);
+            f32lv += 8; f32rv += 8; i16x2v += 16;
+        } while (--nw);
+    }
+    if (n) {
+        float f32lt[8] = { 0 }, f32rt[8] = { 0 };
+        int16_t i16t[16];
+        memcpy(f32lt, f32lv, (n * sizeof(float)));
+        memcpy(f32rt, f32rv, (n * sizeof(float)));
+        f32x2_i16x2_k_8(f32lt, f32rt, i16t, f32k);
+        memcpy(i16x2v, i16t, (n * 2u * sizeof(int16_t)));
+    }
+}
+
+
+void aymo_(i16x4_i16x2_k)(size_t n, const int16_t i16x4v[], int16_t i16x2v[], const float k[4])
+{
+    if (n >= 8) {
+        size_t nw = (n / 8);
+        n %= 8;
+        do {
+            i16x4_i16x2_k_8(i16x4v, i16x2v, k);
+            i16x4v += 32; i16x2v += 16;
+        } while (--nw);
+    }
+    if (n) {
+        int16_t i16x4t[32] = { 0 };
+        int16_t i16x2t[16];
+        memcpy(i16x4t, i16x4v, (n * 4u * sizeof(int16_t)));
+        i16x4_i16x2_k_8(i16x4t, i16x2t, k);
+        memcpy(i16x2v, i16x2t, (n * 2u * sizeof(int16_t)));
+    }
+}
+
+
+void aymo_(i16x4_f32x2_k)(size_t n, const int16_t i16x4v[], float f32x2v[], const float k[4])
+{
+    if (n >= 8) {
+        size_t nw = (n / 8);
+        n %= 8;
+        do {
+            i16x4_f32x2_k_8(i16x4v, f32x2v, k);
+            i16x4v += 32; f32x2v += 16;
+        } while (--nw);
+    }
+    if (n) {
+        int16_t i16x4t[32] = { 0 };
+        float f32x2t[16];
+        memcpy(i16x4t, i16x4v, (n * 4u * sizeof(int16_t)));
+        i16x4_f32x2_k_8(i16x4t, f32x2t, k);
+        memcpy(f32x2v, f32x2t, (n * 2u * sizeof(float)));
+    }
+}
+
+
 AYMO_CXX_EXTERN_C_END
 
 #endif  // AYMO_CPU_SUPPORT_ARM_NEON
@@ -20,6 +20,7 @@ You should have received a copy of the GNU Lesser General Public License
 along with AYMO. If not, see <https://www.gnu.org/licenses/>.
 */
 
+#include "aymo_convert.h"
 #define AYMO_KEEP_SHORTHANDS
 #include "aymo_convert_none.h"
 
@@ -62,6 +63,86 @@ static inline uint16_t convert_f32_u16(float f)
 }
 
 
+static inline float convert_i8_f32(int8_t i)
+{
+    return (float)i;
+}
+
+
+static inline int8_t convert_f32_i8(float f)
+{
+    if (f >= (float)INT8_MAX) {
+        return INT8_MAX;
+    }
+    if (f < (float)INT8_MIN) {
+        return INT8_MIN;
+    }
+    return (int8_t)f;
+}
+
+
+static inline float convert_u8_f32(uint8_t u)
+{
+    return (float)u;
+}
+
+
+static inline uint8_t convert_f32_u8(float f)
+{
+    if (f >= (float)UINT8_MAX) {
+        return UINT8_MAX;
+    }
+    if (f < 0.f) {
+        return 0u;
+    }
+    return (uint8_t)f;
+}
+
+
+static inline float convert_i24_f32(const uint8_t i24p[])
+{
+    int32_t i = (int32_t)((uint32_t)i24p[0] | ((uint32_t)i24p[1] << 8) | ((uint32_t)i24p[2] << 16));
+    i -= ((i & 0x800000) << 1);  // sign extension
+    return (float)i;
+}
+
+
+static inline void convert_f32_i24(float f, uint8_t i24p[])
+{
+    int32_t i;
+    if (f >= (float)AYMO_CONVERT_I24_MAX) {
+        i = AYMO_CONVERT_I24_MAX;
+    }
+    else if (f < (float)AYMO_CONVERT_I24_MIN) {
+        i = AYMO_CONVERT_I24_MIN;
+    }
+    else {
+        i = (int32_t)f;
+    }
+    i24p[0] = (uint8_t)((uint32_t)i);
+    i24p[1] = (uint8_t)((uint32_t)i >> 8);
+    i24p[2] = (uint8_t)((uint32_t)i >> 16);
+}
+
+
+static inline float convert_i32_f32(int32_t i)
+{
+    return (float)i;
+}
+
+
+static inline int32_t convert_f32_i32(float f)
+{
+    if (f >= (float)INT32_MAX) {  // rounds up to 2^31
+        return INT32_MAX;
+    }
+    if (f < (float)INT32_MIN) {
+        return INT32_MIN;
+    }
+    return (int32_t)f;
+}
+
+
 void aymo_(i16_f32)(size_t n, const int16_t i16v[], float f32v[])
 {
     const int16_t* i16e = (i16v + n);
@@ -174,4 +255,308 @@ void aymo_(f32_u16_k)(size_t n, const float f32v[], uint16_t u16v[], float scale
 }
 
 
+void aymo_(i8_f32)(size_t n, const int8_t i8v[], float f32v[])
+{
+    aymo_(i8_f32_k)(n, i8v, f32v, 1.f);
+}
+
+
+void aymo_(f32_i8)(size_t n, const float f32v[], int8_t i8v[])
+{
+    aymo_(f32_i8_k)(n, f32v, i8v, 1.f);
+}
+
+
+void aymo_(i8_f32_1)(size_t n, const int8_t i8v[], float f32v[])
+{
+    aymo_(i8_f32_k)(n, i8v, f32v, (float)(1. / 128.));
+}
+
+
+void aymo_(f32_i8_1)(size_t n, const float f32v[], int8_t i8v[])
+{
+    aymo_(f32_i8_k)(n, f32v, i8v, (float)(128.));
+}
+
+
+void aymo_(i8_f32_k)(size_t n, const int8_t i8v[], float f32v[], float scale)
+{
+    const int8_t* i8e = (i8v + n);
+    while (i8v != i8e) {
+        *f32v++ = (convert_i8_f32(*i8v++) * scale);
+    }
+}
+
+
+void aymo_(f32_i8_k)(size_t n, const float f32v[], int8_t i8v[], float scale)
+{
+    const float* f32e = (f32v + n);
+    while (f32v != f32e) {
+        *i8v++ = convert_f32_i8(*f32v++ * scale);
+    }
+}
+
+
+void aymo_(u8_f32)(size_t n, const uint8_t u8v[], float f32v[])
+{
+    aymo_(u8_f32_k)(n, u8v, f32v, 1.f);
+}
+
+
+void aymo_(f32_u8)(size_t n, const float f32v[], uint8_t u8v[])
+{
+    aymo_(f32_u8_k)(n, f32v, u8v, 1.f);
+}
+
+
+void aymo_(u8_f32_1)(size_t n, const uint8_t u8v[], float f32v[])
+{
+    aymo_(u8_f32_k)(n, u8v, f32v, (float)(1. / 128.));
+}
+
+
+void aymo_(f32_u8_1)(size_t n, const float f32v[], uint8_t u8v[])
+{
+    aymo_(f32_u8_k)(n, f32v, u8v, (float)(128.));
+}
+
+
+void aymo_(u8_f32_k)(size_t n, const uint8_t u8v[], float f32v[], float scale)
+{
+    const uint8_t* u8e = (u8v + n);
+    while (u8v != u8e) {
+        *f32v++ = (convert_u8_f32(*u8v++) * scale);
+    }
+}
+
+
+void aymo_(f32_u8_k)(size_t n, const float f32v[], uint8_t u8v[], float scale)
+{
+    const float* f32e = (f32v + n);
+    while (f32v != f32e) {
+        *u8v++ = convert_f32_u8(*f32v++ * scale);
+    }
+}
+
+
+void aymo_(i24_f32)(size_t n, const uint8_t i24v[], float f32v[])
+{
+    aymo_(i24_f32_k)(n, i24v, f32v, 1.f);
+}
+
+
+void aymo_(f32_i24)(size_t n, const float f32v[], uint8_t i24v[])
+{
+    aymo_(f32_i24_k)(n, f32v, i24v, 1.f);
+}
+
+
+void aymo_(i24_f32_1)(size_t n, const uint8_t i24v[], float f32v[])
+{
+    aymo_(i24_f32_k)(n, i24v, f32v, (float)(1. / 8388608.));
+}
+
+
+void aymo_(f32_i24_1)(size_t n, const float f32v[], uint8_t i24v[])
+{
+    aymo_(f32_i24_k)(n, f32v, i24v, (float)(8388608.));
+}
+
+
+void aymo_(i24_f32_k)(size_t n, const uint8_t i24v[], float f32v[], float scale)
+{
+    const uint8_t* i24e = (i24v + (n * 3u));
+    while (i24v != i24e) {
+        *f32v++ = (convert_i24_f32(i24v) * scale);
+        i24v += 3;
+    }
+}
+
+
+void aymo_(f32_i24_k)(size_t n, const float f32v[], uint8_t i24v[], float scale)
+{
+    const float* f32e = (f32v + n);
+    while (f32v != f32e) {
+        convert_f32_i24(*f32v++ * scale, i24v);
+        i24v += 3;
+    }
+}
+
+
+void aymo_(i32_f32)(size_t n, const int32_t i32v[], float f32v[])
+{
+    aymo_(i32_f32_k)(n, i32v, f32v, 1.f);
+}
+
+
+void aymo_(f32_i32)(size_t n, const float f32v[], int32_t i32v[])
+{
+    aymo_(f32_i32_k)(n, f32v, i32v, 1.f);
+}
+
+
+void aymo_(i32_f32_1)(size_t n, const int32_t i32v[], float f32v[])
+{
+    aymo_(i32_f32_k)(n, i32v, f32v, (float)(1. / 2147483648.));
+}
+
+
+void aymo_(f32_i32_1)(size_t n, const float f32v[], int32_t i32v[])
+{
+    aymo_(f32_i32_k)(n, f32v, i32v, (float)(2147483648.));
+}
+
+
+void aymo_(i32_f32_k)(size_t n, const int32_t i32v[], float f32v[], float scale)
+{
+    const int32_t* i32e = (i32v + n);
+    while (i32v != i32e) {
+        *f32v++ = (convert_i32_f32(*i32v++) * scale);
+    }
+}
+
+
+void aymo_(f32_i32_k)(size_t n, const float f32v[], int32_t i32v[], float scale)
+{
+    const float* f32e = (f32v + n);
+    while (f32v != f32e) {
+        *i32v++ = convert_f32_i32(*f32v++ * scale);
+    }
+}
+
+
+void aymo_(f64_f32)(size_t n, const double f64v[], float f32v[])
+{
+    const double* f64e = (f64v + n);
+    while (f64v != f64e) {
+        *f32v++ = (float)*f64v++;
+    }
+}
+
+
+void aymo_(f32_f64)(size_t n, const float f32v[], double f64v[])
+{
+    const float* f32e = (f32v + n);
+    while (f32v != f32e) {
+        *f64v++ = (double)*f32v++;
+    }
+}
+
+
+void aymo_(f64_f32_k)(size_t n, const double f64v[], float f32v[], float scale)
+{
+    const double k = (double)scale;
+    const double* f64e = (f64v + n);
+    while (f64v != f64e) {
+        *f32v++ = (float)(*f64v++ * k);
+    }
+}
+
+
+void aymo_(f32_f64_k)(size_t n, const float f32v[], double f64v[], float scale)
+{
+    const double k = (double)scale;
+    const float* f32e = (f32v + n);
+    while (f32v != f32e) {
+        *f64v++ = ((double)*f32v++ * k);
+    }
+}
+
+
+void aymo_(i16x2_f32x2_k)(size_t n, const int16_t i16x2v[], float f32lv[], float f32rv[], float scale)
+{
+    const int16_t* i16e = (i16x2v + (n * 2u));
+    while (i16x2v != i16e) {
+        *f32lv++ = (convert_i16_f32(*i16x2v++) * scale);
+        *f32rv++ = (convert_i16_f32(*i16x2v++) * scale);
+    }
+}
+
+
+void aymo_(f32x2_i16x2_k)(size_t n, const float f32lv[], const float f32rv[], int16_t i16x2v[], float scale)
+{
+    const float* f32e = (f32lv + n);
+    while (f32lv != f32e) {
+        *i16x2v++ = convert_f32_i16(*f32lv++ * scale);
+        *i16x2v++ = convert_f32_i16(*f32rv++ * scale);
+    }
+}
+
+
+void aymo_(i16x4_i16x2_k)(size_t n, const int16_t i16x4v[], int16_t i16x2v[], const float k[4])
+{
+    const int16_t* i16e = (i16x4v + (n * 4u));
+    while (i16x4v != i16e) {
+        float a = convert_i16_f32(i16x4v[0]);
+        float b = convert_i16_f32(i16x4v[1]);
+        float c = convert_i16_f32(i16x4v[2]);
+        float d = convert_i16_f32(i16x4v[3]);
+        i16x4v += 4;
+        *i16x2v++ = convert_f32_i16((a * k[0]) + (c * k[2]));
+        *i16x2v++ = convert_f32_i16((b * k[1]) + (d * k[3]));
+    }
+}
+
+
+void aymo_(i16x4_f32x2_k)(size_t n, const int16_t i16x4v[], float f32x2v[], const float k[4])
+{
+    const int16_t* i16e = (i16x4v + (n * 4u));
+    while (i16x4v != i16e) {
+        float a = convert_i16_f32(i16x4v[0]);
+        float b = convert_i16_f32(i16x4v[1]);
+        float c = convert_i16_f32(i16x4v[2]);
+        float d = convert_i16_f32(i16x4v[3]);
+        i16x4v += 4;
+        *f32x2v++ = ((a * k[0]) + (c * k[2]));
+        *f32x2v++ = ((b * k[1]) + (d * k[3]));
+    }
+}
+
+
+static inline uint32_t convert_meter_i16(struct aymo_convert_meter* meter, uint32_t ch, int16_t i)
+{
+    int32_t x = i;
+    uint32_t a = (uint32_t)((x < 0) ? -x : x);
+    if (meter->peak[ch] < a) {
+        meter->peak[ch] = a;
+    }
+    meter->sumsq[ch] += (uint64_t)(a * a);
+    return (uint32_t)(i == 0);
+}
+
+
+void aymo_(i16_f32_k_m)(size_t n, const int16_t i16v[], float f32v[], float scale, struct aymo_convert_meter* meter)
+{
+    uint32_t channels = meter->channels;
+    while (n) {
+        size_t nb = ((n < 32u) ? n : 32u);
+        uint32_t zeros = 0u;
+        for (size_t i = 0u; i < nb; ++i) {
+            int16_t x = i16v[i];
+            f32v[i] = (convert_i16_f32(x) * scale);
+            zeros |= (convert_meter_i16(meter, (uint32_t)(i % channels), x) << i);
+        }
+        aymo_convert_meter_zeros(meter, nb, zeros);
+        i16v += nb; f32v += nb; n -= nb;
+    }
+}
+
+
+void aymo_(f32_i16_k_m)(size_t n, const float f32v[], int16_t i16v[], float scale, struct aymo_convert_meter* meter)
+{
+    uint32_t channels = meter->channels;
+    while (n) {
+        size_t nb = ((n < 32u) ? n : 32u);
+        uint32_t zeros = 0u;
+        for (size_t i = 0u; i < nb; ++i) {
+            int16_t x = convert_f32_i16(f32v[i] * scale);
+            i16v[i] = x;
+            zeros |= (convert_meter_i16(meter, (uint32_t)(i % channels), x) << i);
+        }
+        aymo_convert_meter_zeros(meter, nb, zeros);
+        f32v += nb; i16v += nb; n -= nb;
+    }
+}
+
+
 AYMO_CXX_EXTERN_C_END
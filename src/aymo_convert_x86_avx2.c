@@ -23,6 +23,7 @@ along with AYMO. If not, see <https://www.gnu.org/licenses/>.
 #include "aymo_cpu.h"
 #ifdef AYMO_CPU_SUPPORT_X86_AVX2
 
+#include "aymo_convert.h"
 #include "aymo_convert_x86_sse41.h"
 #define AYMO_KEEP_SHORTHANDS
 #include "aymo_convert_x86_avx2.h"
@@ -330,6 +331,767 @@ void aymo_(f32_u16_k)(size_t n, const float f32v[], uint16_t u16v[], float scale
 }
 
 
+// Kernels for other formats, processing blocks of samples.
+// Lane-wise packing needs a final 64-bit permutation to restore the order.
+
+static inline void i8_f32_k_16(const int8_t i8v[], float f32v[], __m256 psk)
+{
+    __m128i epi8 = _mm_loadu_si128((const void*)i8v);
+    __m256i epi32lo = _mm256_cvtepi8_epi32(epi8);
+    __m256i epi32hi = _mm256_cvtepi8_epi32(_mm_srli_si128(epi8, 8));
+    _mm256_storeu_ps((void*)&f32v[0], _mm256_mul_ps(_mm256_cvtepi32_ps(epi32lo), psk));
+    _mm256_storeu_ps((void*)&f32v[8], _mm256_mul_ps(_mm256_cvtepi32_ps(epi32hi), psk));
+}
+
+
+static inline void f32_i8_k_16(const float f32v[], int8_t i8v[], __m256 psk)
+{
+    __m256 psmin = _mm256_set1_ps((float)INT8_MIN);
+    __m256 psmax = _mm256_set1_ps((float)INT8_MAX);
+    __m256 pslo = _mm256_mul_ps(_mm256_loadu_ps((const void*)&f32v[0]), psk);
+    __m256 pshi = _mm256_mul_ps(_mm256_loadu_ps((const void*)&f32v[8]), psk);
+    __m256i epi32lo = _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(pslo, psmin), psmax));
+    __m256i epi32hi = _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(pshi, psmin), psmax));
+    __m256i epi16 = _mm256_packs_epi32(epi32lo, epi32hi);
+    epi16 = _mm256_permute4x64_epi64(epi16, _MM_SHUFFLE(3, 1, 2, 0));
+    __m128i epi8 = _mm_packs_epi16(_mm256_castsi256_si128(epi16), _mm256_extracti128_si256(epi16, 1));
+    _mm_storeu_si128((void*)i8v, epi8);
+}
+
+
+static inline void u8_f32_k_16(const uint8_t u8v[], float f32v[], __m256 psk)
+{
+    __m128i epu8 = _mm_loadu_si128((const void*)u8v);
+    __m256i epi32lo = _mm256_cvtepu8_epi32(epu8);
+    __m256i epi32hi = _mm256_cvtepu8_epi32(_mm_srli_si128(epu8, 8));
+    _mm256_storeu_ps((void*)&f32v[0], _mm256_mul_ps(_mm256_cvtepi32_ps(epi32lo), psk));
+    _mm256_storeu_ps((void*)&f32v[8], _mm256_mul_ps(_mm256_cvtepi32_ps(epi32hi), psk));
+}
+
+
+static inline void f32_u8_k_16(const float f32v[], uint8_t u8v[], __m256 psk)
+{
+    __m256 psmin = _mm256_setzero_ps();
+    __m256 psmax = _mm256_set1_ps((float)UINT8_MAX);
+    __m256 pslo = _mm256_mul_ps(_mm256_loadu_ps((const void*)&f32v[0]), psk);
+    __m256 pshi = _mm256_mul_ps(_mm256_loadu_ps((const void*)&f32v[8]), psk);
+    __m256i epi32lo = _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(pslo, psmin), psmax));
+    __m256i epi32hi = _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(pshi, psmin), psmax));
+    __m256i epu16 = _mm256_packus_epi32(epi32lo, epi32hi);
+    epu16 = _mm256_permute4x64_epi64(epu16, _MM_SHUFFLE(3, 1, 2, 0));
+    __m128i epu8 = _mm_packus_epi16(_mm256_castsi256_si128(epu16), _mm256_extracti128_si256(epu16, 1));
+    _mm_storeu_si128((void*)u8v, epu8);
+}
+
+
+// Packed 24-bit samples: 4 samples per 12 bytes per lane.
+// The last lane is loaded 4 bytes earlier, to avoid reading past the block.
+static inline void i24_f32_k_16(const uint8_t i24v[], float f32v[], __m256 psk)
+{
+    const __m256i expand = _mm256_setr_epi8(
+        -1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11,
+        -1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11
+    );
+    const __m256i expand4 = _mm256_setr_epi8(
+        -1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11,
+        -1, 4, 5, 6, -1, 7, 8, 9, -1, 10, 11, 12, -1, 13, 14, 15
+    );
+    __m256i epi8lo = _mm256_castsi128_si256(_mm_loadu_si128((const void*)&i24v[0]));
+    __m256i epi8hi = _mm256_castsi128_si256(_mm_loadu_si128((const void*)&i24v[24]));
+    epi8lo = _mm256_inserti128_si256(epi8lo, _mm_loadu_si128((const void*)&i24v[12]), 1);
+    epi8hi = _mm256_inserti128_si256(epi8hi, _mm_loadu_si128((const void*)&i24v[32]), 1);
+    __m256i epi32lo = _mm256_srai_epi32(_mm256_shuffle_epi8(epi8lo, expand), 8);
+    __m256i epi32hi = _mm256_srai_epi32(_mm256_shuffle_epi8(epi8hi, expand4), 8);
+    _mm256_storeu_ps((void*)&f32v[0], _mm256_mul_ps(_mm256_cvtepi32_ps(epi32lo), psk));
+    _mm256_storeu_ps((void*)&f32v[8], _mm256_mul_ps(_mm256_cvtepi32_ps(epi32hi), psk));
+}
+
+
+static inline void f32_i24_k_16(const float f32v[], uint8_t i24v[], __m256 psk)
+{
+    const __m256i shrink = _mm256_setr_epi8(
+        0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1,
+        0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1
+    );
+    __m256 psmin = _mm256_set1_ps((float)AYMO_CONVERT_I24_MIN);
+    __m256 psmax = _mm256_set1_ps((float)AYMO_CONVERT_I24_MAX);
+    __m256 pslo = _mm256_mul_ps(_mm256_loadu_ps((const void*)&f32v[0]), psk);
+    __m256 pshi = _mm256_mul_ps(_mm256_loadu_ps((const void*)&f32v[8]), psk);
+    __m256i epi32lo = _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(pslo, psmin), psmax));
+    __m256i epi32hi = _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(pshi, psmin), psmax));
+    __m256i epi8lo = _mm256_shuffle_epi8(epi32lo, shrink);
+    __m256i epi8hi = _mm256_shuffle_epi8(epi32hi, shrink);
+    __m128i epi8a = _mm256_castsi256_si128(epi8lo);
+    __m128i epi8b = _mm256_extracti128_si256(epi8lo, 1);
+    __m128i epi8c = _mm256_castsi256_si128(epi8hi);
+    __m128i epi8d = _mm256_extracti128_si256(epi8hi, 1);
+    epi8a = _mm_or_si128(epi8a, _mm_slli_si128(epi8b, 12));
+    epi8b = _mm_or_si128(_mm_srli_si128(epi8b, 4), _mm_slli_si128(epi8c, 8));
+    epi8c = _mm_or_si128(_mm_srli_si128(epi8c, 8), _mm_slli_si128(epi8d, 4));
+    _mm_storeu_si128((void*)&i24v[0x00], epi8a);
+    _mm_storeu_si128((void*)&i24v[0x10], epi8b);
+    _mm_storeu_si128((void*)&i24v[0x20], epi8c);
+}
+
+
+static inline void i32_f32_k_16(const int32_t i32v[], float f32v[], __m256 psk)
+{
+    __m256i epi32lo = _mm256_loadu_si256((const void*)&i32v[0]);
+    __m256i epi32hi = _mm256_loadu_si256((const void*)&i32v[8]);
+    _mm256_storeu_ps((void*)&f32v[0], _mm256_mul_ps(_mm256_cvtepi32_ps(epi32lo), psk));
+    _mm256_storeu_ps((void*)&f32v[8], _mm256_mul_ps(_mm256_cvtepi32_ps(epi32hi), psk));
+}
+
+
+// Positive overflows turn from INT32_MIN into INT32_MAX
+static inline __m256i mm256_cvtps_epi32_sat(__m256 ps)
+{
+    __m256 psover = _mm256_cmp_ps(ps, _mm256_set1_ps((float)INT32_MAX), _CMP_GE_OQ);
+    return _mm256_xor_si256(_mm256_cvtps_epi32(ps), _mm256_castps_si256(psover));
+}
+
+
+static inline void f32_i32_k_16(const float f32v[], int32_t i32v[], __m256 psk)
+{
+    __m256 pslo = _mm256_mul_ps(_mm256_loadu_ps((const void*)&f32v[0]), psk);
+    __m256 pshi = _mm256_mul_ps(_mm256_loadu_ps((const void*)&f32v[8]), psk);
+    _mm256_storeu_si256((void*)&i32v[0], mm256_cvtps_epi32_sat(pslo));
+    _mm256_storeu_si256((void*)&i32v[8], mm256_cvtps_epi32_sat(pshi));
+}
+
+
+static inline void f64_f32_k_8(const double f64v[], float f32v[], __m256d pdk)
+{
+    __m128 pslo = _mm256_cvtpd_ps(_mm256_mul_pd(_mm256_loadu_pd(&f64v[0]), pdk));
+    __m128 pshi = _mm256_cvtpd_ps(_mm256_mul_pd(_mm256_loadu_pd(&f64v[4]), pdk));
+    _mm256_storeu_ps((void*)f32v, _mm256_insertf128_ps(_mm256_castps128_ps256(pslo), pshi, 1));
+}
+
+
+static inline void f32_f64_k_8(const float f32v[], double f64v[], __m256d pdk)
+{
+    __m256 ps = _mm256_loadu_ps((const void*)f32v);
+    _mm256_storeu_pd(&f64v[0], _mm256_mul_pd(_mm256_cvtps_pd(_mm256_castps256_ps128(ps)), pdk));
+    _mm256_storeu_pd(&f64v[4], _mm256_mul_pd(_mm256_cvtps_pd(_mm256_extractf128_ps(ps, 1)), pdk));
+}
+
+
+void aymo_(i8_f32)(size_t n, const int8_t i8v[], float f32v[])
+{
+    aymo_(i8_f32_k)(n, i8v, f32v, 1.f);
+}
+
+
+void aymo_(f32_i8)(size_t n, const float f32v[], int8_t i8v[])
+{
+    aymo_(f32_i8_k)(n, f32v, i8v, 1.f);
+}
+
+
+void aymo_(i8_f32_1)(size_t n, const int8_t i8v[], float f32v[])
+{
+    aymo_(i8_f32_k)(n, i8v, f32v, (float)(1. / 128.));
+}
+
+
+void aymo_(f32_i8_1)(size_t n, const float f32v[], int8_t i8v[])
+{
+    aymo_(f32_i8_k)(n, f32v, i8v, (float)(128.));
+}
+
+
+void aymo_(i8_f32_k)(size_t n, const int8_t i8v[], float f32v[], float scale)
+{
+    __m256 psk = _mm256_set1_ps(scale);
+    if (n >= 16) {
+        size_t nw = (n / 16);
+        n %= 16;
+        do {
+            i8_f32_k_16(i8v, f32v, psk);
+            i8v += 16; f32v += 16;
+        } while (--nw);
+    }
+    if (n) {
+        aymo_convert_x86_sse41_i8_f32_k(n, i8v, f32v, scale);
+    }
+}
+
+
+void aymo_(f32_i8_k)(size_t n, const float f32v[], int8_t i8v[], float scale)
+{
+    __m256 psk = _mm256_set1_ps(scale);
+    if (n >= 16) {
+        size_t nw = (n / 16);
+        n %= 16;
+        do {
+            f32_i8_k_16(f32v, i8v, psk);
+            f32v += 16; i8v += 16;
+        } while (--nw);
+    }
+    if (n) {
+        aymo_convert_x86_sse41_f32_i8_k(n, f32v, i8v, scale);
+    }
+}
+
+
+void aymo_(u8_f32)(size_t n, const uint8_t u8v[], float f32v[])
+{
+    aymo_(u8_f32_k)(n, u8v, f32v, 1.f);
+}
+
+
+void aymo_(f32_u8)(size_t n, const float f32v[], uint8_t u8v[])
+{
+    aymo_(f32_u8_k)(n, f32v, u8v, 1.f);
+}
+
+
+void aymo_(u8_f32_1)(size_t n, const uint8_t u8v[], float f32v[])
+{
+    aymo_(u8_f32_k)(n, u8v, f32v, (float)(1. / 128.));
+}
+
+
+void aymo_(f32_u8_1)(size_t n, const float f32v[], uint8_t u8v[])
+{
+    aymo_(f32_u8_k)(n, f32v, u8v, (float)(128.));
+}
+
+
+void aymo_(u8_f32_k)(size_t n, const uint8_t u8v[], float f32v[], float scale)
+{
+    __m256 psk = _mm256_set1_ps(scale);
+    if (n >= 16) {
+        size_t nw = (n / 16);
+        n %= 16;
+        do {
+            u8_f32_k_16(u8v, f32v, psk);
+            u8v += 16; f32v += 16;
+        } while (--nw);
+    }
+    if (n) {
+        aymo_convert_x86_sse41_u8_f32_k(n, u8v, f32v, scale);
+    }
+}
+
+
+void aymo_(f32_u8_k)(size_t n, const float f32v[], uint8_t u8v[], float scale)
+{
+    __m256 psk = _mm256_set1_ps(scale);
+    if (n >= 16) {
+        size_t nw = (n / 16);
+        n %= 16;
+        do {
+            f32_u8_k_16(f32v, u8v, psk);
+            f32v += 16; u8v += 16;
+        } while (--nw);
+    }
+    if (n) {
+        aymo_convert_x86_sse41_f32_u8_k(n, f32v, u8v, scale);
+    }
+}
+
+
+void aymo_(i24_f32)(size_t n, const uint8_t i24v[], float f32v[])
+{
+    aymo_(i24_f32_k)(n, i24v, f32v, 1.f);
+}
+
+
+void aymo_(f32_i24)(size_t n, const float f32v[], uint8_t i24v[])
+{
+    aymo_(f32_i24_k)(n, f32v, i24v, 1.f);
+}
+
+
+void aymo_(i24_f32_1)(size_t n, const uint8_t i24v[], float f32v[])
+{
+    aymo_(i24_f32_k)(n, i24v, f32v, (float)(1. / 8388608.));
+}
+
+
+void aymo_(f32_i24_1)(size_t n, const float f32v[], uint8_t i24v[])
+{
+    aymo_(f32_i24_k)(n, f32v, i24v, (float)(8388608.));
+}
+
+
+void aymo_(i24_f32_k)(size_t n, const uint8_t i24v[], float f32v[], float scale)
+{
+    __m256 psk = _mm256_set1_ps(scale);
+    if (n >= 16) {
+        size_t nw = (n / 16);
+        n %= 16;
+        do {
+            i24_f32_k_16(i24v, f32v, psk);
+            i24v += 48; f32v += 16;
+        } while (--nw);
+    }
+    if (n) {
+        aymo_convert_x86_sse41_i24_f32_k(n, i24v, f32v, scale);
+    }
+}
+
+
+void aymo_(f32_i24_k)(size_t n, const float f32v[], uint8_t i24v[], float scale)
+{
+    __m256 psk = _mm256_set1_ps(scale);
+    if (n >= 16) {
+        size_t nw = (n / 16);
+        n %= 16;
+        do {
+            f32_i24_k_16(f32v, i24v, psk);
+            f32v += 16; i24v += 48;
+        } while (--nw);
+    }
+    if (n) {
+        aymo_convert_x86_sse41_f32_i24_k(n, f32v, i24v, scale);
+    }
+}
+
+
+void aymo_(i32_f32)(size_t n, const int32_t i32v[], float f32v[])
+{
+    aymo_(i32_f32_k)(n, i32v, f32v, 1.f);
+}
+
+
+void aymo_(f32_i32)(size_t n, const float f32v[], int32_t i32v[])
+{
+    aymo_(f32_i32_k)(n, f32v, i32v, 1.f);
+}
+
+
+void aymo_(i32_f32_1)(size_t n, const int32_t i32v[], float f32v[])
+{
+    aymo_(i32_f32_k)(n, i32v, f32v, (float)(1. / 2147483648.));
+}
+
+
+void aymo_(f32_i32_1)(size_t n, const float f32v[], int32_t i32v[])
+{
+    aymo_(f32_i32_k)(n, f32v, i32v, (float)(2147483648.));
+}
+
+
+void aymo_(i32_f32_k)(size_t n, const int32_t i32v[], float f32v[], float scale)
+{
+    __m256 psk = _mm256_set1_ps(scale);
+    if (n >= 16) {
+        size_t nw = (n / 16);
+        n %= 16;
+        do {
+            i32_f32_k_16(i32v, f32v, psk);
+            i32v += 16; f32v += 16;
+        } while (--nw);
+    }
+    if (n) {
+        aymo_convert_x86_sse41_i32_f32_k(n, i32v, f32v, scale);
+    }
+}
+
+
+void aymo_(f32_i32_k)(size_t n, const float f32v[], int32_t i32v[], float scale)
+{
+    __m256 psk = _mm256_set1_ps(scale);
+    if (n >= 16) {
+        size_t nw = (n / 16);
+        n %= 16;
+        do {
+            f32_i32_k_16(f32v, i32v, psk);
+            f32v += 16; i32v += 16;
+        } while (--nw);
+    }
+    if (n) {
+        aymo_convert_x86_sse41_f32_i32_k(n, f32v, i32v, scale);
+    }
+}
+
+
+void aymo_(f64_f32)(size_t n, const double f64v[], float f32v[])
+{
+    aymo_(f64_f32_k)(n, f64v, f32v, 1.f);
+}
+
+
+void aymo_(f32_f64)(size_t n, const float f32v[], double f64v[])
+{
+    aymo_(f32_f64_k)(n, f32v, f64v, 1.f);
+}
+
+
+void aymo_(f64_f32_k)(size_t n, const double f64v[], float f32v[], float scale)
+{
+    __m256d pdk = _mm256_set1_pd((double)scale);
+    if (n >= 8) {
+        size_t nw = (n / 8);
+        n %= 8;
+        do {
+            f64_f32_k_8(f64v, f32v, pdk);
+            f64v += 8; f32v += 8;
+        } while (--nw);
+    }
+    if (n) {
+        aymo_convert_x86_sse41_f64_f32_k(n, f64v, f32v, scale);
+    }
+}
+
+
+void aymo_(f32_f64_k)(size_t n, const float f32v[], double f64v[], float scale)
+{
+    __m256d pdk = _mm256_set1_pd((double)scale);
+    if (n >= 8) {
+        size_t nw = (n / 8);
+        n %= 8;
+        do {
+            f32_f64_k_8(f32v, f64v, pdk);
+            f32v += 8; f64v += 8;
+        } while (--nw);
+    }
+    if (n) {
+        aymo_convert_x86_sse41_f32_f64_k(n, f32v, f64v, scale);
+    }
+}
+
+
+// Fused layout kernels, processing 8 frames per step.
+// Lane-wise unpacking keeps the frame order, but for the final 16-bit packing.
+
+static inline void i16x4_lr_8(const int16_t i16x4v[], __m256 psk02, __m256 psk13, __m256* pslrlo, __m256* pslrhi)
+{
+    __m256i epi16lo = _mm256_loadu_si256((const void*)&i16x4v[0]);
+    __m256i epi16hi = _mm256_loadu_si256((const void*)&i16x4v[16]);
+    __m256 psaclo = _mm256_cvtepi32_ps(_mm256_srai_epi32(_mm256_slli_epi32(epi16lo, 16), 16));
+    __m256 psachi = _mm256_cvtepi32_ps(_mm256_srai_epi32(_mm256_slli_epi32(epi16hi, 16), 16));
+    __m256 psbdlo = _mm256_cvtepi32_ps(_mm256_srai_epi32(epi16lo, 16));
+    __m256 psbdhi = _mm256_cvtepi32_ps(_mm256_srai_epi32(epi16hi, 16));
+    psaclo = _mm256_mul_ps(psaclo, psk02);
+    psachi = _mm256_mul_ps(psachi, psk02);
+    psbdlo = _mm256_mul_ps(psbdlo, psk13);
+    psbdhi = _mm256_mul_ps(psbdhi, psk13);
+    __m256 psl = _mm256_hadd_ps(psaclo, psachi);  // L0 L1 L4 L5 | L2 L3 L6 L7
+    __m256 psr = _mm256_hadd_ps(psbdlo, psbdhi);  // R0 R1 R4 R5 | R2 R3 R6 R7
+    *pslrlo = _mm256_unpacklo_ps(psl, psr);  // frames 0..3
+    *pslrhi = _mm256_unpackhi_ps(psl, psr);  // frames 4..7
+}
+
+
+void aymo_(i16x2_f32x2_k)(size_t n, const int16_t i16x2v[], float f32lv[], float f32rv[], float scale)
+{
+    __m256 psk = _mm256_set1_ps(scale);
+    if (n >= 8) {
+        size_t nw = (n / 8);
+        n %= 8;
+        do {
+            __m256i epi16 = _mm256_loadu_si256((const void*)i16x2v); i16x2v += 16;
+            __m256i epi32l = _mm256_srai_epi32(_mm256_slli_epi32(epi16, 16), 16);
+            __m256i epi32r = _mm256_srai_epi32(epi16, 16);
+            __m256 psl = _mm256_mul_ps(_mm256_cvtepi32_ps(epi32l), psk);
+            __m256 psr = _mm256_mul_ps(_mm256_cvtepi32_ps(epi32r), psk);
+            _mm256_storeu_ps((void*)f32lv, psl); f32lv += 8;
+            _mm256_storeu_ps((void*)f32rv, psr); f32rv += 8;
+        } while (--nw);
+    }
+    if (n) {
+        aymo_convert_x86_sse41_i16x2_f32x2_k(n, i16x2v, f32lv, f32rv, scale);
+    }
+}
+
+
+void aymo_(f32x2_i16x2_k)(size_t n, const float f32lv[], const float f32rv[], int16_t i16x2v[], float scale)
+{
+    __m256 psk = _mm256_set1_ps(scale);
+    if (n >= 8) {
+        size_t nw = (n / 8);
+        n %= 8;
+        do {
+            __m256 psl = _mm256_mul_ps(_mm256_loadu_ps((const void*)f32lv), psk); f32lv += 8;
+            __m256 psr = _mm256_mul_ps(_mm256_loadu_ps((const void*)f32rv), psk); f32rv += 8;
+            __m256i epi32lo = _mm256_cvtps_epi32(_mm256_unpacklo_ps(psl, psr));
+            __m256i epi32hi = _mm256_cvtps_epi32(_mm256_unpackhi_ps(psl, psr));
+            __m256i epi16 = _mm256_packs_epi32(epi32lo, epi32hi);
+            _mm256_storeu_si256((void*)i16x2v, epi16); i16x2v += 16;
+        } while (--nw);
+    }
+    if (n) {
+        aymo_convert_x86_sse41_f32x2_i16x2_k(n, f32lv, f32rv, i16x2v, scale);
+    }
+}
+
+
+void aymo_(i16x4_i16x2_k)(size_t n, const int16_t i16x4v[], int16_t i16x2v[], const float k[4])
+{
+    __m256 psk02 = _mm256_setr_ps(k[0], k[2], k[0], k[2], k[0], k[2], k[0], k[2]);
+    __m256 psk13 = _mm256_setr_ps(k[1], k[3], k[1], k[3], k[1], k[3], k[1], k[3]);
+    if (n >= 8) {
+        size_t nw = (n / 8);
+        n %= 8;
+        do {
+            __m256 pslrlo, pslrhi;
+            i16x4_lr_8(i16x4v, psk02, psk13, &pslrlo, &pslrhi); i16x4v += 32;
+            __m256i epi32lo = _mm256_cvtps_epi32(pslrlo);
+            __m256i epi32hi = _mm256_cvtps_epi32(pslrhi);
+            __m256i epi16 = _mm256_packs_epi32(epi32lo, epi32hi);
+            epi16 = _mm256_permute4x64_epi64(epi16, _MM_SHUFFLE(3, 1, 2, 0));
+            _mm256_storeu_si256((void*)i16x2v, epi16); i16x2v += 16;
+        } while (--nw);
+    }
+    if (n) {
+        aymo_convert_x86_sse41_i16x4_i16x2_k(n, i16x4v, i16x2v, k);
+    }
+}
+
+
+void aymo_(i16x4_f32x2_k)(size_t n, const int16_t i16x4v[], float f32x2v[], const float k[4])
+{
+    __m256 psk02 = _mm256_setr_ps(k[0], k[2], k[0], k[2], k[0], k[2], k[0], k[2]);
+    __m256 psk13 = _mm256_setr_ps(k[1], k[3], k[1], k[3], k[1], k[3], k[1], k[3]);
+    if (n >= 8) {
+        size_t nw = (n / 8);
+        n %= 8;
+        do {
+            __m256 pslrlo, pslrhi;
+            i16x4_lr_8(i16x4v, psk02, psk13, &pslrlo, &pslrhi); i16x4v += 32;
+            _mm256_storeu_ps((void*)f32x2v, pslrlo); f32x2v += 8;
+            _mm256_storeu_ps((void*)f32x2v, pslrhi); f32x2v += 8;
+        } while (--nw);
+    }
+    if (n) {
+        aymo_convert_x86_sse41_i16x4_f32x2_k(n, i16x4v, f32x2v, k);
+    }
+}
+
+
+// Metering accumulators, kept in registers for a whole call
+struct convert_meter_acc {
+    __m256i peak;  // epu16 magnitudes
+    __m256i sumsq0;  // epu64, channel 0 (or mono)
+    __m256i sumsq1;  // epu64, channel 1
+};
+
+
+static inline void convert_meter_acc_ctor(struct convert_meter_acc* acc)
+{
+    acc->peak = _mm256_setzero_si256();
+    acc->sumsq0 = _mm256_setzero_si256();
+    acc->sumsq1 = _mm256_setzero_si256();
+}
+
+
+static inline __m256i mm256_sumsq_epu64(__m256i sumsq, __m256i epi16)
+{
+    __m256i z = _mm256_setzero_si256();
+    __m256i epu32 = _mm256_madd_epi16(epi16, epi16);  // up to 2^31, unsigned
+    sumsq = _mm256_add_epi64(sumsq, _mm256_unpacklo_epi32(epu32, z));
+    sumsq = _mm256_add_epi64(sumsq, _mm256_unpackhi_epi32(epu32, z));
+    return sumsq;
+}
+
+
+// Returns the zero sample mask, bit i for sample i
+static inline uint32_t convert_meter_acc_16(struct convert_meter_acc* acc, __m256i epi16, int stereo)
+{
+    __m256i z = _mm256_setzero_si256();
+    acc->peak = _mm256_max_epu16(acc->peak, _mm256_abs_epi16(epi16));
+    if (stereo) {
+        acc->sumsq0 = mm256_sumsq_epu64(acc->sumsq0, _mm256_blend_epi16(epi16, z, 0xAA));
+        acc->sumsq1 = mm256_sumsq_epu64(acc->sumsq1, _mm256_blend_epi16(epi16, z, 0x55));
+    }
+    else {
+        acc->sumsq0 = mm256_sumsq_epu64(acc->sumsq0, epi16);
+    }
+    __m256i zeros = _mm256_packs_epi16(_mm256_cmpeq_epi16(epi16, z), z);  // in-lane
+    uint32_t mask = (uint32_t)_mm256_movemask_epi8(zeros);
+    return ((mask & 0x00FFu) | ((mask >> 8) & 0xFF00u));
+}
+
+
+static inline uint32_t mm_hmax_epu16(__m128i epu16)
+{
+    __m128i ones = _mm_set1_epi16(-1);
+    __m128i minpos = _mm_minpos_epu16(_mm_xor_si128(epu16, ones));
+    return (0xFFFFu - ((uint32_t)_mm_cvtsi128_si32(minpos) & 0xFFFFu));
+}
+
+
+static inline uint64_t mm256_hsum_epu64(__m256i epu64)
+{
+    uint64_t t[2];
+    __m128i sum = _mm_add_epi64(_mm256_castsi256_si128(epu64), _mm256_extracti128_si256(epu64, 1));
+    _mm_storeu_si128((void*)t, sum);
+    return (t[0] + t[1]);
+}
+
+
+static inline void convert_meter_acc_store(const struct convert_meter_acc* acc, struct aymo_convert_meter* meter, int stereo)
+{
+    __m128i z = _mm_setzero_si128();
+    __m128i peak = _mm_max_epu16(_mm256_castsi256_si128(acc->peak), _mm256_extracti128_si256(acc->peak, 1));
+    uint32_t peak0, peak1;
+    if (stereo) {
+        peak0 = mm_hmax_epu16(_mm_blend_epi16(peak, z, 0xAA));
+        peak1 = mm_hmax_epu16(_mm_blend_epi16(peak, z, 0x55));
+        meter->sumsq[1] += mm256_hsum_epu64(acc->sumsq1);
+        if (meter->peak[1] < peak1) {
+            meter->peak[1] = peak1;
+        }
+    }
+    else {
+        peak0 = mm_hmax_epu16(peak);
+    }
+    meter->sumsq[0] += mm256_hsum_epu64(acc->sumsq0);
+    if (meter->peak[0] < peak0) {
+        meter->peak[0] = peak0;
+    }
+}
+
+
+static inline __m256i i16_f32_k_16m(const int16_t i16v[], float f32v[], __m256 psk)
+{
+    __m256i epi16 = _mm256_loadu_si256((const void*)i16v);
+    __m256i epi32lo = _mm256_cvtepi16_epi32(_mm256_castsi256_si128(epi16));
+    __m256i epi32hi = _mm256_cvtepi16_epi32(_mm256_extracti128_si256(epi16, 1));
+    _mm256_storeu_ps(&f32v[0], _mm256_mul_ps(_mm256_cvtepi32_ps(epi32lo), psk));
+    _mm256_storeu_ps(&f32v[8], _mm256_mul_ps(_mm256_cvtepi32_ps(epi32hi), psk));
+    return epi16;
+}
+
+
+static inline __m256i f32_i16_k_16m(const float f32v[], int16_t i16v[], __m256 psk)
+{
+    __m256i epi32lo = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(&f32v[0]), psk));
+    __m256i epi32hi = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(&f32v[8]), psk));
+    __m256i epi16 = _mm256_packs_epi32(epi32lo, epi32hi);
+    epi16 = _mm256_permute4x64_epi64(epi16, _MM_SHUFFLE(3, 1, 2, 0));
+    _mm256_storeu_si256((void*)i16v, epi16);
+    return epi16;
+}
+
+
+// Zero runs are accounted every 32 samples; tails are delegated to SSE4.1
+void aymo_(i16_f32_k_m)(size_t n, const int16_t i16v[], float f32v[], float scale, struct aymo_convert_meter* meter)
+{
+    __m256 psk = _mm256_set1_ps(scale);
+    int stereo = (meter->channels == 2u);
+    struct convert_meter_acc acc;
+    convert_meter_acc_ctor(&acc);
+
+    while (n >= 16u) {
+        size_t nb = ((n < 32u) ? 16u : 32u);
+        uint32_t zeros = convert_meter_acc_16(&acc, i16_f32_k_16m(&i16v[0], &f32v[0], psk), stereo);
+        if (nb == 32u) {
+            zeros |= (convert_meter_acc_16(&acc, i16_f32_k_16m(&i16v[16], &f32v[16], psk), stereo) << 16);
+        }
+        aymo_convert_meter_zeros(meter, nb, zeros);
+        i16v += nb; f32v += nb; n -= nb;
+    }
+    convert_meter_acc_store(&acc, meter, stereo);
+
+    if (n) {
+        aymo_convert_x86_sse41_i16_f32_k_m(n, i16v, f32v, scale, meter);
+    }
+}
+
+
+void aymo_(f32_i16_k_m)(size_t n, const float f32v[], int16_t i16v[], float scale, struct aymo_convert_meter* meter)
+{
+    __m256 psk = _mm256_set1_ps(scale);
+    int stereo = (meter->channels == 2u);
+    struct convert_meter_acc acc;
+    convert_meter_acc_ctor(&acc);
+
+    while (n >= 16u) {
+        size_t nb = ((n < 32u) ? 16u : 32u);
+        uint32_t zeros = convert_meter_acc_16(&acc, f32_i16_k_16m(&f32v[0], &i16v[0], psk), stereo);
+        if (nb == 32u) {
+            zeros |= (convert_meter_acc_16(&acc, f32_i16_k_16m(&f32v[16], &i16v[16], psk), stereo) << 16);
+        }
+        aymo_convert_meter_zeros(meter, nb, zeros);
+        f32v += nb; i16v += nb; n -= nb;
+    }
+    convert_meter_acc_store(&acc, meter, stereo);
+
+    if (n) {
+        aymo_convert_x86_sse41_f32_i16_k_m(n, f32v, i16v, scale, meter);
+    }
+}
+
+
+// Non-temporal stores bypass the caches for outputs too big to be read back
+// soon; the head is peeled with regular stores up to the vector alignment.
+static inline size_t convert_nt_head(const void* p, size_t size, size_t align)
+{
+    uintptr_t addr = (uintptr_t)p;
+    if (addr & (size - 1u)) {
+        return SIZE_MAX;  // never aligned
+    }
+    return (((0u - addr) & (align - 1u)) / size);
+}
+
+
+void aymo_(i16_f32_k_nt)(size_t n, const int16_t i16v[], float f32v[], float scale)
+{
+    size_t head = convert_nt_head(f32v, sizeof(float), 32u);
+    if ((head > n) || ((n - head) < 16)) {
+        aymo_convert_x86_sse41_i16_f32_k(n, i16v, f32v, scale);
+        return;
+    }
+    if (head) {
+        aymo_convert_x86_sse41_i16_f32_k(head, i16v, f32v, scale);
+        i16v += head; f32v += head; n -= head;
+    }
+    __m256 psk = _mm256_set1_ps(scale);
+    size_t nw = (n / 16);
+    n %= 16;
+    do {
+        __m256i epi16 = _mm256_loadu_si256((const void*)i16v); i16v += 16;
+        __m256i epi32lo = _mm256_cvtepi16_epi32(_mm256_extracti128_si256(epi16, 0));
+        __m256i epi32hi = _mm256_cvtepi16_epi32(_mm256_extracti128_si256(epi16, 1));
+        __m256 pslo = _mm256_cvtepi32_ps(epi32lo);
+        __m256 pshi = _mm256_cvtepi32_ps(epi32hi);
+        pslo = _mm256_mul_ps(pslo, psk);
+        pshi = _mm256_mul_ps(pshi, psk);
+        _mm256_stream_ps(f32v, pslo); f32v += 8;
+        _mm256_stream_ps(f32v, pshi); f32v += 8;
+    } while (--nw);
+    _mm_sfence();
+    if (n) {
+        aymo_convert_x86_sse41_i16_f32_k(n, i16v, f32v, scale);
+    }
+}
+
+
+void aymo_(f32_i16_k_nt)(size_t n, const float f32v[], int16_t i16v[], float scale)
+{
+    size_t head = convert_nt_head(i16v, sizeof(int16_t), 32u);
+    if ((head > n) || ((n - head) < 16)) {
+        aymo_convert_x86_sse41_f32_i16_k(n, f32v, i16v, scale);
+        return;
+    }
+    if (head) {
+        aymo_convert_x86_sse41_f32_i16_k(head, f32v, i16v, scale);
+        f32v += head; i16v += head; n -= head;
+    }
+    __m256 psk = _mm256_set1_ps(scale);
+    size_t nw = (n / 16);
+    n %= 16;
+    do {
+        __m256 pslo = _mm256_loadu_ps((const void*)f32v); f32v += 8;
+        __m256 pshi = _mm256_loadu_ps((const void*)f32v); f32v += 8;
+        pslo = _mm256_mul_ps(pslo, psk);
+        pshi = _mm256_mul_ps(pshi, psk);
+        __m256i epi32lo = _mm256_cvtps_epi32(pslo);
+        __m256i epi32hi = _mm256_cvtps_epi32(pshi);
+        __m256i epi16 = _mm256_packs_epi32(epi32lo, epi32hi);
+        epi16 = _mm256_permute4x64_epi64(epi16, _MM_SHUFFLE(3, 1, 2, 0));
+        _mm256_stream_si256((void*)i16v, epi16); i16v += 16;
+    } while (--nw);
+    _mm_sfence();
+    if (n) {
+        aymo_convert_x86_sse41_f32_i16_k(n, f32v, i16v, scale);
+    }
+}
+
 AYMO_CXX_EXTERN_C_END
 
 #endif  // AYMO_CPU_SUPPORT_X86_AVX2
@@ -23,10 +23,12 @@ along with AYMO. If not, see <https://www.gnu.org/licenses/>.
 #include "aymo_cpu.h"
 #ifdef AYMO_CPU_SUPPORT_X86_SSE41
 
+#include "aymo_convert.h"
 #define AYMO_KEEP_SHORTHANDS
 #include "aymo_convert_x86_sse41.h"
 
 #include <immintrin.h>
+#include <string.h>
 
 AYMO_CXX_EXTERN_C_BEGIN
 
@@ -791,6 +793,880 @@ void aymo_(f32_u16_k)(size_t n, const float f32v[], uint16_t u16v[], float scale
 }
 
 
+// Kernels for other formats, processing blocks of samples.
+// Tails are run through zero-padded temporary buffers.
+
+static inline void i8_f32_k_16(const int8_t i8v[], float f32v[], __m128 psk)
+{
+    __m128i epi8 = _mm_loadu_si128((const void*)i8v);
+    __m128i epi32a = _mm_cvtepi8_epi32(epi8);
+    __m128i epi32b = _mm_cvtepi8_epi32(_mm_srli_si128(epi8, 4));
+    __m128i epi32c = _mm_cvtepi8_epi32(_mm_srli_si128(epi8, 8));
+    __m128i epi32d = _mm_cvtepi8_epi32(_mm_srli_si128(epi8, 12));
+    _mm_storeu_ps((void*)&f32v[0x0], _mm_mul_ps(_mm_cvtepi32_ps(epi32a), psk));
+    _mm_storeu_ps((void*)&f32v[0x4], _mm_mul_ps(_mm_cvtepi32_ps(epi32b), psk));
+    _mm_storeu_ps((void*)&f32v[0x8], _mm_mul_ps(_mm_cvtepi32_ps(epi32c), psk));
+    _mm_storeu_ps((void*)&f32v[0xC], _mm_mul_ps(_mm_cvtepi32_ps(epi32d), psk));
+}
+
+
+static inline void f32_i8_k_16(const float f32v[], int8_t i8v[], __m128 psk)
+{
+    __m128 psmin = _mm_set1_ps((float)INT8_MIN);
+    __m128 psmax = _mm_set1_ps((float)INT8_MAX);
+    __m128 psa = _mm_mul_ps(_mm_loadu_ps((const void*)&f32v[0x0]), psk);
+    __m128 psb = _mm_mul_ps(_mm_loadu_ps((const void*)&f32v[0x4]), psk);
+    __m128 psc = _mm_mul_ps(_mm_loadu_ps((const void*)&f32v[0x8]), psk);
+    __m128 psd = _mm_mul_ps(_mm_loadu_ps((const void*)&f32v[0xC]), psk);
+    __m128i epi32a = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(psa, psmin), psmax));
+    __m128i epi32b = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(psb, psmin), psmax));
+    __m128i epi32c = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(psc, psmin), psmax));
+    __m128i epi32d = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(psd, psmin), psmax));
+    __m128i epi16ab = _mm_packs_epi32(epi32a, epi32b);
+    __m128i epi16cd = _mm_packs_epi32(epi32c, epi32d);
+    _mm_storeu_si128((void*)i8v, _mm_packs_epi16(epi16ab, epi16cd));
+}
+
+
+static inline void u8_f32_k_16(const uint8_t u8v[], float f32v[], __m128 psk)
+{
+    __m128i epu8 = _mm_loadu_si128((const void*)u8v);
+    __m128i epi32a = _mm_cvtepu8_epi32(epu8);
+    __m128i epi32b = _mm_cvtepu8_epi32(_mm_srli_si128(epu8, 4));
+    __m128i epi32c = _mm_cvtepu8_epi32(_mm_srli_si128(epu8, 8));
+    __m128i epi32d = _mm_cvtepu8_epi32(_mm_srli_si128(epu8, 12));
+    _mm_storeu_ps((void*)&f32v[0x0], _mm_mul_ps(_mm_cvtepi32_ps(epi32a), psk));
+    _mm_storeu_ps((void*)&f32v[0x4], _mm_mul_ps(_mm_cvtepi32_ps(epi32b), psk));
+    _mm_storeu_ps((void*)&f32v[0x8], _mm_mul_ps(_mm_cvtepi32_ps(epi32c), psk));
+    _mm_storeu_ps((void*)&f32v[0xC], _mm_mul_ps(_mm_cvtepi32_ps(epi32d), psk));
+}
+
+
+static inline void f32_u8_k_16(const float f32v[], uint8_t u8v[], __m128 psk)
+{
+    __m128 psmin = _mm_setzero_ps();
+    __m128 psmax = _mm_set1_ps((float)UINT8_MAX);
+    __m128 psa = _mm_mul_ps(_mm_loadu_ps((const void*)&f32v[0x0]), psk);
+    __m128 psb = _mm_mul_ps(_mm_loadu_ps((const void*)&f32v[0x4]), psk);
+    __m128 psc = _mm_mul_ps(_mm_loadu_ps((const void*)&f32v[0x8]), psk);
+    __m128 psd = _mm_mul_ps(_mm_loadu_ps((const void*)&f32v[0xC]), psk);
+    __m128i epi32a = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(psa, psmin), psmax));
+    __m128i epi32b = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(psb, psmin), psmax));
+    __m128i epi32c = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(psc, psmin), psmax));
+    __m128i epi32d = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(psd, psmin), psmax));
+    __m128i epu16ab = _mm_packus_epi32(epi32a, epi32b);
+    __m128i epu16cd = _mm_packus_epi32(epi32c, epi32d);
+    _mm_storeu_si128((void*)u8v, _mm_packus_epi16(epu16ab, epu16cd));
+}
+
+
+// Packed 24-bit samples: 4 samples per 12 bytes, sign-extended from the top bytes
+static inline __m128 i24_f32_k_4(__m128i epi8, __m128 psk)
+{
+    const __m128i expand = _mm_setr_epi8(-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11);
+    __m128i epi32 = _mm_srai_epi32(_mm_shuffle_epi8(epi8, expand), 8);
+    return _mm_mul_ps(_mm_cvtepi32_ps(epi32), psk);
+}
+
+
+static inline void i24_f32_k_16(const uint8_t i24v[], float f32v[], __m128 psk)
+{
+    __m128i epi8a = _mm_loadu_si128((const void*)&i24v[0x00]);
+    __m128i epi8b = _mm_loadu_si128((const void*)&i24v[0x10]);
+    __m128i epi8c = _mm_loadu_si128((const void*)&i24v[0x20]);
+    _mm_storeu_ps((void*)&f32v[0x0], i24_f32_k_4(epi8a, psk));
+    _mm_storeu_ps((void*)&f32v[0x4], i24_f32_k_4(_mm_alignr_epi8(epi8b, epi8a, 12), psk));
+    _mm_storeu_ps((void*)&f32v[0x8], i24_f32_k_4(_mm_alignr_epi8(epi8c, epi8b, 8), psk));
+    _mm_storeu_ps((void*)&f32v[0xC], i24_f32_k_4(_mm_srli_si128(epi8c, 4), psk));
+}
+
+
+static inline __m128i f32_i24_k_4(const float f32v[], __m128 psk)
+{
+    const __m128i shrink = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+    __m128 psmin = _mm_set1_ps((float)AYMO_CONVERT_I24_MIN);
+    __m128 psmax = _mm_set1_ps((float)AYMO_CONVERT_I24_MAX);
+    __m128 ps = _mm_mul_ps(_mm_loadu_ps((const void*)f32v), psk);
+    __m128i epi32 = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(ps, psmin), psmax));
+    return _mm_shuffle_epi8(epi32, shrink);
+}
+
+
+static inline void f32_i24_k_16(const float f32v[], uint8_t i24v[], __m128 psk)
+{
+    __m128i epi8a = f32_i24_k_4(&f32v[0x0], psk);
+    __m128i epi8b = f32_i24_k_4(&f32v[0x4], psk);
+    __m128i epi8c = f32_i24_k_4(&f32v[0x8], psk);
+    __m128i epi8d = f32_i24_k_4(&f32v[0xC], psk);
+    epi8a = _mm_or_si128(epi8a, _mm_slli_si128(epi8b, 12));
+    epi8b = _mm_or_si128(_mm_srli_si128(epi8b, 4), _mm_slli_si128(epi8c, 8));
+    epi8c = _mm_or_si128(_mm_srli_si128(epi8c, 8), _mm_slli_si128(epi8d, 4));
+    _mm_storeu_si128((void*)&i24v[0x00], epi8a);
+    _mm_storeu_si128((void*)&i24v[0x10], epi8b);
+    _mm_storeu_si128((void*)&i24v[0x20], epi8c);
+}
+
+
+static inline void i32_f32_k_8(const int32_t i32v[], float f32v[], __m128 psk)
+{
+    __m128i epi32lo = _mm_loadu_si128((const void*)&i32v[0]);
+    __m128i epi32hi = _mm_loadu_si128((const void*)&i32v[4]);
+    _mm_storeu_ps((void*)&f32v[0], _mm_mul_ps(_mm_cvtepi32_ps(epi32lo), psk));
+    _mm_storeu_ps((void*)&f32v[4], _mm_mul_ps(_mm_cvtepi32_ps(epi32hi), psk));
+}
+
+
+// Positive overflows turn from INT32_MIN into INT32_MAX
+static inline __m128i cvtps_epi32_sat(__m128 ps)
+{
+    __m128 psover = _mm_cmpge_ps(ps, _mm_set1_ps((float)INT32_MAX));
+    return _mm_xor_si128(_mm_cvtps_epi32(ps), _mm_castps_si128(psover));
+}
+
+
+static inline void f32_i32_k_8(const float f32v[], int32_t i32v[], __m128 psk)
+{
+    __m128 pslo = _mm_mul_ps(_mm_loadu_ps((const void*)&f32v[0]), psk);
+    __m128 pshi = _mm_mul_ps(_mm_loadu_ps((const void*)&f32v[4]), psk);
+    _mm_storeu_si128((void*)&i32v[0], cvtps_epi32_sat(pslo));
+    _mm_storeu_si128((void*)&i32v[4], cvtps_epi32_sat(pshi));
+}
+
+
+static inline void f64_f32_k_4(const double f64v[], float f32v[], __m128d pdk)
+{
+    __m128 pslo = _mm_cvtpd_ps(_mm_mul_pd(_mm_loadu_pd(&f64v[0]), pdk));
+    __m128 pshi = _mm_cvtpd_ps(_mm_mul_pd(_mm_loadu_pd(&f64v[2]), pdk));
+    _mm_storeu_ps((void*)f32v, _mm_movelh_ps(pslo, pshi));
+}
+
+
+static inline void f32_f64_k_4(const float f32v[], double f64v[], __m128d pdk)
+{
+    __m128 ps = _mm_loadu_ps((const void*)f32v);
+    _mm_storeu_pd(&f64v[0], _mm_mul_pd(_mm_cvtps_pd(ps), pdk));
+    _mm_storeu_pd(&f64v[2], _mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(ps, ps)), pdk));
+}
+
+
+void aymo_(i8_f32)(size_t n, const int8_t i8v[], float f32v[])
+{
+    aymo_(i8_f32_k)(n, i8v, f32v, 1.f);
+}
+
+
+void aymo_(f32_i8)(size_t n, const float f32v[], int8_t i8v[])
+{
+    aymo_(f32_i8_k)(n, f32v, i8v, 1.f);
+}
+
+
+void aymo_(i8_f32_1)(size_t n, const int8_t i8v[], float f32v[])
+{
+    aymo_(i8_f32_k)(n, i8v, f32v, (float)(1. / 128.));
+}
+
+
+void aymo_(f32_i8_1)(size_t n, const float f32v[], int8_t i8v[])
+{
+    aymo_(f32_i8_k)(n, f32v, i8v, (float)(128.));
+}
+
+
+void aymo_(i8_f32_k)(size_t n, const int8_t i8v[], float f32v[], float scale)
+{
+    __m128 psk = _mm_set1_ps(scale);
+    if (n >= 16) {
+        size_t nw = (n / 16);
+        n %= 16;
+        do {
+            i8_f32_k_16(i8v, f32v, psk);
+            i8v += 16; f32v += 16;
+        } while (--nw);
+    }
+    if (n) {
+        int8_t i8t[16] = { 0 };
+        float f32t[16];
+        memcpy(i8t, i8v, (n * sizeof(int8_t)));
+        i8_f32_k_16(i8t, f32t, psk);
+        memcpy(f32v, f32t, (n * sizeof(float)));
+    }
+}
+
+
+void aymo_(f32_i8_k)(size_t n, const float f32v[], int8_t i8v[], float scale)
+{
+    __m128 psk = _mm_set1_ps(scale);
+    if (n >= 16) {
+        size_t nw = (n / 16);
+        n %= 16;
+        do {
+            f32_i8_k_16(f32v, i8v, psk);
+            f32v += 16; i8v += 16;
+        } while (--nw);
+    }
+    if (n) {
+        float f32t[16] = { 0 };
+        int8_t i8t[16];
+        memcpy(f32t, f32v, (n * sizeof(float)));
+        f32_i8_k_16(f32t, i8t, psk);
+        memcpy(i8v, i8t, (n * sizeof(int8_t)));
+    }
+}
+
+
+void aymo_(u8_f32)(size_t n, const uint8_t u8v[], float f32v[])
+{
+    aymo_(u8_f32_k)(n, u8v, f32v, 1.f);
+}
+
+
+void aymo_(f32_u8)(size_t n, const float f32v[], uint8_t u8v[])
+{
+    aymo_(f32_u8_k)(n, f32v, u8v, 1.f);
+}
+
+
+void aymo_(u8_f32_1)(size_t n, const uint8_t u8v[], float f32v[])
+{
+    aymo_(u8_f32_k)(n, u8v, f32v, (float)(1. / 128.));
+}
+
+
+void aymo_(f32_u8_1)(size_t n, const float f32v[], uint8_t u8v[])
+{
+    aymo_(f32_u8_k)(n, f32v, u8v, (float)(128.));
+}
+
+
+void aymo_(u8_f32_k)(size_t n, const uint8_t u8v[], float f32v[], float scale)
+{
+    __m128 psk = _mm_set1_ps(scale);
+    if (n >= 16) {
+        size_t nw = (n / 16);
+        n %= 16;
+        do {
+            u8_f32_k_16(u8v, f32v, psk);
+            u8v += 16; f32v += 16;
+        } while (--nw);
+    }
+    if (n) {
+        uint8_t u8t[16] = { 0 };
+        float f32t[16];
+        memcpy(u8t, u8v, (n * sizeof(uint8_t)));
+        u8_f32_k_16(u8t, f32t, psk);
+        memcpy(f32v, f32t, (n * sizeof(float)));
+    }
+}
+
+
+void aymo_(f32_u8_k)(size_t n, const float f32v[], uint8_t u8v[], float scale)
+{
+    __m128 psk = _mm_set1_ps(scale);
+    if (n >= 16) {
+        size_t nw = (n / 16);
+        n %= 16;
+        do {
+            f32_u8_k_16(f32v, u8v, psk);
+            f32v += 16; u8v += 16;
+        } while (--nw);
+    }
+    if (n) {
+        float f32t[16] = { 0 };
+        uint8_t u8t[16];
+        memcpy(f32t, f32v, (n * sizeof(float)));
+        f32_u8_k_16(f32t, u8t, psk);
+        memcpy(u8v, u8t, (n * sizeof(uint8_t)));
+    }
+}
+
+
+void aymo_(i24_f32)(size_t n, const uint8_t i24v[], float f32v[])
+{
+    aymo_(i24_f32_k)(n, i24v, f32v, 1.f);
+}
+
+
+void aymo_(f32_i24)(size_t n, const float f32v[], uint8_t i24v[])
+{
+    aymo_(f32_i24_k)(n, f32v, i24v, 1.f);
+}
+
+
+void aymo_(i24_f32_1)(size_t n, const uint8_t i24v[], float f32v[])
+{
+    aymo_(i24_f32_k)(n, i24v, f32v, (float)(1. / 8388608.));
+}
+
+
+void aymo_(f32_i24_1)(size_t n, const float f32v[], uint8_t i24v[])
+{
+    aymo_(f32_i24_k)(n, f32v, i24v, (float)(8388608.));
+}
+
+
+void aymo_(i24_f32_k)(size_t n, const uint8_t i24v[], float f32v[], float scale)
+{
+    __m128 psk = _mm_set1_ps(scale);
+    if (n >= 16) {
+        size_t nw = (n / 16);
+        n %= 16;
+        do {
+            i24_f32_k_16(i24v, f32v, psk);
+            i24v += 48; f32v += 16;
+        } while (--nw);
+    }
+    if (n) {
+        uint8_t i24t[48] = { 0 };
+        float f32t[16];
+        memcpy(i24t, i24v, (n * 3u * sizeof(uint8_t)));
+        i24_f32_k_16(i24t, f32t, psk);
+        memcpy(f32v, f32t, (n * sizeof(float)));
+    }
+}
+
+
+void aymo_(f32_i24_k)(size_t n, const float f32v[], uint8_t i24v[], float scale)
+{
+    __m128 psk = _mm_set1_ps(scale);
+    if (n >= 16) {
+        size_t nw = (n / 16);
+        n %= 16;
+        do {
+            f32_i24_k_16(f32v, i24v, psk);
+            f32v += 16; i24v += 48;
+        } while (--nw);
+    }
+    if (n) {
+        float f32t[16] = { 0 };
+        uint8_t i24t[48];
+        memcpy(f32t, f32v, (n * sizeof(float)));
+        f32_i24_k_16(f32t, i24t, psk);
+        memcpy(i24v, i24t, (n * 3u * sizeof(uint8_t)));
+    }
+}
+
+
+void aymo_(i32_f32)(size_t n, const int32_t i32v[], float f32v[])
+{
+    aymo_(i32_f32_k)(n, i32v, f32v, 1.f);
+}
+
+
+void aymo_(f32_i32)(size_t n, const float f32v[], int32_t i32v[])
+{
+    aymo_(f32_i32_k)(n, f32v, i32v, 1.f);
+}
+
+
+void aymo_(i32_f32_1)(size_t n, const int32_t i32v[], float f32v[])
+{
+    aymo_(i32_f32_k)(n, i32v, f32v, (float)(1. / 2147483648.));
+}
+
+
+void aymo_(f32_i32_1)(size_t n, const float f32v[], int32_t i32v[])
+{
+    aymo_(f32_i32_k)(n, f32v, i32v, (float)(2147483648.));
+}
+
+
+void aymo_(i32_f32_k)(size_t n, const int32_t i32v[], float f32v[], float scale)
+{
+    __m128 psk = _mm_set1_ps(scale);
+    if (n >= 8) {
+        size_t nw = (n / 8);
+        n %= 8;
+        do {
+            i32_f32_k_8(i32v, f32v, psk);
+            i32v += 8; f32v += 8;
+        } while (--nw);
+    }
+    if (n) {
+        int32_t i32t[8] = { 0 };
+        float f32t[8];
+        memcpy(i32t, i32v, (n * sizeof(int32_t)));
+        i32_f32_k_8(i32t, f32t, psk);
+        memcpy(f32v, f32t, (n * sizeof(float)));
+    }
+}
+
+
+void aymo_(f32_i32_k)(size_t n, const float f32v[], int32_t i32v[], float scale)
+{
+    __m128 psk = _mm_set1_ps(scale);
+    if (n >= 8) {
+        size_t nw = (n / 8);
+        n %= 8;
+        do {
+            f32_i32_k_8(f32v, i32v, psk);
+            f32v += 8; i32v += 8;
+        } while (--nw);
+    }
+    if (n) {
+        float f32t[8] = { 0 };
+        int32_t i32t[8];
+        memcpy(f32t, f32v, (n * sizeof(float)));
+        f32_i32_k_8(f32t, i32t, psk);
+        memcpy(i32v, i32t, (n * sizeof(int32_t)));
+    }
+}
+
+
+void aymo_(f64_f32)(size_t n, const double f64v[], float f32v[])
+{
+    aymo_(f64_f32_k)(n, f64v, f32v, 1.f);
+}
+
+
+void aymo_(f32_f64)(size_t n, const float f32v[], double f64v[])
+{
+    aymo_(f32_f64_k)(n, f32v, f64v, 1.f);
+}
+
+
+void aymo_(f64_f32_k)(size_t n, const double f64v[], float f32v[], float scale)
+{
+    __m128d pdk = _mm_set1_pd((double)scale);
+    if (n >= 4) {
+        size_t nw = (n / 4);
+        n %= 4;
+        do {
+            f64_f32_k_4(f64v, f32v, pdk);
+            f64v += 4; f32v += 4;
+        } while (--nw);
+    }
+    if (n) {
+        double f64t[4] = { 0 };
+        float f32t[4];
+        memcpy(f64t, f64v, (n * sizeof(double)));
+        f64_f32_k_4(f64t, f32t, pdk);
+        memcpy(f32v, f32t, (n * sizeof(float)));
+    }
+}
+
+
+void aymo_(f32_f64_k)(size_t n, const float f32v[], double f64v[], float scale)
+{
+    __m128d pdk = _mm_set1_pd((double)scale);
+    if (n >= 4) {
+        size_t nw = (n / 4);
+        n %= 4;
+        do {
+            f32_f64_k_4(f32v, f64v, pdk);
+            f32v += 4; f64v += 4;
+        } while (--nw);
+    }
+    if (n) {
+        float f32t[4] = { 0 };
+        double f64t[4];
+        memcpy(f32t, f32v, (n * sizeof(float)));
+        f32_f64_k_4(f32t, f64t, pdk);
+        memcpy(f64v, f64t, (n * sizeof(double)));
+    }
+}
+
+
+// Fused layout kernels, processing 4 frames per step.
+// Tails are run through zero-padded temporary buffers.
+
+static inline void i16x2_f32x2_k_4(const int16_t i16x2v[], float f32lv[], float f32rv[], __m128 psk)
+{
+    __m128i epi16 = _mm_loadu_si128((const void*)i16x2v);
+    __m128i epi32l = _mm_srai_epi32(_mm_slli_epi32(epi16, 16), 16);
+    __m128i epi32r = _mm_srai_epi32(epi16, 16);
+    __m128 psl = _mm_mul_ps(_mm_cvtepi32_ps(epi32l), psk);
+    __m128 psr = _mm_mul_ps(_mm_cvtepi32_ps(epi32r), psk);
+    _mm_storeu_ps((void*)f32lv, psl);
+    _mm_storeu_ps((void*)f32rv, psr);
+}
+
+
+static inline void f32x2_i16x2_k_4(const float f32lv[], const float f32rv[], int16_t i16x2v[], __m128 psk)
+{
+    __m128 psl = _mm_mul_ps(_mm_loadu_ps((const void*)f32lv), psk);
+    __m128 psr = _mm_mul_ps(_mm_loadu_ps((const void*)f32rv), psk);
+    __m128i epi32lo = _mm_cvtps_epi32(_mm_unpacklo_ps(psl, psr));
+    __m128i epi32hi = _mm_cvtps_epi32(_mm_unpackhi_ps(psl, psr));
+    __m128i epi16 = _mm_packs_epi32(epi32lo, epi32hi);
+    _mm_storeu_si128((void*)i16x2v, epi16);
+}
+
+
+static inline void i16x4_lr_4(const int16_t i16x4v[], __m128 psk02, __m128 psk13, __m128* pslrlo, __m128* pslrhi)
+{
+    __m128i epi16lo = _mm_loadu_si128((const void*)&i16x4v[0]);  // A0 B0 C0 D0 A1 B1 C1 D1
+    __m128i epi16hi = _mm_loadu_si128((const void*)&i16x4v[8]);  // A2 B2 C2 D2 A3 B3 C3 D3
+    __m128 psaclo = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(epi16lo, 16), 16));
+    __m128 psachi = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(epi16hi, 16), 16));
+    __m128 psbdlo = _mm_cvtepi32_ps(_mm_srai_epi32(epi16lo, 16));
+    __m128 psbdhi = _mm_cvtepi32_ps(_mm_srai_epi32(epi16hi, 16));
+    psaclo = _mm_mul_ps(psaclo, psk02);
+    psachi = _mm_mul_ps(psachi, psk02);
+    psbdlo = _mm_mul_ps(psbdlo, psk13);
+    psbdhi = _mm_mul_ps(psbdhi, psk13);
+    __m128 psl = _mm_hadd_ps(psaclo, psachi);
+    __m128 psr = _mm_hadd_ps(psbdlo, psbdhi);
+    *pslrlo = _mm_unpacklo_ps(psl, psr);
+    *pslrhi = _mm_unpackhi_ps(psl, psr);
+}
+
+
+static inline void i16x4_i16x2_k_4(const int16_t i16x4v[], int16_t i16x2v[], __m128 psk02, __m128 psk13)
+{
+    __m128 pslrlo, pslrhi;
+    i16x4_lr_4(i16x4v, psk02, psk13, &pslrlo, &pslrhi);
+    __m128i epi32lo = _mm_cvtps_epi32(pslrlo);
+    __m128i epi32hi = _mm_cvtps_epi32(pslrhi);
+    __m128i epi16 = _mm_packs_epi32(epi32lo, epi32hi);
+    _mm_storeu_si128((void*)i16x2v, epi16);
+}
+
+
+static inline void i16x4_f32x2_k_4(const int16_t i16x4v[], float f32x2v[], __m128 psk02, __m128 psk13)
+{
+    __m128 pslrlo, pslrhi;
+    i16x4_lr_4(i16x4v, psk02, psk13, &pslrlo, &pslrhi);
+    _mm_storeu_ps((void*)&f32x2v[0], pslrlo);
+    _mm_storeu_ps((void*)&f32x2v[4], pslrhi);
+}
+
+
+void aymo_(i16x2_f32x2_k)(size_t n, const int16_t i16x2v[], float f32lv[], float f32rv[], float scale)
+{
+    __m128 psk = _mm_set1_ps(scale);
+    if (n >= 4) {
+        size_t nw = (n / 4);
+        n %= 4;
+        do {
+            i16x2_f32x2_k_4(i16x2v, f32lv, f32rv, psk);
+            i16x2v += 8; f32lv += 4; f32rv += 4;
+        } while (--nw);
+    }
+    if (n) {
+        int16_t i16t[8] = { 0 };
+        float f32lt[4], f32rt[4];
+        memcpy(i16t, i16x2v, (n * 2u * sizeof(int16_t)));
+        i16x2_f32x2_k_4(i16t, f32lt, f32rt, psk);
+        memcpy(f32lv, f32lt, (n * sizeof(float)));
+        memcpy(f32rv, f32rt, (n * sizeof(float)));
+    }
+}
+
+
+void aymo_(f32x2_i16x2_k)(size_t n, const float f32lv[], const float f32rv[], int16_t i16x2v[], float scale)
+{
+    __m128 psk = _mm_set1_ps(scale);
+    if (n >= 4) {
+        size_t nw = (n / 4);
+        n %= 4;
+        do {
+            f32x2_i16x2_k_4(f32lv, f32rv, i16x2v, psk);
+            f32lv += 4; f32rv += 4; i16x2v += 8;
+        } while (--nw);
+    }
+    if (n) {
+        float f32lt[4] = { 0 }, f32rt[4] = { 0 };
+        int16_t i16t[8];
+        memcpy(f32lt, f32lv, (n * sizeof(float)));
+        memcpy(f32rt, f32rv, (n * sizeof(float)));
+        f32x2_i16x2_k_4(f32lt, f32rt, i16t, psk);
+        memcpy(i16x2v, i16t, (n * 2u * sizeof(int16_t)));
+    }
+}
+
+
+void aymo_(i16x4_i16x2_k)(size_t n, const int16_t i16x4v[], int16_t i16x2v[], const float k[4])
+{
+    __m128 psk02 = _mm_setr_ps(k[0], k[2], k[0], k[2]);
+    __m128 psk13 = _mm_setr_ps(k[1], k[3], k[1], k[3]);
+    if (n >= 4) {
+        size_t nw = (n / 4);
+        n %= 4;
+        do {
+            i16x4_i16x2_k_4(i16x4v, i16x2v, psk02, psk13);
+            i16x4v += 16; i16x2v += 8;
+        } while (--nw);
+    }
+    if (n) {
+        int16_t i16x4t[16] = { 0 };
+        int16_t i16x2t[8];
+        memcpy(i16x4t, i16x4v, (n * 4u * sizeof(int16_t)));
+        i16x4_i16x2_k_4(i16x4t, i16x2t, psk02, psk13);
+        memcpy(i16x2v, i16x2t, (n * 2u * sizeof(int16_t)));
+    }
+}
+
+
+void aymo_(i16x4_f32x2_k)(size_t n, const int16_t i16x4v[], float f32x2v[], const float k[4])
+{
+    __m128 psk02 = _mm_setr_ps(k[0], k[2], k[0], k[2]);
+    __m128 psk13 = _mm_setr_ps(k[1], k[3], k[1], k[3]);
+    if (n >= 4) {
+        size_t nw = (n / 4);
+        n %= 4;
+        do {
+            i16x4_f32x2_k_4(i16x4v, f32x2v, psk02, psk13);
+            i16x4v += 16; f32x2v += 8;
+        } while (--nw);
+    }
+    if (n) {
+        int16_t i16x4t[16] = { 0 };
+        float f32x2t[8];
+        memcpy(i16x4t, i16x4v, (n * 4u * sizeof(int16_t)));
+        i16x4_f32x2_k_4(i16x4t, f32x2t, psk02, psk13);
+        memcpy(f32x2v, f32x2t, (n * 2u * sizeof(float)));
+    }
+}
+
+
+// Metering accumulators, kept in registers for a whole call
+struct convert_meter_acc {
+    __m128i peak;  // epu16 magnitudes
+    __m128i sumsq0;  // epu64, channel 0 (or mono)
+    __m128i sumsq1;  // epu64, channel 1
+};
+
+
+static inline void convert_meter_acc_ctor(struct convert_meter_acc* acc)
+{
+    acc->peak = _mm_setzero_si128();
+    acc->sumsq0 = _mm_setzero_si128();
+    acc->sumsq1 = _mm_setzero_si128();
+}
+
+
+static inline __m128i mm_sumsq_epu64(__m128i sumsq, __m128i epi16)
+{
+    __m128i z = _mm_setzero_si128();
+    __m128i epu32 = _mm_madd_epi16(epi16, epi16);  // up to 2^31, unsigned
+    sumsq = _mm_add_epi64(sumsq, _mm_unpacklo_epi32(epu32, z));
+    sumsq = _mm_add_epi64(sumsq, _mm_unpackhi_epi32(epu32, z));
+    return sumsq;
+}
+
+
+// Returns the zero sample mask, bit i for sample i
+static inline uint32_t convert_meter_acc_8(struct convert_meter_acc* acc, __m128i epi16, int stereo)
+{
+    __m128i z = _mm_setzero_si128();
+    acc->peak = _mm_max_epu16(acc->peak, _mm_abs_epi16(epi16));
+    if (stereo) {
+        acc->sumsq0 = mm_sumsq_epu64(acc->sumsq0, _mm_blend_epi16(epi16, z, 0xAA));
+        acc->sumsq1 = mm_sumsq_epu64(acc->sumsq1, _mm_blend_epi16(epi16, z, 0x55));
+    }
+    else {
+        acc->sumsq0 = mm_sumsq_epu64(acc->sumsq0, epi16);
+    }
+    __m128i zeros = _mm_packs_epi16(_mm_cmpeq_epi16(epi16, z), z);
+    return (uint32_t)_mm_movemask_epi8(zeros);
+}
+
+
+static inline uint32_t mm_hmax_epu16(__m128i epu16)
+{
+    __m128i ones = _mm_set1_epi16(-1);
+    __m128i minpos = _mm_minpos_epu16(_mm_xor_si128(epu16, ones));
+    return (0xFFFFu - ((uint32_t)_mm_cvtsi128_si32(minpos) & 0xFFFFu));
+}
+
+
+static inline uint64_t mm_hsum_epu64(__m128i epu64)
+{
+    uint64_t t[2];
+    _mm_storeu_si128((void*)t, epu64);
+    return (t[0] + t[1]);
+}
+
+
+static inline void convert_meter_acc_store(const struct convert_meter_acc* acc, struct aymo_convert_meter* meter, int stereo)
+{
+    __m128i z = _mm_setzero_si128();
+    uint32_t peak0, peak1;
+    if (stereo) {
+        peak0 = mm_hmax_epu16(_mm_blend_epi16(acc->peak, z, 0xAA));
+        peak1 = mm_hmax_epu16(_mm_blend_epi16(acc->peak, z, 0x55));
+        meter->sumsq[1] += mm_hsum_epu64(acc->sumsq1);
+        if (meter->peak[1] < peak1) {
+            meter->peak[1] = peak1;
+        }
+    }
+    else {
+        peak0 = mm_hmax_epu16(acc->peak);
+    }
+    meter->sumsq[0] += mm_hsum_epu64(acc->sumsq0);
+    if (meter->peak[0] < peak0) {
+        meter->peak[0] = peak0;
+    }
+}
+
+
+static inline __m128i i16_f32_k_8m(const int16_t i16v[], float f32v[], __m128 psk)
+{
+    __m128i epi16 = _mm_loadu_si128((const void*)i16v);
+    __m128i epi32lo = _mm_cvtepi16_epi32(epi16);
+    __m128i epi32hi = _mm_cvtepi16_epi32(_mm_shuffle_epi32(epi16, _MM_SHUFFLE(3, 2, 3, 2)));
+    _mm_storeu_ps(&f32v[0], _mm_mul_ps(_mm_cvtepi32_ps(epi32lo), psk));
+    _mm_storeu_ps(&f32v[4], _mm_mul_ps(_mm_cvtepi32_ps(epi32hi), psk));
+    return epi16;
+}
+
+
+static inline __m128i f32_i16_k_8m(const float f32v[], int16_t i16v[], __m128 psk)
+{
+    __m128 pslo = _mm_mul_ps(_mm_loadu_ps(&f32v[0]), psk);
+    __m128 pshi = _mm_mul_ps(_mm_loadu_ps(&f32v[4]), psk);
+    __m128i epi16 = _mm_packs_epi32(_mm_cvtps_epi32(pslo), _mm_cvtps_epi32(pshi));
+    _mm_storeu_si128((void*)i16v, epi16);
+    return epi16;
+}
+
+
+// Zero runs are accounted every 32 samples; tails go through zero-padded
+// buffers, whose padding is masked out of the zero runs.
+void aymo_(i16_f32_k_m)(size_t n, const int16_t i16v[], float f32v[], float scale, struct aymo_convert_meter* meter)
+{
+    __m128 psk = _mm_set1_ps(scale);
+    int stereo = (meter->channels == 2u);
+    struct convert_meter_acc acc;
+    convert_meter_acc_ctor(&acc);
+
+    while (n) {
+        size_t nb = ((n < 32u) ? n : 32u);
+        uint32_t zeros = 0u;
+        for (size_t i = 0u; i < nb; i += 8u) {
+            __m128i epi16;
+            if ((i + 8u) <= nb) {
+                epi16 = i16_f32_k_8m(&i16v[i], &f32v[i], psk);
+            }
+            else {
+                int16_t i16t[8] = { 0 };
+                float f32t[8];
+                memcpy(i16t, &i16v[i], ((nb - i) * sizeof(int16_t)));
+                epi16 = i16_f32_k_8m(i16t, f32t, psk);
+                memcpy(&f32v[i], f32t, ((nb - i) * sizeof(float)));
+            }
+            zeros |= (convert_meter_acc_8(&acc, epi16, stereo) << i);
+        }
+        if (nb < 32u) {
+            zeros &= (uint32_t)((1uL << nb) - 1u);
+        }
+        aymo_convert_meter_zeros(meter, nb, zeros);
+        i16v += nb; f32v += nb; n -= nb;
+    }
+    convert_meter_acc_store(&acc, meter, stereo);
+}
+
+
+void aymo_(f32_i16_k_m)(size_t n, const float f32v[], int16_t i16v[], float scale, struct aymo_convert_meter* meter)
+{
+    __m128 psk = _mm_set1_ps(scale);
+    int stereo = (meter->channels == 2u);
+    struct convert_meter_acc acc;
+    convert_meter_acc_ctor(&acc);
+
+    while (n) {
+        size_t nb = ((n < 32u) ? n : 32u);
+        uint32_t zeros = 0u;
+        for (size_t i = 0u; i < nb; i += 8u) {
+            __m128i epi16;
+            if ((i + 8u) <= nb) {
+                epi16 = f32_i16_k_8m(&f32v[i], &i16v[i], psk);
+            }
+            else {
+                float f32t[8] = { 0 };
+                int16_t i16t[8];
+                memcpy(f32t, &f32v[i], ((nb - i) * sizeof(float)));
+                epi16 = f32_i16_k_8m(f32t, i16t, psk);
+                memcpy(&i16v[i], i16t, ((nb - i) * sizeof(int16_t)));
+            }
+            zeros |= (convert_meter_acc_8(&acc, epi16, stereo) << i);
+        }
+        if (nb < 32u) {
+            zeros &= (uint32_t)((1uL << nb) - 1u);
+        }
+        aymo_convert_meter_zeros(meter, nb, zeros);
+        f32v += nb; i16v += nb; n -= nb;
+    }
+    convert_meter_acc_store(&acc, meter, stereo);
+}
+
+
+// Non-temporal stores bypass the caches for outputs too big to be read back
+// soon; the head is peeled with regular stores up to the vector alignment.
+static inline size_t convert_nt_head(const void* p, size_t size, size_t align)
+{
+    uintptr_t addr = (uintptr_t)p;
+    if (addr & (size - 1u)) {
+        return SIZE_MAX;  // never aligned
+    }
+    return (((0u - addr) & (align - 1u)) / size);
+}
+
+
+void aymo_(i16_f32_k_nt)(size_t n, const int16_t i16v[], float f32v[], float scale)
+{
+    size_t head = convert_nt_head(f32v, sizeof(float), 16u);
+    if ((head > n) || ((n - head) < 8)) {
+        aymo_(i16_f32_k)(n, i16v, f32v, scale);
+        return;
+    }
+    if (head) {
+        aymo_(i16_f32_k)(head, i16v, f32v, scale);
+        i16v += head; f32v += head; n -= head;
+    }
+    __m128 psk = _mm_set1_ps(scale);
+    size_t nw = (n / 8);
+    n %= 8;
+    do {
+        __m128i epi16 = _mm_loadu_si128((const void*)i16v); i16v += 8;
+        __m128i epi32lo = _mm_cvtepi16_epi32(epi16);
+        epi16 = _mm_shuffle_epi32(epi16, _MM_SHUFFLE(3, 2, 3, 2));
+        __m128i epi32hi = _mm_cvtepi16_epi32(epi16);
+        __m128 pslo = _mm_cvtepi32_ps(epi32lo);
+        __m128 pshi = _mm_cvtepi32_ps(epi32hi);
+        pslo = _mm_mul_ps(pslo, psk);
+        pshi = _mm_mul_ps(pshi, psk);
+        _mm_stream_ps(f32v, pslo); f32v += 4;
+        _mm_stream_ps(f32v, pshi); f32v += 4;
+    } while (--nw);
+    _mm_sfence();
+    if (n) {
+        aymo_(i16_f32_k)(n, i16v, f32v, scale);
+    }
+}
+
+
+void aymo_(f32_i16_k_nt)(size_t n, const float f32v[], int16_t i16v[], float scale)
+{
+    size_t head = convert_nt_head(i16v, sizeof(int16_t), 16u);
+    if ((head > n) || ((n - head) < 8)) {
+        aymo_(f32_i16_k)(n, f32v, i16v, scale);
+        return;
+    }
+    if (head) {
+        aymo_(f32_i16_k)(head, f32v, i16v, scale);
+        f32v += head; i16v += head; n -= head;
+    }
+    __m128 psk = _mm_set1_ps(scale);
+    size_t nw = (n / 8);
+    n %= 8;
+    do {
+        __m128 pslo = _mm_loadu_ps((const void*)f32v); f32v += 4;
+        __m128 pshi = _mm_loadu_ps((const void*)f32v); f32v += 4;
+        pslo = _mm_mul_ps(pslo, psk);
+        pshi = _mm_mul_ps(pshi, psk);
+        __m128i epi32lo = _mm_cvtps_epi32(pslo);
+        __m128i epi32hi = _mm_cvtps_epi32(pshi);
+        __m128i epi16 = _mm_packs_epi32(epi32lo, epi32hi);
+        _mm_stream_si128((void*)i16v, epi16); i16v += 8;
+    } while (--nw);
+    _mm_sfence();
+    if (n) {
+        aymo_(f32_i16_k)(n, f32v, i16v, scale);
+    }
+}
+
 AYMO_CXX_EXTERN_C_END
 
 #endif  // AYMO_CPU_SUPPORT_X86_SSE41
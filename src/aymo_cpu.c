@@ -35,4 +35,28 @@ void aymo_cpu_boot(void)
 }
 
 
+aymo_cpu_fpstate_t aymo_cpu_enter_ftz(void)
+{
+    #if (defined(AYMO_CPU_FAMILY_X86) || defined(AYMO_CPU_FAMILY_X86_64))
+        return (aymo_cpu_fpstate_t)aymo_cpu_x86_enter_ftz();
+    #elif (defined(AYMO_CPU_FAMILY_ARM) || defined(AYMO_CPU_FAMILY_AARCH64))
+        return (aymo_cpu_fpstate_t)aymo_cpu_arm_enter_ftz();
+    #else
+        return 0u;
+    #endif
+}
+
+
+void aymo_cpu_leave_ftz(aymo_cpu_fpstate_t state)
+{
+    #if (defined(AYMO_CPU_FAMILY_X86) || defined(AYMO_CPU_FAMILY_X86_64))
+        aymo_cpu_x86_leave_ftz((uint32_t)state);
+    #elif (defined(AYMO_CPU_FAMILY_ARM) || defined(AYMO_CPU_FAMILY_AARCH64))
+        aymo_cpu_arm_leave_ftz((uint64_t)state);
+    #else
+        AYMO_UNUSED_VAR(state);
+    #endif
+}
+
+
 AYMO_CXX_EXTERN_C_END
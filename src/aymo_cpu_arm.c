@@ -21,6 +21,10 @@ along with AYMO. If not, see <https://www.gnu.org/licenses/>.
 #include "aymo_cpu.h"
 #if (defined(AYMO_CPU_FAMILY_ARM) || defined(AYMO_CPU_FAMILY_AARCH64))
 
+#if (defined(_MSC_VER) && defined(AYMO_CPU_FAMILY_AARCH64))
+    #include <intrin.h>
+#endif
+
 AYMO_CXX_EXTERN_C_BEGIN
 
 
@@ -56,6 +60,82 @@ unsigned aymo_cpu_arm_get_extensions(void)
 }
 
 
+// FPCR (AArch64) / FPSCR (AArch32) access
+#if (defined(AYMO_CPU_FAMILY_AARCH64) && (defined(__GNUC__) || defined(__clang__)))
+    #define AYMO_CPU_ARM_HAVE_FPCR
+
+    static inline uint64_t aymo_cpu_arm_get_fpcr(void)
+    {
+        uint64_t fpcr;
+        __asm__ __volatile__ ("mrs %0, fpcr" : "=r" (fpcr));
+        return fpcr;
+    }
+
+    static inline void aymo_cpu_arm_set_fpcr(uint64_t fpcr)
+    {
+        __asm__ __volatile__ ("msr fpcr, %0" : : "r" (fpcr));
+    }
+
+#elif (defined(AYMO_CPU_FAMILY_AARCH64) && defined(_MSC_VER))
+    #define AYMO_CPU_ARM_HAVE_FPCR
+
+    static inline uint64_t aymo_cpu_arm_get_fpcr(void)
+    {
+        return (uint64_t)_ReadStatusReg(ARM64_FPCR);
+    }
+
+    static inline void aymo_cpu_arm_set_fpcr(uint64_t fpcr)
+    {
+        _WriteStatusReg(ARM64_FPCR, (__int64)fpcr);
+    }
+
+#elif (defined(AYMO_CPU_FAMILY_ARM) && defined(__ARM_FP) && (defined(__GNUC__) || defined(__clang__)))
+    #define AYMO_CPU_ARM_HAVE_FPCR
+
+    static inline uint64_t aymo_cpu_arm_get_fpcr(void)
+    {
+        uint32_t fpscr;
+        __asm__ __volatile__ ("vmrs %0, fpscr" : "=r" (fpscr));
+        return fpscr;
+    }
+
+    static inline void aymo_cpu_arm_set_fpcr(uint64_t fpcr)
+    {
+        uint32_t fpscr = (uint32_t)fpcr;
+        __asm__ __volatile__ ("vmsr fpscr, %0" : : "r" (fpscr));
+    }
+#endif
+
+
+uint64_t aymo_cpu_arm_enter_ftz(void)
+{
+    uint64_t fpcr = 0u;
+
+#ifdef AYMO_CPU_ARM_HAVE_FPCR
+    // FZ also makes inputs flush to zero, so it covers DAZ as well
+    fpcr = aymo_cpu_arm_get_fpcr();
+    uint64_t ftz = (fpcr | AYMO_CPU_ARM_FPCR_FZ);
+    if (ftz != fpcr) {
+        aymo_cpu_arm_set_fpcr(ftz);
+    }
+#endif
+
+    return fpcr;
+}
+
+
+void aymo_cpu_arm_leave_ftz(uint64_t fpcr)
+{
+#ifdef AYMO_CPU_ARM_HAVE_FPCR
+    if (aymo_cpu_arm_get_fpcr() != fpcr) {
+        aymo_cpu_arm_set_fpcr(fpcr);
+    }
+#else
+    AYMO_UNUSED_VAR(fpcr);
+#endif
+}
+
+
 AYMO_CXX_EXTERN_C_END
 
 #endif  // (defined(AYMO_CPU_FAMILY_ARM) || defined(AYMO_CPU_FAMILY_AARCH64))
@@ -29,6 +29,10 @@ along with AYMO. If not, see <https://www.gnu.org/licenses/>.
     #endif
 #endif  // AYMO_CPU_HAVE_CPUINFO
 
+#if defined(_MSC_VER)
+    #include <xmmintrin.h>
+#endif
+
 AYMO_CXX_EXTERN_C_BEGIN
 
 #define AYMO_CPU_X86_CPUID_SSE      (1uL << 25u)  // edx[25] @ leaf 1
@@ -114,6 +118,74 @@ unsigned aymo_cpu_x86_get_extensions(void)
 }
 
 
+// MXCSR access, without requiring SSE code generation
+#if (defined(__GNUC__) || defined(__clang__))
+    #define AYMO_CPU_X86_HAVE_MXCSR
+
+    static inline uint32_t aymo_cpu_x86_get_mxcsr(void)
+    {
+        uint32_t mxcsr;
+        __asm__ __volatile__ ("stmxcsr %0" : "=m" (mxcsr));
+        return mxcsr;
+    }
+
+    static inline void aymo_cpu_x86_set_mxcsr(uint32_t mxcsr)
+    {
+        __asm__ __volatile__ ("ldmxcsr %0" : : "m" (mxcsr));
+    }
+
+#elif defined(_MSC_VER)
+    #define AYMO_CPU_X86_HAVE_MXCSR
+
+    static inline uint32_t aymo_cpu_x86_get_mxcsr(void)
+    {
+        return (uint32_t)_mm_getcsr();
+    }
+
+    static inline void aymo_cpu_x86_set_mxcsr(uint32_t mxcsr)
+    {
+        _mm_setcsr((unsigned)mxcsr);
+    }
+#endif
+
+
+uint32_t aymo_cpu_x86_enter_ftz(void)
+{
+    uint32_t mxcsr = 0u;
+
+#ifdef AYMO_CPU_X86_HAVE_MXCSR
+    if (aymo_cpu_x86_extensions & AYMO_CPU_X86_EXT_SSE) {
+        mxcsr = aymo_cpu_x86_get_mxcsr();
+        uint32_t ftz = (mxcsr | AYMO_CPU_X86_MXCSR_FTZ);
+
+        // DAZ is missing on some early SSE2 CPUs, and setting it there faults
+        if (aymo_cpu_x86_extensions & AYMO_CPU_X86_EXT_SSE3) {
+            ftz |= AYMO_CPU_X86_MXCSR_DAZ;
+        }
+        if (ftz != mxcsr) {
+            aymo_cpu_x86_set_mxcsr(ftz);
+        }
+    }
+#endif
+
+    return mxcsr;
+}
+
+
+void aymo_cpu_x86_leave_ftz(uint32_t mxcsr)
+{
+#ifdef AYMO_CPU_X86_HAVE_MXCSR
+    if (aymo_cpu_x86_extensions & AYMO_CPU_X86_EXT_SSE) {
+        if (aymo_cpu_x86_get_mxcsr() != mxcsr) {
+            aymo_cpu_x86_set_mxcsr(mxcsr);
+        }
+    }
+#else
+    AYMO_UNUSED_VAR(mxcsr);
+#endif
+}
+
+
 AYMO_CXX_EXTERN_C_END
 
 #endif  // (defined(AYMO_CPU_FAMILY_X86) || defined(AYMO_CPU_FAMILY_X86_64))
@@ -52,7 +52,7 @@ int aymo_file_save(const char* pathp, const void* datap, size_t size)
     }
 
     while (total < size) {
-        subsize = fwrite(chunkp, 1u, (total - size), filep);
+        subsize = fwrite(chunkp, 1u, (size - total), filep);
         if (subsize == 0u) {
             perror("fwrite()");
             goto error_;
@@ -61,9 +61,18 @@ int aymo_file_save(const char* pathp, const void* datap, size_t size)
         total += subsize;
         chunkp += subsize;
     }
+
+    if (fclose(filep)) {
+        filep = (FILE*)NULL;
+        perror("fclose()");
+        goto error_;
+    }
     return 0;
 
 error_:
+    if (filep != NULL) {
+        (void)fclose(filep);
+    }
     return 1;
 }
 
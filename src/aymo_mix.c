@@ -0,0 +1,130 @@
+/*
+AYMO - Accelerated YaMaha Operator
+Copyright (c) 2023-2024 Andrea Zoppi.
+
+This file is part of AYMO.
+
+AYMO is free software: you can redistribute it and/or modify it under the
+terms of the GNU Lesser General Public License as published by the Free
+Software Foundation, either version 2.1 of the License, or (at your option)
+any later version.
+
+AYMO is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with AYMO. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "aymo_cpu.h"
+#include "aymo_mix.h"
+#include "aymo_mix_none.h"
+#include "aymo_mix_x86_avx2.h"
+#include "aymo_mix_x86_sse41.h"
+
+AYMO_CXX_EXTERN_C_BEGIN
+
+
+// Dispatcher function types
+typedef void (*aymo_mix_i16_k_f)(size_t n, size_t m, const int16_t* const xv[], const float kv[], int16_t yv[]);
+typedef void (*aymo_mix_i16x2_k_f)(size_t n, size_t m, const int16_t* const xv[], const float kv[], int16_t yv[]);
+typedef void (*aymo_mix_f32_k_f)(size_t n, size_t m, const float* const xv[], const float kv[], float yv[]);
+typedef void (*aymo_mix_f32x2_k_f)(size_t n, size_t m, const float* const xv[], const float kv[], float yv[]);
+typedef void (*aymo_mix_i16_i32_k_f)(size_t n, size_t m, const int16_t* const xv[], const float kv[], int32_t yv[]);
+typedef void (*aymo_mix_i16x2_i32_k_f)(size_t n, size_t m, const int16_t* const xv[], const float kv[], int32_t yv[]);
+typedef void (*aymo_mix_i32_i16_f)(size_t n, const int32_t xv[], int16_t yv[]);
+
+// Dispatcher function pointers
+static aymo_mix_i16_k_f aymo_mix_i16_k_p;
+static aymo_mix_i16x2_k_f aymo_mix_i16x2_k_p;
+static aymo_mix_f32_k_f aymo_mix_f32_k_p;
+static aymo_mix_f32x2_k_f aymo_mix_f32x2_k_p;
+static aymo_mix_i16_i32_k_f aymo_mix_i16_i32_k_p;
+static aymo_mix_i16x2_i32_k_f aymo_mix_i16x2_i32_k_p;
+static aymo_mix_i32_i16_f aymo_mix_i32_i16_p;
+
+
+void aymo_mix_boot(void)
+{
+#ifdef AYMO_CPU_SUPPORT_X86_AVX2
+    if (aymo_cpu_x86_get_extensions() & AYMO_CPU_X86_EXT_AVX2) {
+        aymo_mix_i16_k_p = aymo_mix_x86_avx2_i16_k;
+        aymo_mix_i16x2_k_p = aymo_mix_x86_avx2_i16x2_k;
+        aymo_mix_f32_k_p = aymo_mix_x86_avx2_f32_k;
+        aymo_mix_f32x2_k_p = aymo_mix_x86_avx2_f32x2_k;
+        aymo_mix_i16_i32_k_p = aymo_mix_x86_avx2_i16_i32_k;
+        aymo_mix_i16x2_i32_k_p = aymo_mix_x86_avx2_i16x2_i32_k;
+        aymo_mix_i32_i16_p = aymo_mix_x86_avx2_i32_i16;
+        return;
+    }
+#endif  // AYMO_CPU_SUPPORT_X86_AVX2
+
+#ifdef AYMO_CPU_SUPPORT_X86_SSE41
+    if (aymo_cpu_x86_get_extensions() & AYMO_CPU_X86_EXT_SSE41) {
+        aymo_mix_i16_k_p = aymo_mix_x86_sse41_i16_k;
+        aymo_mix_i16x2_k_p = aymo_mix_x86_sse41_i16x2_k;
+        aymo_mix_f32_k_p = aymo_mix_x86_sse41_f32_k;
+        aymo_mix_f32x2_k_p = aymo_mix_x86_sse41_f32x2_k;
+        aymo_mix_i16_i32_k_p = aymo_mix_x86_sse41_i16_i32_k;
+        aymo_mix_i16x2_i32_k_p = aymo_mix_x86_sse41_i16x2_i32_k;
+        aymo_mix_i32_i16_p = aymo_mix_x86_sse41_i32_i16;
+        return;
+    }
+#endif  // AYMO_CPU_SUPPORT_X86_SSE41
+
+    // Default dispatcher functions
+    aymo_mix_i16_k_p = aymo_mix_none_i16_k;
+    aymo_mix_i16x2_k_p = aymo_mix_none_i16x2_k;
+    aymo_mix_f32_k_p = aymo_mix_none_f32_k;
+    aymo_mix_f32x2_k_p = aymo_mix_none_f32x2_k;
+    aymo_mix_i16_i32_k_p = aymo_mix_none_i16_i32_k;
+    aymo_mix_i16x2_i32_k_p = aymo_mix_none_i16x2_i32_k;
+    aymo_mix_i32_i16_p = aymo_mix_none_i32_i16;
+}
+
+
+void aymo_mix_i16_k(size_t n, size_t m, const int16_t* const xv[], const float kv[], int16_t yv[])
+{
+    aymo_mix_i16_k_p(n, m, xv, kv, yv);
+}
+
+
+void aymo_mix_i16x2_k(size_t n, size_t m, const int16_t* const xv[], const float kv[], int16_t yv[])
+{
+    aymo_mix_i16x2_k_p(n, m, xv, kv, yv);
+}
+
+
+void aymo_mix_f32_k(size_t n, size_t m, const float* const xv[], const float kv[], float yv[])
+{
+    aymo_mix_f32_k_p(n, m, xv, kv, yv);
+}
+
+
+void aymo_mix_f32x2_k(size_t n, size_t m, const float* const xv[], const float kv[], float yv[])
+{
+    aymo_mix_f32x2_k_p(n, m, xv, kv, yv);
+}
+
+
+void aymo_mix_i16_i32_k(size_t n, size_t m, const int16_t* const xv[], const float kv[], int32_t yv[])
+{
+    aymo_mix_i16_i32_k_p(n, m, xv, kv, yv);
+}
+
+
+void aymo_mix_i16x2_i32_k(size_t n, size_t m, const int16_t* const xv[], const float kv[], int32_t yv[])
+{
+    aymo_mix_i16x2_i32_k_p(n, m, xv, kv, yv);
+}
+
+
+void aymo_mix_i32_i16(size_t n, const int32_t xv[], int16_t yv[])
+{
+    aymo_mix_i32_i16_p(n, xv, yv);
+}
+
+
+AYMO_CXX_EXTERN_C_END
@@ -0,0 +1,162 @@
+/*
+AYMO - Accelerated YaMaha Operator
+Copyright (c) 2023-2024 Andrea Zoppi.
+
+This file is part of AYMO.
+
+AYMO is free software: you can redistribute it and/or modify it under the
+terms of the GNU Lesser General Public License as published by the Free
+Software Foundation, either version 2.1 of the License, or (at your option)
+any later version.
+
+AYMO is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with AYMO. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "aymo_mix.h"
+#define AYMO_KEEP_SHORTHANDS
+#include "aymo_mix_none.h"
+
+AYMO_CXX_EXTERN_C_BEGIN
+
+
+static inline int16_t mix_f32_i16(float f)
+{
+    if (f >= (float)INT16_MAX) {
+        return INT16_MAX;
+    }
+    if (f < (float)INT16_MIN) {
+        return INT16_MIN;
+    }
+    return (int16_t)f;
+}
+
+
+static inline int32_t mix_f32_i32(float f)
+{
+    if (f >= (float)INT32_MAX) {  // rounds up to 2^31
+        return INT32_MAX;
+    }
+    if (f < (float)INT32_MIN) {
+        return INT32_MIN;
+    }
+    return (int32_t)f;
+}
+
+
+static inline int32_t mix_add_i32(int32_t a, int32_t b)
+{
+    int64_t s = ((int64_t)a + (int64_t)b);
+    if (s > INT32_MAX) {
+        return INT32_MAX;
+    }
+    if (s < INT32_MIN) {
+        return INT32_MIN;
+    }
+    return (int32_t)s;
+}
+
+
+void aymo_(i16_k)(size_t n, size_t m, const int16_t* const xv[], const float kv[], int16_t yv[])
+{
+    for (size_t i = 0u; i < n; ++i) {
+        float f = 0.f;
+        for (size_t j = 0u; j < m; ++j) {
+            f += ((float)xv[j][i] * kv[j]);
+        }
+        yv[i] = mix_f32_i16(f);
+    }
+}
+
+
+void aymo_(i16x2_k)(size_t n, size_t m, const int16_t* const xv[], const float kv[], int16_t yv[])
+{
+    for (size_t i = 0u; i < (n * 2u); i += 2u) {
+        float fl = 0.f;
+        float fr = 0.f;
+        for (size_t j = 0u; j < m; ++j) {
+            fl += ((float)xv[j][i + 0u] * kv[(j * 2u) + 0u]);
+            fr += ((float)xv[j][i + 1u] * kv[(j * 2u) + 1u]);
+        }
+        yv[i + 0u] = mix_f32_i16(fl);
+        yv[i + 1u] = mix_f32_i16(fr);
+    }
+}
+
+
+void aymo_(f32_k)(size_t n, size_t m, const float* const xv[], const float kv[], float yv[])
+{
+    for (size_t i = 0u; i < n; ++i) {
+        float f = 0.f;
+        for (size_t j = 0u; j < m; ++j) {
+            f += (xv[j][i] * kv[j]);
+        }
+        yv[i] = f;
+    }
+}
+
+
+void aymo_(f32x2_k)(size_t n, size_t m, const float* const xv[], const float kv[], float yv[])
+{
+    for (size_t i = 0u; i < (n * 2u); i += 2u) {
+        float fl = 0.f;
+        float fr = 0.f;
+        for (size_t j = 0u; j < m; ++j) {
+            fl += (xv[j][i + 0u] * kv[(j * 2u) + 0u]);
+            fr += (xv[j][i + 1u] * kv[(j * 2u) + 1u]);
+        }
+        yv[i + 0u] = fl;
+        yv[i + 1u] = fr;
+    }
+}
+
+
+void aymo_(i16_i32_k)(size_t n, size_t m, const int16_t* const xv[], const float kv[], int32_t yv[])
+{
+    for (size_t i = 0u; i < n; ++i) {
+        float f = 0.f;
+        for (size_t j = 0u; j < m; ++j) {
+            f += ((float)xv[j][i] * kv[j]);
+        }
+        yv[i] = mix_add_i32(yv[i], mix_f32_i32(f));
+    }
+}
+
+
+void aymo_(i16x2_i32_k)(size_t n, size_t m, const int16_t* const xv[], const float kv[], int32_t yv[])
+{
+    for (size_t i = 0u; i < (n * 2u); i += 2u) {
+        float fl = 0.f;
+        float fr = 0.f;
+        for (size_t j = 0u; j < m; ++j) {
+            fl += ((float)xv[j][i + 0u] * kv[(j * 2u) + 0u]);
+            fr += ((float)xv[j][i + 1u] * kv[(j * 2u) + 1u]);
+        }
+        yv[i + 0u] = mix_add_i32(yv[i + 0u], mix_f32_i32(fl));
+        yv[i + 1u] = mix_add_i32(yv[i + 1u], mix_f32_i32(fr));
+    }
+}
+
+
+void aymo_(i32_i16)(size_t n, const int32_t xv[], int16_t yv[])
+{
+    const int32_t* xe = (xv + n);
+    while (xv != xe) {
+        int32_t x = *xv++;
+        if (x > INT16_MAX) {
+            x = INT16_MAX;
+        }
+        if (x < INT16_MIN) {
+            x = INT16_MIN;
+        }
+        *yv++ = (int16_t)x;
+    }
+}
+
+
+AYMO_CXX_EXTERN_C_END
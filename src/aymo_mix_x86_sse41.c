@@ -0,0 +1,256 @@
+/*
+AYMO - Accelerated YaMaha Operator
+Copyright (c) 2023-2024 Andrea Zoppi.
+
+This file is part of AYMO.
+
+AYMO is free software: you can redistribute it and/or modify it under the
+terms of the GNU Lesser General Public License as published by the Free
+Software Foundation, either version 2.1 of the License, or (at your option)
+any later version.
+
+AYMO is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with AYMO. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "aymo_cpu.h"
+#ifdef AYMO_CPU_SUPPORT_X86_SSE41
+
+#include "aymo_mix.h"
+#define AYMO_KEEP_SHORTHANDS
+#include "aymo_mix_x86_sse41.h"
+
+#include <immintrin.h>
+
+AYMO_CXX_EXTERN_C_BEGIN
+
+
+// Blocks of 8 samples are accumulated across all the streams within registers.
+// Tail samples go through the same operations in scalar form, so that results
+// do not depend on the buffer length.
+
+
+// Positive overflows turn from INT32_MIN into INT32_MAX
+static inline __m128i cvtps_epi32_sat(__m128 ps)
+{
+    __m128 psover = _mm_cmpge_ps(ps, _mm_set1_ps((float)INT32_MAX));
+    return _mm_xor_si128(_mm_cvtps_epi32(ps), _mm_castps_si128(psover));
+}
+
+
+static inline __m128i cvtps_epi16_sat(__m128 pslo, __m128 pshi)
+{
+    __m128 psmin = _mm_set1_ps((float)INT16_MIN);
+    __m128 psmax = _mm_set1_ps((float)INT16_MAX);
+    pslo = _mm_max_ps(_mm_min_ps(pslo, psmax), psmin);
+    pshi = _mm_max_ps(_mm_min_ps(pshi, psmax), psmin);
+    return _mm_packs_epi32(_mm_cvtps_epi32(pslo), _mm_cvtps_epi32(pshi));
+}
+
+
+// Overflows saturate towards the sign of the operands
+static inline __m128i adds_epi32(__m128i a, __m128i b)
+{
+    __m128i s = _mm_add_epi32(a, b);
+    __m128i over = _mm_and_si128(_mm_xor_si128(s, a), _mm_xor_si128(s, b));
+    __m128i sat = _mm_xor_si128(_mm_srai_epi32(a, 31), _mm_set1_epi32(INT32_MAX));
+    return _mm_castps_si128(_mm_blendv_ps(_mm_castsi128_ps(s), _mm_castsi128_ps(sat), _mm_castsi128_ps(over)));
+}
+
+
+static inline int16_t cvtss_i16_sat(float f)
+{
+    __m128 ps = _mm_set_ss(f);
+    ps = _mm_max_ss(_mm_min_ss(ps, _mm_set_ss((float)INT16_MAX)), _mm_set_ss((float)INT16_MIN));
+    return (int16_t)_mm_cvtss_si32(ps);
+}
+
+
+static inline int32_t cvtss_i32_sat(float f)
+{
+    return _mm_cvtsi128_si32(cvtps_epi32_sat(_mm_set_ss(f)));
+}
+
+
+static inline int32_t adds_i32(int32_t a, int32_t b)
+{
+    int32_t s = (int32_t)((uint32_t)a + (uint32_t)b);
+    if (((s ^ a) & (s ^ b)) < 0) {
+        return ((a < 0) ? INT32_MIN : INT32_MAX);
+    }
+    return s;
+}
+
+
+// Stereo gains as L,R,L,R
+static inline __m128 load_k_x2(const float kv[])
+{
+    return _mm_castpd_ps(_mm_loaddup_pd((const double*)(const void*)kv));
+}
+
+
+static inline void mix_i16_8(
+    size_t m, const int16_t* const xv[], size_t i, const float kv[], size_t ks, __m128* pslo, __m128* pshi
+)
+{
+    __m128 acclo = _mm_setzero_ps();
+    __m128 acchi = _mm_setzero_ps();
+    for (size_t j = 0u; j < m; ++j) {
+        __m128 psk = ((ks == 2u) ? load_k_x2(&kv[j * 2u]) : _mm_set1_ps(kv[j]));
+        __m128i epi16 = _mm_loadu_si128((const void*)&xv[j][i]);
+        __m128 xlo = _mm_cvtepi32_ps(_mm_cvtepi16_epi32(epi16));
+        __m128 xhi = _mm_cvtepi32_ps(_mm_cvtepi16_epi32(_mm_unpackhi_epi64(epi16, epi16)));
+        acclo = _mm_add_ps(acclo, _mm_mul_ps(xlo, psk));
+        acchi = _mm_add_ps(acchi, _mm_mul_ps(xhi, psk));
+    }
+    *pslo = acclo;
+    *pshi = acchi;
+}
+
+
+static inline void mix_f32_8(
+    size_t m, const float* const xv[], size_t i, const float kv[], size_t ks, __m128* pslo, __m128* pshi
+)
+{
+    __m128 acclo = _mm_setzero_ps();
+    __m128 acchi = _mm_setzero_ps();
+    for (size_t j = 0u; j < m; ++j) {
+        __m128 psk = ((ks == 2u) ? load_k_x2(&kv[j * 2u]) : _mm_set1_ps(kv[j]));
+        acclo = _mm_add_ps(acclo, _mm_mul_ps(_mm_loadu_ps(&xv[j][i + 0u]), psk));
+        acchi = _mm_add_ps(acchi, _mm_mul_ps(_mm_loadu_ps(&xv[j][i + 4u]), psk));
+    }
+    *pslo = acclo;
+    *pshi = acchi;
+}
+
+
+// Sample i of stream j has gain kv[(j * ks) + (i % ks)]
+static inline float mix_i16_1(size_t m, const int16_t* const xv[], size_t i, const float kv[], size_t ks)
+{
+    float f = 0.f;
+    for (size_t j = 0u; j < m; ++j) {
+        f += ((float)xv[j][i] * kv[(j * ks) + (i % ks)]);
+    }
+    return f;
+}
+
+
+static inline float mix_f32_1(size_t m, const float* const xv[], size_t i, const float kv[], size_t ks)
+{
+    float f = 0.f;
+    for (size_t j = 0u; j < m; ++j) {
+        f += (xv[j][i] * kv[(j * ks) + (i % ks)]);
+    }
+    return f;
+}
+
+
+static inline void mix_i16_ks(size_t n, size_t m, const int16_t* const xv[], const float kv[], int16_t yv[], size_t ks)
+{
+    size_t i = 0u;
+    for (; (i + 8u) <= n; i += 8u) {
+        __m128 pslo, pshi;
+        mix_i16_8(m, xv, i, kv, ks, &pslo, &pshi);
+        _mm_storeu_si128((void*)&yv[i], cvtps_epi16_sat(pslo, pshi));
+    }
+    for (; i < n; ++i) {
+        yv[i] = cvtss_i16_sat(mix_i16_1(m, xv, i, kv, ks));
+    }
+}
+
+
+static inline void mix_f32_ks(size_t n, size_t m, const float* const xv[], const float kv[], float yv[], size_t ks)
+{
+    size_t i = 0u;
+    for (; (i + 8u) <= n; i += 8u) {
+        __m128 pslo, pshi;
+        mix_f32_8(m, xv, i, kv, ks, &pslo, &pshi);
+        _mm_storeu_ps(&yv[i + 0u], pslo);
+        _mm_storeu_ps(&yv[i + 4u], pshi);
+    }
+    for (; i < n; ++i) {
+        yv[i] = mix_f32_1(m, xv, i, kv, ks);
+    }
+}
+
+
+static inline void mix_i16_i32_ks(size_t n, size_t m, const int16_t* const xv[], const float kv[], int32_t yv[], size_t ks)
+{
+    size_t i = 0u;
+    for (; (i + 8u) <= n; i += 8u) {
+        __m128 pslo, pshi;
+        mix_i16_8(m, xv, i, kv, ks, &pslo, &pshi);
+        __m128i ylo = _mm_loadu_si128((const void*)&yv[i + 0u]);
+        __m128i yhi = _mm_loadu_si128((const void*)&yv[i + 4u]);
+        _mm_storeu_si128((void*)&yv[i + 0u], adds_epi32(ylo, cvtps_epi32_sat(pslo)));
+        _mm_storeu_si128((void*)&yv[i + 4u], adds_epi32(yhi, cvtps_epi32_sat(pshi)));
+    }
+    for (; i < n; ++i) {
+        yv[i] = adds_i32(yv[i], cvtss_i32_sat(mix_i16_1(m, xv, i, kv, ks)));
+    }
+}
+
+
+void aymo_(i16_k)(size_t n, size_t m, const int16_t* const xv[], const float kv[], int16_t yv[])
+{
+    mix_i16_ks(n, m, xv, kv, yv, 1u);
+}
+
+
+void aymo_(i16x2_k)(size_t n, size_t m, const int16_t* const xv[], const float kv[], int16_t yv[])
+{
+    mix_i16_ks((n * 2u), m, xv, kv, yv, 2u);
+}
+
+
+void aymo_(f32_k)(size_t n, size_t m, const float* const xv[], const float kv[], float yv[])
+{
+    mix_f32_ks(n, m, xv, kv, yv, 1u);
+}
+
+
+void aymo_(f32x2_k)(size_t n, size_t m, const float* const xv[], const float kv[], float yv[])
+{
+    mix_f32_ks((n * 2u), m, xv, kv, yv, 2u);
+}
+
+
+void aymo_(i16_i32_k)(size_t n, size_t m, const int16_t* const xv[], const float kv[], int32_t yv[])
+{
+    mix_i16_i32_ks(n, m, xv, kv, yv, 1u);
+}
+
+
+void aymo_(i16x2_i32_k)(size_t n, size_t m, const int16_t* const xv[], const float kv[], int32_t yv[])
+{
+    mix_i16_i32_ks((n * 2u), m, xv, kv, yv, 2u);
+}
+
+
+void aymo_(i32_i16)(size_t n, const int32_t xv[], int16_t yv[])
+{
+    if (n >= 8u) {
+        size_t nw = (n / 8u);
+        n %= 8u;
+        do {
+            __m128i lo = _mm_loadu_si128((const void*)&xv[0]);
+            __m128i hi = _mm_loadu_si128((const void*)&xv[4]);
+            _mm_storeu_si128((void*)yv, _mm_packs_epi32(lo, hi));
+            xv += 8u; yv += 8u;
+        } while (--nw);
+    }
+    while (n--) {
+        int32_t x = *xv++;
+        *yv++ = (int16_t)((x > INT16_MAX) ? INT16_MAX : ((x < INT16_MIN) ? INT16_MIN : x));
+    }
+}
+
+
+AYMO_CXX_EXTERN_C_END
+
+#endif  // AYMO_CPU_SUPPORT_X86_SSE41
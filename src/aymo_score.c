@@ -103,6 +103,364 @@ uint32_t aymo_score_tick(
 }
 
 
+void aymo_score_get_checkpoint(
+    struct aymo_score_instance* score,
+    struct aymo_score_checkpoint* checkpoint
+)
+{
+    assert(score);
+    assert(score->vt);
+    assert(checkpoint);
+    score->vt->get_checkpoint(score, checkpoint);
+}
+
+
+void aymo_score_set_checkpoint(
+    struct aymo_score_instance* score,
+    const struct aymo_score_checkpoint* checkpoint
+)
+{
+    assert(score);
+    assert(score->vt);
+    assert(checkpoint);
+    score->vt->set_checkpoint(score, checkpoint);
+}
+
+
+uint32_t aymo_score_index_build(
+    struct aymo_score_instance* score,
+    struct aymo_score_checkpoint index[],
+    uint32_t capacity,
+    uint32_t period
+)
+{
+    assert(score);
+    assert(score->vt);
+    assert(!capacity || index);
+    assert(period);
+
+    struct aymo_score_status* status = aymo_score_get_status(score);
+    uint32_t length = 0u;
+    uint32_t elapsed = 0u;
+    uint32_t next = 0u;
+
+    aymo_score_restart(score);
+
+    while ((length < capacity) && !(status->flags & AYMO_SCORE_FLAG_EOF)) {
+        if (elapsed >= next) {
+            aymo_score_get_checkpoint(score, &index[length]);
+            index[length].time = elapsed;
+            ++length;
+
+            if (elapsed > (UINT32_MAX - period)) {
+                break;
+            }
+            next = (elapsed + period);
+        }
+        elapsed += aymo_score_tick(score, (next - elapsed));
+    }
+
+    aymo_score_restart(score);
+    return length;
+}
+
+
+// Ticks up to the target time, consuming all the events found there
+static uint32_t aymo_score_advance(
+    struct aymo_score_instance* score,
+    uint32_t elapsed,
+    uint32_t time,
+    uint8_t regs[],
+    uint8_t written[]
+)
+{
+    struct aymo_score_status* status = aymo_score_get_status(score);
+
+    while (!(status->flags & AYMO_SCORE_FLAG_EOF)) {
+        if ((elapsed >= time) && (status->flags & AYMO_SCORE_FLAG_DELAY)) {
+            break;
+        }
+        elapsed += aymo_score_tick(score, (time - elapsed));
+
+        if (status->flags & AYMO_SCORE_FLAG_EVENT) {
+            uint16_t address = status->address;
+            if (regs && (address < AYMO_YMF262_REG_NUM)) {
+                regs[address] = status->value;
+                if (written) {
+                    written[address >> 3u] |= (uint8_t)(1u << (address & 7u));
+                }
+            }
+        }
+    }
+    return elapsed;
+}
+
+
+uint32_t aymo_score_seek(
+    struct aymo_score_instance* score,
+    const struct aymo_score_checkpoint index[],
+    uint32_t length,
+    uint32_t time
+)
+{
+    assert(score);
+    assert(score->vt);
+    assert(!length || index);
+
+    uint32_t elapsed = 0u;
+    aymo_score_restart(score);
+
+    if (length && (index[0].time <= time)) {
+        // Binary search of the last checkpoint not after the target time
+        uint32_t lo = 0u;
+        uint32_t hi = length;
+        while ((hi - lo) > 1u) {
+            uint32_t mid = (lo + ((hi - lo) / 2u));
+            if (index[mid].time <= time) {
+                lo = mid;
+            }
+            else {
+                hi = mid;
+            }
+        }
+        aymo_score_set_checkpoint(score, &index[lo]);
+        elapsed = index[lo].time;
+    }
+
+    return aymo_score_advance(score, elapsed, time, NULL, NULL);
+}
+
+
+uint32_t aymo_score_scan_registers(
+    struct aymo_score_instance* score,
+    uint32_t time,
+    uint8_t regs[AYMO_YMF262_REG_NUM],
+    uint8_t written[AYMO_YMF262_REG_NUM / 8u]
+)
+{
+    assert(score);
+    assert(score->vt);
+    assert(regs);
+
+    if (written) {
+        aymo_memset(written, 0, (AYMO_YMF262_REG_NUM / 8u));
+    }
+
+    aymo_score_restart(score);
+    return aymo_score_advance(score, 0u, time, regs, written);
+}
+
+
+// YMF262 channel index driven by a register, -1 if none
+static int aymo_score_address_to_channel(uint16_t address)
+{
+    unsigned lo = (address & 0xFFu);
+    int channel = -1;
+
+    if (((lo >= 0x20u) && (lo < 0xA0u)) || (lo >= 0xE0u)) {
+        unsigned subaddr = (lo & 0x1Fu);
+        if ((subaddr < 0x16u) && ((subaddr & 7u) < 6u)) {
+            channel = (int)(((subaddr >> 3u) * 3u) + ((subaddr & 7u) % 3u));
+        }
+    }
+    else if ((lo >= 0xA0u) && (lo < 0xD0u) && (lo != 0xBDu)) {
+        unsigned subaddr = (lo & 0x0Fu);
+        if (subaddr < 9u) {
+            channel = (int)subaddr;
+        }
+    }
+
+    if ((channel >= 0) && (address & 0x100u)) {
+        channel += 9;
+    }
+    return channel;
+}
+
+
+// Tells whether a register has audible effects on a standard YMF262
+static int aymo_score_is_audible(uint16_t address)
+{
+    switch (address) {
+        case 0x008u:
+        case 0x0BDu:
+        case 0x104u:
+        case 0x105u: return 1;
+        default: return (aymo_score_address_to_channel(address) >= 0);
+    }
+}
+
+
+// Flags as not known the registers of a 16-address page, in both banks
+static void aymo_score_forget_page(uint8_t known[], unsigned page)
+{
+    known[(page >> 3u) + 0u] = 0u;
+    known[(page >> 3u) + 1u] = 0u;
+    known[((page + 0x100u) >> 3u) + 0u] = 0u;
+    known[((page + 0x100u) >> 3u) + 1u] = 0u;
+}
+
+
+// Scans the whole score for features affecting the optimization passes
+static void aymo_score_optimize_prescan(
+    struct aymo_score_instance* score,
+    uint32_t* keyed,
+    int* extended
+)
+{
+    struct aymo_score_status* status = aymo_score_get_status(score);
+    uint32_t keyed_ = 0u;
+    int extended_ = 0;
+
+    aymo_score_restart(score);
+
+    while (!(status->flags & AYMO_SCORE_FLAG_EOF)) {
+        aymo_score_tick(score, ((status->flags & AYMO_SCORE_FLAG_DELAY) ? status->delay : 0u));
+
+        if (status->flags & AYMO_SCORE_FLAG_EVENT) {
+            uint16_t address = status->address;
+            uint8_t value = status->value;
+
+            if ((address & 0xF0u) == 0xB0u) {
+                if (address == 0x0BDu) {
+                    if ((value & 0x20u) && (value & 0x1Fu)) {
+                        keyed_ |= 0x1C0u;  // rhythm channels
+                    }
+                }
+                else if (value & 0x20u) {
+                    int channel = aymo_score_address_to_channel(address);
+                    if (channel >= 0) {
+                        // Pessimistic 4-operator pairing
+                        int local = (channel % 9);
+                        int paired = ((local < 3) ? (channel + 3) : ((local < 6) ? (channel - 3) : channel));
+                        keyed_ |= ((1uL << channel) | (1uL << paired));
+                    }
+                }
+            }
+            else if (address == 0x008u) {
+                if (value & 0x80u) {
+                    keyed_ = 0x3FFFFu;  // CSM keys all the channels
+                }
+            }
+            else if (address == 0x105u) {
+                if (value & 0xFEu) {
+                    extended_ = 1;  // non-standard registers may be audible
+                }
+            }
+        }
+    }
+
+    *keyed = keyed_;
+    *extended = extended_;
+}
+
+
+uint32_t aymo_score_optimize(
+    struct aymo_score_instance* score,
+    unsigned passes,
+    struct aymo_score_event events[],
+    uint32_t capacity,
+    struct aymo_score_optimize_stats* stats
+)
+{
+    assert(score);
+    assert(score->vt);
+    assert(!capacity || events);
+
+    struct aymo_score_optimize_stats stats_;
+    aymo_memset(&stats_, 0, sizeof(stats_));
+
+    uint32_t keyed = 0x3FFFFu;
+    int extended = 0;
+    if (passes & (AYMO_SCORE_OPTIMIZE_INAUDIBLE | AYMO_SCORE_OPTIMIZE_SILENT)) {
+        aymo_score_optimize_prescan(score, &keyed, &extended);
+        if (extended) {
+            passes &= ~(AYMO_SCORE_OPTIMIZE_INAUDIBLE | AYMO_SCORE_OPTIMIZE_SILENT);
+        }
+    }
+
+    // Shadow register file, as seen by the chip after reset
+    uint8_t regs[AYMO_YMF262_REG_NUM];
+    uint8_t known[AYMO_YMF262_REG_NUM / 8u];
+    aymo_memset(regs, 0, sizeof(regs));
+    aymo_memset(known, 0xFF, sizeof(known));
+    aymo_score_forget_page(known, 0xC0u);  // reset value depends on NEW
+
+    struct aymo_score_status* status = aymo_score_get_status(score);
+    uint32_t length = 0u;
+    uint32_t pending = 0u;
+
+    aymo_score_restart(score);
+
+    while (!(status->flags & AYMO_SCORE_FLAG_EOF)) {
+        uint32_t delay = ((status->flags & AYMO_SCORE_FLAG_DELAY) ? status->delay : 0u);
+        aymo_score_tick(score, delay);
+        stats_.length += delay;
+        pending += delay;
+
+        if (!(status->flags & AYMO_SCORE_FLAG_EVENT)) {
+            continue;
+        }
+        uint16_t address = status->address;
+        uint8_t value = status->value;
+        stats_.events_in++;
+
+        if (address >= AYMO_YMF262_REG_NUM) {
+            stats_.inaudible++;
+            continue;
+        }
+        if ((passes & AYMO_SCORE_OPTIMIZE_INAUDIBLE) && !aymo_score_is_audible(address)) {
+            stats_.inaudible++;
+            continue;
+        }
+        if (passes & AYMO_SCORE_OPTIMIZE_SILENT) {
+            int channel = aymo_score_address_to_channel(address);
+            if ((channel >= 0) && !(keyed & (1uL << channel))) {
+                stats_.silent++;
+                continue;
+            }
+        }
+
+        uint8_t mask = (uint8_t)(1u << (address & 7u));
+        if ((passes & AYMO_SCORE_OPTIMIZE_REDUNDANT) &&
+            (known[address >> 3u] & mask) && (regs[address] == value)) {
+            stats_.redundant++;
+            continue;
+        }
+
+        if ((address == 0x104u) || (address == 0x105u)) {
+            if (!(known[address >> 3u] & mask) || (regs[address] != value)) {
+                // Channel setup may be applied differently after pairing or mode changes
+                aymo_score_forget_page(known, 0xA0u);
+                aymo_score_forget_page(known, 0xB0u);
+                aymo_score_forget_page(known, 0xC0u);
+                aymo_score_forget_page(known, 0xE0u);
+                aymo_score_forget_page(known, 0xF0u);
+            }
+        }
+        regs[address] = value;
+        known[address >> 3u] |= mask;
+
+        if (length < capacity) {
+            events[length].delay = pending;
+            events[length].address = address;
+            events[length].value = value;
+            events[length].reserved_ = 0u;
+            ++length;
+        }
+        stats_.events_out++;
+        pending = 0u;
+    }
+    stats_.tail = pending;
+
+    aymo_score_restart(score);
+
+    if (stats) {
+        *stats = stats_;
+    }
+    return length;
+}
+
+
 enum aymo_score_type aymo_score_ext_to_type(
     const char *tag
 )
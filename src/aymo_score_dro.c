@@ -33,7 +33,9 @@ const struct aymo_score_vt aymo_score_dro_vt = {
     (aymo_score_unload_f)aymo_score_dro_unload,
     (aymo_score_get_status_f)aymo_score_dro_get_status,
     (aymo_score_restart_f)aymo_score_dro_restart,
-    (aymo_score_tick_f)aymo_score_dro_tick
+    (aymo_score_tick_f)aymo_score_dro_tick,
+    (aymo_score_get_checkpoint_f)aymo_score_dro_get_checkpoint,
+    (aymo_score_set_checkpoint_f)aymo_score_dro_set_checkpoint
 };
 
 
@@ -309,9 +311,9 @@ static void aymo_score_dro_decode_v2(
         score->parent.status.delay = (((ptr[1] + 1uL) * 256u) * score->division);
         score->parent.status.flags = AYMO_SCORE_FLAG_DELAY;
     }
-    else if ((ptr[0] & 0xFFu) < v2_header->codemap_length) {
+    else if ((ptr[0] & 0x7Fu) < v2_header->codemap_length) {
         score->address_hi = ((ptr[0] & 0x80u) >> 7u);
-        uint8_t address_lo = score->codemap[ptr[0] & 0xFFu];
+        uint8_t address_lo = score->codemap[ptr[0] & 0x7Fu];
         score->parent.status.address = make_u16le(address_lo, score->address_hi);
         score->parent.status.value = ptr[1];
         score->parent.status.flags = AYMO_SCORE_FLAG_EVENT;
@@ -357,6 +359,7 @@ uint32_t aymo_score_dro_tick(
             else {
                 score->parent.status.flags = AYMO_SCORE_FLAG_EOF;
                 score->offset = score->length;
+                count -= pending;
                 break;
             }
 
@@ -367,6 +370,7 @@ uint32_t aymo_score_dro_tick(
         }
         else {
             score->parent.status.flags = AYMO_SCORE_FLAG_EOF;
+            count -= pending;
             break;
         }
     } while (pending);
@@ -375,4 +379,44 @@ uint32_t aymo_score_dro_tick(
 }
 
 
+void aymo_score_dro_get_checkpoint(
+    struct aymo_score_dro_instance* score,
+    struct aymo_score_checkpoint* checkpoint
+)
+{
+    assert(score);
+    assert(checkpoint);
+
+    checkpoint->time = 0u;
+    checkpoint->offset = score->offset;
+    checkpoint->state = score->address_hi;
+    checkpoint->delay = score->parent.status.delay;
+}
+
+
+void aymo_score_dro_set_checkpoint(
+    struct aymo_score_dro_instance* score,
+    const struct aymo_score_checkpoint* checkpoint
+)
+{
+    assert(score);
+    assert(checkpoint);
+
+    score->offset = checkpoint->offset;
+    score->address_hi = (uint8_t)(checkpoint->state & 1u);
+
+    score->parent.status.delay = checkpoint->delay;
+    score->parent.status.address = 0u;
+    score->parent.status.value = 0u;
+    score->parent.status.flags = 0u;
+
+    if (score->parent.status.delay) {
+        score->parent.status.flags = AYMO_SCORE_FLAG_DELAY;
+    }
+    else if (score->offset >= score->length) {
+        score->parent.status.flags = AYMO_SCORE_FLAG_EOF;
+    }
+}
+
+
 AYMO_CXX_EXTERN_C_END
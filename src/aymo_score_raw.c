@@ -33,7 +33,9 @@ const struct aymo_score_vt aymo_score_raw_vt = {
     (aymo_score_unload_f)aymo_score_raw_unload,
     (aymo_score_get_status_f)aymo_score_raw_get_status,
     (aymo_score_restart_f)aymo_score_raw_restart,
-    (aymo_score_tick_f)aymo_score_raw_tick
+    (aymo_score_tick_f)aymo_score_raw_tick,
+    (aymo_score_get_checkpoint_f)aymo_score_raw_get_checkpoint,
+    (aymo_score_set_checkpoint_f)aymo_score_raw_set_checkpoint
 };
 
 
@@ -198,6 +200,7 @@ uint32_t aymo_score_raw_tick(
                     }
                     else {
                         score->parent.status.flags = AYMO_SCORE_FLAG_EOF;
+                        count -= pending;
                         break;
                     }
                 }
@@ -218,6 +221,7 @@ uint32_t aymo_score_raw_tick(
         }
         else {
             score->parent.status.flags = AYMO_SCORE_FLAG_EOF;
+            count -= pending;
             break;
         }
     } while (pending);
@@ -226,4 +230,46 @@ uint32_t aymo_score_raw_tick(
 }
 
 
+void aymo_score_raw_get_checkpoint(
+    struct aymo_score_raw_instance* score,
+    struct aymo_score_checkpoint* checkpoint
+)
+{
+    assert(score);
+    assert(checkpoint);
+
+    checkpoint->time = 0u;
+    checkpoint->offset = score->index;
+    checkpoint->state = ((uint32_t)score->clock << 16u) | score->address_hi;
+    checkpoint->delay = score->parent.status.delay;
+}
+
+
+void aymo_score_raw_set_checkpoint(
+    struct aymo_score_raw_instance* score,
+    const struct aymo_score_checkpoint* checkpoint
+)
+{
+    assert(score);
+    assert(checkpoint);
+
+    score->index = checkpoint->offset;
+    score->address_hi = (uint8_t)(checkpoint->state & 1u);
+    score->clock = (uint16_t)(checkpoint->state >> 16u);
+    aymo_score_raw_update_clock(score);
+
+    score->parent.status.delay = checkpoint->delay;
+    score->parent.status.address = 0u;
+    score->parent.status.value = 0u;
+    score->parent.status.flags = 0u;
+
+    if (score->parent.status.delay) {
+        score->parent.status.flags = AYMO_SCORE_FLAG_DELAY;
+    }
+    else if (score->index >= score->length) {
+        score->parent.status.flags = AYMO_SCORE_FLAG_EOF;
+    }
+}
+
+
 AYMO_CXX_EXTERN_C_END
@@ -18,7 +18,10 @@ You should have received a copy of the GNU Lesser General Public License
 along with AYMO. If not, see <https://www.gnu.org/licenses/>.
 */
 
+#include "aymo_cpu.h"
 #include "aymo_score_ref.h"
+#include "aymo_score_ref_x86_avx2.h"
+#include "aymo_score_ref_x86_sse41.h"
 
 #include <assert.h>
 
@@ -38,7 +41,9 @@ const struct aymo_score_vt aymo_score_ref_vt = {
     (aymo_score_unload_f)aymo_score_ref_unload,
     (aymo_score_get_status_f)aymo_score_ref_get_status,
     (aymo_score_restart_f)aymo_score_ref_restart,
-    (aymo_score_tick_f)aymo_score_ref_tick
+    (aymo_score_tick_f)aymo_score_ref_tick,
+    (aymo_score_get_checkpoint_f)aymo_score_ref_get_checkpoint,
+    (aymo_score_set_checkpoint_f)aymo_score_ref_set_checkpoint
 };
 
 
@@ -77,6 +82,29 @@ int aymo_score_ref_load(
 
     score->text = (const char*)data;
     score->size = size;
+    score->events = NULL;
+    score->length = 0u;
+    score->tail = 0u;
+    aymo_score_ref_restart(score);
+    return 0;
+}
+
+
+int aymo_score_ref_load_events(
+    struct aymo_score_ref_instance* score,
+    const struct aymo_score_event events[],
+    uint32_t length,
+    uint32_t tail
+)
+{
+    assert(score);
+    assert(events);
+
+    score->text = NULL;
+    score->size = 0u;
+    score->events = events;
+    score->length = length;
+    score->tail = tail;
     aymo_score_ref_restart(score);
     return 0;
 }
@@ -153,6 +181,16 @@ void aymo_score_ref_restart(
 
     score->offset = 0u;
     score->line = 1u;
+    score->addrhi = 0u;
+    score->index = 0u;
+    score->delayed = 0u;
+
+    if (score->events) {
+        if (!score->length && !score->tail) {
+            score->parent.status.flags |= AYMO_SCORE_FLAG_EOF;
+        }
+        return;
+    }
 
     aymo_score_ref_skip_whitespace(score);
     if (score->offset < score->size) {
@@ -339,6 +377,72 @@ static void aymo_score_ref_decode_line(
 }
 
 
+static void aymo_score_ref_decode_event(
+    struct aymo_score_ref_instance* score
+)
+{
+    uint32_t index = score->index;
+    uint32_t delay = ((index < score->length) ? score->events[index].delay : score->tail);
+
+    if (!score->delayed && delay) {
+        score->delayed = 1u;
+        score->parent.status.delay = delay;
+        score->parent.status.flags = AYMO_SCORE_FLAG_DELAY;
+    }
+    else {
+        const struct aymo_score_event* event = &score->events[index];
+        score->index = (index + 1u);
+        score->delayed = 0u;
+        score->parent.status.address = event->address;
+        score->parent.status.value = event->value;
+        score->parent.status.flags = AYMO_SCORE_FLAG_EVENT;
+    }
+}
+
+
+static uint32_t aymo_score_ref_tick_events(
+    struct aymo_score_ref_instance* score,
+    uint32_t count
+)
+{
+    uint32_t pending = count;
+
+    do {
+        if (pending >= score->parent.status.delay) {
+            pending -= score->parent.status.delay;
+            score->parent.status.delay = 0u;
+        }
+        else {
+            score->parent.status.delay -= pending;
+            pending = 0u;
+        }
+
+        score->parent.status.address = 0u;
+        score->parent.status.value = 0u;
+        score->parent.status.flags = 0u;
+
+        if (score->parent.status.delay) {
+            score->parent.status.flags = AYMO_SCORE_FLAG_DELAY;
+        }
+        else if ((score->index < score->length) || (!score->delayed && score->tail)) {
+            aymo_score_ref_decode_event(score);
+
+            if (score->parent.status.flags & AYMO_SCORE_FLAG_EVENT) {
+                count -= pending;
+                break;
+            }
+        }
+        else {
+            score->parent.status.flags = AYMO_SCORE_FLAG_EOF;
+            count -= pending;
+            break;
+        }
+    } while (pending);
+
+    return count;
+}
+
+
 uint32_t aymo_score_ref_tick(
     struct aymo_score_ref_instance* score,
     uint32_t count
@@ -347,6 +451,10 @@ uint32_t aymo_score_ref_tick(
     assert(score);
     assert(!score->size || score->text);
 
+    if (score->events) {
+        return aymo_score_ref_tick_events(score, count);
+    }
+
     uint32_t pending = count;
 
     do {
@@ -376,12 +484,313 @@ uint32_t aymo_score_ref_tick(
         }
         else {
             score->parent.status.flags = AYMO_SCORE_FLAG_EOF;
+            count -= pending;
             break;
         }
-    } while (pending);
+    } while (pending || !score->parent.status.flags);  // no-op lines do not stop
 
     return count;
 }
 
 
+void aymo_score_ref_get_checkpoint(
+    struct aymo_score_ref_instance* score,
+    struct aymo_score_checkpoint* checkpoint
+)
+{
+    assert(score);
+    assert(checkpoint);
+
+    checkpoint->time = 0u;
+    checkpoint->delay = score->parent.status.delay;
+
+    if (score->events) {
+        checkpoint->offset = score->index;
+        checkpoint->state = score->delayed;
+    }
+    else {
+        checkpoint->offset = score->offset;
+        checkpoint->state = ((score->line << 8u) | score->addrhi);
+    }
+}
+
+
+void aymo_score_ref_set_checkpoint(
+    struct aymo_score_ref_instance* score,
+    const struct aymo_score_checkpoint* checkpoint
+)
+{
+    assert(score);
+    assert(checkpoint);
+
+    score->parent.status.delay = checkpoint->delay;
+    score->parent.status.address = 0u;
+    score->parent.status.value = 0u;
+    score->parent.status.flags = 0u;
+
+    if (score->events) {
+        score->index = checkpoint->offset;
+        score->delayed = (uint8_t)(checkpoint->state & 1u);
+
+        if (score->parent.status.delay) {
+            score->parent.status.flags = AYMO_SCORE_FLAG_DELAY;
+        }
+        else if ((score->index >= score->length) && (score->delayed || !score->tail)) {
+            score->parent.status.flags = AYMO_SCORE_FLAG_EOF;
+        }
+        return;
+    }
+
+    score->offset = checkpoint->offset;
+    score->addrhi = (uint8_t)(checkpoint->state & 0xFFu);
+    score->line = (checkpoint->state >> 8u);
+
+    if (score->parent.status.delay) {
+        score->parent.status.flags = AYMO_SCORE_FLAG_DELAY;
+    }
+    else if (score->offset >= score->size) {
+        score->parent.status.flags = AYMO_SCORE_FLAG_EOF;
+    }
+}
+
+
+// Classifies 64 characters, into bitmasks of line breaks and hex digits
+typedef void (*aymo_score_ref_classify_f)(const char text[64], uint64_t* eol, uint64_t* hex);
+
+void aymo_score_ref_classify_none(const char text[64], uint64_t* eol, uint64_t* hex)
+{
+    uint64_t eol_ = 0u;
+    uint64_t hex_ = 0u;
+
+    for (unsigned i = 0u; i < 64u; ++i) {
+        char c = text[i];
+        if ((c == '\n') || (c == '\r')) {
+            eol_ |= ((uint64_t)1u << i);
+        }
+        if (((c >= '0') && (c <= '9')) || ((c >= 'a') && (c <= 'f'))) {
+            hex_ |= ((uint64_t)1u << i);
+        }
+    }
+
+    *eol = eol_;
+    *hex = hex_;
+}
+
+
+static int aymo_score_ref_ffsll(uint64_t x)
+{
+#if (defined(__GNUC__) || defined(__clang__))
+    return __builtin_ffsll((long long)x);
+#else
+    if (x) {
+        int i = 1;
+        while (!(x & 1u)) {
+            x >>= 1u;
+            ++i;
+        }
+        return i;
+    }
+    return 0;
+#endif
+}
+
+
+// Pre-parser state, caching the classification of a 64-character window
+struct aymo_score_ref_parser {
+    const char* text;
+    uint32_t size;
+    uint32_t base;
+    uint64_t eol;
+    uint64_t hex;
+    aymo_score_ref_classify_f classify;
+};
+
+
+static void aymo_score_ref_parser_classify(
+    struct aymo_score_ref_parser* parser,
+    uint32_t base
+)
+{
+    parser->base = base;
+
+    if ((parser->size - base) >= 64u) {
+        parser->classify(&parser->text[base], &parser->eol, &parser->hex);
+    }
+    else {
+        char padded[64];
+        aymo_memset(padded, ' ', sizeof(padded));
+        aymo_memcpy(padded, (void*)&parser->text[base], (parser->size - base));
+        parser->classify(padded, &parser->eol, &parser->hex);
+    }
+}
+
+
+static void aymo_score_ref_parser_window(
+    struct aymo_score_ref_parser* parser,
+    uint32_t offset
+)
+{
+    if ((offset - parser->base) >= 64u) {
+        aymo_score_ref_parser_classify(parser, (offset & ~(uint32_t)63u));
+    }
+}
+
+
+// Finds the first line break at or after offset; size if none
+static uint32_t aymo_score_ref_parser_find_eol(
+    struct aymo_score_ref_parser* parser,
+    uint32_t offset
+)
+{
+    while (offset < parser->size) {
+        aymo_score_ref_parser_window(parser, offset);
+        uint32_t shift = (offset - parser->base);
+        uint64_t mask = (parser->eol >> shift);
+        if (mask) {
+            offset += (uint32_t)(aymo_score_ref_ffsll(mask) - 1);
+            return ((offset < parser->size) ? offset : parser->size);
+        }
+        offset = (parser->base + 64u);
+    }
+    return parser->size;
+}
+
+
+// Finds the first hex digit (or non-digit if invert) at or after offset; size if none
+static uint32_t aymo_score_ref_parser_find_hex(
+    struct aymo_score_ref_parser* parser,
+    uint32_t offset,
+    int invert
+)
+{
+    while (offset < parser->size) {
+        aymo_score_ref_parser_window(parser, offset);
+        uint32_t shift = (offset - parser->base);
+        uint64_t mask = (invert ? ~parser->hex : parser->hex);
+        mask >>= shift;
+        if (mask) {
+            offset += (uint32_t)(aymo_score_ref_ffsll(mask) - 1);
+            return ((offset < parser->size) ? offset : parser->size);
+        }
+        offset = (parser->base + 64u);
+    }
+    return parser->size;
+}
+
+
+static uint8_t aymo_score_ref_parse_hex8(
+    const char* text,
+    uint32_t begin,
+    uint32_t end
+)
+{
+    uint8_t value = 0u;
+    if ((end - begin) > 2u) {
+        begin = (end - 2u);  // only the last two digits stick
+    }
+    for (; begin < end; ++begin) {
+        char c = text[begin];
+        value <<= 4u;
+        value |= (uint8_t)((c <= '9') ? (c - '0') : (c - ('a' - 10)));
+    }
+    return value;
+}
+
+
+uint32_t aymo_score_ref_parse(
+    const void* data,
+    uint32_t size,
+    struct aymo_score_event events[],
+    uint32_t capacity,
+    uint32_t* tail
+)
+{
+    assert(!size || data);
+    assert(!capacity || events);
+
+    struct aymo_score_ref_parser parser;
+    parser.text = (const char*)data;
+    parser.size = size;
+    parser.base = 0u;
+    parser.eol = 0u;
+    parser.hex = 0u;
+    parser.classify = aymo_score_ref_classify_none;
+#ifdef AYMO_CPU_SUPPORT_X86_AVX2
+    if (aymo_cpu_x86_get_extensions() & AYMO_CPU_X86_EXT_AVX2) {
+        parser.classify = aymo_score_ref_x86_avx2_classify;
+    }
+    else
+#endif
+#ifdef AYMO_CPU_SUPPORT_X86_SSE41
+    if (aymo_cpu_x86_get_extensions() & AYMO_CPU_X86_EXT_SSE41) {
+        parser.classify = aymo_score_ref_x86_sse41_classify;
+    }
+#endif
+    if (size) {
+        aymo_score_ref_parser_classify(&parser, 0u);
+    }
+
+    // The scalar decoder does the line bookkeeping; the parser only walks offsets
+    struct aymo_score_ref_instance score;
+    score.text = parser.text;
+    score.size = size;
+    score.offset = 0u;
+    score.line = 1u;
+    score.addrhi = 0u;
+
+    aymo_score_ref_skip_whitespace(&score);
+    if ((score.offset < size) && (parser.text[score.offset] == 'i')) {  //  "init\n"
+        score.offset = aymo_score_ref_parser_find_eol(&parser, score.offset);
+        aymo_score_ref_skip_whitespace(&score);
+    }
+
+    uint32_t found = 0u;
+    uint32_t delay = 0u;
+
+    while (score.offset < size) {
+        char c = parser.text[score.offset];
+
+        if (c == 'i') {  // "init\n"
+            score.offset = aymo_score_ref_parser_find_eol(&parser, score.offset);
+            aymo_score_ref_skip_whitespace(&score);
+        }
+        else if (c == 's') {  // "setchip(%d)\n"
+            aymo_score_ref_decode_setchip(&score);
+        }
+        else if (c == 'r') {  // "r%.2f\n"
+            score.parent.status.delay = 0u;
+            aymo_score_ref_decode_rate(&score);
+            delay += score.parent.status.delay;
+        }
+        else {  // "%x <- %x\n"
+            uint32_t offset = score.offset;
+            uint32_t end = aymo_score_ref_parser_find_hex(&parser, offset, 1);
+            uint8_t addrlo = aymo_score_ref_parse_hex8(parser.text, offset, end);
+
+            offset = aymo_score_ref_parser_find_hex(&parser, end, 0);
+            end = aymo_score_ref_parser_find_hex(&parser, offset, 1);
+            uint8_t value = aymo_score_ref_parse_hex8(parser.text, offset, end);
+
+            score.offset = aymo_score_ref_parser_find_eol(&parser, end);
+            aymo_score_ref_skip_whitespace(&score);
+
+            if (found < capacity) {
+                struct aymo_score_event* event = &events[found];
+                event->delay = delay;
+                event->address = (((uint16_t)score.addrhi << 8u) | addrlo);
+                event->value = value;
+                event->reserved_ = 0u;
+            }
+            ++found;
+            delay = 0u;
+        }
+    }
+
+    if (tail) {
+        *tail = delay;
+    }
+    return found;
+}
+
+
 AYMO_CXX_EXTERN_C_END
@@ -0,0 +1,65 @@
+/*
+AYMO - Accelerated YaMaha Operator
+Copyright (c) 2023-2024 Andrea Zoppi.
+
+This file is part of AYMO.
+
+AYMO is free software: you can redistribute it and/or modify it under the
+terms of the GNU Lesser General Public License as published by the Free
+Software Foundation, either version 2.1 of the License, or (at your option)
+any later version.
+
+AYMO is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with AYMO. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "aymo_cpu.h"
+#ifdef AYMO_CPU_SUPPORT_X86_AVX2
+
+#define AYMO_KEEP_SHORTHANDS
+#include "aymo_score_ref_x86_avx2.h"
+
+#include <immintrin.h>
+
+AYMO_CXX_EXTERN_C_BEGIN
+
+
+static inline uint64_t aymo_(classify32)(__m256i c, uint64_t* hex)
+{
+    __m256i lf = _mm256_cmpeq_epi8(c, _mm256_set1_epi8('\n'));
+    __m256i cr = _mm256_cmpeq_epi8(c, _mm256_set1_epi8('\r'));
+    __m256i eol = _mm256_or_si256(lf, cr);
+
+    // Signed ranges, so that non-ASCII characters never match
+    __m256i dec = _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8('0' - 1)),
+                                   _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), c));
+    __m256i alpha = _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8('a' - 1)),
+                                     _mm256_cmpgt_epi8(_mm256_set1_epi8('f' + 1), c));
+    __m256i digit = _mm256_or_si256(dec, alpha);
+
+    *hex = (uint64_t)(uint32_t)_mm256_movemask_epi8(digit);
+    return (uint64_t)(uint32_t)_mm256_movemask_epi8(eol);
+}
+
+
+void aymo_(classify)(const char text[64], uint64_t* eol, uint64_t* hex)
+{
+    __m256i lo = _mm256_loadu_si256((const void*)&text[0]);
+    __m256i hi = _mm256_loadu_si256((const void*)&text[32]);
+    uint64_t hex_lo, hex_hi;
+    uint64_t eol_lo = aymo_(classify32)(lo, &hex_lo);
+    uint64_t eol_hi = aymo_(classify32)(hi, &hex_hi);
+
+    *eol = (eol_lo | (eol_hi << 32u));
+    *hex = (hex_lo | (hex_hi << 32u));
+}
+
+
+AYMO_CXX_EXTERN_C_END
+
+#endif  // AYMO_CPU_SUPPORT_X86_AVX2
@@ -0,0 +1,69 @@
+/*
+AYMO - Accelerated YaMaha Operator
+Copyright (c) 2023-2024 Andrea Zoppi.
+
+This file is part of AYMO.
+
+AYMO is free software: you can redistribute it and/or modify it under the
+terms of the GNU Lesser General Public License as published by the Free
+Software Foundation, either version 2.1 of the License, or (at your option)
+any later version.
+
+AYMO is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with AYMO. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "aymo_cpu.h"
+#ifdef AYMO_CPU_SUPPORT_X86_SSE41
+
+#define AYMO_KEEP_SHORTHANDS
+#include "aymo_score_ref_x86_sse41.h"
+
+#include <immintrin.h>
+
+AYMO_CXX_EXTERN_C_BEGIN
+
+
+static inline uint64_t aymo_(classify16)(__m128i c, uint64_t* hex)
+{
+    __m128i lf = _mm_cmpeq_epi8(c, _mm_set1_epi8('\n'));
+    __m128i cr = _mm_cmpeq_epi8(c, _mm_set1_epi8('\r'));
+    __m128i eol = _mm_or_si128(lf, cr);
+
+    // Signed ranges, so that non-ASCII characters never match
+    __m128i dec = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('0' - 1)),
+                                _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), c));
+    __m128i alpha = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('a' - 1)),
+                                  _mm_cmpgt_epi8(_mm_set1_epi8('f' + 1), c));
+    __m128i digit = _mm_or_si128(dec, alpha);
+
+    *hex = (uint64_t)(uint16_t)_mm_movemask_epi8(digit);
+    return (uint64_t)(uint16_t)_mm_movemask_epi8(eol);
+}
+
+
+void aymo_(classify)(const char text[64], uint64_t* eol, uint64_t* hex)
+{
+    uint64_t eol_ = 0u;
+    uint64_t hex_ = 0u;
+
+    for (unsigned i = 0u; i < 64u; i += 16u) {
+        __m128i c = _mm_loadu_si128((const void*)&text[i]);
+        uint64_t hex16;
+        eol_ |= (aymo_(classify16)(c, &hex16) << i);
+        hex_ |= (hex16 << i);
+    }
+
+    *eol = eol_;
+    *hex = hex_;
+}
+
+
+AYMO_CXX_EXTERN_C_END
+
+#endif  // AYMO_CPU_SUPPORT_X86_SSE41
@@ -33,7 +33,9 @@ const struct aymo_score_vt aymo_score_vgm_vt = {
     (aymo_score_unload_f)aymo_score_vgm_unload,
     (aymo_score_get_status_f)aymo_score_vgm_get_status,
     (aymo_score_restart_f)aymo_score_vgm_restart,
-    (aymo_score_tick_f)aymo_score_vgm_tick
+    (aymo_score_tick_f)aymo_score_vgm_tick,
+    (aymo_score_get_checkpoint_f)aymo_score_vgm_get_checkpoint,
+    (aymo_score_set_checkpoint_f)aymo_score_vgm_set_checkpoint
 };
 
 
@@ -301,6 +303,7 @@ uint32_t aymo_score_vgm_tick(
         }
         else {  // TODO: support for loops
             score->parent.status.flags = AYMO_SCORE_FLAG_EOF;
+            count -= pending;
             break;
         }
     } while (pending);
@@ -309,4 +312,44 @@ uint32_t aymo_score_vgm_tick(
 }
 
 
+void aymo_score_vgm_get_checkpoint(
+    struct aymo_score_vgm_instance* score,
+    struct aymo_score_checkpoint* checkpoint
+)
+{
+    assert(score);
+    assert(checkpoint);
+
+    checkpoint->time = 0u;
+    checkpoint->offset = score->offset;
+    checkpoint->state = 0u;
+    checkpoint->delay = score->parent.status.delay;
+}
+
+
+void aymo_score_vgm_set_checkpoint(
+    struct aymo_score_vgm_instance* score,
+    const struct aymo_score_checkpoint* checkpoint
+)
+{
+    assert(score);
+    assert(checkpoint);
+
+    score->offset = checkpoint->offset;
+    score->index = 0u;
+
+    score->parent.status.delay = checkpoint->delay;
+    score->parent.status.address = 0u;
+    score->parent.status.value = 0u;
+    score->parent.status.flags = 0u;
+
+    if (score->parent.status.delay) {
+        score->parent.status.flags = AYMO_SCORE_FLAG_DELAY;
+    }
+    else if (score->offset >= score->eof_offset) {
+        score->parent.status.flags = AYMO_SCORE_FLAG_EOF;
+    }
+}
+
+
 AYMO_CXX_EXTERN_C_END
@@ -24,6 +24,7 @@ along with AYMO. If not, see <https://www.gnu.org/licenses/>.
 #include "aymo_tda8425_dummy.h"
 #include "aymo_tda8425_none.h"
 #include "aymo_tda8425_x86_avx2.h"
+#include "aymo_tda8425_x86_fma3.h"
 #include "aymo_tda8425_x86_sse41.h"
 
 #include <assert.h>
@@ -34,6 +35,7 @@ AYMO_CXX_EXTERN_C_BEGIN
 const struct aymo_tda8425_math* aymo_tda8425_math;
 
 static const struct aymo_tda8425_vt* aymo_tda8425_best_vt;
+static const struct aymo_tda8425_bank_vt* aymo_tda8425_best_bank_vt;
 
 
 void aymo_tda8425_boot(const struct aymo_tda8425_math* math)
@@ -42,9 +44,13 @@ void aymo_tda8425_boot(const struct aymo_tda8425_math* math)
 
     aymo_tda8425_math = math;
 
+    aymo_tda8425_best_vt = aymo_tda8425_none_get_vt();
+    aymo_tda8425_best_bank_vt = aymo_tda8425_none_get_bank_vt();
+
     #ifdef AYMO_CPU_SUPPORT_X86_AVX2
         if (aymo_cpu_x86_get_extensions() & AYMO_CPU_X86_EXT_AVX2) {
             aymo_tda8425_best_vt = aymo_tda8425_x86_avx2_get_vt();
+            aymo_tda8425_best_bank_vt = aymo_tda8425_x86_avx2_get_bank_vt();
             return;
         }
     #endif
@@ -52,6 +58,7 @@ void aymo_tda8425_boot(const struct aymo_tda8425_math* math)
     #ifdef AYMO_CPU_SUPPORT_X86_SSE41
         if (aymo_cpu_x86_get_extensions() & AYMO_CPU_X86_EXT_SSE41) {
             aymo_tda8425_best_vt = aymo_tda8425_x86_sse41_get_vt();
+            aymo_tda8425_best_bank_vt = aymo_tda8425_x86_sse41_get_bank_vt();
             return;
         }
     #endif
@@ -59,11 +66,9 @@ void aymo_tda8425_boot(const struct aymo_tda8425_math* math)
     #ifdef AYMO_CPU_SUPPORT_ARM_NEON
         if (aymo_cpu_arm_get_extensions() & AYMO_CPU_ARM_EXT_NEON) {
             aymo_tda8425_best_vt = aymo_tda8425_arm_neon_get_vt();
-            return;
+            return;  // banks: plain C fallback
         }
     #endif
-
-    aymo_tda8425_best_vt = aymo_tda8425_none_get_vt();
 }
 
 
@@ -73,6 +78,15 @@ const struct aymo_tda8425_vt* aymo_tda8425_get_vt(const char* cpu_ext)
         return NULL;
     }
 
+    #ifdef AYMO_CPU_SUPPORT_X86_FMA3
+        if (!aymo_strcmp(cpu_ext, "x86_fma3")) {
+            if ((aymo_cpu_x86_get_extensions() & (AYMO_CPU_X86_EXT_AVX2 | AYMO_CPU_X86_EXT_FMA3)) ==
+                                                 (AYMO_CPU_X86_EXT_AVX2 | AYMO_CPU_X86_EXT_FMA3)) {
+                return aymo_tda8425_x86_fma3_get_vt();
+            }
+        }
+    #endif
+
     #ifdef AYMO_CPU_SUPPORT_X86_AVX2
         if (!aymo_strcmp(cpu_ext, "x86_avx2")) {
             if (aymo_cpu_x86_get_extensions() & AYMO_CPU_X86_EXT_AVX2) {
@@ -113,6 +127,41 @@ const struct aymo_tda8425_vt* aymo_tda8425_get_best_vt(void)
 }
 
 
+const struct aymo_tda8425_bank_vt* aymo_tda8425_get_bank_vt(const char* cpu_ext)
+{
+    if (cpu_ext == NULL) {
+        return NULL;
+    }
+
+    #ifdef AYMO_CPU_SUPPORT_X86_AVX2
+        if (!aymo_strcmp(cpu_ext, "x86_avx2")) {
+            if (aymo_cpu_x86_get_extensions() & AYMO_CPU_X86_EXT_AVX2) {
+                return aymo_tda8425_x86_avx2_get_bank_vt();
+            }
+        }
+    #endif
+
+    #ifdef AYMO_CPU_SUPPORT_X86_SSE41
+        if (!aymo_strcmp(cpu_ext, "x86_sse41")) {
+            if (aymo_cpu_x86_get_extensions() & AYMO_CPU_X86_EXT_SSE41) {
+                return aymo_tda8425_x86_sse41_get_bank_vt();
+            }
+        }
+    #endif
+
+    if (!aymo_strcmp(cpu_ext, "none")) {
+        return aymo_tda8425_none_get_bank_vt();
+    }
+    return NULL;
+}
+
+
+const struct aymo_tda8425_bank_vt* aymo_tda8425_get_best_bank_vt(void)
+{
+    return aymo_tda8425_best_bank_vt;
+}
+
+
 uint32_t aymo_tda8425_get_sizeof(struct aymo_tda8425_chip* chip)
 {
     assert(chip);
@@ -173,4 +222,125 @@ void aymo_tda8425_process_f32(struct aymo_tda8425_chip* chip, uint32_t count, co
 }
 
 
+void aymo_tda8425_process_i16(struct aymo_tda8425_chip* chip, uint32_t count, const int16_t x[], int16_t y[])
+{
+    assert(chip);
+    assert(chip->vt);
+    assert(chip->vt->process_i16);
+
+    chip->vt->process_i16(chip, count, x, y);
+}
+
+
+void aymo_tda8425_set_coeffs(struct aymo_tda8425_chip* chip, struct aymo_tda8425_coeffs* coeffs)
+{
+    assert(chip);
+    assert(chip->vt);
+    assert(chip->vt->set_coeffs);
+
+    chip->vt->set_coeffs(chip, coeffs);
+}
+
+
+void aymo_tda8425_set_smoothing(struct aymo_tda8425_chip* chip, uint32_t frames)
+{
+    assert(chip);
+    assert(chip->vt);
+    assert(chip->vt->set_smoothing);
+
+    chip->vt->set_smoothing(chip, frames);
+}
+
+
+void aymo_tda8425_set_silence(struct aymo_tda8425_chip* chip, float threshold)
+{
+    assert(chip);
+    assert(chip->vt);
+    assert(chip->vt->set_silence);
+
+    chip->vt->set_silence(chip, threshold);
+}
+
+
+
+uint32_t aymo_tda8425_bank_get_sizeof(struct aymo_tda8425_bank* bank, uint32_t instances)
+{
+    assert(bank);
+    assert(bank->vt);
+    assert(bank->vt->get_sizeof);
+
+    return bank->vt->get_sizeof(instances);
+}
+
+
+void aymo_tda8425_bank_ctor(struct aymo_tda8425_bank* bank, uint32_t instances, float sample_rate)
+{
+    assert(bank);
+    assert(bank->vt);
+    assert(bank->vt->ctor);
+
+    bank->vt->ctor(bank, instances, sample_rate);
+}
+
+
+void aymo_tda8425_bank_dtor(struct aymo_tda8425_bank* bank)
+{
+    assert(bank);
+    assert(bank->vt);
+    assert(bank->vt->dtor);
+
+    bank->vt->dtor(bank);
+}
+
+
+uint8_t aymo_tda8425_bank_read(struct aymo_tda8425_bank* bank, uint32_t index, uint16_t address)
+{
+    assert(bank);
+    assert(bank->vt);
+    assert(bank->vt->read);
+
+    return bank->vt->read(bank, index, address);
+}
+
+
+void aymo_tda8425_bank_write(struct aymo_tda8425_bank* bank, uint32_t index, uint16_t address, uint8_t value)
+{
+    assert(bank);
+    assert(bank->vt);
+    assert(bank->vt->write);
+
+    bank->vt->write(bank, index, address, value);
+}
+
+
+void aymo_tda8425_bank_process_f32(struct aymo_tda8425_bank* bank, uint32_t count, const float* const x[], float* const y[])
+{
+    assert(bank);
+    assert(bank->vt);
+    assert(bank->vt->process_f32);
+
+    bank->vt->process_f32(bank, count, x, y);
+}
+
+
+void aymo_tda8425_bank_process_f32_interleaved(struct aymo_tda8425_bank* bank, uint32_t count, const float x[], float y[])
+{
+    assert(bank);
+    assert(bank->vt);
+    assert(bank->vt->process_f32_interleaved);
+
+    bank->vt->process_f32_interleaved(bank, count, x, y);
+}
+
+
+void aymo_tda8425_bank_set_coeffs(struct aymo_tda8425_bank* bank, struct aymo_tda8425_coeffs* coeffs)
+{
+    assert(bank);
+    assert(bank->vt);
+    assert(bank->vt->set_coeffs);
+
+    bank->vt->set_coeffs(bank, coeffs);
+}
+
+
 AYMO_CXX_EXTERN_C_END
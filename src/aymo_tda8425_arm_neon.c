@@ -29,21 +29,6 @@ along with AYMO. If not, see <https://www.gnu.org/licenses/>.
 
 AYMO_CXX_EXTERN_C_BEGIN
 
-#undef cos
-#undef fabs
-#undef log10
-#undef pow
-#undef sqrt
-#undef tan
-
-#define cos     (aymo_tda8425_math->cos)
-#define fabs    (aymo_tda8425_math->fabs)
-#define log10   (aymo_tda8425_math->log10)
-#define pow     (aymo_tda8425_math->pow)
-#define sqrt    (aymo_tda8425_math->sqrt)
-#define tan     (aymo_tda8425_math->tan)
-
-
 const struct aymo_tda8425_vt aymo_(vt) =
 {
     AYMO_STRINGIFY2(aymo_(vt)),
@@ -52,7 +37,11 @@ const struct aymo_tda8425_vt aymo_(vt) =
     (aymo_tda8425_dtor_f)&(aymo_(dtor)),
     (aymo_tda8425_read_f)&(aymo_(read)),
     (aymo_tda8425_write_f)&(aymo_(write)),
-    (aymo_tda8425_process_f32_f)&(aymo_(process_f32))
+    (aymo_tda8425_process_f32_f)&(aymo_(process_f32)),
+    (aymo_tda8425_process_i16_f)&(aymo_(process_i16)),
+    (aymo_tda8425_set_coeffs_f)&(aymo_(set_coeffs)),
+    (aymo_tda8425_set_smoothing_f)&(aymo_(set_smoothing)),
+    (aymo_tda8425_set_silence_f)&(aymo_(set_silence))
 };
 
 
@@ -98,88 +87,46 @@ void aymo_(dtor)(struct aymo_(chip)* chip)
 }
 
 
-static void aymo_(apply_vl)(struct aymo_(chip)* chip)
+// Stores biquad coefficients into the target lanes selected by mask
+static void aymo_(store_biquad)(struct aymo_(chip)* chip, const struct aymo_tda8425_biquad* bq, uint32x4_t mask)
 {
-    double db = (double)aymo_tda8425_reg_v_to_db[chip->reg_vl & 0x3Fu];
+    chip->tkb0 = vbslq_f32(mask, vdupq_n_f32(bq->kb0), chip->tkb0);
+    chip->tkb1 = vbslq_f32(mask, vdupq_n_f32(bq->kb1), chip->tkb1);
+    chip->tkb2 = vbslq_f32(mask, vdupq_n_f32(bq->kb2), chip->tkb2);
+    chip->tka1 = vbslq_f32(mask, vdupq_n_f32(bq->ka1), chip->tka1);
+    chip->tka2 = vbslq_f32(mask, vdupq_n_f32(bq->ka2), chip->tka2);
+}
 
-    if (chip->reg_sf & 0x20u) {  // mute
-        db = -90.;
-    }
 
-    double g = pow(10., (db * .05));
-    chip->kv = vset_lane_f32((float)g, chip->kv, 0);
+static void aymo_(apply_vl)(struct aymo_(chip)* chip)
+{
+    float g = aymo_tda8425_lookup_volume(chip->coeffs, chip->reg_vl, chip->reg_sf);
+    chip->tkv = vset_lane_f32(g, chip->tkv, 0);
 }
 
 
 static void aymo_(apply_vr)(struct aymo_(chip)* chip)
 {
-    double db = (double)aymo_tda8425_reg_v_to_db[chip->reg_vr & 0x3Fu];
-
-    if (chip->reg_sf & 0x20u) {  // mute
-        db = -90.;
-    }
-
-    double g = pow(10., (db * .05));
-    chip->kv = vset_lane_f32((float)g, chip->kv, 1);
+    float g = aymo_tda8425_lookup_volume(chip->coeffs, chip->reg_vr, chip->reg_sf);
+    chip->tkv = vset_lane_f32(g, chip->tkv, 1);
 }
 
 
 static void aymo_(apply_ba)(struct aymo_(chip)* chip)
 {
-    double dbb = (double)aymo_tda8425_reg_ba_to_db[chip->reg_ba & 0x0Fu];
-    double gb = pow(10., (dbb * (.05 * .5)));
-    double fs = (double)chip->sample_rate;
-    double pi = 3.14159265358979323846264338327950288;
-    double fcb = 300.;  // [Hz]
-    double wb = ((2. * pi) * fcb);
-    double kb = (tan(wb * (.5 / fs)) / wb);
-
-    double a0 = ((kb * wb) + gb);
-    double a1 = ((kb * wb) - gb);
-    double a2 = 0.;
-
-    double b0 = (((kb * wb) * (gb * gb)) + gb);
-    double b1 = (((kb * wb) * (gb * gb)) - gb);
-    double b2 = 0.;
-
-    double ra0 = (1. / a0);
-    chip->kb0 = vsetq_lane_f32((float)(b0 * ra0), chip->kb0, 2);
-    chip->kb1 = vsetq_lane_f32((float)(b1 * ra0), chip->kb1, 2);
-    chip->kb2 = vsetq_lane_f32((float)(b2 * ra0), chip->kb2, 2);
-    ra0 = -ra0;
-    chip->ka1 = vsetq_lane_f32((float)(a1 * ra0), chip->ka1, 2);
-    chip->ka2 = vsetq_lane_f32((float)(a2 * ra0), chip->ka2, 2);
+    struct aymo_tda8425_biquad tmp;
+    const struct aymo_tda8425_biquad* bq =
+        aymo_tda8425_lookup_bass(chip->coeffs, &tmp, chip->sample_rate, chip->reg_ba);
+    aymo_(store_biquad)(chip, bq, vsetq_lane_u32(~0u, vdupq_n_u32(0u), 2));
 }
 
 
 static void aymo_(apply_tr)(struct aymo_(chip)* chip)
 {
-    double db = (double)aymo_tda8425_reg_tr_to_db[chip->reg_tr & 0x0Fu];
-    double gt = pow(10., (db * (.05 * .5)));
-    double fs = (double)chip->sample_rate;
-    double pi = 3.14159265358979323846264338327950288;
-    double fcd = 10.;  // [Hz]
-    double wd = ((2. * pi) * fcd);
-    double kd = ((chip->reg_sf & 0x40u) ? 0. : (tan(wd * (.5 / fs)) / wd));
-    double fct = 4500.;  // [Hz]
-    double wt = ((2. * pi) * fct);
-    double kt = (tan(wt * (.5 / fs)) / wt);
-
-    double a0 = (((gt * kt * wt) * (kd * wd)) + ((gt * kt * wt) + (kd * wd)) + 1.);
-    double a1 = (((gt * kt * wt) * (kd * wd) * 2.) - 2.);
-    double a2 = (((gt * kt * wt) * (kd * wd)) - ((gt * kt * wt) + (kd * wd)) + 1.);
-
-    double b0 = ((gt * gt) + (gt * kt * wt));
-    double b1 = ((gt * gt) * -2.);
-    double b2 = ((gt * gt) - (gt * kt * wt));
-
-    double ra0 = (1. / a0);
-    chip->kb0 = vsetq_lane_f32((float)(b0 * ra0), chip->kb0, 1);
-    chip->kb1 = vsetq_lane_f32((float)(b1 * ra0), chip->kb1, 1);
-    chip->kb2 = vsetq_lane_f32((float)(b2 * ra0), chip->kb2, 1);
-    ra0 = -ra0;
-    chip->ka1 = vsetq_lane_f32((float)(a1 * ra0), chip->ka1, 1);
-    chip->ka2 = vsetq_lane_f32((float)(a2 * ra0), chip->ka2, 1);
+    struct aymo_tda8425_biquad tmp;
+    const struct aymo_tda8425_biquad* bq =
+        aymo_tda8425_lookup_treble(chip->coeffs, &tmp, chip->sample_rate, chip->reg_tr, chip->reg_sf);
+    aymo_(store_biquad)(chip, bq, vsetq_lane_u32(~0u, vdupq_n_u32(0u), 1));
 }
 
 
@@ -240,105 +187,26 @@ static void aymo_(apply_source_mode)(struct aymo_(chip)* chip)
         }
     }  // not forced mono
 
-    chip->klr = klr;
-    chip->krl = krl;
+    chip->tklr = klr;
+    chip->tkrl = krl;
 }
 
 
 static void aymo_(apply_pseudo)(struct aymo_(chip)* chip)
 {
-    uint8_t mode = ((chip->reg_sf >> 3u) & 0x03u);
-
-    // Pseudo stereo
-    if (mode == 0x02u) {  // enabled
-        double c1 = (double)chip->pseudo_c1;
-        double c2 = (double)chip->pseudo_c2;
-        double r1 = 15000.;  // [ohm]
-        double r2 = 15000.;  // [ohm]
-        double t1 = (c1 * r1);
-        double t2 = (c2 * r2);
-
-        double fs = (double)chip->sample_rate;
-        double k = (.5 / fs);
-        double kk = (k * k);
-        double t1_t2 = (t1 * t2);
-        double t1_t2_k = ((t1 + t2) * k);
-
-        double a0 = (kk + t1_t2 + t1_t2_k);
-        double a1 = ((kk - t1_t2) * 2.);
-        double a2 = (kk + t1_t2 - t1_t2_k);
-
-        double b0 = a2;
-        double b1 = a1;
-        double b2 = a0;
-
-        double ra0 = (1. / a0);
-        chip->kb0 = vsetq_lane_f32((float)(b0 * ra0), chip->kb0, 0);
-        chip->kb1 = vsetq_lane_f32((float)(b1 * ra0), chip->kb1, 0);
-        chip->kb2 = vsetq_lane_f32((float)(b2 * ra0), chip->kb2, 0);
-        ra0 = -ra0;
-        chip->ka1 = vsetq_lane_f32((float)(a1 * ra0), chip->ka1, 0);
-        chip->ka2 = vsetq_lane_f32((float)(a2 * ra0), chip->ka2, 0);
-    }
-    else {  // pass-through
-        chip->kb0 = vsetq_lane_f32(1.f, chip->kb0, 0);
-        chip->kb1 = vsetq_lane_f32(.0f, chip->kb1, 0);
-        chip->kb2 = vsetq_lane_f32(.0f, chip->kb2, 0);
-
-        chip->ka1 = vsetq_lane_f32(.0f, chip->ka1, 0);
-        chip->ka2 = vsetq_lane_f32(.0f, chip->ka2, 0);
-    }
+    struct aymo_tda8425_biquad tmp;
+    const struct aymo_tda8425_biquad* bq =
+        aymo_tda8425_lookup_pseudo(chip->coeffs, &tmp, chip->sample_rate, chip->reg_pp, chip->reg_sf);
+    aymo_(store_biquad)(chip, bq, vsetq_lane_u32(~0u, vdupq_n_u32(0u), 0));
 }
 
 
 static void aymo_(apply_tfilter)(struct aymo_(chip)* chip)
 {
-    // T-filter
-    if (chip->reg_sf & 0x80u) {  // pass-through
-        chip->kb0 = vsetq_lane_f32(1.f, chip->kb0, 3);
-        chip->kb1 = vsetq_lane_f32(.0f, chip->kb1, 3);
-        chip->kb2 = vsetq_lane_f32(.0f, chip->kb2, 3);
-
-        chip->ka1 = vsetq_lane_f32(.0f, chip->ka1, 3);
-        chip->ka2 = vsetq_lane_f32(.0f, chip->ka2, 3);
-    }
-    else {  // enabled
-        double db = (double)aymo_tda8425_reg_ba_to_db[chip->reg_ba & 0x0Fu];
-        double g = pow(10., (db * (.05 * .5)));
-        double fs = (double)chip->sample_rate;
-        double pi = 3.14159265358979323846264338327950288;
-        double fc = 180.;  // [Hz]
-        double w = ((2. * pi) * fc);
-        double k = (tan(w * (.5 / fs)) / w);
-
-        double log10_g = log10(g);
-        double ang = (log10_g * .85);
-        double abs_sqrt_log10_g = sqrt(fabs(log10_g));
-        double abs2_sqrt_log10_g = abs_sqrt_log10_g * abs_sqrt_log10_g;
-        double kw = (k * w);
-        double m_k2w2 = ((kw * kw) * -.05);
-        double sqrt_5 = 2.23606797749978980505147774238139391;
-        double ph = (pi * .75);
-        double h_sqrt_5_kw_abs_sqrt_log10_g = ((sqrt_5 * .2) * kw * abs_sqrt_log10_g);
-        double cosm = cos(ang - ph);
-        double cosp = cos(ang + ph);
-
-        double a0 = (((m_k2w2 - abs2_sqrt_log10_g) + (h_sqrt_5_kw_abs_sqrt_log10_g * cosm)));
-        double a1 = (((m_k2w2 + abs2_sqrt_log10_g)) * 2.);
-        double a2 = (((m_k2w2 - abs2_sqrt_log10_g) - (h_sqrt_5_kw_abs_sqrt_log10_g * cosm)));
-
-        double b0 = (((m_k2w2 - abs2_sqrt_log10_g) + (h_sqrt_5_kw_abs_sqrt_log10_g * cosp)));
-        double b1 = a1;
-        double b2 = (((m_k2w2 - abs2_sqrt_log10_g) - (h_sqrt_5_kw_abs_sqrt_log10_g * cosp)));
-
-        double ra0 = (1. / a0);
-        chip->kb0 = vsetq_lane_f32((float)(b0 * ra0), chip->kb0, 3);
-        chip->kb1 = vsetq_lane_f32((float)(b1 * ra0), chip->kb1, 3);
-        chip->kb2 = vsetq_lane_f32((float)(b2 * ra0), chip->kb2, 3);
-        ra0 = -ra0;
-        chip->ka1 = vsetq_lane_f32((float)(a1 * ra0), chip->ka1, 3);
-        chip->ka2 = vsetq_lane_f32((float)(a2 * ra0), chip->ka2, 3);
-    }
+    struct aymo_tda8425_biquad tmp;
+    const struct aymo_tda8425_biquad* bq =
+        aymo_tda8425_lookup_tfilter(chip->coeffs, &tmp, chip->sample_rate, chip->reg_ba, chip->reg_sf);
+    aymo_(store_biquad)(chip, bq, vsetq_lane_u32(~0u, vdupq_n_u32(0u), 3));
 }
 
 
@@ -353,6 +221,57 @@ static void aymo_(apply_pp)(struct aymo_(chip)* chip)
 }
 
 
+// Applies the coefficient targets at once, ending any ramp
+static void aymo_(snap)(struct aymo_(chip)* chip)
+{
+    chip->kb2 = chip->tkb2;
+    chip->ka2 = chip->tka2;
+    chip->kb1 = chip->tkb1;
+    chip->ka1 = chip->tka1;
+    chip->kb0 = chip->tkb0;
+    chip->krl = chip->tkrl;
+    chip->klr = chip->tklr;
+    chip->kv = chip->tkv;
+    chip->smooth_left = 0u;
+}
+
+
+// Moves the coefficients one ramp step towards their targets
+static void aymo_(ramp)(struct aymo_(chip)* chip)
+{
+    chip->kb2 = vaddq_f32(chip->kb2, chip->dkb2);
+    chip->ka2 = vaddq_f32(chip->ka2, chip->dka2);
+    chip->kb1 = vaddq_f32(chip->kb1, chip->dkb1);
+    chip->ka1 = vaddq_f32(chip->ka1, chip->dka1);
+    chip->kb0 = vaddq_f32(chip->kb0, chip->dkb0);
+    chip->krl = vadd_f32(chip->krl, chip->dkrl);
+    chip->klr = vadd_f32(chip->klr, chip->dklr);
+    chip->kv = vadd_f32(chip->kv, chip->dkv);
+}
+
+
+// Starts a new ramp from the current coefficients towards the targets
+static void aymo_(retarget)(struct aymo_(chip)* chip)
+{
+    if (chip->smooth_steps) {
+        float rs = (1.f / (float)chip->smooth_steps);
+        chip->dkb2 = vmulq_n_f32(vsubq_f32(chip->tkb2, chip->kb2), rs);
+        chip->dka2 = vmulq_n_f32(vsubq_f32(chip->tka2, chip->ka2), rs);
+        chip->dkb1 = vmulq_n_f32(vsubq_f32(chip->tkb1, chip->kb1), rs);
+        chip->dka1 = vmulq_n_f32(vsubq_f32(chip->tka1, chip->ka1), rs);
+        chip->dkb0 = vmulq_n_f32(vsubq_f32(chip->tkb0, chip->kb0), rs);
+        chip->dkrl = vmul_n_f32(vsub_f32(chip->tkrl, chip->krl), rs);
+        chip->dklr = vmul_n_f32(vsub_f32(chip->tklr, chip->klr), rs);
+        chip->dkv = vmul_n_f32(vsub_f32(chip->tkv, chip->kv), rs);
+
+        chip->smooth_left = (chip->smooth_steps * AYMO_TDA8425_SMOOTH_STEP);
+    }
+    else {
+        aymo_(snap)(chip);
+    }
+}
+
+
 uint8_t aymo_(read)(struct aymo_(chip)* chip, uint16_t address)
 {
     assert(chip);
@@ -429,11 +348,16 @@ void aymo_(write)(struct aymo_(chip)* chip, uint16_t address, uint8_t value)
             aymo_(apply_tr)(chip);
             break;
         }
+        default: {
+            return;
+        }
     }
+
+    aymo_(retarget)(chip);
 }
 
 
-void aymo_(process_f32)(struct aymo_(chip)* chip, uint32_t count, const float x[], float y[])
+static void aymo_(run_f32)(struct aymo_(chip)* chip, uint32_t count, const float x[], float y[])
 {
     assert(chip);
     assert(x);
@@ -515,6 +439,280 @@ void aymo_(process_f32)(struct aymo_(chip)* chip, uint32_t count, const float x[
 }
 
 
+static inline vi32x4_t aymo_(f32_q)(vf32x4_t f, int q)
+{
+    return vcvtq_s32_f32(vmulq_n_f32(f, (float)(1L << q)));
+}
+
+
+static inline vi32x2_t aymo_(f32_q2)(vf32x2_t f, int q)
+{
+    return vcvt_s32_f32(vmul_n_f32(f, (float)(1L << q)));
+}
+
+
+static inline vf32x4_t aymo_(q_f32)(vi32x4_t i, int q)
+{
+    return vmulq_n_f32(vcvtq_f32_s32(i), (float)(1. / (double)(1L << q)));
+}
+
+
+// Multiply-accumulates Q-format lanes into exact 64-bit low/high sums
+static inline void aymo_(mac_q)(int64x2_t* lo, int64x2_t* hi, vi32x4_t x, vi32x4_t k)
+{
+    *lo = vmlal_s32(*lo, vget_low_s32(x), vget_low_s32(k));
+    *hi = vmlal_s32(*hi, vget_high_s32(x), vget_high_s32(k));
+}
+
+
+// Rounds 64-bit low/high sums back to Q-format signal lanes
+static inline vi32x4_t aymo_(round_q)(int64x2_t lo, int64x2_t hi)
+{
+    return vcombine_s32(vrshrn_n_s64(lo, AYMO_TDA8425_Q_COEFF), vrshrn_n_s64(hi, AYMO_TDA8425_Q_COEFF));
+}
+
+
+static void aymo_(run_i16)(struct aymo_(chip)* chip, uint32_t count, const int16_t x[], int16_t y[])
+{
+    assert(chip);
+    assert(x);
+    assert(y);
+
+    if AYMO_UNLIKELY(!count) {
+        return;
+    }
+
+    const int qk = AYMO_TDA8425_Q_COEFF;
+    const int qs = AYMO_TDA8425_Q_SIGNAL;
+
+    vi32x4_t kb2 = aymo_(f32_q)(chip->kb2, qk);
+    vi32x4_t ka2 = aymo_(f32_q)(chip->ka2, qk);
+
+    vi32x4_t b2l = aymo_(f32_q)(chip->hb1l, qs);
+    vi32x4_t a2l = aymo_(f32_q)(chip->ha1l, qs);
+
+    vi32x4_t b2r = aymo_(f32_q)(chip->hb1r, qs);
+    vi32x4_t a2r = aymo_(f32_q)(chip->ha1r, qs);
+
+    vi32x4_t kb1 = aymo_(f32_q)(chip->kb1, qk);
+    vi32x4_t ka1 = aymo_(f32_q)(chip->ka1, qk);
+
+    vi32x4_t b1l = aymo_(f32_q)(chip->hb0l, qs);
+    vi32x4_t a1l = aymo_(f32_q)(chip->ha0l, qs);
+
+    vi32x4_t b1r = aymo_(f32_q)(chip->hb0r, qs);
+    vi32x4_t a1r = aymo_(f32_q)(chip->ha0r, qs);
+
+    vi32x2_t klr = aymo_(f32_q2)(chip->klr, qk);
+    vi32x2_t krl = aymo_(f32_q2)(chip->krl, qk);
+
+    vi32x4_t kb0 = aymo_(f32_q)(chip->kb0, qk);
+
+    vi32x2_t kv = aymo_(f32_q2)(chip->kv, qk);
+
+    do {
+        int64x2_t lol = vdupq_n_s64(0);
+        int64x2_t hil = vdupq_n_s64(0);
+        int64x2_t lor = vdupq_n_s64(0);
+        int64x2_t hir = vdupq_n_s64(0);
+
+        aymo_(mac_q)(&lol, &hil, b2l, kb2);
+        aymo_(mac_q)(&lol, &hil, a2l, ka2);
+        aymo_(mac_q)(&lor, &hir, b2r, kb2);
+        aymo_(mac_q)(&lor, &hir, a2r, ka2);
+
+        aymo_(mac_q)(&lol, &hil, b1l, kb1);
+        aymo_(mac_q)(&lol, &hil, a1l, ka1);
+        aymo_(mac_q)(&lor, &hir, b1r, kb1);
+        aymo_(mac_q)(&lor, &hir, a1r, ka1);
+
+        vi32x2_t xlr = vdup_n_s32((int32_t)x[0]);
+        xlr = vset_lane_s32((int32_t)x[1], xlr, 1); x += 2u;
+        xlr = vshl_n_s32(xlr, (AYMO_TDA8425_Q_SIGNAL - 15));
+        vi32x2_t xrl = vrev64_s32(xlr);
+        int64x2_t wxq = vmull_s32(xlr, klr);
+        wxq = vmlal_s32(wxq, xrl, krl);
+        vi32x2_t wx = vrshrn_n_s64(wxq, AYMO_TDA8425_Q_COEFF);
+        vi32x4_t xx = vcombine_s32(wx, wx);
+
+        vi32x4_t xl = vrev64q_s32(xx);
+        vi32x4_t b0l = vextq_s32(xl, a1l, 3);
+        vi32x4_t b0r = vextq_s32(xx, a1r, 3);
+
+        aymo_(mac_q)(&lol, &hil, b0l, kb0);
+        aymo_(mac_q)(&lor, &hir, b0r, kb0);
+        vi32x4_t a0l = aymo_(round_q)(lol, hil);
+        vi32x4_t a0r = aymo_(round_q)(lor, hir);
+
+        vi32x2_t ylh = vget_high_s32(a0l);
+        vi32x2_t yrh = vget_high_s32(a0r);
+        vi32x2_t yy = vext_s32(ylh, vrev64_s32(yrh), 1);
+        yy = vrshrn_n_s64(vmull_s32(yy, kv), AYMO_TDA8425_Q_COEFF);
+        int16x4_t yq = vqrshrn_n_s32(vcombine_s32(yy, yy), (AYMO_TDA8425_Q_SIGNAL - 15));
+        vst1_lane_s32((int32_t*)(void*)y, vreinterpret_s32_s16(yq), 0); y += 2u;
+
+        b2l = b1l;
+        a2l = a1l;
+        b2r = b1r;
+        a2r = a1r;
+
+        b1l = b0l;
+        a1l = a0l;
+        b1r = b0r;
+        a1r = a0r;
+    } while (--count);
+
+    chip->hb1l = aymo_(q_f32)(b2l, qs);
+    chip->ha1l = aymo_(q_f32)(a2l, qs);
+    chip->hb1r = aymo_(q_f32)(b2r, qs);
+    chip->ha1r = aymo_(q_f32)(a2r, qs);
+
+    chip->hb0l = aymo_(q_f32)(b1l, qs);
+    chip->ha0l = aymo_(q_f32)(a1l, qs);
+    chip->hb0r = aymo_(q_f32)(b1r, qs);
+    chip->ha0r = aymo_(q_f32)(a1r, qs);
+}
+
+
+// Advances the ramp by the given frames, which never cross a ramp step boundary
+static void aymo_(advance)(struct aymo_(chip)* chip, uint32_t count)
+{
+    chip->smooth_left -= count;
+
+    if (!chip->smooth_left) {
+        aymo_(snap)(chip);
+    }
+    else if (!(chip->smooth_left % AYMO_TDA8425_SMOOTH_STEP)) {
+        aymo_(ramp)(chip);
+    }
+}
+
+
+// Frames to process before the next ramp step, if ramping
+static inline uint32_t aymo_(run_length)(const struct aymo_(chip)* chip, uint32_t count)
+{
+    if AYMO_UNLIKELY(chip->smooth_left) {
+        uint32_t n = (((chip->smooth_left - 1u) % AYMO_TDA8425_SMOOTH_STEP) + 1u);
+        if (count > n) {
+            count = n;
+        }
+    }
+    return count;
+}
+
+
+// Zeroes the filter states once all of their magnitudes fall below the silence threshold
+static void aymo_(gate_silence)(struct aymo_(chip)* chip)
+{
+    vf32x4_t m1l = vmaxq_f32(vabsq_f32(chip->hb1l), vabsq_f32(chip->ha1l));
+    vf32x4_t m1r = vmaxq_f32(vabsq_f32(chip->hb1r), vabsq_f32(chip->ha1r));
+    vf32x4_t m0l = vmaxq_f32(vabsq_f32(chip->hb0l), vabsq_f32(chip->ha0l));
+    vf32x4_t m0r = vmaxq_f32(vabsq_f32(chip->hb0r), vabsq_f32(chip->ha0r));
+    vf32x4_t m = vmaxq_f32(vmaxq_f32(m1l, m1r), vmaxq_f32(m0l, m0r));
+    vu32x4_t quiet = vcltq_f32(m, vdupq_n_f32(chip->silence));
+    vu32x2_t quiet2 = vand_u32(vget_low_u32(quiet), vget_high_u32(quiet));
+
+    if ((vget_lane_u32(quiet2, 0) & vget_lane_u32(quiet2, 1)) == UINT32_MAX) {
+        vf32x4_t z = vdupq_n_f32(0.f);
+        chip->hb1l = z;
+        chip->ha1l = z;
+        chip->hb1r = z;
+        chip->ha1r = z;
+        chip->hb0l = z;
+        chip->ha0l = z;
+        chip->hb0r = z;
+        chip->ha0r = z;
+    }
+}
+
+
+void aymo_(process_f32)(struct aymo_(chip)* chip, uint32_t count, const float x[], float y[])
+{
+    assert(chip);
+    assert(x);
+    assert(y);
+
+    aymo_cpu_fpstate_t fpstate = aymo_cpu_enter_ftz();
+
+    while (count) {
+        uint32_t n = aymo_(run_length)(chip, count);
+        aymo_(run_f32)(chip, n, x, y);
+        x += (n * 2u);
+        y += (n * 2u);
+        count -= n;
+
+        if AYMO_UNLIKELY(chip->smooth_left) {
+            aymo_(advance)(chip, n);
+        }
+    }
+
+    if (chip->silence > 0.f) {
+        aymo_(gate_silence)(chip);
+    }
+
+    aymo_cpu_leave_ftz(fpstate);
+}
+
+
+void aymo_(process_i16)(struct aymo_(chip)* chip, uint32_t count, const int16_t x[], int16_t y[])
+{
+    assert(chip);
+    assert(x);
+    assert(y);
+
+    while (count) {
+        uint32_t n = aymo_(run_length)(chip, count);
+        aymo_(run_i16)(chip, n, x, y);
+        x += (n * 2u);
+        y += (n * 2u);
+        count -= n;
+
+        if AYMO_UNLIKELY(chip->smooth_left) {
+            aymo_(advance)(chip, n);
+        }
+    }
+
+    if (chip->silence > 0.f) {
+        aymo_(gate_silence)(chip);
+    }
+}
+
+
+void aymo_(set_coeffs)(struct aymo_(chip)* chip, struct aymo_tda8425_coeffs* coeffs)
+{
+    assert(chip);
+    assert(!coeffs || (coeffs->sample_rate == chip->sample_rate));
+
+    // Cached and computed coefficients are the same, so there is nothing to reapply
+    chip->coeffs = coeffs;
+}
+
+
+void aymo_(set_smoothing)(struct aymo_(chip)* chip, uint32_t frames)
+{
+    assert(chip);
+
+    uint32_t steps = ((frames / AYMO_TDA8425_SMOOTH_STEP) + ((frames % AYMO_TDA8425_SMOOTH_STEP) != 0u));
+    if (steps > (UINT32_MAX / AYMO_TDA8425_SMOOTH_STEP)) {
+        steps = (UINT32_MAX / AYMO_TDA8425_SMOOTH_STEP);
+    }
+    chip->smooth_steps = steps;
+
+    if (!steps) {
+        aymo_(snap)(chip);
+    }
+}
+
+
+void aymo_(set_silence)(struct aymo_(chip)* chip, float threshold)
+{
+    assert(chip);
+    assert(threshold >= 0.f);
+
+    chip->silence = threshold;
+}
+
+
 AYMO_CXX_EXTERN_C_END
 
 #endif  // AYMO_CPU_SUPPORT_ARM_NEON
@@ -18,10 +18,28 @@ You should have received a copy of the GNU Lesser General Public License
 along with AYMO. If not, see <https://www.gnu.org/licenses/>.
 */
 
+#include "aymo_tda8425.h"
 #include "aymo_tda8425_common.h"
 
+#include <assert.h>
+#include <stddef.h>
+
 AYMO_CXX_EXTERN_C_BEGIN
 
+#undef cos
+#undef fabs
+#undef log10
+#undef pow
+#undef sqrt
+#undef tan
+
+#define cos     (aymo_tda8425_math->cos)
+#define fabs    (aymo_tda8425_math->fabs)
+#define log10   (aymo_tda8425_math->log10)
+#define pow     (aymo_tda8425_math->pow)
+#define sqrt    (aymo_tda8425_math->sqrt)
+#define tan     (aymo_tda8425_math->tan)
+
 
 const int8_t aymo_tda8425_reg_v_to_db[64] =
 {
@@ -147,4 +165,496 @@ const float aymo_tda8425_pseudo_preset_c2[3] =
 };
 
 
+const struct aymo_tda8425_biquad aymo_tda8425_biquad_pass =
+{
+    1.f,  // kb0
+    0.f,  // kb1
+    0.f,  // kb2
+    0.f,  // ka1
+    0.f   // ka2
+};
+
+
+static void aymo_tda8425_biquad_store(
+    struct aymo_tda8425_biquad* bq,
+    double b0, double b1, double b2, double a0, double a1, double a2
+)
+{
+    double ra0 = (1. / a0);
+    bq->kb0 = (float)(b0 * ra0);
+    bq->kb1 = (float)(b1 * ra0);
+    bq->kb2 = (float)(b2 * ra0);
+    ra0 = -ra0;
+    bq->ka1 = (float)(a1 * ra0);
+    bq->ka2 = (float)(a2 * ra0);
+}
+
+
+static uint8_t aymo_tda8425_pseudo_preset(uint8_t reg_pp)
+{
+    uint8_t pseudo_preset = (reg_pp & 0x03u);
+    if (pseudo_preset >= 3u) {
+        pseudo_preset = 0u;
+    }
+    return pseudo_preset;
+}
+
+
+// Input mixer gains for L and R outputs, from the direct and the swapped inputs
+void aymo_tda8425_calc_mixer(float klr[2], float krl[2], uint8_t reg_sf)
+{
+    assert(klr);
+    assert(krl);
+
+    // Default mute
+    klr[0] = 0.f; klr[1] = 0.f;
+    krl[0] = 0.f; krl[1] = 0.f;
+
+    uint8_t source = (reg_sf & 0x07u);
+    uint8_t mode = ((reg_sf >> 3u) & 0x03u);
+
+    // Forced mono
+    if (mode == 0x00u) {  // process
+        switch (source) {
+            // Channel 1
+            case 0x02u:
+            case 0x04u:
+            case 0x06u: {
+                klr[0] = 1.f; klr[1] = 1.f;
+                krl[0] = 1.f; krl[1] = 1.f;
+                break;
+            }
+        }
+    }
+    else {  // not forced mono
+        switch (source) {
+            // Channel 1
+            case 0x02u: {  // mono left
+                klr[0] = 1.f; klr[1] = 0.f;
+                krl[0] = 0.f; krl[1] = 1.f;
+                break;
+            }
+            case 0x04u: {  // mono right
+                klr[0] = 0.f; klr[1] = 1.f;
+                krl[0] = 1.f; krl[1] = 0.f;
+                break;
+            }
+            case 0x06u: {  // stereo
+                klr[0] = 1.f; klr[1] = 1.f;
+                krl[0] = 0.f; krl[1] = 0.f;
+                break;
+            }
+            default: {
+                if (mode == 0x03u) {  // spatial stereo
+                    mode = 0x02u;  // force linear stereo (mute)
+                }
+                break;
+            }
+        }
+
+        // Spatial stereo
+        if (mode == 0x03u) {  // process
+            const float xt = .52f;  // cross-talk
+            klr[0] += xt; klr[1] += xt;
+            krl[0] -= xt; krl[1] -= xt;
+        }
+    }  // not forced mono
+}
+
+
+float aymo_tda8425_calc_volume(uint8_t reg_v, uint8_t reg_sf)
+{
+    double db = (double)aymo_tda8425_reg_v_to_db[reg_v & 0x3Fu];
+
+    if (reg_sf & 0x20u) {  // mute
+        db = -90.;
+    }
+
+    double g = pow(10., (db * .05));
+    return (float)g;
+}
+
+
+void aymo_tda8425_calc_bass(struct aymo_tda8425_biquad* bq, float sample_rate, uint8_t reg_ba)
+{
+    assert(bq);
+    assert(sample_rate > 0.f);
+
+    double dbb = (double)aymo_tda8425_reg_ba_to_db[reg_ba & 0x0Fu];
+    double gb = pow(10., (dbb * (.05 * .5)));
+    double fs = (double)sample_rate;
+    double pi = 3.14159265358979323846264338327950288;
+    double fcb = 300.;  // [Hz]
+    double wb = ((2. * pi) * fcb);
+    double kb = (tan(wb * (.5 / fs)) / wb);
+
+    double a0 = ((kb * wb) + gb);
+    double a1 = ((kb * wb) - gb);
+    double a2 = 0.;
+
+    double b0 = (((kb * wb) * (gb * gb)) + gb);
+    double b1 = (((kb * wb) * (gb * gb)) - gb);
+    double b2 = 0.;
+
+    aymo_tda8425_biquad_store(bq, b0, b1, b2, a0, a1, a2);
+}
+
+
+void aymo_tda8425_calc_treble(struct aymo_tda8425_biquad* bq, float sample_rate, uint8_t reg_tr, uint8_t reg_sf)
+{
+    assert(bq);
+    assert(sample_rate > 0.f);
+
+    double db = (double)aymo_tda8425_reg_tr_to_db[reg_tr & 0x0Fu];
+    double gt = pow(10., (db * (.05 * .5)));
+    double fs = (double)sample_rate;
+    double pi = 3.14159265358979323846264338327950288;
+    double fcd = 10.;  // [Hz]
+    double wd = ((2. * pi) * fcd);
+    double kd = ((reg_sf & 0x40u) ? 0. : (tan(wd * (.5 / fs)) / wd));
+    double fct = 4500.;  // [Hz]
+    double wt = ((2. * pi) * fct);
+    double kt = (tan(wt * (.5 / fs)) / wt);
+
+    double a0 = (((gt * kt * wt) * (kd * wd)) + ((gt * kt * wt) + (kd * wd)) + 1.);
+    double a1 = (((gt * kt * wt) * (kd * wd) * 2.) - 2.);
+    double a2 = (((gt * kt * wt) * (kd * wd)) - ((gt * kt * wt) + (kd * wd)) + 1.);
+
+    double b0 = ((gt * gt) + (gt * kt * wt));
+    double b1 = ((gt * gt) * -2.);
+    double b2 = ((gt * gt) - (gt * kt * wt));
+
+    aymo_tda8425_biquad_store(bq, b0, b1, b2, a0, a1, a2);
+}
+
+
+void aymo_tda8425_calc_tfilter(struct aymo_tda8425_biquad* bq, float sample_rate, uint8_t reg_ba, uint8_t reg_sf)
+{
+    assert(bq);
+    assert(sample_rate > 0.f);
+
+    // T-filter
+    if (reg_sf & 0x80u) {  // pass-through
+        *bq = aymo_tda8425_biquad_pass;
+    }
+    else {  // enabled
+        double db = (double)aymo_tda8425_reg_ba_to_db[reg_ba & 0x0Fu];
+        double g = pow(10., (db * (.05 * .5)));
+        double fs = (double)sample_rate;
+        double pi = 3.14159265358979323846264338327950288;
+        double fc = 180.;  // [Hz]
+        double w = ((2. * pi) * fc);
+        double k = (tan(w * (.5 / fs)) / w);
+
+        double log10_g = log10(g);
+        double ang = (log10_g * .85);
+        double abs_sqrt_log10_g = sqrt(fabs(log10_g));
+        double abs2_sqrt_log10_g = abs_sqrt_log10_g * abs_sqrt_log10_g;
+        double kw = (k * w);
+        double m_k2w2 = ((kw * kw) * -.05);
+        double sqrt_5 = 2.23606797749978980505147774238139391;
+        double ph = (pi * .75);
+        double h_sqrt_5_kw_abs_sqrt_log10_g = ((sqrt_5 * .2) * kw * abs_sqrt_log10_g);
+        double cosm = cos(ang - ph);
+        double cosp = cos(ang + ph);
+
+        double a0 = (((m_k2w2 - abs2_sqrt_log10_g) + (h_sqrt_5_kw_abs_sqrt_log10_g * cosm)));
+        double a1 = (((m_k2w2 + abs2_sqrt_log10_g)) * 2.);
+        double a2 = (((m_k2w2 - abs2_sqrt_log10_g) - (h_sqrt_5_kw_abs_sqrt_log10_g * cosm)));
+
+        double b0 = (((m_k2w2 - abs2_sqrt_log10_g) + (h_sqrt_5_kw_abs_sqrt_log10_g * cosp)));
+        double b1 = a1;
+        double b2 = (((m_k2w2 - abs2_sqrt_log10_g) - (h_sqrt_5_kw_abs_sqrt_log10_g * cosp)));
+
+        aymo_tda8425_biquad_store(bq, b0, b1, b2, a0, a1, a2);
+    }
+}
+
+
+void aymo_tda8425_calc_pseudo(struct aymo_tda8425_biquad* bq, float sample_rate, uint8_t reg_pp, uint8_t reg_sf)
+{
+    assert(bq);
+    assert(sample_rate > 0.f);
+
+    uint8_t mode = ((reg_sf >> 3u) & 0x03u);
+
+    // Pseudo stereo
+    if (mode == 0x02u) {  // enabled
+        uint8_t pseudo_preset = aymo_tda8425_pseudo_preset(reg_pp);
+        double c1 = (double)aymo_tda8425_pseudo_preset_c1[pseudo_preset];
+        double c2 = (double)aymo_tda8425_pseudo_preset_c2[pseudo_preset];
+        double r1 = 15000.;  // [ohm]
+        double r2 = 15000.;  // [ohm]
+        double t1 = (c1 * r1);
+        double t2 = (c2 * r2);
+
+        double fs = (double)sample_rate;
+        double k = (.5 / fs);
+        double kk = (k * k);
+        double t1_t2 = (t1 * t2);
+        double t1_t2_k = ((t1 + t2) * k);
+
+        double a0 = (kk + t1_t2 + t1_t2_k);
+        double a1 = ((kk - t1_t2) * 2.);
+        double a2 = (kk + t1_t2 - t1_t2_k);
+
+        double b0 = a2;
+        double b1 = a1;
+        double b2 = a0;
+
+        aymo_tda8425_biquad_store(bq, b0, b1, b2, a0, a1, a2);
+    }
+    else {  // pass-through
+        *bq = aymo_tda8425_biquad_pass;
+    }
+}
+
+
+void aymo_tda8425_coeffs_ctor(struct aymo_tda8425_coeffs* coeffs, float sample_rate)
+{
+    assert(coeffs);
+    assert(sample_rate > 0.f);
+
+    aymo_memset(coeffs, 0, sizeof(*coeffs));
+    coeffs->sample_rate = sample_rate;
+}
+
+
+void aymo_tda8425_coeffs_fill(struct aymo_tda8425_coeffs* coeffs)
+{
+    assert(coeffs);
+
+    float sample_rate = coeffs->sample_rate;
+    struct aymo_tda8425_biquad tmp;  // unused with a cache
+
+    for (unsigned index = 0u; index < 64u; ++index) {
+        (void)aymo_tda8425_lookup_volume(coeffs, (uint8_t)index, 0x00u);
+    }
+    for (unsigned index = 0u; index < 16u; ++index) {
+        (void)aymo_tda8425_lookup_bass(coeffs, &tmp, sample_rate, (uint8_t)index);
+        (void)aymo_tda8425_lookup_treble(coeffs, &tmp, sample_rate, (uint8_t)index, 0x00u);
+        (void)aymo_tda8425_lookup_treble(coeffs, &tmp, sample_rate, (uint8_t)index, 0x40u);
+        (void)aymo_tda8425_lookup_tfilter(coeffs, &tmp, sample_rate, (uint8_t)index, 0x00u);
+    }
+    for (unsigned index = 0u; index < 3u; ++index) {
+        (void)aymo_tda8425_lookup_pseudo(coeffs, &tmp, sample_rate, (uint8_t)index, 0x10u);
+    }
+}
+
+
+float aymo_tda8425_lookup_volume(struct aymo_tda8425_coeffs* coeffs, uint8_t reg_v, uint8_t reg_sf)
+{
+    if (!coeffs) {
+        return aymo_tda8425_calc_volume(reg_v, reg_sf);
+    }
+
+    // Mute shares the -90 dB entry of the lowest settings
+    unsigned index = ((reg_sf & 0x20u) ? 0u : (reg_v & 0x3Fu));
+    uint64_t mask = ((uint64_t)1u << index);
+
+    if AYMO_UNLIKELY(!(coeffs->volume_valid & mask)) {
+        coeffs->volume[index] = aymo_tda8425_calc_volume((uint8_t)index, 0x00u);
+        coeffs->volume_valid |= mask;
+    }
+    return coeffs->volume[index];
+}
+
+
+const struct aymo_tda8425_biquad* aymo_tda8425_lookup_bass(
+    struct aymo_tda8425_coeffs* coeffs,
+    struct aymo_tda8425_biquad* tmp,
+    float sample_rate,
+    uint8_t reg_ba
+)
+{
+    if (!coeffs) {
+        aymo_tda8425_calc_bass(tmp, sample_rate, reg_ba);
+        return tmp;
+    }
+    assert(coeffs->sample_rate == sample_rate);
+
+    unsigned index = (reg_ba & 0x0Fu);
+    uint32_t mask = (1uL << index);
+
+    if AYMO_UNLIKELY(!(coeffs->bass_valid & mask)) {
+        aymo_tda8425_calc_bass(&coeffs->bass[index], sample_rate, (uint8_t)index);
+        coeffs->bass_valid |= mask;
+    }
+    return &coeffs->bass[index];
+}
+
+
+const struct aymo_tda8425_biquad* aymo_tda8425_lookup_treble(
+    struct aymo_tda8425_coeffs* coeffs,
+    struct aymo_tda8425_biquad* tmp,
+    float sample_rate,
+    uint8_t reg_tr,
+    uint8_t reg_sf
+)
+{
+    if (!coeffs) {
+        aymo_tda8425_calc_treble(tmp, sample_rate, reg_tr, reg_sf);
+        return tmp;
+    }
+    assert(coeffs->sample_rate == sample_rate);
+
+    unsigned bank = ((reg_sf >> 6u) & 0x01u);
+    unsigned index = ((bank << 4u) | (reg_tr & 0x0Fu));
+    uint32_t mask = (1uL << index);
+
+    if AYMO_UNLIKELY(!(coeffs->treble_valid & mask)) {
+        aymo_tda8425_calc_treble(&coeffs->treble[bank][index & 0x0Fu], sample_rate, (uint8_t)index, (uint8_t)(bank << 6u));
+        coeffs->treble_valid |= mask;
+    }
+    return &coeffs->treble[bank][index & 0x0Fu];
+}
+
+
+const struct aymo_tda8425_biquad* aymo_tda8425_lookup_tfilter(
+    struct aymo_tda8425_coeffs* coeffs,
+    struct aymo_tda8425_biquad* tmp,
+    float sample_rate,
+    uint8_t reg_ba,
+    uint8_t reg_sf
+)
+{
+    if (!coeffs) {
+        aymo_tda8425_calc_tfilter(tmp, sample_rate, reg_ba, reg_sf);
+        return tmp;
+    }
+    assert(coeffs->sample_rate == sample_rate);
+
+    if (reg_sf & 0x80u) {  // pass-through
+        return &aymo_tda8425_biquad_pass;
+    }
+
+    unsigned index = (reg_ba & 0x0Fu);
+    uint32_t mask = (1uL << index);
+
+    if AYMO_UNLIKELY(!(coeffs->tfilter_valid & mask)) {
+        aymo_tda8425_calc_tfilter(&coeffs->tfilter[index], sample_rate, (uint8_t)index, 0x00u);
+        coeffs->tfilter_valid |= mask;
+    }
+    return &coeffs->tfilter[index];
+}
+
+
+const struct aymo_tda8425_biquad* aymo_tda8425_lookup_pseudo(
+    struct aymo_tda8425_coeffs* coeffs,
+    struct aymo_tda8425_biquad* tmp,
+    float sample_rate,
+    uint8_t reg_pp,
+    uint8_t reg_sf
+)
+{
+    if (!coeffs) {
+        aymo_tda8425_calc_pseudo(tmp, sample_rate, reg_pp, reg_sf);
+        return tmp;
+    }
+    assert(coeffs->sample_rate == sample_rate);
+
+    uint8_t mode = ((reg_sf >> 3u) & 0x03u);
+    if (mode != 0x02u) {  // pass-through
+        return &aymo_tda8425_biquad_pass;
+    }
+
+    unsigned index = aymo_tda8425_pseudo_preset(reg_pp);
+    uint32_t mask = (1uL << index);
+
+    if AYMO_UNLIKELY(!(coeffs->pseudo_valid & mask)) {
+        aymo_tda8425_calc_pseudo(&coeffs->pseudo[index], sample_rate, (uint8_t)index, 0x10u);
+        coeffs->pseudo_valid |= mask;
+    }
+    return &coeffs->pseudo[index];
+}
+
+
+
+static struct aymo_tda8425_chip* aymo_tda8425_chips_at(struct aymo_tda8425_chip* chips, uint32_t chip_size, uint32_t index)
+{
+    return (struct aymo_tda8425_chip*)(void*)((uint8_t*)(void*)chips + ((size_t)index * chip_size));
+}
+
+
+void aymo_tda8425_chips_process_f32(
+    struct aymo_tda8425_chip* chips,
+    uint32_t chip_size,
+    uint32_t instances,
+    uint32_t count,
+    const float* const x[],
+    float* const y[]
+)
+{
+    assert(chips);
+    assert(x);
+    assert(y);
+
+    float silence[AYMO_TDA8425_CHIPS_BLOCK * 2u];
+    float discard[AYMO_TDA8425_CHIPS_BLOCK * 2u];
+    aymo_memset(silence, 0, sizeof(silence));
+
+    for (uint32_t i = 0u; i < instances; ++i) {
+        struct aymo_tda8425_chip* chip = aymo_tda8425_chips_at(chips, chip_size, i);
+        const float* xi = x[i];
+        float* yi = y[i];
+
+        if (xi && yi) {
+            chip->vt->process_f32(chip, count, xi, yi);
+            continue;
+        }
+
+        for (uint32_t n = 0u; n < count; ) {
+            uint32_t block = (count - n);
+            if (block > AYMO_TDA8425_CHIPS_BLOCK) {
+                block = AYMO_TDA8425_CHIPS_BLOCK;
+            }
+            chip->vt->process_f32(chip, block, (xi ? &xi[n * 2u] : silence), (yi ? &yi[n * 2u] : discard));
+            n += block;
+        }
+    }
+}
+
+
+void aymo_tda8425_chips_process_f32_interleaved(
+    struct aymo_tda8425_chip* chips,
+    uint32_t chip_size,
+    uint32_t instances,
+    uint32_t count,
+    const float x[],
+    float y[]
+)
+{
+    assert(chips);
+    assert(x);
+    assert(y);
+
+    float xb[AYMO_TDA8425_CHIPS_BLOCK * 2u];
+    float yb[AYMO_TDA8425_CHIPS_BLOCK * 2u];
+    size_t stride = ((size_t)instances * 2u);
+
+    for (uint32_t i = 0u; i < instances; ++i) {
+        struct aymo_tda8425_chip* chip = aymo_tda8425_chips_at(chips, chip_size, i);
+        const float* xi = &x[i * 2u];
+        float* yi = &y[i * 2u];
+
+        for (uint32_t n = 0u; n < count; ) {
+            uint32_t block = (count - n);
+            if (block > AYMO_TDA8425_CHIPS_BLOCK) {
+                block = AYMO_TDA8425_CHIPS_BLOCK;
+            }
+            for (uint32_t k = 0u; k < block; ++k) {
+                xb[(k * 2u) + 0u] = xi[((n + k) * stride) + 0u];
+                xb[(k * 2u) + 1u] = xi[((n + k) * stride) + 1u];
+            }
+            chip->vt->process_f32(chip, block, xb, yb);
+            for (uint32_t k = 0u; k < block; ++k) {
+                yi[((n + k) * stride) + 0u] = yb[(k * 2u) + 0u];
+                yi[((n + k) * stride) + 1u] = yb[(k * 2u) + 1u];
+            }
+            n += block;
+        }
+    }
+}
+
+
 AYMO_CXX_EXTERN_C_END
@@ -37,7 +37,11 @@ const struct aymo_tda8425_vt aymo_(vt) =
     (aymo_tda8425_dtor_f)&(aymo_(dtor)),
     (aymo_tda8425_read_f)&(aymo_(read)),
     (aymo_tda8425_write_f)&(aymo_(write)),
-    (aymo_tda8425_process_f32_f)&(aymo_(process_f32))
+    (aymo_tda8425_process_f32_f)&(aymo_(process_f32)),
+    (aymo_tda8425_process_i16_f)&(aymo_(process_i16)),
+    (aymo_tda8425_set_coeffs_f)&(aymo_(set_coeffs)),
+    (aymo_tda8425_set_smoothing_f)&(aymo_(set_smoothing)),
+    (aymo_tda8425_set_silence_f)&(aymo_(set_silence))
 };
 
 
@@ -105,4 +109,49 @@ void aymo_(process_f32)(struct aymo_(chip)* chip, uint32_t count, const float x[
 }
 
 
+void aymo_(process_i16)(struct aymo_(chip)* chip, uint32_t count, const int16_t x[], int16_t y[])
+{
+    AYMO_UNUSED_VAR(chip);
+    AYMO_UNUSED_VAR(count);
+    AYMO_UNUSED_VAR(x);
+    AYMO_UNUSED_VAR(y);
+    assert(chip);
+    assert(x);
+    assert(y);
+
+    // not supported
+}
+
+
+void aymo_(set_coeffs)(struct aymo_(chip)* chip, struct aymo_tda8425_coeffs* coeffs)
+{
+    AYMO_UNUSED_VAR(chip);
+    AYMO_UNUSED_VAR(coeffs);
+    assert(chip);
+
+    // not supported
+}
+
+
+void aymo_(set_smoothing)(struct aymo_(chip)* chip, uint32_t frames)
+{
+    AYMO_UNUSED_VAR(chip);
+    AYMO_UNUSED_VAR(frames);
+    assert(chip);
+
+    // not supported
+}
+
+
+void aymo_(set_silence)(struct aymo_(chip)* chip, float threshold)
+{
+    AYMO_UNUSED_VAR(chip);
+    AYMO_UNUSED_VAR(threshold);
+    assert(chip);
+    assert(threshold >= 0.f);
+
+    // not supported
+}
+
+
 AYMO_CXX_EXTERN_C_END
@@ -38,7 +38,11 @@ const struct aymo_tda8425_vt aymo_(vt) =
     (aymo_tda8425_dtor_f)&(aymo_(dtor)),
     (aymo_tda8425_read_f)&(aymo_(read)),
     (aymo_tda8425_write_f)&(aymo_(write)),
-    (aymo_tda8425_process_f32_f)&(aymo_(process_f32))
+    (aymo_tda8425_process_f32_f)&(aymo_(process_f32)),
+    (aymo_tda8425_process_i16_f)&(aymo_(process_i16)),
+    (aymo_tda8425_set_coeffs_f)&(aymo_(set_coeffs)),
+    (aymo_tda8425_set_smoothing_f)&(aymo_(set_smoothing)),
+    (aymo_tda8425_set_silence_f)&(aymo_(set_silence))
 };
 
 
@@ -120,12 +124,8 @@ void aymo_(write)(struct aymo_(chip)* chip, uint16_t address, uint8_t value)
 }
 
 
-void aymo_(process_f32)(struct aymo_(chip)* chip, uint32_t count, const float x[], float y[])
+static void aymo_(run_f32)(struct aymo_(chip)* chip, uint32_t count, const float x[], float y[])
 {
-    assert(chip);
-    assert(x);
-    assert(y);
-
     TDA8425_Chip* emu = &chip->emu;
     TDA8425_Chip_Process_Data data;
     data.inputs[TDA8425_Source_2][TDA8425_Stereo_L] = (TDA8425_Float)0.f;
@@ -150,4 +150,193 @@ void aymo_(process_f32)(struct aymo_(chip)* chip, uint32_t count, const float x[
 }
 
 
+void aymo_(process_f32)(struct aymo_(chip)* chip, uint32_t count, const float x[], float y[])
+{
+    assert(chip);
+    assert(x);
+    assert(y);
+
+    aymo_cpu_fpstate_t fpstate = aymo_cpu_enter_ftz();
+    aymo_(run_f32)(chip, count, x, y);
+    aymo_cpu_leave_ftz(fpstate);
+}
+
+
+static inline int16_t aymo_(f32_i16_1)(float f)
+{
+    f *= 32768.f;
+    f += ((f < 0.f) ? -.5f : .5f);
+    if (f >= (float)INT16_MAX) {
+        return INT16_MAX;
+    }
+    if (f <= (float)INT16_MIN) {
+        return INT16_MIN;
+    }
+    return (int16_t)f;
+}
+
+
+// The wrapped emulator is the float reference model: convert on the fly
+void aymo_(process_i16)(struct aymo_(chip)* chip, uint32_t count, const int16_t x[], int16_t y[])
+{
+    assert(chip);
+    assert(x);
+    assert(y);
+
+    const float scale = (float)(1. / 32768.);
+    float xf[2];
+    float yf[2];
+
+    aymo_cpu_fpstate_t fpstate = aymo_cpu_enter_ftz();
+
+    while (count--) {
+        xf[0] = ((float)*x++ * scale);
+        xf[1] = ((float)*x++ * scale);
+
+        aymo_(run_f32)(chip, 1u, xf, yf);
+
+        *y++ = aymo_(f32_i16_1)(yf[0]);
+        *y++ = aymo_(f32_i16_1)(yf[1]);
+    }
+
+    aymo_cpu_leave_ftz(fpstate);
+}
+
+
+void aymo_(set_coeffs)(struct aymo_(chip)* chip, struct aymo_tda8425_coeffs* coeffs)
+{
+    AYMO_UNUSED_VAR(chip);
+    AYMO_UNUSED_VAR(coeffs);
+    assert(chip);
+
+    // not supported
+}
+
+
+void aymo_(set_smoothing)(struct aymo_(chip)* chip, uint32_t frames)
+{
+    AYMO_UNUSED_VAR(chip);
+    AYMO_UNUSED_VAR(frames);
+    assert(chip);
+
+    // not supported
+}
+
+
+void aymo_(set_silence)(struct aymo_(chip)* chip, float threshold)
+{
+    AYMO_UNUSED_VAR(chip);
+    AYMO_UNUSED_VAR(threshold);
+    assert(chip);
+    assert(threshold >= 0.f);
+
+    // not supported
+}
+
+
+const struct aymo_tda8425_bank_vt aymo_(bank_vt) =
+{
+    AYMO_STRINGIFY2(aymo_(bank_vt)),
+    (aymo_tda8425_bank_get_sizeof_f)&(aymo_(bank_get_sizeof)),
+    (aymo_tda8425_bank_ctor_f)&(aymo_(bank_ctor)),
+    (aymo_tda8425_bank_dtor_f)&(aymo_(bank_dtor)),
+    (aymo_tda8425_bank_read_f)&(aymo_(bank_read)),
+    (aymo_tda8425_bank_write_f)&(aymo_(bank_write)),
+    (aymo_tda8425_bank_process_f32_f)&(aymo_(bank_process_f32)),
+    (aymo_tda8425_bank_process_f32_interleaved_f)&(aymo_(bank_process_f32_interleaved)),
+    (aymo_tda8425_bank_set_coeffs_f)&(aymo_(bank_set_coeffs))
+};
+
+
+const struct aymo_tda8425_bank_vt* aymo_(get_bank_vt)(void)
+{
+    return &aymo_(bank_vt);
+}
+
+
+static inline struct aymo_(chip)* aymo_(bank_chips)(struct aymo_(bank)* bank)
+{
+    return (struct aymo_(chip)*)(void*)(bank + 1);
+}
+
+
+uint32_t aymo_(bank_get_sizeof)(uint32_t instances)
+{
+    return (uint32_t)(sizeof(struct aymo_(bank)) + (instances * sizeof(struct aymo_(chip))));
+}
+
+
+void aymo_(bank_ctor)(struct aymo_(bank)* bank, uint32_t instances, float sample_rate)
+{
+    assert(bank);
+    assert(sample_rate > 0.f);
+
+    bank->parent.instances = instances;
+
+    struct aymo_(chip)* chips = aymo_(bank_chips)(bank);
+    for (uint32_t i = 0u; i < instances; ++i) {
+        chips[i].parent.vt = &aymo_(vt);
+        aymo_(ctor)(&chips[i], sample_rate);
+    }
+}
+
+
+void aymo_(bank_dtor)(struct aymo_(bank)* bank)
+{
+    assert(bank);
+
+    struct aymo_(chip)* chips = aymo_(bank_chips)(bank);
+    for (uint32_t i = 0u; i < bank->parent.instances; ++i) {
+        aymo_(dtor)(&chips[i]);
+    }
+}
+
+
+uint8_t aymo_(bank_read)(struct aymo_(bank)* bank, uint32_t index, uint16_t address)
+{
+    assert(bank);
+    assert(index < bank->parent.instances);
+
+    return aymo_(read)(&aymo_(bank_chips)(bank)[index], address);
+}
+
+
+void aymo_(bank_write)(struct aymo_(bank)* bank, uint32_t index, uint16_t address, uint8_t value)
+{
+    assert(bank);
+    assert(index < bank->parent.instances);
+
+    aymo_(write)(&aymo_(bank_chips)(bank)[index], address, value);
+}
+
+
+void aymo_(bank_process_f32)(struct aymo_(bank)* bank, uint32_t count, const float* const x[], float* const y[])
+{
+    assert(bank);
+
+    aymo_tda8425_chips_process_f32(&aymo_(bank_chips)(bank)->parent, sizeof(struct aymo_(chip)),
+                                   bank->parent.instances, count, x, y);
+}
+
+
+void aymo_(bank_process_f32_interleaved)(struct aymo_(bank)* bank, uint32_t count, const float x[], float y[])
+{
+    assert(bank);
+
+    aymo_tda8425_chips_process_f32_interleaved(&aymo_(bank_chips)(bank)->parent, sizeof(struct aymo_(chip)),
+                                               bank->parent.instances, count, x, y);
+}
+
+
+void aymo_(bank_set_coeffs)(struct aymo_(bank)* bank, struct aymo_tda8425_coeffs* coeffs)
+{
+    assert(bank);
+
+    struct aymo_(chip)* chips = aymo_(bank_chips)(bank);
+    for (uint32_t i = 0u; i < bank->parent.instances; ++i) {
+        aymo_(set_coeffs)(&chips[i], coeffs);
+    }
+}
+
+
 AYMO_CXX_EXTERN_C_END
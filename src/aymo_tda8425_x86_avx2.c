@@ -29,21 +29,6 @@ along with AYMO. If not, see <https://www.gnu.org/licenses/>.
 
 AYMO_CXX_EXTERN_C_BEGIN
 
-#undef cos
-#undef fabs
-#undef log10
-#undef pow
-#undef sqrt
-#undef tan
-
-#define cos     (aymo_tda8425_math->cos)
-#define fabs    (aymo_tda8425_math->fabs)
-#define log10   (aymo_tda8425_math->log10)
-#define pow     (aymo_tda8425_math->pow)
-#define sqrt    (aymo_tda8425_math->sqrt)
-#define tan     (aymo_tda8425_math->tan)
-
-
 #undef mm256_alignr_ps
 #define mm256_alignr_ps(a, b, imm8)  \
     (_mm256_castsi256_ps(_mm256_alignr_epi8(_mm256_castps_si256(a), _mm256_castps_si256(b), ((imm8) * 4))))
@@ -57,7 +42,11 @@ const struct aymo_tda8425_vt aymo_(vt) =
     (aymo_tda8425_dtor_f)&(aymo_(dtor)),
     (aymo_tda8425_read_f)&(aymo_(read)),
     (aymo_tda8425_write_f)&(aymo_(write)),
-    (aymo_tda8425_process_f32_f)&(aymo_(process_f32))
+    (aymo_tda8425_process_f32_f)&(aymo_(process_f32)),
+    (aymo_tda8425_process_i16_f)&(aymo_(process_i16)),
+    (aymo_tda8425_set_coeffs_f)&(aymo_(set_coeffs)),
+    (aymo_tda8425_set_smoothing_f)&(aymo_(set_smoothing)),
+    (aymo_tda8425_set_silence_f)&(aymo_(set_silence))
 };
 
 
@@ -103,90 +92,48 @@ void aymo_(dtor)(struct aymo_(chip)* chip)
 }
 
 
-static void aymo_(apply_vl)(struct aymo_(chip)* chip)
+// Stores biquad coefficients into the target lanes selected by mask
+static void aymo_(store_biquad)(struct aymo_(chip)* chip, const struct aymo_tda8425_biquad* bq, vf32x8_t mask)
 {
-    double db = (double)aymo_tda8425_reg_v_to_db[chip->reg_vl & 0x3Fu];
+    chip->tkb0 = _mm256_blendv_ps(chip->tkb0, _mm256_set1_ps(bq->kb0), mask);
+    chip->tkb1 = _mm256_blendv_ps(chip->tkb1, _mm256_set1_ps(bq->kb1), mask);
+    chip->tkb2 = _mm256_blendv_ps(chip->tkb2, _mm256_set1_ps(bq->kb2), mask);
+    chip->tka1 = _mm256_blendv_ps(chip->tka1, _mm256_set1_ps(bq->ka1), mask);
+    chip->tka2 = _mm256_blendv_ps(chip->tka2, _mm256_set1_ps(bq->ka2), mask);
+}
 
-    if (chip->reg_sf & 0x20u) {  // mute
-        db = -90.;
-    }
 
-    double g = pow(10., (db * .05));
-    vf32x4_t kvlo = _mm_set_ps((float)g, .0f, .0f, .0f);
-    chip->kv = _mm256_insertf128_ps(chip->kv, kvlo, 0);
+static void aymo_(apply_vl)(struct aymo_(chip)* chip)
+{
+    float g = aymo_tda8425_lookup_volume(chip->coeffs, chip->reg_vl, chip->reg_sf);
+    vf32x4_t kvlo = _mm_set_ps(g, .0f, .0f, .0f);
+    chip->tkv = _mm256_insertf128_ps(chip->tkv, kvlo, 0);
 }
 
 
 static void aymo_(apply_vr)(struct aymo_(chip)* chip)
 {
-    double db = (double)aymo_tda8425_reg_v_to_db[chip->reg_vr & 0x3Fu];
-
-    if (chip->reg_sf & 0x20u) {  // mute
-        db = -90.;
-    }
-
-    double g = pow(10., (db * .05));
-    vf32x4_t kvhi = _mm_set_ps((float)g, .0f, .0f, .0f);
-    chip->kv = _mm256_insertf128_ps(chip->kv, kvhi, 1);
+    float g = aymo_tda8425_lookup_volume(chip->coeffs, chip->reg_vr, chip->reg_sf);
+    vf32x4_t kvhi = _mm_set_ps(g, .0f, .0f, .0f);
+    chip->tkv = _mm256_insertf128_ps(chip->tkv, kvhi, 1);
 }
 
 
 static void aymo_(apply_ba)(struct aymo_(chip)* chip)
 {
-    double dbb = (double)aymo_tda8425_reg_ba_to_db[chip->reg_ba & 0x0Fu];
-    double gb = pow(10., (dbb * (.05 * .5)));
-    double fs = (double)chip->sample_rate;
-    double pi = 3.14159265358979323846264338327950288;
-    double fcb = 300.;  // [Hz]
-    double wb = ((2. * pi) * fcb);
-    double kb = (tan(wb * (.5 / fs)) / wb);
-
-    double a0 = ((kb * wb) + gb);
-    double a1 = ((kb * wb) - gb);
-    double a2 = 0.;
-
-    double b0 = (((kb * wb) * (gb * gb)) + gb);
-    double b1 = (((kb * wb) * (gb * gb)) - gb);
-    double b2 = 0.;
-
-    double ra0 = (1. / a0);
-    chip->kb0 = _mm256_blend_ps(chip->kb0, _mm256_set1_ps((float)(b0 * ra0)), 0x44);
-    chip->kb1 = _mm256_blend_ps(chip->kb1, _mm256_set1_ps((float)(b1 * ra0)), 0x44);
-    chip->kb2 = _mm256_blend_ps(chip->kb2, _mm256_set1_ps((float)(b2 * ra0)), 0x44);
-    ra0 = -ra0;
-    chip->ka1 = _mm256_blend_ps(chip->ka1, _mm256_set1_ps((float)(a1 * ra0)), 0x44);
-    chip->ka2 = _mm256_blend_ps(chip->ka2, _mm256_set1_ps((float)(a2 * ra0)), 0x44);
+    struct aymo_tda8425_biquad tmp;
+    const struct aymo_tda8425_biquad* bq =
+        aymo_tda8425_lookup_bass(chip->coeffs, &tmp, chip->sample_rate, chip->reg_ba);
+    aymo_(store_biquad)(chip, bq, _mm256_castsi256_ps(_mm256_set_epi32(0, -1, 0, 0, 0, -1, 0, 0)));
 }
 
 
 static void aymo_(apply_tr)(struct aymo_(chip)* chip)
 {
-    double db = (double)aymo_tda8425_reg_tr_to_db[chip->reg_tr & 0x0Fu];
-    double gt = pow(10., (db * (.05 * .5)));
-    double fs = (double)chip->sample_rate;
-    double pi = 3.14159265358979323846264338327950288;
-    double fcd = 10.;  // [Hz]
-    double wd = ((2. * pi) * fcd);
-    double kd = ((chip->reg_sf & 0x40u) ? 0. : (tan(wd * (.5 / fs)) / wd));
-    double fct = 4500.;  // [Hz]
-    double wt = ((2. * pi) * fct);
-    double kt = (tan(wt * (.5 / fs)) / wt);
-
-    double a0 = (((gt * kt * wt) * (kd * wd)) + ((gt * kt * wt) + (kd * wd)) + 1.);
-    double a1 = (((gt * kt * wt) * (kd * wd) * 2.) - 2.);
-    double a2 = (((gt * kt * wt) * (kd * wd)) - ((gt * kt * wt) + (kd * wd)) + 1.);
-
-    double b0 = ((gt * gt) + (gt * kt * wt));
-    double b1 = ((gt * gt) * -2.);
-    double b2 = ((gt * gt) - (gt * kt * wt));
-
-    double ra0 = (1. / a0);
-    chip->kb0 = _mm256_blend_ps(chip->kb0, _mm256_set1_ps((float)(b0 * ra0)), 0x22);
-    chip->kb1 = _mm256_blend_ps(chip->kb1, _mm256_set1_ps((float)(b1 * ra0)), 0x22);
-    chip->kb2 = _mm256_blend_ps(chip->kb2, _mm256_set1_ps((float)(b2 * ra0)), 0x22);
-    ra0 = -ra0;
-    chip->ka1 = _mm256_blend_ps(chip->ka1, _mm256_set1_ps((float)(a1 * ra0)), 0x22);
-    chip->ka2 = _mm256_blend_ps(chip->ka2, _mm256_set1_ps((float)(a2 * ra0)), 0x22);
+    struct aymo_tda8425_biquad tmp;
+    const struct aymo_tda8425_biquad* bq =
+        aymo_tda8425_lookup_treble(chip->coeffs, &tmp, chip->sample_rate, chip->reg_tr, chip->reg_sf);
+    aymo_(store_biquad)(chip, bq, _mm256_castsi256_ps(_mm256_set_epi32(0, 0, -1, 0, 0, 0, -1, 0)));
 }
 
 
@@ -247,105 +194,26 @@ static void aymo_(apply_source_mode)(struct aymo_(chip)* chip)
         }
     }  // not forced mono
 
-    chip->klr = klr;
-    chip->krl = krl;
+    chip->tklr = klr;
+    chip->tkrl = krl;
 }
 
 
 static void aymo_(apply_pseudo)(struct aymo_(chip)* chip)
 {
-    uint8_t mode = ((chip->reg_sf >> 3u) & 0x03u);
-
-    // Pseudo stereo
-    if (mode == 0x02u) {  // enabled
-        double c1 = (double)chip->pseudo_c1;
-        double c2 = (double)chip->pseudo_c2;
-        double r1 = 15000.;  // [ohm]
-        double r2 = 15000.;  // [ohm]
-        double t1 = (c1 * r1);
-        double t2 = (c2 * r2);
-
-        double fs = (double)chip->sample_rate;
-        double k = (.5 / fs);
-        double kk = (k * k);
-        double t1_t2 = (t1 * t2);
-        double t1_t2_k = ((t1 + t2) * k);
-
-        double a0 = (kk + t1_t2 + t1_t2_k);
-        double a1 = ((kk - t1_t2) * 2.);
-        double a2 = (kk + t1_t2 - t1_t2_k);
-
-        double b0 = a2;
-        double b1 = a1;
-        double b2 = a0;
-
-        double ra0 = (1. / a0);
-        chip->kb0 = _mm256_blend_ps(chip->kb0, _mm256_set1_ps((float)(b0 * ra0)), 0x11);
-        chip->kb1 = _mm256_blend_ps(chip->kb1, _mm256_set1_ps((float)(b1 * ra0)), 0x11);
-        chip->kb2 = _mm256_blend_ps(chip->kb2, _mm256_set1_ps((float)(b2 * ra0)), 0x11);
-        ra0 = -ra0;
-        chip->ka1 = _mm256_blend_ps(chip->ka1, _mm256_set1_ps((float)(a1 * ra0)), 0x11);
-        chip->ka2 = _mm256_blend_ps(chip->ka2, _mm256_set1_ps((float)(a2 * ra0)), 0x11);
-    }
-    else {  // pass-through
-        chip->kb0 = _mm256_blend_ps(chip->kb0, _mm256_set1_ps(1.f), 0x11);
-        chip->kb1 = _mm256_blend_ps(chip->kb1, _mm256_set1_ps(.0f), 0x11);
-        chip->kb2 = _mm256_blend_ps(chip->kb2, _mm256_set1_ps(.0f), 0x11);
-
-        chip->ka1 = _mm256_blend_ps(chip->ka1, _mm256_set1_ps(.0f), 0x11);
-        chip->ka2 = _mm256_blend_ps(chip->ka2, _mm256_set1_ps(.0f), 0x11);
-    }
+    struct aymo_tda8425_biquad tmp;
+    const struct aymo_tda8425_biquad* bq =
+        aymo_tda8425_lookup_pseudo(chip->coeffs, &tmp, chip->sample_rate, chip->reg_pp, chip->reg_sf);
+    aymo_(store_biquad)(chip, bq, _mm256_castsi256_ps(_mm256_set_epi32(0, 0, 0, -1, 0, 0, 0, -1)));
 }
 
 
 static void aymo_(apply_tfilter)(struct aymo_(chip)* chip)
 {
-    // T-filter
-    if (chip->reg_sf & 0x80u) {  // pass-through
-        chip->kb0 = _mm256_blend_ps(chip->kb0, _mm256_set1_ps(1.f), 0x88);
-        chip->kb1 = _mm256_blend_ps(chip->kb1, _mm256_set1_ps(.0f), 0x88);
-        chip->kb2 = _mm256_blend_ps(chip->kb2, _mm256_set1_ps(.0f), 0x88);
-
-        chip->ka1 = _mm256_blend_ps(chip->ka1, _mm256_set1_ps(.0f), 0x88);
-        chip->ka2 = _mm256_blend_ps(chip->ka2, _mm256_set1_ps(.0f), 0x88);
-    }
-    else {  // enabled
-        double db = (double)aymo_tda8425_reg_ba_to_db[chip->reg_ba & 0x0Fu];
-        double g = pow(10., (db * (.05 * .5)));
-        double fs = (double)chip->sample_rate;
-        double pi = 3.14159265358979323846264338327950288;
-        double fc = 180.;  // [Hz]
-        double w = ((2. * pi) * fc);
-        double k = (tan(w * (.5 / fs)) / w);
-
-        double log10_g = log10(g);
-        double ang = (log10_g * .85);
-        double abs_sqrt_log10_g = sqrt(fabs(log10_g));
-        double abs2_sqrt_log10_g = abs_sqrt_log10_g * abs_sqrt_log10_g;
-        double kw = (k * w);
-        double m_k2w2 = ((kw * kw) * -.05);
-        double sqrt_5 = 2.23606797749978980505147774238139391;
-        double ph = (pi * .75);
-        double h_sqrt_5_kw_abs_sqrt_log10_g = ((sqrt_5 * .2) * kw * abs_sqrt_log10_g);
-        double cosm = cos(ang - ph);
-        double cosp = cos(ang + ph);
-
-        double a0 = (((m_k2w2 - abs2_sqrt_log10_g) + (h_sqrt_5_kw_abs_sqrt_log10_g * cosm)));
-        double a1 = (((m_k2w2 + abs2_sqrt_log10_g)) * 2.);
-        double a2 = (((m_k2w2 - abs2_sqrt_log10_g) - (h_sqrt_5_kw_abs_sqrt_log10_g * cosm)));
-
-        double b0 = (((m_k2w2 - abs2_sqrt_log10_g) + (h_sqrt_5_kw_abs_sqrt_log10_g * cosp)));
-        double b1 = a1;
-        double b2 = (((m_k2w2 - abs2_sqrt_log10_g) - (h_sqrt_5_kw_abs_sqrt_log10_g * cosp)));
-
-        double ra0 = (1. / a0);
-        chip->kb0 = _mm256_blend_ps(chip->kb0, _mm256_set1_ps((float)(b0 * ra0)), 0x88);
-        chip->kb1 = _mm256_blend_ps(chip->kb1, _mm256_set1_ps((float)(b1 * ra0)), 0x88);
-        chip->kb2 = _mm256_blend_ps(chip->kb2, _mm256_set1_ps((float)(b2 * ra0)), 0x88);
-        ra0 = -ra0;
-        chip->ka1 = _mm256_blend_ps(chip->ka1, _mm256_set1_ps((float)(a1 * ra0)), 0x88);
-        chip->ka2 = _mm256_blend_ps(chip->ka2, _mm256_set1_ps((float)(a2 * ra0)), 0x88);
-    }
+    struct aymo_tda8425_biquad tmp;
+    const struct aymo_tda8425_biquad* bq =
+        aymo_tda8425_lookup_tfilter(chip->coeffs, &tmp, chip->sample_rate, chip->reg_ba, chip->reg_sf);
+    aymo_(store_biquad)(chip, bq, _mm256_castsi256_ps(_mm256_set_epi32(-1, 0, 0, 0, -1, 0, 0, 0)));
 }
 
 
@@ -360,6 +228,57 @@ static void aymo_(apply_pp)(struct aymo_(chip)* chip)
 }
 
 
+// Applies the coefficient targets at once, ending any ramp
+static void aymo_(snap)(struct aymo_(chip)* chip)
+{
+    chip->kb2 = chip->tkb2;
+    chip->ka2 = chip->tka2;
+    chip->kb1 = chip->tkb1;
+    chip->ka1 = chip->tka1;
+    chip->krl = chip->tkrl;
+    chip->klr = chip->tklr;
+    chip->kb0 = chip->tkb0;
+    chip->kv = chip->tkv;
+    chip->smooth_left = 0u;
+}
+
+
+// Moves the coefficients one ramp step towards their targets
+static void aymo_(ramp)(struct aymo_(chip)* chip)
+{
+    chip->kb2 = _mm256_add_ps(chip->kb2, chip->dkb2);
+    chip->ka2 = _mm256_add_ps(chip->ka2, chip->dka2);
+    chip->kb1 = _mm256_add_ps(chip->kb1, chip->dkb1);
+    chip->ka1 = _mm256_add_ps(chip->ka1, chip->dka1);
+    chip->krl = _mm256_add_ps(chip->krl, chip->dkrl);
+    chip->klr = _mm256_add_ps(chip->klr, chip->dklr);
+    chip->kb0 = _mm256_add_ps(chip->kb0, chip->dkb0);
+    chip->kv = _mm256_add_ps(chip->kv, chip->dkv);
+}
+
+
+// Starts a new ramp from the current coefficients towards the targets
+static void aymo_(retarget)(struct aymo_(chip)* chip)
+{
+    if (chip->smooth_steps) {
+        vf32x8_t rs = _mm256_set1_ps(1.f / (float)chip->smooth_steps);
+        chip->dkb2 = _mm256_mul_ps(_mm256_sub_ps(chip->tkb2, chip->kb2), rs);
+        chip->dka2 = _mm256_mul_ps(_mm256_sub_ps(chip->tka2, chip->ka2), rs);
+        chip->dkb1 = _mm256_mul_ps(_mm256_sub_ps(chip->tkb1, chip->kb1), rs);
+        chip->dka1 = _mm256_mul_ps(_mm256_sub_ps(chip->tka1, chip->ka1), rs);
+        chip->dkrl = _mm256_mul_ps(_mm256_sub_ps(chip->tkrl, chip->krl), rs);
+        chip->dklr = _mm256_mul_ps(_mm256_sub_ps(chip->tklr, chip->klr), rs);
+        chip->dkb0 = _mm256_mul_ps(_mm256_sub_ps(chip->tkb0, chip->kb0), rs);
+        chip->dkv = _mm256_mul_ps(_mm256_sub_ps(chip->tkv, chip->kv), rs);
+
+        chip->smooth_left = (chip->smooth_steps * AYMO_TDA8425_SMOOTH_STEP);
+    }
+    else {
+        aymo_(snap)(chip);
+    }
+}
+
+
 uint8_t aymo_(read)(struct aymo_(chip)* chip, uint16_t address)
 {
     assert(chip);
@@ -436,11 +355,40 @@ void aymo_(write)(struct aymo_(chip)* chip, uint16_t address, uint8_t value)
             aymo_(apply_tr)(chip);
             break;
         }
+        default: {
+            return;
+        }
     }
+
+    aymo_(retarget)(chip);
 }
 
 
-void aymo_(process_f32)(struct aymo_(chip)* chip, uint32_t count, const float x[], float y[])
+// Runs one frame through the pipelined filter cascade.
+// Terms not depending on the previous frame are summed first, to shorten the recursion chain.
+static inline vf32x8_t aymo_(step_f32)(
+    vf32x8_t xx,
+    vf32x8_t* b2, vf32x8_t* a2, vf32x8_t* b1, vf32x8_t* a1,
+    vf32x8_t kb2, vf32x8_t ka2, vf32x8_t kb1, vf32x8_t ka1, vf32x8_t kb0
+)
+{
+    vf32x8_t y2 = _mm256_add_ps(_mm256_mul_ps(*b2, kb2), _mm256_mul_ps(*a2, ka2));
+    vf32x8_t y1 = _mm256_add_ps(y2, _mm256_mul_ps(*b1, kb1));
+    vf32x8_t a0 = _mm256_add_ps(y1, _mm256_mul_ps(*a1, ka1));
+
+    vf32x8_t b0 = mm256_alignr_ps(*a1, xx, 3);
+    a0 = _mm256_add_ps(a0, _mm256_mul_ps(b0, kb0));
+
+    *b2 = *b1;
+    *a2 = *a1;
+
+    *b1 = b0;
+    *a1 = a0;
+    return a0;
+}
+
+
+static void aymo_(run_f32)(struct aymo_(chip)* chip, uint32_t count, const float x[], float y[])
 {
     assert(chip);
     assert(x);
@@ -467,25 +415,162 @@ void aymo_(process_f32)(struct aymo_(chip)* chip, uint32_t count, const float x[
 
     vf32x8_t kv = chip->kv;
 
-    do {
-        vf32x8_t y2 = _mm256_add_ps(_mm256_mul_ps(b2, kb2), _mm256_mul_ps(a2, ka2));
-        vf32x8_t y1 = _mm256_add_ps(_mm256_mul_ps(b1, kb1), _mm256_mul_ps(a1, ka1));
-        vf32x8_t a0 = _mm256_add_ps(y2, y1);
+    // Blocks of 4 frames: full-width input mixing, volume, and stores
+    if (count >= 4u) {
+        const vi32x8_t ilr = _mm256_set_epi32(7, 3, 7, 3, 7, 3, 7, 3);
+        vf32x8_t kxx = _mm256_permutevar8x32_ps(klr, ilr);  // L<-L, R<-R
+        vf32x8_t kxs = _mm256_permutevar8x32_ps(krl, ilr);  // L<-R, R<-L
+        vf32x8_t kvv = _mm256_permutevar8x32_ps(kv, ilr);
+
+        const vi32x8_t ix0 = _mm256_set_epi32(1, 1, 1, 1, 0, 0, 0, 0);
+        const vi32x8_t ix1 = _mm256_set_epi32(3, 3, 3, 3, 2, 2, 2, 2);
+        const vi32x8_t ix2 = _mm256_set_epi32(5, 5, 5, 5, 4, 4, 4, 4);
+        const vi32x8_t ix3 = _mm256_set_epi32(7, 7, 7, 7, 6, 6, 6, 6);
+        const vi32x8_t iy  = _mm256_set_epi32(7, 3, 6, 2, 5, 1, 4, 0);
+
+        do {
+            // Mix 4 frames at once; lanes 3 and 7 of each frame vector feed the cascade
+            vf32x8_t xv = _mm256_loadu_ps(x); x += 8u;
+            vf32x8_t xs = _mm256_permute_ps(xv, 0xB1);
+            vf32x8_t xm = _mm256_add_ps(_mm256_mul_ps(xv, kxx), _mm256_mul_ps(xs, kxs));
+
+            vf32x8_t o0 = aymo_(step_f32)(_mm256_permutevar8x32_ps(xm, ix0), &b2, &a2, &b1, &a1, kb2, ka2, kb1, ka1, kb0);
+            vf32x8_t o1 = aymo_(step_f32)(_mm256_permutevar8x32_ps(xm, ix1), &b2, &a2, &b1, &a1, kb2, ka2, kb1, ka1, kb0);
+            vf32x8_t o2 = aymo_(step_f32)(_mm256_permutevar8x32_ps(xm, ix2), &b2, &a2, &b1, &a1, kb2, ka2, kb1, ka1, kb0);
+            vf32x8_t o3 = aymo_(step_f32)(_mm256_permutevar8x32_ps(xm, ix3), &b2, &a2, &b1, &a1, kb2, ka2, kb1, ka1, kb0);
+
+            // Gather lanes 3 and 7 of each frame back into interleaved stereo order
+            vf32x8_t o01 = _mm256_unpackhi_ps(o0, o1);
+            vf32x8_t o23 = _mm256_unpackhi_ps(o2, o3);
+            vf32x8_t olr = _mm256_castpd_ps(_mm256_unpackhi_pd(_mm256_castps_pd(o01), _mm256_castps_pd(o23)));
+            vf32x8_t yy = _mm256_mul_ps(_mm256_permutevar8x32_ps(olr, iy), kvv);
+            _mm256_storeu_ps(y, yy); y += 8u;
+
+            count -= 4u;
+        } while (count >= 4u);
+    }
 
+    while (count) {
         vf32x4_t xl = _mm_set1_ps(x[0]);
         vf32x4_t xr = _mm_set1_ps(x[1]); x += 2u;
         vf32x8_t xlr = _mm256_insertf128_ps(_mm256_castps128_ps256(xl), xr, 1);
         vf32x8_t xrl = _mm256_insertf128_ps(_mm256_castps128_ps256(xr), xl, 1);
         vf32x8_t xx = _mm256_add_ps(_mm256_mul_ps(xlr, klr), _mm256_mul_ps(xrl, krl));
 
-        vf32x8_t b0 = mm256_alignr_ps(a1, xx, 3);
-        a0 = _mm256_add_ps(a0, _mm256_mul_ps(b0, kb0));
+        vf32x8_t a0 = aymo_(step_f32)(xx, &b2, &a2, &b1, &a1, kb2, ka2, kb1, ka1, kb0);
 
         vf32x8_t yy = _mm256_mul_ps(a0, kv);
         vi32x8_t yyi = _mm256_castps_si256(yy);
         ((int32_t*)y)[0] = _mm256_extract_epi32(yyi, 3);
         ((int32_t*)y)[1] = _mm256_extract_epi32(yyi, 7); y += 2u;
 
+        --count;
+    }
+
+    chip->hb1 = b2;
+    chip->ha1 = a2;
+
+    chip->hb0 = b1;
+    chip->ha0 = a1;
+}
+
+
+static inline vi32x8_t aymo_(f32_q)(vf32x8_t f, int q)
+{
+    return _mm256_cvtps_epi32(_mm256_mul_ps(f, _mm256_set1_ps((float)(1L << q))));
+}
+
+
+static inline vf32x8_t aymo_(q_f32)(vi32x8_t i, int q)
+{
+    return _mm256_mul_ps(_mm256_cvtepi32_ps(i), _mm256_set1_ps((float)(1. / (double)(1L << q))));
+}
+
+
+// Multiply-accumulates Q-format lanes into exact 64-bit even/odd sums
+static inline void aymo_(mac_q)(__m256i* even, __m256i* odd, vi32x8_t x, vi32x8_t k)
+{
+    *even = _mm256_add_epi64(*even, _mm256_mul_epi32(x, k));
+    *odd = _mm256_add_epi64(*odd, _mm256_mul_epi32(_mm256_srli_epi64(x, 32), _mm256_srli_epi64(k, 32)));
+}
+
+
+// Rounds 64-bit even/odd sums back to Q-format signal lanes
+static inline vi32x8_t aymo_(round_q)(__m256i even, __m256i odd)
+{
+    const __m256i r = _mm256_set1_epi64x(1LL << (AYMO_TDA8425_Q_COEFF - 1));
+    even = _mm256_srli_epi64(_mm256_add_epi64(even, r), AYMO_TDA8425_Q_COEFF);
+    odd = _mm256_slli_epi64(_mm256_add_epi64(odd, r), (32 - AYMO_TDA8425_Q_COEFF));
+    return _mm256_blend_epi32(even, odd, 0xAA);  // "10101010"
+}
+
+
+static void aymo_(run_i16)(struct aymo_(chip)* chip, uint32_t count, const int16_t x[], int16_t y[])
+{
+    assert(chip);
+    assert(x);
+    assert(y);
+
+    if AYMO_UNLIKELY(!count) {
+        return;
+    }
+
+    const int qk = AYMO_TDA8425_Q_COEFF;
+    const int qs = AYMO_TDA8425_Q_SIGNAL;
+
+    vi32x8_t kb2 = aymo_(f32_q)(chip->kb2, qk);
+    vi32x8_t ka2 = aymo_(f32_q)(chip->ka2, qk);
+    vi32x8_t b2  = aymo_(f32_q)(chip->hb1, qs);
+    vi32x8_t a2  = aymo_(f32_q)(chip->ha1, qs);
+
+    vi32x8_t kb1 = aymo_(f32_q)(chip->kb1, qk);
+    vi32x8_t ka1 = aymo_(f32_q)(chip->ka1, qk);
+    vi32x8_t b1  = aymo_(f32_q)(chip->hb0, qs);
+    vi32x8_t a1  = aymo_(f32_q)(chip->ha0, qs);
+
+    vi32x8_t klr = aymo_(f32_q)(chip->klr, qk);
+    vi32x8_t krl = aymo_(f32_q)(chip->krl, qk);
+
+    vi32x8_t kb0 = aymo_(f32_q)(chip->kb0, qk);
+
+    vi32x8_t kv = aymo_(f32_q)(chip->kv, qk);
+
+    const vi32x8_t plr = _mm256_setr_epi32(0, 0, 0, 0, 1, 1, 1, 1);
+    const vi32x8_t prl = _mm256_setr_epi32(1, 1, 1, 1, 0, 0, 0, 0);
+
+    do {
+        __m256i ev = _mm256_setzero_si256();
+        __m256i od = _mm256_setzero_si256();
+
+        aymo_(mac_q)(&ev, &od, b2, kb2);
+        aymo_(mac_q)(&ev, &od, a2, ka2);
+        aymo_(mac_q)(&ev, &od, b1, kb1);
+        aymo_(mac_q)(&ev, &od, a1, ka1);
+
+        vi32x4_t xi = _mm_cvtepi16_epi32(_mm_cvtsi32_si128(*(const int32_t*)(const void*)x)); x += 2u;
+        xi = _mm_slli_epi32(xi, (qs - 15));
+        vi32x8_t xlr = _mm256_permutevar8x32_epi32(_mm256_castsi128_si256(xi), plr);
+        vi32x8_t xrl = _mm256_permutevar8x32_epi32(_mm256_castsi128_si256(xi), prl);
+        __m256i evx = _mm256_setzero_si256();
+        __m256i odx = _mm256_setzero_si256();
+        aymo_(mac_q)(&evx, &odx, xlr, klr);
+        aymo_(mac_q)(&evx, &odx, xrl, krl);
+        vi32x8_t xx = aymo_(round_q)(evx, odx);
+
+        vi32x8_t b0 = _mm256_alignr_epi8(a1, xx, 12);
+        aymo_(mac_q)(&ev, &od, b0, kb0);
+        vi32x8_t a0 = aymo_(round_q)(ev, od);
+
+        __m256i evy = _mm256_setzero_si256();
+        __m256i ody = _mm256_setzero_si256();
+        aymo_(mac_q)(&evy, &ody, a0, kv);
+        vi32x8_t yy = aymo_(round_q)(evy, ody);
+        yy = _mm256_add_epi32(yy, _mm256_set1_epi32(1 << (qs - 16)));
+        yy = _mm256_srai_epi32(yy, (qs - 15));
+        yy = _mm256_packs_epi32(yy, yy);
+        y[0] = (int16_t)_mm256_extract_epi16(yy, 3);
+        y[1] = (int16_t)_mm256_extract_epi16(yy, 11); y += 2u;
+
         b2 = b1;
         a2 = a1;
 
@@ -493,11 +578,653 @@ void aymo_(process_f32)(struct aymo_(chip)* chip, uint32_t count, const float x[
         a1 = a0;
     } while (--count);
 
-    chip->hb1 = b2;
-    chip->ha1 = a2;
+    chip->hb1 = aymo_(q_f32)(b2, qs);
+    chip->ha1 = aymo_(q_f32)(a2, qs);
 
-    chip->hb0 = b1;
-    chip->ha0 = a1;
+    chip->hb0 = aymo_(q_f32)(b1, qs);
+    chip->ha0 = aymo_(q_f32)(a1, qs);
+}
+
+
+// Advances the ramp by the given frames, which never cross a ramp step boundary
+static void aymo_(advance)(struct aymo_(chip)* chip, uint32_t count)
+{
+    chip->smooth_left -= count;
+
+    if (!chip->smooth_left) {
+        aymo_(snap)(chip);
+    }
+    else if (!(chip->smooth_left % AYMO_TDA8425_SMOOTH_STEP)) {
+        aymo_(ramp)(chip);
+    }
+}
+
+
+// Frames to process before the next ramp step, if ramping
+static inline uint32_t aymo_(run_length)(const struct aymo_(chip)* chip, uint32_t count)
+{
+    if AYMO_UNLIKELY(chip->smooth_left) {
+        uint32_t n = (((chip->smooth_left - 1u) % AYMO_TDA8425_SMOOTH_STEP) + 1u);
+        if (count > n) {
+            count = n;
+        }
+    }
+    return count;
+}
+
+
+// Zeroes the filter states once all of their magnitudes fall below the silence threshold
+static void aymo_(gate_silence)(struct aymo_(chip)* chip)
+{
+    vf32x8_t sign = _mm256_set1_ps(-0.f);
+    vf32x8_t m1 = _mm256_max_ps(_mm256_andnot_ps(sign, chip->hb1), _mm256_andnot_ps(sign, chip->ha1));
+    vf32x8_t m0 = _mm256_max_ps(_mm256_andnot_ps(sign, chip->hb0), _mm256_andnot_ps(sign, chip->ha0));
+    vf32x8_t m = _mm256_max_ps(m1, m0);
+    vf32x8_t quiet = _mm256_cmp_ps(m, _mm256_set1_ps(chip->silence), _CMP_LT_OQ);
+
+    if (_mm256_movemask_ps(quiet) == 0xFF) {
+        vf32x8_t z = _mm256_setzero_ps();
+        chip->hb1 = z;
+        chip->ha1 = z;
+        chip->hb0 = z;
+        chip->ha0 = z;
+    }
+}
+
+
+void aymo_(process_f32)(struct aymo_(chip)* chip, uint32_t count, const float x[], float y[])
+{
+    assert(chip);
+    assert(x);
+    assert(y);
+
+    aymo_cpu_fpstate_t fpstate = aymo_cpu_enter_ftz();
+
+    while (count) {
+        uint32_t n = aymo_(run_length)(chip, count);
+        aymo_(run_f32)(chip, n, x, y);
+        x += (n * 2u);
+        y += (n * 2u);
+        count -= n;
+
+        if AYMO_UNLIKELY(chip->smooth_left) {
+            aymo_(advance)(chip, n);
+        }
+    }
+
+    if (chip->silence > 0.f) {
+        aymo_(gate_silence)(chip);
+    }
+
+    aymo_cpu_leave_ftz(fpstate);
+}
+
+
+void aymo_(process_i16)(struct aymo_(chip)* chip, uint32_t count, const int16_t x[], int16_t y[])
+{
+    assert(chip);
+    assert(x);
+    assert(y);
+
+    while (count) {
+        uint32_t n = aymo_(run_length)(chip, count);
+        aymo_(run_i16)(chip, n, x, y);
+        x += (n * 2u);
+        y += (n * 2u);
+        count -= n;
+
+        if AYMO_UNLIKELY(chip->smooth_left) {
+            aymo_(advance)(chip, n);
+        }
+    }
+
+    if (chip->silence > 0.f) {
+        aymo_(gate_silence)(chip);
+    }
+}
+
+
+void aymo_(set_coeffs)(struct aymo_(chip)* chip, struct aymo_tda8425_coeffs* coeffs)
+{
+    assert(chip);
+    assert(!coeffs || (coeffs->sample_rate == chip->sample_rate));
+
+    // Cached and computed coefficients are the same, so there is nothing to reapply
+    chip->coeffs = coeffs;
+}
+
+
+void aymo_(set_smoothing)(struct aymo_(chip)* chip, uint32_t frames)
+{
+    assert(chip);
+
+    uint32_t steps = ((frames / AYMO_TDA8425_SMOOTH_STEP) + ((frames % AYMO_TDA8425_SMOOTH_STEP) != 0u));
+    if (steps > (UINT32_MAX / AYMO_TDA8425_SMOOTH_STEP)) {
+        steps = (UINT32_MAX / AYMO_TDA8425_SMOOTH_STEP);
+    }
+    chip->smooth_steps = steps;
+
+    if (!steps) {
+        aymo_(snap)(chip);
+    }
+}
+
+
+void aymo_(set_silence)(struct aymo_(chip)* chip, float threshold)
+{
+    assert(chip);
+    assert(threshold >= 0.f);
+
+    chip->silence = threshold;
+}
+
+
+// Lanes of a bank instance, as a blend mask
+static inline vf32x8_t aymo_(bank_mask)(uint32_t index)
+{
+    vi32x8_t lanes = _mm256_set_epi32(3, 3, 2, 2, 1, 1, 0, 0);
+    return _mm256_castsi256_ps(_mm256_cmpeq_epi32(lanes, _mm256_set1_epi32((int)index)));
+}
+
+
+static void aymo_(bank_store_biquad)(
+    struct aymo_(bank_unit)* bank,
+    int stage,
+    const struct aymo_tda8425_biquad* bq,
+    vf32x8_t mask
+)
+{
+    bank->kb0[stage] = _mm256_blendv_ps(bank->kb0[stage], _mm256_set1_ps(bq->kb0), mask);
+    bank->kb1[stage] = _mm256_blendv_ps(bank->kb1[stage], _mm256_set1_ps(bq->kb1), mask);
+    bank->kb2[stage] = _mm256_blendv_ps(bank->kb2[stage], _mm256_set1_ps(bq->kb2), mask);
+    bank->ka1[stage] = _mm256_blendv_ps(bank->ka1[stage], _mm256_set1_ps(bq->ka1), mask);
+    bank->ka2[stage] = _mm256_blendv_ps(bank->ka2[stage], _mm256_set1_ps(bq->ka2), mask);
+}
+
+
+static void aymo_(bank_apply_volume)(struct aymo_(bank_unit)* bank, uint32_t index)
+{
+    float gl = aymo_tda8425_lookup_volume(bank->coeffs, bank->reg_vl[index], bank->reg_sf[index]);
+    float gr = aymo_tda8425_lookup_volume(bank->coeffs, bank->reg_vr[index], bank->reg_sf[index]);
+    vf32x8_t kv = _mm256_set_ps(gr, gl, gr, gl, gr, gl, gr, gl);
+    bank->kv = _mm256_blendv_ps(bank->kv, kv, aymo_(bank_mask)(index));
+}
+
+
+static void aymo_(bank_apply_source_mode)(struct aymo_(bank_unit)* bank, uint32_t index)
+{
+    float klr[2];
+    float krl[2];
+    aymo_tda8425_calc_mixer(klr, krl, bank->reg_sf[index]);
+
+    vf32x8_t mask = aymo_(bank_mask)(index);
+    vf32x8_t kd = _mm256_set_ps(klr[1], klr[0], klr[1], klr[0], klr[1], klr[0], klr[1], klr[0]);
+    vf32x8_t kx = _mm256_set_ps(krl[1], krl[0], krl[1], krl[0], krl[1], krl[0], krl[1], krl[0]);
+    bank->klr = _mm256_blendv_ps(bank->klr, kd, mask);
+    bank->krl = _mm256_blendv_ps(bank->krl, kx, mask);
+}
+
+
+static void aymo_(bank_apply_pseudo)(struct aymo_(bank_unit)* bank, uint32_t index)
+{
+    struct aymo_tda8425_biquad tmp;
+    const struct aymo_tda8425_biquad* bq =
+        aymo_tda8425_lookup_pseudo(bank->coeffs, &tmp, bank->sample_rate, bank->reg_pp[index], bank->reg_sf[index]);
+    aymo_(bank_store_biquad)(bank, 0, bq, aymo_(bank_mask)(index));
+}
+
+
+static void aymo_(bank_apply_tr)(struct aymo_(bank_unit)* bank, uint32_t index)
+{
+    struct aymo_tda8425_biquad tmp;
+    const struct aymo_tda8425_biquad* bq =
+        aymo_tda8425_lookup_treble(bank->coeffs, &tmp, bank->sample_rate, bank->reg_tr[index], bank->reg_sf[index]);
+    aymo_(bank_store_biquad)(bank, 1, bq, aymo_(bank_mask)(index));
+}
+
+
+static void aymo_(bank_apply_ba)(struct aymo_(bank_unit)* bank, uint32_t index)
+{
+    struct aymo_tda8425_biquad tmp;
+    const struct aymo_tda8425_biquad* bq =
+        aymo_tda8425_lookup_bass(bank->coeffs, &tmp, bank->sample_rate, bank->reg_ba[index]);
+    aymo_(bank_store_biquad)(bank, 2, bq, aymo_(bank_mask)(index));
+}
+
+
+static void aymo_(bank_apply_tfilter)(struct aymo_(bank_unit)* bank, uint32_t index)
+{
+    struct aymo_tda8425_biquad tmp;
+    const struct aymo_tda8425_biquad* bq =
+        aymo_tda8425_lookup_tfilter(bank->coeffs, &tmp, bank->sample_rate, bank->reg_ba[index], bank->reg_sf[index]);
+    aymo_(bank_store_biquad)(bank, 3, bq, aymo_(bank_mask)(index));
+}
+
+
+static uint8_t aymo_(bank_unit_read)(const struct aymo_(bank_unit)* bank, uint32_t index, uint16_t address)
+{
+    switch (address) {
+        case 0x00u: {
+            return bank->reg_vl[index];
+        }
+        case 0x01u: {
+            return bank->reg_vr[index];
+        }
+        case 0x02u: {
+            return bank->reg_ba[index];
+        }
+        case 0x03u: {
+            return bank->reg_tr[index];
+        }
+        case 0x07u: {
+            return bank->reg_pp[index];
+        }
+        case 0x08u: {
+            return bank->reg_sf[index];
+        }
+        default: {
+            return 0xFFu;
+        }
+    }
+}
+
+
+static void aymo_(bank_unit_write)(struct aymo_(bank_unit)* bank, uint32_t index, uint16_t address, uint8_t value)
+{
+    switch (address) {
+        case 0x00u: {  // VL
+            bank->reg_vl[index] = (value | 0xC0u);
+            aymo_(bank_apply_volume)(bank, index);
+            break;
+        }
+        case 0x01u: {  // VR
+            bank->reg_vr[index] = (value | 0xC0u);
+            aymo_(bank_apply_volume)(bank, index);
+            break;
+        }
+        case 0x02u: {  // BA
+            bank->reg_ba[index] = (value | 0xF0u);
+            aymo_(bank_apply_ba)(bank, index);
+            break;
+        }
+        case 0x03u: {  // TR
+            bank->reg_tr[index] = (value | 0xF0u);
+            aymo_(bank_apply_tr)(bank, index);
+            break;
+        }
+        case 0x07u: {  // PP
+            bank->reg_pp[index] = (value | 0xFCu);
+            aymo_(bank_apply_pseudo)(bank, index);
+            break;
+        }
+        case 0x08u: {  // SF
+            bank->reg_sf[index] = value;
+            aymo_(bank_apply_source_mode)(bank, index);
+            aymo_(bank_apply_pseudo)(bank, index);
+            aymo_(bank_apply_tfilter)(bank, index);
+            aymo_(bank_apply_volume)(bank, index);
+            aymo_(bank_apply_tr)(bank, index);
+            break;
+        }
+    }
+}
+
+
+static void aymo_(bank_unit_ctor)(struct aymo_(bank_unit)* bank, float sample_rate)
+{
+    aymo_memset(bank, 0, sizeof(*bank));
+
+    bank->sample_rate = sample_rate;
+
+    for (uint32_t index = 0u; index < AYMO_TDA8425_X86_AVX2_BANK_WIDTH; ++index) {
+        aymo_(bank_unit_write)(bank, index, 0x00u, 0xFCu);  // VL: 0 dB
+        aymo_(bank_unit_write)(bank, index, 0x01u, 0xFCu);  // VR: 0 dB
+        aymo_(bank_unit_write)(bank, index, 0x02u, 0xF6u);  // BA: 0 dB
+        aymo_(bank_unit_write)(bank, index, 0x03u, 0xF6u);  // TR: 0 dB
+        aymo_(bank_unit_write)(bank, index, 0x07u, 0xFCu);  // PP: light pseudo
+        aymo_(bank_unit_write)(bank, index, 0x08u, 0xCEu);  // SF: linear stereo, channel 1, unmuted
+    }
+}
+
+
+const struct aymo_tda8425_bank_vt aymo_(bank_vt) =
+{
+    AYMO_STRINGIFY2(aymo_(bank_vt)),
+    (aymo_tda8425_bank_get_sizeof_f)&(aymo_(bank_get_sizeof)),
+    (aymo_tda8425_bank_ctor_f)&(aymo_(bank_ctor)),
+    (aymo_tda8425_bank_dtor_f)&(aymo_(bank_dtor)),
+    (aymo_tda8425_bank_read_f)&(aymo_(bank_read)),
+    (aymo_tda8425_bank_write_f)&(aymo_(bank_write)),
+    (aymo_tda8425_bank_process_f32_f)&(aymo_(bank_process_f32)),
+    (aymo_tda8425_bank_process_f32_interleaved_f)&(aymo_(bank_process_f32_interleaved)),
+    (aymo_tda8425_bank_set_coeffs_f)&(aymo_(bank_set_coeffs))
+};
+
+
+const struct aymo_tda8425_bank_vt* aymo_(get_bank_vt)(void)
+{
+    return &aymo_(bank_vt);
+}
+
+
+static inline uint32_t aymo_(bank_unit_count)(uint32_t instances)
+{
+    return ((instances + (AYMO_TDA8425_X86_AVX2_BANK_WIDTH - 1u)) / AYMO_TDA8425_X86_AVX2_BANK_WIDTH);
+}
+
+
+static inline struct aymo_(bank_unit)* aymo_(bank_units)(struct aymo_(bank)* bank)
+{
+    return (struct aymo_(bank_unit)*)(void*)(bank + 1);
+}
+
+
+uint32_t aymo_(bank_get_sizeof)(uint32_t instances)
+{
+    return (uint32_t)(sizeof(struct aymo_(bank)) + (aymo_(bank_unit_count)(instances) * sizeof(struct aymo_(bank_unit))));
+}
+
+
+void aymo_(bank_ctor)(struct aymo_(bank)* bank, uint32_t instances, float sample_rate)
+{
+    assert(bank);
+    assert(sample_rate > 0.f);
+
+    bank->parent.instances = instances;
+
+    struct aymo_(bank_unit)* units = aymo_(bank_units)(bank);
+    for (uint32_t u = 0u; u < aymo_(bank_unit_count)(instances); ++u) {
+        aymo_(bank_unit_ctor)(&units[u], sample_rate);
+    }
+}
+
+
+void aymo_(bank_dtor)(struct aymo_(bank)* bank)
+{
+    AYMO_UNUSED_VAR(bank);
+    assert(bank);
+}
+
+
+uint8_t aymo_(bank_read)(struct aymo_(bank)* bank, uint32_t index, uint16_t address)
+{
+    assert(bank);
+    assert(index < bank->parent.instances);
+
+    const struct aymo_(bank_unit)* unit = &aymo_(bank_units)(bank)[index / AYMO_TDA8425_X86_AVX2_BANK_WIDTH];
+    return aymo_(bank_unit_read)(unit, (index % AYMO_TDA8425_X86_AVX2_BANK_WIDTH), address);
+}
+
+
+void aymo_(bank_write)(struct aymo_(bank)* bank, uint32_t index, uint16_t address, uint8_t value)
+{
+    assert(bank);
+    assert(index < bank->parent.instances);
+
+    struct aymo_(bank_unit)* unit = &aymo_(bank_units)(bank)[index / AYMO_TDA8425_X86_AVX2_BANK_WIDTH];
+    aymo_(bank_unit_write)(unit, (index % AYMO_TDA8425_X86_AVX2_BANK_WIDTH), address, value);
+}
+
+
+void aymo_(bank_set_coeffs)(struct aymo_(bank)* bank, struct aymo_tda8425_coeffs* coeffs)
+{
+    assert(bank);
+
+    struct aymo_(bank_unit)* units = aymo_(bank_units)(bank);
+    for (uint32_t u = 0u; u < aymo_(bank_unit_count)(bank->parent.instances); ++u) {
+        assert(!coeffs || (coeffs->sample_rate == units[u].sample_rate));
+        units[u].coeffs = coeffs;
+    }
+}
+
+
+// Filter histories of a bank, kept in registers while processing.
+// Stage N feeds on the outputs of stage N-1, so only stage 0 needs its input history:
+//   xD = mixed input delayed by D frames, yN_D = output of stage N delayed by D frames
+struct aymo_(bank_state) {
+    vf32x8_t x1, x2;
+    vf32x8_t y0_1, y0_2, y0_3;
+    vf32x8_t y1_1, y1_2, y1_3;
+    vf32x8_t y2_1, y2_2, y2_3;
+    vf32x8_t y3_1, y3_2;
+};
+
+
+static inline void aymo_(bank_load_state)(const struct aymo_(bank_unit)* bank, struct aymo_(bank_state)* st)
+{
+    st->x1 = bank->hb0[0];
+    st->x2 = bank->hb1[0];
+    st->y0_1 = bank->ha0[0];
+    st->y0_2 = bank->ha1[0];
+    st->y0_3 = bank->hb1[1];
+    st->y1_1 = bank->ha0[1];
+    st->y1_2 = bank->ha1[1];
+    st->y1_3 = bank->hb1[2];
+    st->y2_1 = bank->ha0[2];
+    st->y2_2 = bank->ha1[2];
+    st->y2_3 = bank->hb1[3];
+    st->y3_1 = bank->ha0[3];
+    st->y3_2 = bank->ha1[3];
+}
+
+
+static inline void aymo_(bank_save_state)(struct aymo_(bank_unit)* bank, const struct aymo_(bank_state)* st)
+{
+    bank->hb0[0] = st->x1;
+    bank->hb1[0] = st->x2;
+    bank->ha0[0] = st->y0_1;
+    bank->ha1[0] = st->y0_2;
+    bank->hb0[1] = st->y0_2;
+    bank->hb1[1] = st->y0_3;
+    bank->ha0[1] = st->y1_1;
+    bank->ha1[1] = st->y1_2;
+    bank->hb0[2] = st->y1_2;
+    bank->hb1[2] = st->y1_3;
+    bank->ha0[2] = st->y2_1;
+    bank->ha1[2] = st->y2_2;
+    bank->hb0[3] = st->y2_2;
+    bank->hb1[3] = st->y2_3;
+    bank->ha0[3] = st->y3_1;
+    bank->ha1[3] = st->y3_2;
+}
+
+
+// Runs one biquad stage; operation order matches x86_sse41 bit for bit
+static inline vf32x8_t aymo_(bank_stage)(
+    const struct aymo_(bank_unit)* bank, int stage,
+    vf32x8_t b0, vf32x8_t b1, vf32x8_t b2, vf32x8_t a1, vf32x8_t a2
+)
+{
+    vf32x8_t y2 = _mm256_add_ps(_mm256_mul_ps(b2, bank->kb2[stage]), _mm256_mul_ps(a2, bank->ka2[stage]));
+    vf32x8_t y1 = _mm256_add_ps(_mm256_mul_ps(b1, bank->kb1[stage]), _mm256_mul_ps(a1, bank->ka1[stage]));
+    vf32x8_t a0 = _mm256_add_ps(y2, y1);
+    return _mm256_add_ps(a0, _mm256_mul_ps(b0, bank->kb0[stage]));
+}
+
+
+// Runs one stereo frame of all the bank instances.
+// Each stage is fed by the previous stage output of the previous frame, like the
+// pipelined chip cascade, so all the stages are independent within a frame.
+static inline vf32x8_t aymo_(bank_step)(const struct aymo_(bank_unit)* bank, struct aymo_(bank_state)* st, vf32x8_t xv)
+{
+    vf32x8_t xs = _mm256_permute_ps(xv, _MM_SHUFFLE(2, 3, 0, 1));
+    vf32x8_t xx = _mm256_add_ps(_mm256_mul_ps(xv, bank->klr), _mm256_mul_ps(xs, bank->krl));
+
+    vf32x8_t y0 = aymo_(bank_stage)(bank, 0, xx, st->x1, st->x2, st->y0_1, st->y0_2);
+    vf32x8_t y1 = aymo_(bank_stage)(bank, 1, st->y0_1, st->y0_2, st->y0_3, st->y1_1, st->y1_2);
+    vf32x8_t y2 = aymo_(bank_stage)(bank, 2, st->y1_1, st->y1_2, st->y1_3, st->y2_1, st->y2_2);
+    vf32x8_t y3 = aymo_(bank_stage)(bank, 3, st->y2_1, st->y2_2, st->y2_3, st->y3_1, st->y3_2);
+
+    st->x2 = st->x1;
+    st->x1 = xx;
+    st->y0_3 = st->y0_2;
+    st->y0_2 = st->y0_1;
+    st->y0_1 = y0;
+    st->y1_3 = st->y1_2;
+    st->y1_2 = st->y1_1;
+    st->y1_1 = y1;
+    st->y2_3 = st->y2_2;
+    st->y2_2 = st->y2_1;
+    st->y2_1 = y2;
+    st->y3_2 = st->y3_1;
+    st->y3_1 = y3;
+
+    return _mm256_mul_ps(y3, bank->kv);
+}
+
+
+// Transposes 4 frames of 4 stereo streams, as 64-bit pairs
+static inline void aymo_(bank_transpose)(__m256d* v0, __m256d* v1, __m256d* v2, __m256d* v3)
+{
+    __m256d t0 = _mm256_unpacklo_pd(*v0, *v1);
+    __m256d t1 = _mm256_unpackhi_pd(*v0, *v1);
+    __m256d t2 = _mm256_unpacklo_pd(*v2, *v3);
+    __m256d t3 = _mm256_unpackhi_pd(*v2, *v3);
+    *v0 = _mm256_permute2f128_pd(t0, t2, 0x20);
+    *v1 = _mm256_permute2f128_pd(t1, t3, 0x20);
+    *v2 = _mm256_permute2f128_pd(t0, t2, 0x31);
+    *v3 = _mm256_permute2f128_pd(t1, t3, 0x31);
+}
+
+
+static inline __m256d aymo_(bank_load4)(const float* x)
+{
+    return (x ? _mm256_loadu_pd((const double*)(const void*)x) : _mm256_setzero_pd());
+}
+
+
+static inline void aymo_(bank_store4)(float* y, __m256d v)
+{
+    if (y) {
+        _mm256_storeu_pd((double*)(void*)y, v);
+    }
+}
+
+
+static inline __m128d aymo_(bank_load1)(const float* x)
+{
+    return (x ? _mm_load_sd((const double*)(const void*)x) : _mm_setzero_pd());
+}
+
+
+static inline void aymo_(bank_store1)(float* y, __m128d v)
+{
+    if (y) {
+        _mm_store_sd((double*)(void*)y, v);
+    }
+}
+
+
+void aymo_(bank_process_f32)(struct aymo_(bank)* bank_, uint32_t count, const float* const x[], float* const y[])
+{
+    assert(bank_);
+    assert(x);
+    assert(y);
+
+    struct aymo_(bank_unit)* units = aymo_(bank_units)(bank_);
+    uint32_t instances = bank_->parent.instances;
+
+    aymo_cpu_fpstate_t fpstate = aymo_cpu_enter_ftz();
+
+    for (uint32_t first = 0u; first < instances; first += AYMO_TDA8425_X86_AVX2_BANK_WIDTH) {
+        struct aymo_(bank_unit)* bank = &units[first / AYMO_TDA8425_X86_AVX2_BANK_WIDTH];
+        const float* xp[AYMO_TDA8425_X86_AVX2_BANK_WIDTH];
+        float* yp[AYMO_TDA8425_X86_AVX2_BANK_WIDTH];
+
+        for (uint32_t i = 0u; i < AYMO_TDA8425_X86_AVX2_BANK_WIDTH; ++i) {
+            xp[i] = (((first + i) < instances) ? x[first + i] : NULL);
+            yp[i] = (((first + i) < instances) ? y[first + i] : NULL);
+        }
+
+        struct aymo_(bank_state) st;
+        aymo_(bank_load_state)(bank, &st);
+        uint32_t n = 0u;
+
+        for (; (n + 4u) <= count; n += 4u) {
+            uint32_t k = (n * 2u);
+            __m256d v0 = aymo_(bank_load4)(xp[0] ? &xp[0][k] : NULL);
+            __m256d v1 = aymo_(bank_load4)(xp[1] ? &xp[1][k] : NULL);
+            __m256d v2 = aymo_(bank_load4)(xp[2] ? &xp[2][k] : NULL);
+            __m256d v3 = aymo_(bank_load4)(xp[3] ? &xp[3][k] : NULL);
+            aymo_(bank_transpose)(&v0, &v1, &v2, &v3);
+
+            v0 = _mm256_castps_pd(aymo_(bank_step)(bank, &st, _mm256_castpd_ps(v0)));
+            v1 = _mm256_castps_pd(aymo_(bank_step)(bank, &st, _mm256_castpd_ps(v1)));
+            v2 = _mm256_castps_pd(aymo_(bank_step)(bank, &st, _mm256_castpd_ps(v2)));
+            v3 = _mm256_castps_pd(aymo_(bank_step)(bank, &st, _mm256_castpd_ps(v3)));
+
+            aymo_(bank_transpose)(&v0, &v1, &v2, &v3);
+            aymo_(bank_store4)((yp[0] ? &yp[0][k] : NULL), v0);
+            aymo_(bank_store4)((yp[1] ? &yp[1][k] : NULL), v1);
+            aymo_(bank_store4)((yp[2] ? &yp[2][k] : NULL), v2);
+            aymo_(bank_store4)((yp[3] ? &yp[3][k] : NULL), v3);
+        }
+
+        for (; n < count; ++n) {
+            uint32_t k = (n * 2u);
+            __m128d lo = _mm_unpacklo_pd(aymo_(bank_load1)(xp[0] ? &xp[0][k] : NULL),
+                                         aymo_(bank_load1)(xp[1] ? &xp[1][k] : NULL));
+            __m128d hi = _mm_unpacklo_pd(aymo_(bank_load1)(xp[2] ? &xp[2][k] : NULL),
+                                         aymo_(bank_load1)(xp[3] ? &xp[3][k] : NULL));
+            vf32x8_t xv = _mm256_castpd_ps(_mm256_insertf128_pd(_mm256_castpd128_pd256(lo), hi, 1));
+
+            __m256d yv = _mm256_castps_pd(aymo_(bank_step)(bank, &st, xv));
+
+            lo = _mm256_castpd256_pd128(yv);
+            hi = _mm256_extractf128_pd(yv, 1);
+            aymo_(bank_store1)((yp[0] ? &yp[0][k] : NULL), lo);
+            aymo_(bank_store1)((yp[1] ? &yp[1][k] : NULL), _mm_unpackhi_pd(lo, lo));
+            aymo_(bank_store1)((yp[2] ? &yp[2][k] : NULL), hi);
+            aymo_(bank_store1)((yp[3] ? &yp[3][k] : NULL), _mm_unpackhi_pd(hi, hi));
+        }
+
+        aymo_(bank_save_state)(bank, &st);
+    }
+
+    aymo_cpu_leave_ftz(fpstate);
+}
+
+
+void aymo_(bank_process_f32_interleaved)(struct aymo_(bank)* bank_, uint32_t count, const float x[], float y[])
+{
+    assert(bank_);
+    assert(x);
+    assert(y);
+
+    struct aymo_(bank_unit)* units = aymo_(bank_units)(bank_);
+    uint32_t instances = bank_->parent.instances;
+
+    uint32_t stride = (instances * 2u);
+    aymo_cpu_fpstate_t fpstate = aymo_cpu_enter_ftz();
+
+    for (uint32_t first = 0u; first < instances; first += AYMO_TDA8425_X86_AVX2_BANK_WIDTH) {
+        struct aymo_(bank_unit)* bank = &units[first / AYMO_TDA8425_X86_AVX2_BANK_WIDTH];
+        const float* xb = &x[first * 2u];
+        float* yb = &y[first * 2u];
+
+        struct aymo_(bank_state) st;
+        aymo_(bank_load_state)(bank, &st);
+
+        if AYMO_LIKELY((instances - first) >= AYMO_TDA8425_X86_AVX2_BANK_WIDTH) {
+            for (uint32_t n = 0u; n < count; ++n) {
+                vf32x8_t xv = _mm256_loadu_ps(xb); xb += stride;
+                _mm256_storeu_ps(yb, aymo_(bank_step)(bank, &st, xv)); yb += stride;
+            }
+        }
+        else {
+            int lanes = (int)((instances - first) * 2u);
+            vi32x8_t mask = _mm256_cmpgt_epi32(_mm256_set1_epi32(lanes), _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+
+            for (uint32_t n = 0u; n < count; ++n) {
+                vf32x8_t xv = _mm256_maskload_ps(xb, mask); xb += stride;
+                _mm256_maskstore_ps(yb, mask, aymo_(bank_step)(bank, &st, xv)); yb += stride;
+            }
+        }
+
+        aymo_(bank_save_state)(bank, &st);
+    }
+
+    aymo_cpu_leave_ftz(fpstate);
 }
 
 
@@ -0,0 +1,724 @@
+/*
+AYMO - Accelerated YaMaha Operator
+Copyright (c) 2023-2024 Andrea Zoppi.
+
+This file is part of AYMO.
+
+AYMO is free software: you can redistribute it and/or modify it under the
+terms of the GNU Lesser General Public License as published by the Free
+Software Foundation, either version 2.1 of the License, or (at your option)
+any later version.
+
+AYMO is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with AYMO. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "aymo_cpu.h"
+#ifdef AYMO_CPU_SUPPORT_X86_FMA3
+
+#include "aymo_tda8425.h"
+#define AYMO_KEEP_SHORTHANDS
+#include "aymo_tda8425_x86_fma3.h"
+
+#include <assert.h>
+
+AYMO_CXX_EXTERN_C_BEGIN
+
+#undef mm256_alignr_ps
+#define mm256_alignr_ps(a, b, imm8)  \
+    (_mm256_castsi256_ps(_mm256_alignr_epi8(_mm256_castps_si256(a), _mm256_castps_si256(b), ((imm8) * 4))))
+
+
+const struct aymo_tda8425_vt aymo_(vt) =
+{
+    AYMO_STRINGIFY2(aymo_(vt)),
+    (aymo_tda8425_get_sizeof_f)&(aymo_(get_sizeof)),
+    (aymo_tda8425_ctor_f)&(aymo_(ctor)),
+    (aymo_tda8425_dtor_f)&(aymo_(dtor)),
+    (aymo_tda8425_read_f)&(aymo_(read)),
+    (aymo_tda8425_write_f)&(aymo_(write)),
+    (aymo_tda8425_process_f32_f)&(aymo_(process_f32)),
+    (aymo_tda8425_process_i16_f)&(aymo_(process_i16)),
+    (aymo_tda8425_set_coeffs_f)&(aymo_(set_coeffs)),
+    (aymo_tda8425_set_smoothing_f)&(aymo_(set_smoothing)),
+    (aymo_tda8425_set_silence_f)&(aymo_(set_silence))
+};
+
+
+const struct aymo_tda8425_vt* aymo_(get_vt)(void)
+{
+    return &aymo_(vt);
+}
+
+
+uint32_t aymo_(get_sizeof)(void)
+{
+    return sizeof(struct aymo_(chip));
+}
+
+
+void aymo_(ctor)(struct aymo_(chip)* chip, float sample_rate)
+{
+    assert(chip);
+    assert(sample_rate > 0.f);
+
+    // Wipe everything, except VT
+    aymo_memset((&chip->parent.vt + 1u), 0, (sizeof(*chip) - sizeof(chip->parent.vt)));
+
+    // Setup default parameters
+    chip->sample_rate = sample_rate;
+    chip->pseudo_c1 = aymo_tda8425_pseudo_preset_c1[0];
+    chip->pseudo_c2 = aymo_tda8425_pseudo_preset_c2[0];
+
+    // Setup default registers
+    aymo_(write)(chip, 0x00u, 0xFCu);  // VL: 0 dB
+    aymo_(write)(chip, 0x01u, 0xFCu);  // VR: 0 dB
+    aymo_(write)(chip, 0x02u, 0xF6u);  // BA: 0 dB
+    aymo_(write)(chip, 0x03u, 0xF6u);  // TR: 0 dB
+    aymo_(write)(chip, 0x07u, 0xFCu);  // PP: light pseudo
+    aymo_(write)(chip, 0x08u, 0xCEu);  // SF: linear stereo, channel 1, unmuted
+}
+
+
+void aymo_(dtor)(struct aymo_(chip)* chip)
+{
+    AYMO_UNUSED_VAR(chip);
+    assert(chip);
+}
+
+
+// Stores biquad coefficients into the target lanes selected by mask
+static void aymo_(store_biquad)(struct aymo_(chip)* chip, const struct aymo_tda8425_biquad* bq, vf32x8_t mask)
+{
+    chip->tkb0 = _mm256_blendv_ps(chip->tkb0, _mm256_set1_ps(bq->kb0), mask);
+    chip->tkb1 = _mm256_blendv_ps(chip->tkb1, _mm256_set1_ps(bq->kb1), mask);
+    chip->tkb2 = _mm256_blendv_ps(chip->tkb2, _mm256_set1_ps(bq->kb2), mask);
+    chip->tka1 = _mm256_blendv_ps(chip->tka1, _mm256_set1_ps(bq->ka1), mask);
+    chip->tka2 = _mm256_blendv_ps(chip->tka2, _mm256_set1_ps(bq->ka2), mask);
+}
+
+
+static void aymo_(apply_vl)(struct aymo_(chip)* chip)
+{
+    float g = aymo_tda8425_lookup_volume(chip->coeffs, chip->reg_vl, chip->reg_sf);
+    vf32x4_t kvlo = _mm_set_ps(g, .0f, .0f, .0f);
+    chip->tkv = _mm256_insertf128_ps(chip->tkv, kvlo, 0);
+}
+
+
+static void aymo_(apply_vr)(struct aymo_(chip)* chip)
+{
+    float g = aymo_tda8425_lookup_volume(chip->coeffs, chip->reg_vr, chip->reg_sf);
+    vf32x4_t kvhi = _mm_set_ps(g, .0f, .0f, .0f);
+    chip->tkv = _mm256_insertf128_ps(chip->tkv, kvhi, 1);
+}
+
+
+static void aymo_(apply_ba)(struct aymo_(chip)* chip)
+{
+    struct aymo_tda8425_biquad tmp;
+    const struct aymo_tda8425_biquad* bq =
+        aymo_tda8425_lookup_bass(chip->coeffs, &tmp, chip->sample_rate, chip->reg_ba);
+    aymo_(store_biquad)(chip, bq, _mm256_castsi256_ps(_mm256_set_epi32(0, -1, 0, 0, 0, -1, 0, 0)));
+}
+
+
+static void aymo_(apply_tr)(struct aymo_(chip)* chip)
+{
+    struct aymo_tda8425_biquad tmp;
+    const struct aymo_tda8425_biquad* bq =
+        aymo_tda8425_lookup_treble(chip->coeffs, &tmp, chip->sample_rate, chip->reg_tr, chip->reg_sf);
+    aymo_(store_biquad)(chip, bq, _mm256_castsi256_ps(_mm256_set_epi32(0, 0, -1, 0, 0, 0, -1, 0)));
+}
+
+
+static void aymo_(apply_source_mode)(struct aymo_(chip)* chip)
+{
+    // Default mute
+    vf32x8_t klr = _mm256_setzero_ps();
+    vf32x8_t krl = _mm256_setzero_ps();
+
+    uint8_t source = (chip->reg_sf & 0x07u);
+    uint8_t mode = ((chip->reg_sf >> 3u) & 0x03u);
+
+    // Forced mono
+    if (mode == 0x00u) {  // process
+        switch (source) {
+            // Channel 1
+            case 0x02u:
+            case 0x04u:
+            case 0x06u: {
+                klr = _mm256_set_ps(1.f, .0f, .0f, .0f,  1.f, .0f, .0f, .0f);
+                krl = _mm256_set_ps(1.f, .0f, .0f, .0f,  1.f, .0f, .0f, .0f);
+                break;
+            }
+        }
+    }
+    else {  // not forced mono
+        switch (source) {
+            // Channel 1
+            case 0x02u: {  // mono left
+                klr = _mm256_set_ps(0.f, .0f, .0f, .0f,  1.f, .0f, .0f, .0f);
+                krl = _mm256_set_ps(1.f, .0f, .0f, .0f,  0.f, .0f, .0f, .0f);
+                break;
+            }
+            case 0x04u: {  // mono right
+                klr = _mm256_set_ps(1.f, .0f, .0f, .0f,  0.f, .0f, .0f, .0f);
+                krl = _mm256_set_ps(0.f, .0f, .0f, .0f,  1.f, .0f, .0f, .0f);
+                break;
+            }
+            case 0x06u: {  // stereo
+                klr = _mm256_set_ps(1.f, .0f, .0f, .0f,  1.f, .0f, .0f, .0f);
+                krl = _mm256_set_ps(0.f, .0f, .0f, .0f,  0.f, .0f, .0f, .0f);
+                break;
+            }
+            default: {
+                if (mode == 0x03u) {  // spatial stereo
+                    mode = 0x02u;  // force linear stereo (mute)
+                }
+                break;
+            }
+        }
+
+        // Spatial stereo
+        if (mode == 0x03u) {  // process
+            const float xt = .52f;  // cross-talk
+            __m256 kx = _mm256_set_ps(xt, .0f, .0f, .0f,  xt, .0f, .0f, .0f);
+            klr = _mm256_add_ps(klr, kx);
+            krl = _mm256_sub_ps(krl, kx);
+        }
+    }  // not forced mono
+
+    chip->tklr = klr;
+    chip->tkrl = krl;
+}
+
+
+static void aymo_(apply_pseudo)(struct aymo_(chip)* chip)
+{
+    struct aymo_tda8425_biquad tmp;
+    const struct aymo_tda8425_biquad* bq =
+        aymo_tda8425_lookup_pseudo(chip->coeffs, &tmp, chip->sample_rate, chip->reg_pp, chip->reg_sf);
+    aymo_(store_biquad)(chip, bq, _mm256_castsi256_ps(_mm256_set_epi32(0, 0, 0, -1, 0, 0, 0, -1)));
+}
+
+
+static void aymo_(apply_tfilter)(struct aymo_(chip)* chip)
+{
+    struct aymo_tda8425_biquad tmp;
+    const struct aymo_tda8425_biquad* bq =
+        aymo_tda8425_lookup_tfilter(chip->coeffs, &tmp, chip->sample_rate, chip->reg_ba, chip->reg_sf);
+    aymo_(store_biquad)(chip, bq, _mm256_castsi256_ps(_mm256_set_epi32(-1, 0, 0, 0, -1, 0, 0, 0)));
+}
+
+
+static void aymo_(apply_pp)(struct aymo_(chip)* chip)
+{
+    uint8_t pseudo_preset = (chip->reg_pp & 0x03u);
+    if (pseudo_preset >= 3u) {
+        pseudo_preset = 0u;
+    }
+    chip->pseudo_c1 = aymo_tda8425_pseudo_preset_c1[pseudo_preset];
+    chip->pseudo_c2 = aymo_tda8425_pseudo_preset_c2[pseudo_preset];
+}
+
+
+// Applies the coefficient targets at once, ending any ramp
+static void aymo_(snap)(struct aymo_(chip)* chip)
+{
+    chip->kb2 = chip->tkb2;
+    chip->ka2 = chip->tka2;
+    chip->kb1 = chip->tkb1;
+    chip->ka1 = chip->tka1;
+    chip->krl = chip->tkrl;
+    chip->klr = chip->tklr;
+    chip->kb0 = chip->tkb0;
+    chip->kv = chip->tkv;
+    chip->smooth_left = 0u;
+}
+
+
+// Moves the coefficients one ramp step towards their targets
+static void aymo_(ramp)(struct aymo_(chip)* chip)
+{
+    chip->kb2 = _mm256_add_ps(chip->kb2, chip->dkb2);
+    chip->ka2 = _mm256_add_ps(chip->ka2, chip->dka2);
+    chip->kb1 = _mm256_add_ps(chip->kb1, chip->dkb1);
+    chip->ka1 = _mm256_add_ps(chip->ka1, chip->dka1);
+    chip->krl = _mm256_add_ps(chip->krl, chip->dkrl);
+    chip->klr = _mm256_add_ps(chip->klr, chip->dklr);
+    chip->kb0 = _mm256_add_ps(chip->kb0, chip->dkb0);
+    chip->kv = _mm256_add_ps(chip->kv, chip->dkv);
+}
+
+
+// Starts a new ramp from the current coefficients towards the targets
+static void aymo_(retarget)(struct aymo_(chip)* chip)
+{
+    if (chip->smooth_steps) {
+        vf32x8_t rs = _mm256_set1_ps(1.f / (float)chip->smooth_steps);
+        chip->dkb2 = _mm256_mul_ps(_mm256_sub_ps(chip->tkb2, chip->kb2), rs);
+        chip->dka2 = _mm256_mul_ps(_mm256_sub_ps(chip->tka2, chip->ka2), rs);
+        chip->dkb1 = _mm256_mul_ps(_mm256_sub_ps(chip->tkb1, chip->kb1), rs);
+        chip->dka1 = _mm256_mul_ps(_mm256_sub_ps(chip->tka1, chip->ka1), rs);
+        chip->dkrl = _mm256_mul_ps(_mm256_sub_ps(chip->tkrl, chip->krl), rs);
+        chip->dklr = _mm256_mul_ps(_mm256_sub_ps(chip->tklr, chip->klr), rs);
+        chip->dkb0 = _mm256_mul_ps(_mm256_sub_ps(chip->tkb0, chip->kb0), rs);
+        chip->dkv = _mm256_mul_ps(_mm256_sub_ps(chip->tkv, chip->kv), rs);
+
+        chip->smooth_left = (chip->smooth_steps * AYMO_TDA8425_SMOOTH_STEP);
+    }
+    else {
+        aymo_(snap)(chip);
+    }
+}
+
+
+uint8_t aymo_(read)(struct aymo_(chip)* chip, uint16_t address)
+{
+    assert(chip);
+
+    switch (address) {
+        case 0x00u: {
+            return chip->reg_vl;
+        }
+        case 0x01u: {
+            return chip->reg_vr;
+        }
+        case 0x02u: {
+            return chip->reg_ba;
+        }
+        case 0x03u: {
+            return chip->reg_tr;
+        }
+        case 0x07u: {
+            return chip->reg_pp;
+        }
+        case 0x08u: {
+            return chip->reg_sf;
+        }
+        default: {
+            return 0xFFu;
+        }
+    }
+}
+
+
+void aymo_(write)(struct aymo_(chip)* chip, uint16_t address, uint8_t value)
+{
+    assert(chip);
+
+    switch (address) {
+        case 0x00u: {  // VL
+            value |= 0xC0u;
+            chip->reg_vl = value;
+            aymo_(apply_vl)(chip);
+            break;
+        }
+        case 0x01u: {  // VR
+            value |= 0xC0u;
+            chip->reg_vr = value;
+            aymo_(apply_vr)(chip);
+            break;
+        }
+        case 0x02u: {  // BA
+            value |= 0xF0u;
+            chip->reg_ba = value;
+            aymo_(apply_ba)(chip);
+            break;
+        }
+        case 0x03u: {  // TR
+            value |= 0xF0u;
+            chip->reg_tr = value;
+            aymo_(apply_tr)(chip);
+            break;
+        }
+        case 0x07u: {  // PP
+            value |= 0xFCu;
+            chip->reg_pp = value;
+            aymo_(apply_pp)(chip);
+            aymo_(apply_pseudo)(chip);
+            break;
+        }
+        case 0x08u: {  // SF
+            chip->reg_sf = value;
+            aymo_(apply_source_mode)(chip);
+            aymo_(apply_pseudo)(chip);
+            aymo_(apply_tfilter)(chip);
+            aymo_(apply_vl)(chip);
+            aymo_(apply_vr)(chip);
+            aymo_(apply_tr)(chip);
+            break;
+        }
+        default: {
+            return;
+        }
+    }
+
+    aymo_(retarget)(chip);
+}
+
+
+// Runs one frame through the pipelined filter cascade.
+// Feedback and feedforward products of the same delay are paired with plain adds, so that
+// cancelling pole-zero pairs (T-filter disabled) stay exact and do not drift.
+static inline vf32x8_t aymo_(step_f32)(
+    vf32x8_t xx,
+    vf32x8_t* b2, vf32x8_t* a2, vf32x8_t* b1, vf32x8_t* a1,
+    vf32x8_t kb2, vf32x8_t ka2, vf32x8_t kb1, vf32x8_t ka1, vf32x8_t kb0
+)
+{
+    vf32x8_t y2 = _mm256_add_ps(_mm256_mul_ps(*b2, kb2), _mm256_mul_ps(*a2, ka2));
+    vf32x8_t y1 = _mm256_add_ps(_mm256_mul_ps(*b1, kb1), _mm256_mul_ps(*a1, ka1));
+
+    vf32x8_t b0 = mm256_alignr_ps(*a1, xx, 3);
+    vf32x8_t a0 = _mm256_add_ps(_mm256_fmadd_ps(b0, kb0, y2), y1);
+
+    *b2 = *b1;
+    *a2 = *a1;
+
+    *b1 = b0;
+    *a1 = a0;
+    return a0;
+}
+
+
+static void aymo_(run_f32)(struct aymo_(chip)* chip, uint32_t count, const float x[], float y[])
+{
+    assert(chip);
+    assert(x);
+    assert(y);
+
+    if AYMO_UNLIKELY(!count) {
+        return;
+    }
+
+    vf32x8_t kb2 = chip->kb2;
+    vf32x8_t ka2 = chip->ka2;
+    vf32x8_t b2  = chip->hb1;
+    vf32x8_t a2  = chip->ha1;
+
+    vf32x8_t kb1 = chip->kb1;
+    vf32x8_t ka1 = chip->ka1;
+    vf32x8_t b1  = chip->hb0;
+    vf32x8_t a1  = chip->ha0;
+
+    vf32x8_t klr = chip->klr;
+    vf32x8_t krl = chip->krl;
+
+    vf32x8_t kb0 = chip->kb0;
+
+    vf32x8_t kv = chip->kv;
+
+    // Blocks of 4 frames: full-width input mixing, volume, and stores
+    if (count >= 4u) {
+        const vi32x8_t ilr = _mm256_set_epi32(7, 3, 7, 3, 7, 3, 7, 3);
+        vf32x8_t kxx = _mm256_permutevar8x32_ps(klr, ilr);  // L<-L, R<-R
+        vf32x8_t kxs = _mm256_permutevar8x32_ps(krl, ilr);  // L<-R, R<-L
+        vf32x8_t kvv = _mm256_permutevar8x32_ps(kv, ilr);
+
+        const vi32x8_t ix0 = _mm256_set_epi32(1, 1, 1, 1, 0, 0, 0, 0);
+        const vi32x8_t ix1 = _mm256_set_epi32(3, 3, 3, 3, 2, 2, 2, 2);
+        const vi32x8_t ix2 = _mm256_set_epi32(5, 5, 5, 5, 4, 4, 4, 4);
+        const vi32x8_t ix3 = _mm256_set_epi32(7, 7, 7, 7, 6, 6, 6, 6);
+        const vi32x8_t iy  = _mm256_set_epi32(7, 3, 6, 2, 5, 1, 4, 0);
+
+        do {
+            // Mix 4 frames at once; lanes 3 and 7 of each frame vector feed the cascade
+            vf32x8_t xv = _mm256_loadu_ps(x); x += 8u;
+            vf32x8_t xs = _mm256_permute_ps(xv, 0xB1);
+            vf32x8_t xm = _mm256_fmadd_ps(xv, kxx, _mm256_mul_ps(xs, kxs));
+
+            vf32x8_t o0 = aymo_(step_f32)(_mm256_permutevar8x32_ps(xm, ix0), &b2, &a2, &b1, &a1, kb2, ka2, kb1, ka1, kb0);
+            vf32x8_t o1 = aymo_(step_f32)(_mm256_permutevar8x32_ps(xm, ix1), &b2, &a2, &b1, &a1, kb2, ka2, kb1, ka1, kb0);
+            vf32x8_t o2 = aymo_(step_f32)(_mm256_permutevar8x32_ps(xm, ix2), &b2, &a2, &b1, &a1, kb2, ka2, kb1, ka1, kb0);
+            vf32x8_t o3 = aymo_(step_f32)(_mm256_permutevar8x32_ps(xm, ix3), &b2, &a2, &b1, &a1, kb2, ka2, kb1, ka1, kb0);
+
+            // Gather lanes 3 and 7 of each frame back into interleaved stereo order
+            vf32x8_t o01 = _mm256_unpackhi_ps(o0, o1);
+            vf32x8_t o23 = _mm256_unpackhi_ps(o2, o3);
+            vf32x8_t olr = _mm256_castpd_ps(_mm256_unpackhi_pd(_mm256_castps_pd(o01), _mm256_castps_pd(o23)));
+            vf32x8_t yy = _mm256_mul_ps(_mm256_permutevar8x32_ps(olr, iy), kvv);
+            _mm256_storeu_ps(y, yy); y += 8u;
+
+            count -= 4u;
+        } while (count >= 4u);
+    }
+
+    while (count) {
+        vf32x4_t xl = _mm_set1_ps(x[0]);
+        vf32x4_t xr = _mm_set1_ps(x[1]); x += 2u;
+        vf32x8_t xlr = _mm256_insertf128_ps(_mm256_castps128_ps256(xl), xr, 1);
+        vf32x8_t xrl = _mm256_insertf128_ps(_mm256_castps128_ps256(xr), xl, 1);
+        vf32x8_t xx = _mm256_fmadd_ps(xlr, klr, _mm256_mul_ps(xrl, krl));
+
+        vf32x8_t a0 = aymo_(step_f32)(xx, &b2, &a2, &b1, &a1, kb2, ka2, kb1, ka1, kb0);
+
+        vf32x8_t yy = _mm256_mul_ps(a0, kv);
+        vi32x8_t yyi = _mm256_castps_si256(yy);
+        ((int32_t*)y)[0] = _mm256_extract_epi32(yyi, 3);
+        ((int32_t*)y)[1] = _mm256_extract_epi32(yyi, 7); y += 2u;
+
+        --count;
+    }
+
+    chip->hb1 = b2;
+    chip->ha1 = a2;
+
+    chip->hb0 = b1;
+    chip->ha0 = a1;
+}
+
+
+static inline vi32x8_t aymo_(f32_q)(vf32x8_t f, int q)
+{
+    return _mm256_cvtps_epi32(_mm256_mul_ps(f, _mm256_set1_ps((float)(1L << q))));
+}
+
+
+static inline vf32x8_t aymo_(q_f32)(vi32x8_t i, int q)
+{
+    return _mm256_mul_ps(_mm256_cvtepi32_ps(i), _mm256_set1_ps((float)(1. / (double)(1L << q))));
+}
+
+
+// Multiply-accumulates Q-format lanes into exact 64-bit even/odd sums
+static inline void aymo_(mac_q)(__m256i* even, __m256i* odd, vi32x8_t x, vi32x8_t k)
+{
+    *even = _mm256_add_epi64(*even, _mm256_mul_epi32(x, k));
+    *odd = _mm256_add_epi64(*odd, _mm256_mul_epi32(_mm256_srli_epi64(x, 32), _mm256_srli_epi64(k, 32)));
+}
+
+
+// Rounds 64-bit even/odd sums back to Q-format signal lanes
+static inline vi32x8_t aymo_(round_q)(__m256i even, __m256i odd)
+{
+    const __m256i r = _mm256_set1_epi64x(1LL << (AYMO_TDA8425_Q_COEFF - 1));
+    even = _mm256_srli_epi64(_mm256_add_epi64(even, r), AYMO_TDA8425_Q_COEFF);
+    odd = _mm256_slli_epi64(_mm256_add_epi64(odd, r), (32 - AYMO_TDA8425_Q_COEFF));
+    return _mm256_blend_epi32(even, odd, 0xAA);  // "10101010"
+}
+
+
+static void aymo_(run_i16)(struct aymo_(chip)* chip, uint32_t count, const int16_t x[], int16_t y[])
+{
+    assert(chip);
+    assert(x);
+    assert(y);
+
+    if AYMO_UNLIKELY(!count) {
+        return;
+    }
+
+    const int qk = AYMO_TDA8425_Q_COEFF;
+    const int qs = AYMO_TDA8425_Q_SIGNAL;
+
+    vi32x8_t kb2 = aymo_(f32_q)(chip->kb2, qk);
+    vi32x8_t ka2 = aymo_(f32_q)(chip->ka2, qk);
+    vi32x8_t b2  = aymo_(f32_q)(chip->hb1, qs);
+    vi32x8_t a2  = aymo_(f32_q)(chip->ha1, qs);
+
+    vi32x8_t kb1 = aymo_(f32_q)(chip->kb1, qk);
+    vi32x8_t ka1 = aymo_(f32_q)(chip->ka1, qk);
+    vi32x8_t b1  = aymo_(f32_q)(chip->hb0, qs);
+    vi32x8_t a1  = aymo_(f32_q)(chip->ha0, qs);
+
+    vi32x8_t klr = aymo_(f32_q)(chip->klr, qk);
+    vi32x8_t krl = aymo_(f32_q)(chip->krl, qk);
+
+    vi32x8_t kb0 = aymo_(f32_q)(chip->kb0, qk);
+
+    vi32x8_t kv = aymo_(f32_q)(chip->kv, qk);
+
+    const vi32x8_t plr = _mm256_setr_epi32(0, 0, 0, 0, 1, 1, 1, 1);
+    const vi32x8_t prl = _mm256_setr_epi32(1, 1, 1, 1, 0, 0, 0, 0);
+
+    do {
+        __m256i ev = _mm256_setzero_si256();
+        __m256i od = _mm256_setzero_si256();
+
+        aymo_(mac_q)(&ev, &od, b2, kb2);
+        aymo_(mac_q)(&ev, &od, a2, ka2);
+        aymo_(mac_q)(&ev, &od, b1, kb1);
+        aymo_(mac_q)(&ev, &od, a1, ka1);
+
+        vi32x4_t xi = _mm_cvtepi16_epi32(_mm_cvtsi32_si128(*(const int32_t*)(const void*)x)); x += 2u;
+        xi = _mm_slli_epi32(xi, (qs - 15));
+        vi32x8_t xlr = _mm256_permutevar8x32_epi32(_mm256_castsi128_si256(xi), plr);
+        vi32x8_t xrl = _mm256_permutevar8x32_epi32(_mm256_castsi128_si256(xi), prl);
+        __m256i evx = _mm256_setzero_si256();
+        __m256i odx = _mm256_setzero_si256();
+        aymo_(mac_q)(&evx, &odx, xlr, klr);
+        aymo_(mac_q)(&evx, &odx, xrl, krl);
+        vi32x8_t xx = aymo_(round_q)(evx, odx);
+
+        vi32x8_t b0 = _mm256_alignr_epi8(a1, xx, 12);
+        aymo_(mac_q)(&ev, &od, b0, kb0);
+        vi32x8_t a0 = aymo_(round_q)(ev, od);
+
+        __m256i evy = _mm256_setzero_si256();
+        __m256i ody = _mm256_setzero_si256();
+        aymo_(mac_q)(&evy, &ody, a0, kv);
+        vi32x8_t yy = aymo_(round_q)(evy, ody);
+        yy = _mm256_add_epi32(yy, _mm256_set1_epi32(1 << (qs - 16)));
+        yy = _mm256_srai_epi32(yy, (qs - 15));
+        yy = _mm256_packs_epi32(yy, yy);
+        y[0] = (int16_t)_mm256_extract_epi16(yy, 3);
+        y[1] = (int16_t)_mm256_extract_epi16(yy, 11); y += 2u;
+
+        b2 = b1;
+        a2 = a1;
+
+        b1 = b0;
+        a1 = a0;
+    } while (--count);
+
+    chip->hb1 = aymo_(q_f32)(b2, qs);
+    chip->ha1 = aymo_(q_f32)(a2, qs);
+
+    chip->hb0 = aymo_(q_f32)(b1, qs);
+    chip->ha0 = aymo_(q_f32)(a1, qs);
+}
+
+
+// Advances the ramp by the given frames, which never cross a ramp step boundary
+static void aymo_(advance)(struct aymo_(chip)* chip, uint32_t count)
+{
+    chip->smooth_left -= count;
+
+    if (!chip->smooth_left) {
+        aymo_(snap)(chip);
+    }
+    else if (!(chip->smooth_left % AYMO_TDA8425_SMOOTH_STEP)) {
+        aymo_(ramp)(chip);
+    }
+}
+
+
+// Frames to process before the next ramp step, if ramping
+static inline uint32_t aymo_(run_length)(const struct aymo_(chip)* chip, uint32_t count)
+{
+    if AYMO_UNLIKELY(chip->smooth_left) {
+        uint32_t n = (((chip->smooth_left - 1u) % AYMO_TDA8425_SMOOTH_STEP) + 1u);
+        if (count > n) {
+            count = n;
+        }
+    }
+    return count;
+}
+
+
+// Zeroes the filter states once all of their magnitudes fall below the silence threshold
+static void aymo_(gate_silence)(struct aymo_(chip)* chip)
+{
+    vf32x8_t sign = _mm256_set1_ps(-0.f);
+    vf32x8_t m1 = _mm256_max_ps(_mm256_andnot_ps(sign, chip->hb1), _mm256_andnot_ps(sign, chip->ha1));
+    vf32x8_t m0 = _mm256_max_ps(_mm256_andnot_ps(sign, chip->hb0), _mm256_andnot_ps(sign, chip->ha0));
+    vf32x8_t m = _mm256_max_ps(m1, m0);
+    vf32x8_t quiet = _mm256_cmp_ps(m, _mm256_set1_ps(chip->silence), _CMP_LT_OQ);
+
+    if (_mm256_movemask_ps(quiet) == 0xFF) {
+        vf32x8_t z = _mm256_setzero_ps();
+        chip->hb1 = z;
+        chip->ha1 = z;
+        chip->hb0 = z;
+        chip->ha0 = z;
+    }
+}
+
+
+void aymo_(process_f32)(struct aymo_(chip)* chip, uint32_t count, const float x[], float y[])
+{
+    assert(chip);
+    assert(x);
+    assert(y);
+
+    aymo_cpu_fpstate_t fpstate = aymo_cpu_enter_ftz();
+
+    while (count) {
+        uint32_t n = aymo_(run_length)(chip, count);
+        aymo_(run_f32)(chip, n, x, y);
+        x += (n * 2u);
+        y += (n * 2u);
+        count -= n;
+
+        if AYMO_UNLIKELY(chip->smooth_left) {
+            aymo_(advance)(chip, n);
+        }
+    }
+
+    if (chip->silence > 0.f) {
+        aymo_(gate_silence)(chip);
+    }
+
+    aymo_cpu_leave_ftz(fpstate);
+}
+
+
+void aymo_(process_i16)(struct aymo_(chip)* chip, uint32_t count, const int16_t x[], int16_t y[])
+{
+    assert(chip);
+    assert(x);
+    assert(y);
+
+    while (count) {
+        uint32_t n = aymo_(run_length)(chip, count);
+        aymo_(run_i16)(chip, n, x, y);
+        x += (n * 2u);
+        y += (n * 2u);
+        count -= n;
+
+        if AYMO_UNLIKELY(chip->smooth_left) {
+            aymo_(advance)(chip, n);
+        }
+    }
+
+    if (chip->silence > 0.f) {
+        aymo_(gate_silence)(chip);
+    }
+}
+
+
+void aymo_(set_coeffs)(struct aymo_(chip)* chip, struct aymo_tda8425_coeffs* coeffs)
+{
+    assert(chip);
+    assert(!coeffs || (coeffs->sample_rate == chip->sample_rate));
+
+    // Cached and computed coefficients are the same, so there is nothing to reapply
+    chip->coeffs = coeffs;
+}
+
+
+void aymo_(set_smoothing)(struct aymo_(chip)* chip, uint32_t frames)
+{
+    assert(chip);
+
+    uint32_t steps = ((frames / AYMO_TDA8425_SMOOTH_STEP) + ((frames % AYMO_TDA8425_SMOOTH_STEP) != 0u));
+    if (steps > (UINT32_MAX / AYMO_TDA8425_SMOOTH_STEP)) {
+        steps = (UINT32_MAX / AYMO_TDA8425_SMOOTH_STEP);
+    }
+    chip->smooth_steps = steps;
+
+    if (!steps) {
+        aymo_(snap)(chip);
+    }
+}
+
+
+void aymo_(set_silence)(struct aymo_(chip)* chip, float threshold)
+{
+    assert(chip);
+    assert(threshold >= 0.f);
+
+    chip->silence = threshold;
+}
+
+
+AYMO_CXX_EXTERN_C_END
+
+#endif  // AYMO_CPU_SUPPORT_X86_FMA3
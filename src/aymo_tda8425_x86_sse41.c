@@ -29,21 +29,6 @@ along with AYMO. If not, see <https://www.gnu.org/licenses/>.
 
 AYMO_CXX_EXTERN_C_BEGIN
 
-#undef cos
-#undef fabs
-#undef log10
-#undef pow
-#undef sqrt
-#undef tan
-
-#define cos     (aymo_tda8425_math->cos)
-#define fabs    (aymo_tda8425_math->fabs)
-#define log10   (aymo_tda8425_math->log10)
-#define pow     (aymo_tda8425_math->pow)
-#define sqrt    (aymo_tda8425_math->sqrt)
-#define tan     (aymo_tda8425_math->tan)
-
-
 #undef mm_insert_ps
 #define mm_insert_ps(a, b, imm8)  \
     (_mm_blend_ps((a), _mm_set1_ps(b), (1 << (imm8))))
@@ -62,7 +47,11 @@ const struct aymo_tda8425_vt aymo_(vt) =
     (aymo_tda8425_dtor_f)&(aymo_(dtor)),
     (aymo_tda8425_read_f)&(aymo_(read)),
     (aymo_tda8425_write_f)&(aymo_(write)),
-    (aymo_tda8425_process_f32_f)&(aymo_(process_f32))
+    (aymo_tda8425_process_f32_f)&(aymo_(process_f32)),
+    (aymo_tda8425_process_i16_f)&(aymo_(process_i16)),
+    (aymo_tda8425_set_coeffs_f)&(aymo_(set_coeffs)),
+    (aymo_tda8425_set_smoothing_f)&(aymo_(set_smoothing)),
+    (aymo_tda8425_set_silence_f)&(aymo_(set_silence))
 };
 
 
@@ -108,88 +97,46 @@ void aymo_(dtor)(struct aymo_(chip)* chip)
 }
 
 
-static void aymo_(apply_vl)(struct aymo_(chip)* chip)
+// Stores biquad coefficients into the target lanes selected by mask
+static void aymo_(store_biquad)(struct aymo_(chip)* chip, const struct aymo_tda8425_biquad* bq, vf32x4_t mask)
 {
-    double db = (double)aymo_tda8425_reg_v_to_db[chip->reg_vl & 0x3Fu];
+    chip->tkb0 = _mm_blendv_ps(chip->tkb0, _mm_set1_ps(bq->kb0), mask);
+    chip->tkb1 = _mm_blendv_ps(chip->tkb1, _mm_set1_ps(bq->kb1), mask);
+    chip->tkb2 = _mm_blendv_ps(chip->tkb2, _mm_set1_ps(bq->kb2), mask);
+    chip->tka1 = _mm_blendv_ps(chip->tka1, _mm_set1_ps(bq->ka1), mask);
+    chip->tka2 = _mm_blendv_ps(chip->tka2, _mm_set1_ps(bq->ka2), mask);
+}
 
-    if (chip->reg_sf & 0x20u) {  // mute
-        db = -90.;
-    }
 
-    double g = pow(10., (db * .05));
-    chip->kv = mm_insert_ps(chip->kv, (float)g, 2);
+static void aymo_(apply_vl)(struct aymo_(chip)* chip)
+{
+    float g = aymo_tda8425_lookup_volume(chip->coeffs, chip->reg_vl, chip->reg_sf);
+    chip->tkv = mm_insert_ps(chip->tkv, g, 2);
 }
 
 
 static void aymo_(apply_vr)(struct aymo_(chip)* chip)
 {
-    double db = (double)aymo_tda8425_reg_v_to_db[chip->reg_vr & 0x3Fu];
-
-    if (chip->reg_sf & 0x20u) {  // mute
-        db = -90.;
-    }
-
-    double g = pow(10., (db * .05));
-    chip->kv = mm_insert_ps(chip->kv, (float)g, 3);
+    float g = aymo_tda8425_lookup_volume(chip->coeffs, chip->reg_vr, chip->reg_sf);
+    chip->tkv = mm_insert_ps(chip->tkv, g, 3);
 }
 
 
 static void aymo_(apply_ba)(struct aymo_(chip)* chip)
 {
-    double dbb = (double)aymo_tda8425_reg_ba_to_db[chip->reg_ba & 0x0Fu];
-    double gb = pow(10., (dbb * (.05 * .5)));
-    double fs = (double)chip->sample_rate;
-    double pi = 3.14159265358979323846264338327950288;
-    double fcb = 300.;  // [Hz]
-    double wb = ((2. * pi) * fcb);
-    double kb = (tan(wb * (.5 / fs)) / wb);
-
-    double a0 = ((kb * wb) + gb);
-    double a1 = ((kb * wb) - gb);
-    double a2 = 0.;
-
-    double b0 = (((kb * wb) * (gb * gb)) + gb);
-    double b1 = (((kb * wb) * (gb * gb)) - gb);
-    double b2 = 0.;
-
-    double ra0 = (1. / a0);
-    chip->kb0 = mm_insert_ps(chip->kb0, (float)(b0 * ra0), 2);
-    chip->kb1 = mm_insert_ps(chip->kb1, (float)(b1 * ra0), 2);
-    chip->kb2 = mm_insert_ps(chip->kb2, (float)(b2 * ra0), 2);
-    ra0 = -ra0;
-    chip->ka1 = mm_insert_ps(chip->ka1, (float)(a1 * ra0), 2);
-    chip->ka2 = mm_insert_ps(chip->ka2, (float)(a2 * ra0), 2);
+    struct aymo_tda8425_biquad tmp;
+    const struct aymo_tda8425_biquad* bq =
+        aymo_tda8425_lookup_bass(chip->coeffs, &tmp, chip->sample_rate, chip->reg_ba);
+    aymo_(store_biquad)(chip, bq, _mm_castsi128_ps(_mm_set_epi32(0, -1, 0, 0)));
 }
 
 
 static void aymo_(apply_tr)(struct aymo_(chip)* chip)
 {
-    double db = (double)aymo_tda8425_reg_tr_to_db[chip->reg_tr & 0x0Fu];
-    double gt = pow(10., (db * (.05 * .5)));
-    double fs = (double)chip->sample_rate;
-    double pi = 3.14159265358979323846264338327950288;
-    double fcd = 10.;  // [Hz]
-    double wd = ((2. * pi) * fcd);
-    double kd = ((chip->reg_sf & 0x40u) ? 0. : (tan(wd * (.5 / fs)) / wd));
-    double fct = 4500.;  // [Hz]
-    double wt = ((2. * pi) * fct);
-    double kt = (tan(wt * (.5 / fs)) / wt);
-
-    double a0 = (((gt * kt * wt) * (kd * wd)) + ((gt * kt * wt) + (kd * wd)) + 1.);
-    double a1 = (((gt * kt * wt) * (kd * wd) * 2.) - 2.);
-    double a2 = (((gt * kt * wt) * (kd * wd)) - ((gt * kt * wt) + (kd * wd)) + 1.);
-
-    double b0 = ((gt * gt) + (gt * kt * wt));
-    double b1 = ((gt * gt) * -2.);
-    double b2 = ((gt * gt) - (gt * kt * wt));
-
-    double ra0 = (1. / a0);
-    chip->kb0 = mm_insert_ps(chip->kb0, (float)(b0 * ra0), 1);
-    chip->kb1 = mm_insert_ps(chip->kb1, (float)(b1 * ra0), 1);
-    chip->kb2 = mm_insert_ps(chip->kb2, (float)(b2 * ra0), 1);
-    ra0 = -ra0;
-    chip->ka1 = mm_insert_ps(chip->ka1, (float)(a1 * ra0), 1);
-    chip->ka2 = mm_insert_ps(chip->ka2, (float)(a2 * ra0), 1);
+    struct aymo_tda8425_biquad tmp;
+    const struct aymo_tda8425_biquad* bq =
+        aymo_tda8425_lookup_treble(chip->coeffs, &tmp, chip->sample_rate, chip->reg_tr, chip->reg_sf);
+    aymo_(store_biquad)(chip, bq, _mm_castsi128_ps(_mm_set_epi32(0, 0, -1, 0)));
 }
 
 
@@ -250,105 +197,26 @@ static void aymo_(apply_source_mode)(struct aymo_(chip)* chip)
         }
     }  // not forced mono
 
-    chip->klr = klr;
-    chip->krl = krl;
+    chip->tklr = klr;
+    chip->tkrl = krl;
 }
 
 
 static void aymo_(apply_pseudo)(struct aymo_(chip)* chip)
 {
-    uint8_t mode = ((chip->reg_sf >> 3u) & 0x03u);
-
-    // Pseudo stereo
-    if (mode == 0x02u) {  // enabled
-        double c1 = (double)chip->pseudo_c1;
-        double c2 = (double)chip->pseudo_c2;
-        double r1 = 15000.;  // [ohm]
-        double r2 = 15000.;  // [ohm]
-        double t1 = (c1 * r1);
-        double t2 = (c2 * r2);
-
-        double fs = (double)chip->sample_rate;
-        double k = (.5 / fs);
-        double kk = (k * k);
-        double t1_t2 = (t1 * t2);
-        double t1_t2_k = ((t1 + t2) * k);
-
-        double a0 = (kk + t1_t2 + t1_t2_k);
-        double a1 = ((kk - t1_t2) * 2.);
-        double a2 = (kk + t1_t2 - t1_t2_k);
-
-        double b0 = a2;
-        double b1 = a1;
-        double b2 = a0;
-
-        double ra0 = (1. / a0);
-        chip->kb0 = mm_insert_ps(chip->kb0, (float)(b0 * ra0), 0);
-        chip->kb1 = mm_insert_ps(chip->kb1, (float)(b1 * ra0), 0);
-        chip->kb2 = mm_insert_ps(chip->kb2, (float)(b2 * ra0), 0);
-        ra0 = -ra0;
-        chip->ka1 = mm_insert_ps(chip->ka1, (float)(a1 * ra0), 0);
-        chip->ka2 = mm_insert_ps(chip->ka2, (float)(a2 * ra0), 0);
-    }
-    else {  // pass-through
-        chip->kb0 = mm_insert_ps(chip->kb0, 1.f, 0);
-        chip->kb1 = mm_insert_ps(chip->kb1, .0f, 0);
-        chip->kb2 = mm_insert_ps(chip->kb2, .0f, 0);
-
-        chip->ka1 = mm_insert_ps(chip->ka1, .0f, 0);
-        chip->ka2 = mm_insert_ps(chip->ka2, .0f, 0);
-    }
+    struct aymo_tda8425_biquad tmp;
+    const struct aymo_tda8425_biquad* bq =
+        aymo_tda8425_lookup_pseudo(chip->coeffs, &tmp, chip->sample_rate, chip->reg_pp, chip->reg_sf);
+    aymo_(store_biquad)(chip, bq, _mm_castsi128_ps(_mm_set_epi32(0, 0, 0, -1)));
 }
 
 
 static void aymo_(apply_tfilter)(struct aymo_(chip)* chip)
 {
-    // T-filter
-    if (chip->reg_sf & 0x80u) {  // pass-through
-        chip->kb0 = mm_insert_ps(chip->kb0, 1.f, 3);
-        chip->kb1 = mm_insert_ps(chip->kb1, .0f, 3);
-        chip->kb2 = mm_insert_ps(chip->kb2, .0f, 3);
-
-        chip->ka1 = mm_insert_ps(chip->ka1, .0f, 3);
-        chip->ka2 = mm_insert_ps(chip->ka2, .0f, 3);
-    }
-    else {  // enabled
-        double db = (double)aymo_tda8425_reg_ba_to_db[chip->reg_ba & 0x0Fu];
-        double g = pow(10., (db * (.05 * .5)));
-        double fs = (double)chip->sample_rate;
-        double pi = 3.14159265358979323846264338327950288;
-        double fc = 180.;  // [Hz]
-        double w = ((2. * pi) * fc);
-        double k = (tan(w * (.5 / fs)) / w);
-
-        double log10_g = log10(g);
-        double ang = (log10_g * .85);
-        double abs_sqrt_log10_g = sqrt(fabs(log10_g));
-        double abs2_sqrt_log10_g = abs_sqrt_log10_g * abs_sqrt_log10_g;
-        double kw = (k * w);
-        double m_k2w2 = ((kw * kw) * -.05);
-        double sqrt_5 = 2.23606797749978980505147774238139391;
-        double ph = (pi * .75);
-        double h_sqrt_5_kw_abs_sqrt_log10_g = ((sqrt_5 * .2) * kw * abs_sqrt_log10_g);
-        double cosm = cos(ang - ph);
-        double cosp = cos(ang + ph);
-
-        double a0 = (((m_k2w2 - abs2_sqrt_log10_g) + (h_sqrt_5_kw_abs_sqrt_log10_g * cosm)));
-        double a1 = (((m_k2w2 + abs2_sqrt_log10_g)) * 2.);
-        double a2 = (((m_k2w2 - abs2_sqrt_log10_g) - (h_sqrt_5_kw_abs_sqrt_log10_g * cosm)));
-
-        double b0 = (((m_k2w2 - abs2_sqrt_log10_g) + (h_sqrt_5_kw_abs_sqrt_log10_g * cosp)));
-        double b1 = a1;
-        double b2 = (((m_k2w2 - abs2_sqrt_log10_g) - (h_sqrt_5_kw_abs_sqrt_log10_g * cosp)));
-
-        double ra0 = (1. / a0);
-        chip->kb0 = mm_insert_ps(chip->kb0, (float)(b0 * ra0), 3);
-        chip->kb1 = mm_insert_ps(chip->kb1, (float)(b1 * ra0), 3);
-        chip->kb2 = mm_insert_ps(chip->kb2, (float)(b2 * ra0), 3);
-        ra0 = -ra0;
-        chip->ka1 = mm_insert_ps(chip->ka1, (float)(a1 * ra0), 3);
-        chip->ka2 = mm_insert_ps(chip->ka2, (float)(a2 * ra0), 3);
-    }
+    struct aymo_tda8425_biquad tmp;
+    const struct aymo_tda8425_biquad* bq =
+        aymo_tda8425_lookup_tfilter(chip->coeffs, &tmp, chip->sample_rate, chip->reg_ba, chip->reg_sf);
+    aymo_(store_biquad)(chip, bq, _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0)));
 }
 
 
@@ -363,6 +231,57 @@ static void aymo_(apply_pp)(struct aymo_(chip)* chip)
 }
 
 
+// Applies the coefficient targets at once, ending any ramp
+static void aymo_(snap)(struct aymo_(chip)* chip)
+{
+    chip->kb2 = chip->tkb2;
+    chip->ka2 = chip->tka2;
+    chip->kb1 = chip->tkb1;
+    chip->ka1 = chip->tka1;
+    chip->klr = chip->tklr;
+    chip->krl = chip->tkrl;
+    chip->kb0 = chip->tkb0;
+    chip->kv = chip->tkv;
+    chip->smooth_left = 0u;
+}
+
+
+// Moves the coefficients one ramp step towards their targets
+static void aymo_(ramp)(struct aymo_(chip)* chip)
+{
+    chip->kb2 = _mm_add_ps(chip->kb2, chip->dkb2);
+    chip->ka2 = _mm_add_ps(chip->ka2, chip->dka2);
+    chip->kb1 = _mm_add_ps(chip->kb1, chip->dkb1);
+    chip->ka1 = _mm_add_ps(chip->ka1, chip->dka1);
+    chip->klr = _mm_add_ps(chip->klr, chip->dklr);
+    chip->krl = _mm_add_ps(chip->krl, chip->dkrl);
+    chip->kb0 = _mm_add_ps(chip->kb0, chip->dkb0);
+    chip->kv = _mm_add_ps(chip->kv, chip->dkv);
+}
+
+
+// Starts a new ramp from the current coefficients towards the targets
+static void aymo_(retarget)(struct aymo_(chip)* chip)
+{
+    if (chip->smooth_steps) {
+        vf32x4_t rs = _mm_set1_ps(1.f / (float)chip->smooth_steps);
+        chip->dkb2 = _mm_mul_ps(_mm_sub_ps(chip->tkb2, chip->kb2), rs);
+        chip->dka2 = _mm_mul_ps(_mm_sub_ps(chip->tka2, chip->ka2), rs);
+        chip->dkb1 = _mm_mul_ps(_mm_sub_ps(chip->tkb1, chip->kb1), rs);
+        chip->dka1 = _mm_mul_ps(_mm_sub_ps(chip->tka1, chip->ka1), rs);
+        chip->dklr = _mm_mul_ps(_mm_sub_ps(chip->tklr, chip->klr), rs);
+        chip->dkrl = _mm_mul_ps(_mm_sub_ps(chip->tkrl, chip->krl), rs);
+        chip->dkb0 = _mm_mul_ps(_mm_sub_ps(chip->tkb0, chip->kb0), rs);
+        chip->dkv = _mm_mul_ps(_mm_sub_ps(chip->tkv, chip->kv), rs);
+
+        chip->smooth_left = (chip->smooth_steps * AYMO_TDA8425_SMOOTH_STEP);
+    }
+    else {
+        aymo_(snap)(chip);
+    }
+}
+
+
 uint8_t aymo_(read)(struct aymo_(chip)* chip, uint16_t address)
 {
     assert(chip);
@@ -439,11 +358,16 @@ void aymo_(write)(struct aymo_(chip)* chip, uint16_t address, uint8_t value)
             aymo_(apply_tr)(chip);
             break;
         }
+        default: {
+            return;
+        }
     }
+
+    aymo_(retarget)(chip);
 }
 
 
-void aymo_(process_f32)(struct aymo_(chip)* chip, uint32_t count, const float x[], float y[])
+static void aymo_(run_f32)(struct aymo_(chip)* chip, uint32_t count, const float x[], float y[])
 {
     assert(chip);
     assert(x);
@@ -523,6 +447,387 @@ void aymo_(process_f32)(struct aymo_(chip)* chip, uint32_t count, const float x[
 }
 
 
+static inline vi32x4_t aymo_(f32_q)(vf32x4_t f, int q)
+{
+    return _mm_cvtps_epi32(_mm_mul_ps(f, _mm_set1_ps((float)(1L << q))));
+}
+
+
+static inline vf32x4_t aymo_(q_f32)(vi32x4_t i, int q)
+{
+    return _mm_mul_ps(_mm_cvtepi32_ps(i), _mm_set1_ps((float)(1. / (double)(1L << q))));
+}
+
+
+// Multiply-accumulates Q-format lanes into exact 64-bit even/odd sums
+static inline void aymo_(mac_q)(__m128i* even, __m128i* odd, vi32x4_t x, vi32x4_t k)
+{
+    *even = _mm_add_epi64(*even, _mm_mul_epi32(x, k));
+    *odd = _mm_add_epi64(*odd, _mm_mul_epi32(_mm_srli_epi64(x, 32), _mm_srli_epi64(k, 32)));
+}
+
+
+// Rounds 64-bit even/odd sums back to Q-format signal lanes
+static inline vi32x4_t aymo_(round_q)(__m128i even, __m128i odd)
+{
+    const __m128i r = _mm_set1_epi64x(1LL << (AYMO_TDA8425_Q_COEFF - 1));
+    even = _mm_srli_epi64(_mm_add_epi64(even, r), AYMO_TDA8425_Q_COEFF);
+    odd = _mm_slli_epi64(_mm_add_epi64(odd, r), (32 - AYMO_TDA8425_Q_COEFF));
+    return _mm_blend_epi16(even, odd, 0xCC);  // "1010"
+}
+
+
+static void aymo_(run_i16)(struct aymo_(chip)* chip, uint32_t count, const int16_t x[], int16_t y[])
+{
+    assert(chip);
+    assert(x);
+    assert(y);
+
+    if AYMO_UNLIKELY(!count) {
+        return;
+    }
+
+    const int qk = AYMO_TDA8425_Q_COEFF;
+    const int qs = AYMO_TDA8425_Q_SIGNAL;
+
+    vi32x4_t kb2 = aymo_(f32_q)(chip->kb2, qk);
+    vi32x4_t ka2 = aymo_(f32_q)(chip->ka2, qk);
+
+    vi32x4_t b2l = aymo_(f32_q)(chip->hb1l, qs);
+    vi32x4_t a2l = aymo_(f32_q)(chip->ha1l, qs);
+
+    vi32x4_t b2r = aymo_(f32_q)(chip->hb1r, qs);
+    vi32x4_t a2r = aymo_(f32_q)(chip->ha1r, qs);
+
+    vi32x4_t kb1 = aymo_(f32_q)(chip->kb1, qk);
+    vi32x4_t ka1 = aymo_(f32_q)(chip->ka1, qk);
+
+    vi32x4_t b1l = aymo_(f32_q)(chip->hb0l, qs);
+    vi32x4_t a1l = aymo_(f32_q)(chip->ha0l, qs);
+
+    vi32x4_t b1r = aymo_(f32_q)(chip->hb0r, qs);
+    vi32x4_t a1r = aymo_(f32_q)(chip->ha0r, qs);
+
+    vi32x4_t klr = aymo_(f32_q)(chip->klr, qk);
+    vi32x4_t krl = aymo_(f32_q)(chip->krl, qk);
+
+    vi32x4_t kb0 = aymo_(f32_q)(chip->kb0, qk);
+
+    vi32x4_t kv = aymo_(f32_q)(chip->kv, qk);
+
+    do {
+        __m128i evl = _mm_setzero_si128();
+        __m128i odl = _mm_setzero_si128();
+        __m128i evr = _mm_setzero_si128();
+        __m128i odr = _mm_setzero_si128();
+
+        aymo_(mac_q)(&evl, &odl, b2l, kb2);
+        aymo_(mac_q)(&evl, &odl, a2l, ka2);
+        aymo_(mac_q)(&evr, &odr, b2r, kb2);
+        aymo_(mac_q)(&evr, &odr, a2r, ka2);
+
+        aymo_(mac_q)(&evl, &odl, b1l, kb1);
+        aymo_(mac_q)(&evl, &odl, a1l, ka1);
+        aymo_(mac_q)(&evr, &odr, b1r, kb1);
+        aymo_(mac_q)(&evr, &odr, a1r, ka1);
+
+        vi32x4_t xi = _mm_cvtepi16_epi32(_mm_cvtsi32_si128(*(const int32_t*)(const void*)x)); x += 2u;
+        xi = _mm_slli_epi32(xi, (qs - 15));
+        vi32x4_t xlr = _mm_shuffle_epi32(xi, _MM_SHUFFLE(1, 0, 1, 0));  // "01.."
+        vi32x4_t xrl = _mm_shuffle_epi32(xi, _MM_SHUFFLE(0, 1, 0, 1));  // "10.."
+        __m128i evx = _mm_setzero_si128();
+        __m128i odx = _mm_setzero_si128();
+        aymo_(mac_q)(&evx, &odx, xlr, klr);
+        aymo_(mac_q)(&evx, &odx, xrl, krl);
+        vi32x4_t xx = aymo_(round_q)(evx, odx);
+
+        vi32x4_t xl = _mm_shuffle_epi32(xx, _MM_SHUFFLE(2, 3, 0, 1));  // "2..."
+        vi32x4_t b0l = _mm_alignr_epi8(a1l, xl, 12);
+        vi32x4_t b0r = _mm_alignr_epi8(a1r, xx, 12);
+
+        aymo_(mac_q)(&evl, &odl, b0l, kb0);
+        aymo_(mac_q)(&evr, &odr, b0r, kb0);
+        vi32x4_t a0l = aymo_(round_q)(evl, odl);
+        vi32x4_t a0r = aymo_(round_q)(evr, odr);
+
+        vi32x4_t yy = _mm_shuffle_epi32(a0l, _MM_SHUFFLE(2, 3, 0, 1));  // ".3.."
+        yy = _mm_blend_epi16(yy, a0r, 0xC0);  // "1000"
+        __m128i evy = _mm_setzero_si128();
+        __m128i ody = _mm_setzero_si128();
+        aymo_(mac_q)(&evy, &ody, yy, kv);
+        yy = aymo_(round_q)(evy, ody);
+        yy = _mm_add_epi32(yy, _mm_set1_epi32(1 << (qs - 16)));
+        yy = _mm_srai_epi32(yy, (qs - 15));
+        yy = _mm_packs_epi32(yy, yy);
+        *(int32_t*)(void*)y = _mm_extract_epi32(yy, 1); y += 2u;
+
+        b2l = b1l;
+        a2l = a1l;
+        b2r = b1r;
+        a2r = a1r;
+
+        b1l = b0l;
+        a1l = a0l;
+        b1r = b0r;
+        a1r = a0r;
+    } while (--count);
+
+    chip->hb1l = aymo_(q_f32)(b2l, qs);
+    chip->ha1l = aymo_(q_f32)(a2l, qs);
+    chip->hb1r = aymo_(q_f32)(b2r, qs);
+    chip->ha1r = aymo_(q_f32)(a2r, qs);
+
+    chip->hb0l = aymo_(q_f32)(b1l, qs);
+    chip->ha0l = aymo_(q_f32)(a1l, qs);
+    chip->hb0r = aymo_(q_f32)(b1r, qs);
+    chip->ha0r = aymo_(q_f32)(a1r, qs);
+}
+
+
+// Advances the ramp by the given frames, which never cross a ramp step boundary
+static void aymo_(advance)(struct aymo_(chip)* chip, uint32_t count)
+{
+    chip->smooth_left -= count;
+
+    if (!chip->smooth_left) {
+        aymo_(snap)(chip);
+    }
+    else if (!(chip->smooth_left % AYMO_TDA8425_SMOOTH_STEP)) {
+        aymo_(ramp)(chip);
+    }
+}
+
+
+// Frames to process before the next ramp step, if ramping
+static inline uint32_t aymo_(run_length)(const struct aymo_(chip)* chip, uint32_t count)
+{
+    if AYMO_UNLIKELY(chip->smooth_left) {
+        uint32_t n = (((chip->smooth_left - 1u) % AYMO_TDA8425_SMOOTH_STEP) + 1u);
+        if (count > n) {
+            count = n;
+        }
+    }
+    return count;
+}
+
+
+// Zeroes the filter states once all of their magnitudes fall below the silence threshold
+static void aymo_(gate_silence)(struct aymo_(chip)* chip)
+{
+    vf32x4_t sign = _mm_set1_ps(-0.f);
+    vf32x4_t m1l = _mm_max_ps(_mm_andnot_ps(sign, chip->hb1l), _mm_andnot_ps(sign, chip->ha1l));
+    vf32x4_t m1r = _mm_max_ps(_mm_andnot_ps(sign, chip->hb1r), _mm_andnot_ps(sign, chip->ha1r));
+    vf32x4_t m0l = _mm_max_ps(_mm_andnot_ps(sign, chip->hb0l), _mm_andnot_ps(sign, chip->ha0l));
+    vf32x4_t m0r = _mm_max_ps(_mm_andnot_ps(sign, chip->hb0r), _mm_andnot_ps(sign, chip->ha0r));
+    vf32x4_t m = _mm_max_ps(_mm_max_ps(m1l, m1r), _mm_max_ps(m0l, m0r));
+    vf32x4_t quiet = _mm_cmplt_ps(m, _mm_set1_ps(chip->silence));
+
+    if (_mm_movemask_ps(quiet) == 0xF) {
+        vf32x4_t z = _mm_setzero_ps();
+        chip->hb1l = z;
+        chip->ha1l = z;
+        chip->hb1r = z;
+        chip->ha1r = z;
+        chip->hb0l = z;
+        chip->ha0l = z;
+        chip->hb0r = z;
+        chip->ha0r = z;
+    }
+}
+
+
+void aymo_(process_f32)(struct aymo_(chip)* chip, uint32_t count, const float x[], float y[])
+{
+    assert(chip);
+    assert(x);
+    assert(y);
+
+    aymo_cpu_fpstate_t fpstate = aymo_cpu_enter_ftz();
+
+    while (count) {
+        uint32_t n = aymo_(run_length)(chip, count);
+        aymo_(run_f32)(chip, n, x, y);
+        x += (n * 2u);
+        y += (n * 2u);
+        count -= n;
+
+        if AYMO_UNLIKELY(chip->smooth_left) {
+            aymo_(advance)(chip, n);
+        }
+    }
+
+    if (chip->silence > 0.f) {
+        aymo_(gate_silence)(chip);
+    }
+
+    aymo_cpu_leave_ftz(fpstate);
+}
+
+
+void aymo_(process_i16)(struct aymo_(chip)* chip, uint32_t count, const int16_t x[], int16_t y[])
+{
+    assert(chip);
+    assert(x);
+    assert(y);
+
+    while (count) {
+        uint32_t n = aymo_(run_length)(chip, count);
+        aymo_(run_i16)(chip, n, x, y);
+        x += (n * 2u);
+        y += (n * 2u);
+        count -= n;
+
+        if AYMO_UNLIKELY(chip->smooth_left) {
+            aymo_(advance)(chip, n);
+        }
+    }
+
+    if (chip->silence > 0.f) {
+        aymo_(gate_silence)(chip);
+    }
+}
+
+
+void aymo_(set_coeffs)(struct aymo_(chip)* chip, struct aymo_tda8425_coeffs* coeffs)
+{
+    assert(chip);
+    assert(!coeffs || (coeffs->sample_rate == chip->sample_rate));
+
+    // Cached and computed coefficients are the same, so there is nothing to reapply
+    chip->coeffs = coeffs;
+}
+
+
+void aymo_(set_smoothing)(struct aymo_(chip)* chip, uint32_t frames)
+{
+    assert(chip);
+
+    uint32_t steps = ((frames / AYMO_TDA8425_SMOOTH_STEP) + ((frames % AYMO_TDA8425_SMOOTH_STEP) != 0u));
+    if (steps > (UINT32_MAX / AYMO_TDA8425_SMOOTH_STEP)) {
+        steps = (UINT32_MAX / AYMO_TDA8425_SMOOTH_STEP);
+    }
+    chip->smooth_steps = steps;
+
+    if (!steps) {
+        aymo_(snap)(chip);
+    }
+}
+
+
+void aymo_(set_silence)(struct aymo_(chip)* chip, float threshold)
+{
+    assert(chip);
+    assert(threshold >= 0.f);
+
+    chip->silence = threshold;
+}
+
+
+const struct aymo_tda8425_bank_vt aymo_(bank_vt) =
+{
+    AYMO_STRINGIFY2(aymo_(bank_vt)),
+    (aymo_tda8425_bank_get_sizeof_f)&(aymo_(bank_get_sizeof)),
+    (aymo_tda8425_bank_ctor_f)&(aymo_(bank_ctor)),
+    (aymo_tda8425_bank_dtor_f)&(aymo_(bank_dtor)),
+    (aymo_tda8425_bank_read_f)&(aymo_(bank_read)),
+    (aymo_tda8425_bank_write_f)&(aymo_(bank_write)),
+    (aymo_tda8425_bank_process_f32_f)&(aymo_(bank_process_f32)),
+    (aymo_tda8425_bank_process_f32_interleaved_f)&(aymo_(bank_process_f32_interleaved)),
+    (aymo_tda8425_bank_set_coeffs_f)&(aymo_(bank_set_coeffs))
+};
+
+
+const struct aymo_tda8425_bank_vt* aymo_(get_bank_vt)(void)
+{
+    return &aymo_(bank_vt);
+}
+
+
+static inline struct aymo_(chip)* aymo_(bank_chips)(struct aymo_(bank)* bank)
+{
+    return (struct aymo_(chip)*)(void*)(bank + 1);
+}
+
+
+uint32_t aymo_(bank_get_sizeof)(uint32_t instances)
+{
+    return (uint32_t)(sizeof(struct aymo_(bank)) + (instances * sizeof(struct aymo_(chip))));
+}
+
+
+void aymo_(bank_ctor)(struct aymo_(bank)* bank, uint32_t instances, float sample_rate)
+{
+    assert(bank);
+    assert(sample_rate > 0.f);
+
+    bank->parent.instances = instances;
+
+    struct aymo_(chip)* chips = aymo_(bank_chips)(bank);
+    for (uint32_t i = 0u; i < instances; ++i) {
+        chips[i].parent.vt = &aymo_(vt);
+        aymo_(ctor)(&chips[i], sample_rate);
+    }
+}
+
+
+void aymo_(bank_dtor)(struct aymo_(bank)* bank)
+{
+    assert(bank);
+
+    struct aymo_(chip)* chips = aymo_(bank_chips)(bank);
+    for (uint32_t i = 0u; i < bank->parent.instances; ++i) {
+        aymo_(dtor)(&chips[i]);
+    }
+}
+
+
+uint8_t aymo_(bank_read)(struct aymo_(bank)* bank, uint32_t index, uint16_t address)
+{
+    assert(bank);
+    assert(index < bank->parent.instances);
+
+    return aymo_(read)(&aymo_(bank_chips)(bank)[index], address);
+}
+
+
+void aymo_(bank_write)(struct aymo_(bank)* bank, uint32_t index, uint16_t address, uint8_t value)
+{
+    assert(bank);
+    assert(index < bank->parent.instances);
+
+    aymo_(write)(&aymo_(bank_chips)(bank)[index], address, value);
+}
+
+
+void aymo_(bank_process_f32)(struct aymo_(bank)* bank, uint32_t count, const float* const x[], float* const y[])
+{
+    assert(bank);
+
+    aymo_tda8425_chips_process_f32(&aymo_(bank_chips)(bank)->parent, sizeof(struct aymo_(chip)),
+                                   bank->parent.instances, count, x, y);
+}
+
+
+void aymo_(bank_process_f32_interleaved)(struct aymo_(bank)* bank, uint32_t count, const float x[], float y[])
+{
+    assert(bank);
+
+    aymo_tda8425_chips_process_f32_interleaved(&aymo_(bank_chips)(bank)->parent, sizeof(struct aymo_(chip)),
+                                               bank->parent.instances, count, x, y);
+}
+
+
+void aymo_(bank_set_coeffs)(struct aymo_(bank)* bank, struct aymo_tda8425_coeffs* coeffs)
+{
+    assert(bank);
+
+    struct aymo_(chip)* chips = aymo_(bank_chips)(bank);
+    for (uint32_t i = 0u; i < bank->parent.instances; ++i) {
+        aymo_(set_coeffs)(&chips[i], coeffs);
+    }
+}
+
+
 AYMO_CXX_EXTERN_C_END
 
 #endif  // AYMO_CPU_SUPPORT_X86_SSE41
@@ -42,13 +42,13 @@ AYMO_PUBLIC void aymo_wave_heading_setup(
 
     uint16_t sample_byte_size = (sample_bits / 8u);
     uint32_t sample_data_size = (sample_count * channel_count * sample_byte_size);
-    assert(sample_data_size < (UINT32_MAX - 32u));
+    assert(sample_data_size < (UINT32_MAX - 36u));
 
     heading->riff_fourcc[0]         = 'R';
     heading->riff_fourcc[1]         = 'I';
     heading->riff_fourcc[2]         = 'F';
     heading->riff_fourcc[3]         = 'F';
-    heading->riff_size              = (32u + sample_data_size);
+    heading->riff_size              = (36u + sample_data_size);  // rest of the heading, plus samples
 
     heading->wave_fourcc[0]         = 'W';
     heading->wave_fourcc[1]         = 'A';
@@ -64,7 +64,7 @@ AYMO_PUBLIC void aymo_wave_heading_setup(
     heading->wave_fmt_type          = wave_fmt_type;
     heading->wave_fmt_channel_count = channel_count;
     heading->wave_fmt_sample_rate   = sample_rate;
-    heading->wave_fmt_byte_rate     = (sample_byte_size * sample_rate);
+    heading->wave_fmt_byte_rate     = (sample_byte_size * channel_count * sample_rate);
     heading->wave_fmt_block_align   = (sample_byte_size * channel_count);
     heading->wave_fmt_sample_bits   = sample_bits;
 
@@ -76,4 +76,112 @@ AYMO_PUBLIC void aymo_wave_heading_setup(
 }
 
 
+
+static inline uint16_t aymo_wave_read_u16le(const uint8_t* ptr)
+{
+    return (uint16_t)(ptr[0] | ((uint16_t)ptr[1] << 8u));
+}
+
+
+static inline uint32_t aymo_wave_read_u32le(const uint8_t* ptr)
+{
+    return (ptr[0] | ((uint32_t)ptr[1] << 8u) | ((uint32_t)ptr[2] << 16u) | ((uint32_t)ptr[3] << 24u));
+}
+
+
+static inline int aymo_wave_fourcc_equals(const uint8_t* ptr, const char* fourcc)
+{
+    return ((ptr[0] == (uint8_t)fourcc[0]) && (ptr[1] == (uint8_t)fourcc[1]) &&
+            (ptr[2] == (uint8_t)fourcc[2]) && (ptr[3] == (uint8_t)fourcc[3]));
+}
+
+
+AYMO_PUBLIC int aymo_wave_heading_parse(
+    struct aymo_wave_heading* heading,
+    const void* data,
+    uint32_t size,
+    uint32_t* data_offset
+)
+{
+    assert(heading);
+    assert(data || !size);
+    assert(data_offset);
+
+    const uint8_t* bytes = (const uint8_t*)data;
+    int fmt_found = 0;
+
+    *data_offset = 0u;
+    aymo_memset(heading, 0, sizeof(*heading));
+
+    if ((size < 12u) || !aymo_wave_fourcc_equals(&bytes[0], "RIFF") || !aymo_wave_fourcc_equals(&bytes[8], "WAVE")) {
+        return 1;  // not a WAVE file
+    }
+
+    uint32_t offset = 12u;
+    while ((size - offset) >= 8u) {
+        const uint8_t* chunk = &bytes[offset];
+        uint32_t chunk_size = aymo_wave_read_u32le(&chunk[4]);
+        uint32_t avail_size = (size - offset - 8u);
+
+        if (aymo_wave_fourcc_equals(chunk, "fmt ")) {
+            if ((chunk_size < 16u) || (avail_size < 16u)) {
+                return 1;
+            }
+            heading->wave_fmt_size          = chunk_size;
+            heading->wave_fmt_type          = aymo_wave_read_u16le(&chunk[8]);
+            heading->wave_fmt_channel_count = aymo_wave_read_u16le(&chunk[10]);
+            heading->wave_fmt_sample_rate   = aymo_wave_read_u32le(&chunk[12]);
+            heading->wave_fmt_byte_rate     = aymo_wave_read_u32le(&chunk[16]);
+            heading->wave_fmt_block_align   = aymo_wave_read_u16le(&chunk[20]);
+            heading->wave_fmt_sample_bits   = aymo_wave_read_u16le(&chunk[22]);
+
+            if ((heading->wave_fmt_type == 0xFFFEu) && (chunk_size >= 40u) && (avail_size >= 40u)) {
+                // WAVE_FORMAT_EXTENSIBLE: subformat GUID starts with the format type
+                heading->wave_fmt_type = aymo_wave_read_u16le(&chunk[32]);
+            }
+            fmt_found = 1;
+        }
+        else if (aymo_wave_fourcc_equals(chunk, "data")) {
+            if (!fmt_found) {
+                return 1;
+            }
+            if (chunk_size > avail_size) {
+                chunk_size = avail_size;  // truncated or streamed
+            }
+            if (heading->wave_fmt_block_align) {
+                chunk_size -= (chunk_size % heading->wave_fmt_block_align);
+            }
+            heading->riff_fourcc[0]      = 'R';
+            heading->riff_fourcc[1]      = 'I';
+            heading->riff_fourcc[2]      = 'F';
+            heading->riff_fourcc[3]      = 'F';
+            heading->riff_size           = aymo_wave_read_u32le(&bytes[4]);
+            heading->wave_fourcc[0]      = 'W';
+            heading->wave_fourcc[1]      = 'A';
+            heading->wave_fourcc[2]      = 'V';
+            heading->wave_fourcc[3]      = 'E';
+            heading->wave_fmt_fourcc[0]  = 'f';
+            heading->wave_fmt_fourcc[1]  = 'm';
+            heading->wave_fmt_fourcc[2]  = 't';
+            heading->wave_fmt_fourcc[3]  = ' ';
+            heading->wave_data_fourcc[0] = 'd';
+            heading->wave_data_fourcc[1] = 'a';
+            heading->wave_data_fourcc[2] = 't';
+            heading->wave_data_fourcc[3] = 'a';
+            heading->wave_data_size      = chunk_size;
+            *data_offset = (offset + 8u);
+            return 0;
+        }
+
+        if (chunk_size > avail_size) {
+            break;
+        }
+        offset += (8u + chunk_size + (chunk_size & 1u));  // chunks are word aligned
+        if (offset > size) {
+            break;
+        }
+    }
+    return 1;  // no samples
+}
+
 AYMO_CXX_EXTERN_C_END
@@ -24,8 +24,11 @@ along with AYMO. If not, see <https://www.gnu.org/licenses/>.
 #include "aymo_ym7128_dummy.h"
 #include "aymo_ym7128_none.h"
 #include "aymo_ym7128_x86_avx.h"
+#include "aymo_ym7128_x86_avx2.h"
 #include "aymo_ym7128_x86_sse41.h"
 
+#include <assert.h>
+
 AYMO_CXX_EXTERN_C_BEGIN
 
 
@@ -34,6 +37,13 @@ static const struct aymo_ym7128_vt* aymo_ym7128_best_vt;
 
 void aymo_ym7128_boot(void)
 {
+    #ifdef AYMO_CPU_SUPPORT_X86_AVX2
+        if (aymo_cpu_x86_get_extensions() & AYMO_CPU_X86_EXT_AVX2) {
+            aymo_ym7128_best_vt = aymo_ym7128_x86_avx2_get_vt();
+            return;
+        }
+    #endif
+
     #ifdef AYMO_CPU_SUPPORT_X86_AVX
         if (aymo_cpu_x86_get_extensions() & AYMO_CPU_X86_EXT_AVX) {
             aymo_ym7128_best_vt = aymo_ym7128_x86_avx_get_vt();
@@ -65,6 +75,14 @@ const struct aymo_ym7128_vt* aymo_ym7128_get_vt(const char* cpu_ext)
         return NULL;
     }
 
+    #ifdef AYMO_CPU_SUPPORT_X86_AVX2
+        if (!aymo_strcmp(cpu_ext, "x86_avx2")) {
+            if (aymo_cpu_x86_get_extensions() & AYMO_CPU_X86_EXT_AVX2) {
+                return aymo_ym7128_x86_avx2_get_vt();
+            }
+        }
+    #endif
+
     #ifdef AYMO_CPU_SUPPORT_X86_AVX
         if (!aymo_strcmp(cpu_ext, "x86_avx")) {
             if (aymo_cpu_x86_get_extensions() & AYMO_CPU_X86_EXT_AVX) {
@@ -165,4 +183,14 @@ void aymo_ym7128_process_i16(struct aymo_ym7128_chip* chip, uint32_t count, cons
 }
 
 
+void aymo_ym7128_process_f32(struct aymo_ym7128_chip* chip, uint32_t count, const float x[], float y[])
+{
+    assert(chip);
+    assert(chip->vt);
+    assert(chip->vt->process_f32);
+
+    chip->vt->process_f32(chip, count, x, y);
+}
+
+
 AYMO_CXX_EXTERN_C_END
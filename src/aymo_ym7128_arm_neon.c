@@ -39,7 +39,8 @@ const struct aymo_ym7128_vt aymo_(vt) =
     (aymo_ym7128_dtor_f)&(aymo_(dtor)),
     (aymo_ym7128_read_f)&(aymo_(read)),
     (aymo_ym7128_write_f)&(aymo_(write)),
-    (aymo_ym7128_process_i16_f)&(aymo_(process_i16))
+    (aymo_ym7128_process_i16_f)&(aymo_(process_i16)),
+    (aymo_ym7128_process_f32_f)&(aymo_(process_f32))
 };
 
 
@@ -70,12 +71,9 @@ void aymo_(ctor)(struct aymo_(chip)* chip)
 
     // Initialize oversampler coefficients
     const int16_t* k = aymo_ym7128_kernel_linear;
-    chip->ka = vseta(k[ 6], k[ 6], k[ 4], k[ 4], k[ 2], k[ 2], k[ 0], k[ 0]);
-    chip->kb = vseta(k[ 7], k[ 7], k[ 5], k[ 5], k[ 3], k[ 3], k[ 1], k[ 1]);
-    chip->kc = vseta(k[14], k[14], k[12], k[12], k[10], k[10], k[ 8], k[ 8]);
-    chip->kd = vseta(k[15], k[15], k[13], k[13], k[11], k[11], k[ 9], k[ 9]);
-    chip->ke = vseta(    0,     0,     0,     0, k[18], k[18], k[16], k[16]);
-    chip->kf = vseta(    0,     0,     0,     0,     0,     0, k[17], k[17]);
+    for (unsigned i = 0u; i < AYMO_YM7128_KERNEL_LENGTH; ++i) {
+        chip->kh[i] = vset1(k[i]);
+    }
 
     // Initialize as pass-through
     aymo_(write)(chip, (uint16_t)aymo_ym7128_reg_gl1, 0x3Fu);
@@ -165,10 +163,173 @@ void aymo_(write)(struct aymo_(chip)* chip, uint16_t address, uint8_t value)
 
     if (address < (uint16_t)AYMO_YM7128_REG_COUNT) {
         chip->regs[address] = value;
+        aymo_ym7128_calc_f32(&chip->f32_coeffs, chip->regs);
+    }
+}
+
+
+// Delay line taps mixed by the block kernel
+struct aymo_(taps) {
+    unsigned count;
+    uint8_t lane[8];
+    int16_t kl[8];
+    int16_t kr[8];
+    const int16_t* up[8];
+};
+
+
+// Collects the audible taps, split by delay: long taps (not shorter than the
+// block) can be read before the block is written into the delay line, while
+// short taps must be read after it; counts are padded to even with mute taps
+static
+void aymo_(taps_setup)(const struct aymo_(chip)* chip, struct aymo_(taps)* lt, struct aymo_(taps)* st)
+{
+    lt->count = 0u;
+    st->count = 0u;
+
+    for (unsigned i = 0u; i < 8u; ++i) {
+        int16_t kl = vextractv(chip->kgl, i);
+        int16_t kr = vextractv(chip->kgr, i);
+        if (kl || kr) {
+            int16_t t = aymo_ym7128_tap[chip->regs[(unsigned)aymo_ym7128_reg_t1 + i]];
+            struct aymo_(taps)* taps = ((t >= AYMO_YM7128_BLOCK_LENGTH) ? lt : st);
+            taps->lane[taps->count] = (uint8_t)i;
+            taps->kl[taps->count] = kl;
+            taps->kr[taps->count] = kr;
+            ++taps->count;
+        }
+    }
+
+    if (lt->count & 1u) {
+        lt->lane[lt->count] = lt->lane[0];
+        lt->kl[lt->count] = 0;
+        lt->kr[lt->count] = 0;
+        ++lt->count;
+    }
+    if (st->count & 1u) {
+        st->lane[st->count] = st->lane[0];
+        st->kl[st->count] = 0;
+        st->kr[st->count] = 0;
+        ++st->count;
     }
 }
 
 
+// Points each tap to the next n (padded to 8) samples of the delay line,
+// copying them into a scratch buffer if they wrap around its end
+static
+void aymo_(taps_locate)(
+    const struct aymo_(chip)* chip,
+    struct aymo_(taps)* taps,
+    const int16_t ti[8],
+    unsigned n,
+    int16_t scratch[][AYMO_YM7128_BLOCK_LENGTH]
+)
+{
+    n = ((n + 7u) & ~7u);
+
+    for (unsigned j = 0u; j < taps->count; ++j) {
+        unsigned i = (unsigned)ti[taps->lane[j]] + 1u;
+        if (i >= AYMO_YM7128_DELAY_LENGTH) {
+            i -= AYMO_YM7128_DELAY_LENGTH;
+        }
+        if ((i + n) <= AYMO_YM7128_DELAY_LENGTH) {
+            taps->up[j] = &chip->uh[i];
+        }
+        else {
+            unsigned m = (AYMO_YM7128_DELAY_LENGTH - i);
+            aymo_memcpy(&scratch[j][0], (void*)&chip->uh[i], (m * sizeof(int16_t)));
+            aymo_memcpy(&scratch[j][m], (void*)&chip->uh[0], ((n - m) * sizeof(int16_t)));
+            taps->up[j] = &scratch[j][0];
+        }
+    }
+}
+
+
+// Accumulates tap pairs into 32-bit sums, 8 samples at a time
+static
+void aymo_(taps_mix)(const struct aymo_(taps)* taps, unsigned n, vi32x4_t accl[], vi32x4_t accr[])
+{
+    for (unsigned j = 0u; j < taps->count; j += 2u) {
+        const int16_t* ua = taps->up[j];
+        const int16_t* ub = taps->up[j + 1u];
+        vi16x8_t kla = vset1(taps->kl[j]);
+        vi16x8_t klb = vset1(taps->kl[j + 1u]);
+        vi16x8_t kra = vset1(taps->kr[j]);
+        vi16x8_t krb = vset1(taps->kr[j + 1u]);
+
+        for (unsigned k = 0u; k < n; k += 8u) {
+            vi16x8_t ta = vload(&ua[k]);
+            vi16x8_t tb = vload(&ub[k]);
+            vi16x8_t gla = vmulhrs(ta, kla);
+            vi16x8_t glb = vmulhrs(tb, klb);
+            vi16x8_t gra = vmulhrs(ta, kra);
+            vi16x8_t grb = vmulhrs(tb, krb);
+            unsigned g = (k >> 2);
+            accl[g     ] = vvadd(accl[g     ], vaddl_s16(vgetlo(gla), vgetlo(glb)));
+            accl[g + 1u] = vvadd(accl[g + 1u], vaddl_s16(vgethi(gla), vgethi(glb)));
+            accr[g     ] = vvadd(accr[g     ], vaddl_s16(vgetlo(gra), vgetlo(grb)));
+            accr[g + 1u] = vvadd(accr[g + 1u], vaddl_s16(vgethi(gra), vgethi(grb)));
+        }
+    }
+}
+
+
+// Polyphase oversampler, vectorized over time: each vector holds the L,R pairs
+// of four consecutive input samples, with the 9 previous pairs before z[0].
+// Partial sums follow the same order as the per-sample kernel it replaced.
+static
+void aymo_(oversample)(const vi16x8_t kh[], const int32_t z[], unsigned n, int16_t y[])
+{
+    for (unsigned k = 0u; k < n; k += 4u) {
+        const int32_t* p = &z[k];
+        vi16x8_t z0 = vload((const int16_t*)(const void*)&p[ 0]);
+        vi16x8_t z1 = vload((const int16_t*)(const void*)&p[-1]);
+        vi16x8_t z2 = vload((const int16_t*)(const void*)&p[-2]);
+        vi16x8_t z3 = vload((const int16_t*)(const void*)&p[-3]);
+        vi16x8_t z4 = vload((const int16_t*)(const void*)&p[-4]);
+        vi16x8_t z5 = vload((const int16_t*)(const void*)&p[-5]);
+        vi16x8_t z6 = vload((const int16_t*)(const void*)&p[-6]);
+        vi16x8_t z7 = vload((const int16_t*)(const void*)&p[-7]);
+        vi16x8_t z8 = vload((const int16_t*)(const void*)&p[-8]);
+        vi16x8_t z9 = vload((const int16_t*)(const void*)&p[-9]);
+
+        // Even phase
+        vi16x8_t a0 = vaddsi(vaddsi(vmulhrs(z8, kh[16]), vmulhrs(z4, kh[ 8])), vmulhrs(z0, kh[ 0]));
+        vi16x8_t a1 = vaddsi(vaddsi(vmulhrs(z9, kh[18]), vmulhrs(z5, kh[10])), vmulhrs(z1, kh[ 2]));
+        vi16x8_t a2 = vaddsi(vmulhrs(z6, kh[12]), vmulhrs(z2, kh[ 4]));
+        vi16x8_t a3 = vaddsi(vmulhrs(z7, kh[14]), vmulhrs(z3, kh[ 6]));
+        vi16x8_t y0 = vaddsi(vaddsi(a0, a2), vaddsi(a1, a3));
+
+        // Odd phase
+        vi16x8_t b0 = vaddsi(vaddsi(vmulhrs(z8, kh[17]), vmulhrs(z4, kh[ 9])), vmulhrs(z0, kh[ 1]));
+        vi16x8_t b1 = vaddsi(vmulhrs(z5, kh[11]), vmulhrs(z1, kh[ 3]));
+        vi16x8_t b2 = vaddsi(vmulhrs(z6, kh[13]), vmulhrs(z2, kh[ 5]));
+        vi16x8_t b3 = vaddsi(vmulhrs(z7, kh[15]), vmulhrs(z3, kh[ 7]));
+        vi16x8_t y1 = vaddsi(vaddsi(b0, b2), vaddsi(b1, b3));
+
+        y0 = vand(y0, vset1((int16_t)AYMO_YM7128_SIGNAL_MASK));
+        y1 = vand(y1, vset1((int16_t)AYMO_YM7128_SIGNAL_MASK));
+        int32x4x2_t yy = vzipq_s32(vreinterpretq_s32_s16(y0), vreinterpretq_s32_s16(y1));
+
+        if AYMO_LIKELY((k + 4u) <= n) {
+            vstore(&y[0], vreinterpretq_s16_s32(yy.val[0]));
+            vstore(&y[8], vreinterpretq_s16_s32(yy.val[1]));
+        }
+        else {
+            AYMO_ALIGN_V128 int16_t yt[16];
+            vstore(&yt[0], vreinterpretq_s16_s32(yy.val[0]));
+            vstore(&yt[8], vreinterpretq_s16_s32(yy.val[1]));
+            aymo_memcpy(y, yt, ((n - k) * 4u * sizeof(int16_t)));
+        }
+        y += 16u;
+    }
+}
+
+
+// Processes blocks of samples: the input stage runs per sample, as it feeds
+// back from T0, while taps are mixed with contiguous loads from the delay line.
+// The oversampler then runs on the whole block.
 void aymo_(process_i16)(struct aymo_(chip)* chip, uint32_t count, const int16_t x[], int16_t y[])
 {
     assert(chip);
@@ -181,97 +342,305 @@ void aymo_(process_i16)(struct aymo_(chip)* chip, uint32_t count, const int16_t
     vi16x8_t kk2 = chip->kk2;
     vi16x8_t kkm = chip->kkm;
     vi16x8_t ti = chip->ti;
-    vi16x8_t kgl = chip->kgl;
-    vi16x8_t kgr = chip->kgr;
-    vi16x8_t kv = chip->kv;
-
-    vi16x8_t zc = chip->zc;
-    vi16x8_t zb = chip->zb;
-    vi16x8_t kf = chip->kf;
-    vi16x8_t ke = chip->ke;
-    vi16x8_t za = chip->za;
-    vi16x8_t kd = chip->kd;
-    vi16x8_t kc = chip->kc;
-    vi16x8_t kb = chip->kb;
-    vi16x8_t ka = chip->ka;
+    int16_t ti0 = vextract(xxv, 0);
+    int16_t hi = vextract(xxv, 1);
+    int16_t t0 = vextract(xxv, 4);
+    int16_t xk = vextract(xxv, 5);
+    int16_t t0d = vextract(xxv, 6);
+    vi16x8_t kvl = vset1(vextract(chip->kv, 6));
+    vi16x8_t kvr = vset1(vextract(chip->kv, 7));
+
+    struct aymo_(taps) lt, st;
+    aymo_(taps_setup)(chip, &lt, &st);
+
+    AYMO_ALIGN_V128 int16_t tiv[8];
+    AYMO_ALIGN_V128 int16_t scratch[8 + 2][AYMO_YM7128_BLOCK_LENGTH];  // with padding
+    vi32x4_t accl[AYMO_YM7128_BLOCK_LENGTH / 4];
+    vi32x4_t accr[AYMO_YM7128_BLOCK_LENGTH / 4];
+    AYMO_ALIGN_V128 int32_t zv[12 + AYMO_YM7128_BLOCK_LENGTH];  // oversampler history, then block
+    int32_t* vlrn = &zv[12];
+    aymo_memcpy(&zv[12 - 9], chip->zh, sizeof(chip->zh));
 
     do {
-        int16_t ti0 = vextract(xxv, 0);
-        int16_t t0 = chip->uh[ti0];
-        xxv = vinsert(xxv, t0, 4);
-
-        xxv = vinsert(xxv, (*x++ & AYMO_YM7128_SIGNAL_MASK), 5);
-
-        vi16x8_t xx = xxv;
-        xxv = vinsert(xxv, t0, 6);  // t0d = t0
-        xx = vmulhrs(xx, kk1);
-        xx = vaddsi(xx, vrevv(xx));
-        xx = vmulhrs(xx, kk2);
-        xx = vand(xx, vcmpgt(kkm, xx));
-        xx = vaddsi(xx, vrev64q_s16(xx));
-        vi16x8_t vv = xx;
-        vi16x8_t tj = vsub(ti, vset1(-1));
-        vi16x8_t tm = vcmpgt(vset1(AYMO_YM7128_DELAY_LENGTH - 1), ti);  // tj < DL
-        ti = vand(tj, tm);
-
-        xxv = vinsert(xxv, vextract(vv, 0), 0);  // ti0'
-        int16_t hj = vextract(vv, 1);
-        xxv = vinsert(xxv, hj, 1);  // hi'
-        int16_t u = vextract(vv, 5);
-        chip->uh[hj] = u;
-        vi16x8_t tu = vsetx();
-        tu = vinsert(tu, chip->uh[vextract(ti, 0)], 0);
-        tu = vinsert(tu, chip->uh[vextract(ti, 1)], 1);
-        tu = vinsert(tu, chip->uh[vextract(ti, 2)], 2);
-        tu = vinsert(tu, chip->uh[vextract(ti, 3)], 3);
-        tu = vinsert(tu, chip->uh[vextract(ti, 4)], 4);
-        tu = vinsert(tu, chip->uh[vextract(ti, 5)], 5);
-        tu = vinsert(tu, chip->uh[vextract(ti, 6)], 6);
-        tu = vinsert(tu, chip->uh[vextract(ti, 7)], 7);
-
-        vi16x8_t gl = vmulhrs(tu, kgl);
-        vi16x8_t gr = vmulhrs(tu, kgr);
-        vi32x4_t ggl = vpaddlq_s16(gl);
-        vi32x4_t ggr = vpaddlq_s16(gr);
-        ggl = vvadd(ggl, vvext(ggl, ggl, 2));
-        ggr = vvadd(ggr, vvext(ggr, ggr, 2));
-        ggl = vvadd(ggl, vvrev(ggl));
-        ggr = vvadd(ggr, vvrev(ggr));
-        vi16x8_t ggrl = vvpacks(ggr, ggl);
-        vi16x8_t gglr = vext(ggrl, ggrl, 1);
-        vi16x8_t vlr = vmulhrs(gglr, kv);
-
-        zc = vext(zb, zc, 6);  // '543210..'
-
-        vi16x8_t y1 = vmulhrs(zc, kf);
-        vi16x8_t y0 = vmulhrs(zc, ke);
-
-        zb = vext(za, zb, 6);  // '543210..'
-
-        y1 = vaddsi(y1, vmulhrs(zb, kd));
-        y0 = vaddsi(y0, vmulhrs(zb, kc));
-
-        za = vext(vlr, za, 6);  // '543210..'
-
-        y1 = vaddsi(y1, vmulhrs(za, kb));
-        y0 = vaddsi(y0, vmulhrs(za, ka));
-
-        vi16x4_t yy0 = vqadd_s16(vgetlo(y0), vgethi(y0));
-        vi16x4_t yy1 = vqadd_s16(vgetlo(y1), vgethi(y1));
-        yy0 = vqadd_s16(yy0, vext_s16(yy0, yy0, 2));
-        yy1 = vqadd_s16(yy1, vext_s16(yy1, yy1, 2));
-
-        vi16x4_t yy = vext_s16(yy0, yy1, 2);
-        yy = vand_s16(yy, vdup_n_s16((int16_t)AYMO_YM7128_SIGNAL_MASK));
-        vst1_s16(y, yy); y += 4u;
-    } while (--count);
+        unsigned n = ((count < AYMO_YM7128_BLOCK_LENGTH) ? (unsigned)count : AYMO_YM7128_BLOCK_LENGTH);
+        count -= n;
 
+        for (unsigned g = 0u; g < (((n + 7u) & ~7u) >> 2); ++g) {
+            accl[g] = vvsetz();
+            accr[g] = vvsetz();
+        }
+
+        // Long taps read what was written before this block
+        vstore(tiv, ti);
+        aymo_(taps_locate)(chip, &lt, tiv, n, scratch);
+        aymo_(taps_mix)(&lt, n, accl, accr);
+
+        for (unsigned k = 0u; k < n; ++k) {
+            t0 = chip->uh[ti0];
+            xk = (int16_t)(*x++ & AYMO_YM7128_SIGNAL_MASK);
+
+            vi16x8_t xx = vinsert(xxv, ti0, 0);
+            xx = vinsert(xx, hi, 1);
+            xx = vinsert(xx, t0, 4);
+            xx = vinsert(xx, xk, 5);
+            xx = vinsert(xx, t0d, 6);
+            t0d = t0;
+            xx = vmulhrs(xx, kk1);
+            xx = vaddsi(xx, vrevv(xx));
+            xx = vmulhrs(xx, kk2);
+            xx = vand(xx, vcmpgt(kkm, xx));
+            xx = vaddsi(xx, vrev64q_s16(xx));
+
+            // Delay line pointers just wrap around
+            if AYMO_UNLIKELY(++ti0 >= AYMO_YM7128_DELAY_LENGTH) ti0 = 0;
+            if AYMO_UNLIKELY(++hi >= AYMO_YM7128_DELAY_LENGTH) hi = 0;
+            chip->uh[hi] = vextract(xx, 5);
+        }
+
+        // Short taps read what was written within this block
+        aymo_(taps_locate)(chip, &st, tiv, n, scratch + lt.count);
+        aymo_(taps_mix)(&st, n, accl, accr);
+
+        vi16x8_t tj = vadd(ti, vset1((int16_t)n));
+        vi16x8_t tm = vcmpgt(tj, vset1(AYMO_YM7128_DELAY_LENGTH - 1));  // tj >= DL
+        ti = vsub(tj, vand(tm, vset1(AYMO_YM7128_DELAY_LENGTH)));
+
+        for (unsigned k = 0u; k < n; k += 8u) {
+            unsigned g = (k >> 2);
+            vi16x8_t vl = vmulhrs(vvpacks(accl[g], accl[g + 1u]), kvl);
+            vi16x8_t vr = vmulhrs(vvpacks(accr[g], accr[g + 1u]), kvr);
+            int16x8x2_t vlr = vzipq_s16(vl, vr);
+            vstore((int16_t*)(void*)&vlrn[k     ], vlr.val[0]);
+            vstore((int16_t*)(void*)&vlrn[k + 4u], vlr.val[1]);
+        }
+
+        aymo_(oversample)(chip->kh, vlrn, n, y);
+        y += (n * 4u);
+
+        for (unsigned k = 0u; k < 9u; ++k) {
+            zv[(12 - 9) + k] = vlrn[(int)(n + k) - 9];
+        }
+    } while (count);
+
+    xxv = vinsert(xxv, ti0, 0);
+    xxv = vinsert(xxv, hi, 1);
+    xxv = vinsert(xxv, t0, 4);
+    xxv = vinsert(xxv, xk, 5);
+    xxv = vinsert(xxv, t0d, 6);
     chip->xxv = xxv;
     chip->ti = ti;
 
-    chip->zc = zc;
-    chip->zb = zb;
-    chip->za = za;
+    aymo_memcpy(chip->zh, &zv[12 - 9], sizeof(chip->zh));
+}
+
+
+// Copies n samples of the float delay line from index i, wrapping around its end
+static
+void aymo_(f32_gather)(const float uh[], unsigned i, unsigned n, float dst[])
+{
+    unsigned m = (AYMO_YM7128_DELAY_LENGTH - i);
+    if (m > n) {
+        m = n;
+    }
+    aymo_memcpy(&dst[0], (void*)&uh[i], (m * sizeof(float)));
+    aymo_memcpy(&dst[m], (void*)&uh[0], ((n - m) * sizeof(float)));
+}
+
+
+// Copies n samples into the float delay line from index i, wrapping around its end
+static
+void aymo_(f32_scatter)(float uh[], unsigned i, unsigned n, const float src[])
+{
+    unsigned m = (AYMO_YM7128_DELAY_LENGTH - i);
+    if (m > n) {
+        m = n;
+    }
+    aymo_memcpy(&uh[i], (void*)&src[0], (m * sizeof(float)));
+    aymo_memcpy(&uh[0], (void*)&src[m], ((n - m) * sizeof(float)));
+}
+
+
+// Float model block kernel.
+// Taps are read after the block is written into the delay line, except those
+// reaching back into samples the block overwrites; T0 is vectorized unless it
+// is shorter than the block.
+static
+void aymo_(run_f32)(struct aymo_(chip)* chip, unsigned n, const float x[], float y[])
+{
+    const struct aymo_ym7128_f32_coeffs* k = &chip->f32_coeffs;
+    struct aymo_ym7128_f32_state* s = &chip->f32;
+    const float* kk = aymo_ym7128_kernel_linear_f32;
+    unsigned nv = ((n + 3u) & ~3u);
+    unsigned hi = s->hi;
+    unsigned i;
+
+    unsigned hw = (hi + 1u);
+    if (hw >= AYMO_YM7128_DELAY_LENGTH) {
+        hw -= AYMO_YM7128_DELAY_LENGTH;
+    }
+    unsigned t0 = (unsigned)k->tap[0];
+    unsigned ti = (hw + AYMO_YM7128_DELAY_LENGTH - 1u - t0);
+    if (ti >= AYMO_YM7128_DELAY_LENGTH) {
+        ti -= AYMO_YM7128_DELAY_LENGTH;
+    }
+
+    // Locate the audible taps, from the first sample written by the block;
+    // the longest ones are copied before the block overwrites their samples
+    float wv[8][AYMO_YM7128_BLOCK_LENGTH];
+    const float* wp[8];
+    unsigned wi[8];
+    float gl[8];
+    float gr[8];
+    unsigned taps = 0u;
+
+    for (unsigned j = 0u; j < 8u; ++j) {
+        if ((k->kgl[j] != 0.f) || (k->kgr[j] != 0.f)) {
+            unsigned t = (unsigned)k->tap[1u + j];
+            unsigned tj = (hw + AYMO_YM7128_DELAY_LENGTH - t);
+            if (tj >= AYMO_YM7128_DELAY_LENGTH) {
+                tj -= AYMO_YM7128_DELAY_LENGTH;
+            }
+            if ((t + nv) > AYMO_YM7128_DELAY_LENGTH) {
+                aymo_(f32_gather)(s->uh, tj, nv, wv[taps]);
+                wp[taps] = wv[taps];
+            }
+            else {
+                wp[taps] = NULL;
+                wi[taps] = tj;
+            }
+            gl[taps] = k->kgl[j];
+            gr[taps] = k->kgr[j];
+            ++taps;
+        }
+    }
+
+    // Input stage
+    if ((t0 + 1u) >= n) {
+        float tv[AYMO_YM7128_BLOCK_LENGTH + 1];  // T0 delayed, then T0
+        float uv[AYMO_YM7128_BLOCK_LENGTH];
+        tv[0] = s->t0d;
+        aymo_(f32_gather)(s->uh, ti, n, &tv[1]);
+        s->t0d = tv[n];
+
+        float32x4_t kvm = vdupq_n_f32(k->kvm);
+        float32x4_t kvc = vdupq_n_f32(k->kvc);
+        float32x4_t kc0 = vdupq_n_f32(k->kc0);
+        float32x4_t kc1 = vdupq_n_f32(k->kc1);
+
+        for (i = 0u; (i + 4u) <= n; i += 4u) {
+            float32x4_t vt0 = vld1q_f32(&tv[i + 1u]);
+            float32x4_t vt0d = vld1q_f32(&tv[i]);
+            float32x4_t vf = vaddq_f32(vmulq_f32(vt0, kc0), vmulq_f32(vt0d, kc1));
+            float32x4_t vu = vaddq_f32(vmulq_f32(vld1q_f32(&x[i]), kvm), vmulq_f32(vf, kvc));
+            vst1q_f32(&uv[i], vu);
+        }
+        for (; i < n; ++i) {
+            uv[i] = ((x[i] * k->kvm) + (((tv[i + 1u] * k->kc0) + (tv[i] * k->kc1)) * k->kvc));
+        }
+        aymo_(f32_scatter)(s->uh, hw, n, uv);
+    }
+    else {
+        float t0d = s->t0d;
+        unsigned hj = hw;
+        for (i = 0u; i < n; ++i) {
+            float t = s->uh[ti];
+            s->uh[hj] = ((x[i] * k->kvm) + (((t * k->kc0) + (t0d * k->kc1)) * k->kvc));
+            t0d = t;
+            if (++ti >= AYMO_YM7128_DELAY_LENGTH) {
+                ti = 0u;
+            }
+            if (++hj >= AYMO_YM7128_DELAY_LENGTH) {
+                hj = 0u;
+            }
+        }
+        s->t0d = t0d;
+    }
+
+    for (unsigned j = 0u; j < taps; ++j) {
+        if (!wp[j]) {
+            unsigned tj = wi[j];
+            if ((tj + nv) <= AYMO_YM7128_DELAY_LENGTH) {
+                wp[j] = &s->uh[tj];
+            }
+            else {
+                aymo_(f32_gather)(s->uh, tj, nv, wv[j]);
+                wp[j] = wv[j];
+            }
+        }
+    }
+
+    // Mix the taps and interleave them after the oversampler history
+    float lr[(AYMO_YM7128_KERNEL_LENGTH - 1) + (AYMO_YM7128_BLOCK_LENGTH * 2)];
+    float* zv = &lr[AYMO_YM7128_KERNEL_LENGTH - 1];
+    aymo_memcpy(lr, s->zh, sizeof(s->zh));
+
+    float32x4_t kvl = vdupq_n_f32(k->kvl);
+    float32x4_t kvr = vdupq_n_f32(k->kvr);
+
+    for (i = 0u; i < nv; i += 4u) {
+        float32x4_t vl = vdupq_n_f32(0.f);
+        float32x4_t vr = vdupq_n_f32(0.f);
+        for (unsigned j = 0u; j < taps; ++j) {
+            float32x4_t vw = vld1q_f32(&wp[j][i]);
+            vl = vaddq_f32(vl, vmulq_f32(vw, vdupq_n_f32(gl[j])));
+            vr = vaddq_f32(vr, vmulq_f32(vw, vdupq_n_f32(gr[j])));
+        }
+        vl = vmulq_f32(vl, kvl);
+        vr = vmulq_f32(vr, kvr);
+        float32x4x2_t vlr = vzipq_f32(vl, vr);
+        vst1q_f32(&zv[(i * 2u) + 0u], vlr.val[0]);
+        vst1q_f32(&zv[(i * 2u) + 4u], vlr.val[1]);
+    }
+
+    // Oversampler, two frames at a time
+    for (i = 0u; i < n; i += 2u) {
+        const float* p = &zv[i * 2u];
+        float32x4_t vz = vld1q_f32(p);
+        float32x4_t y0 = vmulq_f32(vz, vdupq_n_f32(kk[0]));
+        float32x4_t y1 = vmulq_f32(vz, vdupq_n_f32(kk[1]));
+        for (unsigned j = 1u; j < 9u; ++j) {
+            vz = vld1q_f32(p - (j * 2u));
+            y0 = vaddq_f32(y0, vmulq_f32(vz, vdupq_n_f32(kk[j * 2u])));
+            y1 = vaddq_f32(y1, vmulq_f32(vz, vdupq_n_f32(kk[(j * 2u) + 1u])));
+        }
+        vz = vld1q_f32(p - 18u);
+        y0 = vaddq_f32(y0, vmulq_f32(vz, vdupq_n_f32(kk[18])));
+
+        vst1q_f32(&y[0], vcombine_f32(vget_low_f32(y0), vget_low_f32(y1)));
+        if AYMO_LIKELY((i + 1u) < n) {
+            vst1q_f32(&y[4], vcombine_f32(vget_high_f32(y0), vget_high_f32(y1)));
+        }
+        y += 8u;
+    }
+
+    aymo_memcpy(s->zh, &lr[n * 2u], sizeof(s->zh));
+
+    hi += n;
+    if (hi >= AYMO_YM7128_DELAY_LENGTH) {
+        hi -= AYMO_YM7128_DELAY_LENGTH;
+    }
+    s->hi = (uint16_t)hi;
+}
+
+
+void aymo_(process_f32)(struct aymo_(chip)* chip, uint32_t count, const float x[], float y[])
+{
+    assert(chip);
+    assert(x);
+    assert(y);
+    if AYMO_UNLIKELY(!count) return;
+
+    aymo_cpu_fpstate_t fpstate = aymo_cpu_enter_ftz();
+
+    while (count) {
+        unsigned n = ((count < AYMO_YM7128_BLOCK_LENGTH) ? (unsigned)count : AYMO_YM7128_BLOCK_LENGTH);
+        aymo_(run_f32)(chip, n, x, y);
+        x += n;
+        y += (n * 4u);
+        count -= n;
+    }
+
+    aymo_cpu_leave_ftz(fpstate);
 }
 
 
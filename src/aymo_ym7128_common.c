@@ -98,6 +98,79 @@ const int16_t aymo_ym7128_gain[64u] =
 };
 
 
+#define PGAINF(x)   ((float)(x))
+#define NGAINF(x)   (-(float)(x))
+
+const float aymo_ym7128_gain_f32[64u] =
+{
+    NGAINF(0.000000000000000000),  // -oo dB-
+    NGAINF(0.001000000000000000),  // -60 dB-
+    NGAINF(0.001258925411794167),  // -58 dB-
+    NGAINF(0.001584893192461114),  // -56 dB-
+    NGAINF(0.001995262314968879),  // -54 dB-
+    NGAINF(0.002511886431509579),  // -52 dB-
+    NGAINF(0.003162277660168379),  // -50 dB-
+    NGAINF(0.003981071705534973),  // -48 dB-
+    NGAINF(0.005011872336272725),  // -46 dB-
+    NGAINF(0.006309573444801930),  // -44 dB-
+    NGAINF(0.007943282347242814),  // -42 dB-
+    NGAINF(0.010000000000000000),  // -40 dB-
+    NGAINF(0.012589254117941675),  // -38 dB-
+    NGAINF(0.015848931924611134),  // -36 dB-
+    NGAINF(0.019952623149688799),  // -34 dB-
+    NGAINF(0.025118864315095794),  // -32 dB-
+    NGAINF(0.031622776601683791),  // -30 dB-
+    NGAINF(0.039810717055349734),  // -28 dB-
+    NGAINF(0.050118723362727220),  // -26 dB-
+    NGAINF(0.063095734448019331),  // -24 dB-
+    NGAINF(0.079432823472428138),  // -22 dB-
+    NGAINF(0.100000000000000006),  // -20 dB-
+    NGAINF(0.125892541179416728),  // -18 dB-
+    NGAINF(0.158489319246111343),  // -16 dB-
+    NGAINF(0.199526231496887974),  // -14 dB-
+    NGAINF(0.251188643150958013),  // -12 dB-
+    NGAINF(0.316227766016837941),  // -10 dB-
+    NGAINF(0.398107170553497203),  // - 8 dB-
+    NGAINF(0.501187233627272244),  // - 6 dB-
+    NGAINF(0.630957344480193250),  // - 4 dB-
+    NGAINF(0.794328234724281490),  // - 2 dB-
+    NGAINF(1.000000000000000000),  // - 0 dB-
+
+    PGAINF(0.000000000000000000),  // -oo dB+
+    PGAINF(0.001000000000000000),  // -60 dB+
+    PGAINF(0.001258925411794167),  // -58 dB+
+    PGAINF(0.001584893192461114),  // -56 dB+
+    PGAINF(0.001995262314968879),  // -54 dB+
+    PGAINF(0.002511886431509579),  // -52 dB+
+    PGAINF(0.003162277660168379),  // -50 dB+
+    PGAINF(0.003981071705534973),  // -48 dB+
+    PGAINF(0.005011872336272725),  // -46 dB+
+    PGAINF(0.006309573444801930),  // -44 dB+
+    PGAINF(0.007943282347242814),  // -42 dB+
+    PGAINF(0.010000000000000000),  // -40 dB+
+    PGAINF(0.012589254117941675),  // -38 dB+
+    PGAINF(0.015848931924611134),  // -36 dB+
+    PGAINF(0.019952623149688799),  // -34 dB+
+    PGAINF(0.025118864315095794),  // -32 dB+
+    PGAINF(0.031622776601683791),  // -30 dB+
+    PGAINF(0.039810717055349734),  // -28 dB+
+    PGAINF(0.050118723362727220),  // -26 dB+
+    PGAINF(0.063095734448019331),  // -24 dB+
+    PGAINF(0.079432823472428138),  // -22 dB+
+    PGAINF(0.100000000000000006),  // -20 dB+
+    PGAINF(0.125892541179416728),  // -18 dB+
+    PGAINF(0.158489319246111343),  // -16 dB+
+    PGAINF(0.199526231496887974),  // -14 dB+
+    PGAINF(0.251188643150958013),  // -12 dB+
+    PGAINF(0.316227766016837941),  // -10 dB+
+    PGAINF(0.398107170553497203),  // - 8 dB+
+    PGAINF(0.501187233627272244),  // - 6 dB+
+    PGAINF(0.630957344480193250),  // - 4 dB+
+    PGAINF(0.794328234724281490),  // - 2 dB+
+    PGAINF(1.000000000000000000)   // - 0 dB+
+};
+
+
 #define TAP(i)  ((int16_t)(((i) * (AYMO_YM7128_DELAY_LENGTH - 1)) / (AYMO_YM7128_TAP_COUNT - 1)))
 
 const int16_t aymo_ym7128_tap[32u] =
@@ -189,4 +262,53 @@ const int16_t aymo_ym7128_kernel_minphase[19u] =
 };
 
 
+
+#define KERNELF(x)  ((float)(x))
+
+const float aymo_ym7128_kernel_linear_f32[19u] =
+{
+    KERNELF(+0.005969087803865891),
+    KERNELF(-0.003826518613910499),
+    KERNELF(-0.016623943725986926),
+    KERNELF(+0.007053928712894589),
+    KERNELF(+0.038895802111020034),
+    KERNELF(-0.010501507751597486),
+    KERNELF(-0.089238395139830201),
+    KERNELF(+0.013171814880420758),
+    KERNELF(+0.312314472963171053),
+    KERNELF(+0.485820312497107776),
+    KERNELF(+0.312314472963171053),
+    KERNELF(+0.013171814880420758),
+    KERNELF(-0.089238395139830201),
+    KERNELF(-0.010501507751597486),
+    KERNELF(+0.038895802111020034),
+    KERNELF(+0.007053928712894589),
+    KERNELF(-0.016623943725986926),
+    KERNELF(-0.003826518613910499),
+    KERNELF(+0.005969087803865891)
+};
+
+
+void aymo_ym7128_calc_f32(struct aymo_ym7128_f32_coeffs* coeffs, const uint8_t regs[])
+{
+    for (unsigned i = 0u; i < 8u; ++i) {
+        coeffs->kgl[i] = aymo_ym7128_gain_f32[regs[aymo_ym7128_reg_gl1 + i] & 0x3Fu];
+        coeffs->kgr[i] = aymo_ym7128_gain_f32[regs[aymo_ym7128_reg_gr1 + i] & 0x3Fu];
+    }
+    coeffs->kvm = aymo_ym7128_gain_f32[regs[aymo_ym7128_reg_vm] & 0x3Fu];
+    coeffs->kvc = aymo_ym7128_gain_f32[regs[aymo_ym7128_reg_vc] & 0x3Fu];
+    coeffs->kvl = aymo_ym7128_gain_f32[regs[aymo_ym7128_reg_vl] & 0x3Fu];
+    coeffs->kvr = aymo_ym7128_gain_f32[regs[aymo_ym7128_reg_vr] & 0x3Fu];
+
+    // Signed coefficients, full scale as per the fixed-point model
+    int16_t c0 = (int16_t)((regs[aymo_ym7128_reg_c0] & 0x3Fu) << (16 - AYMO_YM7128_COEFF_BITS));
+    int16_t c1 = (int16_t)((regs[aymo_ym7128_reg_c1] & 0x3Fu) << (16 - AYMO_YM7128_COEFF_BITS));
+    coeffs->kc0 = ((float)c0 * (1.f / 32768.f));
+    coeffs->kc1 = ((float)c1 * (1.f / 32768.f));
+
+    for (unsigned i = 0u; i < 9u; ++i) {
+        coeffs->tap[i] = aymo_ym7128_tap[regs[aymo_ym7128_reg_t0 + i] & 0x1Fu];
+    }
+}
+
 AYMO_CXX_EXTERN_C_END
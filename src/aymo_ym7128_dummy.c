@@ -34,7 +34,8 @@ const struct aymo_ym7128_vt aymo_(vt) =
     (aymo_ym7128_dtor_f)&(aymo_(dtor)),
     (aymo_ym7128_read_f)&(aymo_(read)),
     (aymo_ym7128_write_f)&(aymo_(write)),
-    (aymo_ym7128_process_i16_f)&(aymo_(process_i16))
+    (aymo_ym7128_process_i16_f)&(aymo_(process_i16)),
+    (aymo_ym7128_process_f32_f)&(aymo_(process_f32))
 };
 
 
@@ -100,4 +101,18 @@ void aymo_(process_i16)(struct aymo_(chip)* chip, uint32_t count, const int16_t
 }
 
 
+void aymo_(process_f32)(struct aymo_(chip)* chip, uint32_t count, const float x[], float y[])
+{
+    AYMO_UNUSED_VAR(chip);
+    AYMO_UNUSED_VAR(count);
+    AYMO_UNUSED_VAR(x);
+    AYMO_UNUSED_VAR(y);
+    assert(chip);
+    assert(x);
+    assert(y);
+
+    // not supported
+}
+
+
 AYMO_CXX_EXTERN_C_END
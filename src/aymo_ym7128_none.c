@@ -34,7 +34,8 @@ const struct aymo_ym7128_vt aymo_(vt) =
     (aymo_ym7128_dtor_f)&(aymo_(dtor)),
     (aymo_ym7128_read_f)&(aymo_(read)),
     (aymo_ym7128_write_f)&(aymo_(write)),
-    (aymo_ym7128_process_i16_f)&(aymo_(process_i16))
+    (aymo_ym7128_process_i16_f)&(aymo_(process_i16)),
+    (aymo_ym7128_process_f32_f)&(aymo_(process_f32))
 };
 
 
@@ -70,6 +71,18 @@ void aymo_(ctor)(struct aymo_(chip)* chip)
     YM7128B_ChipFixed_Write(emu, (YM7128B_Address)YM7128B_Reg_VR, 0x3Fu);
 
     YM7128B_ChipFixed_Start(emu);
+
+    YM7128B_ChipFloat* emu_f32 = &chip->emu_f32;
+    YM7128B_ChipFloat_Ctor(emu_f32);
+    YM7128B_ChipFloat_Reset(emu_f32);
+
+    YM7128B_ChipFloat_Write(emu_f32, (YM7128B_Address)YM7128B_Reg_GL1, 0x3Fu);
+    YM7128B_ChipFloat_Write(emu_f32, (YM7128B_Address)YM7128B_Reg_GR1, 0x3Fu);
+    YM7128B_ChipFloat_Write(emu_f32, (YM7128B_Address)YM7128B_Reg_VM, 0x3Fu);
+    YM7128B_ChipFloat_Write(emu_f32, (YM7128B_Address)YM7128B_Reg_VL, 0x3Fu);
+    YM7128B_ChipFloat_Write(emu_f32, (YM7128B_Address)YM7128B_Reg_VR, 0x3Fu);
+
+    YM7128B_ChipFloat_Start(emu_f32);
 }
 
 
@@ -80,6 +93,10 @@ void aymo_(dtor)(struct aymo_(chip)* chip)
     YM7128B_ChipFixed* emu = &chip->emu;
     YM7128B_ChipFixed_Stop(emu);
     YM7128B_ChipFixed_Dtor(emu);
+
+    YM7128B_ChipFloat* emu_f32 = &chip->emu_f32;
+    YM7128B_ChipFloat_Stop(emu_f32);
+    YM7128B_ChipFloat_Dtor(emu_f32);
 }
 
 
@@ -100,6 +117,7 @@ void aymo_(write)(struct aymo_(chip)* chip, uint16_t address, uint8_t value)
 
     if (address <= (uint16_t)YM7128B_Address_Max) {
         YM7128B_ChipFixed_Write(&chip->emu, (YM7128B_Address)address, value);
+        YM7128B_ChipFloat_Write(&chip->emu_f32, (YM7128B_Address)address, value);
     }
 }
 
@@ -130,4 +148,30 @@ void aymo_(process_i16)(struct aymo_(chip)* chip, uint32_t count, const int16_t
 }
 
 
+void aymo_(process_f32)(struct aymo_(chip)* chip, uint32_t count, const float x[], float y[])
+{
+    assert(chip);
+    assert(x);
+    assert(y);
+    if AYMO_UNLIKELY(!count) return;
+
+    YM7128B_ChipFloat* emu = &chip->emu_f32;
+    YM7128B_ChipFloat_Process_Data data;
+
+    const float* xe = &x[count];
+
+    while AYMO_LIKELY(x != xe) {
+        data.inputs[YM7128B_InputChannel_Mono] = *x++;
+
+        YM7128B_ChipFloat_Process(emu, &data);
+
+        for (int k = 0; k < YM7128B_Oversampler_Factor; ++k) {
+            for (int c = 0; c < YM7128B_OutputChannel_Count; ++c) {
+                *y++ = data.outputs[c][k];
+            }
+        }
+    }
+}
+
+
 AYMO_CXX_EXTERN_C_END
@@ -0,0 +1,678 @@
+/*
+AYMO - Accelerated YaMaha Operator
+Copyright (c) 2023-2024 Andrea Zoppi.
+
+This file is part of AYMO.
+
+AYMO is free software: you can redistribute it and/or modify it under the
+terms of the GNU Lesser General Public License as published yb the Free
+Software Foundation, either version 2.1 of the License, or (at your option)
+any later version.
+
+AYMO is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with AYMO. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "aymo_cpu.h"
+#ifdef AYMO_CPU_SUPPORT_X86_AVX2
+
+#include "aymo_cpu_x86_sse41_inline.h"  // 128-bit shorthands, input stage
+#include "aymo_ym7128.h"
+#define AYMO_KEEP_SHORTHANDS
+#include "aymo_ym7128_x86_avx2.h"
+
+#include <assert.h>
+
+AYMO_CXX_EXTERN_C_BEGIN
+
+
+const struct aymo_ym7128_vt aymo_(vt) =
+{
+    AYMO_STRINGIFY2(aymo_(vt)),
+    (aymo_ym7128_get_sizeof_f)&(aymo_(get_sizeof)),
+    (aymo_ym7128_ctor_f)&(aymo_(ctor)),
+    (aymo_ym7128_dtor_f)&(aymo_(dtor)),
+    (aymo_ym7128_read_f)&(aymo_(read)),
+    (aymo_ym7128_write_f)&(aymo_(write)),
+    (aymo_ym7128_process_i16_f)&(aymo_(process_i16)),
+    (aymo_ym7128_process_f32_f)&(aymo_(process_f32))
+};
+
+
+const struct aymo_ym7128_vt* aymo_(get_vt)(void)
+{
+    return &aymo_(vt);
+}
+
+
+uint32_t aymo_(get_sizeof)(void)
+{
+    return sizeof(struct aymo_(chip));
+}
+
+
+void aymo_(ctor)(struct aymo_(chip)* chip)
+{
+    assert(chip);
+
+    // Wipe everything, except VT
+    aymo_memset((&chip->parent.vt + 1u), 0, (sizeof(*chip) - sizeof(chip->parent.vt)));
+
+    // Initialize input stage coefficients (-1 as a placeholder for computed values)
+    chip->xxv = vseta(0, 0, 0, 0, 1, 1, 0, 0);
+    chip->kk1 = vseta(0, -1, -1, -1, -0x8000, -0x8000, -0x8000, -0x8000);
+    chip->kk2 = vseta(0, -1, -0x8000, 0, 0, 0, 0x8000, -0x8000);
+    chip->kkm = vseta(0, 0x7FFF, 0x7FFF, 0, 0, 0, AYMO_YM7128_DELAY_LENGTH, AYMO_YM7128_DELAY_LENGTH);
+
+    // Initialize oversampler coefficients
+    const int16_t* k = aymo_ym7128_kernel_linear;
+    for (unsigned i = 0u; i < AYMO_YM7128_KERNEL_LENGTH; ++i) {
+        chip->kh[i] = _mm256_set1_epi16(k[i]);
+    }
+
+    // Initialize as pass-through
+    aymo_(write)(chip, (uint16_t)aymo_ym7128_reg_gl1, 0x3Fu);
+    aymo_(write)(chip, (uint16_t)aymo_ym7128_reg_gr1, 0x3Fu);
+    aymo_(write)(chip, (uint16_t)aymo_ym7128_reg_vm, 0x3Fu);
+    aymo_(write)(chip, (uint16_t)aymo_ym7128_reg_vl, 0x3Fu);
+    aymo_(write)(chip, (uint16_t)aymo_ym7128_reg_vr, 0x3Fu);
+}
+
+
+void aymo_(dtor)(struct aymo_(chip)* chip)
+{
+    AYMO_UNUSED_VAR(chip);
+    assert(chip);
+}
+
+
+uint8_t aymo_(read)(struct aymo_(chip)* chip, uint16_t address)
+{
+    assert(chip);
+
+    if (address < (uint16_t)AYMO_YM7128_REG_COUNT) {
+        return chip->regs[address];
+    }
+    return 0x00u;
+}
+
+
+void aymo_(write)(struct aymo_(chip)* chip, uint16_t address, uint8_t value)
+{
+    assert(chip);
+
+    if (address <= (uint16_t)aymo_ym7128_reg_gl8) {
+        value &= 0x3Fu;
+        int16_t gl = aymo_ym7128_gain[value];
+        int i = (int)(address - (uint16_t)aymo_ym7128_reg_gl1);
+        chip->kgl = vinsertn(chip->kgl, gl, i);
+    }
+    else if (address <= (uint16_t)aymo_ym7128_reg_gr8) {
+        value &= 0x3Fu;
+        int16_t gr = aymo_ym7128_gain[value];
+        int i = (int)(address - (uint16_t)aymo_ym7128_reg_gr1);
+        chip->kgr = vinsertn(chip->kgr, gr, i);
+    }
+    else if (address <= (uint16_t)aymo_ym7128_reg_vr) {
+        value &= 0x3Fu;
+        int16_t v = aymo_ym7128_gain[value];
+        if (address == (uint16_t)aymo_ym7128_reg_vm) {
+            chip->kk1 = vinsert(chip->kk1, -v, 5);
+        }
+        else if (address == (uint16_t)aymo_ym7128_reg_vc) {
+            chip->kk2 = vinsert(chip->kk2, v, 6);
+        }
+        else if (address == (uint16_t)aymo_ym7128_reg_vl) {
+            chip->kv = vinsert(chip->kv, v, 6);
+        }
+        else {
+            chip->kv = vinsert(chip->kv, v, 7);
+        }
+    }
+    else if (address <= (uint16_t)aymo_ym7128_reg_c1) {
+        value &= 0x3Fu;
+        int16_t v = ((int16_t)value << (16 - AYMO_YM7128_COEFF_BITS));
+        if (address == (uint16_t)aymo_ym7128_reg_c0) {
+            chip->kk1 = vinsert(chip->kk1, v, 4);
+        }
+        else {
+            chip->kk1 = vinsert(chip->kk1, v, 6);
+        }
+    }
+    else if (address <= (uint16_t)aymo_ym7128_reg_t8) {
+        value &= 0x1Fu;
+        int16_t t = aymo_ym7128_tap[value];
+        int16_t hi = vextract(chip->xxv, 1);  // hi
+        t = (hi - t);
+        if (t < 0) {
+            t += AYMO_YM7128_DELAY_LENGTH;
+        }
+        if (address == (uint16_t)aymo_ym7128_reg_t0) {
+            chip->xxv = vinsert(chip->xxv, t, 0);  // ti0
+        }
+        else {
+            uint16_t i = (address - (uint16_t)aymo_ym7128_reg_t1);
+            chip->ti = vinsertn(chip->ti, t, i);
+        }
+    }
+
+    if (address < (uint16_t)AYMO_YM7128_REG_COUNT) {
+        chip->regs[address] = value;
+        aymo_ym7128_calc_f32(&chip->f32_coeffs, chip->regs);
+    }
+}
+
+
+// Delay line taps mixed by the block kernel
+struct aymo_(taps) {
+    unsigned count;
+    uint8_t lane[8];
+    int16_t kl[8];
+    int16_t kr[8];
+    const int16_t* up[8];
+};
+
+
+// Collects the audible taps, split by delay: long taps (not shorter than the
+// block) can be read before the block is written into the delay line, while
+// short taps must be read after it; counts are padded to even with mute taps
+static
+void aymo_(taps_setup)(const struct aymo_(chip)* chip, struct aymo_(taps)* lt, struct aymo_(taps)* st)
+{
+    lt->count = 0u;
+    st->count = 0u;
+
+    for (unsigned i = 0u; i < 8u; ++i) {
+        int16_t kl = vextractv(chip->kgl, i);
+        int16_t kr = vextractv(chip->kgr, i);
+        if (kl || kr) {
+            int16_t t = aymo_ym7128_tap[chip->regs[(unsigned)aymo_ym7128_reg_t1 + i]];
+            struct aymo_(taps)* taps = ((t >= AYMO_YM7128_BLOCK_LENGTH) ? lt : st);
+            taps->lane[taps->count] = (uint8_t)i;
+            taps->kl[taps->count] = kl;
+            taps->kr[taps->count] = kr;
+            ++taps->count;
+        }
+    }
+
+    if (lt->count & 1u) {
+        lt->lane[lt->count] = lt->lane[0];
+        lt->kl[lt->count] = 0;
+        lt->kr[lt->count] = 0;
+        ++lt->count;
+    }
+    if (st->count & 1u) {
+        st->lane[st->count] = st->lane[0];
+        st->kl[st->count] = 0;
+        st->kr[st->count] = 0;
+        ++st->count;
+    }
+}
+
+
+// Points each tap to the next n (padded to 16) samples of the delay line,
+// copying them into a scratch buffer if they wrap around its end
+static
+void aymo_(taps_locate)(
+    const struct aymo_(chip)* chip,
+    struct aymo_(taps)* taps,
+    const int16_t ti[8],
+    unsigned n,
+    int16_t scratch[][AYMO_YM7128_BLOCK_LENGTH]
+)
+{
+    n = ((n + 15u) & ~15u);
+
+    for (unsigned j = 0u; j < taps->count; ++j) {
+        unsigned i = (unsigned)ti[taps->lane[j]] + 1u;
+        if (i >= AYMO_YM7128_DELAY_LENGTH) {
+            i -= AYMO_YM7128_DELAY_LENGTH;
+        }
+        if ((i + n) <= AYMO_YM7128_DELAY_LENGTH) {
+            taps->up[j] = &chip->uh[i];
+        }
+        else {
+            unsigned m = (AYMO_YM7128_DELAY_LENGTH - i);
+            aymo_memcpy(&scratch[j][0], (void*)&chip->uh[i], (m * sizeof(int16_t)));
+            aymo_memcpy(&scratch[j][m], (void*)&chip->uh[0], ((n - m) * sizeof(int16_t)));
+            taps->up[j] = &scratch[j][0];
+        }
+    }
+}
+
+
+// Accumulates tap pairs into 32-bit sums, 16 samples at a time;
+// each pair of sums holds samples '0123''89AB' and '4567''CDEF'
+static
+void aymo_(taps_mix)(const struct aymo_(taps)* taps, unsigned n, vi32x8_t accl[], vi32x8_t accr[])
+{
+    const vi16x16_t one = _mm256_set1_epi16(1);
+
+    for (unsigned j = 0u; j < taps->count; j += 2u) {
+        const int16_t* ua = taps->up[j];
+        const int16_t* ub = taps->up[j + 1u];
+        vi16x16_t kla = _mm256_set1_epi16(taps->kl[j]);
+        vi16x16_t klb = _mm256_set1_epi16(taps->kl[j + 1u]);
+        vi16x16_t kra = _mm256_set1_epi16(taps->kr[j]);
+        vi16x16_t krb = _mm256_set1_epi16(taps->kr[j + 1u]);
+
+        for (unsigned k = 0u; k < n; k += 16u) {
+            vi16x16_t ta = _mm256_loadu_si256((const void*)&ua[k]);
+            vi16x16_t tb = _mm256_loadu_si256((const void*)&ub[k]);
+            vi16x16_t gla = _mm256_mulhrs_epi16(ta, kla);
+            vi16x16_t glb = _mm256_mulhrs_epi16(tb, klb);
+            vi16x16_t gra = _mm256_mulhrs_epi16(ta, kra);
+            vi16x16_t grb = _mm256_mulhrs_epi16(tb, krb);
+            unsigned g = (k >> 3);
+            accl[g     ] = _mm256_add_epi32(accl[g     ], _mm256_madd_epi16(_mm256_unpacklo_epi16(gla, glb), one));
+            accl[g + 1u] = _mm256_add_epi32(accl[g + 1u], _mm256_madd_epi16(_mm256_unpackhi_epi16(gla, glb), one));
+            accr[g     ] = _mm256_add_epi32(accr[g     ], _mm256_madd_epi16(_mm256_unpacklo_epi16(gra, grb), one));
+            accr[g + 1u] = _mm256_add_epi32(accr[g + 1u], _mm256_madd_epi16(_mm256_unpackhi_epi16(gra, grb), one));
+        }
+    }
+}
+
+
+// Polyphase oversampler, vectorized over time: each vector holds the L,R pairs
+// of eight consecutive input samples, with the 9 previous pairs before z[0].
+// Partial sums follow the same order as the per-sample kernel it replaced.
+static
+void aymo_(oversample)(const vi16x16_t kh[], const int32_t z[], unsigned n, int16_t y[])
+{
+    vi16x16_t km = _mm256_set1_epi16((int16_t)AYMO_YM7128_SIGNAL_MASK);
+
+    for (unsigned k = 0u; k < n; k += 8u) {
+        const int32_t* p = &z[k];
+        vi16x16_t z0 = _mm256_loadu_si256((const void*)&p[ 0]);
+        vi16x16_t z1 = _mm256_loadu_si256((const void*)&p[-1]);
+        vi16x16_t z2 = _mm256_loadu_si256((const void*)&p[-2]);
+        vi16x16_t z3 = _mm256_loadu_si256((const void*)&p[-3]);
+        vi16x16_t z4 = _mm256_loadu_si256((const void*)&p[-4]);
+        vi16x16_t z5 = _mm256_loadu_si256((const void*)&p[-5]);
+        vi16x16_t z6 = _mm256_loadu_si256((const void*)&p[-6]);
+        vi16x16_t z7 = _mm256_loadu_si256((const void*)&p[-7]);
+        vi16x16_t z8 = _mm256_loadu_si256((const void*)&p[-8]);
+        vi16x16_t z9 = _mm256_loadu_si256((const void*)&p[-9]);
+
+        // Even phase
+        vi16x16_t a0 = _mm256_adds_epi16(_mm256_adds_epi16(_mm256_mulhrs_epi16(z8, kh[16]),
+                                                           _mm256_mulhrs_epi16(z4, kh[ 8])),
+                                         _mm256_mulhrs_epi16(z0, kh[ 0]));
+        vi16x16_t a1 = _mm256_adds_epi16(_mm256_adds_epi16(_mm256_mulhrs_epi16(z9, kh[18]),
+                                                           _mm256_mulhrs_epi16(z5, kh[10])),
+                                         _mm256_mulhrs_epi16(z1, kh[ 2]));
+        vi16x16_t a2 = _mm256_adds_epi16(_mm256_mulhrs_epi16(z6, kh[12]), _mm256_mulhrs_epi16(z2, kh[ 4]));
+        vi16x16_t a3 = _mm256_adds_epi16(_mm256_mulhrs_epi16(z7, kh[14]), _mm256_mulhrs_epi16(z3, kh[ 6]));
+        vi16x16_t y0 = _mm256_adds_epi16(_mm256_adds_epi16(a0, a1), _mm256_adds_epi16(a2, a3));
+
+        // Odd phase
+        vi16x16_t b0 = _mm256_adds_epi16(_mm256_adds_epi16(_mm256_mulhrs_epi16(z8, kh[17]),
+                                                           _mm256_mulhrs_epi16(z4, kh[ 9])),
+                                         _mm256_mulhrs_epi16(z0, kh[ 1]));
+        vi16x16_t b1 = _mm256_adds_epi16(_mm256_mulhrs_epi16(z5, kh[11]), _mm256_mulhrs_epi16(z1, kh[ 3]));
+        vi16x16_t b2 = _mm256_adds_epi16(_mm256_mulhrs_epi16(z6, kh[13]), _mm256_mulhrs_epi16(z2, kh[ 5]));
+        vi16x16_t b3 = _mm256_adds_epi16(_mm256_mulhrs_epi16(z7, kh[15]), _mm256_mulhrs_epi16(z3, kh[ 7]));
+        vi16x16_t y1 = _mm256_adds_epi16(_mm256_adds_epi16(b0, b1), _mm256_adds_epi16(b2, b3));
+
+        y0 = _mm256_and_si256(y0, km);
+        y1 = _mm256_and_si256(y1, km);
+        vi16x16_t ya = _mm256_unpacklo_epi32(y0, y1);  // '01''45'
+        vi16x16_t yb = _mm256_unpackhi_epi32(y0, y1);  // '23''67'
+        vi16x16_t yc = _mm256_permute2x128_si256(ya, yb, 0x20);
+        vi16x16_t yd = _mm256_permute2x128_si256(ya, yb, 0x31);
+
+        if AYMO_LIKELY((k + 8u) <= n) {
+            _mm256_storeu_si256((void*)&y[ 0], yc);
+            _mm256_storeu_si256((void*)&y[16], yd);
+        }
+        else {
+            AYMO_ALIGN_V256 int16_t yt[32];
+            _mm256_store_si256((void*)&yt[ 0], yc);
+            _mm256_store_si256((void*)&yt[16], yd);
+            aymo_memcpy(y, yt, ((n - k) * 4u * sizeof(int16_t)));
+        }
+        y += 32u;
+    }
+}
+
+
+// Processes blocks of samples: the input stage runs per sample, as it feeds
+// back from T0, while taps are mixed with contiguous loads from the delay line.
+// The oversampler then runs on the whole block.
+// Taps are mixed 16 samples at a time, and the oversampler runs 8 at a time.
+void aymo_(process_i16)(struct aymo_(chip)* chip, uint32_t count, const int16_t x[], int16_t y[])
+{
+    assert(chip);
+    assert(x);
+    assert(y);
+    if AYMO_UNLIKELY(!count) return;
+
+    vi16x8_t xxv = chip->xxv;
+    vi16x8_t kk1 = chip->kk1;
+    vi16x8_t kk2 = chip->kk2;
+    vi16x8_t kkm = chip->kkm;
+    vi16x8_t ti = chip->ti;
+    int16_t ti0 = vextract(xxv, 0);
+    int16_t hi = vextract(xxv, 1);
+    int16_t t0 = vextract(xxv, 4);
+    int16_t xk = vextract(xxv, 5);
+    int16_t t0d = vextract(xxv, 6);
+    vi16x16_t kvl = _mm256_set1_epi16(vextract(chip->kv, 6));
+    vi16x16_t kvr = _mm256_set1_epi16(vextract(chip->kv, 7));
+
+
+    struct aymo_(taps) lt, st;
+    aymo_(taps_setup)(chip, &lt, &st);
+
+    AYMO_ALIGN_V128 int16_t tiv[8];
+    AYMO_ALIGN_V128 int16_t scratch[8 + 2][AYMO_YM7128_BLOCK_LENGTH];  // with padding
+    vi32x8_t accl[AYMO_YM7128_BLOCK_LENGTH / 8];
+    vi32x8_t accr[AYMO_YM7128_BLOCK_LENGTH / 8];
+    AYMO_ALIGN_V256 int32_t zv[16 + AYMO_YM7128_BLOCK_LENGTH];  // oversampler history, then block
+    int32_t* vlrn = &zv[16];
+    aymo_memcpy(&zv[16 - 9], chip->zh, sizeof(chip->zh));
+
+    do {
+        unsigned n = ((count < AYMO_YM7128_BLOCK_LENGTH) ? (unsigned)count : AYMO_YM7128_BLOCK_LENGTH);
+        count -= n;
+
+        for (unsigned g = 0u; g < (((n + 15u) & ~15u) >> 3); ++g) {
+            accl[g] = _mm256_setzero_si256();
+            accr[g] = _mm256_setzero_si256();
+        }
+
+        // Long taps read what was written before this block
+        vstore((void*)tiv, ti);
+        aymo_(taps_locate)(chip, &lt, tiv, n, scratch);
+        aymo_(taps_mix)(&lt, n, accl, accr);
+
+        for (unsigned k = 0u; k < n; ++k) {
+            t0 = chip->uh[ti0];
+            xk = (int16_t)(*x++ & AYMO_YM7128_SIGNAL_MASK);
+
+            vi16x8_t xx = vinsert(xxv, ti0, 0);
+            xx = vinsert(xx, hi, 1);
+            xx = vinsert(xx, t0, 4);
+            xx = vinsert(xx, xk, 5);
+            xx = vinsert(xx, t0d, 6);
+            t0d = t0;
+            xx = vmulhrs(xx, kk1);
+            xx = vaddsi(xx, vvshuffle(xx, KSHUFFLE(2, 3, 0, 1)));  // "2301"
+            xx = vmulhrs(xx, kk2);
+            xx = vand(xx, vcmpgt(kkm, xx));
+            xx = vaddsi(xx, valignr(xx, xx, 2));
+
+            // Delay line pointers just wrap around
+            if AYMO_UNLIKELY(++ti0 >= AYMO_YM7128_DELAY_LENGTH) ti0 = 0;
+            if AYMO_UNLIKELY(++hi >= AYMO_YM7128_DELAY_LENGTH) hi = 0;
+            chip->uh[hi] = vextract(xx, 5);
+        }
+
+        // Short taps read what was written within this block
+        aymo_(taps_locate)(chip, &st, tiv, n, scratch + lt.count);
+        aymo_(taps_mix)(&st, n, accl, accr);
+
+        vi16x8_t tj = vadd(ti, vset1((int16_t)n));
+        vi16x8_t tm = vcmpgt(tj, vset1(AYMO_YM7128_DELAY_LENGTH - 1));  // tj >= DL
+        ti = vsub(tj, vand(tm, vset1(AYMO_YM7128_DELAY_LENGTH)));
+
+        for (unsigned k = 0u; k < n; k += 16u) {
+            unsigned g = (k >> 3);
+            vi16x16_t vl = _mm256_mulhrs_epi16(_mm256_packs_epi32(accl[g], accl[g + 1u]), kvl);
+            vi16x16_t vr = _mm256_mulhrs_epi16(_mm256_packs_epi32(accr[g], accr[g + 1u]), kvr);
+            vi16x16_t vlr_lo = _mm256_unpacklo_epi16(vl, vr);  // '0123''89AB'
+            vi16x16_t vlr_hi = _mm256_unpackhi_epi16(vl, vr);  // '4567''CDEF'
+            _mm256_storeu_si256((void*)&vlrn[k     ], _mm256_permute2x128_si256(vlr_lo, vlr_hi, 0x20));
+            _mm256_storeu_si256((void*)&vlrn[k + 8u], _mm256_permute2x128_si256(vlr_lo, vlr_hi, 0x31));
+        }
+
+        aymo_(oversample)(chip->kh, vlrn, n, y);
+        y += (n * 4u);
+
+        for (unsigned k = 0u; k < 9u; ++k) {
+            zv[(16 - 9) + k] = vlrn[(int)(n + k) - 9];
+        }
+    } while (count);
+
+    xxv = vinsert(xxv, ti0, 0);
+    xxv = vinsert(xxv, hi, 1);
+    xxv = vinsert(xxv, t0, 4);
+    xxv = vinsert(xxv, xk, 5);
+    xxv = vinsert(xxv, t0d, 6);
+    chip->xxv = xxv;
+    chip->ti = ti;
+
+    aymo_memcpy(chip->zh, &zv[16 - 9], sizeof(chip->zh));
+}
+
+
+// Copies n samples of the float delay line from index i, wrapping around its end
+static
+void aymo_(f32_gather)(const float uh[], unsigned i, unsigned n, float dst[])
+{
+    unsigned m = (AYMO_YM7128_DELAY_LENGTH - i);
+    if (m > n) {
+        m = n;
+    }
+    aymo_memcpy(&dst[0], (void*)&uh[i], (m * sizeof(float)));
+    aymo_memcpy(&dst[m], (void*)&uh[0], ((n - m) * sizeof(float)));
+}
+
+
+// Copies n samples into the float delay line from index i, wrapping around its end
+static
+void aymo_(f32_scatter)(float uh[], unsigned i, unsigned n, const float src[])
+{
+    unsigned m = (AYMO_YM7128_DELAY_LENGTH - i);
+    if (m > n) {
+        m = n;
+    }
+    aymo_memcpy(&uh[i], (void*)&src[0], (m * sizeof(float)));
+    aymo_memcpy(&uh[0], (void*)&src[m], ((n - m) * sizeof(float)));
+}
+
+
+// Float model block kernel.
+// Taps are read after the block is written into the delay line, except those
+// reaching back into samples the block overwrites; T0 is vectorized unless it
+// is shorter than the block.
+static
+void aymo_(run_f32)(struct aymo_(chip)* chip, unsigned n, const float x[], float y[])
+{
+    const struct aymo_ym7128_f32_coeffs* k = &chip->f32_coeffs;
+    struct aymo_ym7128_f32_state* s = &chip->f32;
+    const float* kk = aymo_ym7128_kernel_linear_f32;
+    unsigned nv = ((n + 7u) & ~7u);
+    unsigned hi = s->hi;
+    unsigned i;
+
+    unsigned hw = (hi + 1u);
+    if (hw >= AYMO_YM7128_DELAY_LENGTH) {
+        hw -= AYMO_YM7128_DELAY_LENGTH;
+    }
+    unsigned t0 = (unsigned)k->tap[0];
+    unsigned ti = (hw + AYMO_YM7128_DELAY_LENGTH - 1u - t0);
+    if (ti >= AYMO_YM7128_DELAY_LENGTH) {
+        ti -= AYMO_YM7128_DELAY_LENGTH;
+    }
+
+    // Locate the audible taps, from the first sample written by the block;
+    // the longest ones are copied before the block overwrites their samples
+    float wv[8][AYMO_YM7128_BLOCK_LENGTH];
+    const float* wp[8];
+    unsigned wi[8];
+    float gl[8];
+    float gr[8];
+    unsigned taps = 0u;
+
+    for (unsigned j = 0u; j < 8u; ++j) {
+        if ((k->kgl[j] != 0.f) || (k->kgr[j] != 0.f)) {
+            unsigned t = (unsigned)k->tap[1u + j];
+            unsigned tj = (hw + AYMO_YM7128_DELAY_LENGTH - t);
+            if (tj >= AYMO_YM7128_DELAY_LENGTH) {
+                tj -= AYMO_YM7128_DELAY_LENGTH;
+            }
+            if ((t + nv) > AYMO_YM7128_DELAY_LENGTH) {
+                aymo_(f32_gather)(s->uh, tj, nv, wv[taps]);
+                wp[taps] = wv[taps];
+            }
+            else {
+                wp[taps] = NULL;
+                wi[taps] = tj;
+            }
+            gl[taps] = k->kgl[j];
+            gr[taps] = k->kgr[j];
+            ++taps;
+        }
+    }
+
+    // Input stage
+    if ((t0 + 1u) >= n) {
+        float tv[AYMO_YM7128_BLOCK_LENGTH + 1];  // T0 delayed, then T0
+        float uv[AYMO_YM7128_BLOCK_LENGTH];
+        tv[0] = s->t0d;
+        aymo_(f32_gather)(s->uh, ti, n, &tv[1]);
+        s->t0d = tv[n];
+
+        __m256 kvm = _mm256_set1_ps(k->kvm);
+        __m256 kvc = _mm256_set1_ps(k->kvc);
+        __m256 kc0 = _mm256_set1_ps(k->kc0);
+        __m256 kc1 = _mm256_set1_ps(k->kc1);
+
+        for (i = 0u; (i + 8u) <= n; i += 8u) {
+            __m256 vt0 = _mm256_loadu_ps(&tv[i + 1u]);
+            __m256 vt0d = _mm256_loadu_ps(&tv[i]);
+            __m256 vf = _mm256_add_ps(_mm256_mul_ps(vt0, kc0), _mm256_mul_ps(vt0d, kc1));
+            __m256 vu = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(&x[i]), kvm), _mm256_mul_ps(vf, kvc));
+            _mm256_storeu_ps(&uv[i], vu);
+        }
+        for (; i < n; ++i) {
+            uv[i] = ((x[i] * k->kvm) + (((tv[i + 1u] * k->kc0) + (tv[i] * k->kc1)) * k->kvc));
+        }
+        aymo_(f32_scatter)(s->uh, hw, n, uv);
+    }
+    else {
+        float t0d = s->t0d;
+        unsigned hj = hw;
+        for (i = 0u; i < n; ++i) {
+            float t = s->uh[ti];
+            s->uh[hj] = ((x[i] * k->kvm) + (((t * k->kc0) + (t0d * k->kc1)) * k->kvc));
+            t0d = t;
+            if (++ti >= AYMO_YM7128_DELAY_LENGTH) {
+                ti = 0u;
+            }
+            if (++hj >= AYMO_YM7128_DELAY_LENGTH) {
+                hj = 0u;
+            }
+        }
+        s->t0d = t0d;
+    }
+
+    for (unsigned j = 0u; j < taps; ++j) {
+        if (!wp[j]) {
+            unsigned tj = wi[j];
+            if ((tj + nv) <= AYMO_YM7128_DELAY_LENGTH) {
+                wp[j] = &s->uh[tj];
+            }
+            else {
+                aymo_(f32_gather)(s->uh, tj, nv, wv[j]);
+                wp[j] = wv[j];
+            }
+        }
+    }
+
+    // Mix the taps and interleave them after the oversampler history
+    float lr[(AYMO_YM7128_KERNEL_LENGTH - 1) + (AYMO_YM7128_BLOCK_LENGTH * 2)];
+    float* zv = &lr[AYMO_YM7128_KERNEL_LENGTH - 1];
+    aymo_memcpy(lr, s->zh, sizeof(s->zh));
+
+    __m256 kvl = _mm256_set1_ps(k->kvl);
+    __m256 kvr = _mm256_set1_ps(k->kvr);
+
+    for (i = 0u; i < nv; i += 8u) {
+        __m256 vl = _mm256_setzero_ps();
+        __m256 vr = _mm256_setzero_ps();
+        for (unsigned j = 0u; j < taps; ++j) {
+            __m256 vw = _mm256_loadu_ps(&wp[j][i]);
+            vl = _mm256_add_ps(vl, _mm256_mul_ps(vw, _mm256_set1_ps(gl[j])));
+            vr = _mm256_add_ps(vr, _mm256_mul_ps(vw, _mm256_set1_ps(gr[j])));
+        }
+        vl = _mm256_mul_ps(vl, kvl);
+        vr = _mm256_mul_ps(vr, kvr);
+        __m256 va = _mm256_unpacklo_ps(vl, vr);
+        __m256 vb = _mm256_unpackhi_ps(vl, vr);
+        _mm256_storeu_ps(&zv[(i * 2u) + 0u], _mm256_permute2f128_ps(va, vb, 0x20));
+        _mm256_storeu_ps(&zv[(i * 2u) + 8u], _mm256_permute2f128_ps(va, vb, 0x31));
+    }
+
+    // Oversampler, four frames at a time
+    for (i = 0u; i < n; i += 4u) {
+        const float* p = &zv[i * 2u];
+        __m256 vz = _mm256_loadu_ps(p);
+        __m256 y0 = _mm256_mul_ps(vz, _mm256_set1_ps(kk[0]));
+        __m256 y1 = _mm256_mul_ps(vz, _mm256_set1_ps(kk[1]));
+        for (unsigned j = 1u; j < 9u; ++j) {
+            vz = _mm256_loadu_ps(p - (j * 2u));
+            y0 = _mm256_add_ps(y0, _mm256_mul_ps(vz, _mm256_set1_ps(kk[j * 2u])));
+            y1 = _mm256_add_ps(y1, _mm256_mul_ps(vz, _mm256_set1_ps(kk[(j * 2u) + 1u])));
+        }
+        vz = _mm256_loadu_ps(p - 18u);
+        y0 = _mm256_add_ps(y0, _mm256_mul_ps(vz, _mm256_set1_ps(kk[18])));
+
+        __m256 ya = _mm256_castpd_ps(_mm256_unpacklo_pd(_mm256_castps_pd(y0), _mm256_castps_pd(y1)));  // frames 0, 2
+        __m256 yb = _mm256_castpd_ps(_mm256_unpackhi_pd(_mm256_castps_pd(y0), _mm256_castps_pd(y1)));  // frames 1, 3
+        __m256 yc = _mm256_permute2f128_ps(ya, yb, 0x20);
+        __m256 yd = _mm256_permute2f128_ps(ya, yb, 0x31);
+
+        if AYMO_LIKELY((i + 4u) <= n) {
+            _mm256_storeu_ps(&y[0], yc);
+            _mm256_storeu_ps(&y[8], yd);
+        }
+        else {
+            float yt[16];
+            _mm256_storeu_ps(&yt[0], yc);
+            _mm256_storeu_ps(&yt[8], yd);
+            aymo_memcpy(y, yt, ((n - i) * 4u * sizeof(float)));
+        }
+        y += 16u;
+    }
+
+    aymo_memcpy(s->zh, &lr[n * 2u], sizeof(s->zh));
+
+    hi += n;
+    if (hi >= AYMO_YM7128_DELAY_LENGTH) {
+        hi -= AYMO_YM7128_DELAY_LENGTH;
+    }
+    s->hi = (uint16_t)hi;
+}
+
+
+void aymo_(process_f32)(struct aymo_(chip)* chip, uint32_t count, const float x[], float y[])
+{
+    assert(chip);
+    assert(x);
+    assert(y);
+    if AYMO_UNLIKELY(!count) return;
+
+    aymo_cpu_fpstate_t fpstate = aymo_cpu_enter_ftz();
+
+    while (count) {
+        unsigned n = ((count < AYMO_YM7128_BLOCK_LENGTH) ? (unsigned)count : AYMO_YM7128_BLOCK_LENGTH);
+        aymo_(run_f32)(chip, n, x, y);
+        x += n;
+        y += (n * 4u);
+        count -= n;
+    }
+
+    aymo_cpu_leave_ftz(fpstate);
+}
+
+
+AYMO_CXX_EXTERN_C_END
+
+#endif  // AYMO_CPU_SUPPORT_X86_AVX2
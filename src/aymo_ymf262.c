@@ -251,4 +251,34 @@ void aymo_ymf262_generate_f32x4(struct aymo_ymf262_chip* chip, uint32_t count, f
 }
 
 
+void aymo_ymf262_load_registers(
+    struct aymo_ymf262_chip* chip,
+    const uint8_t regs[AYMO_YMF262_REG_NUM],
+    const uint8_t mask[AYMO_YMF262_REG_NUM / 8u]
+)
+{
+    assert(chip);
+    assert(chip->vt);
+    assert(chip->vt->load_registers);
+    assert(regs);
+
+    chip->vt->load_registers(chip, regs, mask);
+}
+
+
+void aymo_ymf262_write_batch(
+    struct aymo_ymf262_chip* chip,
+    const struct aymo_ymf262_reg_write writes[],
+    uint32_t count
+)
+{
+    assert(chip);
+    assert(chip->vt);
+    assert(chip->vt->write_batch);
+    assert(!count || writes);
+
+    chip->vt->write_batch(chip, writes, count);
+}
+
+
 AYMO_CXX_EXTERN_C_END
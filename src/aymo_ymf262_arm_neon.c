@@ -48,7 +48,9 @@ const struct aymo_ymf262_vt aymo_(vt) =
     (aymo_ymf262_generate_i16x2_f)&(aymo_(generate_i16x2)),
     (aymo_ymf262_generate_i16x4_f)&(aymo_(generate_i16x4)),
     (aymo_ymf262_generate_f32x2_f)&(aymo_(generate_f32x2)),
-    (aymo_ymf262_generate_f32x4_f)&(aymo_(generate_f32x4))
+    (aymo_ymf262_generate_f32x4_f)&(aymo_(generate_f32x4)),
+    (aymo_ymf262_load_registers_f)&(aymo_(load_registers)),
+    (aymo_ymf262_write_batch_f)&(aymo_(write_batch))
 };
 
 
@@ -819,8 +821,8 @@ void aymo_(pg_update_fnum)(
     struct aymo_ymf262_reg_20h* reg_20h0 = &(chip->slot_regs[slot0].reg_20h);
     int16_t ks0 = (eg_ksv >> ((reg_20h0->ksr ^ 1) << 1));
     vinsertv(sg0->eg_ks, ks0, sgo);
-    aymo_(eg_update_ksl)(chip, word0);
-    aymo_(pg_update_deltafreq)(chip, cg, sg0);
+    chip->wr_ksl_words |= (1uLL << word0);  // deferred
+    chip->wr_deltafreq_sgs |= (1u << sgi0);  // deferred
 
     int word1 = aymo_ymf262_ch2x_to_word[ch2x][1];
     int sgi1 = (word1 / AYMO_(SLOT_GROUP_LENGTH));
@@ -829,8 +831,8 @@ void aymo_(pg_update_fnum)(
     struct aymo_ymf262_reg_20h* reg_20h1 = &(chip->slot_regs[slot1].reg_20h);
     int16_t ks1 = (eg_ksv >> ((reg_20h1->ksr ^ 1) << 1));
     vinsertv(sg1->eg_ks, ks1, sgo);
-    aymo_(eg_update_ksl)(chip, word1);
-    aymo_(pg_update_deltafreq)(chip, cg, sg1);
+    chip->wr_ksl_words |= (1uLL << word1);  // deferred
+    chip->wr_deltafreq_sgs |= (1u << sgi1);  // deferred
 }
 
 
@@ -1127,6 +1129,165 @@ void aymo_(cm_rewire_rhythm)(
 }
 
 
+// Applies the derived state updates deferred by register writes
+static
+void aymo_(wr_flush)(struct aymo_(chip)* chip)
+{
+    uint32_t fnum_ch2x = chip->wr_fnum_ch2x;
+    if (fnum_ch2x) {
+        chip->wr_fnum_ch2x = 0u;
+        do {
+            int ch2x = (uffsll(fnum_ch2x) - 1);
+            fnum_ch2x &= (fnum_ch2x - 1u);
+
+            unsigned ch2x_is_pairing = (chip->og_ch2x_pairing & (1uL << ch2x));
+            int ch2p = -1;
+            if (chip->chip_regs.reg_105h.newm && ch2x_is_pairing) {
+                ch2p = aymo_ymf262_ch2x_paired[ch2x];
+            }
+            aymo_(ch2x_update_fnum)(chip, ch2x, ch2p);
+        } while (fnum_ch2x);
+    }
+
+    uint32_t rewire_ch2x = chip->wr_rewire_ch2x;
+    if (rewire_ch2x) {
+        chip->wr_rewire_ch2x = 0u;
+        do {
+            int ch2x = (uffsll(rewire_ch2x) - 1);
+            rewire_ch2x &= (rewire_ch2x - 1u);
+            aymo_(cm_rewire_ch2x)(chip, ch2x);
+        } while (rewire_ch2x);
+    }
+
+    uint64_t ksl_words = chip->wr_ksl_words;
+    if (ksl_words) {
+        chip->wr_ksl_words = 0u;
+        do {
+            int word = (uffsll(ksl_words) - 1);
+            ksl_words &= (ksl_words - 1u);
+            aymo_(eg_update_ksl)(chip, word);
+        } while (ksl_words);
+    }
+
+    uint32_t deltafreq_sgs = chip->wr_deltafreq_sgs;
+    if (deltafreq_sgs) {
+        chip->wr_deltafreq_sgs = 0u;
+        for (int sgi = 0; sgi < AYMO_(SLOT_GROUP_NUM); ++sgi) {
+            if (deltafreq_sgs & (1u << sgi)) {
+                int cgi = aymo_(sgi_to_cgi)(sgi);
+                aymo_(pg_update_deltafreq)(chip, &chip->cg[cgi], &chip->sg[sgi]);
+            }
+        }
+    }
+}
+
+
+// Register write kinds, for batch processing
+enum aymo_(wr_kind) {
+    aymo_(wr_kind_last) = 0,  // only the last value matters
+    aymo_(wr_kind_ordered),  // each value matters (key on/off)
+    aymo_(wr_kind_barrier)  // changes how other registers behave
+};
+
+static inline
+enum aymo_(wr_kind) aymo_(wr_kind_of)(uint16_t address)
+{
+    switch (address & 0xF0) {
+    case 0x00: {
+        if ((address == 0x08) || (address == 0x104) || (address == 0x105)) {
+            return aymo_(wr_kind_barrier);
+        }
+        return aymo_(wr_kind_last);
+    }
+    case 0xB0: {
+        if (address == 0xBD) {
+            return aymo_(wr_kind_barrier);
+        }
+        return aymo_(wr_kind_ordered);
+    }
+    default: {
+        return aymo_(wr_kind_last);
+    }
+    }
+}
+
+
+// Shadow register byte, NULL if it has no derived state
+static
+uint8_t* aymo_(wr_shadow)(struct aymo_(chip)* chip, uint16_t address)
+{
+    switch (address & 0xF0) {
+    case 0x20:
+    case 0x30: return (uint8_t*)(void*)&(chip->slot_regs[aymo_(addr_to_slot)(address)].reg_20h);
+    case 0x40:
+    case 0x50: return (uint8_t*)(void*)&(chip->slot_regs[aymo_(addr_to_slot)(address)].reg_40h);
+    case 0x60:
+    case 0x70: return (uint8_t*)(void*)&(chip->slot_regs[aymo_(addr_to_slot)(address)].reg_60h);
+    case 0x80:
+    case 0x90: return (uint8_t*)(void*)&(chip->slot_regs[aymo_(addr_to_slot)(address)].reg_80h);
+    case 0xE0:
+    case 0xF0: return (uint8_t*)(void*)&(chip->slot_regs[aymo_(addr_to_slot)(address)].reg_E0h);
+    case 0xA0: return (uint8_t*)(void*)&(chip->ch2x_regs[aymo_(addr_to_ch2x)(address)].reg_A0h);
+    case 0xC0: return (uint8_t*)(void*)&(chip->ch2x_regs[aymo_(addr_to_ch2x)(address)].reg_C0h);
+    default: return NULL;
+    }
+}
+
+
+// Value actually stored into the shadow register, as done by the write handlers
+static inline
+uint8_t aymo_(wr_effective)(struct aymo_(chip)* chip, uint16_t address, uint8_t value)
+{
+    if (!chip->chip_regs.reg_105h.newm) {
+        if ((address & 0xF0) == 0xC0) {
+            value = ((value & 0x0Fu) | 0x30u);
+        }
+        else if ((address & 0xE0) == 0xE0) {
+            int slot = aymo_(addr_to_slot)(address);
+            if (chip->chip_regs.reg_105h.simd || (slot < AYMO_YMF262_SLOT_NUM)) {
+                value &= 0xFBu;  // ws &= 3
+            }
+        }
+    }
+    return value;
+}
+
+
+// Prepares the shadow register for the last write of a sequence, so that the
+// write handler sees every field changed by any of the skipped writes
+static
+void aymo_(wr_collapse)(
+    struct aymo_(chip)* chip,
+    const struct aymo_ymf262_reg_write skipped[],
+    uint32_t count,
+    uint16_t address,
+    uint8_t value
+)
+{
+    uint8_t* shadow = aymo_(wr_shadow)(chip, address);
+    if (shadow) {
+        uint8_t last = aymo_(wr_effective)(chip, address, value);
+        uint8_t next = last;
+        uint8_t diff = 0u;
+        int found = 0;
+
+        for (uint32_t i = count; i--; ) {
+            if (skipped[i].address == address) {
+                uint8_t prev = aymo_(wr_effective)(chip, address, skipped[i].value);
+                diff |= (prev ^ next);
+                next = prev;
+                found = 1;
+            }
+        }
+
+        if (found) {
+            diff |= (FORCE_BYTE(shadow) ^ next);
+            FORCE_BYTE(shadow) = (last ^ diff);
+        }
+    }
+}
+
+
 static
 void aymo_(write_00h)(struct aymo_(chip)* chip, uint16_t address, uint8_t value)
 {
@@ -1231,12 +1392,7 @@ void aymo_(write_20h)(struct aymo_(chip)* chip, uint16_t address, uint8_t value)
     }
 
     if (update_deltafreq) {
-        for (sgi = 0; sgi < AYMO_(SLOT_GROUP_NUM); ++sgi) {
-            cgi = aymo_(sgi_to_cgi)(sgi);
-            cg = &chip->cg[cgi];
-            sg = &chip->sg[sgi];
-            aymo_(pg_update_deltafreq)(chip, cg, sg);
-        }
+        chip->wr_deltafreq_sgs = ((1u << AYMO_(SLOT_GROUP_NUM)) - 1u);  // deferred
     }
 }
 
@@ -1256,7 +1412,7 @@ void aymo_(write_40h)(struct aymo_(chip)* chip, uint16_t address, uint8_t value)
     int word = aymo_ymf262_slot_to_word[slot];
 
     if ((reg_40h->tl != reg_40h_prev.tl) || (reg_40h->ksl != reg_40h_prev.ksl)) {
-        aymo_(eg_update_ksl)(chip, word);
+        chip->wr_ksl_words |= (1uLL << word);  // deferred
     }
 }
 
@@ -1370,12 +1526,8 @@ void aymo_(write_A0h)(struct aymo_(chip)* chip, uint16_t address, uint8_t value)
     int ch2x_is_secondary = (ch2p < ch2x);
 
     if (!(chip->chip_regs.reg_105h.newm && ch2x_is_pairing && ch2x_is_secondary)) {
-        if (!(chip->chip_regs.reg_105h.newm && ch2x_is_pairing && !ch2x_is_secondary)) {
-            ch2p = -1;
-        }
-
         if (reg_A0h->fnum_lo != reg_A0h_prev.fnum_lo) {
-            aymo_(ch2x_update_fnum)(chip, ch2x, ch2p);
+            chip->wr_fnum_ch2x |= (1uL << ch2x);  // deferred
         }
     }
 }
@@ -1416,12 +1568,8 @@ void aymo_(write_B0h)(struct aymo_(chip)* chip, uint16_t address, uint8_t value)
         int ch2x_is_secondary = (ch2p < ch2x);
 
         if (!(chip->chip_regs.reg_105h.newm && ch2x_is_pairing && ch2x_is_secondary)) {
-            if (!(chip->chip_regs.reg_105h.newm && ch2x_is_pairing && !ch2x_is_secondary)) {
-                ch2p = -1;
-            }
-
             if ((reg_B0h->fnum_hi != reg_B0h_prev.fnum_hi) || (reg_B0h->block != reg_B0h_prev.block)) {
-                aymo_(ch2x_update_fnum)(chip, ch2x, ch2p);
+                chip->wr_fnum_ch2x |= (1uL << ch2x);  // deferred
             }
         }
 
@@ -1499,7 +1647,7 @@ void aymo_(write_C0h)(struct aymo_(chip)* chip, uint16_t address, uint8_t value)
     }
 
     if (reg_C0h->cnt != reg_C0h_prev.cnt) {
-        aymo_(cm_rewire_ch2x)(chip, ch2x);
+        chip->wr_rewire_ch2x |= (1uL << ch2x);  // deferred
     }
 }
 
@@ -1619,14 +1767,9 @@ uint8_t aymo_(read)(struct aymo_(chip)* chip, uint16_t address)
 }
 
 
-void aymo_(write)(struct aymo_(chip)* chip, uint16_t address, uint8_t value)
+static
+void aymo_(write_reg)(struct aymo_(chip)* chip, uint16_t address, uint8_t value)
 {
-    assert(chip);
-
-    if (address > 0x1FF) {
-        return;
-    }
-
     switch (address & 0xF0) {
     case 0x00: {
         aymo_(write_00h)(chip, address, value);
@@ -1674,6 +1817,410 @@ void aymo_(write)(struct aymo_(chip)* chip, uint16_t address, uint8_t value)
         break;
     }
     }
+}
+
+
+void aymo_(write)(struct aymo_(chip)* chip, uint16_t address, uint8_t value)
+{
+    assert(chip);
+
+    if (address > 0x1FF) {
+        return;
+    }
+
+    aymo_(write_reg)(chip, address, value);
+    aymo_(wr_flush)(chip);
+    vsfence();
+}
+
+
+void aymo_(write_batch)(
+    struct aymo_(chip)* chip,
+    const struct aymo_ymf262_reg_write writes[],
+    uint32_t count
+)
+{
+    assert(chip);
+    assert(!count || writes);
+
+    uint8_t seen[AYMO_YMF262_REG_NUM / 8u];
+
+    while (count) {
+        uint32_t length = ((count < 64u) ? count : 64u);
+
+        // Find the writes overwritten before any barrier, backwards
+        uint64_t live = 0u;
+        aymo_memset(seen, 0, sizeof(seen));
+        for (uint32_t i = length; i--; ) {
+            uint16_t address = writes[i].address;
+            if (address < AYMO_YMF262_REG_NUM) {
+                enum aymo_(wr_kind) kind = aymo_(wr_kind_of)(address);
+                if (kind == aymo_(wr_kind_last)) {
+                    uint8_t mask = (uint8_t)(1u << (address & 7u));
+                    if (!(seen[address >> 3u] & mask)) {
+                        seen[address >> 3u] |= mask;
+                        live |= (1uLL << i);
+                    }
+                }
+                else {
+                    if (kind == aymo_(wr_kind_barrier)) {
+                        aymo_memset(seen, 0, sizeof(seen));
+                    }
+                    live |= (1uLL << i);
+                }
+            }
+        }
+
+        // Apply the live writes, deferring updates up to the next barrier
+        uint32_t run = 0u;
+        for (uint32_t i = 0u; i < length; ++i) {
+            if (live & (1uLL << i)) {
+                uint16_t address = writes[i].address;
+                uint8_t value = writes[i].value;
+                enum aymo_(wr_kind) kind = aymo_(wr_kind_of)(address);
+
+                if (kind == aymo_(wr_kind_barrier)) {
+                    aymo_(wr_flush)(chip);
+                    run = (i + 1u);
+                }
+                else if (kind == aymo_(wr_kind_last)) {
+                    aymo_(wr_collapse)(chip, &writes[run], (i - run), address, value);
+                }
+                aymo_(write_reg)(chip, address, value);
+            }
+        }
+
+        writes += length;
+        count -= length;
+    }
+
+    aymo_(wr_flush)(chip);
+    vsfence();
+}
+
+
+static
+void aymo_(load_shadow)(struct aymo_(chip)* chip, uint16_t address, uint8_t value)
+{
+    switch (address & 0xF0) {
+    case 0x00: {
+        switch (address) {
+        case 0x01: FORCE_BYTE(&(chip->chip_regs.reg_01h)) = value; break;
+        case 0x02: FORCE_BYTE(&(chip->chip_regs.reg_02h)) = value; break;
+        case 0x03: FORCE_BYTE(&(chip->chip_regs.reg_03h)) = value; break;
+        case 0x04: FORCE_BYTE(&(chip->chip_regs.reg_04h)) = value; break;
+        case 0x08: FORCE_BYTE(&(chip->chip_regs.reg_08h)) = value; break;
+        case 0x104: FORCE_BYTE(&(chip->chip_regs.reg_104h)) = value; break;
+        case 0x105: FORCE_BYTE(&(chip->chip_regs.reg_105h)) = value; break;
+        }
+        break;
+    }
+    case 0x20:
+    case 0x30: {
+        int slot = aymo_(addr_to_slot)(address);
+        FORCE_BYTE(&(chip->slot_regs[slot].reg_20h)) = value;
+        break;
+    }
+    case 0x40:
+    case 0x50: {
+        int slot = aymo_(addr_to_slot)(address);
+        FORCE_BYTE(&(chip->slot_regs[slot].reg_40h)) = value;
+        break;
+    }
+    case 0x60:
+    case 0x70: {
+        int slot = aymo_(addr_to_slot)(address);
+        FORCE_BYTE(&(chip->slot_regs[slot].reg_60h)) = value;
+        break;
+    }
+    case 0x80:
+    case 0x90: {
+        int slot = aymo_(addr_to_slot)(address);
+        FORCE_BYTE(&(chip->slot_regs[slot].reg_80h)) = value;
+        break;
+    }
+    case 0xE0:
+    case 0xF0: {
+        int slot = aymo_(addr_to_slot)(address);
+        struct aymo_ymf262_reg_E0h* reg_E0h = &(chip->slot_regs[slot].reg_E0h);
+        FORCE_BYTE(reg_E0h) = value;
+        if (chip->chip_regs.reg_105h.simd || (slot < AYMO_YMF262_SLOT_NUM)) {
+            if (!chip->chip_regs.reg_105h.newm) {
+                reg_E0h->ws &= 3;
+            }
+        }
+        break;
+    }
+    case 0xA0: {
+        int ch2x = aymo_(addr_to_ch2x)(address);
+        FORCE_BYTE(&(chip->ch2x_regs[ch2x].reg_A0h)) = value;
+        break;
+    }
+    case 0xB0: {
+        if (address == 0xBD) {
+            FORCE_BYTE(&(chip->chip_regs.reg_BDh)) = value;
+        }
+        else {
+            int ch2x = aymo_(addr_to_ch2x)(address);
+            FORCE_BYTE(&(chip->ch2x_regs[ch2x].reg_B0h)) = value;
+        }
+        break;
+    }
+    case 0xC0: {
+        if (!chip->chip_regs.reg_105h.newm) {
+            value = ((value & 0x0Fu) | 0x30u);
+        }
+        int ch2x = aymo_(addr_to_ch2x)(address);
+        FORCE_BYTE(&(chip->ch2x_regs[ch2x].reg_C0h)) = value;
+        break;
+    }
+    case 0xD0: {
+        int ch2x = aymo_(addr_to_ch2x)(address);
+        FORCE_BYTE(&(chip->ch2x_regs[ch2x].reg_D0h)) = value;
+        break;
+    }
+    }
+}
+
+
+// Rebuilds the derived state of a slot from its shadow registers
+static
+void aymo_(load_slot)(struct aymo_(chip)* chip, int slot)
+{
+    int word = aymo_ymf262_slot_to_word[slot];
+    int sgi = (word / AYMO_(SLOT_GROUP_LENGTH));
+    int sgo = (word % AYMO_(SLOT_GROUP_LENGTH));
+    struct aymo_(slot_group)* sg = &(chip->sg[sgi]);
+    const struct aymo_ymf262_slot_regs* slot_regs = &(chip->slot_regs[slot]);
+
+    int16_t pg_mult_x2 = aymo_ymf262_pg_mult_x2_table[slot_regs->reg_20h.mult];
+    vinsertv(sg->pg_mult_x2, pg_mult_x2, sgo);
+
+    int16_t pg_vib = -(int16_t)slot_regs->reg_20h.vib;
+    vinsertv(sg->pg_vib, pg_vib, sgo);
+
+    int16_t eg_am = -(int16_t)slot_regs->reg_20h.am;
+    vinsertv(sg->eg_am, eg_am, sgo);
+
+    int cgi = aymo_(sgi_to_cgi)(sgi);
+    int16_t eg_ksv = vextractv(chip->cg[cgi].eg_ksv, sgo);
+    int16_t eg_ks = (eg_ksv >> ((slot_regs->reg_20h.ksr ^ 1) << 1));
+    vinsertv(sg->eg_ks, eg_ks, sgo);
+
+    int16_t eg_adsr_word = 0;
+    struct aymo_(eg_adsr)* eg_adsr = (struct aymo_(eg_adsr)*)(void*)&eg_adsr_word;
+    eg_adsr->ar = slot_regs->reg_60h.ar;
+    eg_adsr->dr = slot_regs->reg_60h.dr;
+    eg_adsr->sr = (slot_regs->reg_20h.egt ? 0 : slot_regs->reg_80h.rr);
+    eg_adsr->rr = slot_regs->reg_80h.rr;
+    vinsertv(sg->eg_adsr, eg_adsr_word, sgo);
+
+    int16_t eg_sl = (int16_t)slot_regs->reg_80h.sl;
+    if (eg_sl == 0x0F) {
+        eg_sl = 0x1F;
+    }
+    vinsertv(sg->eg_sl, eg_sl, sgo);
+
+    const struct aymo_(wave)* wave = &aymo_(wave_table)[slot_regs->reg_E0h.ws];
+    vinsertv(sg->wg_phase_shl,   wave->wg_phase_shl,   sgo);
+    vinsertv(sg->wg_phase_zero,  wave->wg_phase_zero,  sgo);
+    vinsertv(sg->wg_phase_neg,   wave->wg_phase_neg,   sgo);
+    vinsertv(sg->wg_phase_flip,  wave->wg_phase_flip,  sgo);
+    vinsertv(sg->wg_phase_mask,  wave->wg_phase_mask,  sgo);
+    vinsertv(sg->wg_sine_gate,   wave->wg_sine_gate,   sgo);
+}
+
+
+// Rebuilds the output gates and feedback of a channel from its shadow registers
+static
+void aymo_(load_ch2x)(struct aymo_(chip)* chip, int ch2x)
+{
+    const struct aymo_ymf262_reg_C0h* reg_C0h = &(chip->ch2x_regs[ch2x].reg_C0h);
+    int ch2x_word0 = aymo_ymf262_ch2x_to_word[ch2x][0];
+    int ch2x_word1 = aymo_ymf262_ch2x_to_word[ch2x][1];
+    int sgo = (ch2x_word0 % AYMO_(SLOT_GROUP_LENGTH));
+    int sgi0 = (ch2x_word0 / AYMO_(SLOT_GROUP_LENGTH));
+    int sgi1 = (ch2x_word1 / AYMO_(SLOT_GROUP_LENGTH));
+    struct aymo_(slot_group)* sg0 = &chip->sg[sgi0];
+    struct aymo_(slot_group)* sg1 = &chip->sg[sgi1];
+    int cgi = aymo_(sgi_to_cgi)(sgi0);
+    struct aymo_(ch2x_group)* cg = &chip->cg[cgi];
+
+    vinsertv(cg->og_ch_gate_a, -(int16_t)reg_C0h->cha, sgo);
+    vinsertv(cg->og_ch_gate_b, -(int16_t)reg_C0h->chb, sgo);
+    vinsertv(cg->og_ch_gate_c, -(int16_t)reg_C0h->chc, sgo);
+    vinsertv(cg->og_ch_gate_d, -(int16_t)reg_C0h->chd, sgo);
+
+    // Outputs keep their current connection until rewired
+    vinsertv(sg0->og_out_ch_gate_a, (vextractv(sg0->og_out_gate, sgo) & -(int16_t)reg_C0h->cha), sgo);
+    vinsertv(sg0->og_out_ch_gate_b, (vextractv(sg0->og_out_gate, sgo) & -(int16_t)reg_C0h->chb), sgo);
+    vinsertv(sg0->og_out_ch_gate_c, (vextractv(sg0->og_out_gate, sgo) & -(int16_t)reg_C0h->chc), sgo);
+    vinsertv(sg0->og_out_ch_gate_d, (vextractv(sg0->og_out_gate, sgo) & -(int16_t)reg_C0h->chd), sgo);
+    vinsertv(sg1->og_out_ch_gate_a, (vextractv(sg1->og_out_gate, sgo) & -(int16_t)reg_C0h->cha), sgo);
+    vinsertv(sg1->og_out_ch_gate_b, (vextractv(sg1->og_out_gate, sgo) & -(int16_t)reg_C0h->chb), sgo);
+    vinsertv(sg1->og_out_ch_gate_c, (vextractv(sg1->og_out_gate, sgo) & -(int16_t)reg_C0h->chc), sgo);
+    vinsertv(sg1->og_out_ch_gate_d, (vextractv(sg1->og_out_gate, sgo) & -(int16_t)reg_C0h->chd), sgo);
+
+    int16_t fb_shs = (reg_C0h->fb ? -(int16_t)(9u - reg_C0h->fb) : +16);
+    vinsertv(sg0->wg_fb_shs, fb_shs, sgo);
+    vinsertv(sg1->wg_fb_shs, fb_shs, sgo);
+}
+
+
+// Rebuilds the frequency of a channel (and its 4-op pair) from its shadow registers
+static
+void aymo_(load_fnum)(struct aymo_(chip)* chip, int ch2x, int ch2p)
+{
+    struct aymo_ymf262_reg_A0h* reg_A0h = &(chip->ch2x_regs[ch2x].reg_A0h);
+    struct aymo_ymf262_reg_B0h* reg_B0h = &(chip->ch2x_regs[ch2x].reg_B0h);
+    struct aymo_ymf262_reg_08h* reg_08h = &(chip->chip_regs.reg_08h);
+    int16_t pg_fnum = (int16_t)(reg_A0h->fnum_lo | ((uint16_t)reg_B0h->fnum_hi << 8));
+    int16_t pg_block = (int16_t)reg_B0h->block;
+    int16_t eg_ksv = ((pg_block << 1) | ((pg_fnum >> (9 - reg_08h->nts)) & 1));
+
+    for (int i = 0; i < 2; ++i) {
+        int ch = (i ? ch2p : ch2x);
+        if (ch < 0) {
+            break;
+        }
+        int word0 = aymo_ymf262_ch2x_to_word[ch][0];
+        int word1 = aymo_ymf262_ch2x_to_word[ch][1];
+        int sgi0 = (word0 / AYMO_(SLOT_GROUP_LENGTH));
+        int sgi1 = (word1 / AYMO_(SLOT_GROUP_LENGTH));
+        int sgo = (word0 % AYMO_(SLOT_GROUP_LENGTH));
+        int cgi = aymo_(sgi_to_cgi)(sgi0);
+        struct aymo_(ch2x_group)* cg = &(chip->cg[cgi]);
+
+        vinsertv(cg->pg_block, pg_block, sgo);
+        vinsertv(cg->pg_fnum, pg_fnum, sgo);
+        vinsertv(cg->eg_ksv, eg_ksv, sgo);
+
+        int slot0 = aymo_ymf262_word_to_slot[word0];
+        int slot1 = aymo_ymf262_word_to_slot[word1];
+        int16_t ks0 = (eg_ksv >> ((chip->slot_regs[slot0].reg_20h.ksr ^ 1) << 1));
+        int16_t ks1 = (eg_ksv >> ((chip->slot_regs[slot1].reg_20h.ksr ^ 1) << 1));
+        vinsertv(chip->sg[sgi0].eg_ks, ks0, sgo);
+        vinsertv(chip->sg[sgi1].eg_ks, ks1, sgo);
+    }
+}
+
+
+void aymo_(load_registers)(
+    struct aymo_(chip)* chip,
+    const uint8_t regs[AYMO_YMF262_REG_NUM],
+    const uint8_t mask[AYMO_YMF262_REG_NUM / 8u]
+)
+{
+    assert(chip);
+    assert(regs);
+
+    struct aymo_ymf262_reg_08h reg_08h_prev = chip->chip_regs.reg_08h;
+    struct aymo_ymf262_reg_104h reg_104h_prev = chip->chip_regs.reg_104h;
+    struct aymo_ymf262_reg_BDh reg_BDh_prev = chip->chip_regs.reg_BDh;
+    uint32_t cnt_prev = 0u;
+    uint32_t kon_prev = 0u;
+    uint16_t fnum_prev[AYMO_(CHANNEL_NUM_MAX)];
+    for (int ch2x = 0; ch2x < AYMO_(CHANNEL_NUM_MAX); ++ch2x) {
+        const struct aymo_ymf262_chan_regs* ch2x_regs = &(chip->ch2x_regs[ch2x]);
+        cnt_prev |= ((uint32_t)ch2x_regs->reg_C0h.cnt << ch2x);
+        kon_prev |= ((uint32_t)ch2x_regs->reg_B0h.kon << ch2x);
+        fnum_prev[ch2x] = (uint16_t)(ch2x_regs->reg_A0h.fnum_lo | ((unsigned)ch2x_regs->reg_B0h.fnum_hi << 8) | ((unsigned)ch2x_regs->reg_B0h.block << 10));
+    }
+
+    // Store the register file, mode first
+    if (!mask || (mask[0x105 >> 3] & (1u << (0x105 & 7)))) {
+        aymo_(load_shadow)(chip, 0x105, regs[0x105]);
+    }
+    for (uint16_t address = 0u; address < AYMO_YMF262_REG_NUM; ++address) {
+        if ((!mask || (mask[address >> 3] & (1u << (address & 7)))) && (address != 0x105)) {
+            aymo_(load_shadow)(chip, address, regs[address]);
+        }
+        if ((address == 0x08) && (chip->chip_regs.reg_08h.nts != reg_08h_prev.nts)) {
+            aymo_(chip_pg_update_nts)(chip);  // before the new frequencies, as the writes would
+        }
+    }
+
+    const struct aymo_ymf262_chip_regs* chip_regs = &(chip->chip_regs);
+    int newm = chip_regs->reg_105h.newm;
+    int slot_num = (chip_regs->reg_105h.simd ? AYMO_(SLOT_NUM_MAX) : AYMO_YMF262_SLOT_NUM);
+    int ch2x_num = (chip_regs->reg_105h.simd ? AYMO_(CHANNEL_NUM_MAX) : AYMO_YMF262_CHANNEL_NUM);
+
+    // Rebuild the connection map
+    chip->og_ch2x_pairing = 0u;
+    for (int ch4x = 0; ch4x < (AYMO_(CHANNEL_NUM_MAX) / 2); ++ch4x) {
+        if (chip_regs->reg_104h.conn & (1 << ch4x)) {
+            int ch2x = aymo_ymf262_ch4x_to_pair[ch4x][0];
+            int ch2p = aymo_ymf262_ch4x_to_pair[ch4x][1];
+            chip->og_ch2x_pairing |= ((1uL << ch2x) | (1uL << ch2p));
+        }
+    }
+    chip->og_ch2x_drum = (chip_regs->reg_BDh.ryt ? 0x1C0u : 0u);
+
+    for (int slot = 0; slot < slot_num; ++slot) {
+        aymo_(load_slot)(chip, slot);
+    }
+    for (int ch2x = 0; ch2x < ch2x_num; ++ch2x) {
+        aymo_(load_ch2x)(chip, ch2x);
+    }
+
+    // Rewire as the writes would: on CNT and 4-op pairing changes, rhythm mode with the keys
+    uint32_t rewire_ch2x = 0u;
+    for (int ch2x = 0; ch2x < ch2x_num; ++ch2x) {
+        if (chip->ch2x_regs[ch2x].reg_C0h.cnt != ((cnt_prev >> ch2x) & 1u)) {
+            rewire_ch2x |= (1uL << ch2x);
+        }
+    }
+    for (int ch4x = 0; ch4x < (AYMO_(CHANNEL_NUM_MAX) / 2); ++ch4x) {
+        if ((chip_regs->reg_104h.conn ^ reg_104h_prev.conn) & (1 << ch4x)) {
+            rewire_ch2x |= (1uL << aymo_ymf262_ch4x_to_pair[ch4x][0]);
+            rewire_ch2x |= (1uL << aymo_ymf262_ch4x_to_pair[ch4x][1]);
+        }
+    }
+    while (rewire_ch2x) {
+        int ch2x = (uffsll(rewire_ch2x) - 1);
+        rewire_ch2x &= (rewire_ch2x - 1u);
+        aymo_(cm_rewire_ch2x)(chip, ch2x);
+    }
+
+    // Rebuild changed frequencies, with 4-op secondaries following their primaries
+    for (int ch2x = 0; ch2x < ch2x_num; ++ch2x) {
+        const struct aymo_ymf262_chan_regs* ch2x_regs = &(chip->ch2x_regs[ch2x]);
+        uint16_t fnum = (uint16_t)(ch2x_regs->reg_A0h.fnum_lo | ((unsigned)ch2x_regs->reg_B0h.fnum_hi << 8) | ((unsigned)ch2x_regs->reg_B0h.block << 10));
+        unsigned ch2x_is_pairing = (newm && (chip->og_ch2x_pairing & (1uL << ch2x)));
+        int ch2p = aymo_ymf262_ch2x_paired[ch2x];
+        int ch2x_is_secondary = (ch2p < ch2x);
+
+        if (!(ch2x_is_pairing && ch2x_is_secondary) && (fnum != fnum_prev[ch2x])) {
+            aymo_(load_fnum)(chip, ch2x, (ch2x_is_pairing ? ch2p : -1));
+        }
+    }
+    for (int slot = 0; slot < slot_num; ++slot) {
+        aymo_(eg_update_ksl)(chip, aymo_ymf262_slot_to_word[slot]);
+    }
+
+    // Rebuild keys as the writes would: on kon changes, with the previous rhythm mode until BDh
+    chip->og_ch2x_drum = (reg_BDh_prev.ryt ? 0x1C0u : 0u);
+    for (int ch2x = 0; ch2x < ch2x_num; ++ch2x) {
+        unsigned kon = chip->ch2x_regs[ch2x].reg_B0h.kon;
+        if (kon != ((kon_prev >> ch2x) & 1u)) {
+            if (kon) {
+                aymo_(ch2x_key_on)(chip, ch2x);
+            } else {
+                aymo_(ch2x_key_off)(chip, ch2x);
+            }
+        }
+    }
+    aymo_(cm_rewire_rhythm)(chip, reg_BDh_prev);
+
+    // Rebuild timers, tremolo before applying the new depth
+    aymo_(tm_update_tremolo)(chip);
+    if (chip_regs->reg_BDh.dam != reg_BDh_prev.dam) {
+        chip->eg_tremoloshift = (((chip_regs->reg_BDh.dam ^ 1) << 1) + 2);
+        chip->eg_tremoloreq = 1;
+    }
+    chip->eg_vibshift = (chip_regs->reg_BDh.dvb ^ 1);
+    aymo_(tm_update_vibrato)(chip);  // also updates all deltafreq
+
     vsfence();
 }
 
@@ -42,7 +42,9 @@ const struct aymo_ymf262_vt aymo_(vt) =
     (aymo_ymf262_generate_i16x2_f)&(aymo_(generate_i16x2)),
     (aymo_ymf262_generate_i16x4_f)&(aymo_(generate_i16x4)),
     (aymo_ymf262_generate_f32x2_f)&(aymo_(generate_f32x2)),
-    (aymo_ymf262_generate_f32x4_f)&(aymo_(generate_f32x4))
+    (aymo_ymf262_generate_f32x4_f)&(aymo_(generate_f32x4)),
+    (aymo_ymf262_load_registers_f)&(aymo_(load_registers)),
+    (aymo_ymf262_write_batch_f)&(aymo_(write_batch))
 };
 
 
@@ -184,4 +186,34 @@ void aymo_(generate_f32x4)(struct aymo_(chip)* chip, uint32_t count, float y[])
 }
 
 
+void aymo_(load_registers)(
+    struct aymo_(chip)* chip,
+    const uint8_t regs[AYMO_YMF262_REG_NUM],
+    const uint8_t mask[AYMO_YMF262_REG_NUM / 8u]
+)
+{
+    AYMO_UNUSED_VAR(chip);
+    AYMO_UNUSED_VAR(regs);
+    AYMO_UNUSED_VAR(mask);
+    assert(chip);
+
+    // not supported
+}
+
+
+void aymo_(write_batch)(
+    struct aymo_(chip)* chip,
+    const struct aymo_ymf262_reg_write writes[],
+    uint32_t count
+)
+{
+    AYMO_UNUSED_VAR(chip);
+    AYMO_UNUSED_VAR(writes);
+    AYMO_UNUSED_VAR(count);
+    assert(chip);
+
+    // not supported
+}
+
+
 AYMO_CXX_EXTERN_C_END
@@ -44,7 +44,9 @@ const struct aymo_ymf262_vt aymo_(vt) =
     (aymo_ymf262_generate_i16x2_f)&(aymo_(generate_i16x2)),
     (aymo_ymf262_generate_i16x4_f)&(aymo_(generate_i16x4)),
     (aymo_ymf262_generate_f32x2_f)&(aymo_(generate_f32x2)),
-    (aymo_ymf262_generate_f32x4_f)&(aymo_(generate_f32x4))
+    (aymo_ymf262_generate_f32x4_f)&(aymo_(generate_f32x4)),
+    (aymo_ymf262_load_registers_f)&(aymo_(load_registers)),
+    (aymo_ymf262_write_batch_f)&(aymo_(write_batch))
 };
 
 
@@ -202,4 +204,50 @@ void aymo_(generate_f32x4)(struct aymo_(chip)* chip, uint32_t count, float y[])
 }
 
 
+void aymo_(load_registers)(
+    struct aymo_(chip)* chip,
+    const uint8_t regs[AYMO_YMF262_REG_NUM],
+    const uint8_t mask[AYMO_YMF262_REG_NUM / 8u]
+)
+{
+    assert(chip);
+    assert(regs);
+
+    // Same order as the accelerated implementations: 105h, 104h, ..., BDh
+    static const uint16_t first[2] = { 0x105, 0x104 };
+    for (unsigned i = 0u; i < 2u; ++i) {
+        uint16_t address = first[i];
+        if (!mask || (mask[address >> 3] & (1u << (address & 7)))) {
+            OPL3_WriteReg(&chip->opl3, address, regs[address]);
+        }
+    }
+    for (uint16_t address = 0u; address < AYMO_YMF262_REG_NUM; ++address) {
+        if ((address != 0x105) && (address != 0x104) && (address != 0xBD)) {
+            if (!mask || (mask[address >> 3] & (1u << (address & 7)))) {
+                OPL3_WriteReg(&chip->opl3, address, regs[address]);
+            }
+        }
+    }
+    if (!mask || (mask[0xBD >> 3] & (1u << (0xBD & 7)))) {
+        OPL3_WriteReg(&chip->opl3, 0xBD, regs[0xBD]);
+    }
+}
+
+
+void aymo_(write_batch)(
+    struct aymo_(chip)* chip,
+    const struct aymo_ymf262_reg_write writes[],
+    uint32_t count
+)
+{
+    assert(chip);
+    assert(!count || writes);
+
+    while (count--) {
+        OPL3_WriteReg(&chip->opl3, writes->address, writes->value);
+        ++writes;
+    }
+}
+
+
 AYMO_CXX_EXTERN_C_END
@@ -0,0 +1,244 @@
+/*
+AYMO - Accelerated YaMaha Operator
+Copyright (c) 2023-2024 Andrea Zoppi.
+
+This file is part of AYMO.
+
+AYMO is free software: you can redistribute it and/or modify it under the
+terms of the GNU Lesser General Public License as published by the Free
+Software Foundation, either version 2.1 of the License, or (at your option)
+any later version.
+
+AYMO is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with AYMO. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "aymo.h"
+#include "aymo_adlibgold.h"
+#include "aymo_convert.h"
+#include "aymo_testing.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+AYMO_CXX_EXTERN_C_BEGIN
+
+
+#define FRAMES      4096u
+#define POOL_SIZE   (1u << 18)
+
+
+static int app_return;
+
+static AYMO_TDA8425_DEFINE_MATH_DEFAULT(tda8425_math);
+
+static uint8_t pool_a[POOL_SIZE] AYMO_ALIGN(AYMO_ADLIBGOLD_CHIP_ALIGN);
+static uint8_t pool_b[POOL_SIZE] AYMO_ALIGN(AYMO_ADLIBGOLD_CHIP_ALIGN);
+
+static float y_a[FRAMES * 2u];
+static float y_b[FRAMES * 2u];
+static int16_t y_i16_a[FRAMES * 2u];
+static int16_t y_i16_b[FRAMES * 2u];
+
+
+// Odd block sizes, to cover pending frames and multiple passes per call
+static const uint32_t block_sizes[] = { 1u, 7u, 256u, 3u, 257u, 2u, 511u, 64u, 1u, 1u };
+
+
+static struct aymo_adlibgold* setup(uint8_t* pool)
+{
+    aymo_boot();
+    aymo_ymf262_boot();
+    aymo_ym7128_boot();
+    aymo_tda8425_boot(&tda8425_math);
+
+    if (aymo_adlibgold_get_sizeof(NULL, NULL, NULL) > POOL_SIZE) {
+        return NULL;
+    }
+    struct aymo_adlibgold* ag = (struct aymo_adlibgold*)(void*)pool;
+    aymo_adlibgold_ctor(ag, NULL, NULL, NULL);
+
+    // YMF262: one sine note on channel 0, both outputs
+    static const uint16_t ymf262_regs[][2] = {
+        { 0x105u, 0x01u },
+        { 0x020u, 0x01u }, { 0x023u, 0x01u },
+        { 0x040u, 0x10u }, { 0x043u, 0x00u },
+        { 0x060u, 0xF0u }, { 0x063u, 0xF0u },
+        { 0x080u, 0x77u }, { 0x083u, 0x77u },
+        { 0x0C0u, 0x31u },
+        { 0x0A0u, 0x98u }, { 0x0B0u, 0x31u },
+    };
+    for (unsigned i = 0u; i < AYMO_VECTOR_LENGTH(ymf262_regs); ++i) {
+        aymo_adlibgold_write(ag, (uint16_t)(AYMO_ADLIBGOLD_ADDRESS_YMF262 + ymf262_regs[i][0]), (uint8_t)ymf262_regs[i][1]);
+    }
+
+    // YM7128: direct tap plus a short echo, with feedback
+    static const uint8_t ym7128_regs[AYMO_YM7128_REG_COUNT] = {
+        0x3F, 0x00, 0x2F, 0x00, 0x00, 0x00, 0x00, 0x00,  // GL1-GL8
+        0x3F, 0x00, 0x00, 0x2F, 0x00, 0x00, 0x00, 0x00,  // GR1-GR8
+        0x3F, 0x30,  // VM, VC
+        0x3F, 0x3F,  // VL, VR
+        0x20, 0x10,  // C0, C1
+        0x08, 0x00, 0x04, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00  // T0-T8
+    };
+    for (unsigned i = 0u; i < AYMO_YM7128_REG_COUNT; ++i) {
+        aymo_adlibgold_write(ag, (uint16_t)(AYMO_ADLIBGOLD_ADDRESS_YM7128 + i), ym7128_regs[i]);
+    }
+
+    // TDA8425: some bass and treble
+    aymo_adlibgold_write(ag, (AYMO_ADLIBGOLD_ADDRESS_TDA8425 + 0x02u), 0xF9u);
+    aymo_adlibgold_write(ag, (AYMO_ADLIBGOLD_ADDRESS_TDA8425 + 0x03u), 0xF3u);
+
+    return ag;
+}
+
+
+void test_aymo_adlibgold_split(void)
+{
+    struct aymo_adlibgold* ag_a = setup(pool_a);
+    struct aymo_adlibgold* ag_b = setup(pool_b);
+    if (!ag_a || !ag_b) {
+        app_return = TEST_STATUS_SKIP;
+        return;
+    }
+
+    aymo_adlibgold_generate_f32x2(ag_a, FRAMES, y_a);
+
+    uint32_t n = 0u;
+    for (unsigned j = 0u; n < FRAMES; ++j) {
+        uint32_t count = block_sizes[j % AYMO_VECTOR_LENGTH(block_sizes)];
+        if (count > (FRAMES - n)) {
+            count = (FRAMES - n);
+        }
+        aymo_adlibgold_generate_f32x2(ag_b, count, &y_b[n * 2u]);
+        n += count;
+    }
+
+    for (n = 0u; n < FRAMES; ++n) {
+        if (memcmp(&y_a[n * 2u], &y_b[n * 2u], (2u * sizeof(float)))) {
+            app_return = TEST_STATUS_FAIL;
+            fprintf(stderr, "%s: mismatch at frame %u\n", __func__, n);
+            break;
+        }
+    }
+
+    aymo_adlibgold_dtor(ag_a);
+    aymo_adlibgold_dtor(ag_b);
+}
+
+
+void test_aymo_adlibgold_i16(void)
+{
+    struct aymo_adlibgold* ag_a = setup(pool_a);
+    struct aymo_adlibgold* ag_b = setup(pool_b);
+    if (!ag_a || !ag_b) {
+        app_return = TEST_STATUS_SKIP;
+        return;
+    }
+
+    aymo_adlibgold_generate_f32x2(ag_a, FRAMES, y_a);
+    aymo_convert_f32_i16_1((FRAMES * 2u), y_a, y_i16_a);
+
+    uint32_t n = 0u;
+    for (unsigned j = 0u; n < FRAMES; ++j) {
+        uint32_t count = block_sizes[j % AYMO_VECTOR_LENGTH(block_sizes)];
+        if (count > (FRAMES - n)) {
+            count = (FRAMES - n);
+        }
+        aymo_adlibgold_generate_i16x2(ag_b, count, &y_i16_b[n * 2u]);
+        n += count;
+    }
+
+    if (memcmp(y_i16_a, y_i16_b, sizeof(y_i16_a))) {
+        app_return = TEST_STATUS_FAIL;
+        fprintf(stderr, "%s: mismatch\n", __func__);
+    }
+
+    aymo_adlibgold_dtor(ag_a);
+    aymo_adlibgold_dtor(ag_b);
+}
+
+
+void test_aymo_adlibgold_route(void)
+{
+    struct aymo_adlibgold* ag = setup(pool_a);
+    if (!ag) {
+        app_return = TEST_STATUS_SKIP;
+        return;
+    }
+
+    for (uint16_t a = 0u; a < AYMO_YM7128_REG_COUNT; ++a) {
+        uint8_t value = (uint8_t)((a * 7u) & 0x1Fu);
+        aymo_adlibgold_write(ag, (uint16_t)(AYMO_ADLIBGOLD_ADDRESS_YM7128 + a), value);
+        if ((aymo_adlibgold_read(ag, (uint16_t)(AYMO_ADLIBGOLD_ADDRESS_YM7128 + a)) != value) ||
+            (aymo_ym7128_read(ag->ym7128, a) != value)) {
+            app_return = TEST_STATUS_FAIL;
+            fprintf(stderr, "%s: YM7128 register 0x%02X\n", __func__, (unsigned)a);
+        }
+    }
+
+    aymo_adlibgold_write(ag, (AYMO_ADLIBGOLD_ADDRESS_TDA8425 + 0x00u), 0xF0u);
+    if ((aymo_adlibgold_read(ag, (AYMO_ADLIBGOLD_ADDRESS_TDA8425 + 0x00u)) != 0xF0u) ||
+        (aymo_tda8425_read(ag->tda8425, 0x00u) != 0xF0u)) {
+        app_return = TEST_STATUS_FAIL;
+        fprintf(stderr, "%s: TDA8425 register 0x00\n", __func__);
+    }
+
+    // Unmapped addresses are ignored
+    aymo_adlibgold_write(ag, AYMO_ADLIBGOLD_ADDRESS_END, 0xFFu);
+    if (aymo_adlibgold_read(ag, AYMO_ADLIBGOLD_ADDRESS_END) != 0x00u) {
+        app_return = TEST_STATUS_FAIL;
+        fprintf(stderr, "%s: unmapped address\n", __func__);
+    }
+
+    aymo_adlibgold_dtor(ag);
+}
+
+
+void test_aymo_adlibgold_mix(void)
+{
+    struct aymo_adlibgold* ag_a = setup(pool_a);
+    struct aymo_adlibgold* ag_b = setup(pool_b);
+    if (!ag_a || !ag_b) {
+        app_return = TEST_STATUS_SKIP;
+        return;
+    }
+
+    // The note reaches the output, and muting both paths silences it
+    aymo_adlibgold_generate_f32x2(ag_a, FRAMES, y_a);
+    aymo_adlibgold_set_mix(ag_b, 0.f, 0.f);
+    aymo_adlibgold_generate_f32x2(ag_b, FRAMES, y_b);
+
+    double energy_a = 0.;
+    double energy_b = 0.;
+    for (uint32_t i = 0u; i < (FRAMES * 2u); ++i) {
+        energy_a += ((double)y_a[i] * (double)y_a[i]);
+        energy_b += ((double)y_b[i] * (double)y_b[i]);
+    }
+    if (!(energy_a > 1.) || (energy_b != 0.)) {
+        app_return = TEST_STATUS_FAIL;
+        fprintf(stderr, "%s: energy_a=%g, energy_b=%g\n", __func__, energy_a, energy_b);
+    }
+
+    aymo_adlibgold_dtor(ag_a);
+    aymo_adlibgold_dtor(ag_b);
+}
+
+
+struct aymo_testing_entry unit_tests[] =
+{
+    AYMO_TEST_ENTRY(test_aymo_adlibgold_split),
+    AYMO_TEST_ENTRY(test_aymo_adlibgold_i16),
+    AYMO_TEST_ENTRY(test_aymo_adlibgold_route),
+    AYMO_TEST_ENTRY(test_aymo_adlibgold_mix)
+};
+
+
+#include "aymo_testing_epilogue_inline.h"
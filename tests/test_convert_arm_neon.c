@@ -353,6 +353,126 @@ error_:
 }
 
 
+void test_aymo_convert_arm_neon_i16x2_f32x2_k(void)
+{
+    unsigned si, ei; int line = 0;
+    for (si = 0; si < ref_n2; ++si) {
+        for (ei = si; ei < ref_n2; ++ei) {
+            memset(buf_f32l, (int)DIRTY, sizeof(buf_f32l));
+            memset(buf_f32r, (int)DIRTY, sizeof(buf_f32r));
+            aymo_(i16x2_f32x2_k)((ei - si), &src_i16[si * 2u], &buf_f32l[si], &buf_f32r[si], (float)(1. / K));
+            if (compare_dirty(&buf_f32l[0], DIRTY, (si * sizeof(buf_f32l[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_f32r[0], DIRTY, (si * sizeof(buf_f32r[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_f32(&buf_f32l[si], &ref_i16x2_f32l_1[si], (ei - si), 0)) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_f32(&buf_f32r[si], &ref_i16x2_f32r_1[si], (ei - si), 0)) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_f32l[ei], DIRTY, ((ref_n2 - ei) * sizeof(buf_f32l[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_f32r[ei], DIRTY, ((ref_n2 - ei) * sizeof(buf_f32r[0])))) {
+                line = __LINE__; goto error_;
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  si=%u, ei=%u\n", __func__, line, si, ei);
+    print_f32(stderr, buf_f32l, ref_n2);
+    print_f32(stderr, ref_i16x2_f32l_1, ref_n2);
+    print_f32(stderr, buf_f32r, ref_n2);
+    print_f32(stderr, ref_i16x2_f32r_1, ref_n2);
+}
+
+
+void test_aymo_convert_arm_neon_f32x2_i16x2_k(void)
+{
+    unsigned si, ei; int line = 0;
+    for (si = 0; si < ref_n2; ++si) {
+        for (ei = si; ei < ref_n2; ++ei) {
+            memset(buf_i16, (int)DIRTY, sizeof(buf_i16));
+            aymo_(f32x2_i16x2_k)((ei - si), &src_f32l_1[si], &src_f32r_1[si], &buf_i16[si * 2u], (float)(K));
+            if (compare_dirty(&buf_i16[0], DIRTY, (si * 2u * sizeof(buf_i16[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_i16(&buf_i16[si * 2u], &ref_f32_i16_1[si * 2u], ((ei - si) * 2u))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_i16[ei * 2u], DIRTY, ((ref_n2 - ei) * 2u * sizeof(buf_i16[0])))) {
+                line = __LINE__; goto error_;
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  si=%u, ei=%u\n", __func__, line, si, ei);
+    print_i16(stderr, buf_i16, ref_n);
+    print_i16(stderr, ref_f32_i16_1, ref_n);
+}
+
+
+void test_aymo_convert_arm_neon_i16x4_i16x2_k(void)
+{
+    unsigned si, ei; int line = 0;
+    for (si = 0; si < ref_n4; ++si) {
+        for (ei = si; ei < ref_n4; ++ei) {
+            memset(buf_i16, (int)DIRTY, sizeof(buf_i16));
+            aymo_(i16x4_i16x2_k)((ei - si), &src_i16[si * 4u], &buf_i16[si * 2u], k_i16x4);
+            if (compare_dirty(&buf_i16[0], DIRTY, (si * 2u * sizeof(buf_i16[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_i16(&buf_i16[si * 2u], &ref_i16x4_i16x2[si * 2u], ((ei - si) * 2u))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_i16[ei * 2u], DIRTY, ((ref_n - (ei * 2u)) * sizeof(buf_i16[0])))) {
+                line = __LINE__; goto error_;
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  si=%u, ei=%u\n", __func__, line, si, ei);
+    print_i16(stderr, buf_i16, ref_n2);
+    print_i16(stderr, ref_i16x4_i16x2, ref_n2);
+}
+
+
+void test_aymo_convert_arm_neon_i16x4_f32x2_k(void)
+{
+    unsigned si, ei; int line = 0;
+    for (si = 0; si < ref_n4; ++si) {
+        for (ei = si; ei < ref_n4; ++ei) {
+            memset(buf_f32, (int)DIRTY, sizeof(buf_f32));
+            aymo_(i16x4_f32x2_k)((ei - si), &src_i16[si * 4u], &buf_f32[si * 2u], k_i16x4);
+            if (compare_dirty(&buf_f32[0], DIRTY, (si * 2u * sizeof(buf_f32[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_f32(&buf_f32[si * 2u], &ref_i16x4_f32x2[si * 2u], ((ei - si) * 2u), 0)) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_f32[ei * 2u], DIRTY, ((ref_n - (ei * 2u)) * sizeof(buf_f32[0])))) {
+                line = __LINE__; goto error_;
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  si=%u, ei=%u\n", __func__, line, si, ei);
+    print_f32(stderr, buf_f32, ref_n2);
+    print_f32(stderr, ref_i16x4_f32x2, ref_n2);
+}
+
+
 struct aymo_testing_entry unit_tests[] =
 {
     AYMO_TEST_ENTRY(test_aymo_convert_arm_neon_i16_f32),
@@ -366,7 +486,11 @@ struct aymo_testing_entry unit_tests[] =
     AYMO_TEST_ENTRY(test_aymo_convert_arm_neon_u16_f32_1),
     AYMO_TEST_ENTRY(test_aymo_convert_arm_neon_f32_u16_1),
     AYMO_TEST_ENTRY(test_aymo_convert_arm_neon_u16_f32_k),
-    AYMO_TEST_ENTRY(test_aymo_convert_arm_neon_f32_u16_k)
+    AYMO_TEST_ENTRY(test_aymo_convert_arm_neon_f32_u16_k),
+    AYMO_TEST_ENTRY(test_aymo_convert_arm_neon_i16x2_f32x2_k),
+    AYMO_TEST_ENTRY(test_aymo_convert_arm_neon_f32x2_i16x2_k),
+    AYMO_TEST_ENTRY(test_aymo_convert_arm_neon_i16x4_i16x2_k),
+    AYMO_TEST_ENTRY(test_aymo_convert_arm_neon_i16x4_f32x2_k)
 };
 
 
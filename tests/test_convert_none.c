@@ -351,6 +351,962 @@ error_:
 }
 
 
+void test_aymo_convert_none_i8_f32(void)
+{
+    unsigned si, ei; int line = 0;
+    for (si = 0; si < ref_n; ++si) {
+        for (ei = si; ei < ref_n; ++ei) {
+            memset(buf_f32, (int)DIRTY, sizeof(buf_f32));
+            aymo_(i8_f32)((ei - si), &src_i8[si], &buf_f32[si]);
+            if (compare_dirty(&buf_f32[0], DIRTY, (si * sizeof(buf_f32[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_f32(&buf_f32[si], &ref_i8_f32[si], (ei - si), 0)) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_f32[ei], DIRTY, ((ref_n - ei) * sizeof(buf_f32[0])))) {
+                line = __LINE__; goto error_;
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  si=%u, ei=%u\n", __func__, line, si, ei);
+    print_f32(stderr, buf_f32, ref_n);
+    print_f32(stderr, ref_i8_f32, ref_n);
+}
+
+
+void test_aymo_convert_none_f32_i8(void)
+{
+    unsigned si, ei; int line = 0;
+    for (si = 0; si < ref_n; ++si) {
+        for (ei = si; ei < ref_n; ++ei) {
+            memset(buf_i8, (int)DIRTY, sizeof(buf_i8));
+            aymo_(f32_i8)((ei - si), &src_f32[si], &buf_i8[si]);
+            if (compare_dirty(&buf_i8[0], DIRTY, (si * sizeof(buf_i8[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_i8(&buf_i8[si], &ref_f32_i8[si], (ei - si))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_i8[ei], DIRTY, ((ref_n - ei) * sizeof(buf_i8[0])))) {
+                line = __LINE__; goto error_;
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  si=%u, ei=%u\n", __func__, line, si, ei);
+    print_i8(stderr, buf_i8, ref_n);
+    print_i8(stderr, ref_f32_i8, ref_n);
+}
+
+
+void test_aymo_convert_none_i8_f32_1(void)
+{
+    unsigned si, ei; int line = 0;
+    for (si = 0; si < ref_n; ++si) {
+        for (ei = si; ei < ref_n; ++ei) {
+            memset(buf_f32, (int)DIRTY, sizeof(buf_f32));
+            aymo_(i8_f32_1)((ei - si), &src_i8[si], &buf_f32[si]);
+            if (compare_dirty(&buf_f32[0], DIRTY, (si * sizeof(buf_f32[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_f32(&buf_f32[si], &ref_i8_f32_1[si], (ei - si), 0)) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_f32[ei], DIRTY, ((ref_n - ei) * sizeof(buf_f32[0])))) {
+                line = __LINE__; goto error_;
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  si=%u, ei=%u\n", __func__, line, si, ei);
+    print_f32(stderr, buf_f32, ref_n);
+    print_f32(stderr, ref_i8_f32_1, ref_n);
+}
+
+
+void test_aymo_convert_none_f32_i8_1(void)
+{
+    unsigned si, ei; int line = 0;
+    for (si = 0; si < ref_n; ++si) {
+        for (ei = si; ei < ref_n; ++ei) {
+            memset(buf_i8, (int)DIRTY, sizeof(buf_i8));
+            aymo_(f32_i8_1)((ei - si), &src_f32_i8_1[si], &buf_i8[si]);
+            if (compare_dirty(&buf_i8[0], DIRTY, (si * sizeof(buf_i8[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_i8(&buf_i8[si], &ref_f32_i8_1[si], (ei - si))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_i8[ei], DIRTY, ((ref_n - ei) * sizeof(buf_i8[0])))) {
+                line = __LINE__; goto error_;
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  si=%u, ei=%u\n", __func__, line, si, ei);
+    print_i8(stderr, buf_i8, ref_n);
+    print_i8(stderr, ref_f32_i8_1, ref_n);
+}
+
+
+void test_aymo_convert_none_i8_f32_k(void)
+{
+    unsigned si, ei; int line = 0;
+    for (si = 0; si < ref_n; ++si) {
+        for (ei = si; ei < ref_n; ++ei) {
+            memset(buf_f32, (int)DIRTY, sizeof(buf_f32));
+            aymo_(i8_f32_k)((ei - si), &src_i8[si], &buf_f32[si], (float)(1. / K8));
+            if (compare_dirty(&buf_f32[0], DIRTY, (si * sizeof(buf_f32[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_f32(&buf_f32[si], &ref_i8_f32_1[si], (ei - si), 0)) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_f32[ei], DIRTY, ((ref_n - ei) * sizeof(buf_f32[0])))) {
+                line = __LINE__; goto error_;
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  si=%u, ei=%u\n", __func__, line, si, ei);
+    print_f32(stderr, buf_f32, ref_n);
+    print_f32(stderr, ref_i8_f32_1, ref_n);
+}
+
+
+void test_aymo_convert_none_f32_i8_k(void)
+{
+    unsigned si, ei; int line = 0;
+    for (si = 0; si < ref_n; ++si) {
+        for (ei = si; ei < ref_n; ++ei) {
+            memset(buf_i8, (int)DIRTY, sizeof(buf_i8));
+            aymo_(f32_i8_k)((ei - si), &src_f32_i8_1[si], &buf_i8[si], (float)(K8));
+            if (compare_dirty(&buf_i8[0], DIRTY, (si * sizeof(buf_i8[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_i8(&buf_i8[si], &ref_f32_i8_1[si], (ei - si))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_i8[ei], DIRTY, ((ref_n - ei) * sizeof(buf_i8[0])))) {
+                line = __LINE__; goto error_;
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  si=%u, ei=%u\n", __func__, line, si, ei);
+    print_i8(stderr, buf_i8, ref_n);
+    print_i8(stderr, ref_f32_i8_1, ref_n);
+}
+
+
+void test_aymo_convert_none_u8_f32(void)
+{
+    unsigned si, ei; int line = 0;
+    for (si = 0; si < ref_n; ++si) {
+        for (ei = si; ei < ref_n; ++ei) {
+            memset(buf_f32, (int)DIRTY, sizeof(buf_f32));
+            aymo_(u8_f32)((ei - si), &src_u8[si], &buf_f32[si]);
+            if (compare_dirty(&buf_f32[0], DIRTY, (si * sizeof(buf_f32[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_f32(&buf_f32[si], &ref_u8_f32[si], (ei - si), 0)) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_f32[ei], DIRTY, ((ref_n - ei) * sizeof(buf_f32[0])))) {
+                line = __LINE__; goto error_;
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  si=%u, ei=%u\n", __func__, line, si, ei);
+    print_f32(stderr, buf_f32, ref_n);
+    print_f32(stderr, ref_u8_f32, ref_n);
+}
+
+
+void test_aymo_convert_none_f32_u8(void)
+{
+    unsigned si, ei; int line = 0;
+    for (si = 0; si < ref_n; ++si) {
+        for (ei = si; ei < ref_n; ++ei) {
+            memset(buf_u8, (int)DIRTY, sizeof(buf_u8));
+            aymo_(f32_u8)((ei - si), &src_f32[si], &buf_u8[si]);
+            if (compare_dirty(&buf_u8[0], DIRTY, (si * sizeof(buf_u8[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_u8(&buf_u8[si], &ref_f32_u8[si], (ei - si))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_u8[ei], DIRTY, ((ref_n - ei) * sizeof(buf_u8[0])))) {
+                line = __LINE__; goto error_;
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  si=%u, ei=%u\n", __func__, line, si, ei);
+    print_u8(stderr, buf_u8, ref_n);
+    print_u8(stderr, ref_f32_u8, ref_n);
+}
+
+
+void test_aymo_convert_none_u8_f32_1(void)
+{
+    unsigned si, ei; int line = 0;
+    for (si = 0; si < ref_n; ++si) {
+        for (ei = si; ei < ref_n; ++ei) {
+            memset(buf_f32, (int)DIRTY, sizeof(buf_f32));
+            aymo_(u8_f32_1)((ei - si), &src_u8[si], &buf_f32[si]);
+            if (compare_dirty(&buf_f32[0], DIRTY, (si * sizeof(buf_f32[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_f32(&buf_f32[si], &ref_u8_f32_1[si], (ei - si), 0)) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_f32[ei], DIRTY, ((ref_n - ei) * sizeof(buf_f32[0])))) {
+                line = __LINE__; goto error_;
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  si=%u, ei=%u\n", __func__, line, si, ei);
+    print_f32(stderr, buf_f32, ref_n);
+    print_f32(stderr, ref_u8_f32_1, ref_n);
+}
+
+
+void test_aymo_convert_none_f32_u8_1(void)
+{
+    unsigned si, ei; int line = 0;
+    for (si = 0; si < ref_n; ++si) {
+        for (ei = si; ei < ref_n; ++ei) {
+            memset(buf_u8, (int)DIRTY, sizeof(buf_u8));
+            aymo_(f32_u8_1)((ei - si), &src_f32_u8_1[si], &buf_u8[si]);
+            if (compare_dirty(&buf_u8[0], DIRTY, (si * sizeof(buf_u8[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_u8(&buf_u8[si], &ref_f32_u8_1[si], (ei - si))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_u8[ei], DIRTY, ((ref_n - ei) * sizeof(buf_u8[0])))) {
+                line = __LINE__; goto error_;
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  si=%u, ei=%u\n", __func__, line, si, ei);
+    print_u8(stderr, buf_u8, ref_n);
+    print_u8(stderr, ref_f32_u8_1, ref_n);
+}
+
+
+void test_aymo_convert_none_u8_f32_k(void)
+{
+    unsigned si, ei; int line = 0;
+    for (si = 0; si < ref_n; ++si) {
+        for (ei = si; ei < ref_n; ++ei) {
+            memset(buf_f32, (int)DIRTY, sizeof(buf_f32));
+            aymo_(u8_f32_k)((ei - si), &src_u8[si], &buf_f32[si], (float)(1. / K8));
+            if (compare_dirty(&buf_f32[0], DIRTY, (si * sizeof(buf_f32[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_f32(&buf_f32[si], &ref_u8_f32_1[si], (ei - si), 0)) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_f32[ei], DIRTY, ((ref_n - ei) * sizeof(buf_f32[0])))) {
+                line = __LINE__; goto error_;
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  si=%u, ei=%u\n", __func__, line, si, ei);
+    print_f32(stderr, buf_f32, ref_n);
+    print_f32(stderr, ref_u8_f32_1, ref_n);
+}
+
+
+void test_aymo_convert_none_f32_u8_k(void)
+{
+    unsigned si, ei; int line = 0;
+    for (si = 0; si < ref_n; ++si) {
+        for (ei = si; ei < ref_n; ++ei) {
+            memset(buf_u8, (int)DIRTY, sizeof(buf_u8));
+            aymo_(f32_u8_k)((ei - si), &src_f32_u8_1[si], &buf_u8[si], (float)(K8));
+            if (compare_dirty(&buf_u8[0], DIRTY, (si * sizeof(buf_u8[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_u8(&buf_u8[si], &ref_f32_u8_1[si], (ei - si))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_u8[ei], DIRTY, ((ref_n - ei) * sizeof(buf_u8[0])))) {
+                line = __LINE__; goto error_;
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  si=%u, ei=%u\n", __func__, line, si, ei);
+    print_u8(stderr, buf_u8, ref_n);
+    print_u8(stderr, ref_f32_u8_1, ref_n);
+}
+
+
+void test_aymo_convert_none_i24_f32(void)
+{
+    unsigned si, ei; int line = 0;
+    for (si = 0; si < ref_n; ++si) {
+        for (ei = si; ei < ref_n; ++ei) {
+            memset(buf_f32, (int)DIRTY, sizeof(buf_f32));
+            aymo_(i24_f32)((ei - si), &src_i24[(si * 3u)], &buf_f32[si]);
+            if (compare_dirty(&buf_f32[0], DIRTY, (si * sizeof(buf_f32[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_f32(&buf_f32[si], &ref_i24_f32[si], (ei - si), 0)) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_f32[ei], DIRTY, ((ref_n - ei) * sizeof(buf_f32[0])))) {
+                line = __LINE__; goto error_;
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  si=%u, ei=%u\n", __func__, line, si, ei);
+    print_f32(stderr, buf_f32, ref_n);
+    print_f32(stderr, ref_i24_f32, ref_n);
+}
+
+
+void test_aymo_convert_none_f32_i24(void)
+{
+    unsigned si, ei; int line = 0;
+    for (si = 0; si < ref_n; ++si) {
+        for (ei = si; ei < ref_n; ++ei) {
+            memset(buf_i24, (int)DIRTY, sizeof(buf_i24));
+            aymo_(f32_i24)((ei - si), &src_f32[si], &buf_i24[(si * 3u)]);
+            if (compare_dirty(&buf_i24[0], DIRTY, ((si * 3u) * sizeof(buf_i24[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_u8(&buf_i24[(si * 3u)], &ref_f32_i24[(si * 3u)], ((ei - si) * 3u))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_i24[(ei * 3u)], DIRTY, (((ref_n - ei) * 3u) * sizeof(buf_i24[0])))) {
+                line = __LINE__; goto error_;
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  si=%u, ei=%u\n", __func__, line, si, ei);
+    print_u8(stderr, buf_i24, (ref_n * 3u));
+    print_u8(stderr, ref_f32_i24, (ref_n * 3u));
+}
+
+
+void test_aymo_convert_none_i24_f32_1(void)
+{
+    unsigned si, ei; int line = 0;
+    for (si = 0; si < ref_n; ++si) {
+        for (ei = si; ei < ref_n; ++ei) {
+            memset(buf_f32, (int)DIRTY, sizeof(buf_f32));
+            aymo_(i24_f32_1)((ei - si), &src_i24[(si * 3u)], &buf_f32[si]);
+            if (compare_dirty(&buf_f32[0], DIRTY, (si * sizeof(buf_f32[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_f32(&buf_f32[si], &ref_i24_f32_1[si], (ei - si), 0)) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_f32[ei], DIRTY, ((ref_n - ei) * sizeof(buf_f32[0])))) {
+                line = __LINE__; goto error_;
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  si=%u, ei=%u\n", __func__, line, si, ei);
+    print_f32(stderr, buf_f32, ref_n);
+    print_f32(stderr, ref_i24_f32_1, ref_n);
+}
+
+
+void test_aymo_convert_none_f32_i24_1(void)
+{
+    unsigned si, ei; int line = 0;
+    for (si = 0; si < ref_n; ++si) {
+        for (ei = si; ei < ref_n; ++ei) {
+            memset(buf_i24, (int)DIRTY, sizeof(buf_i24));
+            aymo_(f32_i24_1)((ei - si), &src_f32_i24_1[si], &buf_i24[(si * 3u)]);
+            if (compare_dirty(&buf_i24[0], DIRTY, ((si * 3u) * sizeof(buf_i24[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_u8(&buf_i24[(si * 3u)], &ref_f32_i24_1[(si * 3u)], ((ei - si) * 3u))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_i24[(ei * 3u)], DIRTY, (((ref_n - ei) * 3u) * sizeof(buf_i24[0])))) {
+                line = __LINE__; goto error_;
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  si=%u, ei=%u\n", __func__, line, si, ei);
+    print_u8(stderr, buf_i24, (ref_n * 3u));
+    print_u8(stderr, ref_f32_i24_1, (ref_n * 3u));
+}
+
+
+void test_aymo_convert_none_i24_f32_k(void)
+{
+    unsigned si, ei; int line = 0;
+    for (si = 0; si < ref_n; ++si) {
+        for (ei = si; ei < ref_n; ++ei) {
+            memset(buf_f32, (int)DIRTY, sizeof(buf_f32));
+            aymo_(i24_f32_k)((ei - si), &src_i24[(si * 3u)], &buf_f32[si], (float)(1. / K24));
+            if (compare_dirty(&buf_f32[0], DIRTY, (si * sizeof(buf_f32[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_f32(&buf_f32[si], &ref_i24_f32_1[si], (ei - si), 0)) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_f32[ei], DIRTY, ((ref_n - ei) * sizeof(buf_f32[0])))) {
+                line = __LINE__; goto error_;
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  si=%u, ei=%u\n", __func__, line, si, ei);
+    print_f32(stderr, buf_f32, ref_n);
+    print_f32(stderr, ref_i24_f32_1, ref_n);
+}
+
+
+void test_aymo_convert_none_f32_i24_k(void)
+{
+    unsigned si, ei; int line = 0;
+    for (si = 0; si < ref_n; ++si) {
+        for (ei = si; ei < ref_n; ++ei) {
+            memset(buf_i24, (int)DIRTY, sizeof(buf_i24));
+            aymo_(f32_i24_k)((ei - si), &src_f32_i24_1[si], &buf_i24[(si * 3u)], (float)(K24));
+            if (compare_dirty(&buf_i24[0], DIRTY, ((si * 3u) * sizeof(buf_i24[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_u8(&buf_i24[(si * 3u)], &ref_f32_i24_1[(si * 3u)], ((ei - si) * 3u))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_i24[(ei * 3u)], DIRTY, (((ref_n - ei) * 3u) * sizeof(buf_i24[0])))) {
+                line = __LINE__; goto error_;
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  si=%u, ei=%u\n", __func__, line, si, ei);
+    print_u8(stderr, buf_i24, (ref_n * 3u));
+    print_u8(stderr, ref_f32_i24_1, (ref_n * 3u));
+}
+
+
+void test_aymo_convert_none_i32_f32(void)
+{
+    unsigned si, ei; int line = 0;
+    for (si = 0; si < ref_n; ++si) {
+        for (ei = si; ei < ref_n; ++ei) {
+            memset(buf_f32, (int)DIRTY, sizeof(buf_f32));
+            aymo_(i32_f32)((ei - si), &src_i32[si], &buf_f32[si]);
+            if (compare_dirty(&buf_f32[0], DIRTY, (si * sizeof(buf_f32[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_f32(&buf_f32[si], &ref_i32_f32[si], (ei - si), 0)) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_f32[ei], DIRTY, ((ref_n - ei) * sizeof(buf_f32[0])))) {
+                line = __LINE__; goto error_;
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  si=%u, ei=%u\n", __func__, line, si, ei);
+    print_f32(stderr, buf_f32, ref_n);
+    print_f32(stderr, ref_i32_f32, ref_n);
+}
+
+
+void test_aymo_convert_none_f32_i32(void)
+{
+    unsigned si, ei; int line = 0;
+    for (si = 0; si < ref_n; ++si) {
+        for (ei = si; ei < ref_n; ++ei) {
+            memset(buf_i32, (int)DIRTY, sizeof(buf_i32));
+            aymo_(f32_i32)((ei - si), &src_f32[si], &buf_i32[si]);
+            if (compare_dirty(&buf_i32[0], DIRTY, (si * sizeof(buf_i32[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_i32(&buf_i32[si], &ref_f32_i32[si], (ei - si))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_i32[ei], DIRTY, ((ref_n - ei) * sizeof(buf_i32[0])))) {
+                line = __LINE__; goto error_;
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  si=%u, ei=%u\n", __func__, line, si, ei);
+    print_i32(stderr, buf_i32, ref_n);
+    print_i32(stderr, ref_f32_i32, ref_n);
+}
+
+
+void test_aymo_convert_none_i32_f32_1(void)
+{
+    unsigned si, ei; int line = 0;
+    for (si = 0; si < ref_n; ++si) {
+        for (ei = si; ei < ref_n; ++ei) {
+            memset(buf_f32, (int)DIRTY, sizeof(buf_f32));
+            aymo_(i32_f32_1)((ei - si), &src_i32[si], &buf_f32[si]);
+            if (compare_dirty(&buf_f32[0], DIRTY, (si * sizeof(buf_f32[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_f32(&buf_f32[si], &ref_i32_f32_1[si], (ei - si), 0)) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_f32[ei], DIRTY, ((ref_n - ei) * sizeof(buf_f32[0])))) {
+                line = __LINE__; goto error_;
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  si=%u, ei=%u\n", __func__, line, si, ei);
+    print_f32(stderr, buf_f32, ref_n);
+    print_f32(stderr, ref_i32_f32_1, ref_n);
+}
+
+
+void test_aymo_convert_none_f32_i32_1(void)
+{
+    unsigned si, ei; int line = 0;
+    for (si = 0; si < ref_n; ++si) {
+        for (ei = si; ei < ref_n; ++ei) {
+            memset(buf_i32, (int)DIRTY, sizeof(buf_i32));
+            aymo_(f32_i32_1)((ei - si), &src_f32_i32_1[si], &buf_i32[si]);
+            if (compare_dirty(&buf_i32[0], DIRTY, (si * sizeof(buf_i32[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_i32(&buf_i32[si], &ref_f32_i32_1[si], (ei - si))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_i32[ei], DIRTY, ((ref_n - ei) * sizeof(buf_i32[0])))) {
+                line = __LINE__; goto error_;
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  si=%u, ei=%u\n", __func__, line, si, ei);
+    print_i32(stderr, buf_i32, ref_n);
+    print_i32(stderr, ref_f32_i32_1, ref_n);
+}
+
+
+void test_aymo_convert_none_i32_f32_k(void)
+{
+    unsigned si, ei; int line = 0;
+    for (si = 0; si < ref_n; ++si) {
+        for (ei = si; ei < ref_n; ++ei) {
+            memset(buf_f32, (int)DIRTY, sizeof(buf_f32));
+            aymo_(i32_f32_k)((ei - si), &src_i32[si], &buf_f32[si], (float)(1. / K32));
+            if (compare_dirty(&buf_f32[0], DIRTY, (si * sizeof(buf_f32[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_f32(&buf_f32[si], &ref_i32_f32_1[si], (ei - si), 0)) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_f32[ei], DIRTY, ((ref_n - ei) * sizeof(buf_f32[0])))) {
+                line = __LINE__; goto error_;
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  si=%u, ei=%u\n", __func__, line, si, ei);
+    print_f32(stderr, buf_f32, ref_n);
+    print_f32(stderr, ref_i32_f32_1, ref_n);
+}
+
+
+void test_aymo_convert_none_f32_i32_k(void)
+{
+    unsigned si, ei; int line = 0;
+    for (si = 0; si < ref_n; ++si) {
+        for (ei = si; ei < ref_n; ++ei) {
+            memset(buf_i32, (int)DIRTY, sizeof(buf_i32));
+            aymo_(f32_i32_k)((ei - si), &src_f32_i32_1[si], &buf_i32[si], (float)(K32));
+            if (compare_dirty(&buf_i32[0], DIRTY, (si * sizeof(buf_i32[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_i32(&buf_i32[si], &ref_f32_i32_1[si], (ei - si))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_i32[ei], DIRTY, ((ref_n - ei) * sizeof(buf_i32[0])))) {
+                line = __LINE__; goto error_;
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  si=%u, ei=%u\n", __func__, line, si, ei);
+    print_i32(stderr, buf_i32, ref_n);
+    print_i32(stderr, ref_f32_i32_1, ref_n);
+}
+
+
+void test_aymo_convert_none_f64_f32(void)
+{
+    unsigned si, ei; int line = 0;
+    for (si = 0; si < ref_n; ++si) {
+        for (ei = si; ei < ref_n; ++ei) {
+            memset(buf_f32, (int)DIRTY, sizeof(buf_f32));
+            aymo_(f64_f32)((ei - si), &src_f64[si], &buf_f32[si]);
+            if (compare_dirty(&buf_f32[0], DIRTY, (si * sizeof(buf_f32[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_f32(&buf_f32[si], &src_f32[si], (ei - si), 0)) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_f32[ei], DIRTY, ((ref_n - ei) * sizeof(buf_f32[0])))) {
+                line = __LINE__; goto error_;
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  si=%u, ei=%u\n", __func__, line, si, ei);
+    print_f32(stderr, buf_f32, ref_n);
+    print_f32(stderr, src_f32, ref_n);
+}
+
+
+void test_aymo_convert_none_f32_f64(void)
+{
+    unsigned si, ei; int line = 0;
+    for (si = 0; si < ref_n; ++si) {
+        for (ei = si; ei < ref_n; ++ei) {
+            memset(buf_f64, (int)DIRTY, sizeof(buf_f64));
+            aymo_(f32_f64)((ei - si), &src_f32[si], &buf_f64[si]);
+            if (compare_dirty(&buf_f64[0], DIRTY, (si * sizeof(buf_f64[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_f64(&buf_f64[si], &src_f64[si], (ei - si), 0)) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_f64[ei], DIRTY, ((ref_n - ei) * sizeof(buf_f64[0])))) {
+                line = __LINE__; goto error_;
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  si=%u, ei=%u\n", __func__, line, si, ei);
+    print_f64(stderr, buf_f64, ref_n);
+    print_f64(stderr, src_f64, ref_n);
+}
+
+
+void test_aymo_convert_none_f64_f32_k(void)
+{
+    unsigned si, ei; int line = 0;
+    for (si = 0; si < ref_n; ++si) {
+        for (ei = si; ei < ref_n; ++ei) {
+            memset(buf_f32, (int)DIRTY, sizeof(buf_f32));
+            aymo_(f64_f32_k)((ei - si), &src_f64[si], &buf_f32[si], (float)(1. / K));
+            if (compare_dirty(&buf_f32[0], DIRTY, (si * sizeof(buf_f32[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_f32(&buf_f32[si], &src_f32_1[si], (ei - si), 0)) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_f32[ei], DIRTY, ((ref_n - ei) * sizeof(buf_f32[0])))) {
+                line = __LINE__; goto error_;
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  si=%u, ei=%u\n", __func__, line, si, ei);
+    print_f32(stderr, buf_f32, ref_n);
+    print_f32(stderr, src_f32_1, ref_n);
+}
+
+
+void test_aymo_convert_none_f32_f64_k(void)
+{
+    unsigned si, ei; int line = 0;
+    for (si = 0; si < ref_n; ++si) {
+        for (ei = si; ei < ref_n; ++ei) {
+            memset(buf_f64, (int)DIRTY, sizeof(buf_f64));
+            aymo_(f32_f64_k)((ei - si), &src_f32[si], &buf_f64[si], (float)(1. / K));
+            if (compare_dirty(&buf_f64[0], DIRTY, (si * sizeof(buf_f64[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_f64(&buf_f64[si], &src_f64_1[si], (ei - si), 0)) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_f64[ei], DIRTY, ((ref_n - ei) * sizeof(buf_f64[0])))) {
+                line = __LINE__; goto error_;
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  si=%u, ei=%u\n", __func__, line, si, ei);
+    print_f64(stderr, buf_f64, ref_n);
+    print_f64(stderr, src_f64_1, ref_n);
+}
+
+
+void test_aymo_convert_none_i16x2_f32x2_k(void)
+{
+    unsigned si, ei; int line = 0;
+    for (si = 0; si < ref_n2; ++si) {
+        for (ei = si; ei < ref_n2; ++ei) {
+            memset(buf_f32l, (int)DIRTY, sizeof(buf_f32l));
+            memset(buf_f32r, (int)DIRTY, sizeof(buf_f32r));
+            aymo_(i16x2_f32x2_k)((ei - si), &src_i16[si * 2u], &buf_f32l[si], &buf_f32r[si], (float)(1. / K));
+            if (compare_dirty(&buf_f32l[0], DIRTY, (si * sizeof(buf_f32l[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_f32r[0], DIRTY, (si * sizeof(buf_f32r[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_f32(&buf_f32l[si], &ref_i16x2_f32l_1[si], (ei - si), 0)) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_f32(&buf_f32r[si], &ref_i16x2_f32r_1[si], (ei - si), 0)) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_f32l[ei], DIRTY, ((ref_n2 - ei) * sizeof(buf_f32l[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_f32r[ei], DIRTY, ((ref_n2 - ei) * sizeof(buf_f32r[0])))) {
+                line = __LINE__; goto error_;
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  si=%u, ei=%u\n", __func__, line, si, ei);
+    print_f32(stderr, buf_f32l, ref_n2);
+    print_f32(stderr, ref_i16x2_f32l_1, ref_n2);
+    print_f32(stderr, buf_f32r, ref_n2);
+    print_f32(stderr, ref_i16x2_f32r_1, ref_n2);
+}
+
+
+void test_aymo_convert_none_f32x2_i16x2_k(void)
+{
+    unsigned si, ei; int line = 0;
+    for (si = 0; si < ref_n2; ++si) {
+        for (ei = si; ei < ref_n2; ++ei) {
+            memset(buf_i16, (int)DIRTY, sizeof(buf_i16));
+            aymo_(f32x2_i16x2_k)((ei - si), &src_f32l_1[si], &src_f32r_1[si], &buf_i16[si * 2u], (float)(K));
+            if (compare_dirty(&buf_i16[0], DIRTY, (si * 2u * sizeof(buf_i16[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_i16(&buf_i16[si * 2u], &ref_f32_i16_1[si * 2u], ((ei - si) * 2u))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_i16[ei * 2u], DIRTY, ((ref_n2 - ei) * 2u * sizeof(buf_i16[0])))) {
+                line = __LINE__; goto error_;
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  si=%u, ei=%u\n", __func__, line, si, ei);
+    print_i16(stderr, buf_i16, ref_n);
+    print_i16(stderr, ref_f32_i16_1, ref_n);
+}
+
+
+void test_aymo_convert_none_i16x4_i16x2_k(void)
+{
+    unsigned si, ei; int line = 0;
+    for (si = 0; si < ref_n4; ++si) {
+        for (ei = si; ei < ref_n4; ++ei) {
+            memset(buf_i16, (int)DIRTY, sizeof(buf_i16));
+            aymo_(i16x4_i16x2_k)((ei - si), &src_i16[si * 4u], &buf_i16[si * 2u], k_i16x4);
+            if (compare_dirty(&buf_i16[0], DIRTY, (si * 2u * sizeof(buf_i16[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_i16(&buf_i16[si * 2u], &ref_i16x4_i16x2[si * 2u], ((ei - si) * 2u))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_i16[ei * 2u], DIRTY, ((ref_n - (ei * 2u)) * sizeof(buf_i16[0])))) {
+                line = __LINE__; goto error_;
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  si=%u, ei=%u\n", __func__, line, si, ei);
+    print_i16(stderr, buf_i16, ref_n2);
+    print_i16(stderr, ref_i16x4_i16x2, ref_n2);
+}
+
+
+void test_aymo_convert_none_i16x4_f32x2_k(void)
+{
+    unsigned si, ei; int line = 0;
+    for (si = 0; si < ref_n4; ++si) {
+        for (ei = si; ei < ref_n4; ++ei) {
+            memset(buf_f32, (int)DIRTY, sizeof(buf_f32));
+            aymo_(i16x4_f32x2_k)((ei - si), &src_i16[si * 4u], &buf_f32[si * 2u], k_i16x4);
+            if (compare_dirty(&buf_f32[0], DIRTY, (si * 2u * sizeof(buf_f32[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_f32(&buf_f32[si * 2u], &ref_i16x4_f32x2[si * 2u], ((ei - si) * 2u), 0)) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_f32[ei * 2u], DIRTY, ((ref_n - (ei * 2u)) * sizeof(buf_f32[0])))) {
+                line = __LINE__; goto error_;
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  si=%u, ei=%u\n", __func__, line, si, ei);
+    print_f32(stderr, buf_f32, ref_n2);
+    print_f32(stderr, ref_i16x4_f32x2, ref_n2);
+}
+
+
+void test_aymo_convert_none_i16_f32_k_m(void)
+{
+    struct aymo_convert_meter meter, meter_ref;
+    unsigned ch, si, ei, mi; int line = 0;
+    for (ch = 1u; ch <= AYMO_CONVERT_METER_CHANNELS_MAX; ++ch) {
+        for (si = 0; si < ref_n; si += ch) {
+            for (ei = si; ei < ref_n; ei += ch) {
+                mi = (si + ((((ei - si) / ch) / 2u) * ch));  // split into two calls
+                aymo_convert_meter_ctor(&meter, ch);
+                aymo_convert_meter_ctor(&meter_ref, ch);
+                memset(buf_f32, (int)DIRTY, sizeof(buf_f32));
+                aymo_(i16_f32_k_m)((mi - si), &src_i16_z[si], &buf_f32[si], 1.f, &meter);
+                aymo_(i16_f32_k_m)((ei - mi), &src_i16_z[mi], &buf_f32[mi], 1.f, &meter);
+                ref_meter_i16(&meter_ref, &src_i16_z[si], (ei - si));
+                if (compare_dirty(&buf_f32[0], DIRTY, (si * sizeof(buf_f32[0])))) {
+                    line = __LINE__; goto error_;
+                }
+                if (compare_f32(&buf_f32[si], &ref_i16_z_f32[si], (ei - si), 0)) {
+                    line = __LINE__; goto error_;
+                }
+                if (compare_dirty(&buf_f32[ei], DIRTY, ((ref_n - ei) * sizeof(buf_f32[0])))) {
+                    line = __LINE__; goto error_;
+                }
+                if (compare_meter(&meter, &meter_ref)) {
+                    line = __LINE__; goto error_;
+                }
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  ch=%u, si=%u, ei=%u\n", __func__, line, ch, si, ei);
+    print_f32(stderr, buf_f32, ref_n);
+    print_f32(stderr, ref_i16_z_f32, ref_n);
+    print_meter(stderr, &meter);
+    print_meter(stderr, &meter_ref);
+}
+
+
+void test_aymo_convert_none_f32_i16_k_m(void)
+{
+    struct aymo_convert_meter meter, meter_ref;
+    unsigned ch, si, ei, mi; int line = 0;
+    for (ch = 1u; ch <= AYMO_CONVERT_METER_CHANNELS_MAX; ++ch) {
+        for (si = 0; si < ref_n; si += ch) {
+            for (ei = si; ei < ref_n; ei += ch) {
+                mi = (si + ((((ei - si) / ch) / 2u) * ch));  // split into two calls
+                aymo_convert_meter_ctor(&meter, ch);
+                aymo_convert_meter_ctor(&meter_ref, ch);
+                memset(buf_i16, (int)DIRTY, sizeof(buf_i16));
+                aymo_(f32_i16_k_m)((mi - si), &ref_i16_z_f32[si], &buf_i16[si], 1.f, &meter);
+                aymo_(f32_i16_k_m)((ei - mi), &ref_i16_z_f32[mi], &buf_i16[mi], 1.f, &meter);
+                ref_meter_i16(&meter_ref, &src_i16_z[si], (ei - si));
+                if (compare_dirty(&buf_i16[0], DIRTY, (si * sizeof(buf_i16[0])))) {
+                    line = __LINE__; goto error_;
+                }
+                if (compare_i16(&buf_i16[si], &src_i16_z[si], (ei - si))) {
+                    line = __LINE__; goto error_;
+                }
+                if (compare_dirty(&buf_i16[ei], DIRTY, ((ref_n - ei) * sizeof(buf_i16[0])))) {
+                    line = __LINE__; goto error_;
+                }
+                if (compare_meter(&meter, &meter_ref)) {
+                    line = __LINE__; goto error_;
+                }
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  ch=%u, si=%u, ei=%u\n", __func__, line, ch, si, ei);
+    print_i16(stderr, buf_i16, ref_n);
+    print_i16(stderr, src_i16_z, ref_n);
+    print_meter(stderr, &meter);
+    print_meter(stderr, &meter_ref);
+}
+
+
 struct aymo_testing_entry unit_tests[] =
 {
     AYMO_TEST_ENTRY(test_aymo_convert_none_i16_f32),
@@ -364,7 +1320,41 @@ struct aymo_testing_entry unit_tests[] =
     AYMO_TEST_ENTRY(test_aymo_convert_none_u16_f32_1),
     AYMO_TEST_ENTRY(test_aymo_convert_none_f32_u16_1),
     AYMO_TEST_ENTRY(test_aymo_convert_none_u16_f32_k),
-    AYMO_TEST_ENTRY(test_aymo_convert_none_f32_u16_k)
+    AYMO_TEST_ENTRY(test_aymo_convert_none_f32_u16_k),
+    AYMO_TEST_ENTRY(test_aymo_convert_none_i8_f32),
+    AYMO_TEST_ENTRY(test_aymo_convert_none_f32_i8),
+    AYMO_TEST_ENTRY(test_aymo_convert_none_i8_f32_1),
+    AYMO_TEST_ENTRY(test_aymo_convert_none_f32_i8_1),
+    AYMO_TEST_ENTRY(test_aymo_convert_none_i8_f32_k),
+    AYMO_TEST_ENTRY(test_aymo_convert_none_f32_i8_k),
+    AYMO_TEST_ENTRY(test_aymo_convert_none_u8_f32),
+    AYMO_TEST_ENTRY(test_aymo_convert_none_f32_u8),
+    AYMO_TEST_ENTRY(test_aymo_convert_none_u8_f32_1),
+    AYMO_TEST_ENTRY(test_aymo_convert_none_f32_u8_1),
+    AYMO_TEST_ENTRY(test_aymo_convert_none_u8_f32_k),
+    AYMO_TEST_ENTRY(test_aymo_convert_none_f32_u8_k),
+    AYMO_TEST_ENTRY(test_aymo_convert_none_i24_f32),
+    AYMO_TEST_ENTRY(test_aymo_convert_none_f32_i24),
+    AYMO_TEST_ENTRY(test_aymo_convert_none_i24_f32_1),
+    AYMO_TEST_ENTRY(test_aymo_convert_none_f32_i24_1),
+    AYMO_TEST_ENTRY(test_aymo_convert_none_i24_f32_k),
+    AYMO_TEST_ENTRY(test_aymo_convert_none_f32_i24_k),
+    AYMO_TEST_ENTRY(test_aymo_convert_none_i32_f32),
+    AYMO_TEST_ENTRY(test_aymo_convert_none_f32_i32),
+    AYMO_TEST_ENTRY(test_aymo_convert_none_i32_f32_1),
+    AYMO_TEST_ENTRY(test_aymo_convert_none_f32_i32_1),
+    AYMO_TEST_ENTRY(test_aymo_convert_none_i32_f32_k),
+    AYMO_TEST_ENTRY(test_aymo_convert_none_f32_i32_k),
+    AYMO_TEST_ENTRY(test_aymo_convert_none_f64_f32),
+    AYMO_TEST_ENTRY(test_aymo_convert_none_f32_f64),
+    AYMO_TEST_ENTRY(test_aymo_convert_none_f64_f32_k),
+    AYMO_TEST_ENTRY(test_aymo_convert_none_f32_f64_k),
+    AYMO_TEST_ENTRY(test_aymo_convert_none_i16x2_f32x2_k),
+    AYMO_TEST_ENTRY(test_aymo_convert_none_f32x2_i16x2_k),
+    AYMO_TEST_ENTRY(test_aymo_convert_none_i16x4_i16x2_k),
+    AYMO_TEST_ENTRY(test_aymo_convert_none_i16x4_f32x2_k),
+    AYMO_TEST_ENTRY(test_aymo_convert_none_i16_f32_k_m),
+    AYMO_TEST_ENTRY(test_aymo_convert_none_f32_i16_k_m)
 };
 
 
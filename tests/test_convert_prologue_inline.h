@@ -19,6 +19,7 @@ along with AYMO. If not, see <https://www.gnu.org/licenses/>.
 */
 
 #include "aymo_cc.h"
+#include "aymo_convert.h"
 
 #include <math.h>
 #include <stddef.h>
@@ -68,10 +69,39 @@ static int app_return;
 #define x0xfu   ((float)xxmmu)
 #define x0xFU   ((float)xxMMu)
 
+#define K8      (+128.f)
+#define x8xmm   (INT8_MIN)
+#define x8xMM   (INT8_MAX)
+#define x8xfi   ((float)x8xmm)
+#define x8xFI   ((float)x8xMM)
+#define u8xmm   (0u)
+#define u8xMM   (UINT8_MAX)
+#define u8xfu   ((float)u8xmm)
+#define u8xFU   ((float)u8xMM)
+
+#define K24     (+8388608.f)
+#define x24mm   (AYMO_CONVERT_I24_MIN)
+#define x24MM   (AYMO_CONVERT_I24_MAX)
+#define x24fi   ((float)x24mm)
+#define x24FI   ((float)x24MM)
+#define I24(x)  (uint8_t)((uint32_t)(x)), (uint8_t)((uint32_t)(x) >> 8), (uint8_t)((uint32_t)(x) >> 16)
+
+#define K32     (+2147483648.f)
+#define x32mm   (INT32_MIN)
+#define x32MM   (INT32_MAX)
+#define x32fi   ((float)x32mm)
+#define x32FI   ((float)x32MM)
+
 
 static float buf_f32[ref_n];
 static int16_t buf_i16[ref_n];
 static uint16_t buf_u16[ref_n];
+// Not all the backends have tests for these formats yet
+int8_t buf_i8[ref_n];
+uint8_t buf_u8[ref_n];
+uint8_t buf_i24[ref_n * 3u];
+int32_t buf_i32[ref_n];
+double buf_f64[ref_n];
 
 
 const int16_t src_i16[ref_n] = {
@@ -210,6 +240,433 @@ const uint16_t ref_f32_u16_1[ref_n] = {
 };
 
 
+const int8_t src_i8[ref_n] = {
+    x8xmm,  -0x01,  -0x02,  +0x03,  x8xMM,  -0x05,  -0x06,  +0x07,
+    -0x10,  x8xmm,  +0x12,  -0x13,  -0x14,  x8xMM,  -0x16,  -0x17,
+    +0x20,  +0x21,  x8xmm,  -0x23,  -0x24,  -0x25,  x8xMM,  -0x27,
+    -0x30,  -0x31,  +0x32,  x8xmm,  +0x34,  +0x35,  +0x36,  x8xMM,
+    x8xMM,  -0x41,  +0x42,  +0x43,  x8xmm,  +0x45,  -0x46,  -0x47,
+    +0x50,  x8xMM,  -0x52,  -0x53,  +0x54,  x8xmm,  +0x56,  +0x57,
+    +0x60,  -0x61,  x8xMM,  +0x63,  -0x64,  +0x65,  x8xmm,  -0x67,
+    -0x70,  +0x71,  +0x72,  x8xMM,  +0x74,  -0x75,  -0x76,  x8xmm
+};
+
+const float ref_i8_f32[ref_n] = {
+    x8xfi,  -0x01,  -0x02,  +0x03,  x8xFI,  -0x05,  -0x06,  +0x07,
+    -0x10,  x8xfi,  +0x12,  -0x13,  -0x14,  x8xFI,  -0x16,  -0x17,
+    +0x20,  +0x21,  x8xfi,  -0x23,  -0x24,  -0x25,  x8xFI,  -0x27,
+    -0x30,  -0x31,  +0x32,  x8xfi,  +0x34,  +0x35,  +0x36,  x8xFI,
+    x8xFI,  -0x41,  +0x42,  +0x43,  x8xfi,  +0x45,  -0x46,  -0x47,
+    +0x50,  x8xFI,  -0x52,  -0x53,  +0x54,  x8xfi,  +0x56,  +0x57,
+    +0x60,  -0x61,  x8xFI,  +0x63,  -0x64,  +0x65,  x8xfi,  -0x67,
+    -0x70,  +0x71,  +0x72,  x8xFI,  +0x74,  -0x75,  -0x76,  x8xfi
+};
+
+const float ref_i8_f32_1[ref_n] = {
+    x8xfi/K8,  -0x01/K8,  -0x02/K8,  +0x03/K8,  x8xFI/K8,  -0x05/K8,  -0x06/K8,  +0x07/K8,
+    -0x10/K8,  x8xfi/K8,  +0x12/K8,  -0x13/K8,  -0x14/K8,  x8xFI/K8,  -0x16/K8,  -0x17/K8,
+    +0x20/K8,  +0x21/K8,  x8xfi/K8,  -0x23/K8,  -0x24/K8,  -0x25/K8,  x8xFI/K8,  -0x27/K8,
+    -0x30/K8,  -0x31/K8,  +0x32/K8,  x8xfi/K8,  +0x34/K8,  +0x35/K8,  +0x36/K8,  x8xFI/K8,
+    x8xFI/K8,  -0x41/K8,  +0x42/K8,  +0x43/K8,  x8xfi/K8,  +0x45/K8,  -0x46/K8,  -0x47/K8,
+    +0x50/K8,  x8xFI/K8,  -0x52/K8,  -0x53/K8,  +0x54/K8,  x8xfi/K8,  +0x56/K8,  +0x57/K8,
+    +0x60/K8,  -0x61/K8,  x8xFI/K8,  +0x63/K8,  -0x64/K8,  +0x65/K8,  x8xfi/K8,  -0x67/K8,
+    -0x70/K8,  +0x71/K8,  +0x72/K8,  x8xFI/K8,  +0x74/K8,  -0x75/K8,  -0x76/K8,  x8xfi/K8
+};
+
+const int8_t ref_f32_i8[ref_n] = {
+    x8xmm,  -0x01,  -0x02,  +0x03,  x8xMM,  -0x05,  -0x06,  +0x07,
+    -0x10,  x8xmm,  +0x12,  -0x13,  -0x14,  x8xMM,  -0x16,  -0x17,
+    +0x20,  +0x21,  x8xmm,  -0x23,  -0x24,  -0x25,  x8xMM,  -0x27,
+    -0x30,  -0x31,  +0x32,  x8xmm,  +0x34,  +0x35,  +0x36,  x8xMM,
+    x8xMM,  -0x41,  +0x42,  +0x43,  x8xmm,  +0x45,  -0x46,  -0x47,
+    +0x50,  x8xMM,  -0x52,  -0x53,  +0x54,  x8xmm,  +0x56,  +0x57,
+    +0x60,  -0x61,  x8xMM,  +0x63,  -0x64,  +0x65,  x8xmm,  -0x67,
+    -0x70,  +0x71,  +0x72,  x8xMM,  +0x74,  -0x75,  -0x76,  x8xmm
+};
+
+const float src_f32_i8_1[ref_n] = {
+    x0xff/K,   -0x01/K8,  -0x02/K8,  +0x03/K8,  x0xFF/K,   -0x05/K8,  -0x06/K8,  +0x07/K8,
+    -0x10/K8,  x0xff/K,   +0x12/K8,  -0x13/K8,  -0x14/K8,  x0xFF/K,   -0x16/K8,  -0x17/K8,
+    +0x20/K8,  +0x21/K8,  x0xff/K,   -0x23/K8,  -0x24/K8,  -0x25/K8,  x0xFF/K,   -0x27/K8,
+    -0x30/K8,  -0x31/K8,  +0x32/K8,  x0xff/K,   +0x34/K8,  +0x35/K8,  +0x36/K8,  x0xFF/K,
+    x0xFF/K,   -0x41/K8,  +0x42/K8,  +0x43/K8,  x0xff/K,   +0x45/K8,  -0x46/K8,  -0x47/K8,
+    +0x50/K8,  x0xFF/K,   -0x52/K8,  -0x53/K8,  +0x54/K8,  x0xff/K,   +0x56/K8,  +0x57/K8,
+    +0x60/K8,  -0x61/K8,  x0xFF/K,   +0x63/K8,  -0x64/K8,  +0x65/K8,  x0xff/K,   -0x67/K8,
+    -0x70/K8,  +0x71/K8,  +0x72/K8,  x0xFF/K,   +0x74/K8,  -0x75/K8,  -0x76/K8,  x0xff/K
+};
+
+const int8_t ref_f32_i8_1[ref_n] = {
+    x8xmm,  -0x01,  -0x02,  +0x03,  x8xMM,  -0x05,  -0x06,  +0x07,
+    -0x10,  x8xmm,  +0x12,  -0x13,  -0x14,  x8xMM,  -0x16,  -0x17,
+    +0x20,  +0x21,  x8xmm,  -0x23,  -0x24,  -0x25,  x8xMM,  -0x27,
+    -0x30,  -0x31,  +0x32,  x8xmm,  +0x34,  +0x35,  +0x36,  x8xMM,
+    x8xMM,  -0x41,  +0x42,  +0x43,  x8xmm,  +0x45,  -0x46,  -0x47,
+    +0x50,  x8xMM,  -0x52,  -0x53,  +0x54,  x8xmm,  +0x56,  +0x57,
+    +0x60,  -0x61,  x8xMM,  +0x63,  -0x64,  +0x65,  x8xmm,  -0x67,
+    -0x70,  +0x71,  +0x72,  x8xMM,  +0x74,  -0x75,  -0x76,  x8xmm
+};
+
+
+const uint8_t src_u8[ref_n] = {
+    u8xmm,  0x01u,  0x02u,  0x03u,  u8xMM,  0x05u,  0x06u,  0x07u,
+    0x10u,  u8xmm,  0x12u,  0x13u,  0x14u,  u8xMM,  0x16u,  0x17u,
+    0x20u,  0x21u,  u8xmm,  0x23u,  0x24u,  0x25u,  u8xMM,  0x27u,
+    0x30u,  0x31u,  0x32u,  u8xmm,  0x34u,  0x35u,  0x36u,  u8xMM,
+    u8xMM,  0x41u,  0x42u,  0x43u,  u8xmm,  0x45u,  0x46u,  0x47u,
+    0x50u,  u8xMM,  0x52u,  0x53u,  0x54u,  u8xmm,  0x56u,  0x57u,
+    0x60u,  0x61u,  u8xMM,  0x63u,  0x64u,  0x65u,  u8xmm,  0x67u,
+    0x70u,  0x71u,  0x72u,  u8xMM,  0x74u,  0x75u,  0x76u,  u8xmm
+};
+
+const float ref_u8_f32[ref_n] = {
+    u8xfu,  +0x01,  +0x02,  +0x03,  u8xFU,  +0x05,  +0x06,  +0x07,
+    +0x10,  u8xfu,  +0x12,  +0x13,  +0x14,  u8xFU,  +0x16,  +0x17,
+    +0x20,  +0x21,  u8xfu,  +0x23,  +0x24,  +0x25,  u8xFU,  +0x27,
+    +0x30,  +0x31,  +0x32,  u8xfu,  +0x34,  +0x35,  +0x36,  u8xFU,
+    u8xFU,  +0x41,  +0x42,  +0x43,  u8xfu,  +0x45,  +0x46,  +0x47,
+    +0x50,  u8xFU,  +0x52,  +0x53,  +0x54,  u8xfu,  +0x56,  +0x57,
+    +0x60,  +0x61,  u8xFU,  +0x63,  +0x64,  +0x65,  u8xfu,  +0x67,
+    +0x70,  +0x71,  +0x72,  u8xFU,  +0x74,  +0x75,  +0x76,  u8xfu
+};
+
+const float ref_u8_f32_1[ref_n] = {
+    u8xfu/K8,  +0x01/K8,  +0x02/K8,  +0x03/K8,  u8xFU/K8,  +0x05/K8,  +0x06/K8,  +0x07/K8,
+    +0x10/K8,  u8xfu/K8,  +0x12/K8,  +0x13/K8,  +0x14/K8,  u8xFU/K8,  +0x16/K8,  +0x17/K8,
+    +0x20/K8,  +0x21/K8,  u8xfu/K8,  +0x23/K8,  +0x24/K8,  +0x25/K8,  u8xFU/K8,  +0x27/K8,
+    +0x30/K8,  +0x31/K8,  +0x32/K8,  u8xfu/K8,  +0x34/K8,  +0x35/K8,  +0x36/K8,  u8xFU/K8,
+    u8xFU/K8,  +0x41/K8,  +0x42/K8,  +0x43/K8,  u8xfu/K8,  +0x45/K8,  +0x46/K8,  +0x47/K8,
+    +0x50/K8,  u8xFU/K8,  +0x52/K8,  +0x53/K8,  +0x54/K8,  u8xfu/K8,  +0x56/K8,  +0x57/K8,
+    +0x60/K8,  +0x61/K8,  u8xFU/K8,  +0x63/K8,  +0x64/K8,  +0x65/K8,  u8xfu/K8,  +0x67/K8,
+    +0x70/K8,  +0x71/K8,  +0x72/K8,  u8xFU/K8,  +0x74/K8,  +0x75/K8,  +0x76/K8,  u8xfu/K8
+};
+
+const uint8_t ref_f32_u8[ref_n] = {
+    u8xmm,  u8xmm,  u8xmm,  0x03u,  u8xMM,  u8xmm,  u8xmm,  0x07u,
+    u8xmm,  u8xmm,  0x12u,  u8xmm,  u8xmm,  u8xMM,  u8xmm,  u8xmm,
+    0x20u,  0x21u,  u8xmm,  u8xmm,  u8xmm,  u8xmm,  u8xMM,  u8xmm,
+    u8xmm,  u8xmm,  0x32u,  u8xmm,  0x34u,  0x35u,  0x36u,  u8xMM,
+    u8xMM,  u8xmm,  0x42u,  0x43u,  u8xmm,  0x45u,  u8xmm,  u8xmm,
+    0x50u,  u8xMM,  u8xmm,  u8xmm,  0x54u,  u8xmm,  0x56u,  0x57u,
+    0x60u,  u8xmm,  u8xMM,  0x63u,  u8xmm,  0x65u,  u8xmm,  u8xmm,
+    u8xmm,  0x71u,  0x72u,  u8xMM,  0x74u,  u8xmm,  u8xmm,  u8xmm
+};
+
+const float src_f32_u8_1[ref_n] = {
+    x0xff/K,   +0x01/K8,  +0x02/K8,  +0x03/K8,  x0xFF/K,   +0x05/K8,  +0x06/K8,  +0x07/K8,
+    +0x10/K8,  x0xff/K,   +0x12/K8,  +0x13/K8,  +0x14/K8,  x0xFF/K,   +0x16/K8,  +0x17/K8,
+    +0x20/K8,  +0x21/K8,  x0xff/K,   +0x23/K8,  +0x24/K8,  +0x25/K8,  x0xFF/K,   +0x27/K8,
+    +0x30/K8,  +0x31/K8,  +0x32/K8,  x0xff/K,   +0x34/K8,  +0x35/K8,  +0x36/K8,  x0xFF/K,
+    x0xFF/K,   +0x41/K8,  +0x42/K8,  +0x43/K8,  x0xff/K,   +0x45/K8,  +0x46/K8,  +0x47/K8,
+    +0x50/K8,  x0xFF/K,   +0x52/K8,  +0x53/K8,  +0x54/K8,  x0xff/K,   +0x56/K8,  +0x57/K8,
+    +0x60/K8,  +0x61/K8,  x0xFF/K,   +0x63/K8,  +0x64/K8,  +0x65/K8,  x0xff/K,   +0x67/K8,
+    +0x70/K8,  +0x71/K8,  +0x72/K8,  x0xFF/K,   +0x74/K8,  +0x75/K8,  +0x76/K8,  x0xff/K
+};
+
+const uint8_t ref_f32_u8_1[ref_n] = {
+    u8xmm,  0x01u,  0x02u,  0x03u,  u8xMM,  0x05u,  0x06u,  0x07u,
+    0x10u,  u8xmm,  0x12u,  0x13u,  0x14u,  u8xMM,  0x16u,  0x17u,
+    0x20u,  0x21u,  u8xmm,  0x23u,  0x24u,  0x25u,  u8xMM,  0x27u,
+    0x30u,  0x31u,  0x32u,  u8xmm,  0x34u,  0x35u,  0x36u,  u8xMM,
+    u8xMM,  0x41u,  0x42u,  0x43u,  u8xmm,  0x45u,  0x46u,  0x47u,
+    0x50u,  u8xMM,  0x52u,  0x53u,  0x54u,  u8xmm,  0x56u,  0x57u,
+    0x60u,  0x61u,  u8xMM,  0x63u,  0x64u,  0x65u,  u8xmm,  0x67u,
+    0x70u,  0x71u,  0x72u,  u8xMM,  0x74u,  0x75u,  0x76u,  u8xmm
+};
+
+
+const uint8_t src_i24[ref_n * 3u] = {
+    I24(x24mm),  I24(-0x01),  I24(-0x02),  I24(+0x03),  I24(x24MM),  I24(-0x05),  I24(-0x06),  I24(+0x07),
+    I24(-0x10),  I24(x24mm),  I24(+0x12),  I24(-0x13),  I24(-0x14),  I24(x24MM),  I24(-0x16),  I24(-0x17),
+    I24(+0x20),  I24(+0x21),  I24(x24mm),  I24(-0x23),  I24(-0x24),  I24(-0x25),  I24(x24MM),  I24(-0x27),
+    I24(-0x30),  I24(-0x31),  I24(+0x32),  I24(x24mm),  I24(+0x34),  I24(+0x35),  I24(+0x36),  I24(x24MM),
+    I24(x24MM),  I24(-0x41),  I24(+0x42),  I24(+0x43),  I24(x24mm),  I24(+0x45),  I24(-0x46),  I24(-0x47),
+    I24(+0x50),  I24(x24MM),  I24(-0x52),  I24(-0x53),  I24(+0x54),  I24(x24mm),  I24(+0x56),  I24(+0x57),
+    I24(+0x60),  I24(-0x61),  I24(x24MM),  I24(+0x63),  I24(-0x64),  I24(+0x65),  I24(x24mm),  I24(-0x67),
+    I24(-0x70),  I24(+0x71),  I24(+0x72),  I24(x24MM),  I24(+0x74),  I24(-0x75),  I24(-0x76),  I24(x24mm)
+};
+
+const float ref_i24_f32[ref_n] = {
+    x24fi,  -0x01,  -0x02,  +0x03,  x24FI,  -0x05,  -0x06,  +0x07,
+    -0x10,  x24fi,  +0x12,  -0x13,  -0x14,  x24FI,  -0x16,  -0x17,
+    +0x20,  +0x21,  x24fi,  -0x23,  -0x24,  -0x25,  x24FI,  -0x27,
+    -0x30,  -0x31,  +0x32,  x24fi,  +0x34,  +0x35,  +0x36,  x24FI,
+    x24FI,  -0x41,  +0x42,  +0x43,  x24fi,  +0x45,  -0x46,  -0x47,
+    +0x50,  x24FI,  -0x52,  -0x53,  +0x54,  x24fi,  +0x56,  +0x57,
+    +0x60,  -0x61,  x24FI,  +0x63,  -0x64,  +0x65,  x24fi,  -0x67,
+    -0x70,  +0x71,  +0x72,  x24FI,  +0x74,  -0x75,  -0x76,  x24fi
+};
+
+const float ref_i24_f32_1[ref_n] = {
+    x24fi/K24,  -0x01/K24,  -0x02/K24,  +0x03/K24,  x24FI/K24,  -0x05/K24,  -0x06/K24,  +0x07/K24,
+    -0x10/K24,  x24fi/K24,  +0x12/K24,  -0x13/K24,  -0x14/K24,  x24FI/K24,  -0x16/K24,  -0x17/K24,
+    +0x20/K24,  +0x21/K24,  x24fi/K24,  -0x23/K24,  -0x24/K24,  -0x25/K24,  x24FI/K24,  -0x27/K24,
+    -0x30/K24,  -0x31/K24,  +0x32/K24,  x24fi/K24,  +0x34/K24,  +0x35/K24,  +0x36/K24,  x24FI/K24,
+    x24FI/K24,  -0x41/K24,  +0x42/K24,  +0x43/K24,  x24fi/K24,  +0x45/K24,  -0x46/K24,  -0x47/K24,
+    +0x50/K24,  x24FI/K24,  -0x52/K24,  -0x53/K24,  +0x54/K24,  x24fi/K24,  +0x56/K24,  +0x57/K24,
+    +0x60/K24,  -0x61/K24,  x24FI/K24,  +0x63/K24,  -0x64/K24,  +0x65/K24,  x24fi/K24,  -0x67/K24,
+    -0x70/K24,  +0x71/K24,  +0x72/K24,  x24FI/K24,  +0x74/K24,  -0x75/K24,  -0x76/K24,  x24fi/K24
+};
+
+const uint8_t ref_f32_i24[ref_n * 3u] = {
+    I24(x24mm),  I24(-0x01),  I24(-0x02),  I24(+0x03),  I24(x24MM),  I24(-0x05),  I24(-0x06),  I24(+0x07),
+    I24(-0x10),  I24(x24mm),  I24(+0x12),  I24(-0x13),  I24(-0x14),  I24(x24MM),  I24(-0x16),  I24(-0x17),
+    I24(+0x20),  I24(+0x21),  I24(x24mm),  I24(-0x23),  I24(-0x24),  I24(-0x25),  I24(x24MM),  I24(-0x27),
+    I24(-0x30),  I24(-0x31),  I24(+0x32),  I24(x24mm),  I24(+0x34),  I24(+0x35),  I24(+0x36),  I24(x24MM),
+    I24(x24MM),  I24(-0x41),  I24(+0x42),  I24(+0x43),  I24(x24mm),  I24(+0x45),  I24(-0x46),  I24(-0x47),
+    I24(+0x50),  I24(x24MM),  I24(-0x52),  I24(-0x53),  I24(+0x54),  I24(x24mm),  I24(+0x56),  I24(+0x57),
+    I24(+0x60),  I24(-0x61),  I24(x24MM),  I24(+0x63),  I24(-0x64),  I24(+0x65),  I24(x24mm),  I24(-0x67),
+    I24(-0x70),  I24(+0x71),  I24(+0x72),  I24(x24MM),  I24(+0x74),  I24(-0x75),  I24(-0x76),  I24(x24mm)
+};
+
+const float src_f32_i24_1[ref_n] = {
+    x0xff/K,    -0x01/K24,  -0x02/K24,  +0x03/K24,  x0xFF/K,    -0x05/K24,  -0x06/K24,  +0x07/K24,
+    -0x10/K24,  x0xff/K,    +0x12/K24,  -0x13/K24,  -0x14/K24,  x0xFF/K,    -0x16/K24,  -0x17/K24,
+    +0x20/K24,  +0x21/K24,  x0xff/K,    -0x23/K24,  -0x24/K24,  -0x25/K24,  x0xFF/K,    -0x27/K24,
+    -0x30/K24,  -0x31/K24,  +0x32/K24,  x0xff/K,    +0x34/K24,  +0x35/K24,  +0x36/K24,  x0xFF/K,
+    x0xFF/K,    -0x41/K24,  +0x42/K24,  +0x43/K24,  x0xff/K,    +0x45/K24,  -0x46/K24,  -0x47/K24,
+    +0x50/K24,  x0xFF/K,    -0x52/K24,  -0x53/K24,  +0x54/K24,  x0xff/K,    +0x56/K24,  +0x57/K24,
+    +0x60/K24,  -0x61/K24,  x0xFF/K,    +0x63/K24,  -0x64/K24,  +0x65/K24,  x0xff/K,    -0x67/K24,
+    -0x70/K24,  +0x71/K24,  +0x72/K24,  x0xFF/K,    +0x74/K24,  -0x75/K24,  -0x76/K24,  x0xff/K
+};
+
+const uint8_t ref_f32_i24_1[ref_n * 3u] = {
+    I24(x24mm),  I24(-0x01),  I24(-0x02),  I24(+0x03),  I24(x24MM),  I24(-0x05),  I24(-0x06),  I24(+0x07),
+    I24(-0x10),  I24(x24mm),  I24(+0x12),  I24(-0x13),  I24(-0x14),  I24(x24MM),  I24(-0x16),  I24(-0x17),
+    I24(+0x20),  I24(+0x21),  I24(x24mm),  I24(-0x23),  I24(-0x24),  I24(-0x25),  I24(x24MM),  I24(-0x27),
+    I24(-0x30),  I24(-0x31),  I24(+0x32),  I24(x24mm),  I24(+0x34),  I24(+0x35),  I24(+0x36),  I24(x24MM),
+    I24(x24MM),  I24(-0x41),  I24(+0x42),  I24(+0x43),  I24(x24mm),  I24(+0x45),  I24(-0x46),  I24(-0x47),
+    I24(+0x50),  I24(x24MM),  I24(-0x52),  I24(-0x53),  I24(+0x54),  I24(x24mm),  I24(+0x56),  I24(+0x57),
+    I24(+0x60),  I24(-0x61),  I24(x24MM),  I24(+0x63),  I24(-0x64),  I24(+0x65),  I24(x24mm),  I24(-0x67),
+    I24(-0x70),  I24(+0x71),  I24(+0x72),  I24(x24MM),  I24(+0x74),  I24(-0x75),  I24(-0x76),  I24(x24mm)
+};
+
+
+const int32_t src_i32[ref_n] = {
+    x32mm,  -0x01,  -0x02,  +0x03,  x32MM,  -0x05,  -0x06,  +0x07,
+    -0x10,  x32mm,  +0x12,  -0x13,  -0x14,  x32MM,  -0x16,  -0x17,
+    +0x20,  +0x21,  x32mm,  -0x23,  -0x24,  -0x25,  x32MM,  -0x27,
+    -0x30,  -0x31,  +0x32,  x32mm,  +0x34,  +0x35,  +0x36,  x32MM,
+    x32MM,  -0x41,  +0x42,  +0x43,  x32mm,  +0x45,  -0x46,  -0x47,
+    +0x50,  x32MM,  -0x52,  -0x53,  +0x54,  x32mm,  +0x56,  +0x57,
+    +0x60,  -0x61,  x32MM,  +0x63,  -0x64,  +0x65,  x32mm,  -0x67,
+    -0x70,  +0x71,  +0x72,  x32MM,  +0x74,  -0x75,  -0x76,  x32mm
+};
+
+const float ref_i32_f32[ref_n] = {
+    x32fi,  -0x01,  -0x02,  +0x03,  x32FI,  -0x05,  -0x06,  +0x07,
+    -0x10,  x32fi,  +0x12,  -0x13,  -0x14,  x32FI,  -0x16,  -0x17,
+    +0x20,  +0x21,  x32fi,  -0x23,  -0x24,  -0x25,  x32FI,  -0x27,
+    -0x30,  -0x31,  +0x32,  x32fi,  +0x34,  +0x35,  +0x36,  x32FI,
+    x32FI,  -0x41,  +0x42,  +0x43,  x32fi,  +0x45,  -0x46,  -0x47,
+    +0x50,  x32FI,  -0x52,  -0x53,  +0x54,  x32fi,  +0x56,  +0x57,
+    +0x60,  -0x61,  x32FI,  +0x63,  -0x64,  +0x65,  x32fi,  -0x67,
+    -0x70,  +0x71,  +0x72,  x32FI,  +0x74,  -0x75,  -0x76,  x32fi
+};
+
+const float ref_i32_f32_1[ref_n] = {
+    x32fi/K32,  -0x01/K32,  -0x02/K32,  +0x03/K32,  x32FI/K32,  -0x05/K32,  -0x06/K32,  +0x07/K32,
+    -0x10/K32,  x32fi/K32,  +0x12/K32,  -0x13/K32,  -0x14/K32,  x32FI/K32,  -0x16/K32,  -0x17/K32,
+    +0x20/K32,  +0x21/K32,  x32fi/K32,  -0x23/K32,  -0x24/K32,  -0x25/K32,  x32FI/K32,  -0x27/K32,
+    -0x30/K32,  -0x31/K32,  +0x32/K32,  x32fi/K32,  +0x34/K32,  +0x35/K32,  +0x36/K32,  x32FI/K32,
+    x32FI/K32,  -0x41/K32,  +0x42/K32,  +0x43/K32,  x32fi/K32,  +0x45/K32,  -0x46/K32,  -0x47/K32,
+    +0x50/K32,  x32FI/K32,  -0x52/K32,  -0x53/K32,  +0x54/K32,  x32fi/K32,  +0x56/K32,  +0x57/K32,
+    +0x60/K32,  -0x61/K32,  x32FI/K32,  +0x63/K32,  -0x64/K32,  +0x65/K32,  x32fi/K32,  -0x67/K32,
+    -0x70/K32,  +0x71/K32,  +0x72/K32,  x32FI/K32,  +0x74/K32,  -0x75/K32,  -0x76/K32,  x32fi/K32
+};
+
+const int32_t ref_f32_i32[ref_n] = {
+    (int32_t)x0xff,  -0x01,           -0x02,           +0x03,           (int32_t)x0xFF,  -0x05,           -0x06,           +0x07,
+    -0x10,           (int32_t)x0xff,  +0x12,           -0x13,           -0x14,           (int32_t)x0xFF,  -0x16,           -0x17,
+    +0x20,           +0x21,           (int32_t)x0xff,  -0x23,           -0x24,           -0x25,           (int32_t)x0xFF,  -0x27,
+    -0x30,           -0x31,           +0x32,           (int32_t)x0xff,  +0x34,           +0x35,           +0x36,           (int32_t)x0xFF,
+    (int32_t)x0xFF,  -0x41,           +0x42,           +0x43,           (int32_t)x0xff,  +0x45,           -0x46,           -0x47,
+    +0x50,           (int32_t)x0xFF,  -0x52,           -0x53,           +0x54,           (int32_t)x0xff,  +0x56,           +0x57,
+    +0x60,           -0x61,           (int32_t)x0xFF,  +0x63,           -0x64,           +0x65,           (int32_t)x0xff,  -0x67,
+    -0x70,           +0x71,           +0x72,           (int32_t)x0xFF,  +0x74,           -0x75,           -0x76,           (int32_t)x0xff
+};
+
+const float src_f32_i32_1[ref_n] = {
+    x0xff/K,    -0x01/K32,  -0x02/K32,  +0x03/K32,  x0xFF/K,    -0x05/K32,  -0x06/K32,  +0x07/K32,
+    -0x10/K32,  x0xff/K,    +0x12/K32,  -0x13/K32,  -0x14/K32,  x0xFF/K,    -0x16/K32,  -0x17/K32,
+    +0x20/K32,  +0x21/K32,  x0xff/K,    -0x23/K32,  -0x24/K32,  -0x25/K32,  x0xFF/K,    -0x27/K32,
+    -0x30/K32,  -0x31/K32,  +0x32/K32,  x0xff/K,    +0x34/K32,  +0x35/K32,  +0x36/K32,  x0xFF/K,
+    x0xFF/K,    -0x41/K32,  +0x42/K32,  +0x43/K32,  x0xff/K,    +0x45/K32,  -0x46/K32,  -0x47/K32,
+    +0x50/K32,  x0xFF/K,    -0x52/K32,  -0x53/K32,  +0x54/K32,  x0xff/K,    +0x56/K32,  +0x57/K32,
+    +0x60/K32,  -0x61/K32,  x0xFF/K,    +0x63/K32,  -0x64/K32,  +0x65/K32,  x0xff/K,    -0x67/K32,
+    -0x70/K32,  +0x71/K32,  +0x72/K32,  x0xFF/K,    +0x74/K32,  -0x75/K32,  -0x76/K32,  x0xff/K
+};
+
+const int32_t ref_f32_i32_1[ref_n] = {
+    x32mm,  -0x01,  -0x02,  +0x03,  x32MM,  -0x05,  -0x06,  +0x07,
+    -0x10,  x32mm,  +0x12,  -0x13,  -0x14,  x32MM,  -0x16,  -0x17,
+    +0x20,  +0x21,  x32mm,  -0x23,  -0x24,  -0x25,  x32MM,  -0x27,
+    -0x30,  -0x31,  +0x32,  x32mm,  +0x34,  +0x35,  +0x36,  x32MM,
+    x32MM,  -0x41,  +0x42,  +0x43,  x32mm,  +0x45,  -0x46,  -0x47,
+    +0x50,  x32MM,  -0x52,  -0x53,  +0x54,  x32mm,  +0x56,  +0x57,
+    +0x60,  -0x61,  x32MM,  +0x63,  -0x64,  +0x65,  x32mm,  -0x67,
+    -0x70,  +0x71,  +0x72,  x32MM,  +0x74,  -0x75,  -0x76,  x32mm
+};
+
+
+const double src_f64[ref_n] = {
+    (double)x0xff,  -0x01,          -0x02,          +0x03,          (double)x0xFF,  -0x05,          -0x06,          +0x07,
+    -0x10,          (double)x0xff,  +0x12,          -0x13,          -0x14,          (double)x0xFF,  -0x16,          -0x17,
+    +0x20,          +0x21,          (double)x0xff,  -0x23,          -0x24,          -0x25,          (double)x0xFF,  -0x27,
+    -0x30,          -0x31,          +0x32,          (double)x0xff,  +0x34,          +0x35,          +0x36,          (double)x0xFF,
+    (double)x0xFF,  -0x41,          +0x42,          +0x43,          (double)x0xff,  +0x45,          -0x46,          -0x47,
+    +0x50,          (double)x0xFF,  -0x52,          -0x53,          +0x54,          (double)x0xff,  +0x56,          +0x57,
+    +0x60,          -0x61,          (double)x0xFF,  +0x63,          -0x64,          +0x65,          (double)x0xff,  -0x67,
+    -0x70,          +0x71,          +0x72,          (double)x0xFF,  +0x74,          -0x75,          -0x76,          (double)x0xff
+};
+
+const double src_f64_1[ref_n] = {
+    (double)x0xff/K,  -0x01/K,          -0x02/K,          +0x03/K,          (double)x0xFF/K,  -0x05/K,          -0x06/K,          +0x07/K,
+    -0x10/K,          (double)x0xff/K,  +0x12/K,          -0x13/K,          -0x14/K,          (double)x0xFF/K,  -0x16/K,          -0x17/K,
+    +0x20/K,          +0x21/K,          (double)x0xff/K,  -0x23/K,          -0x24/K,          -0x25/K,          (double)x0xFF/K,  -0x27/K,
+    -0x30/K,          -0x31/K,          +0x32/K,          (double)x0xff/K,  +0x34/K,          +0x35/K,          +0x36/K,          (double)x0xFF/K,
+    (double)x0xFF/K,  -0x41/K,          +0x42/K,          +0x43/K,          (double)x0xff/K,  +0x45/K,          -0x46/K,          -0x47/K,
+    +0x50/K,          (double)x0xFF/K,  -0x52/K,          -0x53/K,          +0x54/K,          (double)x0xff/K,  +0x56/K,          +0x57/K,
+    +0x60/K,          -0x61/K,          (double)x0xFF/K,  +0x63/K,          -0x64/K,          +0x65/K,          (double)x0xff/K,  -0x67/K,
+    -0x70/K,          +0x71/K,          +0x72/K,          (double)x0xFF/K,  +0x74/K,          -0x75/K,          -0x76/K,          (double)x0xff/K
+};
+
+
+// Fused layout data: src_i16 as stereo or quad frames
+#define ref_n2  (ref_n / 2u)
+#define ref_n4  (ref_n / 4u)
+
+static float buf_f32l[ref_n2];
+static float buf_f32r[ref_n2];
+
+const float ref_i16x2_f32l_1[ref_n2] = {
+    x0xfi/K,  -0x02/K,  x0xFI/K,  -0x06/K,  -0x10/K,  +0x12/K,  -0x14/K,  -0x16/K,
+    +0x20/K,  x0xfi/K,  -0x24/K,  x0xFI/K,  -0x30/K,  +0x32/K,  +0x34/K,  +0x36/K,
+    x0xFI/K,  +0x42/K,  x0xfi/K,  -0x46/K,  +0x50/K,  -0x52/K,  +0x54/K,  +0x56/K,
+    +0x60/K,  x0xFI/K,  -0x64/K,  x0xfi/K,  -0x70/K,  +0x72/K,  +0x74/K,  -0x76/K
+};
+
+const float ref_i16x2_f32r_1[ref_n2] = {
+    -0x01/K,  +0x03/K,  -0x05/K,  +0x07/K,  x0xfi/K,  -0x13/K,  x0xFI/K,  -0x17/K,
+    +0x21/K,  -0x23/K,  -0x25/K,  -0x27/K,  -0x31/K,  x0xfi/K,  +0x35/K,  x0xFI/K,
+    -0x41/K,  +0x43/K,  +0x45/K,  -0x47/K,  x0xFI/K,  -0x53/K,  x0xfi/K,  +0x57/K,
+    -0x61/K,  +0x63/K,  +0x65/K,  -0x67/K,  +0x71/K,  x0xFI/K,  -0x75/K,  x0xfi/K
+};
+
+const float src_f32l_1[ref_n2] = {
+    x0xff/K,  -0x02/K,  x0xFF/K,  -0x06/K,  -0x10/K,  +0x12/K,  -0x14/K,  -0x16/K,
+    +0x20/K,  x0xff/K,  -0x24/K,  x0xFF/K,  -0x30/K,  +0x32/K,  +0x34/K,  +0x36/K,
+    x0xFF/K,  +0x42/K,  x0xff/K,  -0x46/K,  +0x50/K,  -0x52/K,  +0x54/K,  +0x56/K,
+    +0x60/K,  x0xFF/K,  -0x64/K,  x0xff/K,  -0x70/K,  +0x72/K,  +0x74/K,  -0x76/K
+};
+
+const float src_f32r_1[ref_n2] = {
+    -0x01/K,  +0x03/K,  -0x05/K,  +0x07/K,  x0xff/K,  -0x13/K,  x0xFF/K,  -0x17/K,
+    +0x21/K,  -0x23/K,  -0x25/K,  -0x27/K,  -0x31/K,  x0xff/K,  +0x35/K,  x0xFF/K,
+    -0x41/K,  +0x43/K,  +0x45/K,  -0x47/K,  x0xFF/K,  -0x53/K,  x0xff/K,  +0x57/K,
+    -0x61/K,  +0x63/K,  +0x65/K,  -0x67/K,  +0x71/K,  x0xFF/K,  -0x75/K,  x0xff/K
+};
+
+// Downmix: L = A + C, R = 2D - B
+const float k_i16x4[4] = { +1.f, -1.f, +1.f, +2.f };
+
+const int16_t ref_i16x4_i16x2[ref_n2] = {
+    x0xmm,    +0x07,    +0x7ff9,  +0x13,    +0x02,    +0x7fda,  -0x2a,    x0xmm,
+    -0x7fe0,  -0x67,    +0x7fdb,  -0x29,    +0x02,    x0xmm,    +0x6a,    x0xMM,
+    x0xMM,    +0xc7,    x0xmm,    -0xd3,    -0x02,    x0xmm,    +0xaa,    x0xMM,
+    x0xMM,    +0x127,   x0xmm,    -0x133,   +0x02,    x0xMM,    -0x02,    x0xmm
+};
+
+const float ref_i16x4_f32x2[ref_n2] = {
+    -0x8002,  +0x07,    +0x7ff9,  +0x13,    +0x02,    +0x7fda,  -0x2a,    -0x802d,
+    -0x7fe0,  -0x67,    +0x7fdb,  -0x29,    +0x02,    -0xffcf,  +0x6a,    +0xffc9,
+    +0x8041,  +0xc7,    -0x8046,  -0xd3,    -0x02,    -0x80a5,  +0xaa,    +0x80ae,
+    +0x805f,  +0x127,   -0x8064,  -0x133,   +0x02,    +0xff8d,  -0x02,    -0xff8b
+};
+
+
+
+// Metering data: runs of zeros between peaks, as mono or stereo frames
+const int16_t src_i16_z[ref_n] = {
+     0x00,   0x00,  +0x01,  -0x02,   0x00,   0x00,   0x00,   0x00,
+     0x00,  x0xmm,   0x00,  +0x13,   0x00,   0x00,   0x00,   0x00,
+    +0x20,   0x00,   0x00,   0x00,   0x00,   0x00,   0x00,   0x00,
+     0x00,   0x00,   0x00,   0x00,   0x00,   0x00,  +0x36,  x0xMM,
+    x0xMM,  -0x41,   0x00,   0x00,  x0xmm,   0x00,   0x00,   0x00,
+     0x00,   0x00,   0x00,   0x00,   0x00,   0x00,   0x00,   0x00,
+     0x00,   0x00,   0x00,   0x00,   0x00,   0x00,   0x00,   0x00,
+    -0x70,   0x00,   0x00,   0x00,   0x00,   0x00,   0x00,   0x00
+};
+
+const float ref_i16_z_f32[ref_n] = {
+     0x00,   0x00,  +0x01,  -0x02,   0x00,   0x00,   0x00,   0x00,
+     0x00,  x0xfi,   0x00,  +0x13,   0x00,   0x00,   0x00,   0x00,
+    +0x20,   0x00,   0x00,   0x00,   0x00,   0x00,   0x00,   0x00,
+     0x00,   0x00,   0x00,   0x00,   0x00,   0x00,  +0x36,  x0xFI,
+    x0xFI,  -0x41,   0x00,   0x00,  x0xfi,   0x00,   0x00,   0x00,
+     0x00,   0x00,   0x00,   0x00,   0x00,   0x00,   0x00,   0x00,
+     0x00,   0x00,   0x00,   0x00,   0x00,   0x00,   0x00,   0x00,
+    -0x70,   0x00,   0x00,   0x00,   0x00,   0x00,   0x00,   0x00
+};
+
+
+// Sample by sample reference model of the metering statistics
+void ref_meter_i16(struct aymo_convert_meter* meter, const int16_t* vp, size_t n)
+{
+    for (size_t i = 0u; i < n; ++i) {
+        uint32_t ch = (uint32_t)(i % meter->channels);
+        int32_t v = vp[i];
+        uint32_t a = (uint32_t)((v < 0) ? -v : v);
+        if (meter->peak[ch] < a) {
+            meter->peak[ch] = a;
+        }
+        meter->sumsq[ch] += ((uint64_t)a * a);
+        if (v) {
+            if (meter->zero_run[ch] == meter->count[ch]) {
+                meter->zero_lead[ch] = meter->zero_run[ch];
+            }
+            if (meter->zero_run_max[ch] < meter->zero_run[ch]) {
+                meter->zero_run_max[ch] = meter->zero_run[ch];
+            }
+            meter->zero_run[ch] = 0u;
+        }
+        else {
+            ++meter->zero_run[ch];
+        }
+        ++meter->count[ch];
+    }
+}
+
+
+int compare_meter(const struct aymo_convert_meter* meter, const struct aymo_convert_meter* ref)
+{
+    if (meter->channels != ref->channels) {
+        return 1;
+    }
+    for (uint32_t ch = 0u; ch < AYMO_CONVERT_METER_CHANNELS_MAX; ++ch) {
+        if ((meter->sumsq[ch] != ref->sumsq[ch]) ||
+            (meter->count[ch] != ref->count[ch]) ||
+            (meter->zero_lead[ch] != ref->zero_lead[ch]) ||
+            (meter->zero_run[ch] != ref->zero_run[ch]) ||
+            (meter->zero_run_max[ch] != ref->zero_run_max[ch]) ||
+            (meter->peak[ch] != ref->peak[ch])) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+
+void print_meter(FILE* fp, const struct aymo_convert_meter* meter)
+{
+    for (uint32_t ch = 0u; ch < meter->channels; ++ch) {
+        fprintf(fp, "{ ch=%u, peak=%lu, sumsq=%llu, count=%llu, zero_lead=%llu, zero_run=%llu, zero_run_max=%llu }\n",
+                (unsigned)ch, (unsigned long)meter->peak[ch],
+                (unsigned long long)meter->sumsq[ch], (unsigned long long)meter->count[ch],
+                (unsigned long long)meter->zero_lead[ch], (unsigned long long)meter->zero_run[ch],
+                (unsigned long long)meter->zero_run_max[ch]);
+    }
+}
+
 void print_i16(FILE* fp, const int16_t* vp, size_t n)
 {
     fprintf(fp, "{ ");
@@ -233,6 +690,42 @@ void print_u16(FILE* fp, const uint16_t* vp, size_t n)
 }
 
 
+void print_i8(FILE* fp, const int8_t* vp, size_t n)
+{
+    fprintf(fp, "{ ");
+    while (n--) {
+        int i = (int)*vp++;
+        char sc = ((i < 0) ? '-' : ((i > 0) ? '+' : ' '));
+        if (i < 0) i = -i;
+        fprintf(fp, "%c%02Xh,  ", sc, (unsigned)i);
+    }
+    fprintf(fp, "}\n");
+}
+
+
+void print_u8(FILE* fp, const uint8_t* vp, size_t n)
+{
+    fprintf(fp, "{ ");
+    while (n--) {
+        fprintf(fp, "%02Xh,  ", (unsigned)*vp++);
+    }
+    fprintf(fp, "}\n");
+}
+
+
+void print_i32(FILE* fp, const int32_t* vp, size_t n)
+{
+    fprintf(fp, "{ ");
+    while (n--) {
+        long i = (long)*vp++;
+        char sc = ((i < 0) ? '-' : ((i > 0) ? '+' : ' '));
+        if (i < 0) i = -i;
+        fprintf(fp, "%c%08lXh,  ", sc, (unsigned long)i);
+    }
+    fprintf(fp, "}\n");
+}
+
+
 void print_f32(FILE* fp, const float* vp, size_t n)
 {
     fprintf(fp, "{ ");
@@ -243,6 +736,16 @@ void print_f32(FILE* fp, const float* vp, size_t n)
 }
 
 
+void print_f64(FILE* fp, const double* vp, size_t n)
+{
+    fprintf(fp, "{ ");
+    while (n--) {
+        fprintf(fp, "%+6.2f,  ", *vp++);
+    }
+    fprintf(fp, "}\n");
+}
+
+
 const int16_t* compare_i16(const int16_t* bufp, const int16_t* refp, size_t len)
 {
     while (len--) {
@@ -269,6 +772,45 @@ const uint16_t* compare_u16(const uint16_t* bufp, const uint16_t* refp, size_t l
 }
 
 
+const int8_t* compare_i8(const int8_t* bufp, const int8_t* refp, size_t len)
+{
+    while (len--) {
+        if (*bufp != *refp) {
+            return bufp;
+        }
+        ++bufp;
+        ++refp;
+    }
+    return NULL;
+}
+
+
+const uint8_t* compare_u8(const uint8_t* bufp, const uint8_t* refp, size_t len)
+{
+    while (len--) {
+        if (*bufp != *refp) {
+            return bufp;
+        }
+        ++bufp;
+        ++refp;
+    }
+    return NULL;
+}
+
+
+const int32_t* compare_i32(const int32_t* bufp, const int32_t* refp, size_t len)
+{
+    while (len--) {
+        if (*bufp != *refp) {
+            return bufp;
+        }
+        ++bufp;
+        ++refp;
+    }
+    return NULL;
+}
+
+
 const float* compare_f32(const float* bufp, const float* refp, size_t len, float epsilon)
 {
     while (len--) {
@@ -282,6 +824,19 @@ const float* compare_f32(const float* bufp, const float* refp, size_t len, float
 }
 
 
+const double* compare_f64(const double* bufp, const double* refp, size_t len, double epsilon)
+{
+    while (len--) {
+        if (fabs(*bufp - *refp) > epsilon) {
+            return bufp;
+        }
+        ++bufp;
+        ++refp;
+    }
+    return NULL;
+}
+
+
 const void* compare_dirty(const void* bufp, uint8_t refv, size_t size)
 {
     const uint8_t* sp = bufp;
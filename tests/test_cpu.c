@@ -0,0 +1,193 @@
+/*
+AYMO - Accelerated YaMaha Operator
+Copyright (c) 2023-2024 Andrea Zoppi.
+
+This file is part of AYMO.
+
+AYMO is free software: you can redistribute it and/or modify it under the
+terms of the GNU Lesser General Public License as published by the Free
+Software Foundation, either version 2.1 of the License, or (at your option)
+any later version.
+
+AYMO is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with AYMO. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "aymo.h"
+#include "aymo_cpu.h"
+#include "aymo_testing.h"
+
+#include <fenv.h>
+#include <float.h>
+#include <stdio.h>
+#include <string.h>
+
+AYMO_CXX_EXTERN_C_BEGIN
+
+
+/*
+aymo_cpu_enter_ftz() must turn on flush-to-zero, and aymo_cpu_leave_ftz() must
+give back the caller's floating-point control register bit for bit, also when
+nested and when the caller runs with non-default modes.
+*/
+
+static int app_return;
+
+
+// Flush-to-zero bits expected in the saved state, zero where unsupported
+static aymo_cpu_fpstate_t ftz_bits(void)
+{
+#if (defined(AYMO_CPU_FAMILY_X86) || defined(AYMO_CPU_FAMILY_X86_64))
+    unsigned extensions = aymo_cpu_x86_get_extensions();
+    aymo_cpu_fpstate_t bits = 0u;
+    if (extensions & AYMO_CPU_X86_EXT_SSE) {
+        bits |= AYMO_CPU_X86_MXCSR_FTZ;
+        if (extensions & AYMO_CPU_X86_EXT_SSE3) {
+            bits |= AYMO_CPU_X86_MXCSR_DAZ;
+        }
+    }
+    return bits;
+#elif (defined(AYMO_CPU_FAMILY_AARCH64) && (defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER)))
+    return AYMO_CPU_ARM_FPCR_FZ;
+#elif (defined(AYMO_CPU_FAMILY_ARM) && defined(__ARM_FP) && (defined(__GNUC__) || defined(__clang__)))
+    return AYMO_CPU_ARM_FPCR_FZ;
+#else
+    return 0u;
+#endif
+}
+
+
+// Current state, without changing it
+static aymo_cpu_fpstate_t peek_fpstate(void)
+{
+    aymo_cpu_fpstate_t state = aymo_cpu_enter_ftz();
+    aymo_cpu_leave_ftz(state);
+    return state;
+}
+
+
+void test_aymo_cpu_ftz_restore(void)
+{
+    aymo_boot();
+
+    aymo_cpu_fpstate_t bits = ftz_bits();
+    aymo_cpu_fpstate_t outer = aymo_cpu_enter_ftz();
+    aymo_cpu_fpstate_t inner = aymo_cpu_enter_ftz();  // nested: already flushing
+    aymo_cpu_leave_ftz(inner);
+    aymo_cpu_fpstate_t middle = peek_fpstate();
+    aymo_cpu_leave_ftz(outer);
+    aymo_cpu_fpstate_t after = peek_fpstate();
+
+    if ((inner & bits) != bits) {
+        app_return = TEST_STATUS_FAIL;
+        fprintf(stderr, "%s: flush-to-zero not entered: 0x%llX\n", __func__, (unsigned long long)inner);
+    }
+    if ((inner & ~bits) != (outer & ~bits)) {
+        app_return = TEST_STATUS_FAIL;
+        fprintf(stderr, "%s: other modes changed: 0x%llX != 0x%llX\n", __func__,
+                (unsigned long long)inner, (unsigned long long)outer);
+    }
+    if (middle != inner) {
+        app_return = TEST_STATUS_FAIL;
+        fprintf(stderr, "%s: nested leave changed state: 0x%llX != 0x%llX\n", __func__,
+                (unsigned long long)middle, (unsigned long long)inner);
+    }
+    if (after != outer) {
+        app_return = TEST_STATUS_FAIL;
+        fprintf(stderr, "%s: state not restored: 0x%llX != 0x%llX\n", __func__,
+                (unsigned long long)after, (unsigned long long)outer);
+    }
+}
+
+
+// The caller's rounding mode shares the same control register
+void test_aymo_cpu_ftz_rounding(void)
+{
+    aymo_boot();
+
+    int rounding = fegetround();
+    if (fesetround(FE_TOWARDZERO)) {
+        app_return = TEST_STATUS_SKIP;
+        return;
+    }
+    aymo_cpu_fpstate_t before = peek_fpstate();
+
+    aymo_cpu_fpstate_t state = aymo_cpu_enter_ftz();
+    int inside = fegetround();
+    aymo_cpu_fpstate_t entered = peek_fpstate();
+    aymo_cpu_leave_ftz(state);
+    int after = fegetround();
+    aymo_cpu_fpstate_t restored = peek_fpstate();
+
+    fesetround(rounding);
+
+    if ((inside != FE_TOWARDZERO) || (after != FE_TOWARDZERO)) {
+        app_return = TEST_STATUS_FAIL;
+        fprintf(stderr, "%s: rounding mode lost\n", __func__);
+    }
+    if ((entered & ~ftz_bits()) != (before & ~ftz_bits())) {
+        app_return = TEST_STATUS_FAIL;
+        fprintf(stderr, "%s: rounding mode changed: 0x%llX != 0x%llX\n", __func__,
+                (unsigned long long)entered, (unsigned long long)before);
+    }
+    if (restored != before) {
+        app_return = TEST_STATUS_FAIL;
+        fprintf(stderr, "%s: state not restored: 0x%llX != 0x%llX\n", __func__,
+                (unsigned long long)restored, (unsigned long long)before);
+    }
+}
+
+
+// Denormal results become zero only between enter and leave
+void test_aymo_cpu_ftz_flush(void)
+{
+    aymo_boot();
+
+#if ((defined(AYMO_CPU_FAMILY_X86_64) || defined(AYMO_CPU_FAMILY_AARCH64)) && (FLT_EVAL_METHOD == 0))
+    if (!ftz_bits()) {
+        app_return = TEST_STATUS_SKIP;
+        return;
+    }
+    volatile float tiny = FLT_MIN;
+    volatile float half = .5f;
+    volatile float y;
+
+    y = (tiny * half);
+    if (y == 0.f) {
+        app_return = TEST_STATUS_SKIP;  // already flushing by default
+        return;
+    }
+
+    aymo_cpu_fpstate_t state = aymo_cpu_enter_ftz();
+    y = (tiny * half);
+    aymo_cpu_leave_ftz(state);
+    if (y != 0.f) {
+        app_return = TEST_STATUS_FAIL;
+        fprintf(stderr, "%s: denormal not flushed: %g\n", __func__, (double)y);
+    }
+
+    y = (tiny * half);
+    if (y == 0.f) {
+        app_return = TEST_STATUS_FAIL;
+        fprintf(stderr, "%s: still flushing after leave\n", __func__);
+    }
+#else
+    app_return = TEST_STATUS_SKIP;  // scalar math may not follow the vector unit
+#endif
+}
+
+
+struct aymo_testing_entry unit_tests[] =
+{
+    AYMO_TEST_ENTRY(test_aymo_cpu_ftz_restore),
+    AYMO_TEST_ENTRY(test_aymo_cpu_ftz_rounding),
+    AYMO_TEST_ENTRY(test_aymo_cpu_ftz_flush)
+};
+
+
+#include "aymo_testing_epilogue_inline.h"
@@ -0,0 +1,334 @@
+/*
+AYMO - Accelerated YaMaha Operator
+Copyright (c) 2023-2024 Andrea Zoppi.
+
+This file is part of AYMO.
+
+AYMO is free software: you can redistribute it and/or modify it under the
+terms of the GNU Lesser General Public License as published by the Free
+Software Foundation, either version 2.1 of the License, or (at your option)
+any later version.
+
+AYMO is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with AYMO. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "aymo_cc.h"
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+AYMO_CXX_EXTERN_C_BEGIN
+
+
+static int app_return;
+
+
+#define ref_n   64u
+#define ref_n2  (ref_n / 2u)
+#define ref_m   2u
+
+
+#undef DIRTY
+
+#undef x0xmm
+#undef x0xMM
+#undef x0xfi
+#undef x0xFI
+#undef x32mm
+#undef x32MM
+
+
+#define DIRTY   (0xCCu)
+
+#define x0xmm   (INT16_MIN)
+#define x0xMM   (INT16_MAX)
+#define x0xfi   ((float)x0xmm)
+#define x0xFI   ((float)x0xMM)
+
+#define x32mm   (INT32_MIN)
+#define x32MM   (INT32_MAX)
+
+
+static int16_t buf_i16[ref_n];
+static int32_t buf_i32[ref_n];
+static float buf_f32[ref_n];
+
+
+// Two streams, mono gains: y = a - 2b
+// Stereo gains: L = 2a - b, R = a - b
+const int16_t src_a_i16[ref_n] = {
+    x0xmm,  -0x01,  -0x02,  +0x03,  x0xMM,  -0x05,  -0x06,  +0x07,
+    -0x10,  x0xmm,  +0x12,  -0x13,  -0x14,  x0xMM,  -0x16,  -0x17,
+    +0x20,  +0x21,  x0xmm,  -0x23,  -0x24,  -0x25,  x0xMM,  -0x27,
+    -0x30,  -0x31,  +0x32,  x0xmm,  +0x34,  +0x35,  +0x36,  x0xMM,
+    x0xMM,  -0x41,  +0x42,  +0x43,  x0xmm,  +0x45,  -0x46,  -0x47,
+    +0x50,  x0xMM,  -0x52,  -0x53,  +0x54,  x0xmm,  +0x56,  +0x57,
+    +0x60,  -0x61,  x0xMM,  +0x63,  -0x64,  +0x65,  x0xmm,  -0x67,
+    -0x70,  +0x71,  +0x72,  x0xMM,  +0x74,  -0x75,  -0x76,  x0xmm
+};
+
+const int16_t src_b_i16[ref_n] = {
+    +0x00,  x0xmm,  -0x6A,  +0x9F,  -0xD4,  -0x109,  -0x4000,  -0x173,
+    -0x1A8,  x0xMM,  -0x12,  -0x47,  +0x7C,  -0xB1,  +0x4000,  +0x11B,
+    -0x150,  x0xmm,  +0x1BA,  -0x1EF,  -0x24,  +0x59,  -0x4000,  -0xC3,
+    +0xF8,  x0xMM,  -0x162,  +0x197,  -0x1CC,  -0x01,  +0x4000,  -0x6B,
+    -0xA0,  x0xmm,  -0x10A,  -0x13F,  +0x174,  -0x1A9,  -0x4000,  +0x13,
+    -0x48,  x0xMM,  +0xB2,  -0xE7,  -0x11C,  +0x151,  +0x4000,  -0x1BB,
+    +0x1F0,  x0xmm,  -0x5A,  +0x8F,  -0xC4,  -0xF9,  -0x4000,  -0x163,
+    -0x198,  x0xMM,  -0x02,  -0x37,  +0x6C,  -0xA1,  +0x4000,  +0x10B
+};
+
+const float src_a_f32[ref_n] = {
+    x0xfi,  -0x01,  -0x02,  +0x03,  x0xFI,  -0x05,  -0x06,  +0x07,
+    -0x10,  x0xfi,  +0x12,  -0x13,  -0x14,  x0xFI,  -0x16,  -0x17,
+    +0x20,  +0x21,  x0xfi,  -0x23,  -0x24,  -0x25,  x0xFI,  -0x27,
+    -0x30,  -0x31,  +0x32,  x0xfi,  +0x34,  +0x35,  +0x36,  x0xFI,
+    x0xFI,  -0x41,  +0x42,  +0x43,  x0xfi,  +0x45,  -0x46,  -0x47,
+    +0x50,  x0xFI,  -0x52,  -0x53,  +0x54,  x0xfi,  +0x56,  +0x57,
+    +0x60,  -0x61,  x0xFI,  +0x63,  -0x64,  +0x65,  x0xfi,  -0x67,
+    -0x70,  +0x71,  +0x72,  x0xFI,  +0x74,  -0x75,  -0x76,  x0xfi
+};
+
+const float src_b_f32[ref_n] = {
+    +0x00,  x0xfi,  -0x6A,  +0x9F,  -0xD4,  -0x109,  -0x4000,  -0x173,
+    -0x1A8,  x0xFI,  -0x12,  -0x47,  +0x7C,  -0xB1,  +0x4000,  +0x11B,
+    -0x150,  x0xfi,  +0x1BA,  -0x1EF,  -0x24,  +0x59,  -0x4000,  -0xC3,
+    +0xF8,  x0xFI,  -0x162,  +0x197,  -0x1CC,  -0x01,  +0x4000,  -0x6B,
+    -0xA0,  x0xfi,  -0x10A,  -0x13F,  +0x174,  -0x1A9,  -0x4000,  +0x13,
+    -0x48,  x0xFI,  +0xB2,  -0xE7,  -0x11C,  +0x151,  +0x4000,  -0x1BB,
+    +0x1F0,  x0xfi,  -0x5A,  +0x8F,  -0xC4,  -0xF9,  -0x4000,  -0x163,
+    -0x198,  x0xFI,  -0x02,  -0x37,  +0x6C,  -0xA1,  +0x4000,  +0x10B
+};
+
+const float k_mix[2] = { +1.f, -2.f };
+const float k_mix_x2[4] = { +2.f, +1.f, -1.f, -1.f };
+
+const int16_t ref_mix_i16[ref_n] = {
+    x0xmm,  x0xMM,  +0xD2,  -0x13B,  x0xMM,  +0x20D,  +0x7FFA,  +0x2ED,
+    +0x340,  x0xmm,  +0x36,  +0x7B,  -0x10C,  x0xMM,  x0xmm,  -0x24D,
+    +0x2C0,  x0xMM,  x0xmm,  +0x3BB,  +0x24,  -0xD7,  x0xMM,  +0x15F,
+    -0x220,  x0xmm,  +0x2F6,  x0xmm,  +0x3CC,  +0x37,  -0x7FCA,  x0xMM,
+    x0xMM,  x0xMM,  +0x256,  +0x2C1,  x0xmm,  +0x397,  +0x7FBA,  -0x6D,
+    +0xE0,  -0x7FFF,  -0x1B6,  +0x17B,  +0x28C,  x0xmm,  -0x7FAA,  +0x3CD,
+    -0x380,  x0xMM,  x0xMM,  -0xBB,  +0x124,  +0x257,  +0x00,  +0x25F,
+    +0x2C0,  x0xmm,  +0x76,  x0xMM,  -0x64,  +0xCD,  x0xmm,  x0xmm
+};
+
+const int16_t ref_mix_i16x2[ref_n] = {
+    x0xmm,  x0xMM,  +0x66,  -0x9C,  x0xMM,  +0x104,  +0x3FF4,  +0x17A,
+    +0x188,  x0xmm,  +0x36,  +0x34,  -0xA4,  x0xMM,  -0x402C,  -0x132,
+    +0x190,  x0xMM,  x0xmm,  +0x1CC,  -0x24,  -0x7E,  x0xMM,  +0x9C,
+    -0x158,  x0xmm,  +0x1C6,  x0xmm,  +0x234,  +0x36,  -0x3F94,  x0xMM,
+    x0xMM,  +0x7FBF,  +0x18E,  +0x182,  x0xmm,  +0x1EE,  +0x3F74,  -0x5A,
+    +0xE8,  +0x00,  -0x156,  +0x94,  +0x1C4,  x0xmm,  -0x3F54,  +0x212,
+    -0x130,  +0x7F9F,  x0xMM,  -0x2C,  -0x04,  +0x15E,  x0xmm,  +0xFC,
+    +0xB8,  -0x7F8E,  +0xE6,  x0xMM,  +0x7C,  +0x2C,  -0x40EC,  x0xmm
+};
+
+const float ref_mix_f32[ref_n] = {
+    -32768.f,  +65535.f,  +210.f,  -315.f,  +33191.f,  +525.f,  +32762.f,  +749.f,
+    +832.f,  -98302.f,  +54.f,  +123.f,  -268.f,  +33121.f,  -32790.f,  -589.f,
+    +704.f,  +65569.f,  -33652.f,  +955.f,  +36.f,  -215.f,  +65535.f,  +351.f,
+    -544.f,  -65583.f,  +758.f,  -33582.f,  +972.f,  +55.f,  -32714.f,  +32981.f,
+    +33087.f,  +65471.f,  +598.f,  +705.f,  -33512.f,  +919.f,  +32698.f,  -109.f,
+    +224.f,  -32767.f,  -438.f,  +379.f,  +652.f,  -33442.f,  -32682.f,  +973.f,
+    -896.f,  +65439.f,  +32947.f,  -187.f,  +292.f,  +599.f,  +0.f,  +607.f,
+    +704.f,  -65421.f,  +118.f,  +32877.f,  -100.f,  +205.f,  -32886.f,  -33302.f
+};
+
+const float ref_mix_f32x2[ref_n] = {
+    -65536.f,  +32767.f,  +102.f,  -156.f,  +65746.f,  +260.f,  +16372.f,  +378.f,
+    +392.f,  -65535.f,  +54.f,  +52.f,  -164.f,  +32944.f,  -16428.f,  -306.f,
+    +400.f,  +32801.f,  -65978.f,  +460.f,  -36.f,  -126.f,  +81918.f,  +156.f,
+    -344.f,  -32816.f,  +454.f,  -33175.f,  +564.f,  +54.f,  -16276.f,  +32874.f,
+    +65694.f,  +32703.f,  +398.f,  +386.f,  -65908.f,  +494.f,  +16244.f,  -90.f,
+    +232.f,  +0.f,  -342.f,  +148.f,  +452.f,  -33105.f,  -16212.f,  +530.f,
+    -304.f,  +32671.f,  +65624.f,  -44.f,  -4.f,  +350.f,  -49152.f,  +252.f,
+    +184.f,  -32654.f,  +230.f,  +32822.f,  +124.f,  +44.f,  -16620.f,  -33035.f
+};
+
+const int32_t src_acc_i32[ref_n] = {
+    x32MM,  -0x7FFFFFF0,  -0x1000,  -0x12345678,
+    +0x7FFFFFEF,  -0x7FFFFFF0,  +0x3000,  -0x12345678,
+    +0x7FFFFFEF,  -0x7FFFFFF0,  +0x0,  -0x12345678,
+    +0x7FFFFFEF,  -0x7FFFFFF0,  -0x3000,  -0x12345678,
+    +0x7FFFFFEF,  -0x7FFFFFF0,  +0x1000,  -0x12345678,
+    +0x7FFFFFEF,  -0x7FFFFFF0,  -0x2000,  -0x12345678,
+    +0x7FFFFFEF,  -0x7FFFFFF0,  +0x2000,  -0x12345678,
+    +0x7FFFFFEF,  -0x7FFFFFF0,  -0x1000,  -0x12345678,
+    +0x7FFFFFEF,  -0x7FFFFFF0,  +0x3000,  -0x12345678,
+    +0x7FFFFFEF,  -0x7FFFFFF0,  +0x0,  -0x12345678,
+    +0x7FFFFFEF,  -0x7FFFFFF0,  -0x3000,  -0x12345678,
+    +0x7FFFFFEF,  -0x7FFFFFF0,  +0x1000,  -0x12345678,
+    +0x7FFFFFEF,  -0x7FFFFFF0,  -0x2000,  -0x12345678,
+    +0x7FFFFFEF,  -0x7FFFFFF0,  +0x2000,  -0x12345678,
+    +0x7FFFFFEF,  -0x7FFFFFF0,  -0x1000,  -0x12345678,
+    +0x7FFFFFEF,  -0x7FFFFFF0,  +0x3000,  x32mm
+};
+
+const int32_t ref_mix_i16_i32[ref_n] = {
+    +0x7FFF7FFF,  -0x7FFEFFF1,  -0xF2E,  -0x123457B3,
+    x32MM,  -0x7FFFFDE3,  +0xAFFA,  -0x1234538B,
+    x32MM,  x32mm,  +0x36,  -0x123455FD,
+    +0x7FFFFEE3,  -0x7FFF7E8F,  -0xB016,  -0x123458C5,
+    x32MM,  -0x7FFEFFCF,  -0x7374,  -0x123452BD,
+    x32MM,  x32mm,  +0xDFFF,  -0x12345519,
+    +0x7FFFFDCF,  x32mm,  +0x22F6,  -0x1234D9A6,
+    x32MM,  -0x7FFFFFB9,  -0x8FCA,  -0x1233D5A3,
+    x32MM,  -0x7FFF0031,  +0x3256,  -0x123453B7,
+    +0x7FFF7D07,  -0x7FFFFC59,  +0x7FBA,  -0x123456E5,
+    x32MM,  x32mm,  -0x31B6,  -0x123454FD,
+    x32MM,  x32mm,  -0x6FAA,  -0x123452AB,
+    +0x7FFFFC6F,  -0x7FFF0051,  +0x60B3,  -0x12345733,
+    x32MM,  -0x7FFFFD99,  +0x2000,  -0x12345419,
+    x32MM,  x32mm,  -0xF8A,  -0x1233D60B,
+    +0x7FFFFF8B,  -0x7FFFFF23,  -0x5076,  x32mm
+};
+
+const int32_t ref_mix_i16x2_i32[ref_n] = {
+    +0x7FFEFFFF,  -0x7FFF7FF1,  -0xF9A,  -0x12345714,
+    x32MM,  -0x7FFFFEEC,  +0x6FF4,  -0x123454FE,
+    x32MM,  x32mm,  +0x36,  -0x12345644,
+    +0x7FFFFF4B,  -0x7FFF7F40,  -0x702C,  -0x123457AA,
+    x32MM,  -0x7FFF7FCF,  -0xF1BA,  -0x123454AC,
+    +0x7FFFFFCB,  x32mm,  +0x11FFE,  -0x123455DC,
+    +0x7FFFFE97,  x32mm,  +0x21C6,  -0x1234D80F,
+    x32MM,  -0x7FFFFFBA,  -0x4F94,  -0x1233D60E,
+    x32MM,  -0x7FFF8031,  +0x318E,  -0x123454F6,
+    +0x7FFEFE7B,  -0x7FFFFE02,  +0x3F74,  -0x123456D2,
+    x32MM,  -0x7FFFFFF0,  -0x3156,  -0x123455E4,
+    x32MM,  x32mm,  -0x2F54,  -0x12345466,
+    +0x7FFFFEBF,  -0x7FFF8051,  +0xE058,  -0x123456A4,
+    +0x7FFFFFEB,  -0x7FFFFE92,  -0xA000,  -0x1234557C,
+    x32MM,  x32mm,  -0xF1A,  -0x1233D642,
+    x32MM,  -0x7FFFFFC4,  -0x10EC,  x32mm
+};
+
+const int32_t src_i32[ref_n] = {
+    x32mm,  +0x49E6,  -0xD93A,  -0x8001,
+    +0xF582,  -0x13AD0,  -0x8001,  +0x1FC76,
+    -0x1D8C5,  +0x7FFF,  +0x17588,  +0xFA9F,
+    +0x7FFF,  +0x178F8,  +0x126C7,  x32MM,
+    -0x189CC,  -0x1243E,  +0x0,  -0x100EB,
+    +0x101C1,  x32MM,  -0x13BEC,  -0xB710,
+    +0x7FFF,  +0x1F7C2,  -0xF86A,  +0x0,
+    +0x11845,  +0x2CEC,  +0x7FFF,  -0x8B98,
+    +0x103F1,  x32mm,  -0x19BD0,  -0x182A4,
+    x32MM,  -0x1823D,  -0xAC98,  +0x8000,
+    +0x33C5,  -0x16237,  +0x7FFF,  -0x12CF9,
+    -0x182FE,  x32mm,  +0x1A8CC,  +0xA673,
+    +0x8000,  +0x182A3,  -0xAA5C,  x32MM,
+    -0x15BDA,  +0x8E6C,  x32mm,  +0x251F,
+    +0xF1C5,  -0x8000,  -0x830F,  -0x16FEC,
+    +0x7FFF,  -0x117F6,  +0x6044,  -0x8001
+};
+
+const int16_t ref_i32_i16[ref_n] = {
+    x0xmm,  +0x49E6,  x0xmm,  x0xmm,  x0xMM,  x0xmm,  x0xmm,  x0xMM,
+    x0xmm,  x0xMM,  x0xMM,  x0xMM,  x0xMM,  x0xMM,  x0xMM,  x0xMM,
+    x0xmm,  x0xmm,  +0x00,  x0xmm,  x0xMM,  x0xMM,  x0xmm,  x0xmm,
+    x0xMM,  x0xMM,  x0xmm,  +0x00,  x0xMM,  +0x2CEC,  x0xMM,  x0xmm,
+    x0xMM,  x0xmm,  x0xmm,  x0xmm,  x0xMM,  x0xmm,  x0xmm,  x0xMM,
+    +0x33C5,  x0xmm,  x0xMM,  x0xmm,  x0xmm,  x0xmm,  x0xMM,  x0xMM,
+    x0xMM,  x0xMM,  x0xmm,  x0xMM,  x0xmm,  x0xMM,  x0xmm,  +0x251F,
+    x0xMM,  x0xmm,  x0xmm,  x0xmm,  x0xMM,  x0xmm,  +0x6044,  x0xmm
+};
+
+
+void print_i16(FILE* fp, const int16_t* vp, size_t n)
+{
+    fprintf(fp, "{ ");
+    while (n--) {
+        int i = (int)*vp++;
+        char sc = ((i < 0) ? '-' : ((i > 0) ? '+' : ' '));
+        if (i < 0) i = -i;
+        fprintf(fp, "%c%04Xh,  ", sc, (unsigned)i);
+    }
+    fprintf(fp, "}\n");
+}
+
+
+void print_i32(FILE* fp, const int32_t* vp, size_t n)
+{
+    fprintf(fp, "{ ");
+    while (n--) {
+        long i = (long)*vp++;
+        char sc = ((i < 0) ? '-' : ((i > 0) ? '+' : ' '));
+        if (i < 0) i = -i;
+        fprintf(fp, "%c%08lXh,  ", sc, (unsigned long)i);
+    }
+    fprintf(fp, "}\n");
+}
+
+
+void print_f32(FILE* fp, const float* vp, size_t n)
+{
+    fprintf(fp, "{ ");
+    while (n--) {
+        fprintf(fp, "%+6.2f,  ", *vp++);
+    }
+    fprintf(fp, "}\n");
+}
+
+
+const int16_t* compare_i16(const int16_t* bufp, const int16_t* refp, size_t len)
+{
+    while (len--) {
+        if (*bufp != *refp) {
+            return bufp;
+        }
+        ++bufp;
+        ++refp;
+    }
+    return NULL;
+}
+
+
+const int32_t* compare_i32(const int32_t* bufp, const int32_t* refp, size_t len)
+{
+    while (len--) {
+        if (*bufp != *refp) {
+            return bufp;
+        }
+        ++bufp;
+        ++refp;
+    }
+    return NULL;
+}
+
+
+const float* compare_f32(const float* bufp, const float* refp, size_t len, float epsilon)
+{
+    while (len--) {
+        if (fabsf(*bufp - *refp) > epsilon) {
+            return bufp;
+        }
+        ++bufp;
+        ++refp;
+    }
+    return NULL;
+}
+
+
+const void* compare_dirty(const void* bufp, uint8_t refv, size_t size)
+{
+    const uint8_t* sp = bufp;
+    const uint8_t* ep = (sp + size);
+    while (sp != ep) {
+        if (*sp != refv) {
+            return sp;
+        }
+        ++sp;
+    }
+    return NULL;
+}
+
@@ -0,0 +1,242 @@
+/*
+AYMO - Accelerated YaMaha Operator
+Copyright (c) 2023-2024 Andrea Zoppi.
+
+This file is part of AYMO.
+
+AYMO is free software: you can redistribute it and/or modify it under the
+terms of the GNU Lesser General Public License as published by the Free
+Software Foundation, either version 2.1 of the License, or (at your option)
+any later version.
+
+AYMO is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with AYMO. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "aymo.h"
+#ifdef AYMO_CPU_SUPPORT_X86_SSE41
+
+#include "aymo_file.h"
+#include "aymo_testing.h"
+#define AYMO_KEEP_SHORTHANDS
+#include "aymo_mix_x86_sse41.h"
+
+#include "test_mix_prologue_inline.h"
+
+
+void test_aymo_mix_x86_sse41_i16_k(void)
+{
+    unsigned si, ei; int line = 0;
+    for (si = 0; si < ref_n; ++si) {
+        for (ei = si; ei < ref_n; ++ei) {
+            const int16_t* const xv[ref_m] = { &src_a_i16[si], &src_b_i16[si] };
+            memset(buf_i16, (int)DIRTY, sizeof(buf_i16));
+            aymo_(i16_k)((ei - si), ref_m, xv, k_mix, &buf_i16[si]);
+            if (compare_dirty(&buf_i16[0], DIRTY, (si * sizeof(buf_i16[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_i16(&buf_i16[si], &ref_mix_i16[si], (ei - si))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_i16[ei], DIRTY, ((ref_n - ei) * sizeof(buf_i16[0])))) {
+                line = __LINE__; goto error_;
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  si=%u, ei=%u\n", __func__, line, si, ei);
+    print_i16(stderr, buf_i16, ref_n);
+    print_i16(stderr, ref_mix_i16, ref_n);
+}
+
+
+void test_aymo_mix_x86_sse41_i16x2_k(void)
+{
+    unsigned si, ei; int line = 0;
+    for (si = 0; si < ref_n2; ++si) {
+        for (ei = si; ei < ref_n2; ++ei) {
+            const int16_t* const xv[ref_m] = { &src_a_i16[si * 2u], &src_b_i16[si * 2u] };
+            memset(buf_i16, (int)DIRTY, sizeof(buf_i16));
+            aymo_(i16x2_k)((ei - si), ref_m, xv, k_mix_x2, &buf_i16[si * 2u]);
+            if (compare_dirty(&buf_i16[0], DIRTY, ((si * 2u) * sizeof(buf_i16[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_i16(&buf_i16[si * 2u], &ref_mix_i16x2[si * 2u], ((ei - si) * 2u))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_i16[ei * 2u], DIRTY, ((ref_n - (ei * 2u)) * sizeof(buf_i16[0])))) {
+                line = __LINE__; goto error_;
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  si=%u, ei=%u\n", __func__, line, si, ei);
+    print_i16(stderr, buf_i16, ref_n);
+    print_i16(stderr, ref_mix_i16x2, ref_n);
+}
+
+
+void test_aymo_mix_x86_sse41_f32_k(void)
+{
+    unsigned si, ei; int line = 0;
+    for (si = 0; si < ref_n; ++si) {
+        for (ei = si; ei < ref_n; ++ei) {
+            const float* const xv[ref_m] = { &src_a_f32[si], &src_b_f32[si] };
+            memset(buf_f32, (int)DIRTY, sizeof(buf_f32));
+            aymo_(f32_k)((ei - si), ref_m, xv, k_mix, &buf_f32[si]);
+            if (compare_dirty(&buf_f32[0], DIRTY, (si * sizeof(buf_f32[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_f32(&buf_f32[si], &ref_mix_f32[si], (ei - si), 0)) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_f32[ei], DIRTY, ((ref_n - ei) * sizeof(buf_f32[0])))) {
+                line = __LINE__; goto error_;
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  si=%u, ei=%u\n", __func__, line, si, ei);
+    print_f32(stderr, buf_f32, ref_n);
+    print_f32(stderr, ref_mix_f32, ref_n);
+}
+
+
+void test_aymo_mix_x86_sse41_f32x2_k(void)
+{
+    unsigned si, ei; int line = 0;
+    for (si = 0; si < ref_n2; ++si) {
+        for (ei = si; ei < ref_n2; ++ei) {
+            const float* const xv[ref_m] = { &src_a_f32[si * 2u], &src_b_f32[si * 2u] };
+            memset(buf_f32, (int)DIRTY, sizeof(buf_f32));
+            aymo_(f32x2_k)((ei - si), ref_m, xv, k_mix_x2, &buf_f32[si * 2u]);
+            if (compare_dirty(&buf_f32[0], DIRTY, ((si * 2u) * sizeof(buf_f32[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_f32(&buf_f32[si * 2u], &ref_mix_f32x2[si * 2u], ((ei - si) * 2u), 0)) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_f32[ei * 2u], DIRTY, ((ref_n - (ei * 2u)) * sizeof(buf_f32[0])))) {
+                line = __LINE__; goto error_;
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  si=%u, ei=%u\n", __func__, line, si, ei);
+    print_f32(stderr, buf_f32, ref_n);
+    print_f32(stderr, ref_mix_f32x2, ref_n);
+}
+
+
+void test_aymo_mix_x86_sse41_i16_i32_k(void)
+{
+    unsigned si, ei; int line = 0;
+    for (si = 0; si < ref_n; ++si) {
+        for (ei = si; ei < ref_n; ++ei) {
+            const int16_t* const xv[ref_m] = { &src_a_i16[si], &src_b_i16[si] };
+            memcpy(buf_i32, src_acc_i32, sizeof(buf_i32));
+            aymo_(i16_i32_k)((ei - si), ref_m, xv, k_mix, &buf_i32[si]);
+            if (compare_i32(&buf_i32[0], &src_acc_i32[0], si)) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_i32(&buf_i32[si], &ref_mix_i16_i32[si], (ei - si))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_i32(&buf_i32[ei], &src_acc_i32[ei], (ref_n - ei))) {
+                line = __LINE__; goto error_;
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  si=%u, ei=%u\n", __func__, line, si, ei);
+    print_i32(stderr, buf_i32, ref_n);
+    print_i32(stderr, ref_mix_i16_i32, ref_n);
+}
+
+
+void test_aymo_mix_x86_sse41_i16x2_i32_k(void)
+{
+    unsigned si, ei; int line = 0;
+    for (si = 0; si < ref_n2; ++si) {
+        for (ei = si; ei < ref_n2; ++ei) {
+            const int16_t* const xv[ref_m] = { &src_a_i16[si * 2u], &src_b_i16[si * 2u] };
+            memcpy(buf_i32, src_acc_i32, sizeof(buf_i32));
+            aymo_(i16x2_i32_k)((ei - si), ref_m, xv, k_mix_x2, &buf_i32[si * 2u]);
+            if (compare_i32(&buf_i32[0], &src_acc_i32[0], (si * 2u))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_i32(&buf_i32[si * 2u], &ref_mix_i16x2_i32[si * 2u], ((ei - si) * 2u))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_i32(&buf_i32[ei * 2u], &src_acc_i32[ei * 2u], (ref_n - (ei * 2u)))) {
+                line = __LINE__; goto error_;
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  si=%u, ei=%u\n", __func__, line, si, ei);
+    print_i32(stderr, buf_i32, ref_n);
+    print_i32(stderr, ref_mix_i16x2_i32, ref_n);
+}
+
+
+void test_aymo_mix_x86_sse41_i32_i16(void)
+{
+    unsigned si, ei; int line = 0;
+    for (si = 0; si < ref_n; ++si) {
+        for (ei = si; ei < ref_n; ++ei) {
+            memset(buf_i16, (int)DIRTY, sizeof(buf_i16));
+            aymo_(i32_i16)((ei - si), &src_i32[si], &buf_i16[si]);
+            if (compare_dirty(&buf_i16[0], DIRTY, (si * sizeof(buf_i16[0])))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_i16(&buf_i16[si], &ref_i32_i16[si], (ei - si))) {
+                line = __LINE__; goto error_;
+            }
+            if (compare_dirty(&buf_i16[ei], DIRTY, ((ref_n - ei) * sizeof(buf_i16[0])))) {
+                line = __LINE__; goto error_;
+            }
+        }
+    }
+    return;
+error_:
+    app_return = TEST_STATUS_FAIL;
+    fprintf(stderr, "%s @ %d:  si=%u, ei=%u\n", __func__, line, si, ei);
+    print_i16(stderr, buf_i16, ref_n);
+    print_i16(stderr, ref_i32_i16, ref_n);
+}
+
+
+struct aymo_testing_entry unit_tests[] =
+{
+    AYMO_TEST_ENTRY(test_aymo_mix_x86_sse41_i16_k),
+    AYMO_TEST_ENTRY(test_aymo_mix_x86_sse41_i16x2_k),
+    AYMO_TEST_ENTRY(test_aymo_mix_x86_sse41_f32_k),
+    AYMO_TEST_ENTRY(test_aymo_mix_x86_sse41_f32x2_k),
+    AYMO_TEST_ENTRY(test_aymo_mix_x86_sse41_i16_i32_k),
+    AYMO_TEST_ENTRY(test_aymo_mix_x86_sse41_i16x2_i32_k),
+    AYMO_TEST_ENTRY(test_aymo_mix_x86_sse41_i32_i16)
+};
+
+
+#include "aymo_testing_epilogue_inline.h"
+
+
+#endif  // AYMO_CPU_SUPPORT_X86_SSE41
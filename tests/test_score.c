@@ -0,0 +1,653 @@
+/*
+AYMO - Accelerated YaMaha Operator
+Copyright (c) 2023-2024 Andrea Zoppi.
+
+This file is part of AYMO.
+
+AYMO is free software: you can redistribute it and/or modify it under the
+terms of the GNU Lesser General Public License as published by the Free
+Software Foundation, either version 2.1 of the License, or (at your option)
+any later version.
+
+AYMO is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with AYMO. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "aymo_score.h"
+#include "aymo_score_dro.h"
+#include "aymo_score_imf.h"
+#include "aymo_score_raw.h"
+#include "aymo_score_ref.h"
+#include "aymo_score_vgm.h"
+#include "aymo_testing.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+AYMO_CXX_EXTERN_C_BEGIN
+
+
+/*
+Scores are synthesized in memory from a pseudo-random sequence of generic
+operations, encoded into each format with its own sticky states (register
+bank, clock).
+Seeking through the index and scanning registers must match a reference
+walk of a twin score, which ticks one sample at a time from the very start.
+*/
+
+enum op_type {
+    op_type_write,
+    op_type_delay,
+    op_type_clock  // RAW only
+};
+
+struct op {
+    uint8_t type;
+    uint8_t bank;
+    uint8_t address;
+    uint8_t value;  // delay units for op_type_delay
+};
+
+struct event {
+    uint32_t time;
+    uint16_t address;
+    uint8_t value;
+};
+
+#define OP_MAX      240u
+#define EVENT_MAX   (OP_MAX + 16u)
+#define INDEX_MAX   4096u
+#define DATA_MAX    (0x40u + (OP_MAX * 8u) + 256u)
+
+static int app_return;
+
+static struct op ops[OP_MAX];
+static uint8_t addresses[128];
+static unsigned addresses_length;
+
+static uint8_t data[DATA_MAX];
+static char text[OP_MAX * 16u];
+static struct aymo_score_event parsed[EVENT_MAX];
+
+static struct event full[EVENT_MAX];
+static uint32_t full_length;
+static struct event tail[EVENT_MAX];
+
+static struct aymo_score_checkpoint index_[INDEX_MAX];
+
+static union {
+    struct aymo_score_instance base;
+    struct aymo_score_dro_instance dro;
+    struct aymo_score_imf_instance imf;
+    struct aymo_score_raw_instance raw;
+    struct aymo_score_ref_instance ref;
+    struct aymo_score_vgm_instance vgm;
+} score, linear;
+
+
+static void check(int condition, const char* func, const char* what, uint32_t time)
+{
+    if (!condition) {
+        app_return = TEST_STATUS_FAIL;
+        fprintf(stderr, "%s: %s @ %lu\n", func, what, (unsigned long)time);
+    }
+}
+
+
+static uint32_t rng_state;
+
+static uint32_t rng(void)
+{
+    rng_state = ((rng_state * 1664525uL) + 1013904223uL);
+    return (rng_state >> 8u);
+}
+
+
+static void put_u16le(uint8_t* ptr, uint32_t value)
+{
+    ptr[0] = (uint8_t)value;
+    ptr[1] = (uint8_t)(value >> 8u);
+}
+
+
+static void put_u32le(uint8_t* ptr, uint32_t value)
+{
+    ptr[0] = (uint8_t)value;
+    ptr[1] = (uint8_t)(value >> 8u);
+    ptr[2] = (uint8_t)(value >> 16u);
+    ptr[3] = (uint8_t)(value >> 24u);
+}
+
+
+// Low addresses avoiding the special codes of all the formats
+static void addresses_setup(void)
+{
+    static const uint8_t ranges[][2] = {
+        { 0x01u, 0x01u }, { 0x04u, 0x04u }, { 0x08u, 0x08u }, { 0xBDu, 0xBDu },
+        { 0x20u, 0x35u }, { 0x40u, 0x55u }, { 0xA0u, 0xA8u }, { 0xB0u, 0xB8u },
+        { 0xC0u, 0xC8u }, { 0xE0u, 0xF5u }
+    };
+    addresses_length = 0u;
+    for (unsigned i = 0u; i < (sizeof(ranges) / sizeof(ranges[0])); ++i) {
+        for (unsigned a = ranges[i][0]; a <= ranges[i][1]; ++a) {
+            addresses[addresses_length++] = (uint8_t)a;
+        }
+    }
+}
+
+
+static void ops_generate(uint32_t seed)
+{
+    rng_state = seed;
+    addresses_setup();
+
+    for (unsigned i = 0u; i < OP_MAX; ++i) {
+        struct op* op = &ops[i];
+        uint32_t r = (rng() % 100u);
+
+        if ((r < 2u) && (i > 10u) && (i < (OP_MAX - 10u))) {
+            op->type = op_type_clock;
+            op->bank = 0u;
+            op->address = 0u;
+            op->value = (uint8_t)(1u + (rng() % 4u));
+        }
+        else if (r < 30u) {
+            op->type = op_type_delay;
+            op->bank = 0u;
+            op->address = 0u;
+            op->value = (uint8_t)(1u + (rng() % 20u));
+        }
+        else {
+            op->type = op_type_write;
+            op->bank = (uint8_t)((rng() % 4u) == 0u);
+            op->address = addresses[rng() % addresses_length];
+            op->value = (uint8_t)rng();
+        }
+    }
+}
+
+
+static uint32_t encode_dro_v1(void)
+{
+    uint8_t* ptr = &data[24];
+    unsigned bank = 0u;
+
+    for (unsigned i = 0u; i < OP_MAX; ++i) {
+        const struct op* op = &ops[i];
+        if (op->type == op_type_write) {
+            if (op->bank != bank) {
+                bank = op->bank;
+                *ptr++ = (uint8_t)(bank ? aymo_score_dro_v1_code_switch_high : aymo_score_dro_v1_code_switch_low);
+            }
+            if (op->address <= aymo_score_dro_v1_code_escape) {
+                *ptr++ = aymo_score_dro_v1_code_escape;
+            }
+            *ptr++ = op->address;
+            *ptr++ = op->value;
+        }
+        else if (op->type == op_type_delay) {
+            if (op->value > 16u) {
+                *ptr++ = aymo_score_dro_v1_code_delay_word;
+                put_u16le(ptr, ((op->value * 10u) - 1u));
+                ptr += 2u;
+            }
+            else {
+                *ptr++ = aymo_score_dro_v1_code_delay_byte;
+                *ptr++ = (uint8_t)(op->value - 1u);
+            }
+        }
+    }
+
+    uint32_t length = (uint32_t)(ptr - &data[24]);
+    memcpy(&data[0], AYMO_DRO_SIGNATURE, 8u);
+    put_u16le(&data[8], 1u);
+    put_u16le(&data[10], 0u);
+    put_u32le(&data[12], 0u);
+    put_u32le(&data[16], length);
+    data[20] = aymo_score_dro_v1_hardware_type_opl3;
+    data[21] = 0u;
+    data[22] = 0u;
+    data[23] = 0u;
+    return (24u + length);
+}
+
+
+static uint32_t encode_dro_v2(void)
+{
+    const uint8_t short_delay_code = 0x70u;
+    const uint8_t long_delay_code = 0x71u;
+    uint8_t* ptr = &data[26u + addresses_length];
+
+    for (unsigned i = 0u; i < OP_MAX; ++i) {
+        const struct op* op = &ops[i];
+        if (op->type == op_type_write) {
+            uint8_t code = 0u;
+            while (addresses[code] != op->address) {
+                ++code;
+            }
+            *ptr++ = (uint8_t)(code | (op->bank << 7u));
+            *ptr++ = op->value;
+        }
+        else if (op->type == op_type_delay) {
+            if (op->value == 20u) {
+                *ptr++ = long_delay_code;
+                *ptr++ = 0u;
+            }
+            else {
+                *ptr++ = short_delay_code;
+                *ptr++ = (uint8_t)((op->value * 3u) - 1u);
+            }
+        }
+    }
+
+    uint32_t length = (uint32_t)(ptr - &data[26u + addresses_length]);
+    memcpy(&data[0], AYMO_DRO_SIGNATURE, 8u);
+    put_u16le(&data[8], 2u);
+    put_u16le(&data[10], 0u);
+    put_u32le(&data[12], (length / 2u));
+    put_u32le(&data[16], 0u);
+    data[20] = aymo_score_dro_v2_hardware_type_opl3;
+    data[21] = aymo_score_dro_v2_format_interleaved;
+    data[22] = 0u;
+    data[23] = short_delay_code;
+    data[24] = long_delay_code;
+    data[25] = (uint8_t)addresses_length;
+    memcpy(&data[26], addresses, addresses_length);
+    return (26u + addresses_length + length);
+}
+
+
+static uint32_t encode_imf(void)
+{
+    // Type 0 (headerless) is guessed by a null first word
+    uint8_t* last = &data[0];
+    uint8_t* ptr = &data[4];
+    unsigned bank = 0u;
+    memset(&data[0], 0, 4u);
+
+    for (unsigned i = 0u; i < OP_MAX; ++i) {
+        const struct op* op = &ops[i];
+        if (op->type == op_type_write) {
+            if (op->bank != bank) {
+                bank = op->bank;
+                last = ptr;
+                *ptr++ = 0x05u;  // virtual bank register
+                *ptr++ = (uint8_t)bank;
+                *ptr++ = 0u;
+                *ptr++ = 0u;
+            }
+            last = ptr;
+            *ptr++ = op->address;
+            *ptr++ = op->value;
+            *ptr++ = 0u;
+            *ptr++ = 0u;
+        }
+        else if (op->type == op_type_delay) {
+            uint32_t delay = (last[2] | ((uint32_t)last[3] << 8u));
+            put_u16le(&last[2], (delay + op->value));
+        }
+    }
+    return (uint32_t)(ptr - &data[0]);
+}
+
+
+static uint32_t encode_raw(void)
+{
+    uint8_t* ptr = &data[10];
+    unsigned bank = 0u;
+
+    for (unsigned i = 0u; i < OP_MAX; ++i) {
+        const struct op* op = &ops[i];
+        if (op->type == op_type_write) {
+            if (op->bank != bank) {
+                bank = op->bank;
+                *ptr++ = (uint8_t)(bank ? 0x02u : 0x01u);
+                *ptr++ = 0x02u;
+            }
+            *ptr++ = op->value;
+            *ptr++ = op->address;
+        }
+        else if (op->type == op_type_delay) {
+            *ptr++ = op->value;
+            *ptr++ = 0x00u;
+        }
+        else if (op->type == op_type_clock) {
+            *ptr++ = 0x00u;
+            *ptr++ = 0x02u;
+            put_u16le(ptr, (0x0800u * op->value));
+            ptr += 2u;
+        }
+    }
+
+    memcpy(&data[0], "RAWADATA", 8u);
+    put_u16le(&data[8], 0x1000u);
+    return (uint32_t)(ptr - &data[0]);
+}
+
+
+static uint32_t encode_vgm(void)
+{
+    uint8_t* ptr = &data[0x40];
+    uint32_t total = 0u;
+
+    for (unsigned i = 0u; i < OP_MAX; ++i) {
+        const struct op* op = &ops[i];
+        if (op->type == op_type_write) {
+            *ptr++ = (uint8_t)(op->bank ? 0x5Fu : 0x5Eu);
+            *ptr++ = op->address;
+            *ptr++ = op->value;
+        }
+        else if (op->type == op_type_delay) {
+            if (op->value <= 16u) {
+                *ptr++ = (uint8_t)(0x70u + op->value - 1u);
+                total += op->value;
+            }
+            else if (op->value == 20u) {
+                *ptr++ = 0x62u;
+                total += 735u;
+            }
+            else {
+                *ptr++ = 0x61u;
+                put_u16le(ptr, (op->value * 50u));
+                ptr += 2u;
+                total += (op->value * 50u);
+            }
+        }
+    }
+    *ptr++ = 0x66u;
+
+    uint32_t size = (uint32_t)(ptr - &data[0]);
+    memset(&data[0], 0, 0x40u);
+    memcpy(&data[0], "Vgm ", 4u);
+    put_u32le(&data[0x04], (size - 0x04u));
+    put_u32le(&data[0x08], 0x151u);
+    put_u32le(&data[0x18], total);
+    put_u32le(&data[0x34], (0x40u - 0x34u));
+    return size;
+}
+
+
+static uint32_t encode_ref(void)
+{
+    char* ptr = text;
+    unsigned bank = 0u;
+
+    ptr += sprintf(ptr, "init\n");
+    for (unsigned i = 0u; i < OP_MAX; ++i) {
+        const struct op* op = &ops[i];
+        if (op->type == op_type_write) {
+            if (op->bank != bank) {
+                bank = op->bank;
+                ptr += sprintf(ptr, "setchip(%u)\n", bank);
+            }
+            ptr += sprintf(ptr, "%x <- %x\n", op->address, op->value);
+        }
+        else if (op->type == op_type_delay) {
+            unsigned rate = (100000u / op->value);  // [Hz * 100]
+            ptr += sprintf(ptr, "r%u.%02u\n", (rate / 100u), (rate % 100u));
+        }
+    }
+    return (uint32_t)(ptr - text);
+}
+
+
+// Ticks one sample at a time up to the target time, consuming all the events
+// found there; at most limit events are recorded, with their time
+static uint32_t walk(
+    struct aymo_score_instance* instance,
+    uint32_t elapsed,
+    uint32_t time,
+    uint8_t regs[],
+    uint8_t written[],
+    struct event events[],
+    uint32_t* length,
+    uint32_t limit
+)
+{
+    struct aymo_score_status* status = aymo_score_get_status(instance);
+    uint32_t found = *length;
+
+    while (!(status->flags & AYMO_SCORE_FLAG_EOF) && (found < limit)) {
+        if ((elapsed >= time) && (status->flags & AYMO_SCORE_FLAG_DELAY)) {
+            break;
+        }
+        elapsed += aymo_score_tick(instance, ((elapsed < time) ? 1u : 0u));
+
+        if (status->flags & AYMO_SCORE_FLAG_EVENT) {
+            uint16_t address = status->address;
+            if (regs && (address < AYMO_YMF262_REG_NUM)) {
+                regs[address] = status->value;
+                written[address >> 3u] |= (uint8_t)(1u << (address & 7u));
+            }
+            events[found].time = elapsed;
+            events[found].address = address;
+            events[found].value = status->value;
+            ++found;
+        }
+    }
+    *length = found;
+    return elapsed;
+}
+
+
+static int compare_u32(const void* a, const void* b)
+{
+    uint32_t x = *(const uint32_t*)a;
+    uint32_t y = *(const uint32_t*)b;
+    return ((x > y) - (x < y));
+}
+
+
+// Seeks to increasing times, against a linear walk carried along by a twin score
+static void check_seeks(const char* func, uint32_t period, uint32_t times[], unsigned count)
+{
+    struct aymo_score_status* status = aymo_score_get_status(&score.base);
+    struct aymo_score_status* status_ref = aymo_score_get_status(&linear.base);
+    uint8_t regs_ref[AYMO_YMF262_REG_NUM];
+    uint8_t written_ref[AYMO_YMF262_REG_NUM / 8u];
+    uint8_t regs[AYMO_YMF262_REG_NUM];
+    uint8_t written[AYMO_YMF262_REG_NUM / 8u];
+    uint32_t reached_ref = 0u;
+    uint32_t consumed = 0u;
+
+    uint32_t length = aymo_score_index_build(&score.base, index_, INDEX_MAX, period);
+    check((length > 1u), func, "index length", period);
+
+    qsort(times, count, sizeof(times[0]), compare_u32);
+    memset(regs_ref, 0, sizeof(regs_ref));
+    memset(written_ref, 0, sizeof(written_ref));
+    aymo_score_restart(&linear.base);
+
+    for (unsigned t = 0u; t < count; ++t) {
+        uint32_t time = times[t];
+        reached_ref = walk(&linear.base, reached_ref, time, regs_ref, written_ref, full, &consumed, EVENT_MAX);
+
+        uint32_t reached = aymo_score_seek(&score.base, index_, length, time);
+        check((reached == reached_ref), func, "seek time", time);
+        check((status->delay == status_ref->delay), func, "seek delay", time);
+        check((status->flags == status_ref->flags), func, "seek flags", time);
+
+        // The next few events must follow seamlessly
+        uint32_t remaining = 0u;
+        walk(&score.base, reached, UINT32_MAX, NULL, NULL, tail, &remaining, 4u);
+        check(((consumed + remaining) <= full_length), func, "seek events", time);
+        for (uint32_t i = 0u; (i < remaining) && ((consumed + i) < full_length); ++i) {
+            const struct event* expected = &full[consumed + i];
+            if ((tail[i].time != expected->time) ||
+                (tail[i].address != expected->address) ||
+                (tail[i].value != expected->value)) {
+                check(0, func, "seek event", time);
+                break;
+            }
+        }
+
+        memset(regs, 0, sizeof(regs));
+        reached = aymo_score_scan_registers(&score.base, time, regs, written);
+        check((reached == reached_ref), func, "scan time", time);
+        check(!memcmp(regs, regs_ref, sizeof(regs)), func, "scan regs", time);
+        check(!memcmp(written, written_ref, sizeof(written)), func, "scan written", time);
+    }
+}
+
+
+static void check_score(const char* func)
+{
+    static uint32_t times[(EVENT_MAX * 2u) + 16u];
+    uint8_t regs[AYMO_YMF262_REG_NUM];
+    uint8_t written[AYMO_YMF262_REG_NUM / 8u];
+
+    full_length = 0u;
+    aymo_score_restart(&linear.base);
+    uint32_t end = walk(&linear.base, 0u, UINT32_MAX, regs, written, full, &full_length, EVENT_MAX);
+    check(((full_length > (OP_MAX / 2u)) && (full_length < EVENT_MAX)), func, "events", full_length);
+
+    static const uint32_t periods[] = { 1u, 37u, 1000u, 4096u };
+    for (unsigned p = 0u; p < (sizeof(periods) / sizeof(periods[0])); ++p) {
+        uint32_t period = periods[p];
+        unsigned count = 0u;
+
+        // Right at, before, and after each event; around the checkpoints
+        for (uint32_t i = 0u; i < full_length; ++i) {
+            times[count++] = full[i].time;
+            times[count++] = (full[i].time - (uint32_t)(full[i].time > 0u));
+        }
+        times[count++] = (period - 1u);
+        times[count++] = period;
+        times[count++] = (period + 1u);
+        times[count++] = (period * 2u);
+        times[count++] = (end / 3u);
+        times[count++] = (end - 1u);
+        times[count++] = end;
+        times[count++] = (end + 1000u);
+        for (unsigned t = 0u; t < 8u; ++t) {
+            times[count++] = (rng() % (end + 1u));
+        }
+        check_seeks(func, period, times, count);
+
+        // Restore the full event list, overwritten by the linear walk
+        full_length = 0u;
+        aymo_score_restart(&linear.base);
+        walk(&linear.base, 0u, UINT32_MAX, regs, written, full, &full_length, EVENT_MAX);
+    }
+}
+
+
+// Loads both the score under test and its linear twin
+static void load_score(const struct aymo_score_vt* vt, const void* blob, uint32_t size, const char* func)
+{
+    score.base.vt = vt;
+    aymo_score_ctor(&score.base);
+    check(!aymo_score_load(&score.base, blob, size), func, "load", size);
+
+    linear.base.vt = vt;
+    aymo_score_ctor(&linear.base);
+    check(!aymo_score_load(&linear.base, blob, size), func, "load", size);
+}
+
+
+static void unload_score(void)
+{
+    aymo_score_dtor(&linear.base);
+    aymo_score_dtor(&score.base);
+}
+
+
+void test_aymo_score_dro_v1_seek(void)
+{
+    ops_generate(0x1234u);
+    uint32_t size = encode_dro_v1();
+    load_score(&aymo_score_dro_vt, data, size, __func__);
+    check_score(__func__);
+    unload_score();
+}
+
+
+void test_aymo_score_dro_v2_seek(void)
+{
+    ops_generate(0x2345u);
+    uint32_t size = encode_dro_v2();
+    load_score(&aymo_score_dro_vt, data, size, __func__);
+    check_score(__func__);
+    unload_score();
+}
+
+
+void test_aymo_score_imf_seek(void)
+{
+    ops_generate(0x3456u);
+    uint32_t size = encode_imf();
+    load_score(&aymo_score_imf_vt, data, size, __func__);
+    check((score.imf.type == 0u), __func__, "type", score.imf.type);
+    check_score(__func__);
+    unload_score();
+}
+
+
+void test_aymo_score_raw_seek(void)
+{
+    ops_generate(0x4567u);
+    uint32_t size = encode_raw();
+    load_score(&aymo_score_raw_vt, data, size, __func__);
+    check_score(__func__);
+    unload_score();
+}
+
+
+void test_aymo_score_vgm_seek(void)
+{
+    ops_generate(0x5678u);
+    uint32_t size = encode_vgm();
+    load_score(&aymo_score_vgm_vt, data, size, __func__);
+    check_score(__func__);
+    unload_score();
+}
+
+
+void test_aymo_score_ref_seek(void)
+{
+    ops_generate(0x6789u);
+    uint32_t size = encode_ref();
+    load_score(&aymo_score_ref_vt, text, size, __func__);
+    check_score(__func__);
+    unload_score();
+}
+
+
+void test_aymo_score_ref_events_seek(void)
+{
+    ops_generate(0x789Au);
+    uint32_t size = encode_ref();
+    uint32_t tail_delay = 0u;
+    uint32_t length = aymo_score_ref_parse(text, size, parsed, EVENT_MAX, &tail_delay);
+    check((length <= EVENT_MAX), __func__, "parse", length);
+
+    score.base.vt = &aymo_score_ref_vt;
+    aymo_score_ctor(&score.base);
+    check(!aymo_score_ref_load_events(&score.ref, parsed, length, tail_delay), __func__, "load", length);
+    linear.base.vt = &aymo_score_ref_vt;
+    aymo_score_ctor(&linear.base);
+    check(!aymo_score_ref_load_events(&linear.ref, parsed, length, tail_delay), __func__, "load", length);
+    check_score(__func__);
+    unload_score();
+}
+
+
+struct aymo_testing_entry unit_tests[] =
+{
+    AYMO_TEST_ENTRY(test_aymo_score_dro_v1_seek),
+    AYMO_TEST_ENTRY(test_aymo_score_dro_v2_seek),
+    AYMO_TEST_ENTRY(test_aymo_score_imf_seek),
+    AYMO_TEST_ENTRY(test_aymo_score_raw_seek),
+    AYMO_TEST_ENTRY(test_aymo_score_vgm_seek),
+    AYMO_TEST_ENTRY(test_aymo_score_ref_seek),
+    AYMO_TEST_ENTRY(test_aymo_score_ref_events_seek)
+};
+
+
+#include "aymo_testing_epilogue_inline.h"
@@ -0,0 +1,380 @@
+/*
+AYMO - Accelerated YaMaha Operator
+Copyright (c) 2023-2024 Andrea Zoppi.
+
+This file is part of AYMO.
+
+AYMO is free software: you can redistribute it and/or modify it under the
+terms of the GNU Lesser General Public License as published by the Free
+Software Foundation, either version 2.1 of the License, or (at your option)
+any later version.
+
+AYMO is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with AYMO. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "aymo.h"
+#include "aymo_score.h"
+#include "aymo_score_ref.h"
+#include "aymo_testing.h"
+
+#include <stdio.h>
+#include <string.h>
+
+AYMO_CXX_EXTERN_C_BEGIN
+
+
+/*
+Score sheets are synthesized with all the line kinds, line break styles,
+and odd spacing.
+The pre-parsed event array must play the same writes at the same times as
+the text decoder, which in turn must never stop on lines without effect.
+*/
+
+struct event {
+    uint32_t time;
+    uint16_t address;
+    uint8_t value;
+};
+
+#define LINE_MAX    400u
+#define EVENT_MAX   (LINE_MAX + 1u)
+#define TEXT_MAX    (LINE_MAX * 24u)
+
+enum eol_style {
+    eol_style_lf,
+    eol_style_crlf,
+    eol_style_mixed
+};
+
+static int app_return;
+
+static char text[TEXT_MAX];
+static struct aymo_score_event parsed[EVENT_MAX];
+
+static struct event expected[EVENT_MAX];
+static struct event actual[EVENT_MAX];
+
+static struct aymo_score_ref_instance score;
+
+
+static void check(int condition, const char* func, const char* what, uint32_t where)
+{
+    if (!condition) {
+        app_return = TEST_STATUS_FAIL;
+        fprintf(stderr, "%s: %s @ %lu\n", func, what, (unsigned long)where);
+    }
+}
+
+
+static uint32_t rng_state;
+
+static uint32_t rng(void)
+{
+    rng_state = ((rng_state * 1664525uL) + 1013904223uL);
+    return (rng_state >> 8u);
+}
+
+
+static uint32_t text_eol(uint32_t size, enum eol_style style)
+{
+    if ((style == eol_style_crlf) || ((style == eol_style_mixed) && (rng() & 1u))) {
+        text[size++] = '\r';
+    }
+    text[size++] = '\n';
+    return size;
+}
+
+
+// Random score sheet, with every line kind and some spacing around
+static uint32_t text_generate(uint32_t seed, enum eol_style style, int trailing_eol)
+{
+    uint32_t size = 0u;
+    rng_state = seed;
+
+    if (rng() & 1u) {
+        size += (uint32_t)sprintf(&text[size], "init");
+        size = text_eol(size, style);
+    }
+
+    for (unsigned i = 0u; i < LINE_MAX; ++i) {
+        unsigned indent = ((rng() % 8u) ? 0u : (rng() % 4u));
+        while (indent--) {
+            text[size++] = ((rng() & 1u) ? ' ' : '\t');
+        }
+
+        unsigned kind = (rng() % 20u);
+        if (kind < 10u) {  // "%x <- %x"
+            unsigned address = (rng() & 0xFFu);
+            unsigned value = (rng() & 0xFFu);
+            if (!(rng() % 16u)) {
+                value |= 0x100u;  // only the last two digits stick
+            }
+            size += (uint32_t)sprintf(&text[size], "%x <- %x", address, value);
+        }
+        else if (kind < 14u) {  // "r%.2f", with other decimals too
+            unsigned numer = (10u + (rng() % 2000u));
+            switch (rng() % 4u) {
+            case 0u: size += (uint32_t)sprintf(&text[size], "r%u.%u", numer, (rng() % 10u)); break;
+            case 1u: size += (uint32_t)sprintf(&text[size], "r%u.%03u", numer, (rng() % 1000u)); break;
+            default: size += (uint32_t)sprintf(&text[size], "r%u.%02u", numer, (rng() % 100u)); break;
+            }
+        }
+        else if (kind < 17u) {  // "setchip(%d)"
+            size += (uint32_t)sprintf(&text[size], "setchip(%u)", (rng() & 1u));
+        }
+        else if (kind < 18u) {  // "init"
+            size += (uint32_t)sprintf(&text[size], "init");
+        }
+        // else: blank line
+
+        if (((i + 1u) < LINE_MAX) || trailing_eol) {
+            size = text_eol(size, style);
+        }
+    }
+    return size;
+}
+
+
+// Walks a score with random tick lengths, collecting the writes; returns the end time
+static uint32_t walk(
+    struct aymo_score_instance* instance,
+    struct event events[],
+    uint32_t* length,
+    uint32_t chunk,
+    const char* func
+)
+{
+    struct aymo_score_status* status = aymo_score_get_status(instance);
+    uint32_t time = 0u;
+    uint32_t count = 0u;
+
+    aymo_score_restart(instance);
+    if (!status->flags) {
+        check((aymo_score_tick(instance, 0u) == 0u), func, "first tick", time);
+    }
+
+    while (!(status->flags & AYMO_SCORE_FLAG_EOF)) {
+        if (status->flags & AYMO_SCORE_FLAG_EVENT) {
+            if (count < EVENT_MAX) {
+                events[count].time = time;
+                events[count].address = status->address;
+                events[count].value = status->value;
+            }
+            ++count;
+        }
+
+        uint32_t delay = ((status->flags & AYMO_SCORE_FLAG_DELAY) ? status->delay : 0u);
+        uint32_t ticks = (chunk ? (rng() % chunk) : delay);
+        uint32_t consumed = aymo_score_tick(instance, ticks);
+        check((consumed <= ticks), func, "tick overrun", time);
+        if (!(status->flags & (AYMO_SCORE_FLAG_EVENT | AYMO_SCORE_FLAG_EOF))) {
+            check((consumed == ticks), func, "tick underrun", time);
+        }
+        check((status->flags != 0u), func, "tick stopped on a no-op line", time);
+        time += consumed;
+    }
+
+    *length = count;
+    return time;
+}
+
+
+static void check_events(
+    const struct event a[],
+    uint32_t a_length,
+    const struct event b[],
+    uint32_t b_length,
+    const char* func,
+    const char* what
+)
+{
+    check((a_length == b_length), func, what, b_length);
+    for (uint32_t i = 0u; (i < a_length) && (i < b_length) && (i < EVENT_MAX); ++i) {
+        if ((a[i].time != b[i].time) || (a[i].address != b[i].address) || (a[i].value != b[i].value)) {
+            check(0, func, what, i);
+            break;
+        }
+    }
+}
+
+
+static void check_parse(uint32_t size, const char* func)
+{
+    // Reference: the text decoder, ticking exactly by its own delays
+    uint32_t expected_length = 0u;
+    score.parent.vt = &aymo_score_ref_vt;
+    aymo_score_ref_ctor(&score);
+    aymo_score_ref_load(&score, text, size);
+    uint32_t end = walk(&score.parent, expected, &expected_length, 0u, func);
+
+    // The text decoder again, ticking by random lengths
+    uint32_t actual_length = 0u;
+    uint32_t actual_end = walk(&score.parent, actual, &actual_length, 97u, func);
+    check((actual_end == end), func, "text chunked end", actual_end);
+    check_events(expected, expected_length, actual, actual_length, func, "text chunked events");
+
+    // Pre-parsed events, with merged delays
+    uint32_t tail = UINT32_MAX;
+    uint32_t length = aymo_score_ref_parse(text, size, parsed, EVENT_MAX, &tail);
+    check((length == expected_length), func, "parse length", length);
+    uint32_t time = 0u;
+    for (uint32_t i = 0u; (i < length) && (i < EVENT_MAX); ++i) {
+        time += parsed[i].delay;
+        actual[i].time = time;
+        actual[i].address = parsed[i].address;
+        actual[i].value = parsed[i].value;
+    }
+    check(((time + tail) == end), func, "parse tail", tail);
+    check_events(expected, expected_length, actual, length, func, "parse events");
+
+    // Counting only, and storing only a prefix
+    uint32_t tail_count = UINT32_MAX;
+    check((aymo_score_ref_parse(text, size, NULL, 0u, &tail_count) == length), func, "count length", length);
+    check((tail_count == tail), func, "count tail", tail_count);
+    if (length >= 2u) {
+        struct aymo_score_event prefix[EVENT_MAX];
+        uint32_t capacity = (length / 2u);
+        uint32_t tail_prefix = UINT32_MAX;
+        memset(prefix, 0xCC, sizeof(prefix));
+        check((aymo_score_ref_parse(text, size, prefix, capacity, &tail_prefix) == length), func, "prefix length", length);
+        check(!memcmp(prefix, parsed, (capacity * sizeof(prefix[0]))), func, "prefix events", capacity);
+        check((prefix[capacity].address == 0xCCCCu), func, "prefix overrun", capacity);
+        check((tail_prefix == tail), func, "prefix tail", tail_prefix);
+    }
+
+    // Playing the pre-parsed events
+    aymo_score_ref_load_events(&score, parsed, length, tail);
+    actual_end = walk(&score.parent, actual, &actual_length, 0u, func);
+    check((actual_end == end), func, "events end", actual_end);
+    check_events(expected, expected_length, actual, actual_length, func, "events");
+
+    actual_end = walk(&score.parent, actual, &actual_length, 97u, func);
+    check((actual_end == end), func, "events chunked end", actual_end);
+    check_events(expected, expected_length, actual, actual_length, func, "events chunked");
+
+    aymo_score_ref_unload(&score);
+    aymo_score_ref_dtor(&score);
+}
+
+
+static void test_parse(enum eol_style style, int trailing_eol, const char* func)
+{
+    for (uint32_t seed = 1u; seed <= 16u; ++seed) {
+        uint32_t size = text_generate(seed, style, trailing_eol);
+        check_parse(size, func);
+        if (app_return == TEST_STATUS_FAIL) {
+            fprintf(stderr, "%s: seed %lu\n", func, (unsigned long)seed);
+            break;
+        }
+    }
+}
+
+
+void test_aymo_score_ref_parse_lf(void)
+{
+    test_parse(eol_style_lf, 1, __func__);
+}
+
+
+void test_aymo_score_ref_parse_crlf(void)
+{
+    test_parse(eol_style_crlf, 1, __func__);
+}
+
+
+void test_aymo_score_ref_parse_mixed(void)
+{
+    test_parse(eol_style_mixed, 1, __func__);
+}
+
+
+void test_aymo_score_ref_parse_no_trailing_eol(void)
+{
+    test_parse(eol_style_lf, 0, __func__);
+    test_parse(eol_style_crlf, 0, __func__);
+}
+
+
+void test_aymo_score_ref_parse_empty(void)
+{
+    uint32_t tail = UINT32_MAX;
+    check((aymo_score_ref_parse(NULL, 0u, NULL, 0u, &tail) == 0u), __func__, "length", 0u);
+    check((tail == 0u), __func__, "tail", tail);
+
+    aymo_score_ref_ctor(&score);
+    aymo_score_ref_load(&score, NULL, 0u);
+    check(!!(score.parent.status.flags & AYMO_SCORE_FLAG_EOF), __func__, "text EOF", 0u);
+    check((aymo_score_ref_tick(&score, 10u) == 0u), __func__, "text tick", 0u);
+    aymo_score_ref_dtor(&score);
+
+    static const char* const blanks[] = {
+        "\n",
+        "\r\n",
+        " \t\r\n\r\n",
+        "init",
+        "init\r\n",
+        "init\nsetchip(1)\ninit\nsetchip(0)",
+    };
+    for (unsigned i = 0u; i < (sizeof(blanks) / sizeof(blanks[0])); ++i) {
+        uint32_t size = (uint32_t)strlen(blanks[i]);
+        memcpy(text, blanks[i], size);
+        check_parse(size, __func__);
+    }
+}
+
+
+void test_aymo_score_ref_tick_no_ops(void)
+{
+    // Lines without effect are skipped within a single tick
+    static const char sheet[] =
+        "init\r\n"
+        "setchip(1)\r\n"
+        "init\r\n"
+        "12 <- 34\r\n"
+        "setchip(0)\r\n"
+        "init\r\n"
+        "r1000.00\r\n"
+        "setchip(1)\r\n"
+        "56 <- 78";
+
+    aymo_score_ref_ctor(&score);
+    aymo_score_ref_load(&score, sheet, (uint32_t)(sizeof(sheet) - 1u));
+    struct aymo_score_status* status = &score.parent.status;
+
+    check((aymo_score_ref_tick(&score, 0u) == 0u), __func__, "first tick", 0u);
+    check((status->flags == AYMO_SCORE_FLAG_EVENT), __func__, "first event", status->flags);
+    check(((status->address == 0x112u) && (status->value == 0x34u)), __func__, "first write", status->address);
+
+    check((aymo_score_ref_tick(&score, 0u) == 0u), __func__, "delay tick", 0u);
+    check((status->flags == AYMO_SCORE_FLAG_DELAY), __func__, "delay", status->flags);
+    check((status->delay == 50u), __func__, "delay length", status->delay);
+
+    check((aymo_score_ref_tick(&score, 1000u) == 50u), __func__, "second tick", 0u);
+    check((status->flags == AYMO_SCORE_FLAG_EVENT), __func__, "second event", status->flags);
+    check(((status->address == 0x156u) && (status->value == 0x78u)), __func__, "second write", status->address);
+
+    check((aymo_score_ref_tick(&score, 1000u) == 0u), __func__, "last tick", 0u);
+    check((status->flags == AYMO_SCORE_FLAG_EOF), __func__, "EOF", status->flags);
+
+    aymo_score_ref_dtor(&score);
+}
+
+
+struct aymo_testing_entry unit_tests[] =
+{
+    AYMO_TEST_ENTRY(test_aymo_score_ref_parse_lf),
+    AYMO_TEST_ENTRY(test_aymo_score_ref_parse_crlf),
+    AYMO_TEST_ENTRY(test_aymo_score_ref_parse_mixed),
+    AYMO_TEST_ENTRY(test_aymo_score_ref_parse_no_trailing_eol),
+    AYMO_TEST_ENTRY(test_aymo_score_ref_parse_empty),
+    AYMO_TEST_ENTRY(test_aymo_score_ref_tick_no_ops)
+};
+
+
+#include "aymo_testing_epilogue_inline.h"
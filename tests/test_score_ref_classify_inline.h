@@ -0,0 +1,107 @@
+/*
+AYMO - Accelerated YaMaha Operator
+Copyright (c) 2023-2024 Andrea Zoppi.
+
+This file is part of AYMO.
+
+AYMO is free software: you can redistribute it and/or modify it under the
+terms of the GNU Lesser General Public License as published by the Free
+Software Foundation, either version 2.1 of the License, or (at your option)
+any later version.
+
+AYMO is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with AYMO. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+// Expects aymo_(classify) to be defined by the including test
+
+#include "aymo_score_ref.h"
+#include "aymo_testing.h"
+
+#include <stdio.h>
+#include <string.h>
+
+AYMO_CXX_EXTERN_C_BEGIN
+
+
+/*
+The SIMD classifiers must flag the same line breaks and hex digits as the
+plain C classifier, for every byte value, at every position and alignment.
+*/
+
+static int app_return;
+
+static char buffer[64u * 3u];
+
+
+static uint32_t rng_state;
+
+static uint32_t rng(void)
+{
+    rng_state = ((rng_state * 1664525uL) + 1013904223uL);
+    return (rng_state >> 8u);
+}
+
+
+static int compare(const char* text, const char* func, unsigned where)
+{
+    uint64_t eol_ref = 0u, hex_ref = 0u;
+    uint64_t eol = ~(uint64_t)0u, hex = ~(uint64_t)0u;
+    aymo_score_ref_classify_none(text, &eol_ref, &hex_ref);
+    aymo_(classify)(text, &eol, &hex);
+
+    if ((eol != eol_ref) || (hex != hex_ref)) {
+        app_return = TEST_STATUS_FAIL;
+        fprintf(stderr, "%s @ %u: eol 0x%016llX / 0x%016llX, hex 0x%016llX / 0x%016llX\n", func, where,
+                (unsigned long long)eol, (unsigned long long)eol_ref,
+                (unsigned long long)hex, (unsigned long long)hex_ref);
+        return 1;
+    }
+    return 0;
+}
+
+
+// Every byte value, at every position
+static void test_classify_bytes(const char* func)
+{
+    for (unsigned c = 0u; c < 256u; ++c) {
+        for (unsigned i = 0u; i < 64u; ++i) {
+            memset(buffer, ' ', sizeof(buffer));
+            buffer[i] = (char)(unsigned char)c;
+            if (compare(buffer, func, ((c << 8u) | i))) {
+                return;
+            }
+        }
+        memset(buffer, (int)c, sizeof(buffer));
+        if (compare(buffer, func, (c << 8u))) {
+            return;
+        }
+    }
+}
+
+
+// Random mixes of the class boundaries, at every alignment
+static void test_classify_random(const char* func)
+{
+    static const char edges[] = {
+        '\0', '\t', '\n', '\v', '\r', ' ', '/', '0', '9', ':', '@',
+        'A', 'F', 'G', '`', 'a', 'f', 'g', 'r', 's', '<', '-', '(', ')',
+        (char)0x80, (char)0xB0, (char)0xE1, (char)0xFF
+    };
+
+    rng_state = 1u;
+    for (unsigned k = 0u; k < 4096u; ++k) {
+        for (unsigned i = 0u; i < sizeof(buffer); ++i) {
+            unsigned r = rng();
+            buffer[i] = ((r & 1u) ? edges[(r >> 1u) % sizeof(edges)] : (char)(unsigned char)(r >> 8u));
+        }
+        if (compare(&buffer[k % 64u], func, k)) {
+            return;
+        }
+    }
+}
@@ -0,0 +1,248 @@
+/*
+AYMO - Accelerated YaMaha Operator
+Copyright (c) 2023-2024 Andrea Zoppi.
+
+This file is part of AYMO.
+
+AYMO is free software: you can redistribute it and/or modify it under the
+terms of the GNU Lesser General Public License as published by the Free
+Software Foundation, either version 2.1 of the License, or (at your option)
+any later version.
+
+AYMO is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with AYMO. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "aymo.h"
+#include "aymo_cpu.h"
+#include "aymo_tda8425.h"
+#include "aymo_testing.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+AYMO_CXX_EXTERN_C_BEGIN
+
+
+/*
+Banks must sound the same as single chips of the backend they are built on:
+x86_avx2 banks as x86_sse41 chips, the others as chips of their own backend.
+*/
+
+#define INSTANCES   6u  // last AVX2 bank unit partially used
+#define FRAMES      4096u
+#define FS          48000.f
+#define POOL_SIZE   (1u << 16)
+#define POOL_ALIGN  64
+
+#define SILENT_INSTANCE     1u  // NULL input for the first half
+#define DISCARD_INSTANCE    2u  // NULL output for odd blocks
+#define DISCARD_SENTINEL    (-1234.f)
+
+
+static int app_return;
+
+static AYMO_TDA8425_DEFINE_MATH_DEFAULT(tda8425_math);
+
+static uint8_t chip_pools[INSTANCES][POOL_SIZE] AYMO_ALIGN(POOL_ALIGN);
+static uint8_t bank_pool[POOL_SIZE * INSTANCES] AYMO_ALIGN(POOL_ALIGN);
+
+static struct aymo_tda8425_bank* bank;
+static struct aymo_tda8425_coeffs coeffs;
+
+static float x_planar[INSTANCES][FRAMES * 2u];
+static float y_planar[INSTANCES][FRAMES * 2u];
+static float y_chip[INSTANCES][FRAMES * 2u];
+static float x_inter[FRAMES * INSTANCES * 2u];
+static float y_inter[FRAMES * INSTANCES * 2u];
+
+
+static int setup(const char* bank_ext, const char* chip_ext)
+{
+    aymo_cpu_boot();
+    aymo_tda8425_boot(&tda8425_math);
+
+    const struct aymo_tda8425_bank_vt* bank_vt = aymo_tda8425_get_bank_vt(bank_ext);
+    const struct aymo_tda8425_vt* chip_vt = aymo_tda8425_get_vt(chip_ext);
+    if (!bank_vt || !chip_vt) {
+        return 1;
+    }
+    if ((bank_vt->get_sizeof(INSTANCES) > sizeof(bank_pool)) || (chip_vt->get_sizeof() > POOL_SIZE)) {
+        return 1;
+    }
+
+    static const uint8_t regs[INSTANCES][6] = {
+        // VL,  VR,   BA,   TR,   PP,   SF
+        { 0xFC, 0xFC, 0xF6, 0xF6, 0xFC, 0xCE },  // defaults
+        { 0xFF, 0xF0, 0xFF, 0xF0, 0xFF, 0x4E },  // T-filter
+        { 0xF8, 0xFA, 0xF0, 0xFF, 0xFD, 0xD2 },  // pseudo
+        { 0xFC, 0xF4, 0xF3, 0xFA, 0xFE, 0xDE },  // spatial
+        { 0xFC, 0xFC, 0xF9, 0xF3, 0xFC, 0x12 },  // worst case
+        { 0xF0, 0xFF, 0xF6, 0xF6, 0xFF, 0xC2 },  // mono
+    };
+
+    aymo_tda8425_coeffs_ctor(&coeffs, FS);
+
+    bank = (struct aymo_tda8425_bank*)(void*)bank_pool;
+    bank->vt = bank_vt;
+    aymo_tda8425_bank_ctor(bank, INSTANCES, FS);
+    aymo_tda8425_bank_set_coeffs(bank, &coeffs);
+
+    static const uint16_t addresses[6] = { 0x00u, 0x01u, 0x02u, 0x03u, 0x07u, 0x08u };
+
+    for (unsigned i = 0u; i < INSTANCES; ++i) {
+        struct aymo_tda8425_chip* chip = (struct aymo_tda8425_chip*)(void*)chip_pools[i];
+        chip->vt = chip_vt;
+        aymo_tda8425_ctor(chip, FS);
+
+        for (unsigned r = 0u; r < 6u; ++r) {
+            aymo_tda8425_write(chip, addresses[r], regs[i][r]);
+            aymo_tda8425_bank_write(bank, i, addresses[r], regs[i][r]);
+
+            uint8_t value = aymo_tda8425_bank_read(bank, i, addresses[r]);
+            if (value != aymo_tda8425_read(chip, addresses[r])) {
+                app_return = TEST_STATUS_FAIL;
+                fprintf(stderr, "instance %u: register 0x%02X reads 0x%02X\n", i, addresses[r], value);
+            }
+        }
+
+        for (unsigned n = 0u; n < FRAMES; ++n) {
+            float xl = (float)(.5 * sin((double)(n * (i + 1u)) * .01));
+            float xr = (float)(.5 * cos((double)(n * (i + 3u)) * .007));
+            if ((i == SILENT_INSTANCE) && (n < (FRAMES / 2u))) {
+                xl = 0.f;
+                xr = 0.f;
+            }
+            x_planar[i][(n * 2u) + 0u] = xl;
+            x_planar[i][(n * 2u) + 1u] = xr;
+            x_inter[(((n * INSTANCES) + i) * 2u) + 0u] = xl;
+            x_inter[(((n * INSTANCES) + i) * 2u) + 1u] = xr;
+        }
+
+        aymo_tda8425_process_f32(chip, FRAMES, x_planar[i], y_chip[i]);
+        aymo_tda8425_dtor(chip);
+    }
+    return 0;
+}
+
+
+// Odd block sizes, to cover both the 4-frame and the single-frame paths
+static const uint32_t block_sizes[] = { 1u, 7u, 4u, 33u, 2u, 256u, 3u };
+
+
+static void test_planar(const char* bank_ext, const char* chip_ext, const char* func)
+{
+    if (setup(bank_ext, chip_ext)) {
+        app_return = TEST_STATUS_SKIP;
+        return;
+    }
+
+    uint32_t n = 0u;
+    for (unsigned j = 0u; n < FRAMES; ++j) {
+        uint32_t count = block_sizes[j % AYMO_VECTOR_LENGTH(block_sizes)];
+        if (count > (FRAMES - n)) {
+            count = (FRAMES - n);
+        }
+        const float* x[INSTANCES];
+        float* y[INSTANCES];
+        for (unsigned i = 0u; i < INSTANCES; ++i) {
+            x[i] = &x_planar[i][n * 2u];
+            y[i] = &y_planar[i][n * 2u];
+        }
+        if ((n + count) <= (FRAMES / 2u)) {
+            x[SILENT_INSTANCE] = NULL;
+        }
+        if (j & 1u) {
+            y[DISCARD_INSTANCE] = NULL;
+            for (uint32_t k = (n * 2u); k < ((n + count) * 2u); ++k) {
+                y_planar[DISCARD_INSTANCE][k] = DISCARD_SENTINEL;
+            }
+        }
+        aymo_tda8425_bank_process_f32(bank, count, x, y);
+        n += count;
+    }
+
+    for (unsigned i = 0u; i < INSTANCES; ++i) {
+        for (n = 0u; n < (FRAMES * 2u); ++n) {
+            float y_ref = y_chip[i][n];
+            if ((i == DISCARD_INSTANCE) && (y_planar[i][n] == DISCARD_SENTINEL)) {
+                continue;  // discarded
+            }
+            if (memcmp(&y_planar[i][n], &y_ref, sizeof(float))) {
+                app_return = TEST_STATUS_FAIL;
+                fprintf(stderr, "%s: instance %u mismatch at sample %u\n", func, i, n);
+                break;
+            }
+        }
+    }
+
+    aymo_tda8425_bank_dtor(bank);
+}
+
+
+static void test_interleaved(const char* bank_ext, const char* chip_ext, const char* func)
+{
+    if (setup(bank_ext, chip_ext)) {
+        app_return = TEST_STATUS_SKIP;
+        return;
+    }
+
+    uint32_t n = 0u;
+    for (unsigned j = 0u; n < FRAMES; ++j) {
+        uint32_t count = block_sizes[j % AYMO_VECTOR_LENGTH(block_sizes)];
+        if (count > (FRAMES - n)) {
+            count = (FRAMES - n);
+        }
+        uint32_t k = (n * INSTANCES * 2u);
+        aymo_tda8425_bank_process_f32_interleaved(bank, count, &x_inter[k], &y_inter[k]);
+        n += count;
+    }
+
+    for (unsigned i = 0u; i < INSTANCES; ++i) {
+        for (n = 0u; n < FRAMES; ++n) {
+            if (memcmp(&y_inter[((n * INSTANCES) + i) * 2u], &y_chip[i][n * 2u], (2u * sizeof(float)))) {
+                app_return = TEST_STATUS_FAIL;
+                fprintf(stderr, "%s: instance %u mismatch at frame %u\n", func, i, n);
+                break;
+            }
+        }
+    }
+
+    aymo_tda8425_bank_dtor(bank);
+}
+
+
+#define TEST_BANK(bank_ext, chip_ext) \
+    void test_aymo_tda8425_##bank_ext##_bank_planar(void) \
+    { \
+        test_planar(#bank_ext, #chip_ext, __func__); \
+    } \
+    void test_aymo_tda8425_##bank_ext##_bank_interleaved(void) \
+    { \
+        test_interleaved(#bank_ext, #chip_ext, __func__); \
+    }
+
+TEST_BANK(none, none)
+TEST_BANK(x86_sse41, x86_sse41)
+TEST_BANK(x86_avx2, x86_sse41)
+
+
+struct aymo_testing_entry unit_tests[] =
+{
+    AYMO_TEST_ENTRY(test_aymo_tda8425_none_bank_planar),
+    AYMO_TEST_ENTRY(test_aymo_tda8425_none_bank_interleaved),
+    AYMO_TEST_ENTRY(test_aymo_tda8425_x86_sse41_bank_planar),
+    AYMO_TEST_ENTRY(test_aymo_tda8425_x86_sse41_bank_interleaved),
+    AYMO_TEST_ENTRY(test_aymo_tda8425_x86_avx2_bank_planar),
+    AYMO_TEST_ENTRY(test_aymo_tda8425_x86_avx2_bank_interleaved)
+};
+
+
+#include "aymo_testing_epilogue_inline.h"
@@ -0,0 +1,291 @@
+/*
+AYMO - Accelerated YaMaha Operator
+Copyright (c) 2023-2024 Andrea Zoppi.
+
+This file is part of AYMO.
+
+AYMO is free software: you can redistribute it and/or modify it under the
+terms of the GNU Lesser General Public License as published by the Free
+Software Foundation, either version 2.1 of the License, or (at your option)
+any later version.
+
+AYMO is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with AYMO. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "aymo.h"
+#include "aymo_cpu.h"
+#include "aymo_tda8425.h"
+#include "aymo_testing.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+AYMO_CXX_EXTERN_C_BEGIN
+
+
+/*
+The silence gate must zero the filter states only once all of them fall below
+the threshold, and let the chip play normally again as soon as input returns.
+A chip gated with a threshold below its residual states must sound exactly
+like an ungated one.
+*/
+
+#define FS          48000.f
+#define BLOCK       256u
+#define BURST       (BLOCK * 8u)
+#define SILENCE     (BLOCK * 16u)
+#define FRAMES      (BURST + SILENCE + BURST)
+#define POOL_SIZE   (1u << 16)
+#define POOL_ALIGN  64
+
+#define TINY        1e-30f  // below any normal float
+#define RELEASE_TOLERANCE   1e-3f
+
+static int app_return;
+
+static AYMO_TDA8425_DEFINE_MATH_DEFAULT(tda8425_math);
+
+static uint8_t pool_gated[POOL_SIZE] AYMO_ALIGN(POOL_ALIGN);
+static uint8_t pool_open[POOL_SIZE] AYMO_ALIGN(POOL_ALIGN);
+static uint8_t pool_tiny[POOL_SIZE] AYMO_ALIGN(POOL_ALIGN);
+
+static float x[FRAMES * 2u];
+static float y_gated[FRAMES * 2u];
+static float y_open[FRAMES * 2u];
+static float y_tiny[FRAMES * 2u];
+
+
+static struct aymo_tda8425_chip* setup(uint8_t* pool, const struct aymo_tda8425_vt* vt, float threshold)
+{
+    struct aymo_tda8425_chip* chip = (struct aymo_tda8425_chip*)(void*)pool;
+    chip->vt = vt;
+    aymo_tda8425_ctor(chip, FS);
+
+    // Pseudo-stereo, extreme bass and treble: states linger after the signal stops
+    aymo_tda8425_write(chip, 0x00u, 0xFCu);
+    aymo_tda8425_write(chip, 0x01u, 0xFCu);
+    aymo_tda8425_write(chip, 0x02u, 0xFFu);
+    aymo_tda8425_write(chip, 0x03u, 0xFFu);
+    aymo_tda8425_write(chip, 0x07u, 0xFCu);
+    aymo_tda8425_write(chip, 0x08u, 0xD2u);
+    aymo_tda8425_set_silence(chip, threshold);
+    return chip;
+}
+
+
+// Square wave burst, silence, then another burst
+static void generate_input(void)
+{
+    for (uint32_t n = 0u; n < FRAMES; ++n) {
+        float xl = 0.f;
+        float xr = 0.f;
+        if ((n < BURST) || (n >= (BURST + SILENCE))) {
+            xl = (((n / 37u) & 1u) ? .5f : -.5f);
+            xr = (float)(.4 * sin((double)n * .013));
+        }
+        x[n * 2u] = xl;
+        x[n * 2u + 1u] = xr;
+    }
+}
+
+
+static const struct aymo_tda8425_vt* boot_vt(const char* cpu_ext)
+{
+    aymo_cpu_boot();
+    aymo_tda8425_boot(&tda8425_math);
+
+    const struct aymo_tda8425_vt* vt = aymo_tda8425_get_vt(cpu_ext);
+    if (!vt || (vt->get_sizeof() > POOL_SIZE)) {
+        return NULL;
+    }
+    return vt;
+}
+
+
+static int run(const char* cpu_ext)
+{
+    const struct aymo_tda8425_vt* vt = boot_vt(cpu_ext);
+    if (!vt) {
+        return 1;
+    }
+    struct aymo_tda8425_chip* chip_gated = setup(pool_gated, vt, AYMO_TDA8425_SILENCE_THRESHOLD);
+    struct aymo_tda8425_chip* chip_open = setup(pool_open, vt, 0.f);
+    struct aymo_tda8425_chip* chip_tiny = setup(pool_tiny, vt, TINY);
+
+    generate_input();
+
+    // The gate acts at the end of each process call
+    for (uint32_t n = 0u; n < FRAMES; n += BLOCK) {
+        aymo_tda8425_process_f32(chip_gated, BLOCK, &x[n * 2u], &y_gated[n * 2u]);
+        aymo_tda8425_process_f32(chip_open, BLOCK, &x[n * 2u], &y_open[n * 2u]);
+        aymo_tda8425_process_f32(chip_tiny, BLOCK, &x[n * 2u], &y_tiny[n * 2u]);
+    }
+
+    aymo_tda8425_dtor(chip_gated);
+    aymo_tda8425_dtor(chip_open);
+    aymo_tda8425_dtor(chip_tiny);
+    return 0;
+}
+
+
+static int same_samples(const float* a, const float* b, uint32_t begin, uint32_t end, const char* func, const char* what)
+{
+    for (uint32_t i = (begin * 2u); i < (end * 2u); ++i) {
+        if (memcmp(&a[i], &b[i], sizeof(float))) {
+            app_return = TEST_STATUS_FAIL;
+            fprintf(stderr, "%s: %s: mismatch at frame %lu: %g != %g\n", func, what,
+                    (unsigned long)(i / 2u), (double)a[i], (double)b[i]);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+
+// Loud states are never gated; quiet ones are zeroed, so the output becomes exact silence
+static void test_below(const char* cpu_ext, const char* func)
+{
+    if (run(cpu_ext)) {
+        app_return = TEST_STATUS_SKIP;
+        return;
+    }
+
+    same_samples(y_gated, y_open, 0u, BURST, func, "burst");
+
+    // The last silent block must be exactly zero when gated, but not when open
+    uint32_t begin = (BURST + SILENCE - BLOCK);
+    int open_residual = 0;
+    for (uint32_t i = (begin * 2u); i < ((begin + BLOCK) * 2u); ++i) {
+        if (y_gated[i] != 0.f) {
+            app_return = TEST_STATUS_FAIL;
+            fprintf(stderr, "%s: not gated at frame %lu: %g\n", func, (unsigned long)(i / 2u), (double)y_gated[i]);
+            break;
+        }
+        open_residual |= (y_open[i] != 0.f);
+    }
+    if (!open_residual) {
+        app_return = TEST_STATUS_FAIL;
+        fprintf(stderr, "%s: no residual to gate\n", func);
+    }
+}
+
+
+// Once input returns, the gated chip plays like the open one, up to the residual it dropped
+static void test_release(const char* cpu_ext, const char* func)
+{
+    if (run(cpu_ext)) {
+        app_return = TEST_STATUS_SKIP;
+        return;
+    }
+
+    float peak = 0.f;
+    for (uint32_t i = ((BURST + SILENCE) * 2u); i < (FRAMES * 2u); ++i) {
+        float e = fabsf(y_gated[i] - y_open[i]);
+        if (e > RELEASE_TOLERANCE) {
+            app_return = TEST_STATUS_FAIL;
+            fprintf(stderr, "%s: mismatch at frame %lu: %g != %g\n", func,
+                    (unsigned long)(i / 2u), (double)y_gated[i], (double)y_open[i]);
+            break;
+        }
+        peak = fmaxf(peak, fabsf(y_gated[i]));
+    }
+    if (peak < .1f) {
+        app_return = TEST_STATUS_FAIL;
+        fprintf(stderr, "%s: still silent: peak %g\n", func, (double)peak);
+    }
+}
+
+
+// States above the threshold are left alone, bit for bit
+static void test_above(const char* cpu_ext, const char* func)
+{
+    if (run(cpu_ext)) {
+        app_return = TEST_STATUS_SKIP;
+        return;
+    }
+
+    same_samples(y_tiny, y_open, 0u, FRAMES, func, "tiny threshold");
+}
+
+
+// process_f32() gives back the caller's floating-point control state
+static void test_fpstate(const char* cpu_ext, const char* func)
+{
+    const struct aymo_tda8425_vt* vt = boot_vt(cpu_ext);
+    if (!vt) {
+        app_return = TEST_STATUS_SKIP;
+        return;
+    }
+    struct aymo_tda8425_chip* chip = setup(pool_gated, vt, AYMO_TDA8425_SILENCE_THRESHOLD);
+    generate_input();
+
+    // Measured around the call alone, as sticky exception flags are part of the state
+    aymo_cpu_fpstate_t before = aymo_cpu_enter_ftz();
+    aymo_cpu_leave_ftz(before);
+    aymo_tda8425_process_f32(chip, BURST, x, y_gated);
+    aymo_cpu_fpstate_t after = aymo_cpu_enter_ftz();
+    aymo_cpu_leave_ftz(after);
+
+    aymo_tda8425_dtor(chip);
+
+    if (after != before) {
+        app_return = TEST_STATUS_FAIL;
+        fprintf(stderr, "%s: state not restored: 0x%llX != 0x%llX\n", func,
+                (unsigned long long)after, (unsigned long long)before);
+    }
+}
+
+
+#define TEST_SILENCE(cpu_ext) \
+    void test_aymo_tda8425_##cpu_ext##_silence_below(void) \
+    { \
+        test_below(#cpu_ext, __func__); \
+    } \
+    void test_aymo_tda8425_##cpu_ext##_silence_release(void) \
+    { \
+        test_release(#cpu_ext, __func__); \
+    } \
+    void test_aymo_tda8425_##cpu_ext##_silence_above(void) \
+    { \
+        test_above(#cpu_ext, __func__); \
+    } \
+    void test_aymo_tda8425_##cpu_ext##_silence_fpstate(void) \
+    { \
+        test_fpstate(#cpu_ext, __func__); \
+    }
+
+TEST_SILENCE(x86_sse41)
+TEST_SILENCE(x86_avx2)
+TEST_SILENCE(x86_fma3)
+TEST_SILENCE(arm_neon)
+
+
+struct aymo_testing_entry unit_tests[] =
+{
+    AYMO_TEST_ENTRY(test_aymo_tda8425_x86_sse41_silence_below),
+    AYMO_TEST_ENTRY(test_aymo_tda8425_x86_sse41_silence_release),
+    AYMO_TEST_ENTRY(test_aymo_tda8425_x86_sse41_silence_above),
+    AYMO_TEST_ENTRY(test_aymo_tda8425_x86_sse41_silence_fpstate),
+    AYMO_TEST_ENTRY(test_aymo_tda8425_x86_avx2_silence_below),
+    AYMO_TEST_ENTRY(test_aymo_tda8425_x86_avx2_silence_release),
+    AYMO_TEST_ENTRY(test_aymo_tda8425_x86_avx2_silence_above),
+    AYMO_TEST_ENTRY(test_aymo_tda8425_x86_avx2_silence_fpstate),
+    AYMO_TEST_ENTRY(test_aymo_tda8425_x86_fma3_silence_below),
+    AYMO_TEST_ENTRY(test_aymo_tda8425_x86_fma3_silence_release),
+    AYMO_TEST_ENTRY(test_aymo_tda8425_x86_fma3_silence_above),
+    AYMO_TEST_ENTRY(test_aymo_tda8425_x86_fma3_silence_fpstate),
+    AYMO_TEST_ENTRY(test_aymo_tda8425_arm_neon_silence_below),
+    AYMO_TEST_ENTRY(test_aymo_tda8425_arm_neon_silence_release),
+    AYMO_TEST_ENTRY(test_aymo_tda8425_arm_neon_silence_above),
+    AYMO_TEST_ENTRY(test_aymo_tda8425_arm_neon_silence_fpstate)
+};
+
+
+#include "aymo_testing_epilogue_inline.h"
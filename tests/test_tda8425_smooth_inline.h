@@ -0,0 +1,373 @@
+/*
+AYMO - Accelerated YaMaha Operator
+Copyright (c) 2023-2024 Andrea Zoppi.
+
+This file is part of AYMO.
+
+AYMO is free software: you can redistribute it and/or modify it under the
+terms of the GNU Lesser General Public License as published by the Free
+Software Foundation, either version 2.1 of the License, or (at your option)
+any later version.
+
+AYMO is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with AYMO. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+// Expects the aymo_(chip) shorthands of a SIMD backend to be defined by the including test
+
+#include "aymo_cpu.h"
+#include "aymo_tda8425.h"
+#include "aymo_testing.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+AYMO_CXX_EXTERN_C_BEGIN
+
+
+/*
+Coefficient ramps must reach their targets exactly, restart from where
+they are when retargeted, and sound the same however processing is split.
+A filled coefficient cache must stay untouched while chips use it.
+*/
+
+#define FS          48000.f
+#define FRAMES      4096u
+#define SMOOTHING   100u  // [frames], rounded up to whole ramp steps
+#define RAMP_LENGTH (((SMOOTHING + AYMO_TDA8425_SMOOTH_STEP - 1u) / AYMO_TDA8425_SMOOTH_STEP) * AYMO_TDA8425_SMOOTH_STEP)
+
+static int app_return;
+
+static AYMO_TDA8425_DEFINE_MATH_DEFAULT(tda8425_math);
+
+static struct aymo_(chip) chip_a;
+static struct aymo_(chip) chip_b;
+static struct aymo_(chip) chip_ref;
+static struct aymo_tda8425_coeffs coeffs;
+static struct aymo_tda8425_coeffs coeffs_copy;
+
+static float x_f32[FRAMES * 2u];
+static float y_f32_a[FRAMES * 2u];
+static float y_f32_b[FRAMES * 2u];
+static int16_t x_i16[FRAMES * 2u];
+static int16_t y_i16_a[FRAMES * 2u];
+static int16_t y_i16_b[FRAMES * 2u];
+
+static const uint16_t addresses[6] = { 0x00u, 0x01u, 0x02u, 0x03u, 0x07u, 0x08u };
+
+static const uint8_t regs_start[6] = { 0xFCu, 0xFCu, 0xF6u, 0xF6u, 0xFCu, 0xCEu };  // defaults
+static const uint8_t regs_mid[6]   = { 0xFFu, 0xF0u, 0xFFu, 0xF0u, 0xFFu, 0x4Eu };  // T-filter
+static const uint8_t regs_end[6]   = { 0xF8u, 0xFAu, 0xF0u, 0xFFu, 0xFDu, 0xD2u };  // pseudo
+
+
+static uint32_t rng_state;
+
+static uint32_t rng(void)
+{
+    rng_state = ((rng_state * 1664525uL) + 1013904223uL);
+    return (rng_state >> 8u);
+}
+
+
+static void setup(void)
+{
+    aymo_cpu_boot();
+    aymo_tda8425_boot(&tda8425_math);
+
+    rng_state = 1u;
+    for (uint32_t n = 0u; n < FRAMES; ++n) {
+        float xl = (float)(.4 * sin((double)n * .013));
+        float xr = (float)(.4 * cos((double)n * .0021));
+        x_f32[(n * 2u) + 0u] = xl;
+        x_f32[(n * 2u) + 1u] = xr;
+        x_i16[(n * 2u) + 0u] = (int16_t)lrint(xl * 32768.);
+        x_i16[(n * 2u) + 1u] = (int16_t)lrint(xr * 32768.);
+    }
+}
+
+
+static void program(struct aymo_(chip)* chip, const uint8_t regs[6])
+{
+    for (unsigned r = 0u; r < 6u; ++r) {
+        aymo_(write)(chip, addresses[r], regs[r]);
+    }
+}
+
+
+// Same coefficient lanes, bit by bit
+#define SAME_FIELD(a__, b__, field__) \
+    (!memcmp(&(a__)->field__, &(b__)->field__, sizeof((a__)->field__)))
+
+static int same_coeffs(const struct aymo_(chip)* a, const struct aymo_(chip)* b)
+{
+    return (SAME_FIELD(a, b, kb2) && SAME_FIELD(a, b, ka2) &&
+            SAME_FIELD(a, b, kb1) && SAME_FIELD(a, b, ka1) &&
+            SAME_FIELD(a, b, klr) && SAME_FIELD(a, b, krl) &&
+            SAME_FIELD(a, b, kb0) && SAME_FIELD(a, b, kv));
+}
+
+#define SAME_TARGET(c__, field__) \
+    (!memcmp(&(c__)->field__, &(c__)->t##field__, sizeof((c__)->field__)))
+
+static int on_targets(const struct aymo_(chip)* c)
+{
+    return (SAME_TARGET(c, kb2) && SAME_TARGET(c, ka2) &&
+            SAME_TARGET(c, kb1) && SAME_TARGET(c, ka1) &&
+            SAME_TARGET(c, klr) && SAME_TARGET(c, krl) &&
+            SAME_TARGET(c, kb0) && SAME_TARGET(c, kv));
+}
+
+
+// Every volume lane lies between its ramp start and target
+static int volume_between(const struct aymo_(chip)* c, const float* from)
+{
+    float kv[sizeof(c->kv) / sizeof(float)];
+    float tkv[sizeof(c->tkv) / sizeof(float)];
+    memcpy(kv, &c->kv, sizeof(kv));
+    memcpy(tkv, &c->tkv, sizeof(tkv));
+
+    for (unsigned i = 0u; i < AYMO_VECTOR_LENGTH(kv); ++i) {
+        float lo = ((from[i] < tkv[i]) ? from[i] : tkv[i]);
+        float hi = ((from[i] < tkv[i]) ? tkv[i] : from[i]);
+        float eps = (1e-6f * (fabsf(lo) + fabsf(hi)));
+        if ((kv[i] < (lo - eps)) || (kv[i] > (hi + eps))) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+
+// Ramps last whole steps, stay within their ends, then snap exactly onto the targets
+static void test_ramp(const char* func)
+{
+    setup();
+
+    aymo_(ctor)(&chip_a, FS);
+    program(&chip_a, regs_start);
+    aymo_(set_smoothing)(&chip_a, SMOOTHING);
+
+    aymo_(ctor)(&chip_ref, FS);
+    program(&chip_ref, regs_end);
+
+    float from[sizeof(chip_a.kv) / sizeof(float)];
+    memcpy(from, &chip_a.kv, sizeof(from));
+
+    program(&chip_a, regs_end);
+    if ((chip_a.smooth_left != RAMP_LENGTH) || on_targets(&chip_a)) {
+        app_return = TEST_STATUS_FAIL;
+        fprintf(stderr, "%s: ramp not started, %lu frames left\n", func, (unsigned long)chip_a.smooth_left);
+        return;
+    }
+
+    for (uint32_t n = 1u; n <= RAMP_LENGTH; ++n) {
+        aymo_(process_f32)(&chip_a, 1u, &x_f32[n * 2u], &y_f32_a[n * 2u]);
+
+        if (chip_a.smooth_left != (RAMP_LENGTH - n)) {
+            app_return = TEST_STATUS_FAIL;
+            fprintf(stderr, "%s: frame %lu: %lu frames left\n", func, (unsigned long)n, (unsigned long)chip_a.smooth_left);
+            return;
+        }
+        if (!volume_between(&chip_a, from)) {
+            app_return = TEST_STATUS_FAIL;
+            fprintf(stderr, "%s: frame %lu: volume out of ramp\n", func, (unsigned long)n);
+            return;
+        }
+        if ((n < RAMP_LENGTH) && on_targets(&chip_a)) {
+            app_return = TEST_STATUS_FAIL;
+            fprintf(stderr, "%s: frame %lu: ramp ended early\n", func, (unsigned long)n);
+            return;
+        }
+    }
+
+    if (!on_targets(&chip_a) || !same_coeffs(&chip_a, &chip_ref)) {
+        app_return = TEST_STATUS_FAIL;
+        fprintf(stderr, "%s: ramp end not snapped onto targets\n", func);
+    }
+
+    aymo_(dtor)(&chip_a);
+    aymo_(dtor)(&chip_ref);
+}
+
+
+// Writes during a ramp restart it from the current coefficients, for a whole ramp length
+static void test_retarget(const char* func)
+{
+    setup();
+
+    aymo_(ctor)(&chip_a, FS);
+    program(&chip_a, regs_start);
+    aymo_(set_smoothing)(&chip_a, SMOOTHING);
+    program(&chip_a, regs_mid);
+
+    uint32_t mid = ((RAMP_LENGTH / 2u) + 3u);  // off a ramp step boundary
+    aymo_(process_f32)(&chip_a, mid, x_f32, y_f32_a);
+
+    chip_b = chip_a;  // snapshot
+
+    aymo_(ctor)(&chip_ref, FS);
+    program(&chip_ref, regs_end);
+
+    float from[sizeof(chip_a.kv) / sizeof(float)];
+    memcpy(from, &chip_a.kv, sizeof(from));
+
+    program(&chip_a, regs_end);
+    if ((chip_a.smooth_left != RAMP_LENGTH) || !same_coeffs(&chip_a, &chip_b)) {
+        app_return = TEST_STATUS_FAIL;
+        fprintf(stderr, "%s: ramp not restarted from current coefficients\n", func);
+        return;
+    }
+
+    for (uint32_t n = 1u; n <= RAMP_LENGTH; ++n) {
+        aymo_(process_f32)(&chip_a, 1u, &x_f32[(mid + n) * 2u], &y_f32_a[(mid + n) * 2u]);
+
+        if (!volume_between(&chip_a, from)) {
+            app_return = TEST_STATUS_FAIL;
+            fprintf(stderr, "%s: frame %lu: volume out of ramp\n", func, (unsigned long)n);
+            return;
+        }
+        if ((n < RAMP_LENGTH) && !chip_a.smooth_left) {
+            app_return = TEST_STATUS_FAIL;
+            fprintf(stderr, "%s: frame %lu: ramp ended early\n", func, (unsigned long)n);
+            return;
+        }
+    }
+
+    if (chip_a.smooth_left || !on_targets(&chip_a) || !same_coeffs(&chip_a, &chip_ref)) {
+        app_return = TEST_STATUS_FAIL;
+        fprintf(stderr, "%s: ramp end not snapped onto new targets\n", func);
+    }
+
+    aymo_(dtor)(&chip_a);
+    aymo_(dtor)(&chip_b);
+    aymo_(dtor)(&chip_ref);
+}
+
+
+// Random writes at random times; chip A processes each span at once, chip B in random pieces
+static void run_split(int i16)
+{
+    aymo_(ctor)(&chip_a, FS);
+    aymo_(ctor)(&chip_b, FS);
+    program(&chip_a, regs_start);
+    program(&chip_b, regs_start);
+    aymo_(set_smoothing)(&chip_a, (SMOOTHING * 3u));
+    aymo_(set_smoothing)(&chip_b, (SMOOTHING * 3u));
+
+    rng_state = 12345u;
+    uint32_t n = 0u;
+    while (n < FRAMES) {
+        uint16_t address = addresses[rng() % 6u];
+        uint8_t value = (uint8_t)rng();
+        if (address == 0x08u) {
+            value &= 0xDFu;  // no mute
+        }
+        aymo_(write)(&chip_a, address, value);
+        aymo_(write)(&chip_b, address, value);
+
+        uint32_t span = (1u + (rng() % 200u));
+        if (span > (FRAMES - n)) {
+            span = (FRAMES - n);
+        }
+        if (i16) {
+            aymo_(process_i16)(&chip_a, span, &x_i16[n * 2u], &y_i16_a[n * 2u]);
+        }
+        else {
+            aymo_(process_f32)(&chip_a, span, &x_f32[n * 2u], &y_f32_a[n * 2u]);
+        }
+
+        for (uint32_t end = (n + span); n < end; ) {
+            uint32_t piece = (1u + (rng() % 23u));
+            if (piece > (end - n)) {
+                piece = (end - n);
+            }
+            if (i16) {
+                aymo_(process_i16)(&chip_b, piece, &x_i16[n * 2u], &y_i16_b[n * 2u]);
+            }
+            else {
+                aymo_(process_f32)(&chip_b, piece, &x_f32[n * 2u], &y_f32_b[n * 2u]);
+            }
+            n += piece;
+        }
+    }
+}
+
+
+static void test_split(const char* func)
+{
+    setup();
+
+    run_split(0);
+    if (memcmp(y_f32_a, y_f32_b, sizeof(y_f32_a)) || !same_coeffs(&chip_a, &chip_b)) {
+        app_return = TEST_STATUS_FAIL;
+        fprintf(stderr, "%s: f32 output depends on call split\n", func);
+    }
+
+    run_split(1);
+    if (memcmp(y_i16_a, y_i16_b, sizeof(y_i16_a)) || !same_coeffs(&chip_a, &chip_b)) {
+        app_return = TEST_STATUS_FAIL;
+        fprintf(stderr, "%s: i16 output depends on call split\n", func);
+    }
+
+    aymo_(dtor)(&chip_a);
+    aymo_(dtor)(&chip_b);
+}
+
+
+// A filled cache holds every entry, matches computed coefficients, and is only read
+static void test_coeffs_fill(const char* func)
+{
+    setup();
+
+    aymo_tda8425_coeffs_ctor(&coeffs, FS);
+    aymo_tda8425_coeffs_fill(&coeffs);
+
+    if ((coeffs.volume_valid != ~(uint64_t)0u) ||
+        (coeffs.bass_valid != 0xFFFFuL) ||
+        (coeffs.treble_valid != 0xFFFFFFFFuL) ||
+        (coeffs.tfilter_valid != 0xFFFFuL) ||
+        (coeffs.pseudo_valid != 0x7uL)) {
+        app_return = TEST_STATUS_FAIL;
+        fprintf(stderr, "%s: cache not filled\n", func);
+        return;
+    }
+    memcpy(&coeffs_copy, &coeffs, sizeof(coeffs));
+
+    aymo_(ctor)(&chip_a, FS);
+    aymo_(ctor)(&chip_ref, FS);
+    aymo_(set_coeffs)(&chip_a, &coeffs);
+
+    static const uint8_t sf_values[] = { 0xCEu, 0x4Eu, 0xD2u, 0xDEu, 0xEEu, 0x12u, 0xC2u };
+    for (unsigned k = 0u; k < AYMO_VECTOR_LENGTH(sf_values); ++k) {
+        aymo_(write)(&chip_a, 0x08u, sf_values[k]);
+        aymo_(write)(&chip_ref, 0x08u, sf_values[k]);
+
+        for (unsigned value = 0u; value < 64u; ++value) {
+            for (unsigned r = 0u; r < 6u; ++r) {
+                aymo_(write)(&chip_a, addresses[r], (uint8_t)value);
+                aymo_(write)(&chip_ref, addresses[r], (uint8_t)value);
+                if (!same_coeffs(&chip_a, &chip_ref)) {
+                    app_return = TEST_STATUS_FAIL;
+                    fprintf(stderr, "%s: SF=0x%02X reg 0x%02X=0x%02X: cached coefficients differ\n",
+                            func, sf_values[k], addresses[r], value);
+                    return;
+                }
+            }
+        }
+        aymo_(process_f32)(&chip_a, 64u, x_f32, y_f32_a);
+    }
+
+    if (memcmp(&coeffs, &coeffs_copy, sizeof(coeffs))) {
+        app_return = TEST_STATUS_FAIL;
+        fprintf(stderr, "%s: filled cache was written\n", func);
+    }
+
+    aymo_(dtor)(&chip_a);
+    aymo_(dtor)(&chip_ref);
+}
@@ -51,6 +51,10 @@ AYMO_CXX_EXTERN_C_BEGIN
 #define STDEV_LIMIT (.0002)
 #endif
 
+#ifndef STDEV_LIMIT_I16
+#define STDEV_LIMIT_I16 (2.5)  // [LSB] fixed-point vs float model
+#endif
+
 #define EMU_AHEAD   4
 
 static AYMO_TDA8425_DEFINE_MATH_DEFAULT(tda8425_math);
@@ -75,6 +79,10 @@ static struct app_args app_args;
 
 static TDA8425_Chip emu;
 static struct aymo_(chip) chip;
+static struct aymo_(chip) chip_i16;
+static struct aymo_(chip) chip_q;
+static struct aymo_(chip) chip_cached;
+static struct aymo_tda8425_coeffs coeffs;
 
 #ifdef TEST_FILES
 static char* in_name;
@@ -152,6 +160,34 @@ static void app_setup(void)
     aymo_(write)(&chip, 0x07u, app_args.reg_pp);
     aymo_(write)(&chip, 0x08u, app_args.reg_sf);
 
+    aymo_(ctor)(&chip_i16, (float)app_args.fs);
+    aymo_(write)(&chip_i16, 0x00u, app_args.reg_vl);
+    aymo_(write)(&chip_i16, 0x01u, app_args.reg_vr);
+    aymo_(write)(&chip_i16, 0x02u, app_args.reg_ba);
+    aymo_(write)(&chip_i16, 0x03u, app_args.reg_tr);
+    aymo_(write)(&chip_i16, 0x07u, app_args.reg_pp);
+    aymo_(write)(&chip_i16, 0x08u, app_args.reg_sf);
+
+    // Float model fed the same quantized input as the fixed-point one
+    aymo_(ctor)(&chip_q, (float)app_args.fs);
+    aymo_(write)(&chip_q, 0x00u, app_args.reg_vl);
+    aymo_(write)(&chip_q, 0x01u, app_args.reg_vr);
+    aymo_(write)(&chip_q, 0x02u, app_args.reg_ba);
+    aymo_(write)(&chip_q, 0x03u, app_args.reg_tr);
+    aymo_(write)(&chip_q, 0x07u, app_args.reg_pp);
+    aymo_(write)(&chip_q, 0x08u, app_args.reg_sf);
+
+    // Cached coefficients must match the computed ones exactly
+    aymo_tda8425_coeffs_ctor(&coeffs, (float)app_args.fs);
+    aymo_(ctor)(&chip_cached, (float)app_args.fs);
+    aymo_(set_coeffs)(&chip_cached, &coeffs);
+    aymo_(write)(&chip_cached, 0x00u, app_args.reg_vl);
+    aymo_(write)(&chip_cached, 0x01u, app_args.reg_vr);
+    aymo_(write)(&chip_cached, 0x02u, app_args.reg_ba);
+    aymo_(write)(&chip_cached, 0x03u, app_args.reg_tr);
+    aymo_(write)(&chip_cached, 0x07u, app_args.reg_pp);
+    aymo_(write)(&chip_cached, 0x08u, app_args.reg_sf);
+
 #ifdef TEST_FILES
     in_name = aymo_test_args_to_str(0, (app_args.argc - 1), app_args.argv, "", "_in.wav");
     emu_out_name = aymo_test_args_to_str(0, (app_args.argc - 1), app_args.argv, "", "_emu_out.wav");
@@ -191,6 +227,9 @@ static void app_teardown(void)
     TDA8425_Chip_Dtor(&emu);
 
     aymo_(dtor)(&chip);
+    aymo_(dtor)(&chip_i16);
+    aymo_(dtor)(&chip_q);
+    aymo_(dtor)(&chip_cached);
 
 #ifdef TEST_FILES
     fclose(in_file);
@@ -213,10 +252,18 @@ static void app_run(void)
     float emu_y[EMU_AHEAD][2] = {{0}};
     float chip_x[2] = {0};
     float chip_y[2] = {0};
+    int16_t chip_x_i16[2] = {0};
+    int16_t chip_y_i16[2] = {0};
+    float chip_x_q[2] = {0};
+    float chip_y_q[2] = {0};
+    float chip_y_cached[2] = {0};
+    long cached_mismatches = 0;
     double sum_el = 0.;
     double sum_eel = 0.;
     double sum_er = 0.;
     double sum_eer = 0.;
+    double sum_qe = 0.;
+    double sum_qee = 0.;
     long k;
 
     for (k = 0; k < N; ++k) {
@@ -226,6 +273,12 @@ static void app_run(void)
         float xl = (float)(INPUT_AMPLITUDE * sin(th));
         float xr = (float)(INPUT_AMPLITUDE * cos(th));
 
+        // Separate int16 stream, checked against the float model fed the same samples
+        chip_x_i16[0] = (int16_t)lrint(INPUT_AMPLITUDE * sin(th) * 32768.);
+        chip_x_i16[1] = (int16_t)lrint(INPUT_AMPLITUDE * cos(th) * 32768.);
+        chip_x_q[0] = (float)(chip_x_i16[0] / 32768.);
+        chip_x_q[1] = (float)(chip_x_i16[1] / 32768.);
+
         emu_data.inputs[0][0] = (TDA8425_Float)xl;
         emu_data.inputs[0][1] = (TDA8425_Float)xr;
         chip_x[0] = xl;
@@ -240,6 +293,13 @@ static void app_run(void)
         emu_y[0][1] = (float)emu_data.outputs[1];
 
         aymo_(process_f32)(&chip, 1u, chip_x, chip_y);
+        aymo_(process_i16)(&chip_i16, 1u, chip_x_i16, chip_y_i16);
+        aymo_(process_f32)(&chip_q, 1u, chip_x_q, chip_y_q);
+        aymo_(process_f32)(&chip_cached, 1u, chip_x, chip_y_cached);
+
+        if (memcmp(chip_y, chip_y_cached, sizeof(chip_y))) {
+            ++cached_mismatches;
+        }
 
         double el = (emu_y[EMU_AHEAD-1][0] - chip_y[0]);
         double er = (emu_y[EMU_AHEAD-1][1] - chip_y[1]);
@@ -248,6 +308,14 @@ static void app_run(void)
         sum_eel = (el * el);
         sum_eer = (er * er);
 
+        for (int c = 0; c < 2; ++c) {
+            double yq = ((double)chip_y_q[c] * 32768.);
+            yq = fmax(-32768., fmin(yq, 32767.));
+            double qe = ((double)chip_y_i16[c] - yq);
+            sum_qe += qe;
+            sum_qee += (qe * qe);
+        }
+
 #ifdef TEST_FILES
         if (in_file) {
             fwrite(chip_x, sizeof(float), 2, in_file);
@@ -273,9 +341,22 @@ static void app_run(void)
     fprintf(stderr, "L: stdev_e=%g  N=%ld  k=%ld  sum_e=%g  sum_ee=%g\n", stdev_el, N, k, sum_el, sum_eel);
     fprintf(stderr, "R: stdev_e=%g  N=%ld  k=%ld  sum_e=%g  sum_ee=%g\n", stdev_er, N, k, sum_er, sum_eer);
 
+    double avg_qe = (sum_qe / (double)(k * 2));
+    double avg_qee = (sum_qee / (double)(k * 2));
+    double stdev_qe = sqrt(fabs(avg_qee - (avg_qe * avg_qe)));
+
+    fprintf(stderr, "i16: stdev_e=%g LSB  avg_e=%g LSB\n", stdev_qe, avg_qe);
+    fprintf(stderr, "cached: mismatches=%ld\n", cached_mismatches);
+
     if ((stdev_el > STDEV_LIMIT) || (stdev_er > STDEV_LIMIT)) {
         app_return = TEST_STATUS_FAIL;
     }
+    if ((stdev_qe > STDEV_LIMIT_I16) || (fabs(avg_qe) > STDEV_LIMIT_I16)) {
+        app_return = TEST_STATUS_FAIL;
+    }
+    if (cached_mismatches) {
+        app_return = TEST_STATUS_FAIL;
+    }
 }
 
 
@@ -0,0 +1,66 @@
+/*
+AYMO - Accelerated YaMaha Operator
+Copyright (c) 2023-2024 Andrea Zoppi.
+
+This file is part of AYMO.
+
+AYMO is free software: you can redistribute it and/or modify it under the
+terms of the GNU Lesser General Public License as published by the Free
+Software Foundation, either version 2.1 of the License, or (at your option)
+any later version.
+
+AYMO is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with AYMO. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "aymo.h"
+#ifdef AYMO_CPU_SUPPORT_X86_SSE41
+
+#define AYMO_KEEP_SHORTHANDS
+#include "aymo_tda8425_x86_sse41.h"
+
+#include "test_tda8425_smooth_inline.h"
+
+
+void test_tda8425_x86_sse41_smooth_ramp(void)
+{
+    test_ramp(__func__);
+}
+
+
+void test_tda8425_x86_sse41_smooth_retarget(void)
+{
+    test_retarget(__func__);
+}
+
+
+void test_tda8425_x86_sse41_smooth_split(void)
+{
+    test_split(__func__);
+}
+
+
+void test_tda8425_x86_sse41_smooth_coeffs_fill(void)
+{
+    test_coeffs_fill(__func__);
+}
+
+
+struct aymo_testing_entry unit_tests[] =
+{
+    AYMO_TEST_ENTRY(test_tda8425_x86_sse41_smooth_ramp),
+    AYMO_TEST_ENTRY(test_tda8425_x86_sse41_smooth_retarget),
+    AYMO_TEST_ENTRY(test_tda8425_x86_sse41_smooth_split),
+    AYMO_TEST_ENTRY(test_tda8425_x86_sse41_smooth_coeffs_fill)
+};
+
+
+#include "aymo_testing_epilogue_inline.h"
+
+
+#endif  // AYMO_CPU_SUPPORT_X86_SSE41
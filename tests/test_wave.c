@@ -0,0 +1,147 @@
+/*
+AYMO - Accelerated YaMaha Operator
+Copyright (c) 2023-2024 Andrea Zoppi.
+
+This file is part of AYMO.
+
+AYMO is free software: you can redistribute it and/or modify it under the
+terms of the GNU Lesser General Public License as published by the Free
+Software Foundation, either version 2.1 of the License, or (at your option)
+any later version.
+
+AYMO is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with AYMO. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "aymo_testing.h"
+#include "aymo_wave.h"
+
+#include <stdio.h>
+#include <string.h>
+
+AYMO_CXX_EXTERN_C_BEGIN
+
+
+static int app_return;
+
+static uint8_t file[1024];
+
+
+static void put_u16le(uint8_t* ptr, uint16_t value)
+{
+    ptr[0] = (uint8_t)value;
+    ptr[1] = (uint8_t)(value >> 8u);
+}
+
+
+static void put_u32le(uint8_t* ptr, uint32_t value)
+{
+    ptr[0] = (uint8_t)value;
+    ptr[1] = (uint8_t)(value >> 8u);
+    ptr[2] = (uint8_t)(value >> 16u);
+    ptr[3] = (uint8_t)(value >> 24u);
+}
+
+
+static void check(int condition, const char* func, const char* what)
+{
+    if (!condition) {
+        app_return = TEST_STATUS_FAIL;
+        fprintf(stderr, "%s: %s\n", func, what);
+    }
+}
+
+
+void test_aymo_wave_roundtrip(void)
+{
+    struct aymo_wave_heading head;
+    struct aymo_wave_heading parsed;
+    uint32_t offset;
+
+    aymo_wave_heading_setup(&head, AYMO_WAVE_FMT_TYPE_FLOAT, 2u, 32u, 44100u, 100u);
+    check((head.riff_size == (sizeof(head) - 8u + 800u)), __func__, "riff_size");
+    check((head.wave_fmt_byte_rate == (44100u * 8u)), __func__, "byte_rate");
+
+    memset(file, 0, sizeof(file));
+    memcpy(file, &head, sizeof(head));
+    int err = aymo_wave_heading_parse(&parsed, file, (uint32_t)(sizeof(head) + 800u), &offset);
+
+    check(!err, __func__, "error");
+    check((offset == sizeof(head)), __func__, "data_offset");
+    check(!memcmp(&head, &parsed, sizeof(head)), __func__, "heading");
+}
+
+
+void test_aymo_wave_chunks(void)
+{
+    struct aymo_wave_heading parsed;
+    uint32_t offset;
+    uint8_t* ptr = file;
+
+    // Extensible int16 format, odd-sized chunk, streamed data size
+    memset(file, 0, sizeof(file));
+    memcpy(ptr, "RIFF", 4u); put_u32le(&ptr[4], 0xFFFFFFFFu); memcpy(&ptr[8], "WAVE", 4u);
+    ptr += 12u;
+    memcpy(ptr, "LIST", 4u); put_u32le(&ptr[4], 5u);
+    ptr += (8u + 5u + 1u);
+    memcpy(ptr, "fmt ", 4u); put_u32le(&ptr[4], 40u);
+    put_u16le(&ptr[8], 0xFFFEu);
+    put_u16le(&ptr[10], 2u);
+    put_u32le(&ptr[12], 49716u);
+    put_u32le(&ptr[16], (49716u * 4u));
+    put_u16le(&ptr[20], 4u);
+    put_u16le(&ptr[22], 16u);
+    put_u16le(&ptr[32], AYMO_WAVE_FMT_TYPE_PCM);
+    ptr += (8u + 40u);
+    memcpy(ptr, "data", 4u); put_u32le(&ptr[4], 0xFFFFFFFFu);
+    ptr += 8u;
+    uint32_t size = (uint32_t)((ptr - file) + 403u);  // partial frame at the end
+
+    int err = aymo_wave_heading_parse(&parsed, file, size, &offset);
+
+    check(!err, __func__, "error");
+    check((offset == (uint32_t)(ptr - file)), __func__, "data_offset");
+    check((parsed.wave_fmt_type == AYMO_WAVE_FMT_TYPE_PCM), __func__, "fmt_type");
+    check((parsed.wave_fmt_channel_count == 2u), __func__, "channel_count");
+    check((parsed.wave_fmt_sample_rate == 49716u), __func__, "sample_rate");
+    check((parsed.wave_fmt_sample_bits == 16u), __func__, "sample_bits");
+    check((parsed.wave_data_size == 400u), __func__, "data_size");
+}
+
+
+void test_aymo_wave_invalid(void)
+{
+    struct aymo_wave_heading head;
+    struct aymo_wave_heading parsed;
+    uint32_t offset;
+
+    aymo_wave_heading_setup(&head, AYMO_WAVE_FMT_TYPE_PCM, 2u, 16u, 44100u, 0u);
+    memset(file, 0, sizeof(file));
+    memcpy(file, &head, sizeof(head));
+
+    check(!!aymo_wave_heading_parse(&parsed, file, 11u, &offset), __func__, "short");
+    check(!!aymo_wave_heading_parse(&parsed, file, 40u, &offset), __func__, "no data");
+
+    file[0] = 'X';
+    check(!!aymo_wave_heading_parse(&parsed, file, sizeof(head), &offset), __func__, "magic");
+    file[0] = 'R';
+
+    memcpy(&file[12], "fmx ", 4u);  // data without format
+    check(!!aymo_wave_heading_parse(&parsed, file, sizeof(head), &offset), __func__, "no fmt");
+}
+
+
+struct aymo_testing_entry unit_tests[] =
+{
+    AYMO_TEST_ENTRY(test_aymo_wave_roundtrip),
+    AYMO_TEST_ENTRY(test_aymo_wave_chunks),
+    AYMO_TEST_ENTRY(test_aymo_wave_invalid)
+};
+
+
+#include "aymo_testing_epilogue_inline.h"
@@ -55,6 +55,10 @@ AYMO_CXX_EXTERN_C_BEGIN
 #define STDEV_LIMIT (.1)
 #endif
 
+#ifndef STDEV_LIMIT_F32
+#define STDEV_LIMIT_F32 (STDEV_LIMIT / 32768.)
+#endif
+
 
 struct test_args {
     int argc;
@@ -68,6 +72,7 @@ static int app_return;
 static struct test_args test_args;
 
 static YM7128B_ChipFixed emu;
+static YM7128B_ChipFloat emu_f32;
 static struct aymo_(chip) chip;
 
 #ifdef TEST_FILES
@@ -117,6 +122,7 @@ static void app_boot(void)
     memset(&test_args, 0, sizeof(test_args));
 
     YM7128B_ChipFixed_Ctor(&emu);
+    YM7128B_ChipFloat_Ctor(&emu_f32);
 }
 
 
@@ -126,6 +132,10 @@ static void app_setup(void)
     for (int i = 0; i < YM7128B_Reg_Count; ++i) {
         YM7128B_ChipFixed_Write(&emu, (YM7128B_Address)i, test_args.regs[i]);
     }
+    YM7128B_ChipFloat_Reset(&emu_f32);
+    for (int i = 0; i < YM7128B_Reg_Count; ++i) {
+        YM7128B_ChipFloat_Write(&emu_f32, (YM7128B_Address)i, test_args.regs[i]);
+    }
 
     aymo_(ctor)(&chip);
     for (int i = 0; i < AYMO_YM7128_REG_COUNT; ++i) {
@@ -197,6 +207,12 @@ static void app_run(void)
     double sum_ee1l = 0.;
     double sum_e1r = 0.;
     double sum_ee1r = 0.;
+    YM7128B_ChipFloat_Process_Data emu_f32_data;
+    memset(&emu_f32_data, 0, sizeof(emu_f32_data));
+    float chip_f32_x[1] = {0.f};
+    float chip_f32_y[4] = {0.f};
+    double sum_ef = 0.;
+    double sum_eef = 0.;
     long k;
 
     for (k = 0; k < N; ++k) {
@@ -225,6 +241,20 @@ static void app_run(void)
         sum_e1l += e1l; sum_ee1l = (e1l * e1l);
         sum_e1r += e1r; sum_ee1r = (e1r * e1r);
 
+        emu_f32_data.inputs[0] = (float)xx;
+        chip_f32_x[0] = (float)xx;
+
+        YM7128B_ChipFloat_Process(&emu_f32, &emu_f32_data);
+
+        aymo_(process_f32)(&chip, 1u, chip_f32_x, chip_f32_y);
+
+        for (int c = 0; c < 2; ++c) {
+            for (int o = 0; o < 2; ++o) {
+                double ef = ((double)emu_f32_data.outputs[c][o] - (double)chip_f32_y[(o * 2) + c]);
+                sum_ef += ef; sum_eef += (ef * ef);
+            }
+        }
+
 #ifdef TEST_FILES
         if (in_file) {
             fwrite(chip_x, sizeof(int16_t), 1, in_file);
@@ -265,10 +295,19 @@ static void app_run(void)
     double stdev_e1r = sqrt(var_e1r);
     fprintf(stderr, "R1: stdev_e=%g  N=%ld  k=%ld  sum_e=%g  sum_ee=%g\n", stdev_e1r, N, k, sum_e1r, sum_ee1r);
 
+    double avg_ef = (sum_ef / (double)(k * 4));
+    double avg_eef = (sum_eef / (double)(k * 4));
+    double var_ef = fabs(avg_eef - (avg_ef * avg_ef));
+    double stdev_ef = sqrt(var_ef);
+    fprintf(stderr, "F32: stdev_e=%g  N=%ld  k=%ld  sum_e=%g  sum_ee=%g\n", stdev_ef, N, k, sum_ef, sum_eef);
+
     double stdev_e = sqrt(var_e0l + var_e0r + var_e1l + var_e1r);
     if (stdev_e > STDEV_LIMIT) {
         app_return = TEST_STATUS_FAIL;
     }
+    if (stdev_ef > STDEV_LIMIT_F32) {
+        app_return = TEST_STATUS_FAIL;
+    }
 }
 
 
@@ -0,0 +1,310 @@
+/*
+AYMO - Accelerated YaMaha Operator
+Copyright (c) 2023-2024 Andrea Zoppi.
+
+This file is part of AYMO.
+
+AYMO is free software: you can redistribute it and/or modify it under the
+terms of the GNU Lesser General Public License as published by the Free
+Software Foundation, either version 2.1 of the License, or (at your option)
+any later version.
+
+AYMO is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with AYMO. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "aymo.h"
+#include "aymo_testing.h"
+#include "aymo_ymf262.h"
+
+#include <stdio.h>
+#include <string.h>
+
+AYMO_CXX_EXTERN_C_BEGIN
+
+
+/*
+Bulk register loads and batched writes must sound the same as plain
+per-register writes, on each available implementation.
+*/
+
+#define FRAMES      2048u
+#define POOL_SIZE   (1u << 17)
+#define POOL_ALIGN  64
+
+static int app_return;
+
+static uint8_t pool_a[POOL_SIZE] AYMO_ALIGN(POOL_ALIGN);
+static uint8_t pool_b[POOL_SIZE] AYMO_ALIGN(POOL_ALIGN);
+
+static int16_t y_a[FRAMES * 4u];
+static int16_t y_b[FRAMES * 4u];
+
+static uint8_t regs[AYMO_YMF262_REG_NUM];
+static uint8_t mask[AYMO_YMF262_REG_NUM / 8u];
+
+static struct aymo_ymf262_reg_write writes[256];
+
+// Batch lengths around the 64-entry chunks of the batch writer
+static const uint32_t write_lengths[] = {
+    1u, 7u, 63u, 64u, 65u, 127u, 128u, 129u, 200u, 256u
+};
+
+
+static uint32_t rng_state;
+
+static uint32_t rng(void)
+{
+    rng_state = ((rng_state * 1664525uL) + 1013904223uL);
+    return (rng_state >> 8u);
+}
+
+
+static struct aymo_ymf262_chip* setup(uint8_t* pool, const char* cpu_ext)
+{
+    aymo_boot();
+    aymo_ymf262_boot();
+
+    const struct aymo_ymf262_vt* vt = aymo_ymf262_get_vt(cpu_ext);
+    if (!vt || (vt->get_sizeof() > POOL_SIZE)) {
+        return NULL;
+    }
+    struct aymo_ymf262_chip* chip = (struct aymo_ymf262_chip*)(void*)pool;
+    chip->vt = vt;
+    aymo_ymf262_ctor(chip);
+    return chip;
+}
+
+
+// Random register file, with keys on and audible levels for most channels
+static void regs_generate(uint32_t seed)
+{
+    rng_state = seed;
+    for (unsigned address = 0u; address < AYMO_YMF262_REG_NUM; ++address) {
+        regs[address] = (uint8_t)rng();
+    }
+    for (unsigned bank = 0u; bank < 0x200u; bank += 0x100u) {
+        for (unsigned i = 0u; i < 0x16u; ++i) {
+            regs[bank + 0x40u + i] &= 0x1Fu;  // loud
+            regs[bank + 0x60u + i] |= 0x80u;  // fast attack
+        }
+        for (unsigned i = 0u; i < 9u; ++i) {
+            regs[bank + 0xB0u + i] |= (uint8_t)(((rng() % 4u) ? 0x20u : 0x00u));  // key on
+            regs[bank + 0xC0u + i] |= 0x30u;  // both outputs
+        }
+    }
+    regs[0x105u] &= 0x03u;  // standard features only
+}
+
+
+static int is_masked(uint16_t address)
+{
+    return !!(mask[address >> 3u] & (1u << (address & 7u)));
+}
+
+
+// The documented order: 105h first, 104h next, then ascending addresses, and BDh last
+static void write_all(struct aymo_ymf262_chip* chip, int masked)
+{
+    if (!masked || is_masked(0x105u)) {
+        aymo_ymf262_write(chip, 0x105u, regs[0x105u]);
+    }
+    if (!masked || is_masked(0x104u)) {
+        aymo_ymf262_write(chip, 0x104u, regs[0x104u]);
+    }
+    for (uint16_t address = 0u; address < AYMO_YMF262_REG_NUM; ++address) {
+        if ((address != 0x105u) && (address != 0x104u) && (address != 0x0BDu)) {
+            if (!masked || is_masked(address)) {
+                aymo_ymf262_write(chip, address, regs[address]);
+            }
+        }
+    }
+    if (!masked || is_masked(0x0BDu)) {
+        aymo_ymf262_write(chip, 0x0BDu, regs[0x0BDu]);
+    }
+}
+
+
+// Random burst of writes, often hitting the same few addresses
+static void writes_generate(uint32_t length)
+{
+    uint16_t pool[16];
+    for (unsigned i = 0u; i < 16u; ++i) {
+        pool[i] = (uint16_t)(rng() % AYMO_YMF262_REG_NUM);
+    }
+    pool[0] = (uint16_t)(0xB0u + (rng() % 9u));  // keys
+    pool[1] = (uint16_t)(0xA0u + (rng() % 9u));  // frequencies
+    pool[2] = (uint16_t)(0xC0u + (rng() % 9u));  // connections
+
+    for (uint32_t i = 0u; i < length; ++i) {
+        uint16_t address;
+        switch (rng() % 16u) {
+        case 0u: address = 0x0BDu; break;
+        case 1u: address = 0x104u; break;
+        case 2u: address = 0x105u; break;
+        case 3u: address = 0x008u; break;
+        case 4u:
+        case 5u: address = (uint16_t)(rng() % AYMO_YMF262_REG_NUM); break;
+        default: address = pool[rng() % 16u]; break;
+        }
+
+        uint8_t value = (uint8_t)rng();
+        if (((address & 0xE0u) == 0x40u) && ((address & 0x1Fu) < 0x16u)) {
+            value &= 0x1Fu;  // loud
+        }
+        else if (address == 0x105u) {
+            value &= 0x03u;  // standard features only
+        }
+        writes[i].address = address;
+        writes[i].value = value;
+    }
+}
+
+
+static void compare_output(
+    struct aymo_ymf262_chip* chip_a,
+    struct aymo_ymf262_chip* chip_b,
+    uint32_t frames,
+    const char* func,
+    const char* what
+)
+{
+    aymo_ymf262_generate_i16x4(chip_a, frames, y_a);
+    aymo_ymf262_generate_i16x4(chip_b, frames, y_b);
+
+    for (uint32_t n = 0u; n < frames; ++n) {
+        if (memcmp(&y_a[n * 4u], &y_b[n * 4u], (4u * sizeof(int16_t)))) {
+            app_return = TEST_STATUS_FAIL;
+            fprintf(stderr, "%s: %s: mismatch at frame %lu\n", func, what, (unsigned long)n);
+            break;
+        }
+    }
+}
+
+
+static void test_load_registers(const char* cpu_ext, int masked, const char* func)
+{
+    struct aymo_ymf262_chip* chip_a = setup(pool_a, cpu_ext);
+    struct aymo_ymf262_chip* chip_b = setup(pool_b, cpu_ext);
+    if (!chip_a || !chip_b) {
+        app_return = TEST_STATUS_SKIP;
+        return;
+    }
+
+    for (uint32_t seed = 1u; seed <= 8u; ++seed) {
+        regs_generate(seed);
+        for (unsigned i = 0u; i < sizeof(mask); ++i) {
+            mask[i] = (uint8_t)(masked ? rng() : 0xFFu);
+        }
+
+        // Fresh chips
+        aymo_ymf262_ctor(chip_a);
+        aymo_ymf262_ctor(chip_b);
+        aymo_ymf262_load_registers(chip_a, regs, (masked ? mask : NULL));
+        write_all(chip_b, masked);
+        compare_output(chip_a, chip_b, FRAMES, func, "fresh");
+
+        // Chips already playing the previous registers, loading new ones
+        regs_generate(seed + 1000u);
+        if (masked) {
+            for (unsigned i = 0u; i < sizeof(mask); ++i) {
+                mask[i] = (uint8_t)rng();
+            }
+        }
+        aymo_ymf262_load_registers(chip_a, regs, (masked ? mask : NULL));
+        write_all(chip_b, masked);
+        compare_output(chip_a, chip_b, FRAMES, func, "playing");
+    }
+
+    aymo_ymf262_dtor(chip_a);
+    aymo_ymf262_dtor(chip_b);
+}
+
+
+static void test_write_batch(const char* cpu_ext, const char* func)
+{
+    struct aymo_ymf262_chip* chip_a = setup(pool_a, cpu_ext);
+    struct aymo_ymf262_chip* chip_b = setup(pool_b, cpu_ext);
+    if (!chip_a || !chip_b) {
+        app_return = TEST_STATUS_SKIP;
+        return;
+    }
+
+    for (uint32_t seed = 1u; seed <= 8u; ++seed) {
+        regs_generate(seed);
+        aymo_ymf262_ctor(chip_a);
+        aymo_ymf262_ctor(chip_b);
+        write_all(chip_a, 0);
+        write_all(chip_b, 0);
+        compare_output(chip_a, chip_b, 64u, func, "setup");
+
+        for (unsigned k = 0u; k < (sizeof(write_lengths) / sizeof(write_lengths[0])); ++k) {
+            uint32_t length = write_lengths[k];
+            writes_generate(length);
+
+            aymo_ymf262_write_batch(chip_a, writes, length);
+            for (uint32_t i = 0u; i < length; ++i) {
+                aymo_ymf262_write(chip_b, writes[i].address, writes[i].value);
+            }
+
+            char what[32];
+            snprintf(what, sizeof(what), "seed %lu, length %lu", (unsigned long)seed, (unsigned long)length);
+            compare_output(chip_a, chip_b, 256u, func, what);
+            if (app_return == TEST_STATUS_FAIL) {
+                break;
+            }
+        }
+    }
+
+    aymo_ymf262_dtor(chip_a);
+    aymo_ymf262_dtor(chip_b);
+}
+
+
+#define TEST_LOAD_REGISTERS(cpu_ext) \
+    void test_aymo_ymf262_##cpu_ext##_load_registers(void) \
+    { \
+        test_load_registers(#cpu_ext, 0, __func__); \
+    } \
+    void test_aymo_ymf262_##cpu_ext##_load_registers_masked(void) \
+    { \
+        test_load_registers(#cpu_ext, 1, __func__); \
+    } \
+    void test_aymo_ymf262_##cpu_ext##_write_batch(void) \
+    { \
+        test_write_batch(#cpu_ext, __func__); \
+    }
+
+TEST_LOAD_REGISTERS(none)
+TEST_LOAD_REGISTERS(x86_sse41)
+TEST_LOAD_REGISTERS(x86_avx)
+TEST_LOAD_REGISTERS(x86_avx2)
+TEST_LOAD_REGISTERS(arm_neon)
+
+
+struct aymo_testing_entry unit_tests[] =
+{
+    AYMO_TEST_ENTRY(test_aymo_ymf262_none_load_registers),
+    AYMO_TEST_ENTRY(test_aymo_ymf262_none_load_registers_masked),
+    AYMO_TEST_ENTRY(test_aymo_ymf262_none_write_batch),
+    AYMO_TEST_ENTRY(test_aymo_ymf262_x86_sse41_load_registers),
+    AYMO_TEST_ENTRY(test_aymo_ymf262_x86_sse41_load_registers_masked),
+    AYMO_TEST_ENTRY(test_aymo_ymf262_x86_sse41_write_batch),
+    AYMO_TEST_ENTRY(test_aymo_ymf262_x86_avx_load_registers),
+    AYMO_TEST_ENTRY(test_aymo_ymf262_x86_avx_load_registers_masked),
+    AYMO_TEST_ENTRY(test_aymo_ymf262_x86_avx_write_batch),
+    AYMO_TEST_ENTRY(test_aymo_ymf262_x86_avx2_load_registers),
+    AYMO_TEST_ENTRY(test_aymo_ymf262_x86_avx2_load_registers_masked),
+    AYMO_TEST_ENTRY(test_aymo_ymf262_x86_avx2_write_batch),
+    AYMO_TEST_ENTRY(test_aymo_ymf262_arm_neon_load_registers),
+    AYMO_TEST_ENTRY(test_aymo_ymf262_arm_neon_load_registers_masked),
+    AYMO_TEST_ENTRY(test_aymo_ymf262_arm_neon_write_batch)
+};
+
+
+#include "aymo_testing_epilogue_inline.h"